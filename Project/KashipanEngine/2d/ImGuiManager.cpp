@@ -106,7 +106,9 @@ void ImGuiManager::BeginFrame() {
 void ImGuiManager::EndFrame() {
     // ImGuiのフレーム終了処理
     ImGui::Render();
-    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), dxCommon_->GetCommandList());
+    if (isCommandRecordingEnabled_) {
+        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), dxCommon_->GetCommandList());
+    }
 }
 
 void ImGuiManager::Reinitialize() {
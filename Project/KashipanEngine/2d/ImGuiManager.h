@@ -28,6 +28,13 @@ public:
     /// @brief ImGuiのフレーム終了処理
     void EndFrame();
 
+    /// @brief コマンドリストへの記録の設定。
+    /// 無効にするとUIの処理だけ行い、描画コマンドは積まない(ヘッドレスモード用)
+    /// @param isEnabled コマンドリストに記録するかどうか
+    void SetCommandRecordingEnabled(bool isEnabled) {
+        isCommandRecordingEnabled_ = isEnabled;
+    }
+
     /// @brief ImGuiの再初期化
     void Reinitialize();
 
@@ -36,6 +43,8 @@ private:
     WinApp *winApp_ = nullptr;
     /// @brief DirectXCommonインスタンス
     DirectXCommon *dxCommon_ = nullptr;
+    /// @brief コマンドリストに記録するかどうか
+    bool isCommandRecordingEnabled_ = true;
 };
 
 } // namespace KashipanEngine
@@ -1,5 +1,6 @@
 #pragma once
 #include <Objects/Sprite.h>
+#include "Base/Texture.h"
 #include <bitset>
 #include <functional>
 #include "2d/UI/UIElements.h"
@@ -55,7 +56,7 @@ public:
         return name_;
     }
     template <typename T>
-    const T &GetUIElement(const std::string &name) {
+    T GetUIElement(const std::string &name) {
         return uiElements_.Get<T>(name);
     }
     const UIEventFrags &GetEventFrags() const {
@@ -69,7 +70,7 @@ public:
     void SetUIElement(const std::string &name, const T &val) {
         if constexpr (std::is_convertible_v<T, uint32_t>) {
             if (name == "textureIndex") {
-                sprite_->SetTexture(static_cast<uint32_t>(val));
+                sprite_->SetTexture(Texture::GetHandle(static_cast<uint32_t>(val)));
             }
         }
         uiElements_.Set(name, val);
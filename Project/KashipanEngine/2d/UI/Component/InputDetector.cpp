@@ -42,8 +42,8 @@ bool IsHover(BaseUI *detectUI) {
         detectUI->GetWorldTransform().worldMatrix_.m[3][0],
         detectUI->GetWorldTransform().worldMatrix_.m[3][1]
     );
-    uint32_t textureIndex = detectUI->GetUIElement<int>("textureIndex");
-    TextureData textureData = Texture::GetTexture(textureIndex);
+    const uint32_t textureIndex = detectUI->GetUIElement<int>("textureIndex");
+    TextureData textureData = Texture::GetTexture(Texture::GetHandle(textureIndex));
     Vector2 uiSize(
         static_cast<float>(textureData.width),
         static_cast<float>(textureData.height)
@@ -1,66 +1,85 @@
 #pragma once
 #include <string>
-#include <memory>
-#include <unordered_map>
+#include <type_traits>
+#include <Document.h>
 #include "Math/Vector2.h"
 #include "Math/Vector4.h"
-#include "Math/Matrix3x3.h"
 
 namespace KashipanEngine {
 
+/// @brief UIの要素(位置や色など)を名前で持つ表。
+/// 値は Document に持ち、ベクトルは float の配列にする。型は Document のタグで確認するので RTTI を使わない
 class UIElements {
 public:
     UIElements() {
-        elements_["pos"]            = std::make_unique<TypedElement<Vector2>>(Vector2(0.0f, 0.0f));
-        elements_["scale"]          = std::make_unique<TypedElement<Vector2>>(Vector2(1.0f, 1.0f));
-        elements_["anchor"]         = std::make_unique<TypedElement<Vector2>>(Vector2(0.0f, 0.0f));
-        elements_["pivot"]          = std::make_unique<TypedElement<Vector2>>(Vector2(0.0f, 0.0f));
-        elements_["offset"]         = std::make_unique<TypedElement<Vector2>>(Vector2(0.0f, 0.0f));
-        elements_["color"]          = std::make_unique<TypedElement<Vector4>>(Vector4(255.0f, 255.0f, 255.0f, 255.0f));
-        elements_["textureIndex"]   = std::make_unique<TypedElement<int>>(-1);
-        elements_["degree"]         = std::make_unique<TypedElement<float>>(0.0f);
-        elements_["isVisible"]      = std::make_unique<TypedElement<bool>>(true);
+        Set("pos", Vector2(0.0f, 0.0f));
+        Set("scale", Vector2(1.0f, 1.0f));
+        Set("anchor", Vector2(0.0f, 0.0f));
+        Set("pivot", Vector2(0.0f, 0.0f));
+        Set("offset", Vector2(0.0f, 0.0f));
+        Set("color", Vector4(255.0f, 255.0f, 255.0f, 255.0f));
+        Set("textureIndex", -1);
+        Set("degree", 0.0f);
+        Set("isVisible", true);
     }
+    // 要素のハンドルが Document を指すので、コピー・ムーブはしない
+    UIElements(const UIElements &) = delete;
+    UIElements &operator=(const UIElements &) = delete;
 
-    /// @brief 要素の取得
+    /// @brief 要素の取得。型が違う場合は std::invalid_argument を投げる
     /// @tparam T 型
     /// @param element 要素名
     /// @return 要素の値
     template <typename T>
-    const T &Get(const std::string &element) {
+    T Get(const std::string &element) {
+        MyStd::DocumentNode node = document_[element];
         // 要素が存在しない場合は新しく作成して返す
-        if (elements_.find(element) == elements_.end()) {
-            elements_[element] = std::make_unique<TypedElement<T>>(T{});
+        if (node.GetValue().IsNull()) {
+            Write(node, T{});
+            return T{};
         }
-        return dynamic_cast<TypedElement<T> *>(elements_[element].get())->value;
+        return Read<T>(node.GetValue());
     }
 
-    /// @brief 要素の設定
+    /// @brief 要素の設定。同じ形の値は上書きするので、毎フレーム設定してもメモリは増えない
     /// @tparam T 型
     /// @param element 要素名
     /// @param value 設定する値
     template <typename T>
     void Set(const std::string &element, const T &value) {
-        if (elements_.find(element) == elements_.end()) {
-            elements_[element] = std::make_unique<TypedElement<T>>(value);
-        }
-        dynamic_cast<TypedElement<T> *>(elements_[element].get())->value = value;
+        Write(document_[element], value);
     }
 
 private:
-    // 要素テーブル作成用クラス
-    class Element {
-    public:
-        virtual ~Element() = default;
-    };
     template <typename T>
-    class TypedElement : public Element {
-    public:
-        T value;
-        explicit TypedElement(const T &val) : value(val) {}
-    };
+    static void Write(MyStd::DocumentNode node, const T &value) {
+        if constexpr (std::is_same_v<T, Vector2>) {
+            node[size_t{ 0 }] = value.x;
+            node[size_t{ 1 }] = value.y;
+        } else if constexpr (std::is_same_v<T, Vector4>) {
+            node[size_t{ 0 }] = value.x;
+            node[size_t{ 1 }] = value.y;
+            node[size_t{ 2 }] = value.z;
+            node[size_t{ 3 }] = value.w;
+        } else {
+            node = value;
+        }
+    }
+
+    template <typename T>
+    static T Read(const MyStd::DocumentValue &value) {
+        if constexpr (std::is_same_v<T, Vector2>) {
+            return Vector2(value.at(0).GetTo<float>(), value.at(1).GetTo<float>());
+        } else if constexpr (std::is_same_v<T, Vector4>) {
+            return Vector4(value.at(0).GetTo<float>(), value.at(1).GetTo<float>(),
+                value.at(2).GetTo<float>(), value.at(3).GetTo<float>());
+        } else {
+            return value.GetTo<T>();
+        }
+    }
 
-    std::unordered_map<std::string, std::unique_ptr<Element>> elements_;
+    /// @brief 要素の表
+    MyStd::Document document_{ 1024 };
 };
 
 }
\ No newline at end of file
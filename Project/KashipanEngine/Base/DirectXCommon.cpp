@@ -145,6 +145,7 @@ void DirectXCommon::ClearDepthStencil() {
 }
 
 void DirectXCommon::SetBarrier(D3D12_RESOURCE_BARRIER &barrier) {
+    assert(IsOwnerThread());
     // 同じバリアを張ろうとしてるのは無視
     if (barrier.Transition.StateAfter == currentBarrierState_) {
         return;
@@ -198,6 +199,7 @@ void DirectXCommon::Resize() {
 }
 
 void DirectXCommon::CommandExecute(bool isSwapChain) {
+    assert(IsOwnerThread());
     // コマンドリストの内容を確定させる。すべてのコマンドを積んでからCloseすること
     HRESULT hr = commandList_->Close();
     // コマンドリストの内容を確定できたかをチェック
@@ -208,9 +210,9 @@ void DirectXCommon::CommandExecute(bool isSwapChain) {
     commandQueue_->ExecuteCommandLists(1, commandLists);
 
     // スワップチェインの実行を行うかどうか
-    if (isSwapChain) {
+    if (isSwapChain && isPresentEnabled_) {
         // スワップチェインの実行を行う
-        swapChain_->Present(1, 0);
+        swapChain_->Present(isVSync_ ? 1 : 0, 0);
     }
 
     //==================================================
@@ -1,7 +1,9 @@
 #pragma once
 #include <wrl.h>
+#include <cassert>
 #include <chrono>
 #include <cstdlib>
+#include <thread>
 #include <d3d12.h>
 #include <dxgi1_6.h>
 
@@ -45,6 +47,14 @@ public:
     /// @brief ウィンドウサイズ変更適応
     void Resize();
 
+    /// @brief 垂直同期の設定。無効にすると表示を待たずに次のフレームに進む
+    /// @param isVSync 垂直同期を行うかどうか
+    void SetVSync(bool isVSync) { isVSync_ = isVSync; }
+
+    /// @brief 画面への表示の設定。無効にするとコマンドは実行するがスワップチェインに表示しない
+    /// @param isPresentEnabled 表示を行うかどうか
+    void SetPresentEnabled(bool isPresentEnabled) { isPresentEnabled_ = isPresentEnabled; }
+
     /// @brief コマンドの実行
     /// @param isSwapChain スワップチェインの実行かどうか
     void CommandExecute(bool isSwapChain);
@@ -72,9 +82,16 @@ public:
     /// @return コマンドキュー
     ID3D12CommandQueue *GetCommandQueue() const { return commandQueue_.Get(); }
 
-    /// @brief 描画コマンドリスト取得
+    /// @brief 描画コマンドリスト取得。作成したスレッド(メインスレッド)からのみ呼べる
     /// @return 描画コマンドリスト
-    ID3D12GraphicsCommandList *GetCommandList() const { return commandList_.Get(); }
+    ID3D12GraphicsCommandList *GetCommandList() const {
+        assert(IsOwnerThread() && "The command list is only usable from the thread that created DirectXCommon.");
+        return commandList_.Get();
+    }
+
+    /// @brief 作成したスレッドから呼ばれているかどうか。
+    /// デバイスはどのスレッドからでも使えるが、コマンドリストとキューの操作は作成したスレッドに限る
+    bool IsOwnerThread() const { return std::this_thread::get_id() == ownerThreadId_; }
 
     /// @brief スワップチェインの設定取得
     /// @return スワップチェインの設定
@@ -93,6 +110,8 @@ private:
 
     /// @brief WinAppクラス(外部から持ってくる)
     WinApp *winApp_ = nullptr;
+    /// @brief 作成したスレッド
+    std::thread::id ownerThreadId_ = std::this_thread::get_id();
 
     //--------- DXGI ---------//
     
@@ -120,6 +139,10 @@ private:
     Microsoft::WRL::ComPtr<IDXGISwapChain4> swapChain_;
     /// @brief スワップチェインから取得したリソース
     Microsoft::WRL::ComPtr<ID3D12Resource> swapChainResources_[2];
+    /// @brief 垂直同期を行うかどうか
+    bool isVSync_ = true;
+    /// @brief スワップチェインに表示するかどうか
+    bool isPresentEnabled_ = true;
     /// @brief スワップチェイン用のビューポート
     D3D12_VIEWPORT viewport_;
     /// @brief スワップチェイン用のシザー矩形
@@ -1,12 +1,18 @@
 #include <cassert>
-#include <unordered_map>
+#include <FlatHashMap.h>
 #include <functional>
 #include <algorithm>
+#include <fstream>
+#include <format>
+#include <iterator>
+#include <vector>
+#include <InputRecording.h>
 
 #include "Input.h"
 #include "Base/WinApp.h"
 #include "Base/ScreenBuffer.h"
 #include "Common/Logs.h"
+#include "Common/Random.h"
 #include "Math/Vector2.h"
 
 #pragma comment(lib, "xinput.lib")
@@ -77,12 +83,127 @@ SHORT sControllerStickDeadZone = 4096;
 /// @brief コントローラーの振動状態
 XINPUT_VIBRATION vibration[4] = {};
 
+//==================================================
+// 入力の記録・再生
+//==================================================
+
+/// @brief 記録中の入力
+MyStd::InputRecording sRecording;
+/// @brief 再生中の入力
+MyStd::InputRecording sReplay;
+/// @brief 記録中かどうか
+bool sIsRecording = false;
+/// @brief 再生中かどうか
+bool sIsReplaying = false;
+/// @brief 次に再生するフレーム
+size_t sReplayFrameIndex = 0;
+/// @brief 再生中のフレームに記録されていたフレーム時間
+float sReplayDeltaTime = 0.0f;
+
+/// @brief デバイスから入力状態を読み込む
+void PollDevices() {
+    // キーボードの状態を取得
+    sKeyboardDevice->Acquire();
+    sKeyboardDevice->GetDeviceState(sizeof(sKeyboardState), sKeyboardState);
+
+    // マウスの状態を取得
+    sMouseDevice->Acquire();
+    sMouseDevice->GetDeviceState(sizeof(sMouseState), &sMouseState);
+
+    // コントローラーの状態を取得
+    for (int i = 0; i < 4; ++i) {
+        sControllerConnected[i] = true; // 初期状態では接続されていると仮定
+        ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
+        DWORD dw = XInputGetState(i, &sControllerState[i]);
+        // コントローラーが接続されていない場合は状態をクリア
+        if (dw == ERROR_DEVICE_NOT_CONNECTED) {
+            ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
+            sControllerConnected[i] = false;
+            continue;
+        }
+
+        // スティックの値がデッドゾーン以下の場合は0に設定
+        if (sControllerState[i].Gamepad.sThumbLX < +sControllerStickDeadZone &&
+            sControllerState[i].Gamepad.sThumbLX > -sControllerStickDeadZone) {
+            sControllerState[i].Gamepad.sThumbLX = 0;
+        }
+        if (sControllerState[i].Gamepad.sThumbLY < +sControllerStickDeadZone &&
+            sControllerState[i].Gamepad.sThumbLY > -sControllerStickDeadZone) {
+            sControllerState[i].Gamepad.sThumbLY = 0;
+        }
+        if (sControllerState[i].Gamepad.sThumbRX < +sControllerStickDeadZone &&
+            sControllerState[i].Gamepad.sThumbRX > -sControllerStickDeadZone) {
+            sControllerState[i].Gamepad.sThumbRX = 0;
+        }
+        if (sControllerState[i].Gamepad.sThumbRY < +sControllerStickDeadZone &&
+            sControllerState[i].Gamepad.sThumbRY > -sControllerStickDeadZone) {
+            sControllerState[i].Gamepad.sThumbRY = 0;
+        }
+    }
+
+    // マウスの座標を取得
+    GetCursorPos(&sMousePos);
+    ScreenToClient(sWinApp->GetWindowHandle(), &sMousePos);
+}
+
+/// @brief 現在の入力状態を記録用に変換する
+/// @param deltaTime フレーム時間
+MyStd::InputSnapshot CaptureSnapshot(float deltaTime) {
+    MyStd::InputSnapshot snapshot;
+    snapshot.deltaTime = deltaTime;
+    std::copy(std::begin(sKeyboardState), std::end(sKeyboardState), snapshot.keys.begin());
+    snapshot.mouseX = static_cast<int32_t>(sMousePos.x);
+    snapshot.mouseY = static_cast<int32_t>(sMousePos.y);
+    snapshot.mouseDeltaX = static_cast<int32_t>(sMouseState.lX);
+    snapshot.mouseDeltaY = static_cast<int32_t>(sMouseState.lY);
+    snapshot.mouseWheel = static_cast<int32_t>(sMouseState.lZ);
+    std::copy(std::begin(sMouseState.rgbButtons), std::end(sMouseState.rgbButtons), snapshot.mouseButtons.begin());
+    for (int i = 0; i < 4; ++i) {
+        const XINPUT_GAMEPAD &gamepad = sControllerState[i].Gamepad;
+        MyStd::PadSnapshot &pad = snapshot.pads[i];
+        pad.isConnected = sControllerConnected[i];
+        pad.buttons = gamepad.wButtons;
+        pad.leftTrigger = gamepad.bLeftTrigger;
+        pad.rightTrigger = gamepad.bRightTrigger;
+        pad.thumbLX = gamepad.sThumbLX;
+        pad.thumbLY = gamepad.sThumbLY;
+        pad.thumbRX = gamepad.sThumbRX;
+        pad.thumbRY = gamepad.sThumbRY;
+    }
+    return snapshot;
+}
+
+/// @brief 記録した入力状態を現在の入力状態にする
+/// @param snapshot 記録した入力状態
+void ApplySnapshot(const MyStd::InputSnapshot &snapshot) {
+    std::copy(snapshot.keys.begin(), snapshot.keys.end(), std::begin(sKeyboardState));
+    sMousePos.x = static_cast<LONG>(snapshot.mouseX);
+    sMousePos.y = static_cast<LONG>(snapshot.mouseY);
+    sMouseState.lX = static_cast<LONG>(snapshot.mouseDeltaX);
+    sMouseState.lY = static_cast<LONG>(snapshot.mouseDeltaY);
+    sMouseState.lZ = static_cast<LONG>(snapshot.mouseWheel);
+    std::copy(snapshot.mouseButtons.begin(), snapshot.mouseButtons.end(), std::begin(sMouseState.rgbButtons));
+    for (int i = 0; i < 4; ++i) {
+        const MyStd::PadSnapshot &pad = snapshot.pads[i];
+        ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
+        sControllerConnected[i] = pad.isConnected;
+        XINPUT_GAMEPAD &gamepad = sControllerState[i].Gamepad;
+        gamepad.wButtons = pad.buttons;
+        gamepad.bLeftTrigger = pad.leftTrigger;
+        gamepad.bRightTrigger = pad.rightTrigger;
+        gamepad.sThumbLX = pad.thumbLX;
+        gamepad.sThumbLY = pad.thumbLY;
+        gamepad.sThumbRX = pad.thumbRX;
+        gamepad.sThumbRY = pad.thumbRY;
+    }
+}
+
 //==================================================
 // 関数マップ
 //==================================================
 
 /// @brief キーの押下取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOption, std::function<bool(int)>>> sGetKeyFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::DownStateOption, std::function<bool(int)>>> sGetKeyFunctions = {
     { Input::CurrentOption::Current, {
         { Input::DownStateOption::Down, Input::IsKeyDown },
         { Input::DownStateOption::Trigger, Input::IsKeyTrigger },
@@ -96,7 +217,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOpti
 };
 
 /// @brief マウスボタンの押下取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOption, std::function<bool(int)>>> sGetMouseButtonFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::DownStateOption, std::function<bool(int)>>> sGetMouseButtonFunctions = {
     { Input::CurrentOption::Current, {
         { Input::DownStateOption::Down, Input::IsMouseButtonDown },
         { Input::DownStateOption::Trigger, Input::IsMouseButtonTrigger },
@@ -110,7 +231,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOpti
 };
 
 /// @brief マウスカーソル(+マウスホイール)の位置取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::AxisOption, std::unordered_map<Input::ValueOption, std::function<int()>>>> sGetMousePositionFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::AxisOption, MyStd::FlatHashMap<Input::ValueOption, std::function<int()>>>> sGetMousePositionFunctions = {
     { Input::CurrentOption::Current, {
         { Input::AxisOption::X, {
             { Input::ValueOption::Actual, Input::GetMouseX },
@@ -142,7 +263,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::AxisOption, s
 };
 
 /// @brief コントローラーのトリガー取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOption, std::unordered_map<Input::ValueOption, std::function<int(int)>>>> sGetXBoxTriggerFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::LeftRightOption, MyStd::FlatHashMap<Input::ValueOption, std::function<int(int)>>>> sGetXBoxTriggerFunctions = {
     { Input::CurrentOption::Current, {
         { Input::LeftRightOption::Left, {
             { Input::ValueOption::Actual, Input::GetXBoxLeftTrigger },
@@ -166,7 +287,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOpti
 };
 
 /// @brief コントローラーのトリガー比率取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOption, std::unordered_map<Input::ValueOption, std::function<float(int)>>>> sGetXBoxTriggerRatioFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::LeftRightOption, MyStd::FlatHashMap<Input::ValueOption, std::function<float(int)>>>> sGetXBoxTriggerRatioFunctions = {
     { Input::CurrentOption::Current, {
         { Input::LeftRightOption::Left, {
             { Input::ValueOption::Actual, Input::GetXBoxLeftTriggerRatio },
@@ -190,7 +311,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOpti
 };
 
 /// @brief コントローラーのスティック取得関数マップ
-std::unordered_map < Input::CurrentOption, std::unordered_map<Input::LeftRightOption, std::unordered_map<Input::AxisOption, std::unordered_map<Input::ValueOption, std::function<int(int)>>>>> sGetXBoxStickFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::LeftRightOption, MyStd::FlatHashMap<Input::AxisOption, MyStd::FlatHashMap<Input::ValueOption, std::function<int(int)>>>>> sGetXBoxStickFunctions = {
     { Input::CurrentOption::Current, {
         { Input::LeftRightOption::Left, {
             { Input::AxisOption::X, {
@@ -238,7 +359,7 @@ std::unordered_map < Input::CurrentOption, std::unordered_map<Input::LeftRightOp
 };
 
 /// @brief コントローラーのスティック比率取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOption, std::unordered_map<Input::AxisOption, std::unordered_map<Input::ValueOption, std::function<float(int)>>>>> sGetXBoxStickRatioFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::LeftRightOption, MyStd::FlatHashMap<Input::AxisOption, MyStd::FlatHashMap<Input::ValueOption, std::function<float(int)>>>>> sGetXBoxStickRatioFunctions = {
     { Input::CurrentOption::Current, {
         { Input::LeftRightOption::Left, {
             { Input::AxisOption::X, {
@@ -286,7 +407,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::LeftRightOpti
 };
 
 /// @brief コントローラーのボタン取得関数マップ
-std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOption, std::function<bool(int, int)>>> sGetXBoxButtonFunctions = {
+MyStd::FlatHashMap<Input::CurrentOption, MyStd::FlatHashMap<Input::DownStateOption, std::function<bool(int, int)>>> sGetXBoxButtonFunctions = {
     { Input::CurrentOption::Current, {
         { Input::DownStateOption::Down, Input::IsXBoxButtonDown },
         { Input::DownStateOption::Trigger, Input::IsXBoxButtonTrigger },
@@ -303,7 +424,7 @@ std::unordered_map<Input::CurrentOption, std::unordered_map<Input::DownStateOpti
 // 値マップ
 //==================================================
 
-std::unordered_map<int, XBoxButtonCode> sXBoxButtonCodeMap = {
+MyStd::FlatHashMap<int, XBoxButtonCode> sXBoxButtonCodeMap = {
     { 0, XBoxButtonCode::UP },
     { 1, XBoxButtonCode::DOWN },
     { 2, XBoxButtonCode::LEFT },
@@ -327,6 +448,11 @@ void Input::SetMainScreen(ScreenBuffer *screen) {
 }
 
 void Input::Initialize(WinApp *winApp) {
+    InitializeDevices(winApp);
+    AttachWindow();
+}
+
+void Input::InitializeDevices(WinApp *winApp) {
     // 初期化済みフラグをチェック
     if (sIsInitialized) {
         Log("Input is already initialized.", kLogLevelFlagError);
@@ -374,12 +500,19 @@ void Input::Initialize(WinApp *winApp) {
         ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
         ZeroMemory(&sPreControllerState[i], sizeof(XINPUT_STATE));
     }
-    
+}
+
+void Input::AttachWindow() {
+    if (sIsInitialized || !sKeyboardDevice || !sMouseDevice) {
+        Log("Input devices are not created or already attached.", kLogLevelFlagError);
+        assert(false);
+    }
+
     //==================================================
     // 排他的レベルの設定
     //==================================================
 
-    hr = sKeyboardDevice->SetCooperativeLevel(
+    HRESULT hr = sKeyboardDevice->SetCooperativeLevel(
         sWinApp->GetWindowHandle(),
         DISCL_FOREGROUND | DISCL_NONEXCLUSIVE | DISCL_NOWINKEY
     );
@@ -407,58 +540,41 @@ void Input::Finalize() {
     Log("Complete Finalize Input.", kLogLevelFlagInfo);
 }
 
-void Input::Update() {
+void Input::Update(float deltaTime) {
     // 初期化済みフラグをチェック
     if (!sIsInitialized) {
         Log("Input is not initialized.", kLogLevelFlagError);
         assert(false);
     }
 
-    // キーボードの状態を取得
+    // 前回の状態を保存
     memcpy(sPreKeyboardState, sKeyboardState, sizeof(sKeyboardState));
-    sKeyboardDevice->Acquire();
-    sKeyboardDevice->GetDeviceState(sizeof(sKeyboardState), sKeyboardState);
-
-    // マウスの状態を取得
     memcpy(&sPreMouseState, &sMouseState, sizeof(sMouseState));
-    sMouseDevice->Acquire();
-    sMouseDevice->GetDeviceState(sizeof(sMouseState), &sMouseState);
-
-    // コントローラーの状態を取得
+    sPreMousePos = sMousePos;
     for (int i = 0; i < 4; ++i) {
         memcpy(&sPreControllerState[i], &sControllerState[i], sizeof(XINPUT_STATE));
         memcpy(&sPreControllerStateDelta[i], &sControllerStateDelta[i], sizeof(XINPUT_STATE));
         memcpy(&sPreControllerConnected[i], &sControllerConnected[i], sizeof(bool));
+    }
 
-        sControllerConnected[i] = true; // 初期状態では接続されていると仮定
-        ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
-        DWORD dw = XInputGetState(i, &sControllerState[i]);
-        // コントローラーが接続されていない場合は状態をクリア
-        if (dw == ERROR_DEVICE_NOT_CONNECTED) {
-            ZeroMemory(&sControllerState[i], sizeof(XINPUT_STATE));
-            sControllerConnected[i] = false;
-            continue;
-        }
+    // 最後のフレームまで再生し終わっていたら実際の入力に戻す
+    if (sIsReplaying && sReplayFrameIndex >= sReplay.GetFrameCount()) {
+        StopReplay();
+    }
+    if (sIsReplaying) {
+        const MyStd::InputSnapshot &snapshot = sReplay.GetFrame(sReplayFrameIndex);
+        ApplySnapshot(snapshot);
+        sReplayDeltaTime = snapshot.deltaTime;
+        ++sReplayFrameIndex;
+    } else {
+        PollDevices();
+    }
 
-        // スティックの値がデッドゾーン以下の場合は0に設定
-        if (sControllerState[i].Gamepad.sThumbLX < +sControllerStickDeadZone &&
-            sControllerState[i].Gamepad.sThumbLX > -sControllerStickDeadZone) {
-            sControllerState[i].Gamepad.sThumbLX = 0;
-        }
-        if (sControllerState[i].Gamepad.sThumbLY < +sControllerStickDeadZone &&
-            sControllerState[i].Gamepad.sThumbLY > -sControllerStickDeadZone) {
-            sControllerState[i].Gamepad.sThumbLY = 0;
-        }
-        if (sControllerState[i].Gamepad.sThumbRX < +sControllerStickDeadZone &&
-            sControllerState[i].Gamepad.sThumbRX > -sControllerStickDeadZone) {
-            sControllerState[i].Gamepad.sThumbRX = 0;
-        }
-        if (sControllerState[i].Gamepad.sThumbRY < +sControllerStickDeadZone &&
-            sControllerState[i].Gamepad.sThumbRY > -sControllerStickDeadZone) {
-            sControllerState[i].Gamepad.sThumbRY = 0;
+    // コントローラーの差分を計算
+    for (int i = 0; i < 4; ++i) {
+        if (!sControllerConnected[i]) {
+            continue;
         }
-
-        // 差分を計算
         sControllerStateDelta[i].Gamepad.bLeftTrigger =
             sControllerState[i].Gamepad.bLeftTrigger - sPreControllerState[i].Gamepad.bLeftTrigger;
         sControllerStateDelta[i].Gamepad.bRightTrigger =
@@ -472,11 +588,101 @@ void Input::Update() {
         sControllerStateDelta[i].Gamepad.sThumbRY =
             sControllerState[i].Gamepad.sThumbRY - sPreControllerState[i].Gamepad.sThumbRY;
     }
-    
-    // マウスの座標を取得
-    sPreMousePos = sMousePos;
-    GetCursorPos(&sMousePos);
-    ScreenToClient(sWinApp->GetWindowHandle(), &sMousePos);
+
+    // このフレームの入力を記録
+    if (sIsRecording) {
+        sRecording.AddFrame(CaptureSnapshot(deltaTime));
+    }
+}
+
+void Input::StartRecording() {
+    if (sIsReplaying) {
+        Log("Cannot record input while replaying.", kLogLevelFlagWarning);
+        return;
+    }
+    sRecording.Clear();
+    // 乱数を新しいシード値で初期化し直して記録しておく。再生の開始時に同じシード値に戻す
+    InitializeRandom();
+    sRecording.SetSeed(GetRandomSeed());
+    sIsRecording = true;
+    Log(std::format("Input recording started. (random seed {})", GetRandomSeed()));
+}
+
+bool Input::StopRecording(const std::string &filePath) {
+    if (!sIsRecording) {
+        return false;
+    }
+    sIsRecording = false;
+    if (filePath.empty()) {
+        sRecording.Clear();
+        return false;
+    }
+
+    const std::vector<uint8_t> bytes = sRecording.Serialize();
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        Log("Failed to save input recording: " + filePath, kLogLevelFlagError);
+        return false;
+    }
+    Log(std::format("Input recording saved: {} ({} frames, {} bytes)", filePath, sRecording.GetFrameCount(), bytes.size()));
+    sRecording.Clear();
+    return true;
+}
+
+bool Input::StartReplay(const std::string &filePath) {
+    if (sIsRecording) {
+        Log("Cannot replay input while recording.", kLogLevelFlagWarning);
+        return false;
+    }
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file) {
+        Log("Failed to open input recording: " + filePath, kLogLevelFlagError);
+        return false;
+    }
+    const std::vector<uint8_t> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    if (!sReplay.Deserialize(bytes)) {
+        Log("Invalid input recording: " + filePath, kLogLevelFlagError);
+        return false;
+    }
+    if (sReplay.HasSeed()) {
+        SetRandomSeed(sReplay.GetSeed());
+    } else {
+        Log("Input recording has no random seed. Random values may differ from the recording: " + filePath, kLogLevelFlagWarning);
+    }
+    sReplayFrameIndex = 0;
+    sReplayDeltaTime = 0.0f;
+    sIsReplaying = true;
+    Log(std::format("Input replay started: {} ({} frames, random seed {})", filePath, sReplay.GetFrameCount(), sReplay.GetSeed()));
+    return true;
+}
+
+void Input::StopReplay() {
+    if (!sIsReplaying) {
+        return;
+    }
+    sIsReplaying = false;
+    Log(std::format("Input replay finished. ({} / {} frames)", sReplayFrameIndex, sReplay.GetFrameCount()));
+}
+
+bool Input::IsRecording() {
+    return sIsRecording;
+}
+
+bool Input::IsReplaying() {
+    return sIsReplaying;
+}
+
+float Input::GetReplayDeltaTime() {
+    return sReplayDeltaTime;
+}
+
+size_t Input::GetReplayFrameIndex() {
+    return sReplayFrameIndex;
+}
+
+size_t Input::GetReplayFrameCount() {
+    return sReplay.GetFrameCount();
 }
 
 InputDeviceType Input::GetCurrentInputDeviceType() {
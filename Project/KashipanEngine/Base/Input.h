@@ -2,6 +2,8 @@
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
 #include <Xinput.h>
+#include <cstddef>
+#include <string>
 
 namespace KashipanEngine{
 
@@ -98,11 +100,57 @@ public:
     /// @param winApp WinAppインスタンス
     static void Initialize(WinApp *winApp);
 
+    /// @brief デバイスの作成のみ行う。
+    /// DirectInput の COM オブジェクトを作るので、終了処理まで COM を初期化したままのスレッドで呼ぶ
+    /// @param winApp WinAppインスタンス
+    static void InitializeDevices(WinApp *winApp);
+
+    /// @brief ウィンドウとの排他的レベルを設定して初期化を完了する。ウィンドウを作ったスレッドで呼ぶ
+    static void AttachWindow();
+
     /// @brief 終了処理
     static void Finalize();
 
-    /// @brief 入力状態更新
-    static void Update();
+    /// @brief 入力状態更新。記録中はこのフレームの入力をフレーム時間と一緒に記録し、再生中は記録した入力に置き換える
+    /// @param deltaTime このフレームのフレーム時間(記録用)
+    static void Update(float deltaTime = 0.0f);
+
+    //==================================================
+    // 入力の記録・再生
+    //==================================================
+
+    /// @brief 入力の記録開始。乱数を新しいシード値で初期化し直し、そのシード値も記録する
+    static void StartRecording();
+
+    /// @brief 入力の記録終了
+    /// @param filePath 記録の保存先のパス。空の場合は保存しない
+    /// @return 保存できたかどうか
+    static bool StopRecording(const std::string &filePath);
+
+    /// @brief 記録した入力の再生開始。再生中はデバイスを読まずに記録した入力を使う。
+    /// 乱数は記録開始時と同じシード値に戻す
+    /// @param filePath 記録のパス
+    /// @return 読み込めたかどうか
+    static bool StartReplay(const std::string &filePath);
+
+    /// @brief 記録した入力の再生終了
+    static void StopReplay();
+
+    /// @brief 記録中かどうか
+    static bool IsRecording();
+
+    /// @brief 再生中かどうか(最後のフレームを使った Update の後まで true)
+    static bool IsReplaying();
+
+    /// @brief 再生中のフレームに記録されていたフレーム時間を取得
+    /// @return フレーム時間(秒)
+    static float GetReplayDeltaTime();
+
+    /// @brief 再生したフレーム数を取得
+    static size_t GetReplayFrameIndex();
+
+    /// @brief 再生している記録のフレーム数を取得
+    static size_t GetReplayFrameCount();
 
     //==================================================
     // 入力状態の取得
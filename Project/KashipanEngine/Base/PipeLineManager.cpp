@@ -2,6 +2,7 @@
 #include "Common/JsoncLoader.h"
 #include "Common/DirectoryLoader.h"
 #include "Common/Logs.h"
+#include "Common/Profiler.h"
 #include "Base/PipeLines/EnumMaps.h"
 #include "Base/PipeLines/DefineMaps.h"
 #include "PipeLineManager.h"
@@ -11,6 +12,7 @@ using namespace KashipanEngine::PipeLine::EnumMaps;
 using namespace KashipanEngine::PipeLine::DefineMaps;
 
 PipeLineManager::PipeLineManager(DirectXCommon *dxCommon, const std::string &pipeLineSettingsPath) {
+    PROFILE_FUNCTION();
     Log("PipeLineManager constructor called.");
     if (!dxCommon) {
         LogSimple("DirectXCommon pointer is null.", kLogLevelFlagError);
@@ -33,6 +35,7 @@ PipeLineManager::PipeLineManager(DirectXCommon *dxCommon, const std::string &pip
 }
 
 void PipeLineManager::ReloadPipeLines() {
+    PROFILE_FUNCTION();
     Log("Reloading PipeLines.");
     pipeLines_.Reset();
     LoadPreset();
@@ -41,7 +44,7 @@ void PipeLineManager::ReloadPipeLines() {
     LogSimple("PipeLines reloaded successfully.");
 }
 
-void PipeLineManager::SetCommandListPipeLine(const std::string &pipeLineName) {
+void PipeLineManager::SetCommandListPipeLine(StringId pipeLineName) {
     // 現在設定しているパイプラインと同じなら何もしない
     if (currentPipeLineName_ == pipeLineName) {
         return;
@@ -56,7 +59,7 @@ void PipeLineManager::SetCommandListPipeLine(const std::string &pipeLineName) {
         dxCommon_->GetCommandList()->SetGraphicsRootSignature(pipeLineSet.rootSignature.Get());
         dxCommon_->GetCommandList()->SetPipelineState(pipeLineSet.pipelineState.Get());
     } else {
-        LogSimple("PipeLine not found: " + pipeLineName, kLogLevelFlagError);
+        LogSimple("PipeLine not found: " + pipeLineName.GetString(), kLogLevelFlagError);
         assert(false);
     }
 }
@@ -378,7 +381,7 @@ void PipeLineManager::LoadRenderPipeLine(const Json &json) {
     pipeLineInfo.pipeLineSet.rootSignature = rootSignature;
     pipeLineInfo.pipeLineSet.pipelineState = pipelineState;
     // セットにしたものをマップに登録
-    pipeLineInfos_[name] = pipeLineInfo;
+    pipeLineInfos_[StringId::Intern(name)] = pipeLineInfo;
 
     LogSimple("Graphics pipeline created successfully: " + name, kLogLevelFlagInfo);
 }
@@ -502,7 +505,7 @@ void PipeLineManager::LoadComputePipeLine(const Json &json) {
     pipeLineInfo.pipeLineSet.rootSignature = rootSignature;
     pipeLineInfo.pipeLineSet.pipelineState = pipelineState;
     // セットにしたものをマップに登録
-    pipeLineInfos_[name] = pipeLineInfo;
+    pipeLineInfos_[StringId::Intern(name)] = pipeLineInfo;
 
     LogSimple("Compute pipeline state created successfully: " + name, kLogLevelFlagInfo);
 }
@@ -1,8 +1,10 @@
 #pragma once
 #include <json.hpp>
+#include <FlatHashMap.h>
 #include "Base/PipeLines/PipeLines.h"
 #include "Base/PipeLines/ShaderReflection.h"
 #include "Common/PipeLineSet.h"
+#include "Common/StringId.h"
 
 namespace KashipanEngine {
 using Json = nlohmann::json;
@@ -36,23 +38,23 @@ public:
     /// @brief パイプライン情報の取得
     /// @param pipeLineName パイプラインの名前
     /// @return PipeLineInfoの参照
-    [[nodiscard]] PipeLineInfo &GetPipeLine(const std::string &pipeLineName) {
+    [[nodiscard]] PipeLineInfo &GetPipeLine(StringId pipeLineName) {
         return pipeLineInfos_.at(pipeLineName);
     }
 
     /// @brief パイプラインの存在確認
     /// @param pipeLineName パイプラインの名前
     /// @return 存在する場合はtrue、存在しない場合はfalse
-    [[nodiscard]] bool HasPipeLine(const std::string &pipeLineName) const {
+    [[nodiscard]] bool HasPipeLine(StringId pipeLineName) const {
         return pipeLineInfos_.find(pipeLineName) != pipeLineInfos_.end();
     }
 
     /// @brief コマンドリストにパイプラインを設定
     /// @param pipeLineName 設定するパイプラインの名前
-    void SetCommandListPipeLine(const std::string &pipeLineName);
+    void SetCommandListPipeLine(StringId pipeLineName);
     /// @brief 現在設定してるパイプラインをリセット
     void ResetCurrentPipeLine() {
-        currentPipeLineName_.clear();
+        currentPipeLineName_ = StringId();
     }
 
 private:
@@ -118,7 +120,7 @@ private:
     /// @brief パイプラインの設定データ
     PipeLines pipeLines_;
     /// @brief パイプライン情報のマップ
-    std::unordered_map<std::string, PipeLineInfo> pipeLineInfos_;
+    MyStd::FlatHashMap<StringId, PipeLineInfo> pipeLineInfos_;
     /// @brief シェーダーリフレクション用クラス
     std::unique_ptr<ShaderReflection> shaderReflection_;
 
@@ -129,7 +131,7 @@ private:
     /// @brief プリセットのフォルダ名のマップ
     std::unordered_map<std::string, std::string> presetFolderNames_;
     /// @brief 現在設定しているパイプラインの名前
-    std::string currentPipeLineName_;
+    StringId currentPipeLineName_;
 
     /// @brief 各読み込み関数のマップ
     const std::unordered_map<std::string, std::function<void(const Json &)>> kLoadFunctions_ = {
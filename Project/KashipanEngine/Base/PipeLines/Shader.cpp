@@ -37,8 +37,8 @@ void Shader::AddShader(const std::string &shaderName, const std::string & filePa
     std::wstring wProfile = ConvertString(profile);
     // シェーダーをコンパイルしてIDxcBlobを取得
     IDxcBlob *shaderBlob = CompileShader(wFilePath, wProfile.c_str());
-    // 取得したIDxcBlobをシェーダーキャッシュに追加
-    shaderCache_[shaderName] = shaderBlob;
+    // 取得したIDxcBlobをシェーダーキャッシュに追加(参照は1つだけなので、増やさずに所有権ごと渡す)
+    shaderCache_[shaderName].Attach(shaderBlob);
 }
 
 IDxcBlob *Shader::CompileShader(const std::wstring &filePath, const wchar_t *profile) {
@@ -112,6 +112,9 @@ IDxcBlob *Shader::CompileShader(const std::wstring &filePath, const wchar_t *pro
     // コンパイル完了のログを出力
     LogSimple(std::format(L"Compile Succeeded, path:{}, profile:{}", filePath, profile));
     // もう使わないリソースを解放
+    if (shaderError != nullptr) {
+        shaderError->Release();
+    }
     shaderSource->Release();
     shaderResult->Release();
 
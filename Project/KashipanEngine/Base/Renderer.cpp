@@ -1,4 +1,5 @@
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 #include "Renderer.h"
@@ -18,6 +19,8 @@
 #include "Common/ConvertColor.h"
 #include "Common/Descriptors/SRV.h"
 #include "Common/Descriptors/DSV.h"
+#include "Common/Profiler.h"
+#include "Common/FrameAllocator.h"
 #include "Objects/Particle.h" // 追加
 
 #define M_PI (4.0f * std::atanf(1.0f))
@@ -37,14 +40,9 @@ DirectionalLight sDefaultDirectionalLight = {
     1.0f
 };
 
-// レンダリングパイプライン名でのソート用関数
-bool ComparePipelineNameObject(const Renderer::ObjectState &a, const Renderer::ObjectState &b) {
-    return a.pipeLineName < b.pipeLineName;
-}
-// レンダリングパイプライン名でのソート用関数
-bool ComparePipelineNameLine(const Renderer::LineState &a, const Renderer::LineState &b) {
-    return a.pipeLineName < b.pipeLineName;
-}
+// 既定のパイプライン名
+STRING_ID_CONSTANT(kObjectPipeLineName, "Object3d.Solid.BlendNormal");
+STRING_ID_CONSTANT(kParticlePipeLineName, "Particle.Solid.BlendNormal");
 
 } // namespace
 
@@ -107,8 +105,11 @@ Renderer::~Renderer() {
 }
 
 void Renderer::PreDraw() {
+    PROFILE_FUNCTION();
     // 平行光源をリセット
     directionalLight_ = nullptr;
+    // このフレームの描画リストを用意(前のフレームの領域は、フレーム単位のアロケータの切り替えでまとめて解放される)
+    drawList_.Reset(GetFrameResource());
 
     // 2D用のプロジェクション行列を設定
     projectionMatrix2D_ = MakeOrthographicMatrix(
@@ -121,8 +122,10 @@ void Renderer::PreDraw() {
         0.0f,
         100.0f
     );
-    static ID3D12DescriptorHeap *descriptorHeaps[] = { SRV::GetDescriptorHeap() };
-    dxCommon_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+    if (isCommandRecordingEnabled_) {
+        static ID3D12DescriptorHeap *descriptorHeaps[] = { SRV::GetDescriptorHeap() };
+        dxCommon_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+    }
 
     // デバッグカメラが有効ならデバッグカメラの処理
     if (isUseDebugCamera_) {
@@ -131,34 +134,18 @@ void Renderer::PreDraw() {
 }
 
 void Renderer::PostDraw() {
+    PROFILE_FUNCTION();
     // 光源が設定されていなければデフォルトの光源を設定
     if (directionalLight_ == nullptr) {
         directionalLight_ = &sDefaultDirectionalLight;
     }
 
-    // 線の描画
-    for (auto &line : drawLines_) {
-        DrawLine(&line);
-    }
-
+    // 描画リストの順番で描画する。最初に使うパイプラインは前に設定したものと同じでも設定し直させる
     pipeLineManager_->ResetCurrentPipeLine();
-    pipeLineManager_->SetCommandListPipeLine("Object3d.Solid.BlendNormal");
-
-    // 平行光源の設定
-    SetLightBuffer(directionalLight_);
-    // 通常のオブジェクトの描画
-    DrawCommon(drawObjects_);
-    // 半透明オブジェクトの描画
-    DrawCommon(drawAlphaObjects_);
-    // 2Dオブジェクトの描画
-    DrawCommon(draw2DObjects_);
+    drawList_.Submit(*this, kObjectPipeLineName);
 
     // 描画オブジェクトのクリア
-    drawObjects_.clear();
-    drawAlphaObjects_.clear();
-    draw2DObjects_.clear();
-    // グリッドラインのクリア
-    drawLines_.clear();
+    drawList_.Clear(GetFrameResource());
 }
 
 void Renderer::ToggleDebugCamera() {
@@ -172,25 +159,30 @@ void Renderer::SetCamera(Camera *camera) {
 
 void Renderer::DrawSetLine(LineState &lineState) {
     // ラインを追加
-    drawLines_.push_back(lineState);
+    drawList_.AddLine(lineState);
 }
 
 void Renderer::DrawSet(const ObjectState &objectState, bool isUseCamera, bool isSemitransparent) {
-    // カメラが設定されていないものは2Dオブジェクトとして扱う
-    if (isUseCamera == false) {
-        draw2DObjects_.push_back(objectState);
-    } else {
-        // カメラが設定されているものは3Dオブジェクトとして扱う
-        if (isSemitransparent) {
-            // 半透明オブジェクトとして扱う
-            drawAlphaObjects_.push_back(objectState);
-        } else {
-            // 通常のオブジェクトとして扱う
-            drawObjects_.push_back(objectState);
-        }
+    // カメラが設定されていないものは2Dオブジェクト、設定されているものは3Dオブジェクトとして扱う
+    drawList_.AddObject(objectState, isUseCamera, isSemitransparent);
+}
+
+void Renderer::DrawSetText(const TextBatcher::TextState &textState) {
+    // 文字の頂点は PostDraw でまとめて生成する
+    drawList_.AddText(textState);
+}
+
+void Renderer::SetPipeLine(StringId pipeLineName) {
+    if (isCommandRecordingEnabled_) {
+        pipeLineManager_->SetCommandListPipeLine(pipeLineName);
     }
 }
 
+void Renderer::BeginObjects() {
+    // 平行光源の設定
+    SetLightBuffer(directionalLight_);
+}
+
 void Renderer::SetLightBuffer(DirectionalLight *light) {
     // 光源のリソースを生成
     static auto directionalLightResource = PrimitiveDrawer::CreateBufferResources(sizeof(DirectionalLight));
@@ -207,91 +199,169 @@ void Renderer::SetLightBuffer(DirectionalLight *light) {
     directionalLightData->viewProjectionMatrix = light->viewProjectionMatrix;
 
     // CBufferの場所を指定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightResource->GetGPUVirtualAddress());
-}
-
-void Renderer::DrawCommon(std::vector<ObjectState> &objects) {
-    // 描画処理
-    for (auto &object : objects) {
-        DrawCommon(&object);
+    if (isCommandRecordingEnabled_) {
+        dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightResource->GetGPUVirtualAddress());
     }
 }
 
-void Renderer::DrawCommon(ObjectState *objectState) {
-    pipeLineManager_->SetCommandListPipeLine(objectState->pipeLineName);
-
+void Renderer::DrawObject(ObjectState &objectState) {
     // Cameraがnullptrの場合は2D描画
-    if (objectState->isUseCamera == false) {
-        wvpMatrix2D_ = *objectState->worldMatrix * (viewMatrix2D_ * projectionMatrix2D_);
-        objectState->transformationMatrixMap->wvp = wvpMatrix2D_;
+    if (objectState.isUseCamera == false) {
+        wvpMatrix2D_ = *objectState.worldMatrix * (viewMatrix2D_ * projectionMatrix2D_);
+        objectState.transformationMatrixMap->wvp = wvpMatrix2D_;
     } else {
         if (isUseDebugCamera_) {
-            sDebugCamera->SetWorldMatrix(*objectState->worldMatrix);
+            sDebugCamera->SetWorldMatrix(*objectState.worldMatrix);
             sDebugCamera->CalculateMatrix();
-            objectState->transformationMatrixMap->wvp = sDebugCamera->GetWVPMatrix();
+            objectState.transformationMatrixMap->wvp = sDebugCamera->GetWVPMatrix();
         } else {
-            sCameraPtr->SetWorldMatrix(*objectState->worldMatrix);
+            sCameraPtr->SetWorldMatrix(*objectState.worldMatrix);
             sCameraPtr->CalculateMatrix();
-            objectState->transformationMatrixMap->wvp = sCameraPtr->GetWVPMatrix();
+            objectState.transformationMatrixMap->wvp = sCameraPtr->GetWVPMatrix();
         }
     }
 
-    dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(objectState->useTextureIndex).srvHandleGPU);
+    // 描画コマンドは DrawList が数える
+    if (!isCommandRecordingEnabled_) {
+        return;
+    }
+
+    dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(objectState.useTextureHandle).srvHandleGPU);
 
     // VBVを設定
-    dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &objectState->mesh->vertexBufferView);
+    dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &objectState.mesh->vertexBufferView);
     // IBVを設定
-    dxCommon_->GetCommandList()->IASetIndexBuffer(&objectState->mesh->indexBufferView);
+    dxCommon_->GetCommandList()->IASetIndexBuffer(&objectState.mesh->indexBufferView);
     // マテリアルCBufferの場所を指定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, objectState->materialResource->GetGPUVirtualAddress());
+    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, objectState.materialResource->GetGPUVirtualAddress());
     // TransformationMatrix用のCBufferの場所を指定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, objectState->transformationMatrixResource->GetGPUVirtualAddress());
+    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, objectState.transformationMatrixResource->GetGPUVirtualAddress());
 
     // 描画コマンドを発行
-    if (objectState->indexCount > 0) {
-        dxCommon_->GetCommandList()->DrawIndexedInstanced(objectState->indexCount, 1, 0, 0, 0);
+    if (objectState.indexCount > 0) {
+        dxCommon_->GetCommandList()->DrawIndexedInstanced(objectState.indexCount, 1, 0, 0, 0);
     } else {
-        dxCommon_->GetCommandList()->DrawInstanced(objectState->vertexCount, 1, 0, 0);
+        dxCommon_->GetCommandList()->DrawInstanced(objectState.vertexCount, 1, 0, 0);
     }
 }
 
-void Renderer::DrawLine(LineState *lineState) {
-    pipeLineManager_->SetCommandListPipeLine(lineState->pipeLineName);
-
+void Renderer::DrawLine(LineState &lineState) {
     if (isUseDebugCamera_) {
         sDebugCamera->SetWorldMatrix(Matrix4x4::Identity());
         sDebugCamera->CalculateMatrix();
-        lineState->transformationMatrixMap->wvp = sDebugCamera->GetWVPMatrix();
-        lineState->transformationMatrixMap->viewportInverse = sDebugCamera->GetViewportMatrix();
+        lineState.transformationMatrixMap->wvp = sDebugCamera->GetWVPMatrix();
+        lineState.transformationMatrixMap->viewportInverse = sDebugCamera->GetViewportMatrix();
     } else {
         sCameraPtr->SetWorldMatrix(Matrix4x4::Identity());
         sCameraPtr->CalculateMatrix();
-        lineState->transformationMatrixMap->wvp = sCameraPtr->GetWVPMatrix();
-        lineState->transformationMatrixMap->viewportInverse = sCameraPtr->GetViewportMatrix().Inverse();
+        lineState.transformationMatrixMap->wvp = sCameraPtr->GetWVPMatrix();
+        lineState.transformationMatrixMap->viewportInverse = sCameraPtr->GetViewportMatrix().Inverse();
+    }
+
+    // 描画コマンドは DrawList が数える
+    if (!isCommandRecordingEnabled_) {
+        return;
     }
 
     // TransformationMatrix用のCBufferの場所を指定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, lineState->transformationMatrixResource->GetGPUVirtualAddress());
+    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, lineState.transformationMatrixResource->GetGPUVirtualAddress());
     // LineOption用のCBufferの場所を指定
-    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, lineState->lineOptionResource->GetGPUVirtualAddress());
+    dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, lineState.lineOptionResource->GetGPUVirtualAddress());
 
     // VBVを設定
-    dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &lineState->mesh->vertexBufferView);
+    dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &lineState.mesh->vertexBufferView);
     // IBVを設定
-    dxCommon_->GetCommandList()->IASetIndexBuffer(&lineState->mesh->indexBufferView);
+    dxCommon_->GetCommandList()->IASetIndexBuffer(&lineState.mesh->indexBufferView);
 
     // 描画コマンドを発行
-    if (lineState->indexCount > 0) {
-        dxCommon_->GetCommandList()->DrawIndexedInstanced(lineState->indexCount, 1, 0, 0, 0);
+    if (lineState.indexCount > 0) {
+        dxCommon_->GetCommandList()->DrawIndexedInstanced(lineState.indexCount, 1, 0, 0, 0);
     } else {
-        dxCommon_->GetCommandList()->DrawInstanced(lineState->vertexCount, 1, 0, 0);
+        dxCommon_->GetCommandList()->DrawInstanced(lineState.vertexCount, 1, 0, 0);
+    }
+}
+
+void Renderer::PrepareTexts(const TextBatcher &textBatcher) {
+    PROFILE_FUNCTION();
+    if (!isCommandRecordingEnabled_) {
+        return;
+    }
+
+    // 頂点はワールド座標に変換済みなので、ワールド行列は単位行列にする
+    ReserveTextBuffers(textBatcher.GetGlyphCount(), textBatcher.GetBatches().size());
+    const auto &vertices = textBatcher.GetVertices();
+    std::memcpy(textMesh_->vertexBufferMap, vertices.data(), vertices.size() * sizeof(VertexData));
+    textTransformationMatrixMaps_[0]->wvp = viewMatrix2D_ * projectionMatrix2D_;
+    textTransformationMatrixMaps_[0]->world = Matrix4x4::Identity();
+    Camera *camera = isUseDebugCamera_ ? sDebugCamera.get() : sCameraPtr;
+    if (camera) {
+        camera->SetWorldMatrix(Matrix4x4::Identity());
+        camera->CalculateMatrix();
+        textTransformationMatrixMaps_[1]->wvp = camera->GetWVPMatrix();
+        textTransformationMatrixMaps_[1]->world = Matrix4x4::Identity();
+    }
+}
+
+void Renderer::DrawTextBatch(const TextBatcher &textBatcher, size_t batchIndex) {
+    const auto &batch = textBatcher.GetBatches()[batchIndex];
+    if (!isCommandRecordingEnabled_) {
+        return;
+    }
+    Camera *camera = isUseDebugCamera_ ? sDebugCamera.get() : sCameraPtr;
+    if (batch.isUseCamera && camera == nullptr) {
+        return;
+    }
+
+    *textMaterialMaps_[batchIndex] = batch.material;
+    const size_t transformIndex = batch.isUseCamera ? 1 : 0;
+    auto *commandList = dxCommon_->GetCommandList();
+    // 間に他のオブジェクトを描画するので、単位ごとにバッファを設定し直す
+    commandList->IASetVertexBuffers(0, 1, &textMesh_->vertexBufferView);
+    commandList->IASetIndexBuffer(&textMesh_->indexBufferView);
+    commandList->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(batch.textureHandle).srvHandleGPU);
+    commandList->SetGraphicsRootConstantBufferView(0, textMaterialResources_[batchIndex]->GetGPUVirtualAddress());
+    commandList->SetGraphicsRootConstantBufferView(1,
+        textTransformationMatrixResources_[transformIndex]->GetGPUVirtualAddress());
+    // インデックスは文字ごとに同じ並びなので、先頭の頂点をずらして描画する
+    commandList->DrawIndexedInstanced(batch.glyphCount * 6, 1, 0, static_cast<INT>(batch.vertexOffset), 0);
+}
+
+void Renderer::ReserveTextBuffers(size_t glyphCount, size_t batchCount) {
+    // 毎フレームGPUの完了を待っているので、足りなくなったら作り直してよい
+    if (glyphCount > textGlyphCapacity_) {
+        textGlyphCapacity_ = std::max<size_t>(glyphCount, std::max<size_t>(textGlyphCapacity_ * 2, 1024));
+        textMesh_ = PrimitiveDrawer::CreateMesh<VertexData>(
+            static_cast<UINT>(textGlyphCapacity_ * 4), static_cast<UINT>(textGlyphCapacity_ * 6));
+        for (size_t i = 0; i < textGlyphCapacity_; ++i) {
+            const uint32_t vertexIndex = static_cast<uint32_t>(i * 4);
+            uint32_t *index = &textMesh_->indexBufferMap[i * 6];
+            index[0] = vertexIndex + 0;
+            index[1] = vertexIndex + 1;
+            index[2] = vertexIndex + 2;
+            index[3] = vertexIndex + 1;
+            index[4] = vertexIndex + 3;
+            index[5] = vertexIndex + 2;
+        }
+    }
+    while (textMaterialResources_.size() < batchCount) {
+        auto &resource = textMaterialResources_.emplace_back(PrimitiveDrawer::CreateBufferResources(sizeof(Material)));
+        Material *materialMap = nullptr;
+        resource->Map(0, nullptr, reinterpret_cast<void **>(&materialMap));
+        textMaterialMaps_.push_back(materialMap);
+    }
+    for (size_t i = 0; i < textTransformationMatrixResources_.size(); ++i) {
+        if (!textTransformationMatrixResources_[i]) {
+            textTransformationMatrixResources_[i] = PrimitiveDrawer::CreateBufferResources(sizeof(TransformationMatrix));
+            textTransformationMatrixResources_[i]->Map(0, nullptr,
+                reinterpret_cast<void **>(&textTransformationMatrixMaps_[i]));
+        }
     }
 }
 
 void Renderer::DrawParticles(ParticleGroup *group) {
     if (!group) { return; }
 
-    pipeLineManager_->SetCommandListPipeLine("Particle.Solid.BlendNormal");
+    drawList_.SetPipeLine(*this, kParticlePipeLineName);
 
     Matrix4x4 viewProj;
     if (isUseDebugCamera_) {
@@ -308,8 +378,14 @@ void Renderer::DrawParticles(ParticleGroup *group) {
     UINT instanceCount = group->GetInstanceCount();
     if (instanceCount == 0) { return; }
 
+    // 描画コマンドを数える
+    drawList_.CountParticleDraw(instanceCount, group->GetIndexCount());
+    if (!isCommandRecordingEnabled_) {
+        return;
+    }
+
     dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(1, group->GetMatricesSrvGPU());
-    dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(group->GetTextureIndex()).srvHandleGPU);
+    dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, Texture::GetTexture(group->GetTextureHandle()).srvHandleGPU);
     dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(0, group->GetMaterialResource()->GetGPUVirtualAddress());
 
     dxCommon_->GetCommandList()->IASetVertexBuffers(0, 1, &group->GetMesh()->vertexBufferView);
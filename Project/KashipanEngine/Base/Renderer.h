@@ -1,14 +1,21 @@
 #pragma once
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 #include "Common/PipeLineSet.h"
 #include "Common/TransformationMatrix.h"
 #include "Common/VertexDataLine.h"
 #include "Common/LineOption.h"
+#include "Common/StringId.h"
+#include "Common/TextureHandle.h"
+#include "Common/DrawList.h"
+#include "Common/DrawStats.h"
 #include "3d/PrimitiveDrawer.h"
 #include "Math/Matrix4x4.h"
+#include "Font/TextBatcher.h"
 
 namespace KashipanEngine {
 
@@ -47,10 +54,10 @@ public:
         UINT vertexCount = 0;
         /// @brief インデックス数
         UINT indexCount = 0;
-        /// @brief テクスチャのインデックス
-        int useTextureIndex = -1;
+        /// @brief テクスチャのハンドル
+        TextureHandle useTextureHandle;
         /// @brief 使用するレンダリングパイプライン名
-        std::string pipeLineName = "Object3d.Solid.BlendNormal";
+        StringId pipeLineName = "Object3d.Solid.BlendNormal";
         /// @brief カメラを使用するかどうか
         bool isUseCamera = false;
     };
@@ -73,7 +80,7 @@ public:
         /// @brief インデックス数
         UINT indexCount = 0;
         /// @brief 使用するレンダリングパイプライン名
-        std::string pipeLineName = "Line.Normal";
+        StringId pipeLineName = "Line.Normal";
         /// @brief カメラを使用するかどうか
         bool isUseCamera = false;
     };
@@ -130,23 +137,66 @@ public:
     /// @param isSemitransparent 半透明オブジェクトかどうか
     void DrawSet(const ObjectState &objectState, bool isUseCamera, bool isSemitransparent);
 
+    /// @brief 描画するテキスト情報の設定。
+    /// テキストの文字はパイプライン・マテリアル・フォントのページごとにまとめて描画する。
+    /// カメラを使うテキストは半透明オブジェクトの後に描画する。
+    /// 2Dのテキストは2Dオブジェクトとの追加した順番を保ち、間に2Dオブジェクトを挟まないテキストだけをまとめる
+    /// @param textState 描画するテキスト情報
+    void DrawSetText(const TextBatcher::TextState &textState);
+
     /// @brief パーティクル描画
     /// @param group パーティクルグループ
     void DrawParticles(ParticleGroup *group);
 
+    /// @brief コマンドリストへの記録の設定。
+    /// 無効にすると行列の計算や描画コマンドの数え上げだけ行い、GPUへのコマンドは積まない(ヘッドレスモード用)
+    /// @param isEnabled コマンドリストに記録するかどうか
+    void SetCommandRecordingEnabled(bool isEnabled) {
+        isCommandRecordingEnabled_ = isEnabled;
+    }
+
+    /// @brief コマンドリストに記録するかどうか
+    /// @return 記録するならtrue
+    bool IsCommandRecordingEnabled() const {
+        return isCommandRecordingEnabled_;
+    }
+
+    /// @brief 直近の PostDraw で発行した描画コマンドの数の取得
+    /// @return 描画コマンドの数
+    const DrawStats &GetDrawStats() const {
+        return drawList_.GetDrawStats();
+    }
+
+    // 以下は DrawList::Submit から呼ばれる描画先としての処理
+
+    /// @brief パイプラインの設定(切り替え回数は DrawList が数える)
+    void SetPipeLine(StringId pipeLineName);
+
+    /// @brief オブジェクトの描画の開始。オブジェクト用のパイプラインを設定した後に呼ばれる
+    void BeginObjects();
+
+    /// @brief 線の描画処理
+    void DrawLine(LineState &lineState);
+
+    /// @brief オブジェクトの描画処理
+    void DrawObject(ObjectState &objectState);
+
+    /// @brief まとめたテキストの頂点を、描画に使うバッファに書き込む
+    void PrepareTexts(const TextBatcher &textBatcher);
+
+    /// @brief まとめたテキストの1つの単位の描画処理
+    /// @param batchIndex まとめる単位のインデックス
+    void DrawTextBatch(const TextBatcher &textBatcher, size_t batchIndex);
+
 private:
     /// @brief 平行光源の設定
     /// @param light 平行光源へのポインタ
     void SetLightBuffer(DirectionalLight *light);
 
-    /// @brief 共通の描画処理
-    void DrawCommon(std::vector<ObjectState> &objectStates);
-
-    /// @brief 共通の描画処理
-    void DrawCommon(ObjectState *objectState);
-
-    /// @brief グリッド線の描画処理
-    void DrawLine(LineState *lineState);
+    /// @brief テキスト用のバッファを必要な大きさまで確保する
+    /// @param glyphCount 文字数
+    /// @param batchCount まとめる単位の数
+    void ReserveTextBuffers(size_t glyphCount, size_t batchCount);
 
     /// @brief WinAppインスタンス
     WinApp *winApp_ = nullptr;
@@ -159,16 +209,25 @@ private:
 
     /// @brief デバッグカメラ使用フラグ
     bool isUseDebugCamera_ = false;
+    /// @brief コマンドリストに記録するかどうか
+    bool isCommandRecordingEnabled_ = true;
     /// @brief 平行光源へのポインタ
     DirectionalLight *directionalLight_ = nullptr;
-    /// @brief 描画する線
-    std::vector<LineState> drawLines_;
-    /// @brief 描画するオブジェクト
-    std::vector<ObjectState> drawObjects_;
-    /// @brief 描画する半透明オブジェクト
-    std::vector<ObjectState> drawAlphaObjects_;
-    /// @brief 描画する2Dオブジェクト
-    std::vector<ObjectState> draw2DObjects_;
+    /// @brief 描画リスト。フレーム単位のアロケータから確保し、PreDraw で作り直す
+    DrawList<ObjectState, LineState> drawList_;
+
+    /// @brief テキストの文字の頂点を毎フレーム書き込むメッシュ
+    std::unique_ptr<Mesh<VertexData>> textMesh_;
+    /// @brief テキストのメッシュに入る文字数
+    size_t textGlyphCapacity_ = 0;
+    /// @brief まとめる単位ごとのマテリアル用のリソース
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> textMaterialResources_;
+    /// @brief まとめる単位ごとのマテリアルマップ
+    std::vector<Material *> textMaterialMaps_;
+    /// @brief テキスト用のTransformationMatrixのリソース(2D用とカメラ用)
+    std::array<Microsoft::WRL::ComPtr<ID3D12Resource>, 2> textTransformationMatrixResources_;
+    /// @brief テキスト用のTransformationMatrixマップ(2D用とカメラ用)
+    std::array<TransformationMatrix *, 2> textTransformationMatrixMaps_ = {};
 
     /// @brief 2D描画用のビュー行列
     Matrix4x4 viewMatrix2D_ = {};
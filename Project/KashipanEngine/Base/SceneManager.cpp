@@ -1,16 +1,21 @@
-#include <unordered_map>
+#include <algorithm>
+#include <FlatHashMap.h>
 #include "Common/Logs.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
 #include "SceneManager.h"
 
 namespace KashipanEngine {
 namespace {
 std::vector<std::string> sSceneNames;
-std::unordered_map<std::string, std::unique_ptr<SceneBase>> sScenes;
+MyStd::FlatHashMap<StringId, std::unique_ptr<SceneBase>> sScenes;
 SceneBase *sActiveScene = nullptr;
+StringId sActiveSceneName;
 } // namespace
 
 void SceneManager::AddScene(const std::string &sceneName, std::unique_ptr<SceneBase> scene) {
-    if (sScenes.find(sceneName) != sScenes.end()) {
+    const StringId sceneId = StringId::Intern(sceneName);
+    if (sScenes.find(sceneId) != sScenes.end()) {
         // 既に同名のシーンが存在する場合は警告
         Log("Scene with name '" + sceneName + "' already exists. Skipping addition.", kLogLevelFlagWarning);
         return;
@@ -20,23 +25,26 @@ void SceneManager::AddScene(const std::string &sceneName, std::unique_ptr<SceneB
     if (scene->IsInitialized()) {
         scene->Finalize();
     }
-    sScenes[sceneName] = std::move(scene);
+    SceneBase *scenePtr = scene.get();
+    sScenes[sceneId] = std::move(scene);
     sSceneNames.push_back(sceneName);
 
     // アクティブシーンがまだ設定されていない場合は、追加したシーンをアクティブにする
     if (sActiveScene == nullptr) {
-        sActiveScene = sScenes[sceneName].get();
+        sActiveScene = scenePtr;
+        sActiveSceneName = sceneId;
         sActiveScene->Initialize();
     }
 }
 
-void SceneManager::RemoveScene(const std::string &sceneName) {
+void SceneManager::RemoveScene(StringId sceneName) {
     auto it = sScenes.find(sceneName);
     if (it != sScenes.end()) {
-        sSceneNames.erase(std::remove(sSceneNames.begin(), sSceneNames.end(), sceneName), sSceneNames.end());
+        sSceneNames.erase(std::remove_if(sSceneNames.begin(), sSceneNames.end(),
+            [sceneName](const std::string &name) { return StringId(name) == sceneName; }), sSceneNames.end());
         sScenes.erase(it);
     } else {
-        Log("Scene with name '" + sceneName + "' does not exist. Cannot remove.", kLogLevelFlagWarning);
+        Log("Scene with name '" + sceneName.GetString() + "' does not exist. Cannot remove.", kLogLevelFlagWarning);
     }
 }
 
@@ -44,25 +52,29 @@ void SceneManager::ClearScenes() {
     sScenes.clear();
     sSceneNames.clear();
     sActiveScene = nullptr;
+    sActiveSceneName = StringId();
 }
 
-void SceneManager::SetActiveScene(const std::string &sceneName) {
+void SceneManager::SetActiveScene(StringId sceneName) {
     auto it = sScenes.find(sceneName);
     if (it != sScenes.end()) {
         if (sActiveScene->IsInitialized()) {
             sActiveScene->Finalize();
         }
         sActiveScene = it->second.get();
+        sActiveSceneName = sceneName;
         if (!sActiveScene->IsInitialized()) {
             sActiveScene->Initialize();
         }
 
     } else {
-        Log("Scene with name '" + sceneName + "' does not exist. Cannot set as active.", kLogLevelFlagWarning);
+        Log("Scene with name '" + sceneName.GetString() + "' does not exist. Cannot set as active.", kLogLevelFlagWarning);
     }
 }
 
 void SceneManager::UpdateActiveScene() {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kScene);
     if (sActiveScene) {
         sActiveScene->Update();
     } else {
@@ -70,7 +82,19 @@ void SceneManager::UpdateActiveScene() {
     }
 }
 
+void SceneManager::FixedUpdateActiveScene() {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kScene);
+    if (sActiveScene) {
+        sActiveScene->FixedUpdate();
+    } else {
+        Log("No active scene set. Cannot update.", kLogLevelFlagWarning);
+    }
+}
+
 void SceneManager::DrawActiveScene() {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kScene);
     if (sActiveScene) {
         sActiveScene->Draw();
     } else {
@@ -80,9 +104,9 @@ void SceneManager::DrawActiveScene() {
 
 std::string SceneManager::GetActiveSceneName() {
     if (sActiveScene) {
-        for (const auto &pair : sScenes) {
-            if (pair.second.get() == sActiveScene) {
-                return pair.first;
+        for (const auto &name : sSceneNames) {
+            if (StringId(name) == sActiveSceneName) {
+                return name;
             }
         }
     }
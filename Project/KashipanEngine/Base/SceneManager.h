@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include "Common/SceneBase.h"
+#include "Common/StringId.h"
 
 namespace KashipanEngine {
 
@@ -21,11 +22,13 @@ public:
         AddScene(sceneName, std::make_unique<T>(std::forward<Args>(args)...));
     }
     static void AddScene(const std::string &sceneName, std::unique_ptr<SceneBase> scene);
-    static void RemoveScene(const std::string &sceneName);
+    static void RemoveScene(StringId sceneName);
     static void ClearScenes();
-    static void SetActiveScene(const std::string &sceneName);
+    static void SetActiveScene(StringId sceneName);
 
     static void UpdateActiveScene();
+    /// @brief アクティブなシーンの固定ステップ更新。while (engine->BeginFixedUpdate()) の中で呼ぶ
+    static void FixedUpdateActiveScene();
     static void DrawActiveScene();
 
     static std::string GetActiveSceneName();
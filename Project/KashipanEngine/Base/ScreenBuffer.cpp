@@ -82,7 +82,7 @@ ScreenBuffer::ScreenBuffer(const std::string screenName, uint32_t width, uint32_
     textureData.srvHandleGPU = srvGPUHandle_;
     textureData.width = screenWidth_;
     textureData.height = screenHeight_;
-    textureIndex_ = Texture::AddData(textureData);
+    textureHandle_ = Texture::AddData(textureData);
 }
 
 void ScreenBuffer::Resize(uint32_t width, uint32_t height) {
@@ -122,12 +122,7 @@ void ScreenBuffer::Resize(uint32_t width, uint32_t height) {
     textureData.srvHandleGPU = srvGPUHandle_;
     textureData.width = screenWidth_;
     textureData.height = screenHeight_;
-    Texture::ChangeData(textureData, textureIndex_);
-}
-
-uint32_t ScreenBuffer::GetTextureIndex() const {
-    // テクスチャ管理クラスからインデックスを取得
-    return Texture::GetTexture(screenName_).index;
+    Texture::ChangeData(textureData, textureHandle_);
 }
 
 void ScreenBuffer::PreDraw() {
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <string>
 #include "Math/Vector2.h"
+#include "Common/TextureHandle.h"
 
 namespace KashipanEngine {
 
@@ -44,9 +45,11 @@ public:
         return screenName_;
     }
 
-    /// @brief スクリーンのテクスチャのインデックスを取得
-    /// @return スクリーンのテクスチャのインデックス
-    uint32_t GetTextureIndex() const;
+    /// @brief スクリーンのテクスチャのハンドルを取得
+    /// @return スクリーンのテクスチャのハンドル
+    const TextureHandle &GetTextureHandle() const {
+        return textureHandle_;
+    }
 
     /// @brief 現在のスケールを取得
     /// @return 現在のスケール
@@ -147,8 +150,8 @@ private:
     /// @brief シザー矩形
     D3D12_RECT scissorRect_ = {};
 
-    /// @brief スクリーンのテクスチャのインデックス
-    uint32_t textureIndex_ = 0;
+    /// @brief スクリーンのテクスチャのハンドル
+    TextureHandle textureHandle_;
 
     /// @brief 描画用リソース
     Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
@@ -9,11 +9,14 @@
 #include <cassert>
 #include <fstream>
 #include <format>
-#include <VectorMap.h>
+#include <SlotMap.h>
+#include <FlatHashMap.h>
 
 #include "Sound.h"
 #include "Common/Logs.h"
 #include "Common/JsoncLoader.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
 
 #pragma comment(lib, "xaudio2.lib")
 #pragma comment(lib, "mf.lib")
@@ -51,15 +54,49 @@ struct SoundData {
 Microsoft::WRL::ComPtr<IXAudio2> sXaudio2;
 /// @brief マスターボイス
 IXAudio2MasteringVoice *sMasterVoice;
-/// @brief 音声データのリスト
-MyStd::VectorMap<std::string, SoundData> sSoundData;
+/// @brief 音声データのリスト。スロット番号を音声のインデックスとして使う
+MyStd::NamedSlotMap<std::string, SoundData> sSoundData;
+
+/// @brief ハンドルから音声データを取得
+/// @param handle 音声のハンドル
+/// @return 音声データ。無効・アンロード済みのハンドルならエラーを出力してnullptr
+SoundData *FindSoundData(const SoundHandle &handle) {
+    SoundData *soundData = sSoundData.get(handle);
+    if (soundData == nullptr) {
+        Log(std::format("Invalid sound handle: index {} generation {}", handle.index, handle.generation),
+            kLogLevelFlagError);
+    }
+    return soundData;
+}
+
+/// @brief 音声データの解放
+void ReleaseSoundData(SoundData &soundData) {
+    if (soundData.pSourceVoice) {
+        soundData.pSourceVoice->DestroyVoice();
+        soundData.pSourceVoice = nullptr;
+    }
+    delete[] soundData.pBuffer;
+    soundData.pBuffer = nullptr;
+    soundData.bufferSize = 0;
+    soundData.wfex = {};
+}
+
+/// @brief 音声が再生中かどうか
+bool IsPlayingVoice(const SoundData &soundData) {
+    if (!soundData.pSourceVoice) {
+        return false;
+    }
+    XAUDIO2_VOICE_STATE state;
+    soundData.pSourceVoice->GetState(&state);
+    return state.BuffersQueued > 0;
+}
 
 //==================================================
 // テーブル
 //==================================================
 
 /// @brief ピッチテーブル
-std::unordered_map<std::string, float> sPitchTable = {
+MyStd::FlatHashMap<std::string, float> sPitchTable = {
     {"C0", -48.0f}, {"C#0", -47.0f}, {"D0", -46.0f}, {"D#0", -45.0f}, {"E0", -44.0f}, {"F0", -43.0f}, {"F#0", -42.0f}, {"G0", -41.0f}, {"G#0", -40.0f}, {"A0", -39.0f}, {"A#0", -38.0f}, {"B0", -37.0f},
     {"C1", -36.0f}, {"C#1", -35.0f}, {"D1", -34.0f}, {"D#1", -33.0f}, {"E1", -32.0f}, {"F1", -31.0f}, {"F#1", -30.0f}, {"G1", -29.0f}, {"G#1", -28.0f}, {"A1", -27.0f}, {"A#1", -26.0f}, {"B1", -25.0f},
     {"C2", -24.0f}, {"C#2", -23.0f}, {"D2", -22.0f}, {"D#2", -21.0f}, {"E2", -20.0f}, {"F2", -19.0f}, {"F#2", -18.0f}, {"G2", -17.0f}, {"G#2", -16.0f}, {"A2", -15.0f}, {"A#2", -14.0f}, {"B2", -13.0f},
@@ -105,21 +142,25 @@ void Sound::Finalize() {
         assert(SUCCEEDED(hr));
     }
 
+    // 音声データの解放(ボイスは XAudio2 より先に破棄する)
+    for (auto &soundData : sSoundData) {
+        ReleaseSoundData(soundData);
+    }
+    sSoundData.clear();
     // XAudio2の解放
     sXaudio2.Reset();
-    // 音声データの解放
-    for (size_t i = 0; i < sSoundData.size(); ++i) {
-        Unload(static_cast<int>(i));
-    }
 
     Log("XAudio2 finalized successfully.", kLogLevelFlagInfo);
 }
 
-int Sound::Load(const std::string &filePath, const std::string &soundName) {
+SoundHandle Sound::Load(const std::string &filePath, const std::string &soundName) {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kSound);
     // ファイルの重複読み込みを防止
-    if (sSoundData.find(filePath) != sSoundData.end()) {
+    const MyStd::SlotHandle loadedHandle = sSoundData.find(filePath);
+    if (loadedHandle.IsValid()) {
         Log("Sound already loaded: " + filePath, kLogLevelFlagWarning);
-        return static_cast<int>(sSoundData.find(filePath)->index);
+        return loadedHandle;
     }
 
     //==================================================
@@ -240,208 +281,190 @@ int Sound::Load(const std::string &filePath, const std::string &soundName) {
     data.pBuffer = new BYTE[mediaData.size()];
     std::memcpy(data.pBuffer, mediaData.data(), mediaData.size());
     data.pSourceVoice = nullptr;
-    sSoundData.push_back(filePath, data);
+    const MyStd::SlotHandle handle = sSoundData.insert(filePath, data);
 
     // 読み込んだ音声ファイルのログ
     Log(std::format("Load Sound: {} ({} bytes)", filePath, data.bufferSize), kLogLevelFlagInfo);
-    // 音声データのインデックスを返す
-    return static_cast<int>(sSoundData.size() - 1);
+    // 音声データのハンドルを返す
+    return handle;
 }
 
 void Sound::LoadFromJson(const std::string &jsonFilePath) {
-    Json soundsJson = LoadJsonc(jsonFilePath);
-    for (auto it = soundsJson["Sounds"].begin(); it != soundsJson["Sounds"].end(); ++it) {
+    static const JsonPath kSoundsPath("Sounds");
+    const Json soundsJson = LoadJsonc(jsonFilePath);
+    const Json *entries = kSoundsPath.Find(soundsJson);
+    if (entries == nullptr || !entries->is_object()) {
+        Log(std::format("Sounds not found in {}", jsonFilePath), kLogLevelFlagWarning);
+        return;
+    }
+    for (auto it = entries->begin(); it != entries->end(); ++it) {
         Load(it->get<std::string>(), it.key());
     }
 }
 
-int Sound::FindIndex(const std::string &filePath) {
-    auto it = sSoundData.find(filePath);
-    if (it != sSoundData.end()) {
-        return static_cast<int>(it->index);
-    }
-    return 0;
+SoundHandle Sound::FindHandle(const std::string &filePath) {
+    return sSoundData.find(filePath);
 }
 
-int Sound::FindIndexByName(const std::string &soundName) {
+SoundHandle Sound::FindHandleByName(const std::string &soundName) {
     for (size_t i = 0; i < sSoundData.size(); ++i) {
-        if (sSoundData[i].value.name == soundName) {
-            return static_cast<int>(i);
+        const SoundHandle handle = sSoundData.handle_at(i);
+        if (sSoundData[handle].name == soundName) {
+            return handle;
         }
     }
-    return 0;
+    return SoundHandle{};
 }
 
-void Sound::Unload(int index) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::Unload(const SoundHandle &handle) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
-    // 音声データの解放
-    delete[] sSoundData[index].value.pBuffer;
-    sSoundData[index].value.pBuffer = nullptr;
-    sSoundData[index].value.bufferSize = 0;
-    sSoundData[index].value.wfex = {};
+    // 音声データを解放して、ハンドルを無効にする
+    ReleaseSoundData(*soundData);
+    sSoundData.erase(handle);
 }
 
-void Sound::Play(int index, float volume, float pitch, bool loop) {
-    HRESULT hr;
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::Play(const SoundHandle &handle, float volume, float pitch, bool loop) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
-
     // 波形フォーマットを元にSourceVoiceの作成
-    hr = sXaudio2->CreateSourceVoice(
-        &sSoundData[index].value.pSourceVoice,
-        &sSoundData[index].value.wfex);
+    HRESULT hr = sXaudio2->CreateSourceVoice(&soundData->pSourceVoice, &soundData->wfex);
     if (FAILED(hr)) {
-        Log("Failed to create source voice: " + std::to_string(index), kLogLevelFlagError);
+        Log("Failed to create source voice: " + soundData->name, kLogLevelFlagError);
         assert(SUCCEEDED(hr));
     }
 
     // 再生する音声データの設定
     XAUDIO2_BUFFER buffer = { 0 };
-    buffer.AudioBytes = sSoundData[index].value.bufferSize;
-    buffer.pAudioData = sSoundData[index].value.pBuffer;
+    buffer.AudioBytes = soundData->bufferSize;
+    buffer.pAudioData = soundData->pBuffer;
     buffer.Flags = XAUDIO2_END_OF_STREAM;
     buffer.LoopCount = loop ? XAUDIO2_LOOP_INFINITE : 0;
 
     // 音声データの再生
-    hr = sSoundData[index].value.pSourceVoice->SubmitSourceBuffer(&buffer);
+    hr = soundData->pSourceVoice->SubmitSourceBuffer(&buffer);
     if (FAILED(hr)) {
-        Log("Failed to submit source buffer: " + std::to_string(index), kLogLevelFlagError);
+        Log("Failed to submit source buffer: " + soundData->name, kLogLevelFlagError);
         assert(SUCCEEDED(hr));
     }
     // 音声データの再生開始
-    hr = sSoundData[index].value.pSourceVoice->Start();
+    hr = soundData->pSourceVoice->Start();
     if (FAILED(hr)) {
-        Log("Failed to start source voice: " + std::to_string(index), kLogLevelFlagError);
+        Log("Failed to start source voice: " + soundData->name, kLogLevelFlagError);
         assert(SUCCEEDED(hr));
     }
     // 音声データのボリューム設定
-    sSoundData[index].value.pSourceVoice->SetVolume(volume);
+    soundData->pSourceVoice->SetVolume(volume);
     // 音声データのピッチ設定
-    sSoundData[index].value.pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(pitch));
+    soundData->pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(pitch));
 }
 
-void Sound::Stop(int index) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::Stop(const SoundHandle &handle) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
-
     // 音声データの停止
-    if (sSoundData[index].value.pSourceVoice) {
-        sSoundData[index].value.pSourceVoice->Stop();
-        sSoundData[index].value.pSourceVoice->DestroyVoice();
-        sSoundData[index].value.pSourceVoice = nullptr;
-    }
+    soundData->pSourceVoice->Stop();
+    soundData->pSourceVoice->DestroyVoice();
+    soundData->pSourceVoice = nullptr;
 }
 
 void Sound::StopAll() {
-    for (size_t i = 0; i < sSoundData.size(); ++i) {
-        Stop(static_cast<int>(i));
+    for (auto &soundData : sSoundData) {
+        if (IsPlayingVoice(soundData)) {
+            soundData.pSourceVoice->Stop();
+            soundData.pSourceVoice->DestroyVoice();
+            soundData.pSourceVoice = nullptr;
+        }
     }
 }
 
-void Sound::Pause(int index) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::Pause(const SoundHandle &handle) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
     // 音声データの一時停止
-    if (sSoundData[index].value.pSourceVoice) {
-        sSoundData[index].value.pSourceVoice->Stop();
-    }
+    soundData->pSourceVoice->Stop();
 }
 
-void Sound::Resume(int index) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::Resume(const SoundHandle &handle) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
     // 音声データの再開
-    if (sSoundData[index].value.pSourceVoice) {
-        sSoundData[index].value.pSourceVoice->Start();
-    }
+    soundData->pSourceVoice->Start();
 }
 
-bool Sound::IsPlaying(int index) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
-        return false;
-    }
-    if (!sSoundData[index].value.pSourceVoice) {
+bool Sound::IsPlaying(const SoundHandle &handle) {
+    const SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return false;
     }
     // 音声データの再生状態を取得
-    XAUDIO2_VOICE_STATE state;
-    sSoundData[index].value.pSourceVoice->GetState(&state);
-    return state.BuffersQueued > 0;
+    return IsPlayingVoice(*soundData);
 }
 
-void Sound::SetVolume(int index, float volume) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::SetVolume(const SoundHandle &handle, float volume) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
     // 音声データのボリューム設定
-    if (sSoundData[index].value.pSourceVoice) {
-        sSoundData[index].value.pSourceVoice->SetVolume(volume);
-    }
+    soundData->pSourceVoice->SetVolume(volume);
 }
 
-void Sound::SetPitch(int index, float pitch) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::SetPitch(const SoundHandle &handle, float pitch) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
     // 音声データのピッチ設定
-    if (sSoundData[index].value.pSourceVoice) {
-        sSoundData[index].value.pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(pitch));
-    }
+    soundData->pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(pitch));
 }
 
-void Sound::SetPitch(int index, char *pitch) {
-    if (index < 0 || index >= static_cast<int>(sSoundData.size())) {
-        Log("Invalid sound index: " + std::to_string(index), kLogLevelFlagError);
+void Sound::SetPitch(const SoundHandle &handle, char *pitch) {
+    SoundData *soundData = FindSoundData(handle);
+    if (soundData == nullptr) {
         return;
     }
     // 音声が再生されていない場合は何もしない
-    if (!IsPlaying(index)) {
+    if (!IsPlayingVoice(*soundData)) {
         return;
     }
     // 音声データのピッチ設定
-    if (sSoundData[index].value.pSourceVoice) {
-        auto it = sPitchTable.find(pitch);
-        if (it != sPitchTable.end()) {
-            sSoundData[index].value.pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(it->second));
-        } else {
-            Log("Invalid pitch name: " + std::string(pitch), kLogLevelFlagError);
-        }
+    auto it = sPitchTable.find(std::string_view(pitch));
+    if (it != sPitchTable.end()) {
+        soundData->pSourceVoice->SetFrequencyRatio(XAudio2SemitonesToFrequencyRatio(it->second));
+    } else {
+        Log("Invalid pitch name: " + std::string(pitch), kLogLevelFlagError);
     }
 }
 
-} // namespace KashipanEngine
-
+} // namespace KashipanEngine
\ No newline at end of file
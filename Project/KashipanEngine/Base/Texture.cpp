@@ -6,8 +6,12 @@
 #include "Common/JsoncLoader.h"
 #include "Common/ConvertString.h"
 #include "Common/Descriptors/SRV.h"
-#include <VectorMap.h>
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
+#include <SlotMap.h>
 #include <filesystem>
+#include <mutex>
+#include <unordered_map>
 
 namespace KashipanEngine {
 
@@ -15,45 +19,33 @@ namespace {
 
 /// @brief DirectXCommonインスタンス
 DirectXCommon *sDxCommon = nullptr;
-/// @brief テクスチャのデータ
-MyStd::VectorMap<std::string, TextureData> sTextureMap;
-
-/// @brief テクスチャファイルを読み込んで扱えるようにする
-/// @param filePath テクスチャファイルのパス
-/// @return 読み込んだテクスチャのScratchImage
-DirectX::ScratchImage LoadTexture(const std::string &filePath) {
-    // テクスチャファイルを読み込んで扱えるようにする
-    DirectX::ScratchImage image{};
-    std::wstring filePathW = ConvertString(filePath);
-    HRESULT hr = DirectX::LoadFromWICFile(
-        filePathW.c_str(),
-        DirectX::WIC_FLAGS_FORCE_SRGB,
-        nullptr,
-        image
-    );
-    if (FAILED(hr)) assert(SUCCEEDED(hr));
-
-    // ミップマップの作成
-    // サイズが1x1のテクスチャはミップマップを作成しない
-    if (image.GetMetadata().width == 1 && image.GetMetadata().height == 1) {
-        return image;
+/// @brief テクスチャのデータ。スロット番号をテクスチャのインデックスとして使う
+MyStd::NamedSlotMap<std::string, TextureData> sTextureMap;
+/// @brief デフォルトのテクスチャのハンドル
+TextureHandle sDefaultHandle;
+/// @brief 先読みしてデコード済みの画像(Load で取り出す)
+std::unordered_map<std::string, DirectX::ScratchImage> sPrefetchedImages;
+/// @brief 先読みした画像の排他制御
+std::mutex sPrefetchMutex;
+
+/// @brief 先読みした画像があれば取り出す
+bool TakePrefetchedImage(const std::string &filePath, DirectX::ScratchImage &out) {
+    std::lock_guard<std::mutex> lock(sPrefetchMutex);
+    auto it = sPrefetchedImages.find(filePath);
+    if (it == sPrefetchedImages.end()) {
+        return false;
     }
-    DirectX::ScratchImage mipImages{};
-    hr = DirectX::GenerateMipMaps(
-        image.GetImages(),
-        image.GetImageCount(),
-        image.GetMetadata(),
-        DirectX::TEX_FILTER_SRGB,
-        0,
-        mipImages
-    );
-    if (FAILED(hr)) assert(SUCCEEDED(hr));
-    
-    // ミップマップ付きのデータを返す
-    return mipImages;
+    out = std::move(it->second);
+    sPrefetchedImages.erase(it);
+    return true;
+}
+
+/// @brief デフォルトのテクスチャデータの取得
+const TextureData &GetDefaultTexture() {
+    return sTextureMap[sDefaultHandle];
 }
 
-void CreateTextureResource(const DirectX::TexMetadata &metadata) {
+void CreateTextureResource(const DirectX::TexMetadata &metadata, TextureData &textureData) {
     //==================================================
     // metadataを基にResourceの設定
     //==================================================
@@ -78,7 +70,7 @@ void CreateTextureResource(const DirectX::TexMetadata &metadata) {
     // Resourceを生成する
     //==================================================
 
-    auto textureResource = &sTextureMap.back().value.resource;
+    auto textureResource = &textureData.resource;
     HRESULT hr = sDxCommon->GetDevice()->CreateCommittedResource(
         &heapProperties,                // Heapの設定
         D3D12_HEAP_FLAG_NONE,           // Heapの特殊な設定
@@ -132,6 +124,38 @@ Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource *texture
 
 } // namespace
 
+DirectX::ScratchImage Texture::LoadImageData(const std::string &filePath, bool isGenerateMipMaps) {
+    // テクスチャファイルを読み込んで扱えるようにする
+    DirectX::ScratchImage image{};
+    std::wstring filePathW = ConvertString(filePath);
+    HRESULT hr = DirectX::LoadFromWICFile(
+        filePathW.c_str(),
+        DirectX::WIC_FLAGS_FORCE_SRGB,
+        nullptr,
+        image
+    );
+    if (FAILED(hr)) assert(SUCCEEDED(hr));
+
+    // ミップマップの作成
+    // サイズが1x1のテクスチャはミップマップを作成しない
+    if (!isGenerateMipMaps || (image.GetMetadata().width == 1 && image.GetMetadata().height == 1)) {
+        return image;
+    }
+    DirectX::ScratchImage mipImages{};
+    hr = DirectX::GenerateMipMaps(
+        image.GetImages(),
+        image.GetImageCount(),
+        image.GetMetadata(),
+        DirectX::TEX_FILTER_SRGB,
+        0,
+        mipImages
+    );
+    if (FAILED(hr)) assert(SUCCEEDED(hr));
+    
+    // ミップマップ付きのデータを返す
+    return mipImages;
+}
+
 void Texture::Initialize(DirectXCommon *dxCommon) {
     // nullチェック
     if (dxCommon == nullptr) {
@@ -142,7 +166,7 @@ void Texture::Initialize(DirectXCommon *dxCommon) {
     sDxCommon = dxCommon;
 
     // もしテクスチャが設定されていなかった時用のデフォルトテクスチャを読み込む
-    Load("Resources/white1x1.png");
+    sDefaultHandle = Load("Resources/white1x1.png");
 
     // 初期化完了のログを出力
     Log("Texture Initialized.");
@@ -152,42 +176,54 @@ void Texture::Initialize(DirectXCommon *dxCommon) {
 void Texture::Finalize() {
     // テクスチャのリソースを解放
     for (auto &textureData : sTextureMap) {
-        if (textureData.value.resource) {
-            textureData.value.resource.Reset();
+        if (textureData.resource) {
+            textureData.resource.Reset();
         }
-        if (textureData.value.intermediateResource) {
-            textureData.value.intermediateResource.Reset();
+        if (textureData.intermediateResource) {
+            textureData.intermediateResource.Reset();
         }
     }
     sTextureMap.clear();
+    sDefaultHandle = TextureHandle{};
+    {
+        // 使われなかった先読みの画像も捨てる
+        std::lock_guard<std::mutex> lock(sPrefetchMutex);
+        sPrefetchedImages.clear();
+    }
     // 終了完了のログを出力
     Log("Texture Finalized.");
 }
 
-uint32_t Texture::Load(const std::string &filePath, const std::string &textureName) {
+TextureHandle Texture::Load(const std::string &filePath, const std::string &textureName) {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kTexture);
     // ファイルの存在確認
     if (!std::filesystem::exists(filePath)) {
         Log(std::format("Texture file not found: {}", filePath), kLogLevelFlagError);
         // ファイルが存在しない場合はデフォルトのテクスチャを返す
-        return 0;
+        return sDefaultHandle;
     }
 
     // 読み込む前に同じ名前のテクスチャがあるか確認
-    if (sTextureMap.find(filePath) != sTextureMap.end()) {
+    const MyStd::SlotHandle loadedHandle = sTextureMap.find(filePath);
+    if (loadedHandle.IsValid()) {
         Log(std::format("Texture already loaded: {}", filePath), kLogLevelFlagWarning);
-        return sTextureMap[filePath].value.index;
+        return loadedHandle;
     }
     Log(std::format("Texture loading: {}", filePath), kLogLevelFlagInfo);
 
-    // テクスチャファイルを読み込んで扱えるようにする
-    DirectX::ScratchImage mipImages = LoadTexture(filePath);
+    // テクスチャファイルを読み込んで扱えるようにする(先読み済みならデコードを省く)
+    DirectX::ScratchImage mipImages;
+    if (!TakePrefetchedImage(filePath, mipImages)) {
+        mipImages = LoadImageData(filePath);
+    }
     // ミップマップのメタデータを取得
     const DirectX::TexMetadata &metadata = mipImages.GetMetadata();
 
     // テクスチャデータを作成
     TextureData texture = {
         (!textureName.empty()) ? textureName : filePath,
-        static_cast<uint32_t>(sTextureMap.size()),
+        0,
         nullptr,
         nullptr,
         // SRVを作成するDescriptorHeapの場所を決める
@@ -197,14 +233,17 @@ uint32_t Texture::Load(const std::string &filePath, const std::string &textureNa
         static_cast<uint32_t>(metadata.width),
         static_cast<uint32_t>(metadata.height)
     };
-    sTextureMap[filePath] = texture;
+    const MyStd::SlotHandle handle = sTextureMap.insert(filePath, texture);
+    TextureData &textureData = sTextureMap[handle];
+    textureData.index = handle.index;
+    textureData.handle = handle;
 
     // テクスチャリソースを作成
-    CreateTextureResource(metadata);
+    CreateTextureResource(metadata, textureData);
 
     // テクスチャリソースをアップロード
-    sTextureMap[filePath].value.intermediateResource = UploadTextureData(
-        sTextureMap[filePath].value.resource.Get(),
+    textureData.intermediateResource = UploadTextureData(
+        textureData.resource.Get(),
         mipImages
     );
 
@@ -220,16 +259,16 @@ uint32_t Texture::Load(const std::string &filePath, const std::string &textureNa
 
     // SRVの生成
     sDxCommon->GetDevice()->CreateShaderResourceView(
-        sTextureMap[filePath].value.resource.Get(),
+        textureData.resource.Get(),
         &srvDesc,
-        sTextureMap[filePath].value.srvHandleCPU
+        textureData.srvHandleCPU
     );
 
     // Barrierを元に戻す
     D3D12_RESOURCE_BARRIER barrier{};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = sTextureMap[filePath].value.resource.Get();
+    barrier.Transition.pResource = textureData.resource.Get();
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_GENERIC_READ;
     barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
@@ -238,73 +277,126 @@ uint32_t Texture::Load(const std::string &filePath, const std::string &textureNa
     // 読み込んだテクスチャとそのインデックスをログに出力
     LogSimple(std::format("Complete Load Texture: {} ({}x{}) index: {}",
         filePath,
-        sTextureMap[filePath].value.width,
-        sTextureMap[filePath].value.height,
-        static_cast<uint32_t>(sTextureMap[filePath].value.index)
+        textureData.width,
+        textureData.height,
+        textureData.index
     ), kLogLevelFlagInfo);
 
-    // テクスチャのインデックスを返す
-    return sTextureMap[filePath].value.index;
+    // テクスチャのハンドルを返す
+    return handle;
+}
+
+void Texture::Prefetch(const std::string &filePath) {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kTexture);
+    if (!std::filesystem::exists(filePath)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sPrefetchMutex);
+        if (sPrefetchedImages.contains(filePath)) {
+            return;
+        }
+    }
+    DirectX::ScratchImage image = LoadImageData(filePath);
+    std::lock_guard<std::mutex> lock(sPrefetchMutex);
+    sPrefetchedImages.try_emplace(filePath, std::move(image));
+}
+
+void Texture::PrefetchFromJson(const std::string &jsonFilePath) {
+    static const JsonPath kTexturesPath("Textures");
+    const Json texturesJson = LoadJsonc(jsonFilePath);
+    const Json *entries = kTexturesPath.Find(texturesJson);
+    if (entries == nullptr || !entries->is_object()) {
+        return;
+    }
+    for (const auto &entry : *entries) {
+        if (entry.is_string()) {
+            Prefetch(entry.get<std::string>());
+        }
+    }
 }
 
 void Texture::LoadFromJson(const std::string &jsonFilePath) {
-    Json texturesJson = LoadJsonc(jsonFilePath);
-    for (auto it = texturesJson["Textures"].begin(); it != texturesJson["Textures"].end(); ++it) {
+    static const JsonPath kTexturesPath("Textures");
+    const Json texturesJson = LoadJsonc(jsonFilePath);
+    const Json *entries = kTexturesPath.Find(texturesJson);
+    if (entries == nullptr || !entries->is_object()) {
+        Log(std::format("Textures not found in {}", jsonFilePath), kLogLevelFlagWarning);
+        return;
+    }
+    for (auto it = entries->begin(); it != entries->end(); ++it) {
         Load(it->get<std::string>(), it.key());
     }
 }
 
-uint32_t Texture::AddData(const TextureData &textureData) {
-    // もし同じ名前のテクスチャがあれば、インデックスを返す
-    if (sTextureMap.find(textureData.name) != sTextureMap.end()) {
+TextureHandle Texture::AddData(const TextureData &textureData) {
+    // もし同じ名前のテクスチャがあれば、そのハンドルを返す
+    const TextureHandle existingHandle = sTextureMap.find(textureData.name);
+    if (existingHandle.IsValid()) {
         Log(std::format("Texture already exists: {}", textureData.name), kLogLevelFlagWarning);
-        return sTextureMap[textureData.name].value.index;
+        return existingHandle;
     }
     // 新しいテクスチャデータを追加
-    sTextureMap[textureData.name] = textureData;
-    sTextureMap[textureData.name].value.index = static_cast<uint32_t>(sTextureMap.size() - 1);
-    // テクスチャのインデックスを返す
-    return sTextureMap[textureData.name].value.index;
+    const TextureHandle handle = sTextureMap.insert(textureData.name, textureData);
+    sTextureMap[handle].index = handle.index;
+    sTextureMap[handle].handle = handle;
+    // テクスチャのハンドルを返す
+    return handle;
 }
 
-void Texture::ChangeData(const TextureData &textureData, uint32_t index) {
-    // インデックスが範囲外の場合は何もしない
-    if (index >= sTextureMap.size()) {
-        Log("TextureData index out of range.", kLogLevelFlagWarning);
+void Texture::ChangeData(const TextureData &textureData, const TextureHandle &handle) {
+    // 削除済みのハンドルの場合は何もしない
+    TextureData *target = sTextureMap.get(handle);
+    if (target == nullptr) {
+        Log("TextureData handle is invalid.", kLogLevelFlagWarning);
         return;
     }
     // テクスチャデータを変更
-    sTextureMap[index] = textureData;
-    sTextureMap[index].value.index = index;
+    *target = textureData;
+    target->index = handle.index;
+    target->handle = handle;
 }
 
-int32_t Texture::FindIndex(const std::string &filePath) {
-    // ファイルパスが存在しない場合は0を返す
-    if (sTextureMap.find(filePath) == sTextureMap.end()) {
-        return 0;
+TextureHandle Texture::FindHandle(const std::string &filePath) {
+    // ファイルパスが存在しない場合はデフォルトのテクスチャを返す
+    const TextureHandle handle = sTextureMap.find(filePath);
+    return handle.IsValid() ? handle : sDefaultHandle;
+}
+
+TextureHandle Texture::GetHandle(uint32_t index) {
+    // インデックスのスロットが空いている場合はデフォルトのテクスチャを返す
+    const TextureHandle handle = sTextureMap.make_handle(index);
+    if (!handle.IsValid()) {
+        Log(std::format("TextureData index not found: {}", index), kLogLevelFlagWarning);
+        return sDefaultHandle;
     }
-    // テクスチャのインデックスを返す
-    return static_cast<int32_t>(sTextureMap[filePath].value.index);
+    return handle;
 }
 
-const TextureData &Texture::GetTexture(uint32_t index) {
-    // インデックスが範囲外の場合はデフォルトのテクスチャを返す
-    if (index >= sTextureMap.size()) {
-        Log("TextureData index out of range.", kLogLevelFlagWarning);
-        return sTextureMap[0];
+const TextureData &Texture::GetTexture(const TextureHandle &handle) {
+    // 削除済み・無効なハンドルの場合はデフォルトのテクスチャを返す
+    const TextureData *textureData = sTextureMap.get(handle);
+    if (textureData == nullptr) {
+        if (handle.IsValid()) {
+            Log(std::format("TextureData handle is stale: index {} generation {}", handle.index, handle.generation),
+                kLogLevelFlagWarning);
+        }
+        return GetDefaultTexture();
     }
     // テクスチャデータを返す
-    return sTextureMap[index];
+    return *textureData;
 }
 
 const TextureData &Texture::GetTexture(const std::string &filePath) {
     // ファイルパスが存在しない場合はデフォルトのテクスチャを返す
-    if (sTextureMap.find(filePath) == sTextureMap.end()) {
+    const TextureHandle handle = sTextureMap.find(filePath);
+    if (!handle.IsValid()) {
         Log(std::format("TextureData not found: {}", filePath), kLogLevelFlagWarning);
-        return sTextureMap[0];
+        return GetDefaultTexture();
     }
     // テクスチャデータを返す
-    return sTextureMap[filePath];
+    return sTextureMap[handle];
 }
 
-} // namespace KashipanEngine
+} // namespace KashipanEngine
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <DirectXTex.h>
 
 #include "Common/TextureData.h"
+#include "Common/TextureHandle.h"
 
 namespace KashipanEngine {
 
@@ -26,8 +27,23 @@ public:
     /// @brief テクスチャの読み込み
     /// @param filePath 読み込むテクスチャのファイル名
     /// @param textureName テクスチャの名前(設定しなかった場合はファイルパスになる)
-    /// @return テクスチャを読み込んだインデックス
-    static uint32_t Load(const std::string &filePath, const std::string &textureName = "");
+    /// @return 読み込んだテクスチャのハンドル。読み込めなかった場合はデフォルトのテクスチャのハンドル
+    static TextureHandle Load(const std::string &filePath, const std::string &textureName = "");
+
+    /// @brief 画像ファイルの読み込み(デコードとミップマップの作成)だけを行う。GPUへの転送はしない
+    /// @param filePath 読み込む画像ファイルのパス
+    /// @param isGenerateMipMaps ミップマップを作成するかどうか
+    /// @return 読み込んだ画像
+    static DirectX::ScratchImage LoadImageData(const std::string &filePath, bool isGenerateMipMaps = true);
+
+    /// @brief 画像ファイルを先にデコードしておく。どのスレッドからでも呼べる。
+    /// 後で同じパスを Load したときはデコード済みの画像を使い、GPUへの転送だけを行う
+    /// @param filePath 読み込む画像ファイルのパス
+    static void Prefetch(const std::string &filePath);
+
+    /// @brief Jsonファイルに書かれたテクスチャの先読み。どのスレッドからでも呼べる
+    /// @param jsonFilePath Jsonファイルのパス(LoadFromJson と同じ形式)
+    static void PrefetchFromJson(const std::string &jsonFilePath);
 
     /// @brief Jsonファイルからのテクスチャの一括読み込み
     /// @param jsonFilePath Jsonファイルのパス
@@ -35,23 +51,29 @@ public:
 
     /// @brief テクスチャ管理クラスが管理するテクスチャの追加
     /// @param textureData 追加するテクスチャデータ
-    /// @return 追加したテクスチャのインデックス
-    static uint32_t AddData(const TextureData &textureData);
+    /// @return 追加したテクスチャのハンドル
+    static TextureHandle AddData(const TextureData &textureData);
 
     /// @brief テクスチャデータの変更
     /// @param textureData 変更するテクスチャデータ
-    /// @param index 変更するテクスチャのインデックス
-    static void ChangeData(const TextureData &textureData, uint32_t index);
+    /// @param handle 変更するテクスチャのハンドル
+    static void ChangeData(const TextureData &textureData, const TextureHandle &handle);
 
-    /// @brief テクスチャのインデックスの取得
+    /// @brief テクスチャのハンドルの取得
     /// @param filePath テクスチャのファイルパス
-    /// @return テクスチャのインデックス。 見つからなかった場合は0を返す
-    static int32_t FindIndex(const std::string &filePath);
+    /// @return テクスチャのハンドル。 見つからなかった場合はデフォルトのテクスチャのハンドル
+    static TextureHandle FindHandle(const std::string &filePath);
 
-    /// @brief テクスチャデータの取得
+    /// @brief インデックス(UI のデータなどに書かれた数値)からハンドルを取得する。
+    /// 取得した時点のハンドルを保持して使えば、その後に削除されたテクスチャは検出できる
     /// @param index テクスチャのインデックス
-    /// @return テクスチャデータ
-    static [[nodiscard]] const TextureData &GetTexture(uint32_t index);
+    /// @return テクスチャのハンドル。 見つからなかった場合はデフォルトのテクスチャのハンドル
+    static TextureHandle GetHandle(uint32_t index);
+
+    /// @brief テクスチャデータの取得
+    /// @param handle テクスチャのハンドル
+    /// @return テクスチャデータ。無効・削除済みのハンドルならデフォルトのテクスチャ
+    static [[nodiscard]] const TextureData &GetTexture(const TextureHandle &handle);
 
     /// @brief テクスチャデータの取得
     /// @param filePath テクスチャのファイルパス
@@ -11,7 +11,7 @@
 
 namespace KashipanEngine {
 
-WinApp::WinApp(const std::wstring &title, UINT windowStyle, int32_t width, int32_t height) {
+WinApp::WinApp(const std::wstring &title, UINT windowStyle, int32_t width, int32_t height, bool isVisible) {
     //==================================================
     // ウィンドウの初期化
     //==================================================
@@ -60,7 +60,9 @@ WinApp::WinApp(const std::wstring &title, UINT windowStyle, int32_t width, int32
     SetWindowLongPtr(hwnd_, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
 
     // ウィンドウを表示
-    ShowWindow(hwnd_, SW_NORMAL);
+    if (isVisible) {
+        ShowWindow(hwnd_, SW_NORMAL);
+    }
 
     // 初期化完了のログを出力
     Log("WinApp Initialized.");
@@ -185,10 +187,13 @@ int WinApp::ProccessMessage() {
         return -1;
     }
 
-    if (PeekMessage(&msg_, nullptr, 0, 0, PM_REMOVE)) {
+    // フレームの間は待機していて処理できないので、溜まっているメッセージは全て処理する
+    while (PeekMessage(&msg_, nullptr, 0, 0, PM_REMOVE)) {
         TranslateMessage(&msg_);
         DispatchMessage(&msg_);
-
+        if (msg_.message == WM_QUIT) {
+            break;
+        }
     }
 
     return 0;
@@ -20,7 +20,8 @@ enum WindowMode {
 /// @brief Windowsアプリクラス
 class WinApp final {
 public:
-    WinApp(const std::wstring &title, UINT windowStyle, int32_t width, int32_t height);
+    /// @brief コンストラクタ。isVisible が false ならウィンドウを作るだけで表示しない(ヘッドレスモード用)
+    WinApp(const std::wstring &title, UINT windowStyle, int32_t width, int32_t height, bool isVisible = true);
     ~WinApp();
 
     /// @brief ウィンドウクラス取得
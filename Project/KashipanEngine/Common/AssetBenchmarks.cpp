@@ -0,0 +1,295 @@
+#define NOMINMAX
+
+#include <Windows.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include "AssetBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+#include "Common/JsoncLoader.h"
+#include "Common/CookedJson.h"
+#include "Common/MemoryTracker.h"
+#include "Common/StringId.h"
+#include "Base/Texture.h"
+#include "Base/PipeLines/Shader.h"
+#include "Font/FontLoader.h"
+#include "Font/CookedFont.h"
+#include "Objects/Model.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 続けて読み込む回数
+const int kWarmRunCount = 5;
+
+/// @brief 1回の読み込みの計測結果
+struct Measurement {
+    double milliseconds = 0.0;
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+/// @brief 計測するアセット
+struct AssetEntry {
+    std::string category;
+    std::filesystem::path path;
+    /// @brief 読み込み前にキャッシュを捨てるファイル
+    std::vector<std::filesystem::path> cacheFiles;
+    std::function<void()> load;
+};
+
+// 直近の結果
+std::vector<AssetBenchmarkResult> sResults;
+
+/// @brief ファイルのキャッシュを捨てる。
+/// バッファリング無しで開き直すと、他に開いているハンドルが無ければキャッシュマネージャがそのファイルのページを破棄する。
+/// スタンバイリストに残ったページまでは消えないことがあるので、完全な初回読み込みには再起動が必要
+void EvictFileCache(const std::filesystem::path &path) {
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+}
+
+/// @brief 読み込み1回の時間と確保回数を計測する
+Measurement Measure(const std::function<void()> &load) {
+    const uint64_t allocationCount = MemoryTracker::GetTotalAllocationCount();
+    const uint64_t allocatedBytes = MemoryTracker::GetTotalAllocatedBytes();
+    const auto begin = std::chrono::steady_clock::now();
+    load();
+    const auto end = std::chrono::steady_clock::now();
+    Measurement measurement;
+    measurement.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+    measurement.allocationCount = MemoryTracker::GetTotalAllocationCount() - allocationCount;
+    measurement.allocatedBytes = MemoryTracker::GetTotalAllocatedBytes() - allocatedBytes;
+    return measurement;
+}
+
+/// @brief ファイルの中身をすべて読み込む
+bool ReadFileBytes(const std::string &filePath, std::string &out) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/// @brief フォントの解析結果を変換済み形式にして戻し、同じ内容になるかの確認
+void VerifyCookedFont(const std::string &fntFilePath) {
+    std::string bytes;
+    if (!ReadFileBytes(fntFilePath, bytes)) {
+        return;
+    }
+    const FontData parsed = ParseFNT(bytes);
+    const auto uncooked = UncookFont(CookFont(parsed, StringId::Hash(bytes)), nullptr);
+    if (!uncooked || *uncooked != parsed) {
+        Log("Cooked font does not match the parsed font: " + fntFilePath, kLogLevelFlagError);
+    }
+}
+
+/// @brief 拡張子の比較(大文字小文字を区別しない)
+bool HasExtension(const std::filesystem::path &path, const char *extension) {
+    std::string pathExtension = path.extension().string();
+    std::transform(pathExtension.begin(), pathExtension.end(), pathExtension.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return pathExtension == extension;
+}
+
+/// @brief フォルダ内のファイル全て(OBJはマテリアルファイルも読むのでまとめてキャッシュを捨てる)
+std::vector<std::filesystem::path> GetDirectoryFiles(const std::filesystem::path &directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    return files;
+}
+
+/// @brief 計測するアセットの列挙
+std::vector<AssetEntry> CollectAssets(const std::string &resourceDirectory, Shader &shader) {
+    std::vector<std::filesystem::path> paths;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(resourceDirectory, ec)) {
+        if (entry.is_regular_file()) {
+            paths.push_back(entry.path());
+        }
+    }
+    // 毎回同じ順番で計測する
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<AssetEntry> entries;
+    for (const auto &path : paths) {
+        const std::string pathString = path.generic_string();
+        if (HasExtension(path, ".obj")) {
+            entries.push_back({ "OBJ", path, GetDirectoryFiles(path.parent_path()), [path]() {
+                LoadObjFile(path.parent_path().generic_string(), path.filename().string());
+            } });
+        } else if (HasExtension(path, ".fnt")) {
+            VerifyCookedFont(pathString);
+            // 変換済みファイルが無ければ先に作っておく
+            LoadFNT(pathString.c_str());
+            entries.push_back({ "FNT", path, { path }, [pathString]() {
+                std::string bytes;
+                ReadFileBytes(pathString, bytes);
+                ParseFNT(bytes);
+            } });
+            // 元のファイルのハッシュの確認と変換済みファイルの読み込み(起動時と同じ流れ)
+            entries.push_back({ "FNTCooked", path, { path, pathString + kCookedFontExtension }, [pathString]() {
+                LoadFNT(pathString.c_str());
+            } });
+        } else if (HasExtension(path, ".png") || HasExtension(path, ".jpg") || HasExtension(path, ".bmp")) {
+            entries.push_back({ "Texture", path, { path }, [pathString]() {
+                Texture::LoadImageData(pathString, false);
+            } });
+            entries.push_back({ "TextureMips", path, { path }, [pathString]() {
+                Texture::LoadImageData(pathString, true);
+            } });
+        } else if (HasExtension(path, ".json") && pathString.find("PipeLines") != std::string::npos) {
+            entries.push_back({ "Json", path, { path }, [pathString]() {
+                LoadJsoncText(pathString);
+            } });
+            // 元のファイルのハッシュの確認と変換済みファイルの読み込み
+            entries.push_back({ "JsonCooked", path, { path, pathString + kCookedJsonExtension }, [pathString]() {
+                LoadJsonc(pathString);
+            } });
+
+            // シェーダーのプリセットならシェーダーのコンパイルも計測する
+            if (pathString.find("Preset/Shader/") == std::string::npos) {
+                continue;
+            }
+            const Json shaderJson = LoadJsoncText(pathString);
+            const auto shaderPath = GetJsonValue<std::string>(shaderJson, "Path");
+            const auto targetProfile = GetJsonValue<std::string>(shaderJson, "TargetProfile");
+            if (!shaderPath || !targetProfile || !std::filesystem::exists(*shaderPath)) {
+                continue;
+            }
+            const std::filesystem::path hlslPath = *shaderPath;
+            entries.push_back({ "Shader", hlslPath, GetDirectoryFiles(hlslPath.parent_path()),
+                [&shader, shaderFilePath = *shaderPath, profile = *targetProfile]() {
+                    // 前回のコンパイル結果を解放してから同じ名前で登録し直す
+                    shader.Clear();
+                    shader.AddShader("AssetBenchmark", shaderFilePath, profile);
+                } });
+        }
+    }
+    return entries;
+}
+
+} // namespace
+
+bool RunAssetBenchmarks(const std::string &resourceDirectory, const std::string &outputPath,
+    const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n================ Asset Benchmarks ================\n");
+    // シェーダーコンパイラの生成は計測に含めない
+    Shader shader;
+    const auto entries = CollectAssets(resourceDirectory, shader);
+
+    sResults.clear();
+    std::vector<MyStd::Benchmark::Result> comparableResults;
+    double totalColdMilliseconds = 0.0;
+    double totalWarmMilliseconds = 0.0;
+    for (const auto &entry : entries) {
+        AssetBenchmarkResult result;
+        result.category = entry.category;
+        result.path = entry.path.generic_string();
+        std::error_code ec;
+        result.fileBytes = static_cast<uint64_t>(std::filesystem::file_size(entry.path, ec));
+
+        // キャッシュを捨ててから1回読み込む
+        for (const auto &cacheFile : entry.cacheFiles) {
+            EvictFileCache(cacheFile);
+        }
+        result.coldMilliseconds = Measure(entry.load).milliseconds;
+
+        // 続けて読み込んだ時間の中央値を取る
+        std::vector<double> warmMilliseconds;
+        for (int i = 0; i < kWarmRunCount; ++i) {
+            const Measurement measurement = Measure(entry.load);
+            warmMilliseconds.push_back(measurement.milliseconds);
+            result.allocationCount = measurement.allocationCount;
+            result.allocatedBytes = measurement.allocatedBytes;
+        }
+        std::sort(warmMilliseconds.begin(), warmMilliseconds.end());
+        result.warmMilliseconds = warmMilliseconds[warmMilliseconds.size() / 2];
+
+        totalColdMilliseconds += result.coldMilliseconds;
+        totalWarmMilliseconds += result.warmMilliseconds;
+        LogSimple(std::format("{:<12} {:<60} {:10} bytes  cold {:9.3f} ms  warm {:9.3f} ms  {:8} allocs {:10} bytes",
+            result.category, result.path, result.fileBytes, result.coldMilliseconds, result.warmMilliseconds,
+            result.allocationCount, result.allocatedBytes));
+
+        MyStd::Benchmark::Result comparable;
+        comparable.name = result.category + ":" + result.path;
+        comparable.nanosecondsPerIteration = result.warmMilliseconds * 1000000.0;
+        comparable.minNanosecondsPerIteration = warmMilliseconds.front() * 1000000.0;
+        comparable.maxNanosecondsPerIteration = warmMilliseconds.back() * 1000000.0;
+        comparable.iterationCount = 1;
+        comparable.sampleCount = kWarmRunCount;
+        comparableResults.push_back(comparable);
+        sResults.push_back(std::move(result));
+    }
+
+    // 起動時間の目安として合計も比べる
+    MyStd::Benchmark::Result totalCold;
+    totalCold.name = "Total (cold)";
+    totalCold.nanosecondsPerIteration = totalColdMilliseconds * 1000000.0;
+    totalCold.iterationCount = 1;
+    totalCold.sampleCount = 1;
+    comparableResults.push_back(totalCold);
+    MyStd::Benchmark::Result totalWarm = totalCold;
+    totalWarm.name = "Total (warm)";
+    totalWarm.nanosecondsPerIteration = totalWarmMilliseconds * 1000000.0;
+    comparableResults.push_back(totalWarm);
+
+    // 詳細な結果の保存
+    Json json;
+    json["totalColdMilliseconds"] = totalColdMilliseconds;
+    json["totalWarmMilliseconds"] = totalWarmMilliseconds;
+    json["assets"] = Json::array();
+    for (const auto &result : sResults) {
+        json["assets"].push_back({
+            { "category", result.category },
+            { "path", result.path },
+            { "fileBytes", result.fileBytes },
+            { "coldMilliseconds", result.coldMilliseconds },
+            { "warmMilliseconds", result.warmMilliseconds },
+            { "allocationCount", result.allocationCount },
+            { "allocatedBytes", result.allocatedBytes },
+        });
+    }
+    const std::filesystem::path outputParentPath = std::filesystem::path(outputPath).parent_path();
+    if (!outputParentPath.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(outputParentPath, ec);
+    }
+    if (!SaveJsonc(json, outputPath)) {
+        Log("Failed to save asset benchmark results: " + outputPath, kLogLevelFlagError);
+    }
+
+    const bool isPassed = CheckBenchmarkRegressions(comparableResults, baselinePath, tolerance);
+    const std::string summary = std::format("Asset benchmarks finished: {} assets, cold {:.2f} ms, warm {:.2f} ms",
+        sResults.size(), totalColdMilliseconds, totalWarmMilliseconds);
+    if (isPassed) {
+        Log(summary);
+    } else {
+        Log(summary + ", REGRESSED (see warnings above)", kLogLevelFlagError);
+    }
+    return isPassed;
+}
+
+const std::vector<AssetBenchmarkResult> &GetAssetBenchmarkResults() {
+    return sResults;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KashipanEngine {
+
+/// @brief 1つのアセットの読み込みの計測結果
+struct AssetBenchmarkResult {
+    /// @brief 種類(OBJ, FNT, FNTCooked, Texture, TextureMips, Json, JsonCooked, Shader)
+    std::string category;
+    /// @brief アセットのパス
+    std::string path;
+    /// @brief ファイルのサイズ(バイト)
+    uint64_t fileBytes = 0;
+    /// @brief ファイルのキャッシュを捨ててから読み込んだ時間(ミリ秒)
+    double coldMilliseconds = 0.0;
+    /// @brief 続けて読み込んだ時間の中央値(ミリ秒)
+    double warmMilliseconds = 0.0;
+    /// @brief 1回の読み込みでのヒープの確保回数
+    uint64_t allocationCount = 0;
+    /// @brief 1回の読み込みで確保したサイズ(バイト)
+    uint64_t allocatedBytes = 0;
+};
+
+/// @brief 同梱のアセットをエンジンのCPU側の読み込み処理(OBJ・BMFontの解析と変換済みフォントの読み込み、画像のデコードとミップマップの作成、
+/// JSONの解析、シェーダーのコンパイル)で読み込み、アセットごとの時間・サイズ・確保回数を計測する。
+/// GPUへの転送は含まない。結果を outputPath に保存し、baselinePath の基準より遅くなったものをエラーとしてログに出力する
+/// @param resourceDirectory アセットを探すフォルダ
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものが無かったかどうか
+bool RunAssetBenchmarks(const std::string &resourceDirectory = "Resources",
+    const std::string &outputPath = "Logs/Benchmarks/assets.json",
+    const std::string &baselinePath = "Benchmarks/assets_baseline.json", double tolerance = 0.25);
+
+/// @brief 直近の RunAssetBenchmarks の結果の取得
+/// @return アセットごとの計測結果
+const std::vector<AssetBenchmarkResult> &GetAssetBenchmarkResults();
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include <array>
+#include <format>
+#include <random>
+#include <filesystem>
+#include "Benchmarks.h"
+#include "Common/Logs.h"
+#include "Common/JsoncLoader.h"
+#include "Common/Easings.h"
+#include "Common/Random.h"
+#include "Common/StringId.h"
+#include "Math/Vector3.h"
+#include "Math/Matrix4x4.h"
+#include "Math/Collider.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Plane.h"
+#include "Math/MathObjects/Lines.h"
+#include "Math/MathObjects/Triangle.h"
+#include "Math/MathObjects/AABB.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 入力データの数(2の累乗にしてインデックスをマスクで回す)
+const size_t kInputCount = 256;
+const size_t kInputMask = kInputCount - 1;
+// 入力データ生成用の乱数のシード(毎回同じ入力で計る)
+const uint32_t kInputSeed = 20240601u;
+
+/// @brief ベンチマークの入力データ。定数畳み込みされないよう実行時に乱数で作る
+struct BenchmarkInputs {
+    std::array<Vector3, kInputCount> vectors;
+    std::array<Vector3, kInputCount> directions;
+    std::array<float, kInputCount> scalars;
+    std::array<Matrix4x4, kInputCount> matrices;
+    std::array<Math::Sphere, kInputCount> spheres;
+    std::array<Math::Plane, kInputCount> planes;
+    std::array<Math::Triangle, kInputCount> triangles;
+    std::array<Math::AABB, kInputCount> aabbs;
+    std::array<Math::Line, kInputCount> lines;
+    std::array<Math::Ray, kInputCount> rays;
+    std::array<Math::Segment, kInputCount> segments;
+    std::vector<Vector3> controlPoints;
+};
+
+/// @brief 入力データの生成
+std::unique_ptr<BenchmarkInputs> CreateInputs() {
+    auto inputs = std::make_unique<BenchmarkInputs>();
+    std::mt19937 engine(kInputSeed);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    auto randomVector = [&]() { return Vector3(position(engine), position(engine), position(engine)); };
+    auto randomDirection = [&]() {
+        Vector3 v(position(engine), position(engine), position(engine));
+        return v.Length() > 0.0f ? v.Normalize() : Vector3(0.0f, 1.0f, 0.0f);
+    };
+
+    for (size_t i = 0; i < kInputCount; ++i) {
+        inputs->vectors[i] = randomVector();
+        inputs->directions[i] = randomDirection();
+        inputs->scalars[i] = unit(engine);
+        inputs->matrices[i].MakeAffine(
+            Vector3(size(engine), size(engine), size(engine)),
+            Vector3(position(engine), position(engine), position(engine)),
+            randomVector());
+        inputs->spheres[i] = Math::Sphere(randomVector(), size(engine));
+        inputs->planes[i] = Math::Plane(randomDirection(), position(engine));
+        inputs->triangles[i] = Math::Triangle(randomVector(), randomVector(), randomVector());
+        const Vector3 center = randomVector();
+        const Vector3 extent(size(engine), size(engine), size(engine));
+        inputs->aabbs[i] = Math::AABB(center - extent, center + extent);
+        inputs->lines[i].origin = randomVector();
+        inputs->lines[i].diff = randomDirection() * 20.0f;
+        inputs->rays[i].origin = randomVector();
+        inputs->rays[i].diff = randomDirection() * 20.0f;
+        inputs->segments[i].origin = randomVector();
+        inputs->segments[i].diff = randomDirection() * 20.0f;
+    }
+    for (int i = 0; i < 16; ++i) {
+        inputs->controlPoints.push_back(randomVector());
+    }
+    return inputs;
+}
+
+/// @brief 2つの入力の組での衝突判定のベンチマークの追加
+template<typename A, typename B>
+void AddCollisionBenchmark(MyStd::Benchmark &benchmark, const std::string &name,
+    const std::array<A, kInputCount> &a, const std::array<B, kInputCount> &b) {
+    benchmark.Add("Collider::IsCollision(" + name + ")", [&a, &b](uint64_t iterationCount) {
+        uint32_t hitCount = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            // 同じ組み合わせが続かないよう片方のインデックスをずらす
+            hitCount += Math::Collider::IsCollision(a[i & kInputMask], b[(i * 7 + 3) & kInputMask]) ? 1u : 0u;
+        }
+        DoNotOptimize(hitCount);
+    });
+}
+
+/// @brief マイクロベンチマークの登録
+void AddMicroBenchmarks(MyStd::Benchmark &benchmark, const BenchmarkInputs &inputs) {
+    //==================================================
+    // 行列
+    //==================================================
+
+    benchmark.Add("Matrix4x4::operator*", [&inputs](uint64_t iterationCount) {
+        Matrix4x4 result = inputs.matrices[0];
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            result = inputs.matrices[i & kInputMask] * inputs.matrices[(i + 1) & kInputMask];
+            DoNotOptimize(result);
+        }
+    });
+    benchmark.Add("Matrix4x4::Inverse", [&inputs](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Matrix4x4 result = inputs.matrices[i & kInputMask].Inverse();
+            DoNotOptimize(result);
+        }
+    });
+    benchmark.Add("Matrix4x4::MakeAffine", [&inputs](uint64_t iterationCount) {
+        Matrix4x4 result;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            result.MakeAffine(inputs.vectors[i & kInputMask], inputs.directions[(i + 1) & kInputMask],
+                inputs.vectors[(i + 2) & kInputMask]);
+            DoNotOptimize(result);
+        }
+    });
+
+    //==================================================
+    // ベクトル
+    //==================================================
+
+    benchmark.Add("Vector3::Slerp", [&inputs](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Vector3 result = Vector3::Slerp(inputs.directions[i & kInputMask], inputs.directions[(i + 1) & kInputMask],
+                inputs.scalars[i & kInputMask]);
+            DoNotOptimize(result);
+        }
+    });
+    benchmark.Add("Vector3::CatmullRomPosition", [&inputs](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Vector3 result = Vector3::CatmullRomPosition(inputs.controlPoints, inputs.scalars[i & kInputMask]);
+            DoNotOptimize(result);
+        }
+    });
+    benchmark.Add("Vector3::CatmullRomPosition(loop)", [&inputs](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Vector3 result = Vector3::CatmullRomPosition(inputs.controlPoints, inputs.scalars[i & kInputMask], true);
+            DoNotOptimize(result);
+        }
+    });
+
+    //==================================================
+    // 衝突判定
+    //==================================================
+
+    AddCollisionBenchmark(benchmark, "Sphere,Sphere", inputs.spheres, inputs.spheres);
+    AddCollisionBenchmark(benchmark, "Sphere,Plane", inputs.spheres, inputs.planes);
+    AddCollisionBenchmark(benchmark, "Plane,Line", inputs.planes, inputs.lines);
+    AddCollisionBenchmark(benchmark, "Plane,Ray", inputs.planes, inputs.rays);
+    AddCollisionBenchmark(benchmark, "Plane,Segment", inputs.planes, inputs.segments);
+    AddCollisionBenchmark(benchmark, "Triangle,Line", inputs.triangles, inputs.lines);
+    AddCollisionBenchmark(benchmark, "Triangle,Ray", inputs.triangles, inputs.rays);
+    AddCollisionBenchmark(benchmark, "Triangle,Segment", inputs.triangles, inputs.segments);
+    AddCollisionBenchmark(benchmark, "AABB,AABB", inputs.aabbs, inputs.aabbs);
+    AddCollisionBenchmark(benchmark, "AABB,Sphere", inputs.aabbs, inputs.spheres);
+    AddCollisionBenchmark(benchmark, "AABB,Line", inputs.aabbs, inputs.lines);
+    AddCollisionBenchmark(benchmark, "AABB,Ray", inputs.aabbs, inputs.rays);
+    AddCollisionBenchmark(benchmark, "AABB,Segment", inputs.aabbs, inputs.segments);
+
+    //==================================================
+    // イージング
+    //==================================================
+
+    for (int easeType = 0; easeType < EASINGS; ++easeType) {
+        benchmark.Add(std::format("Ease::Auto({})", Ease::easeName_[easeType]), [easeType](uint64_t iterationCount) {
+            float sum = 0.0f;
+            for (uint64_t i = 0; i < iterationCount; ++i) {
+                sum += Ease::Auto(static_cast<int>(i & 63), 63, 0.0f, 100.0f, easeType);
+            }
+            DoNotOptimize(sum);
+        });
+    }
+
+    //==================================================
+    // 乱数
+    //==================================================
+
+    benchmark.Add("GetRandomInt(min,max)", [](uint64_t iterationCount) {
+        int sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += GetRandomInt(0, 100);
+        }
+        DoNotOptimize(sum);
+    });
+    benchmark.Add("GetRandomFloat(min,max)", [](uint64_t iterationCount) {
+        float sum = 0.0f;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += GetRandomFloat(0.0f, 1.0f);
+        }
+        DoNotOptimize(sum);
+    });
+
+    //==================================================
+    // 文字列の識別子
+    //==================================================
+
+    // 実行時の文字列からの変換はハッシュ値の計算だけ(逆引き用の表には登録しない)
+    benchmark.Add("StringId(std::string)", [](uint64_t iterationCount) {
+        const std::string name = "Object3d.Solid.BlendNormal";
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += StringId(name).GetHash();
+        }
+        DoNotOptimize(sum);
+    });
+    // 名前を定義する所でだけ使う、登録込みの生成
+    benchmark.Add("StringId::Intern", [](uint64_t iterationCount) {
+        const std::string name = "Object3d.Solid.BlendNormal";
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += StringId::Intern(name).GetHash();
+        }
+        DoNotOptimize(sum);
+    });
+}
+
+} // namespace
+
+bool SaveBenchmarkResults(const std::vector<MyStd::Benchmark::Result> &results, const std::string &filePath) {
+    Json json;
+    json["benchmarks"] = Json::array();
+    for (const auto &result : results) {
+        json["benchmarks"].push_back({
+            { "name", result.name },
+            { "nanosecondsPerIteration", result.nanosecondsPerIteration },
+            { "minNanosecondsPerIteration", result.minNanosecondsPerIteration },
+            { "maxNanosecondsPerIteration", result.maxNanosecondsPerIteration },
+            { "iterationCount", result.iterationCount },
+            { "sampleCount", result.sampleCount },
+        });
+    }
+    const std::filesystem::path parentPath = std::filesystem::path(filePath).parent_path();
+    if (!parentPath.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(parentPath, ec);
+    }
+    if (!SaveJsonc(json, filePath)) {
+        Log("Failed to save benchmark results: " + filePath, kLogLevelFlagError);
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, double>> LoadBenchmarkBaseline(const std::string &filePath) {
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!std::filesystem::exists(filePath)) {
+        return baseline;
+    }
+    // 基準は手で書き換えることもあるので、変換済みファイルは作らずに読む
+    const Json json = LoadJsoncText(filePath);
+    const auto it = json.find("benchmarks");
+    if (it == json.end() || !it->is_array()) {
+        Log("Invalid benchmark baseline: " + filePath, kLogLevelFlagWarning);
+        return baseline;
+    }
+    for (const auto &entry : *it) {
+        auto name = GetJsonValue<std::string>(entry, "name");
+        auto nanoseconds = GetJsonValue<double>(entry, "nanosecondsPerIteration");
+        if (name && nanoseconds) {
+            baseline.emplace_back(std::move(*name), *nanoseconds);
+        }
+    }
+    return baseline;
+}
+
+bool CheckBenchmarkRegressions(const std::vector<MyStd::Benchmark::Result> &results,
+    const std::string &baselinePath, double tolerance) {
+    const auto baseline = LoadBenchmarkBaseline(baselinePath);
+    if (baseline.empty()) {
+        // 基準が無いまま通すと遅くなっても気づけないので失敗にする
+        Log("No benchmark baseline: " + baselinePath + ". Copy the saved results there to create it.", kLogLevelFlagError);
+        return false;
+    }
+    const auto regressions = MyStd::Benchmark::FindRegressions(results, baseline, tolerance);
+    for (const auto &regression : regressions) {
+        Log(std::format("Benchmark regression: {} {:.2f} ns -> {:.2f} ns ({:+.1f}%)",
+            regression.name, regression.baselineNanoseconds, regression.currentNanoseconds,
+            (regression.ratio - 1.0) * 100.0), kLogLevelFlagWarning);
+    }
+    return regressions.empty();
+}
+
+bool RunMicroBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n================ Micro Benchmarks ================\n");
+    const auto inputs = CreateInputs();
+    MyStd::Benchmark benchmark;
+    AddMicroBenchmarks(benchmark, *inputs);
+    const auto results = benchmark.Run();
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<40} {:10.2f} ns  (min {:.2f} ns, max {:.2f} ns, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration, result.minNanosecondsPerIteration,
+            result.maxNanosecondsPerIteration, result.iterationCount, result.sampleCount));
+    }
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance);
+    Log(std::format("Micro benchmarks finished: {} benchmarks, {}", results.size(), isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include <Benchmark.h>
+
+namespace KashipanEngine {
+
+/// @brief ベンチマークの結果をJSONで保存する
+/// @param results 保存する結果
+/// @param filePath 保存先のパス
+/// @return 保存できたかどうか
+bool SaveBenchmarkResults(const std::vector<MyStd::Benchmark::Result> &results, const std::string &filePath);
+
+/// @brief SaveBenchmarkResults で保存した結果を基準として読み込む
+/// @param filePath 基準のファイルへのパス
+/// @return 名前と1回あたりの時間(ナノ秒)の組。ファイルが無ければ空
+std::vector<std::pair<std::string, double>> LoadBenchmarkBaseline(const std::string &filePath);
+
+/// @brief 結果を基準と比べ、許容範囲を超えて遅くなったものを警告としてログに出力する。
+/// 基準のファイルが無い・読めない場合はエラーとして失敗を返す(基準は保存した結果をコピーして作る)
+/// @param results 今回の結果
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合(0.1なら10%まで)
+/// @return 基準があり、遅くなったものが無かったかどうか
+bool CheckBenchmarkRegressions(const std::vector<MyStd::Benchmark::Result> &results,
+    const std::string &baselinePath, double tolerance);
+
+/// @brief 数学・衝突判定・イージング・乱数のマイクロベンチマークを実行する。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものが無かったかどうか
+bool RunMicroBenchmarks(const std::string &outputPath = "Logs/Benchmarks/micro.json",
+    const std::string &baselinePath = "Benchmarks/micro_baseline.json", double tolerance = 0.15);
+
+} // namespace KashipanEngine
\ No newline at end of file
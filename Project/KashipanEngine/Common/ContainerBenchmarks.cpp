@@ -0,0 +1,263 @@
+#include <format>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <FlatHashMap.h>
+#include <SlotMap.h>
+#include <VectorMap.h>
+#include "ContainerBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 要素数(2の累乗にしてインデックスをマスクで回す)
+const uint32_t kElementCount = 4096;
+const uint32_t kElementMask = kElementCount - 1;
+// 検索する順番を散らすための奇数
+const uint32_t kLookupStride = 2654435761u;
+
+/// @brief リソースのパスに似たキーを作る
+std::vector<std::string> CreateKeys() {
+    std::vector<std::string> keys;
+    keys.reserve(kElementCount);
+    for (uint32_t i = 0; i < kElementCount; ++i) {
+        keys.push_back(std::format("Resources/Textures/texture_{:04}.png", i));
+    }
+    return keys;
+}
+
+/// @brief 要素を追加し終えた SlotMap
+MyStd::NamedSlotMap<std::string, uint64_t> CreateSlotMap(const std::vector<std::string> &keys,
+    std::vector<MyStd::SlotHandle> &handles) {
+    MyStd::NamedSlotMap<std::string, uint64_t> slotMap;
+    handles.clear();
+    for (uint32_t i = 0; i < kElementCount; ++i) {
+        handles.push_back(slotMap.insert(keys[i], i));
+    }
+    return slotMap;
+}
+
+/// @brief 要素を追加し終えた VectorMap
+MyStd::VectorMap<std::string, uint64_t> CreateVectorMap(const std::vector<std::string> &keys) {
+    MyStd::VectorMap<std::string, uint64_t> vectorMap;
+    for (uint32_t i = 0; i < kElementCount; ++i) {
+        vectorMap.push_back(keys[i], i);
+    }
+    return vectorMap;
+}
+
+// ハッシュマップのベンチマークの要素数
+const size_t kHashMapSizes[] = { 100, 1000, 10000, 100000, 1000000 };
+
+/// @brief 重複しないランダムなキーを作る。前半は追加するキー、後半は無いキーの検索に使う
+std::vector<uint64_t> CreateHashKeys(size_t count) {
+    std::mt19937_64 engine(count);
+    std::vector<uint64_t> keys(count * 2);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        // 奇数倍して重複しないようにしてから上位ビットを混ぜる
+        keys[i] = (static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ull) ^ (engine() & 0xFFFF000000000000ull);
+    }
+    return keys;
+}
+
+/// @brief 1つのハッシュマップの型について、要素数ごとのベンチマークを追加する
+template<typename Map>
+void AddHashMapBenchmarks(MyStd::Benchmark &benchmark, const char *mapName, size_t size,
+    const std::vector<uint64_t> &keys, std::vector<std::unique_ptr<Map>> &maps) {
+    // 検索・走査用の要素を入れ終えたマップ
+    auto &map = maps.emplace_back(std::make_unique<Map>());
+    for (size_t i = 0; i < size; ++i) {
+        (*map)[keys[i]] = i;
+    }
+    const Map *filled = map.get();
+
+    benchmark.Add(std::format("{}::insert/{}", mapName, size), [&keys, size](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Map inserted;
+            for (size_t k = 0; k < size; ++k) {
+                inserted.try_emplace(keys[k], k);
+            }
+            DoNotOptimize(inserted.size());
+        }
+    });
+    benchmark.Add(std::format("{}::find(hit)/{}", mapName, size), [&keys, size, filled](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (size_t k = 0; k < size; ++k) {
+                sum += filled->find(keys[k])->second;
+            }
+        }
+        DoNotOptimize(sum);
+    });
+    benchmark.Add(std::format("{}::find(miss)/{}", mapName, size), [&keys, size, filled](uint64_t iterationCount) {
+        uint64_t count = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (size_t k = size; k < size * 2; ++k) {
+                count += filled->find(keys[k]) == filled->end() ? 0 : 1;
+            }
+        }
+        DoNotOptimize(count);
+    });
+    benchmark.Add(std::format("{}::erase/{}", mapName, size), [&keys, size, filled](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            // コピーの時間も含むので、追加と比べる場合はその分を差し引くこと
+            Map erased(*filled);
+            for (size_t k = 0; k < size; ++k) {
+                erased.erase(keys[k]);
+            }
+            DoNotOptimize(erased.size());
+        }
+    });
+    benchmark.Add(std::format("{}::iterate/{}", mapName, size), [filled](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (const auto &[key, value] : *filled) {
+                sum += value;
+            }
+        }
+        DoNotOptimize(sum);
+    });
+}
+
+} // namespace
+
+bool RunContainerBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n============== Container Benchmarks ==============\n");
+    const std::vector<std::string> keys = CreateKeys();
+    std::vector<MyStd::SlotHandle> handles;
+    auto slotMap = CreateSlotMap(keys, handles);
+    auto vectorMap = CreateVectorMap(keys);
+
+    MyStd::Benchmark benchmark;
+    // 1回で1要素の取得。SlotMap は世代の確認込み、VectorMap は確認無しの添字アクセス
+    benchmark.Add("SlotMap::get(handle)", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            const uint64_t *value = slotMap.get(handles[static_cast<uint32_t>(i * kLookupStride) & kElementMask]);
+            sum += value != nullptr ? *value : 0;
+        }
+        DoNotOptimize(sum);
+    });
+    benchmark.Add("VectorMap::operator[](index)", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += vectorMap[static_cast<size_t>(static_cast<uint32_t>(i * kLookupStride) & kElementMask)].value;
+        }
+        DoNotOptimize(sum);
+    });
+    // 1回で1要素のキー検索
+    benchmark.Add("NamedSlotMap::find(key)", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += slotMap.find(keys[static_cast<uint32_t>(i * kLookupStride) & kElementMask]).index;
+        }
+        DoNotOptimize(sum);
+    });
+    benchmark.Add("VectorMap::find(key)", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sum += vectorMap.find(keys[static_cast<uint32_t>(i * kLookupStride) & kElementMask])->value;
+        }
+        DoNotOptimize(sum);
+    });
+    // 1回で全要素の走査
+    benchmark.Add("SlotMap::Iterate4096", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (const uint64_t value : slotMap) {
+                sum += value;
+            }
+        }
+        DoNotOptimize(sum);
+    });
+    benchmark.Add("VectorMap::Iterate4096", [&](uint64_t iterationCount) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (const auto &entry : vectorMap) {
+                sum += entry.value;
+            }
+        }
+        DoNotOptimize(sum);
+    });
+    // 1回で全要素の追加
+    benchmark.Add("NamedSlotMap::Insert4096", [&](uint64_t iterationCount) {
+        std::vector<MyStd::SlotHandle> insertedHandles;
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            auto inserted = CreateSlotMap(keys, insertedHandles);
+            DoNotOptimize(inserted.size());
+        }
+    });
+    benchmark.Add("VectorMap::PushBack4096", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            auto inserted = CreateVectorMap(keys);
+            DoNotOptimize(inserted.size());
+        }
+    });
+    // 1回で1要素の削除と追加(VectorMap の削除は後ろの要素を詰め直すので比べない)
+    benchmark.Add("SlotMap::EraseInsert", [&](uint64_t iterationCount) {
+        MyStd::SlotMap<uint64_t> churnMap;
+        std::vector<MyStd::SlotHandle> churnHandles;
+        for (uint32_t i = 0; i < kElementCount; ++i) {
+            churnHandles.push_back(churnMap.insert(i));
+        }
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            MyStd::SlotHandle &handle = churnHandles[static_cast<uint32_t>(i * kLookupStride) & kElementMask];
+            churnMap.erase(handle);
+            handle = churnMap.insert(i);
+        }
+        DoNotOptimize(churnMap.size());
+    });
+    const auto results = benchmark.Run();
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<40} {:10.2f} ns  (min {:.2f} ns, max {:.2f} ns, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration, result.minNanosecondsPerIteration,
+            result.maxNanosecondsPerIteration, result.iterationCount, result.sampleCount));
+    }
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance);
+    Log(std::format("Container benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+bool RunHashMapBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n============== HashMap Benchmarks ==============\n");
+    using FlatMap = MyStd::FlatHashMap<uint64_t, uint64_t>;
+    using StdMap = std::unordered_map<uint64_t, uint64_t>;
+
+    MyStd::Benchmark benchmark;
+    // 1e6 要素は1回が数十ミリ秒かかるので、サンプル数を減らす
+    benchmark.SetSampleCount(5);
+    std::vector<std::vector<uint64_t>> keySets;
+    keySets.reserve(std::size(kHashMapSizes));
+    std::vector<std::unique_ptr<FlatMap>> flatMaps;
+    std::vector<std::unique_ptr<StdMap>> stdMaps;
+    for (const size_t size : kHashMapSizes) {
+        const auto &keys = keySets.emplace_back(CreateHashKeys(size));
+        AddHashMapBenchmarks(benchmark, "FlatHashMap", size, keys, flatMaps);
+        AddHashMapBenchmarks(benchmark, "unordered_map", size, keys, stdMaps);
+    }
+    const auto results = benchmark.Run();
+    for (const auto &result : results) {
+        // 名前の最後の要素数で割って、要素あたりの時間も出す
+        const size_t size = std::stoull(result.name.substr(result.name.rfind('/') + 1));
+        LogSimple(std::format("{:<36} {:14.2f} ns  ({:7.2f} ns/element, min {:.2f} ns, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration, result.nanosecondsPerIteration / static_cast<double>(size),
+            result.minNanosecondsPerIteration, result.iterationCount, result.sampleCount));
+    }
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance);
+    Log(std::format("HashMap benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
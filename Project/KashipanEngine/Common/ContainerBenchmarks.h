@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief コンテナのベンチマークを実行する。
+/// テクスチャ・音声の管理に使う SlotMap と、以前使っていた VectorMap の追加・検索・走査の時間を比べる。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものが無かったかどうか
+bool RunContainerBenchmarks(const std::string &outputPath = "Logs/Benchmarks/containers.json",
+    const std::string &baselinePath = "Benchmarks/containers_baseline.json", double tolerance = 0.25);
+
+/// @brief ハッシュマップのベンチマークを実行する。
+/// FlatHashMap と std::unordered_map の追加・検索・削除・走査の時間を、要素数 1e2 から 1e6 まで比べる。
+/// 1回の計測は要素数分の操作なので、要素あたりの時間はログに出す
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものが無かったかどうか
+bool RunHashMapBenchmarks(const std::string &outputPath = "Logs/Benchmarks/hashmap.json",
+    const std::string &baselinePath = "Benchmarks/hashmap_baseline.json", double tolerance = 0.25);
+
+} // namespace KashipanEngine
\ No newline at end of file
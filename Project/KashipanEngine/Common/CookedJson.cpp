@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "CookedJson.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 変換済みファイルの識別子("KCFG")
+constexpr uint32_t kCookedMagic = 0x4746434B;
+// 変換済みファイルの形式のバージョン
+constexpr uint32_t kCookedVersion = 1;
+// 復元時に許可する入れ子の深さ
+constexpr uint32_t kMaxDepth = 512;
+// 一時ファイルの名前に付ける通し番号
+std::atomic<uint64_t> sTemporaryFileCounter = 0;
+
+/// @brief 変換済みファイルのヘッダー。後ろに値のデータが続く
+struct CookedHeader {
+    uint32_t magic;
+    uint32_t version;
+    // 元のファイルのハッシュ値
+    uint64_t sourceHash;
+    // データのサイズ
+    uint64_t payloadSize;
+};
+
+/// @brief 値の型タグ
+enum CookedTag : uint8_t {
+    kTagNull,
+    kTagFalse,
+    kTagTrue,
+    kTagInteger,
+    kTagUnsigned,
+    kTagFloat,
+    kTagString,
+    kTagArray,
+    kTagObject,
+};
+
+void WriteBytes(std::string &out, const void *data, size_t size) {
+    out.append(static_cast<const char *>(data), size);
+}
+
+template<typename T>
+void WriteValue(std::string &out, T value) {
+    WriteBytes(out, &value, sizeof(T));
+}
+
+void WriteString(std::string &out, const std::string &str) {
+    WriteValue(out, static_cast<uint32_t>(str.size()));
+    out += str;
+}
+
+void WriteJson(std::string &out, const Json &json) {
+    switch (json.type()) {
+        case Json::value_t::boolean:
+            WriteValue(out, json.get<bool>() ? kTagTrue : kTagFalse);
+            break;
+        case Json::value_t::number_integer:
+            WriteValue(out, kTagInteger);
+            WriteValue(out, json.get<Json::number_integer_t>());
+            break;
+        case Json::value_t::number_unsigned:
+            WriteValue(out, kTagUnsigned);
+            WriteValue(out, json.get<Json::number_unsigned_t>());
+            break;
+        case Json::value_t::number_float:
+            WriteValue(out, kTagFloat);
+            WriteValue(out, json.get<Json::number_float_t>());
+            break;
+        case Json::value_t::string:
+            WriteValue(out, kTagString);
+            WriteString(out, json.get_ref<const Json::string_t &>());
+            break;
+        case Json::value_t::array:
+            WriteValue(out, kTagArray);
+            WriteValue(out, static_cast<uint32_t>(json.size()));
+            for (const auto &element : json) {
+                WriteJson(out, element);
+            }
+            break;
+        case Json::value_t::object:
+            // キーはソート済みの順で書き出すので、復元時は末尾に追加していくだけで済む
+            WriteValue(out, kTagObject);
+            WriteValue(out, static_cast<uint32_t>(json.size()));
+            for (auto it = json.begin(); it != json.end(); ++it) {
+                WriteString(out, it.key());
+                WriteJson(out, it.value());
+            }
+            break;
+        default:
+            WriteValue(out, kTagNull);
+            break;
+    }
+}
+
+/// @brief 変換済みデータの読み込み用クラス。範囲外を読もうとしたら失敗にする
+class CookedReader {
+public:
+    explicit CookedReader(std::string_view bytes) : current_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+    bool IsSucceeded() const { return isSucceeded_ && current_ == end_; }
+
+    void ReadJson(Json &out, uint32_t depth) {
+        uint8_t tag = 0;
+        if (depth > kMaxDepth || !Read(tag)) {
+            isSucceeded_ = false;
+            return;
+        }
+        switch (tag) {
+            case kTagNull:
+                out = nullptr;
+                break;
+            case kTagFalse:
+                out = false;
+                break;
+            case kTagTrue:
+                out = true;
+                break;
+            case kTagInteger:
+                ReadNumber<Json::number_integer_t>(out);
+                break;
+            case kTagUnsigned:
+                ReadNumber<Json::number_unsigned_t>(out);
+                break;
+            case kTagFloat:
+                ReadNumber<Json::number_float_t>(out);
+                break;
+            case kTagString: {
+                std::string_view str;
+                if (ReadString(str)) {
+                    out = Json::string_t(str);
+                }
+                break;
+            }
+            case kTagArray: {
+                uint32_t count = 0;
+                if (!Read(count)) {
+                    break;
+                }
+                out = Json::array();
+                auto &array = out.get_ref<Json::array_t &>();
+                // 壊れたデータで巨大な確保をしないよう、残りのバイト数を上限にする
+                array.reserve(std::min<size_t>(count, static_cast<size_t>(end_ - current_)));
+                for (uint32_t i = 0; i < count && isSucceeded_; ++i) {
+                    ReadJson(array.emplace_back(), depth + 1);
+                }
+                break;
+            }
+            case kTagObject: {
+                uint32_t count = 0;
+                if (!Read(count)) {
+                    break;
+                }
+                out = Json::object();
+                auto &object = out.get_ref<Json::object_t &>();
+                for (uint32_t i = 0; i < count && isSucceeded_; ++i) {
+                    std::string_view key;
+                    if (!ReadString(key)) {
+                        break;
+                    }
+                    auto it = object.emplace_hint(object.end(), Json::string_t(key), nullptr);
+                    ReadJson(it->second, depth + 1);
+                }
+                break;
+            }
+            default:
+                isSucceeded_ = false;
+                break;
+        }
+    }
+
+private:
+    template<typename T>
+    bool Read(T &out) {
+        if (static_cast<size_t>(end_ - current_) < sizeof(T)) {
+            isSucceeded_ = false;
+            return false;
+        }
+        std::memcpy(&out, current_, sizeof(T));
+        current_ += sizeof(T);
+        return true;
+    }
+    template<typename T>
+    void ReadNumber(Json &out) {
+        T value{};
+        if (Read(value)) {
+            out = value;
+        }
+    }
+    bool ReadString(std::string_view &out) {
+        uint32_t size = 0;
+        if (!Read(size)) {
+            return false;
+        }
+        if (static_cast<size_t>(end_ - current_) < size) {
+            isSucceeded_ = false;
+            return false;
+        }
+        out = std::string_view(current_, size);
+        current_ += size;
+        return true;
+    }
+
+    const char *current_;
+    const char *end_;
+    bool isSucceeded_ = true;
+};
+
+} // namespace
+
+std::string CookJson(const Json &json, uint64_t sourceHash) {
+    std::string out(sizeof(CookedHeader), '\0');
+    WriteJson(out, json);
+    CookedHeader header{ kCookedMagic, kCookedVersion, sourceHash, out.size() - sizeof(CookedHeader) };
+    std::memcpy(out.data(), &header, sizeof(CookedHeader));
+    return out;
+}
+
+std::optional<Json> UncookJson(std::string_view bytes, const uint64_t *expectedHash) {
+    if (bytes.size() < sizeof(CookedHeader)) {
+        return std::nullopt;
+    }
+    CookedHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(CookedHeader));
+    if (header.magic != kCookedMagic || header.version != kCookedVersion ||
+        header.payloadSize != bytes.size() - sizeof(CookedHeader)) {
+        return std::nullopt;
+    }
+    if (expectedHash != nullptr && header.sourceHash != *expectedHash) {
+        return std::nullopt;
+    }
+    Json json;
+    CookedReader reader(bytes.substr(sizeof(CookedHeader)));
+    reader.ReadJson(json, 0);
+    if (!reader.IsSucceeded()) {
+        return std::nullopt;
+    }
+    return json;
+}
+
+std::optional<Json> LoadCookedJson(const std::string &cookedPath, const uint64_t *expectedHash) {
+    std::ifstream file(cookedPath, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return UncookJson(bytes, expectedHash);
+}
+
+bool WriteFileAtomically(const std::string &filepath, std::string_view bytes) {
+    // 同じパスへの同期・非同期の保存が重なっても一時ファイルを取り合わないよう、呼び出しごとに名前を変える
+    const std::string tempPath = filepath + "." + std::to_string(sTemporaryFileCounter.fetch_add(1)) + ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, filepath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool SaveCookedJson(const std::string &cookedPath, uint64_t sourceHash, const Json &json) {
+    return WriteFileAtomically(cookedPath, CookJson(json, sourceHash));
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+#include <json.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace KashipanEngine {
+
+using Json = nlohmann::json;
+
+// 変換済み(バイナリ)ファイルの拡張子。元のファイル名の後ろに付ける
+inline constexpr char kCookedJsonExtension[] = ".cooked";
+
+/// @brief JSONを変換済み形式(型タグと長さを前に置いた平坦なバイナリ)にする
+/// @param json 変換するJSON
+/// @param sourceHash 元のファイルのハッシュ値
+/// @return 変換済みのデータ
+std::string CookJson(const Json &json, uint64_t sourceHash);
+
+/// @brief 変換済み形式からJSONを復元する
+/// @param bytes 変換済みのデータ
+/// @param expectedHash 元のファイルのハッシュ値。nullptrなら検証しない
+/// @return 復元したJSON。形式が違うか古い場合は std::nullopt
+std::optional<Json> UncookJson(std::string_view bytes, const uint64_t *expectedHash);
+
+/// @brief 変換済みファイルの読み込み
+/// @param cookedPath 変換済みファイルのパス
+/// @param expectedHash 元のファイルのハッシュ値。nullptrなら検証しない
+/// @return 読み込んだJSON。無いか古い場合は std::nullopt
+std::optional<Json> LoadCookedJson(const std::string &cookedPath, const uint64_t *expectedHash);
+
+/// @brief ファイルをバイナリのまま一時ファイルに書いてから置き換える。
+/// 書きかけのファイルを読むことは無く、一時ファイルの名前は呼び出しごとに違うので同じパスへ同時に保存してもよい
+/// @param filepath 保存先のパス
+/// @param bytes 書き込む内容(改行コードも変換しない)
+/// @return 保存できたかどうか
+bool WriteFileAtomically(const std::string &filepath, std::string_view bytes);
+
+/// @brief 変換済みファイルの保存
+/// @param cookedPath 変換済みファイルのパス
+/// @param sourceHash 元のファイルのハッシュ値
+/// @param json 保存するJSON
+/// @return 保存できたかどうか
+bool SaveCookedJson(const std::string &cookedPath, uint64_t sourceHash, const Json &json);
+
+} // namespace KashipanEngine
\ No newline at end of file
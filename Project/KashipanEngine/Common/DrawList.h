@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include <LinearArena.h>
+#include "Common/DrawStats.h"
+#include "Common/StringId.h"
+#include "Font/TextBatcher.h"
+
+namespace KashipanEngine {
+
+/// @brief 1フレームの描画リスト。追加された描画を描画する順番に並べ、発行する描画コマンドを数える。
+/// GPUには触れず、コマンドの記録は Submit に渡す描画先が行う(Renderer と、テスト用の何も記録しない描画先)。
+/// ObjectState・LineState には pipeLineName・vertexCount・indexCount が必要
+/// @tparam ObjectState オブジェクトの描画情報
+/// @tparam LineState 線の描画情報
+template<typename ObjectState, typename LineState>
+class DrawList {
+public:
+    /// @brief 描画リストを空にして、指定のリソースから確保し直す
+    /// @param resource 描画リストの確保に使うリソース(フレーム単位のアロケータ)
+    void Reset(std::pmr::memory_resource *resource) {
+        MyStd::ResetPmrVector(lines_, resource);
+        MyStd::ResetPmrVector(objects_, resource);
+        MyStd::ResetPmrVector(alphaObjects_, resource);
+        MyStd::ResetPmrVector(objects2D_, resource);
+        textBatcher_.Clear(resource);
+    }
+
+    /// @brief 描画する線の追加
+    void AddLine(const LineState &lineState) {
+        lines_.push_back(lineState);
+    }
+
+    /// @brief 描画するオブジェクトの追加
+    /// @param isUseCamera カメラを使用しているかどうか。使わないものは2Dオブジェクトとして扱う
+    /// @param isSemitransparent 半透明オブジェクトかどうか
+    void AddObject(const ObjectState &objectState, bool isUseCamera, bool isSemitransparent) {
+        if (isUseCamera == false) {
+            objects2D_.push_back(objectState);
+        } else if (isSemitransparent) {
+            alphaObjects_.push_back(objectState);
+        } else {
+            objects_.push_back(objectState);
+        }
+    }
+
+    /// @brief 描画するテキストの追加。文字の頂点は Submit でまとめて生成する
+    void AddText(const TextBatcher::TextState &textState) {
+        TextBatcher::TextState layeredState = textState;
+        // 2Dのテキストは前に追加された2Dオブジェクトの数で区切り、その後ろに描画する
+        layeredState.layer = textState.isUseCamera ? 0 : static_cast<uint32_t>(objects2D_.size());
+        textBatcher_.Add(layeredState);
+    }
+
+    /// @brief パイプラインの切り替え。前と違うパイプラインなら切り替え回数を数える
+    /// @param target 描画先(SetPipeLine(StringId) を呼ぶ)
+    template<typename Target>
+    void SetPipeLine(Target &target, StringId pipeLineName) {
+        if (pipeLineName != lastPipeLineName_) {
+            lastPipeLineName_ = pipeLineName;
+            ++currentDrawStats_.pipeLineChangeCount;
+        }
+        target.SetPipeLine(pipeLineName);
+    }
+
+    /// @brief 追加した時点で描画されるパーティクルの描画コマンドを数える
+    /// @param instanceCount インスタンスの数
+    /// @param indexCount 1インスタンスのインデックスの数
+    void CountParticleDraw(uint32_t instanceCount, uint32_t indexCount) {
+        ++currentDrawStats_.drawCallCount;
+        ++currentDrawStats_.particleDrawCallCount;
+        currentDrawStats_.instanceCount += instanceCount;
+        currentDrawStats_.primitiveVertexCount += static_cast<uint64_t>(indexCount) * instanceCount;
+    }
+
+    /// @brief 追加した順番と種類に従って描画先に描画させ、このフレームの描画コマンドの数を確定させる。
+    /// 線、通常のオブジェクト、半透明オブジェクト、カメラを使うテキストの順に描画し、
+    /// 最後に2Dオブジェクトと2Dのテキストを追加した順番で描画する。
+    /// 描画先は SetPipeLine・BeginObjects・DrawLine・DrawObject・PrepareTexts・DrawTextBatch を持つ
+    /// @param target 描画先
+    /// @param objectPipeLineName オブジェクトの描画の前に設定するパイプライン名
+    template<typename Target>
+    void Submit(Target &target, StringId objectPipeLineName) {
+        // 線の描画
+        lastPipeLineName_ = StringId();
+        for (auto &line : lines_) {
+            SetPipeLine(target, line.pipeLineName);
+            ++currentDrawStats_.lineDrawCallCount;
+            CountDraw(line);
+            target.DrawLine(line);
+        }
+
+        lastPipeLineName_ = StringId();
+        SetPipeLine(target, objectPipeLineName);
+        target.BeginObjects();
+        // 通常のオブジェクトと半透明オブジェクトの描画
+        for (auto &object : objects_) {
+            DrawObject(target, object);
+        }
+        for (auto &object : alphaObjects_) {
+            DrawObject(target, object);
+        }
+
+        // テキストの頂点をまとめて生成
+        textBatcher_.Build();
+        const auto &batches = textBatcher_.GetBatches();
+        if (!batches.empty()) {
+            currentDrawStats_.textCount += static_cast<uint32_t>(textBatcher_.GetTextCount());
+            currentDrawStats_.textGlyphCount += static_cast<uint32_t>(textBatcher_.GetGlyphCount());
+            target.PrepareTexts(textBatcher_);
+        }
+        // カメラを使うテキストの描画
+        for (size_t i = 0; i < batches.size(); ++i) {
+            if (batches[i].isUseCamera) {
+                DrawTextBatch(target, i);
+            }
+        }
+
+        // 2Dのテキストの単位は layer の小さい順に並んでいるので、
+        // 各単位の前に、それより前に追加された2Dオブジェクトを描画する
+        size_t objectIndex = 0;
+        for (size_t i = 0; i < batches.size(); ++i) {
+            if (batches[i].isUseCamera) {
+                continue;
+            }
+            const size_t objectEnd = std::min<size_t>(batches[i].layer, objects2D_.size());
+            for (; objectIndex < objectEnd; ++objectIndex) {
+                DrawObject(target, objects2D_[objectIndex]);
+            }
+            DrawTextBatch(target, i);
+        }
+        for (; objectIndex < objects2D_.size(); ++objectIndex) {
+            DrawObject(target, objects2D_[objectIndex]);
+        }
+
+        // このフレームの描画コマンドの数を確定させる(パーティクルは Submit より前に描画される)
+        drawStats_ = currentDrawStats_;
+        currentDrawStats_ = DrawStats{};
+    }
+
+    /// @brief 描画リストを空にする(確保した領域はそのまま使う)
+    /// @param resource テキストの描画リストの確保に使うリソース
+    void Clear(std::pmr::memory_resource *resource) {
+        lines_.clear();
+        objects_.clear();
+        alphaObjects_.clear();
+        objects2D_.clear();
+        textBatcher_.Clear(resource);
+    }
+
+    /// @brief 描画する線の数
+    size_t GetLineCount() const { return lines_.size(); }
+    /// @brief 描画するオブジェクト(2Dオブジェクトを含む)の数
+    size_t GetObjectCount() const { return objects_.size() + alphaObjects_.size() + objects2D_.size(); }
+    /// @brief 直近の Submit で発行した描画コマンドの数
+    const DrawStats &GetDrawStats() const { return drawStats_; }
+
+private:
+    /// @brief 1つの描画コマンドを数える
+    template<typename State>
+    void CountDraw(const State &state) {
+        ++currentDrawStats_.drawCallCount;
+        ++currentDrawStats_.instanceCount;
+        currentDrawStats_.primitiveVertexCount += state.indexCount > 0 ? state.indexCount : state.vertexCount;
+    }
+
+    template<typename Target>
+    void DrawObject(Target &target, ObjectState &objectState) {
+        SetPipeLine(target, objectState.pipeLineName);
+        CountDraw(objectState);
+        target.DrawObject(objectState);
+    }
+
+    template<typename Target>
+    void DrawTextBatch(Target &target, size_t batchIndex) {
+        const auto &batch = textBatcher_.GetBatches()[batchIndex];
+        SetPipeLine(target, batch.pipeLineName);
+        ++currentDrawStats_.drawCallCount;
+        ++currentDrawStats_.textDrawCallCount;
+        ++currentDrawStats_.instanceCount;
+        currentDrawStats_.primitiveVertexCount += static_cast<uint64_t>(batch.glyphCount) * 6;
+        target.DrawTextBatch(textBatcher_, batchIndex);
+    }
+
+    /// @brief 描画する線
+    std::pmr::vector<LineState> lines_;
+    /// @brief 描画するオブジェクト
+    std::pmr::vector<ObjectState> objects_;
+    /// @brief 描画する半透明オブジェクト
+    std::pmr::vector<ObjectState> alphaObjects_;
+    /// @brief 描画する2Dオブジェクト
+    std::pmr::vector<ObjectState> objects2D_;
+    /// @brief 描画するテキストの文字をまとめるクラス
+    TextBatcher textBatcher_;
+    /// @brief 最後に設定したパイプライン名(切り替え回数の集計用)
+    StringId lastPipeLineName_;
+    /// @brief 集計中の描画コマンドの数
+    DrawStats currentDrawStats_;
+    /// @brief 直近のフレームの描画コマンドの数
+    DrawStats drawStats_;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+namespace KashipanEngine {
+
+/// @brief 1フレームに発行した描画コマンドの数
+struct DrawStats {
+    /// @brief 描画コマンドの数
+    uint32_t drawCallCount = 0;
+    /// @brief 描画したインスタンスの数
+    uint32_t instanceCount = 0;
+    /// @brief 描画したインデックス(インデックスが無いものは頂点)の数
+    uint64_t primitiveVertexCount = 0;
+    /// @brief パイプラインの切り替え回数
+    uint32_t pipeLineChangeCount = 0;
+    /// @brief 線の描画コマンドの数
+    uint32_t lineDrawCallCount = 0;
+    /// @brief パーティクルの描画コマンドの数
+    uint32_t particleDrawCallCount = 0;
+    /// @brief テキストの描画コマンドの数
+    uint32_t textDrawCallCount = 0;
+    /// @brief 描画したテキストの数
+    uint32_t textCount = 0;
+    /// @brief 描画したテキストの文字数
+    uint32_t textGlyphCount = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include <format>
+#include "FrameAllocator.h"
+#include "Common/Logs.h"
+
+namespace KashipanEngine {
+
+namespace {
+// フレーム単位のアロケータ
+MyStd::FrameArena sFrameArena;
+} // namespace
+
+void InitializeFrameAllocator(size_t capacityPerFrame) {
+    sFrameArena.Initialize(capacityPerFrame);
+    Log(std::format("Frame allocator initialized. ({} bytes per frame)", capacityPerFrame));
+}
+
+void EndFrameAllocator() {
+#ifdef DEBUG_BUILD
+    // 容量を超えていたら警告を出す
+    const MyStd::LinearArena &arena = sFrameArena.GetArena();
+    if (arena.GetOverflowCount() > 0) {
+        Log(std::format("Frame allocator overflowed: {} allocations ({} bytes). high water: {} / {} bytes",
+            arena.GetOverflowCount(), arena.GetOverflowBytes(), arena.GetHighWater(), arena.GetCapacity()),
+            kLogLevelFlagWarning);
+        sFrameArena.GetArena().ResetStats();
+    }
+#endif
+    sFrameArena.EndFrame();
+}
+
+MyStd::FrameArena &GetFrameArena() {
+    return sFrameArena;
+}
+
+std::pmr::memory_resource *GetFrameResource() {
+    return sFrameArena.GetResource();
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
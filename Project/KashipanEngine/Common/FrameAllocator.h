@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <LinearArena.h>
+
+namespace KashipanEngine {
+
+/// @brief フレーム単位のアロケータの初期化
+/// @param capacityPerFrame 1フレームあたりの容量(バイト)
+void InitializeFrameAllocator(size_t capacityPerFrame);
+
+/// @brief フレーム単位のアロケータのフレーム終了処理。2フレーム前に確保したメモリを解放する
+void EndFrameAllocator();
+
+/// @brief フレーム単位のアロケータの取得
+/// @return フレーム単位のアロケータ
+MyStd::FrameArena &GetFrameArena();
+
+/// @brief フレーム単位のアロケータの std::pmr 用リソースの取得
+/// @return std::pmr 用リソース
+std::pmr::memory_resource *GetFrameResource();
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <array>
+#include <algorithm>
+#include <format>
+#include <filesystem>
+#include "FrameStatistics.h"
+#include "Common/Logs.h"
+#include "Common/Profiler.h"
+#include "Common/JsoncLoader.h"
+#include "Common/MemoryTracker.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// フレーム時間の統計に使うフレーム数
+const size_t kFrameHistorySize = 240;
+// 報告に含めるフレーム数(直前の約1秒)
+const size_t kReportFrameCount = 60;
+// 報告に含めるプロファイラのゾーン数
+const size_t kReportZoneCount = 16;
+// 報告に含めるプロファイラのトレースの長さ(秒)
+const double kReportTraceSeconds = 1.0;
+// 1回の起動で書き出す報告の最大数(ディスクを埋めないため)
+const uint32_t kMaxReportCount = 16;
+
+/// @brief 報告用に残しておく1フレームの記録
+struct FrameSample {
+    double milliseconds = 0.0;
+    FrameAllocationSample allocation;
+};
+
+// フレーム時間の統計
+MyStd::FrameTimeStats sFrameTimeStats(kFrameHistorySize);
+// 直近のフレームの記録
+std::array<FrameSample, kReportFrameCount> sRecentFrames;
+// これまでに記録したフレーム数
+size_t sRecentFrameCount = 0;
+// 報告を書き出すフォルダ
+std::string sReportDirectory;
+// 書き出した報告の数
+uint32_t sReportCount = 0;
+
+#if !RELEASE_BUILD
+/// @brief ヒッチの報告を書き出す
+/// @param milliseconds ヒッチとなったフレームの時間
+void WriteHitchReport(double milliseconds) {
+    if (sReportCount >= kMaxReportCount) {
+        return;
+    }
+    ++sReportCount;
+
+    const uint64_t frame = sFrameTimeStats.GetFrameCount();
+    const auto summary = sFrameTimeStats.GetSummary();
+    Json report;
+    report["frame"] = frame;
+    report["frameMilliseconds"] = milliseconds;
+    report["medianMilliseconds"] = sFrameTimeStats.GetMedian();
+    report["summary"] = {
+        { "sampleCount", summary.sampleCount },
+        { "average", summary.average },
+        { "p50", summary.p50 },
+        { "p95", summary.p95 },
+        { "p99", summary.p99 },
+        { "max", summary.max },
+        { "hitchCount", summary.hitchCount },
+    };
+
+    // 直前のフレームの時間とアロケータの使用状況(古い順)
+    Json frames = Json::array();
+    const size_t frameCount = std::min(sRecentFrameCount, kReportFrameCount);
+    for (size_t i = sRecentFrameCount - frameCount; i < sRecentFrameCount; ++i) {
+        const FrameSample &sample = sRecentFrames[i % kReportFrameCount];
+        frames.push_back({
+            { "milliseconds", sample.milliseconds },
+            { "allocationCount", sample.allocation.allocationCount },
+            { "usedBytes", sample.allocation.usedBytes },
+            { "overflowCount", sample.allocation.overflowCount },
+            { "heapAllocationCount", sample.allocation.heapAllocationCount },
+            { "heapAllocatedBytes", sample.allocation.heapAllocatedBytes },
+        });
+    }
+    report["recentFrames"] = std::move(frames);
+
+    // 処理時間の大きいゾーン
+    Json zones = Json::array();
+    const auto zoneStats = Profiler::GetZoneStats();
+    for (size_t i = 0; i < zoneStats.size() && i < kReportZoneCount; ++i) {
+        const auto &zone = zoneStats[i];
+        zones.push_back({
+            { "name", zone.name },
+            { "callCount", zone.lastCallCount },
+            { "last", zone.last },
+            { "average", zone.average },
+            { "max", zone.max },
+        });
+    }
+    report["zones"] = std::move(zones);
+
+    // タグごとのヒープの使用状況
+    Json memory = Json::array();
+    for (const auto &tagStats : MemoryTracker::GetStats()) {
+        memory.push_back({
+            { "tag", tagStats.name },
+            { "liveBytes", tagStats.liveBytes },
+            { "liveCount", tagStats.liveCount },
+            { "frameAllocationCount", tagStats.frameAllocationCount },
+            { "frameAllocatedBytes", tagStats.frameAllocatedBytes },
+        });
+    }
+    report["memory"] = std::move(memory);
+    report["logs"] = GetRecentLogs();
+
+    // ヒッチの直後のフレームをさらに遅らせないよう、トレースも報告も保存用のスレッドで書き出す
+    const std::string baseName = std::format("{}/hitch_{}", sReportDirectory, frame);
+    Profiler::ExportChromeTraceAsync(baseName + "_trace.json", kReportTraceSeconds);
+    report["trace"] = std::format("hitch_{}_trace.json", frame);
+    SaveJsoncAsync(std::move(report), baseName + ".json");
+}
+#endif
+
+} // namespace
+
+void InitializeFrameStatistics(const std::string &reportDirectory) {
+    sReportDirectory = reportDirectory;
+#if !RELEASE_BUILD
+    std::error_code errorCode;
+    std::filesystem::create_directories(sReportDirectory, errorCode);
+    if (errorCode) {
+        Log("Failed to create hitch report directory: " + sReportDirectory, kLogLevelFlagWarning);
+    }
+#endif
+}
+
+bool UpdateFrameStatistics(double deltaSeconds, const FrameAllocationSample &allocation) {
+    if (deltaSeconds <= 0.0) {
+        return false;
+    }
+    const double milliseconds = deltaSeconds * 1000.0;
+    sRecentFrames[sRecentFrameCount % kReportFrameCount] = { milliseconds, allocation };
+    ++sRecentFrameCount;
+
+    const bool isHitch = sFrameTimeStats.AddFrame(milliseconds);
+#if !RELEASE_BUILD
+    if (isHitch) {
+        Log(std::format("Hitch detected: {:.2f} ms (median {:.2f} ms, heap allocations {}, frame allocations {})",
+            milliseconds, sFrameTimeStats.GetMedian(), allocation.heapAllocationCount, allocation.allocationCount),
+            kLogLevelFlagWarning);
+        WriteHitchReport(milliseconds);
+    }
+#endif
+    return isHitch;
+}
+
+MyStd::FrameTimeStats &GetFrameTimeStats() {
+    return sFrameTimeStats;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
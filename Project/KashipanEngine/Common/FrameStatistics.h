@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <FrameTimeStats.h>
+
+namespace KashipanEngine {
+
+/// @brief 1フレームのメモリ確保の状況
+struct FrameAllocationSample {
+    /// @brief 確保回数
+    size_t allocationCount = 0;
+    /// @brief 使用サイズ(バイト)
+    size_t usedBytes = 0;
+    /// @brief 容量を超えてヒープから確保した回数
+    size_t overflowCount = 0;
+    /// @brief operator new での確保回数
+    uint64_t heapAllocationCount = 0;
+    /// @brief operator new で確保したサイズ(バイト)
+    uint64_t heapAllocatedBytes = 0;
+};
+
+/// @brief フレーム時間の統計とヒッチ検出の初期化
+/// @param reportDirectory ヒッチの報告を書き出すフォルダへのパス
+void InitializeFrameStatistics(const std::string &reportDirectory);
+
+/// @brief フレーム時間を記録し、ヒッチであれば報告を書き出す。
+/// プロファイラの集計(Profiler::EndFrame)の後に呼ぶ
+/// @param deltaSeconds フレーム時間(秒)。0以下の場合は記録しない
+/// @param allocation このフレームのアロケータの使用状況
+/// @return このフレームがヒッチかどうか
+bool UpdateFrameStatistics(double deltaSeconds, const FrameAllocationSample &allocation);
+
+/// @brief フレーム時間の統計の取得
+/// @return フレーム時間の統計
+MyStd::FrameTimeStats &GetFrameTimeStats();
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <format>
+#include <thread>
+#include <vector>
+#include "GlyphAtlasBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+#include "Font/GlyphAtlas.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 1回でラスタライズする文字数
+const size_t kMissGlyphCount = 256;
+// 探す回数
+const size_t kLookupCount = 1024;
+// 使用率を計測するときに1フレームで要求する文字数
+const size_t kOccupancyGlyphsPerFrame = 32;
+// 使用率を計測するフレーム数
+const size_t kOccupancyFrameCount = 64;
+
+/// @brief ASCII・ラテン文字・ギリシャ文字・キリル文字・ひらがな・カタカナ・漢字の順に、フォントにある文字を最大 count 文字作る
+std::vector<int> CreateCodePoints(const GlyphAtlas &atlas, int fontId, size_t count) {
+    const std::pair<int, int> ranges[] = {
+        { 0x21, 0x7E }, { 0xA1, 0x17F }, { 0x370, 0x4FF }, { 0x3041, 0x3096 }, { 0x30A1, 0x30FA }, { 0x4E00, 0x9FFF },
+    };
+    std::vector<int> codePoints;
+    codePoints.reserve(count);
+    for (const auto &[first, last] : ranges) {
+        for (int codePoint = first; codePoint <= last && codePoints.size() < count; ++codePoint) {
+            if (atlas.HasGlyph(fontId, codePoint)) {
+                codePoints.push_back(codePoint);
+            }
+        }
+    }
+    return codePoints;
+}
+
+/// @brief 文字をすべて要求して、入り終わるまで待つ
+void RequestGlyphs(GlyphAtlas &atlas, int fontId, const std::vector<int> &codePoints) {
+    for (const int codePoint : codePoints) {
+        atlas.FindGlyph(fontId, codePoint);
+    }
+    atlas.WaitIdle();
+}
+
+/// @brief 文字を入れ続けて、最初の追い出しまでの使用率を出力する
+void LogOccupancy(const std::string &fontFilePath) {
+    GlyphAtlas atlas;
+    const int fontId = atlas.LoadFont(fontFilePath);
+    if (fontId < 0) {
+        return;
+    }
+    const std::vector<int> codePoints = CreateCodePoints(atlas, fontId, kOccupancyGlyphsPerFrame * kOccupancyFrameCount);
+    GlyphAtlas::Stats peakStats;
+    for (size_t frame = 0; frame * kOccupancyGlyphsPerFrame < codePoints.size(); ++frame) {
+        atlas.BeginFrame();
+        const size_t begin = frame * kOccupancyGlyphsPerFrame;
+        const std::vector<int> frameCodePoints(codePoints.begin() + begin,
+            codePoints.begin() + std::min(begin + kOccupancyGlyphsPerFrame, codePoints.size()));
+        RequestGlyphs(atlas, fontId, frameCodePoints);
+        if (atlas.GetStats().evictedRegionCount == 0) {
+            peakStats = atlas.GetStats();
+        }
+    }
+    const GlyphAtlas::Stats &stats = atlas.GetStats();
+    const uint32_t atlasSize = atlas.GetDesc().atlasSize;
+    LogSimple(std::format("Occupancy: {}x{} atlas, peak {:.1f}% before the first eviction ({} glyphs in {} regions)",
+        atlasSize, atlasSize, peakStats.occupancy * 100.0, peakStats.glyphCount, peakStats.usedRegionCount));
+    LogSimple(std::format("After {} glyphs: {} glyphs, {:.1f}%, {} evicted regions ({} glyphs), {} failed",
+        codePoints.size(), stats.glyphCount, stats.occupancy * 100.0, stats.evictedRegionCount,
+        stats.evictedGlyphCount, stats.failedCount));
+}
+
+} // namespace
+
+bool RunGlyphAtlasBenchmarks(const std::string &fontFilePath, const std::string &outputPath,
+    const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n============== Glyph Atlas Benchmarks ==============\n");
+    // 1回で要求する文字がすべて入るよう、大きめのアトラスで計測する
+    GlyphAtlasDesc desc;
+    desc.atlasSize = 2048;
+    desc.workerCount = 0;
+    GlyphAtlas singleThreadAtlas(desc);
+    desc.workerCount = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+    GlyphAtlas workerAtlas(desc);
+    const int singleThreadFontId = singleThreadAtlas.LoadFont(fontFilePath);
+    const int workerFontId = workerAtlas.LoadFont(fontFilePath);
+    if (singleThreadFontId < 0 || workerFontId < 0) {
+        return false;
+    }
+    const std::vector<int> codePoints = CreateCodePoints(singleThreadAtlas, singleThreadFontId, kMissGlyphCount);
+    if (codePoints.size() < kMissGlyphCount) {
+        Log(std::format("Glyph atlas benchmark font has only {} of {} glyphs: {}", codePoints.size(), kMissGlyphCount,
+            fontFilePath), kLogLevelFlagError);
+        return false;
+    }
+    std::vector<int> lookupCodePoints(kLookupCount);
+    for (size_t i = 0; i < kLookupCount; ++i) {
+        lookupCodePoints[i] = codePoints[(i * 7) % codePoints.size()];
+    }
+
+    MyStd::Benchmark benchmark;
+    benchmark.SetSampleCount(5);
+    // 1回で空のアトラスに256文字を入れる(ワーカー無し・有り)
+    benchmark.Add("GlyphAtlas/Miss256Glyphs1Thread", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            singleThreadAtlas.Clear();
+            RequestGlyphs(singleThreadAtlas, singleThreadFontId, codePoints);
+            DoNotOptimize(singleThreadAtlas.GetPixels().data());
+        }
+    });
+    benchmark.Add("GlyphAtlas/Miss256GlyphsWorkers", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            workerAtlas.Clear();
+            RequestGlyphs(workerAtlas, workerFontId, codePoints);
+            DoNotOptimize(workerAtlas.GetPixels().data());
+        }
+    });
+    benchmark.Add("GlyphAtlas/Hit1kLookups", [&](uint64_t iterationCount) {
+        RequestGlyphs(workerAtlas, workerFontId, codePoints);
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            float advance = 0.0f;
+            for (const int codePoint : lookupCodePoints) {
+                const GlyphAtlas::Glyph *glyph = workerAtlas.FindGlyph(workerFontId, codePoint);
+                advance += glyph ? glyph->xAdvance : 0.0f;
+            }
+            DoNotOptimize(advance);
+        }
+    });
+    const auto results = benchmark.Run();
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<40} {:12.3f} us  (min {:.3f} us, max {:.3f} us, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration / 1000.0, result.minNanosecondsPerIteration / 1000.0,
+            result.maxNanosecondsPerIteration / 1000.0, result.iterationCount, result.sampleCount));
+    }
+    LogSimple(std::format("Miss cost per glyph: {:.3f} us (1 thread), {:.3f} us ({} workers)",
+        results[0].nanosecondsPerIteration / 1000.0 / kMissGlyphCount,
+        results[1].nanosecondsPerIteration / 1000.0 / kMissGlyphCount, desc.workerCount));
+    LogOccupancy(fontFilePath);
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance);
+    Log(std::format("Glyph atlas benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
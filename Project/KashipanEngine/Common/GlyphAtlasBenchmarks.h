@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief グリフアトラスのベンチマークを実行する。
+/// fontFilePath のTrueTypeフォントで、アトラスに無い256文字をラスタライズして詰める時間(ワーカー無し・有り)と
+/// アトラスにある文字を探す時間を計測し、文字を入れ続けたときの最初の追い出しまでの使用率を出力する。
+/// 画素の内容と追い出しの確認は Tests/GlyphAtlasTests.cpp で行う。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param fontFilePath 使用するフォントファイル(.ttf, .ttc)のパス。256文字以上あること
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものが無かったかどうか
+bool RunGlyphAtlasBenchmarks(const std::string &fontFilePath = "Resources/Font/SourceCodePro-Regular.ttf",
+    const std::string &outputPath = "Logs/Benchmarks/glyph_atlas.json",
+    const std::string &baselinePath = "Benchmarks/glyph_atlas_baseline.json", double tolerance = 0.25);
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include "JsonBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/CookedJson.h"
+#include "Common/JsoncLoader.h"
+#include "Common/Logs.h"
+#include "Common/StringId.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 計測用のファイル
+const char kDocumentPath[] = "Logs/Benchmarks/json_benchmark.jsonc";
+// 保存の計測用のファイル
+const char kSavePath[] = "Logs/Benchmarks/json_save_benchmark.json";
+// 作る JSONC の大きさの目安
+const size_t kDocumentSize = 1024 * 1024;
+// 検索する値のパス
+const char kLeafPath[] = "settings.groups[3].items[2].value";
+
+/// @brief 設定ファイルに似た、コメント付きの約 1 MB の JSONC を作る
+std::string CreateDocumentText() {
+    Json root = Json::object();
+    Json &groups = root["settings"]["groups"];
+    for (int group = 0; group < 8; ++group) {
+        Json &items = groups[group]["items"];
+        for (int item = 0; item < 4; ++item) {
+            items[item] = { { "name", std::format("item_{}_{}", group, item) }, { "value", group * 10 + item } };
+        }
+    }
+    Json &objects = root["objects"];
+    std::string text;
+    for (int i = 0; text.size() < kDocumentSize; ++i) {
+        objects.push_back({
+            { "name", std::format("Resources/Models/object_{:05}.obj", i) },
+            { "position", { i * 0.5, i * 0.25, -i * 0.125 } },
+            { "scale", 1.0 + i % 7 },
+            { "isVisible", i % 3 != 0 },
+            { "tags", { "static", "shadow", std::format("layer{}", i % 8) } },
+        });
+        // 大きさの確認は 256 個ごとにする
+        if (i % 256 == 255) {
+            text = root.dump(4);
+        }
+    }
+    text = root.dump(4);
+    // JSONC として、先頭にコメントを付けておく
+    return "// benchmark document\n" + text;
+}
+
+} // namespace
+
+bool RunJsonBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n============== Json Benchmarks ==============\n");
+    const std::string text = CreateDocumentText();
+    std::filesystem::create_directories(std::filesystem::path(kDocumentPath).parent_path());
+    {
+        std::ofstream file(kDocumentPath, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+    // 変換済みファイルを作っておき、2回目以降の LoadJsonc が変換済みファイルを使うようにする
+    std::filesystem::remove(std::string(kDocumentPath) + kCookedJsonExtension);
+    const Json expected = Json::parse(text, nullptr, false, true);
+    const bool isMatched = !expected.is_discarded() && LoadJsonc(kDocumentPath) == expected && LoadJsonc(kDocumentPath) == expected;
+    if (!isMatched) {
+        Log("Json benchmark: LoadJsonc result does not match the parsed text", kLogLevelFlagError);
+    }
+    const uint64_t sourceHash = StringId::Hash(text);
+    const std::string cooked = CookJson(expected, sourceHash);
+    const JsonPath leafPath(kLeafPath);
+
+    MyStd::Benchmark benchmark;
+    // 1回が数ミリ秒かかるので、サンプル数を減らす
+    benchmark.SetSampleCount(5);
+    benchmark.Add("Json/Parse text 1MB", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(Json::parse(text, nullptr, false, true));
+        }
+    });
+    benchmark.Add("Json/Hash text 1MB", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(StringId::Hash(text));
+        }
+    });
+    benchmark.Add("Json/Uncook 1MB", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(UncookJson(cooked, &sourceHash));
+        }
+    });
+    benchmark.Add("Json/LoadJsoncText 1MB", [](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(LoadJsoncText(kDocumentPath));
+        }
+    });
+    benchmark.Add("Json/LoadJsonc cooked 1MB", [](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(LoadJsonc(kDocumentPath));
+        }
+    });
+    benchmark.Add("Json/FindNestedValue string", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(FindNestedValue(expected, kLeafPath));
+        }
+    });
+    benchmark.Add("Json/FindNestedValue JsonPath", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(leafPath.Find(expected));
+        }
+    });
+    // 保存は設定ファイル程度の大きさで、呼び出し側が止まる時間を比べる
+    Json saveJson = Json::object();
+    for (int i = 0; i < 1024; ++i) {
+        saveJson[std::format("key{:04}", i)] = { { "value", i }, { "name", std::format("entry_{}", i) } };
+    }
+    // 非同期の保存で呼び出し側にかかる時間は、ほぼ内容の複製の時間になる
+    benchmark.Add("Json/Copy 64KB", [&saveJson](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(Json(saveJson));
+        }
+    });
+    benchmark.Add("Json/SaveJsonc 64KB", [&saveJson](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(SaveJsonc(saveJson, kSavePath));
+        }
+    });
+    // 同じパスへの100回の保存はまとめて1回だけ書き込む
+    benchmark.Add("Json/SaveJsoncAsync 64KB x100 + Flush", [&saveJson](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            for (int save = 0; save < 100; ++save) {
+                SaveJsoncAsync(saveJson, kSavePath);
+            }
+            FlushJsoncSaves();
+        }
+    });
+    const auto results = benchmark.Run();
+    LogSimple(std::format("document: {} bytes, cooked: {} bytes", text.size(), cooked.size()));
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<36} {:14.2f} ns  (min {:.2f} ns, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration, result.minNanosecondsPerIteration,
+            result.iterationCount, result.sampleCount));
+    }
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance) && isMatched;
+    Log(std::format("Json benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
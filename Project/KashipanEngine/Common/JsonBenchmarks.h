@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief JSON 読み込みのベンチマークを実行する。
+/// 約 1 MB の JSONC について、テキストの解析・ハッシュ値の計算・変換済みデータの復元・LoadJsonc 全体と、
+/// 文字列のパスと JsonPath での値の検索、同期・非同期の保存の時間を計る。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったもの・結果の違いが無かったかどうか
+bool RunJsonBenchmarks(const std::string &outputPath = "Logs/Benchmarks/json.json",
+    const std::string &baselinePath = "Benchmarks/json_baseline.json", double tolerance = 0.25);
+
+} // namespace KashipanEngine
\ No newline at end of file
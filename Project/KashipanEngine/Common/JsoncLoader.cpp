@@ -1,30 +1,246 @@
+#include <charconv>
+#include <climits>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
+#include "Common/CookedJson.h"
+#include "Common/StringId.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
 #include "JsoncLoader.h"
 
 namespace KashipanEngine {
 
+namespace {
+
+/// @brief ファイルの中身をまとめて読み込む
+bool ReadFileBytes(const std::string &filepath, std::string &out) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/// @brief 非同期保存の待ち行列。I/Oスレッドで書き込む
+class JsoncSaveQueue {
+public:
+    // 同じパスへの保存をまとめる時間
+    static constexpr std::chrono::milliseconds kCoalesceWindow{ 100 };
+
+    JsoncSaveQueue() = default;
+    ~JsoncSaveQueue() {
+        Finalize();
+    }
+
+    std::shared_future<bool> Push(Json &&jsonData, const std::string &filepath, int indent) {
+        // 差し替えた古い内容はロックを外してから破棄する
+        Json replaced;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (isFinalized_) {
+            // 終了後はその場で書き込む
+            lock.unlock();
+            std::promise<bool> promise;
+            promise.set_value(SaveJsonc(jsonData, filepath, indent));
+            return promise.get_future().share();
+        }
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&JsoncSaveQueue::Run, this);
+        }
+
+        auto it = pending_.find(filepath);
+        if (it != pending_.end()) {
+            // 書き込み待ちの内容を差し替える。書き込む時刻は最初の保存から変えない
+            replaced = std::exchange(it->second.json, std::move(jsonData));
+            it->second.indent = indent;
+            return it->second.future;
+        }
+        PendingSave save;
+        save.json = std::move(jsonData);
+        save.indent = indent;
+        save.deadline = std::chrono::steady_clock::now() + kCoalesceWindow;
+        save.promise = std::make_shared<std::promise<bool>>();
+        save.future = save.promise->get_future().share();
+        auto future = save.future;
+        pending_.emplace(filepath, std::move(save));
+        condition_.notify_one();
+        return future;
+    }
+
+    void Flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            return;
+        }
+        ++flushRequestCount_;
+        condition_.notify_one();
+        idleCondition_.wait(lock, [this] { return pending_.empty() && writingCount_ == 0; });
+        --flushRequestCount_;
+    }
+
+    void Finalize() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (isFinalized_) {
+                return;
+            }
+            isFinalized_ = true;
+            condition_.notify_one();
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    struct PendingSave {
+        Json json;
+        int indent = 4;
+        std::chrono::steady_clock::time_point deadline;
+        std::shared_ptr<std::promise<bool>> promise;
+        std::shared_future<bool> future;
+    };
+
+    void Run() {
+        // このスレッドでの確保は全て書き出すJSONの文字列化なのでまとめてJSONとして数える
+        MEMORY_TAG_SCOPE(kJson);
+        Profiler::RegisterThread("JsoncSaveQueue");
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            if (pending_.empty()) {
+                if (isFinalized_) {
+                    break;
+                }
+                condition_.wait(lock);
+                continue;
+            }
+
+            // 終了時と Flush 中は待ち時間を無視して全て書き込む
+            const bool isWriteAll = isFinalized_ || flushRequestCount_ > 0;
+            const auto now = std::chrono::steady_clock::now();
+            auto earliest = std::chrono::steady_clock::time_point::max();
+            std::vector<std::pair<std::string, PendingSave>> saves;
+            for (auto it = pending_.begin(); it != pending_.end();) {
+                if (isWriteAll || it->second.deadline <= now) {
+                    saves.emplace_back(it->first, std::move(it->second));
+                    it = pending_.erase(it);
+                } else {
+                    earliest = std::min(earliest, it->second.deadline);
+                    ++it;
+                }
+            }
+            if (saves.empty()) {
+                condition_.wait_until(lock, earliest);
+                continue;
+            }
+
+            ++writingCount_;
+            lock.unlock();
+            for (auto &[filepath, save] : saves) {
+                save.promise->set_value(SaveJsonc(save.json, filepath, save.indent));
+            }
+            lock.lock();
+            --writingCount_;
+            if (pending_.empty() && writingCount_ == 0) {
+                idleCondition_.notify_all();
+            }
+        }
+        idleCondition_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable idleCondition_;
+    std::unordered_map<std::string, PendingSave> pending_;
+    std::thread thread_;
+    size_t writingCount_ = 0;
+    size_t flushRequestCount_ = 0;
+    bool isFinalized_ = false;
+};
+
+JsoncSaveQueue &GetSaveQueue() {
+    static JsoncSaveQueue queue;
+    return queue;
+}
+
+} // namespace
+
 Json LoadJsonc(const std::string &filename) {
-    Json jsonData;
-    std::fstream jsonFile(filename);
-    jsonData = Json::parse(jsonFile, nullptr, false, true);
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kJson);
+    const std::string cookedPath = filename + kCookedJsonExtension;
+    std::string text;
+    if (!ReadFileBytes(filename, text)) {
+        // 元のファイルが無い場合は比べる相手が無いので、変換済みファイルだけでも読む
+        if (auto cooked = LoadCookedJson(cookedPath, nullptr)) {
+            return std::move(*cooked);
+        }
+        return Json(Json::value_t::discarded);
+    }
+
+    // 元のファイルが変わっていなければ変換済みファイルを使う
+    const uint64_t sourceHash = StringId::Hash(text);
+    if (auto cooked = LoadCookedJson(cookedPath, &sourceHash)) {
+        return std::move(*cooked);
+    }
+    Json jsonData = Json::parse(text, nullptr, false, true);
+    if (!jsonData.is_discarded()) {
+        SaveCookedJson(cookedPath, sourceHash, jsonData);
+    }
     return jsonData;
 }
 
+Json LoadJsoncText(const std::string &filepath) {
+    std::ifstream jsonFile(filepath);
+    return Json::parse(jsonFile, nullptr, false, true);
+}
+
 bool SaveJsonc(const Json &jsonData, const std::string &filepath, int indent) {
+    const std::string cookedPath = filepath + kCookedJsonExtension;
+    std::string text;
     try {
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            return false;
-        }
-        file << jsonData.dump(indent);
-        file.close();
-        return true;
+        text = jsonData.dump(indent);
     } catch (const std::exception&) {
         return false;
     }
+    // 読み込み時は読んだバイト列のハッシュ値と比べるので、改行コードを変換せずにそのまま書く
+    if (!WriteFileAtomically(filepath, text)) {
+        return false;
+    }
+    // 変換済みファイルがあれば新しい内容で作り直す。作れなければ古いものが読まれないよう消しておく
+    std::error_code ec;
+    if (std::filesystem::exists(cookedPath, ec) &&
+        !SaveCookedJson(cookedPath, StringId::Hash(text), jsonData)) {
+        std::filesystem::remove(cookedPath, ec);
+    }
+    return true;
+}
+
+std::shared_future<bool> SaveJsoncAsync(const Json &jsonData, const std::string &filepath, int indent) {
+    // 呼び出し側が内容を書き換えても影響しないよう複製しておく
+    return GetSaveQueue().Push(Json(jsonData), filepath, indent);
+}
+
+std::shared_future<bool> SaveJsoncAsync(Json &&jsonData, const std::string &filepath, int indent) {
+    return GetSaveQueue().Push(std::move(jsonData), filepath, indent);
+}
+
+void FlushJsoncSaves() {
+    GetSaveQueue().Flush();
+}
+
+void FinalizeJsoncSaveQueue() {
+    GetSaveQueue().Finalize();
 }
 
 template<typename T>
@@ -45,41 +261,185 @@ T GetJsonValueOrDefault(const Json &json, const std::string &key, const T &defau
     return value.has_value() ? value.value() : defaultValue;
 }
 
-std::optional<Json> GetNestedValue(const Json &json, const std::string &path) {
-    try {
-        Json current = json;
-        std::stringstream ss(path);
-        std::string segment;
-        
-        while (std::getline(ss, segment, '.')) {
-            // 配列インデックスをチェック（例: "array[0]"）
-            size_t bracketStart = segment.find('[');
-            if (bracketStart != std::string::npos) {
-                std::string arrayName = segment.substr(0, bracketStart);
-                size_t bracketEnd = segment.find(']', bracketStart);
-                if (bracketEnd == std::string::npos) {
-                    return std::nullopt;
-                }
-                
-                std::string indexStr = segment.substr(bracketStart + 1, bracketEnd - bracketStart - 1);
-                int index = std::stoi(indexStr);
-                
-                if (!current.contains(arrayName) || !current[arrayName].is_array() || 
-                    index < 0 || index >= static_cast<int>(current[arrayName].size())) {
-                    return std::nullopt;
-                }
-                current = current[arrayName][index];
-            } else {
-                if (!current.contains(segment)) {
-                    return std::nullopt;
-                }
-                current = current[segment];
+namespace {
+
+/// @brief 配列のインデックスの解析
+/// @details 以前の std::stoi と同じく、先頭の空白と符号を許し、数字の後ろの文字は無視する。
+/// 負の値と int の範囲を超える値は失敗にする
+bool ParseJsonIndex(std::string_view text, size_t &index) {
+    size_t position = 0;
+    while (position < text.size() &&
+        (text[position] == ' ' || (text[position] >= '\t' && text[position] <= '\r'))) {
+        ++position;
+    }
+    bool isNegative = false;
+    if (position < text.size() && (text[position] == '+' || text[position] == '-')) {
+        isNegative = text[position] == '-';
+        ++position;
+    }
+    const char *first = text.data() + position;
+    const char *last = text.data() + text.size();
+    unsigned long long value = 0;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ptr == first) {
+        return false;
+    }
+    if (ec == std::errc::result_out_of_range || value > static_cast<unsigned long long>(INT_MAX)) {
+        return false;
+    }
+    if (isNegative && value != 0) {
+        return false;
+    }
+    index = static_cast<size_t>(value);
+    return true;
+}
+
+/// @brief パスを区切りごとに解析する（例: "object.array[0].value"）
+/// @param path パス
+/// @param onKey キーごとに呼ばれる関数。falseを返すと中断する
+/// @param onIndex 配列のインデックスごとに呼ばれる関数。falseを返すと中断する
+/// @return 最後まで解析できたかどうか
+template<typename OnKey, typename OnIndex>
+bool ParseJsonPath(std::string_view path, OnKey &&onKey, OnIndex &&onIndex) {
+    size_t position = 0;
+    while (position < path.size()) {
+        size_t dot = path.find('.', position);
+        if (dot == std::string_view::npos) {
+            dot = path.size();
+        }
+        std::string_view segment = path.substr(position, dot - position);
+        position = dot + 1;
+
+        // 配列インデックスをチェック（例: "array[0]"、"array[0][1]"）
+        const size_t bracketStart = segment.find('[');
+        if (!onKey(segment.substr(0, bracketStart))) {
+            return false;
+        }
+        if (bracketStart == std::string_view::npos) {
+            continue;
+        }
+        // "]" の後ろは続けて "[" があればインデックスとして読み、それ以外は以前と同じく無視する
+        std::string_view rest = segment.substr(bracketStart);
+        while (!rest.empty() && rest.front() == '[') {
+            const size_t bracketEnd = rest.find(']');
+            if (bracketEnd == std::string_view::npos) {
+                return false;
+            }
+            size_t index = 0;
+            if (!ParseJsonIndex(rest.substr(1, bracketEnd - 1), index)) {
+                return false;
             }
+            if (!onIndex(index)) {
+                return false;
+            }
+            rest.remove_prefix(bracketEnd + 1);
         }
-        return current;
-    } catch (const std::exception&) {
-        return std::nullopt;
     }
+    return true;
+}
+
+/// @brief オブジェクトのメンバーの検索
+template<typename JsonT>
+JsonT *FindJsonMember(JsonT *json, std::string_view key) {
+    if (json == nullptr || !json->is_object()) {
+        return nullptr;
+    }
+    auto it = json->find(key);
+    return it != json->end() ? &*it : nullptr;
+}
+
+/// @brief 配列の要素の検索
+template<typename JsonT>
+JsonT *FindJsonElement(JsonT *json, size_t index) {
+    if (json == nullptr || !json->is_array() || index >= json->size()) {
+        return nullptr;
+    }
+    return &(*json)[index];
+}
+
+template<typename JsonT>
+JsonT *FindNestedValueImpl(JsonT &json, std::string_view path) {
+    JsonT *current = &json;
+    const bool isParsed = ParseJsonPath(path,
+        [&current](std::string_view key) {
+            current = FindJsonMember(current, key);
+            return current != nullptr;
+        },
+        [&current](size_t index) {
+            current = FindJsonElement(current, index);
+            return current != nullptr;
+        });
+    return isParsed ? current : nullptr;
+}
+
+} // namespace
+
+JsonPath::JsonPath(std::string_view path) : path_(path) {
+    isValid_ = ParseJsonPath(path_,
+        [this](std::string_view key) {
+            Segment segment;
+            segment.keyOffset = static_cast<uint32_t>(key.data() - path_.data());
+            segment.keyLength = static_cast<uint32_t>(key.size());
+            segments_.push_back(segment);
+            return true;
+        },
+        [this](size_t index) {
+            Segment segment;
+            segment.index = index;
+            segment.isIndex = true;
+            segments_.push_back(segment);
+            return true;
+        });
+    if (!isValid_) {
+        segments_.clear();
+    }
+}
+
+template<typename JsonT>
+JsonT *JsonPath::FindImpl(JsonT &json) const {
+    if (!isValid_) {
+        return nullptr;
+    }
+    const std::string_view path = path_;
+    JsonT *current = &json;
+    for (const auto &segment : segments_) {
+        if (segment.isIndex) {
+            current = FindJsonElement(current, segment.index);
+        } else {
+            current = FindJsonMember(current, path.substr(segment.keyOffset, segment.keyLength));
+        }
+        if (current == nullptr) {
+            return nullptr;
+        }
+    }
+    return current;
+}
+
+const Json *JsonPath::Find(const Json &json) const {
+    return FindImpl(json);
+}
+
+Json *JsonPath::Find(Json &json) const {
+    return FindImpl(json);
+}
+
+std::optional<Json> GetNestedValue(const Json &json, const std::string &path) {
+    // 見つかった値だけをコピーする
+    const Json *value = FindNestedValue(json, path);
+    return value != nullptr ? std::optional<Json>(*value) : std::nullopt;
+}
+
+std::optional<Json> GetNestedValue(const Json &json, const JsonPath &path) {
+    const Json *value = path.Find(json);
+    return value != nullptr ? std::optional<Json>(*value) : std::nullopt;
+}
+
+const Json *FindNestedValue(const Json &json, std::string_view path) {
+    return FindNestedValueImpl(json, path);
+}
+
+Json *FindNestedValue(Json &json, std::string_view path) {
+    return FindNestedValueImpl(json, path);
 }
 
 bool ValidateJsonStructure(const Json &json, const std::vector<std::string> &requiredKeys) {
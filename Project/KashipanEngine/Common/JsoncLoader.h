@@ -1,7 +1,10 @@
 #pragma once
 #include <json.hpp>
+#include <cstdint>
+#include <future>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace KashipanEngine {
@@ -9,9 +12,25 @@ namespace KashipanEngine {
 using Json = nlohmann::json;
 
 // 基本的な読み込み・保存機能
+// 読み込み時は元のファイルのハッシュ値と一致する変換済みファイルがあればそれを使い、無いか古ければテキストを解析して変換済みファイルを作る。
+// 元のファイルが無い場合だけは変換済みファイルを検証せずに使う
 Json LoadJsonc(const std::string &filepath);
+// 変換済みファイルを使わずにテキストを解析する
+Json LoadJsoncText(const std::string &filepath);
+// 保存は一時ファイルに書いてから置き換えるので、途中で落ちても書きかけのファイルは残らない。
+// 変換済みファイルがあれば一緒に作り直す
 bool SaveJsonc(const Json &jsonData, const std::string &filepath, int indent = 4);
 
+// 非同期の保存機能
+// 内容を複製してI/Oスレッドで書き込む。同じパスへの保存が短い間に続いた場合は最後の内容だけを書き込む
+std::shared_future<bool> SaveJsoncAsync(const Json &jsonData, const std::string &filepath, int indent = 4);
+// 渡したJSONを移動して使うので、大きなデータでも呼び出し側で複製の時間がかからない
+std::shared_future<bool> SaveJsoncAsync(Json &&jsonData, const std::string &filepath, int indent = 4);
+// 保存待ちの書き込みを全て完了させる
+void FlushJsoncSaves();
+// 保存待ちの書き込みを完了させてI/Oスレッドを終了する。以降の非同期保存はその場で書き込む
+void FinalizeJsoncSaveQueue();
+
 // 安全な値取得機能
 template<typename T>
 std::optional<T> GetJsonValue(const Json &json, const std::string &key);
@@ -19,8 +38,47 @@ std::optional<T> GetJsonValue(const Json &json, const std::string &key);
 template<typename T>
 T GetJsonValueOrDefault(const Json &json, const std::string &key, const T &defaultValue);
 
+/// @brief 事前に分解しておくJSONのパス（例: "object.array[0].value"）。
+/// 毎フレームや繰り返し使うパスは一度だけ作っておき、分解のコストを省く
+class JsonPath {
+public:
+    JsonPath() = default;
+    explicit JsonPath(std::string_view path);
+
+    /// @brief パスの書式が正しいかどうか
+    bool IsValid() const { return isValid_; }
+    /// @brief 元の文字列の取得
+    const std::string &GetString() const { return path_; }
+
+    /// @brief パスの指す値の検索（コピーしない）
+    /// @return 値へのポインタ。見つからなければnullptr
+    const Json *Find(const Json &json) const;
+    Json *Find(Json &json) const;
+
+private:
+    struct Segment {
+        // キーの位置（path_ 内）
+        uint32_t keyOffset = 0;
+        uint32_t keyLength = 0;
+        // 配列のインデックス
+        size_t index = 0;
+        // インデックスかどうか
+        bool isIndex = false;
+    };
+    template<typename JsonT>
+    JsonT *FindImpl(JsonT &json) const;
+
+    std::string path_;
+    std::vector<Segment> segments_;
+    bool isValid_ = true;
+};
+
 // ネストしたキーへのアクセス（例: "object.array[0].value"）
 std::optional<Json> GetNestedValue(const Json &json, const std::string &path);
+std::optional<Json> GetNestedValue(const Json &json, const JsonPath &path);
+// ネストしたキーの検索。途中の値をコピーせず、見つかった値へのポインタを返す
+const Json *FindNestedValue(const Json &json, std::string_view path);
+Json *FindNestedValue(Json &json, std::string_view path);
 
 // JSON検証・ユーティリティ機能
 bool ValidateJsonStructure(const Json &json, const std::vector<std::string> &requiredKeys);
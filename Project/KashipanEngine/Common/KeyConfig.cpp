@@ -5,7 +5,30 @@
 namespace KashipanEngine {
 using namespace KeyConfigDefineMaps;
 
-const KeyConfig::ConfigData &KeyConfig::operator[](const std::string &actionName) const {
+namespace {
+
+// 設定ファイルの各項目のパス。読み込みのたびに分解しないよう一度だけ作っておく
+const JsonPath kInputTypePath("InputType");
+const JsonPath kBindingsPath("Bindings");
+const JsonPath kDevicePath("Device");
+const JsonPath kInputPath("Input");
+const JsonPath kEventPath("Event");
+const JsonPath kAxisPath("Axis");
+const JsonPath kDeadZonePath("DeadZone");
+const JsonPath kScalePath("Scale");
+
+/// @brief 必須の項目の取得。無ければ例外を投げる
+const Json &GetRequiredValue(const Json &jsonData, const JsonPath &path) {
+    const Json *value = path.Find(jsonData);
+    if (value == nullptr) {
+        throw std::invalid_argument("Missing key config value: " + path.GetString());
+    }
+    return *value;
+}
+
+} // namespace
+
+const KeyConfig::ConfigData &KeyConfig::operator[](StringId actionName) const {
     auto it = keyConfigMap_.find(actionName);
     if (it != keyConfigMap_.end()) {
         return it->second; // キーが見つかった場合はその値を返す
@@ -22,7 +45,7 @@ void KeyConfig::LoadFromJson(const std::string &filePath) {
         configData.actionName = it.key();
 
         const Json &config = it.value();
-        std::string inputType = config["InputType"].get<std::string>();
+        std::string inputType = GetRequiredValue(config, kInputTypePath).get<std::string>();
 
         if (inputType == "Digital") {
             configData.returnType = "bool";
@@ -32,9 +55,9 @@ void KeyConfig::LoadFromJson(const std::string &filePath) {
             throw std::invalid_argument("Unknown input type: " + inputType);
         }
 
-        for (const auto &keyBinding : config["Bindings"]) {
+        for (const auto &keyBinding : GetRequiredValue(config, kBindingsPath)) {
             KeyBinding keyBindingData;
-            std::string device = keyBinding["Device"].get<std::string>();
+            std::string device = GetRequiredValue(keyBinding, kDevicePath).get<std::string>();
 
             if (device == "Keyboard") {
                 keyBindingData = GetKeyboardKeyBinding(keyBinding);
@@ -49,11 +72,11 @@ void KeyConfig::LoadFromJson(const std::string &filePath) {
             configData.keyBindings.push_back(keyBindingData);
         }
 
-        keyConfigMap_[configData.actionName] = configData;
+        keyConfigMap_[StringId::Intern(configData.actionName)] = configData;
     }
 }
 
-KeyConfig::ActionValue KeyConfig::GetInputValue(const std::string &actionName) {
+KeyConfig::ActionValue KeyConfig::GetInputValue(StringId actionName) {
     auto it = keyConfigMap_.find(actionName);
     if (it != keyConfigMap_.end()) {
         const ConfigData &configData = it->second;
@@ -99,7 +122,7 @@ KeyConfig::ActionValue KeyConfig::GetInputValue(const std::string &actionName) {
     throw std::out_of_range("Action name not found in key config map.");
 }
 
-const KeyConfig::ConfigData &KeyConfig::GetKeyConfig(const std::string &actionName) const {
+const KeyConfig::ConfigData &KeyConfig::GetKeyConfig(StringId actionName) const {
     auto it = keyConfigMap_.find(actionName);
     if (it != keyConfigMap_.end()) {
         return it->second;
@@ -111,7 +134,7 @@ KeyConfig::KeyBinding KeyConfig::GetKeyboardKeyBinding(const Json &jsonData) con
     KeyBinding keyBindingData;
     keyBindingData.deviceType = InputDeviceType::Keyboard;
     
-    std::string input = jsonData["Input"].get<std::string>();
+    std::string input = GetRequiredValue(jsonData, kInputPath).get<std::string>();
     auto itMap = kKeyboardKeyMap.find(input);
     if (itMap != kKeyboardKeyMap.end()) {
         keyBindingData.keyCode = itMap->second;
@@ -119,7 +142,7 @@ KeyConfig::KeyBinding KeyConfig::GetKeyboardKeyBinding(const Json &jsonData) con
         throw std::invalid_argument("Unknown keyboard input: " + input);
     }
 
-    std::string event = jsonData["Event"].get<std::string>();
+    std::string event = GetRequiredValue(jsonData, kEventPath).get<std::string>();
     keyBindingData.actionType = GetActionType(event);
     keyBindingData.scale = GetScale(jsonData);
     
@@ -130,11 +153,11 @@ KeyConfig::KeyBinding KeyConfig::GetMouseKeyBinding(const Json &jsonData) const
     KeyBinding keyBindingData;
     keyBindingData.deviceType = InputDeviceType::Mouse;
     
-    std::string input = jsonData["Input"].get<std::string>();
+    std::string input = GetRequiredValue(jsonData, kInputPath).get<std::string>();
     // 入力が "Cursour"、"Wheel" の場合は別の処理
     if (input == "Cursor") {
         keyBindingData.keyCode = -1;
-        std::string axis = jsonData["Axis"].get<std::string>();
+        std::string axis = GetRequiredValue(jsonData, kAxisPath).get<std::string>();
         if (axis == "X") {
             keyBindingData.axisType = Input::AxisOption::X;
         } else if (axis == "Y") {
@@ -156,13 +179,13 @@ KeyConfig::KeyBinding KeyConfig::GetMouseKeyBinding(const Json &jsonData) const
         }
     }
 
-    if (jsonData.contains("DeadZone")) {
-        keyBindingData.threshold = jsonData["DeadZone"].get<int>();
+    if (const Json *deadZone = kDeadZonePath.Find(jsonData)) {
+        keyBindingData.threshold = deadZone->get<int>();
     } else {
         keyBindingData.threshold = 64;
     }
 
-    std::string event = jsonData["Event"].get<std::string>();
+    std::string event = GetRequiredValue(jsonData, kEventPath).get<std::string>();
     keyBindingData.actionType = GetActionType(event);
     keyBindingData.scale = GetScale(jsonData);
     
@@ -173,17 +196,17 @@ KeyConfig::KeyBinding KeyConfig::GetControllerKeyBinding(const Json &jsonData) c
     KeyBinding keyBindingData;
     keyBindingData.deviceType = InputDeviceType::XBoxController;
     
-    std::string input = jsonData["Input"].get<std::string>();
+    std::string input = GetRequiredValue(jsonData, kInputPath).get<std::string>();
     // 入力が "LeftStick"、"RightStick"、"LeftTrigger"、"RightTrigger" の場合は別の処理
     if (input == "LeftStick") {
         keyBindingData.keyCode = -1;
         keyBindingData.leftRightOption = Input::LeftRightOption::Left;
-        keyBindingData.axisType = GetAxisType(jsonData["Axis"].get<std::string>());
+        keyBindingData.axisType = GetAxisType(GetRequiredValue(jsonData, kAxisPath).get<std::string>());
 
     } else if (input == "RightStick") {
         keyBindingData.keyCode = -1;
         keyBindingData.leftRightOption = Input::LeftRightOption::Right;
-        keyBindingData.axisType = GetAxisType(jsonData["Axis"].get<std::string>());
+        keyBindingData.axisType = GetAxisType(GetRequiredValue(jsonData, kAxisPath).get<std::string>());
     
     } else if (input == "LeftTrigger") {
         keyBindingData.keyCode = -1;
@@ -204,8 +227,8 @@ KeyConfig::KeyBinding KeyConfig::GetControllerKeyBinding(const Json &jsonData) c
         }
     }
 
-    if (jsonData.contains("DeadZone")) {
-        keyBindingData.threshold = jsonData["DeadZone"].get<int>();
+    if (const Json *deadZone = kDeadZonePath.Find(jsonData)) {
+        keyBindingData.threshold = deadZone->get<int>();
     } else {
         if (input == "LeftStick" || input == "RightStick") {
             keyBindingData.threshold = 4096;
@@ -214,7 +237,7 @@ KeyConfig::KeyBinding KeyConfig::GetControllerKeyBinding(const Json &jsonData) c
         }
     }
 
-    std::string event = jsonData["Event"].get<std::string>();
+    std::string event = GetRequiredValue(jsonData, kEventPath).get<std::string>();
     keyBindingData.actionType = GetActionType(event);
     keyBindingData.scale = GetScale(jsonData);
 
@@ -251,8 +274,8 @@ Input::AxisOption KeyConfig::GetAxisType(const std::string &axisTypeStr) const {
 }
 
 float KeyConfig::GetScale(const Json &jsonData) const {
-    if (jsonData.contains("Scale")) {
-        float scale = jsonData["Scale"].get<float>();
+    if (const Json *scaleValue = kScalePath.Find(jsonData)) {
+        float scale = scaleValue->get<float>();
         // スケールが 1.0f か -1.0f でない場合は符号だけを保持して 1.0f にする
         if (scale != 1.0f && scale != -1.0f) {
             scale = (scale > 0.0f) ? 1.0f : -1.0f;
@@ -1,10 +1,11 @@
 #pragma once
 #include <string>
-#include <unordered_map>
+#include <FlatHashMap.h>
 #include <stdexcept>
 #include <variant>
 #include <json.hpp>
 #include "Base/Input.h"
+#include "Common/StringId.h"
 
 namespace KashipanEngine {
 using Json = nlohmann::json;
@@ -35,7 +36,7 @@ public:
     KeyConfig() = default;
     ~KeyConfig() = default;
 
-    const ConfigData &operator[](const std::string &actionName) const;
+    const ConfigData &operator[](StringId actionName) const;
 
     /// @brief Jsonファイルからキーコンフィグを読み込む
     /// @param filePath 読み込むJsonファイルのパス
@@ -44,19 +45,19 @@ public:
     /// @brief 入力の値を取得
     /// @param actionName アクション名
     /// @return アクションの値
-    ActionValue GetInputValue(const std::string &actionName);
+    ActionValue GetInputValue(StringId actionName);
 
     /// @brief キーコンフィグを追加
     /// @param actionName アクション名
     /// @param config キーコンフィグのデータ
-    void AddKeyConfig(const std::string& actionName, const ConfigData & config) {
+    void AddKeyConfig(StringId actionName, const ConfigData & config) {
         keyConfigMap_[actionName] = config;
     }
 
     /// @brief キーコンフィグの取得
     /// @param actionName アクション名
     /// @return キーコンフィグの参照
-    const ConfigData &GetKeyConfig(const std::string &actionName) const;
+    const ConfigData &GetKeyConfig(StringId actionName) const;
 
 private:
     /// @brief キーボードのキーバインドデータを取得
@@ -86,7 +87,7 @@ private:
     float GetScale(const Json &jsonData) const;
 
     // キーコンフィグのマップ
-    std::unordered_map<std::string, ConfigData> keyConfigMap_;
+    MyStd::FlatHashMap<StringId, ConfigData> keyConfigMap_;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
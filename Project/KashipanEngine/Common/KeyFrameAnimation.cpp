@@ -165,19 +165,12 @@ void KeyFrameAnimation::UpdateKeyFrameElementData(KeyFrameElementData &elementDa
 
 void KeyFrameAnimation::UpdateDuration() {
     float maxTime = 0.0f;
-    std::vector<float> lastTimes;
 
-    // 各要素の最後のキーの時間を取得
+    // 各要素の最後のキーの時間から最大の時間を見つける
     for (const auto &pair : keyFrameElements_) {
         const auto &element = pair.second;
-        if (!element.keyFrames.empty()) {
-            lastTimes.push_back(element.keyFrames.back().timeSec);
-        }
-    }
-    // 最大の時間を見つける
-    for (float time : lastTimes) {
-        if (time > maxTime) {
-            maxTime = time;
+        if (!element.keyFrames.empty() && element.keyFrames.back().timeSec > maxTime) {
+            maxTime = element.keyFrames.back().timeSec;
         }
     }
     duration_ = maxTime;
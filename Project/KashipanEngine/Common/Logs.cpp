@@ -1,9 +1,15 @@
 #include <Windows.h>
 #include <filesystem>
 #include <fstream>
+#include <memory_resource>
+#include <mutex>
+#include <array>
+#include <algorithm>
+#include <LinearArena.h>
 #include "Logs.h"
 #include "Common/TimeGet.h"
 #include "Common/ConvertString.h"
+#include "Common/MemoryTracker.h"
 
 namespace KashipanEngine {
 
@@ -13,12 +19,18 @@ namespace {
 
 // ログ出力用のストリーム
 std::ofstream sLogStream;
+// 複数スレッドから出力しても行が混ざらないようにするための排他
+std::mutex sLogMutex;
 // プロジェクトのルートディレクトリ
 std::string sProjectDir;
 // 出力するログのレベル
 LogLevelFlags sOutputLogLevel;
 // 出力するログの種類
 LogTypeFlags sOutputLogType;
+// 直近のログ(ヒッチの報告などで前後の状況を残すため)
+std::array<std::string, kRecentLogCapacity> sRecentLogs;
+// これまでに出力したログの数
+size_t sRecentLogCount = 0;
 // ログレベルフラグの文字列
 const char *kLogLevelFlagStrings[] = {
     "NONE",
@@ -39,9 +51,8 @@ std::string GetRelativePath(const std::string &fullPath) {
 
 /// @brief ログ出力用の詳細情報テキストを作成
 /// @param location ソースロケーション
-/// @return 詳細情報テキスト
-std::string CreateDetailLogText(const std::source_location &location) {
-    std::string logText;
+/// @param logText 詳細情報テキストの追加先
+void CreateDetailLogText(const std::source_location &location, std::pmr::string &logText) {
     logText += TimeGetString("[ {:%Y/%m/%d %H:%M:%S} ]\n\t");
 
     //--------- File ---------//
@@ -58,17 +69,13 @@ std::string CreateDetailLogText(const std::source_location &location) {
     logText += "Line: ";
     logText += std::to_string(location.line());
     logText += "\n\t";
-
-    return logText;
 }
 
 /// @brief ログ出力用の詳細情報無しのテキストを作成
 /// @param message ログメッセージ
 /// @param logLevelFlags ログレベルフラグ
-/// @return ログ出力用のテキスト
-std::string CreateLogText(const std::string &message, LogLevelFlags logLevelFlags) {
-    std::string logText;
-
+/// @param logText ログ出力用のテキストの追加先
+void CreateLogText(const std::string &message, LogLevelFlags logLevelFlags, std::pmr::string &logText) {
     //--------- Message ---------//
     logText += "Message: ";
     if (logLevelFlags & kLogLevelFlagInfo) {
@@ -81,8 +88,21 @@ std::string CreateLogText(const std::string &message, LogLevelFlags logLevelFlag
         logText += "[NO LEVEL LOG] ";
     }
     logText += message;
+}
 
-    return logText;
+/// @brief ログテキストをファイルとデバッグウィンドウに出力
+/// @param logText ログテキスト
+void OutputLogText(std::pmr::string &logText) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    // ログファイルに書き込み
+    sLogStream << logText << std::endl;
+    // 直近のログとして残す(古いものの領域を使い回す)
+    MEMORY_TAG_SCOPE(kLog);
+    sRecentLogs[sRecentLogCount % kRecentLogCapacity].assign(logText.data(), logText.size());
+    ++sRecentLogCount;
+    // デバッグウィンドウに出力
+    logText += '\n';
+    OutputDebugStringA(logText.c_str());
 }
 
 } // namespace
@@ -142,13 +162,12 @@ void Log(const std::string &message, const LogLevelFlags logLevelFlags, const st
         return;
     }
 
-    // ログテキストを作成
-    std::string logText = CreateDetailLogText(location);
-    logText += CreateLogText(message, logLevelFlags);
-    // ログファイルに書き込み
-    sLogStream << logText << std::endl;
-    // デバッグウィンドウに出力
-    OutputDebugStringA((logText + '\n').c_str());
+    // ログテキストを一時メモリ上で作成
+    MyStd::ScratchScope scratch;
+    std::pmr::string logText(scratch.GetResource());
+    CreateDetailLogText(location, logText);
+    CreateLogText(message, logLevelFlags, logText);
+    OutputLogText(logText);
 }
 
 void Log(const std::wstring &message, const LogLevelFlags logLevelFlags, const std::source_location &location) {
@@ -169,9 +188,11 @@ void Log(const std::source_location &message, const LogLevelFlags logLevelFlags,
         return;
     }
 
-    // ログテキストを作成
-    std::string logText = CreateDetailLogText(location);
-    logText += CreateLogText(
+    // ログテキストを一時メモリ上で作成
+    MyStd::ScratchScope scratch;
+    std::pmr::string logText(scratch.GetResource());
+    CreateDetailLogText(location, logText);
+    CreateLogText(
         "[Location] [File:\"" +
         GetRelativePath(message.file_name()) +
         "\" Function:\"" +
@@ -179,12 +200,10 @@ void Log(const std::source_location &message, const LogLevelFlags logLevelFlags,
         "\" Line:" +
         std::to_string(message.line()) +
         "]",
-        logLevelFlags
+        logLevelFlags,
+        logText
     );
-    // ログファイルに書き込み
-    sLogStream << logText << std::endl;
-    // デバッグウィンドウに出力
-    OutputDebugStringA((logText + '\n').c_str());
+    OutputLogText(logText);
 }
 
 void LogSimple(const std::string &message, const LogLevelFlags logLevelFlags) {
@@ -194,12 +213,11 @@ void LogSimple(const std::string &message, const LogLevelFlags logLevelFlags) {
         return;
     }
 
-    // ログテキストを作成
-    std::string logText = '\t' + CreateLogText(message, logLevelFlags);
-    // ログファイルに書き込み
-    sLogStream << logText << std::endl;
-    // デバッグウィンドウに出力
-    OutputDebugStringA((logText + '\n').c_str());
+    // ログテキストを一時メモリ上で作成
+    MyStd::ScratchScope scratch;
+    std::pmr::string logText(1, '\t', scratch.GetResource());
+    CreateLogText(message, logLevelFlags, logText);
+    OutputLogText(logText);
 }
 
 void LogSimple(const std::wstring &message, const LogLevelFlags logLevelFlags) {
@@ -220,8 +238,10 @@ void LogSimple(const std::source_location &message, const LogLevelFlags logLevel
         return;
     }
 
-    // ログテキストを作成
-    std::string logText = '\t' + CreateLogText(
+    // ログテキストを一時メモリ上で作成
+    MyStd::ScratchScope scratch;
+    std::pmr::string logText(1, '\t', scratch.GetResource());
+    CreateLogText(
         "[Location] [File:\"" +
         GetRelativePath(message.file_name()) +
         "\" Function:\"" +
@@ -229,23 +249,34 @@ void LogSimple(const std::source_location &message, const LogLevelFlags logLevel
         "\" Line:" +
         std::to_string(message.line()) +
         "]",
-        logLevelFlags
+        logLevelFlags,
+        logText
     );
-    // ログファイルに書き込み
-    sLogStream << logText << std::endl;
-    // デバッグウィンドウに出力
-    OutputDebugStringA((logText + '\n').c_str());
+    OutputLogText(logText);
 }
 
 void LogNewLine() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
     sLogStream << std::endl;
     OutputDebugStringA("\n");
 }
 
 void LogInsertPartition(const std::string &partition) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
     sLogStream << partition << std::endl;
     OutputDebugStringA((partition + "\n").c_str());
 }
+
+std::vector<std::string> GetRecentLogs() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    const size_t count = std::min(sRecentLogCount, kRecentLogCapacity);
+    std::vector<std::string> logs;
+    logs.reserve(count);
+    for (size_t i = sRecentLogCount - count; i < sRecentLogCount; ++i) {
+        logs.push_back(sRecentLogs[i % kRecentLogCapacity]);
+    }
+    return logs;
+}
 #else
 
 void InitializeLog(const std::string &filePath, const std::string &projectDir,
@@ -295,6 +326,10 @@ void LogNewLine() {
 void LogInsertPartition(const std::string &partition) {
     static_cast<void>(partition);
 }
+
+std::vector<std::string> GetRecentLogs() {
+    return {};
+}
 #endif // _DEBUG
 
 } // namespace KashipanEngine
\ No newline at end of file
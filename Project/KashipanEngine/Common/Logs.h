@@ -1,9 +1,14 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <vector>
 #include <source_location>
 
 namespace KashipanEngine {
 
+/// @brief GetRecentLogs で取得できるログの最大数
+inline constexpr size_t kRecentLogCapacity = 64;
+
 enum LogLevelFlags {
     kLogLevelFlagNone = 0b0000,
     kLogLevelFlagInfo = 0b0001,
@@ -92,4 +97,8 @@ void LogNewLine();
 /// @param partition 仕切り文字列
 void LogInsertPartition(const std::string &partition = "\n==================================================\n");
 
+/// @brief 直近に出力したログの取得(リリースビルドでは常に空)
+/// @return 古い順に並んだ直近のログ。最大 kRecentLogCapacity 件
+std::vector<std::string> GetRecentLogs();
+
 } // namespace KashipanEngine
\ No newline at end of file
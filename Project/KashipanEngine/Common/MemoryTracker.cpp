@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <mutex>
+#include <new>
+#include "Common/Logs.h"
+#include "MemoryTracker.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// タグの名前
+const std::array<const char *, static_cast<size_t>(MemoryTag::kCount)> kTagNames = {
+    "Untagged",
+    "Engine",
+    "Model",
+    "Texture",
+    "Font",
+    "Particle",
+    "Sound",
+    "Json",
+    "Log",
+    "Scene",
+    "Persistent",
+};
+
+} // namespace
+
+const char *MemoryTracker::GetTagName(MemoryTag tag) noexcept {
+    const size_t index = static_cast<size_t>(tag);
+    return index < kTagNames.size() ? kTagNames[index] : "Unknown";
+}
+
+#if USE_MEMORY_TRACKER
+namespace {
+
+constexpr size_t kTagCount = static_cast<size_t>(MemoryTag::kCount);
+
+/// @brief 確保したブロックの前に置く情報。大きさは通常の確保のアラインメント(16バイト)に合わせる
+struct alignas(16) AllocationHeader {
+    uint64_t size;
+    // 元の確保の先頭からユーザーに返したポインタまでの距離
+    uint32_t offset;
+    MemoryTag tag;
+    // アラインメント指定の確保関数で確保したかどうか
+    bool isAligned;
+};
+static_assert(sizeof(AllocationHeader) == 16);
+
+/// @brief タグごとの確保と解放の累計。確保中の量は差から求めるので、1回の確保・解放で触るのは2つだけ
+struct alignas(64) TagCounter {
+    std::atomic<uint64_t> allocationCount{ 0 };
+    std::atomic<uint64_t> allocatedBytes{ 0 };
+    std::atomic<uint64_t> freeCount{ 0 };
+    std::atomic<uint64_t> freedBytes{ 0 };
+};
+
+/// @brief フレーム単位の集計や予算の状態。メインスレッドの EndFrame で更新する
+struct TagFrameState {
+    uint64_t lastAllocationCount = 0;
+    uint64_t lastAllocatedBytes = 0;
+    uint64_t frameAllocationCount = 0;
+    uint64_t frameAllocatedBytes = 0;
+    size_t peakBytes = 0;
+    size_t budgetBytes = 0;
+    bool isOverBudget = false;
+    // リーク確認の基準
+    size_t leakCheckLiveCount = 0;
+    size_t leakCheckLiveBytes = 0;
+    bool isLeakCheckIgnored = false;
+};
+
+// operator new から使うので、動的な初期化を必要としないものだけを置く
+TagCounter sCounters[kTagCount];
+thread_local MemoryTag tThreadTag = MemoryTag::kUntagged;
+
+// 集計用の状態
+std::mutex sStateMutex;
+std::array<TagFrameState, kTagCount> sFrameStates;
+bool sIsLeakCheckStarted = false;
+
+size_t GetLiveBytes(const TagCounter &counter) {
+    // 別スレッドの解放が先に見えることがあるので負にならないようにする
+    const uint64_t freed = counter.freedBytes.load(std::memory_order_relaxed);
+    const uint64_t allocated = counter.allocatedBytes.load(std::memory_order_relaxed);
+    return allocated > freed ? static_cast<size_t>(allocated - freed) : 0;
+}
+
+size_t GetLiveCount(const TagCounter &counter) {
+    const uint64_t freed = counter.freeCount.load(std::memory_order_relaxed);
+    const uint64_t allocated = counter.allocationCount.load(std::memory_order_relaxed);
+    return allocated > freed ? static_cast<size_t>(allocated - freed) : 0;
+}
+
+void *AllocateRaw(size_t size, size_t alignment) noexcept {
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void FreeRaw(void *memory) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+/// @brief ヘッダ付きでメモリを確保して数える
+/// @return 確保できなければnullptr
+void *AllocateTracked(size_t size, size_t alignment) noexcept {
+    const size_t headerSize = alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+    if (size > SIZE_MAX - headerSize) {
+        return nullptr;
+    }
+    const bool isAligned = alignment > sizeof(AllocationHeader);
+    void *raw = isAligned ? AllocateRaw(size + headerSize, alignment) : std::malloc(size + headerSize);
+    if (raw == nullptr) {
+        return nullptr;
+    }
+    std::byte *memory = static_cast<std::byte *>(raw) + headerSize;
+    AllocationHeader *header = reinterpret_cast<AllocationHeader *>(memory) - 1;
+    header->size = size;
+    header->offset = static_cast<uint32_t>(headerSize);
+    header->tag = tThreadTag;
+    header->isAligned = isAligned;
+
+    TagCounter &counter = sCounters[static_cast<size_t>(header->tag)];
+    counter.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    counter.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return memory;
+}
+
+/// @brief AllocateTracked で確保したメモリを解放して数える
+void FreeTracked(void *memory) noexcept {
+    if (memory == nullptr) {
+        return;
+    }
+    const AllocationHeader *header = static_cast<const AllocationHeader *>(memory) - 1;
+    TagCounter &counter = sCounters[static_cast<size_t>(header->tag)];
+    counter.freeCount.fetch_add(1, std::memory_order_relaxed);
+    counter.freedBytes.fetch_add(header->size, std::memory_order_relaxed);
+
+    void *raw = static_cast<std::byte *>(memory) - header->offset;
+    if (header->isAligned) {
+        FreeRaw(raw);
+    } else {
+        std::free(raw);
+    }
+}
+
+/// @brief 確保できるまで new_handler を呼ぶ(標準の operator new と同じ振る舞い)
+void *AllocateOrThrow(size_t size, size_t alignment) {
+    for (;;) {
+        if (void *memory = AllocateTracked(size, alignment)) {
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *AllocateOrNull(size_t size, size_t alignment) noexcept {
+    try {
+        return AllocateOrThrow(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+MemoryTag MemoryTracker::SetThreadTag(MemoryTag tag) noexcept {
+    const MemoryTag previousTag = tThreadTag;
+    tThreadTag = tag;
+    return previousTag;
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    TagFrameState &state = sFrameStates[static_cast<size_t>(tag)];
+    state.budgetBytes = budgetBytes;
+    state.isOverBudget = false;
+}
+
+void MemoryTracker::EndFrame() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    for (size_t i = 0; i < kTagCount; ++i) {
+        const TagCounter &counter = sCounters[i];
+        TagFrameState &state = sFrameStates[i];
+        const uint64_t allocationCount = counter.allocationCount.load(std::memory_order_relaxed);
+        const uint64_t allocatedBytes = counter.allocatedBytes.load(std::memory_order_relaxed);
+        state.frameAllocationCount = allocationCount - state.lastAllocationCount;
+        state.frameAllocatedBytes = allocatedBytes - state.lastAllocatedBytes;
+        state.lastAllocationCount = allocationCount;
+        state.lastAllocatedBytes = allocatedBytes;
+
+        const size_t liveBytes = GetLiveBytes(counter);
+        state.peakBytes = std::max(state.peakBytes, liveBytes);
+
+        // 予算を超えた時に1度だけ警告し、下回ったらまた警告できるようにする
+        if (state.budgetBytes == 0) {
+            continue;
+        }
+        const bool isOverBudget = liveBytes > state.budgetBytes;
+        if (isOverBudget && !state.isOverBudget) {
+            Log(std::format("Memory budget exceeded: {} uses {} bytes (budget {} bytes)",
+                kTagNames[i], liveBytes, state.budgetBytes), kLogLevelFlagWarning);
+        }
+        state.isOverBudget = isOverBudget;
+    }
+}
+
+std::vector<MemoryTracker::TagStats> MemoryTracker::GetStats() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    std::vector<TagStats> stats(kTagCount);
+    for (size_t i = 0; i < kTagCount; ++i) {
+        const TagCounter &counter = sCounters[i];
+        const TagFrameState &state = sFrameStates[i];
+        TagStats &tagStats = stats[i];
+        tagStats.tag = static_cast<MemoryTag>(i);
+        tagStats.name = kTagNames[i];
+        tagStats.liveBytes = GetLiveBytes(counter);
+        tagStats.liveCount = GetLiveCount(counter);
+        tagStats.peakBytes = std::max(state.peakBytes, tagStats.liveBytes);
+        tagStats.frameAllocationCount = state.frameAllocationCount;
+        tagStats.frameAllocatedBytes = state.frameAllocatedBytes;
+        tagStats.totalAllocationCount = counter.allocationCount.load(std::memory_order_relaxed);
+        tagStats.budgetBytes = state.budgetBytes;
+    }
+    return stats;
+}
+
+uint64_t MemoryTracker::GetFrameAllocationCount() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    uint64_t count = 0;
+    for (const auto &state : sFrameStates) {
+        count += state.frameAllocationCount;
+    }
+    return count;
+}
+
+uint64_t MemoryTracker::GetFrameAllocatedBytes() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    uint64_t bytes = 0;
+    for (const auto &state : sFrameStates) {
+        bytes += state.frameAllocatedBytes;
+    }
+    return bytes;
+}
+
+uint64_t MemoryTracker::GetTotalAllocationCount() noexcept {
+    uint64_t count = 0;
+    for (const auto &counter : sCounters) {
+        count += counter.allocationCount.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t MemoryTracker::GetTotalAllocatedBytes() noexcept {
+    uint64_t bytes = 0;
+    for (const auto &counter : sCounters) {
+        bytes += counter.allocatedBytes.load(std::memory_order_relaxed);
+    }
+    return bytes;
+}
+
+void MemoryTracker::BeginLeakCheck() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    for (size_t i = 0; i < kTagCount; ++i) {
+        sFrameStates[i].leakCheckLiveCount = GetLiveCount(sCounters[i]);
+        sFrameStates[i].leakCheckLiveBytes = GetLiveBytes(sCounters[i]);
+    }
+    sIsLeakCheckStarted = true;
+}
+
+void MemoryTracker::SetLeakCheckIgnored(MemoryTag tag, bool isIgnored) {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    sFrameStates[static_cast<size_t>(tag)].isLeakCheckIgnored = isIgnored;
+}
+
+bool MemoryTracker::ReportLeaks() {
+    std::lock_guard<std::mutex> lock(sStateMutex);
+    if (!sIsLeakCheckStarted) {
+        return true;
+    }
+    bool isClean = true;
+    for (size_t i = 0; i < kTagCount; ++i) {
+        const TagFrameState &state = sFrameStates[i];
+        const size_t liveCount = GetLiveCount(sCounters[i]);
+        // 終了まで持ち続けるものは、基準の後に確保していてもリークではない
+        const bool isPersistent = i == static_cast<size_t>(MemoryTag::kPersistent);
+        if (isPersistent || state.isLeakCheckIgnored || liveCount <= state.leakCheckLiveCount) {
+            continue;
+        }
+        const size_t liveBytes = GetLiveBytes(sCounters[i]);
+        Log(std::format("Memory still allocated at shutdown: {} {} blocks, {} bytes",
+            kTagNames[i], liveCount - state.leakCheckLiveCount,
+            liveBytes > state.leakCheckLiveBytes ? liveBytes - state.leakCheckLiveBytes : 0),
+            kLogLevelFlagWarning);
+        isClean = false;
+    }
+    return isClean;
+}
+#else
+MemoryTag MemoryTracker::SetThreadTag(MemoryTag) noexcept {
+    return MemoryTag::kUntagged;
+}
+void MemoryTracker::SetBudget(MemoryTag, size_t) {}
+void MemoryTracker::EndFrame() {}
+std::vector<MemoryTracker::TagStats> MemoryTracker::GetStats() {
+    return {};
+}
+uint64_t MemoryTracker::GetFrameAllocationCount() {
+    return 0;
+}
+uint64_t MemoryTracker::GetFrameAllocatedBytes() {
+    return 0;
+}
+uint64_t MemoryTracker::GetTotalAllocationCount() noexcept {
+    return 0;
+}
+uint64_t MemoryTracker::GetTotalAllocatedBytes() noexcept {
+    return 0;
+}
+void MemoryTracker::BeginLeakCheck() {}
+void MemoryTracker::SetLeakCheckIgnored(MemoryTag, bool) {}
+bool MemoryTracker::ReportLeaks() {
+    return true;
+}
+#endif
+
+} // namespace KashipanEngine
+
+#if USE_MEMORY_TRACKER
+// 全ての operator new / delete を置き換える。配列版や nothrow 版も明示的に置き換え、標準ライブラリの実装に依存しないようにする
+using KashipanEngine::AllocateOrThrow;
+using KashipanEngine::AllocateOrNull;
+using KashipanEngine::FreeTracked;
+
+namespace {
+constexpr size_t kDefaultAlignment = alignof(std::max_align_t);
+} // namespace
+
+void *operator new(size_t size) {
+    return AllocateOrThrow(size, kDefaultAlignment);
+}
+void *operator new[](size_t size) {
+    return AllocateOrThrow(size, kDefaultAlignment);
+}
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return AllocateOrNull(size, kDefaultAlignment);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return AllocateOrNull(size, kDefaultAlignment);
+}
+void *operator new(size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return AllocateOrNull(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return AllocateOrNull(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory) noexcept {
+    FreeTracked(memory);
+}
+void operator delete(void *memory, size_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory, size_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+    FreeTracked(memory);
+}
+void operator delete(void *memory, std::align_val_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory, std::align_val_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete(void *memory, size_t, std::align_val_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept {
+    FreeTracked(memory);
+}
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept {
+    FreeTracked(memory);
+}
+void operator delete[](void *memory, std::align_val_t, const std::nothrow_t &) noexcept {
+    FreeTracked(memory);
+}
+#endif
\ No newline at end of file
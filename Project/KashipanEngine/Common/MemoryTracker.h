@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// メモリの追跡はリリースビルドでは完全に取り除く(operator new も置き換えない)
+#if !RELEASE_BUILD
+#define USE_MEMORY_TRACKER 1
+#else
+#define USE_MEMORY_TRACKER 0
+#endif
+
+namespace KashipanEngine {
+
+/// @brief メモリを確保したサブシステム・アセットの種類
+enum class MemoryTag : uint8_t {
+    kUntagged,
+    kEngine,
+    kModel,
+    kTexture,
+    kFont,
+    kParticle,
+    kSound,
+    kJson,
+    kLog,
+    kScene,
+    // プログラム終了まで解放しない表・バッファ(プロファイラ、StringId の逆引き表など)。リーク確認の対象外
+    kPersistent,
+    kCount,
+};
+
+/// @brief operator new を置き換えて、ヒープの確保をタグごとに数える。
+/// 確保したブロックの前にサイズとタグを書いておくので、解放は別スレッドや別のタグのスコープで行っても良い
+class MemoryTracker {
+public:
+    MemoryTracker() = delete;
+    ~MemoryTracker() = delete;
+    MemoryTracker(const MemoryTracker &) = delete;
+    MemoryTracker &operator=(const MemoryTracker &) = delete;
+
+    /// @brief タグごとの確保の統計
+    struct TagStats {
+        MemoryTag tag = MemoryTag::kUntagged;
+        const char *name = "";
+        /// @brief 確保中のサイズ(バイト)
+        size_t liveBytes = 0;
+        /// @brief 確保中のブロック数
+        size_t liveCount = 0;
+        /// @brief フレームの終わりに確認した確保中のサイズの最大値(バイト)
+        size_t peakBytes = 0;
+        /// @brief 直近のフレームでの確保回数
+        uint64_t frameAllocationCount = 0;
+        /// @brief 直近のフレームで確保したサイズ(バイト)
+        uint64_t frameAllocatedBytes = 0;
+        /// @brief これまでの確保回数
+        uint64_t totalAllocationCount = 0;
+        /// @brief 予算(バイト)。0なら無制限
+        size_t budgetBytes = 0;
+    };
+
+    /// @brief 呼び出したスレッドで今後確保するメモリのタグの設定。通常は MEMORY_TAG_SCOPE を使う
+    /// @return 設定前のタグ
+    static MemoryTag SetThreadTag(MemoryTag tag) noexcept;
+
+    /// @brief タグの名前の取得
+    static const char *GetTagName(MemoryTag tag) noexcept;
+
+    /// @brief タグの予算の設定。フレームの終わりに超えていれば警告を出す
+    /// @param tag タグ
+    /// @param budgetBytes 予算(バイト)。0なら無制限
+    static void SetBudget(MemoryTag tag, size_t budgetBytes);
+
+    /// @brief フレームの終わりに呼び、フレームあたりの確保回数の集計と予算の確認をする
+    static void EndFrame();
+
+    /// @brief タグごとの統計の取得
+    static std::vector<TagStats> GetStats();
+
+    /// @brief 直近のフレームの全タグ合計の確保回数
+    static uint64_t GetFrameAllocationCount();
+    /// @brief 直近のフレームの全タグ合計の確保サイズ(バイト)
+    static uint64_t GetFrameAllocatedBytes();
+
+    /// @brief これまでの全タグ合計の確保回数。区間の前後の差で、その区間の確保回数を求められる
+    static uint64_t GetTotalAllocationCount() noexcept;
+    /// @brief これまでの全タグ合計の確保サイズ(バイト)
+    static uint64_t GetTotalAllocatedBytes() noexcept;
+
+    /// @brief 現在の確保状況を終了時のリーク確認の基準にする
+    static void BeginLeakCheck();
+    /// @brief リーク確認の対象から外すタグの設定(プログラム終了まで保持するキャッシュなど)
+    static void SetLeakCheckIgnored(MemoryTag tag, bool isIgnored);
+    /// @brief BeginLeakCheck の時点より確保中のブロックが増えているタグをログに出力する。
+    /// MemoryTag::kPersistent と SetLeakCheckIgnored で外したタグは数えない
+    /// @return 増えているタグが無かったかどうか
+    static bool ReportLeaks();
+};
+
+/// @brief スコープを抜けるまで、確保するメモリに指定のタグを付ける
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) noexcept : previousTag_(MemoryTracker::SetThreadTag(tag)) {}
+    ~MemoryTagScope() noexcept {
+        MemoryTracker::SetThreadTag(previousTag_);
+    }
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+private:
+    MemoryTag previousTag_;
+};
+
+} // namespace KashipanEngine
+
+#if USE_MEMORY_TRACKER
+#define MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_INNER(a, b)
+/// @brief スコープを抜けるまで、確保するメモリに MemoryTag::tag を付ける
+#define MEMORY_TAG_SCOPE(tag) ::KashipanEngine::MemoryTagScope MEMORY_TAG_CONCAT(memoryTagScope_, __LINE__)(::KashipanEngine::MemoryTag::tag)
+#else
+#define MEMORY_TAG_SCOPE(tag) static_cast<void>(0)
+#endif
\ No newline at end of file
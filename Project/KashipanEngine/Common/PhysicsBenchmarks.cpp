@@ -0,0 +1,180 @@
+#include <format>
+#include <random>
+#include "PhysicsBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+#include "Math/Physics/PhysicsWorld.h"
+#include "Math/Physics/SpringSystem.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 積み上げる列の数(一辺)
+const int kStackColumnCount = 20;
+// 1列に積み上げる箱の数
+const int kStackHeight = 5;
+// 落下させる球の数
+const int kScatterSphereCount = 4000;
+// 計測の前に進めるステップ数(積み上げた箱が落ち着くまで)
+const int kSettleStepCount = 120;
+// 再現性を確かめるステップ数
+const int kReproduceStepCount = 240;
+// 布の一辺の質点数
+const uint32_t kClothSize = 256;
+// 布の1フレームの時間
+const float kClothDeltaTime = 1.0f / 60.0f;
+
+/// @brief 地面の上に箱を積み上げたワールドを作る
+void BuildStacks(PhysicsWorld &world) {
+    world.Clear();
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    RigidBodyDesc desc;
+    desc.shape = RigidBodyShape::kAABB;
+    desc.halfExtents = Vector3(0.5f, 0.5f, 0.5f);
+    desc.friction = 0.6f;
+    for (int x = 0; x < kStackColumnCount; ++x) {
+        for (int z = 0; z < kStackColumnCount; ++z) {
+            for (int y = 0; y < kStackHeight; ++y) {
+                desc.position = Vector3(static_cast<float>(x) * 1.5f, 0.5f + static_cast<float>(y) * 1.0f,
+                    static_cast<float>(z) * 1.5f);
+                world.AddBody(desc);
+            }
+        }
+    }
+}
+
+/// @brief 壁で囲んだ箱の中に球をばらまいたワールドを作る
+void BuildScatter(PhysicsWorld &world) {
+    world.Clear();
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    world.AddPlane(Math::Plane(Vector3(1.0f, 0.0f, 0.0f), -20.0f));
+    world.AddPlane(Math::Plane(Vector3(-1.0f, 0.0f, 0.0f), -20.0f));
+    world.AddPlane(Math::Plane(Vector3(0.0f, 0.0f, 1.0f), -20.0f));
+    world.AddPlane(Math::Plane(Vector3(0.0f, 0.0f, -1.0f), -20.0f));
+    std::mt19937 engine(20240601u);
+    std::uniform_real_distribution<float> horizontal(-19.0f, 19.0f);
+    std::uniform_real_distribution<float> vertical(1.0f, 40.0f);
+    RigidBodyDesc desc;
+    desc.shape = RigidBodyShape::kSphere;
+    desc.radius = 0.4f;
+    desc.restitution = 0.2f;
+    for (int i = 0; i < kScatterSphereCount; ++i) {
+        desc.position = Vector3(horizontal(engine), vertical(engine), horizontal(engine));
+        world.AddBody(desc);
+    }
+}
+
+/// @brief 上の2つの角を固定して、球の上に垂らした布を作る
+ClothGrid BuildCloth(SpringSystem &system, bool isParallel) {
+    system.Clear();
+    system.SetParallel(isParallel);
+    const float spacing = 4.0f / static_cast<float>(kClothSize - 1);
+    const ClothGrid grid = system.CreateCloth(Vector3(-2.0f, 3.0f, -2.0f), Vector3(spacing, 0.0f, 0.0f),
+        Vector3(0.0f, 0.0f, spacing), kClothSize, kClothSize);
+    system.Pin(grid.firstParticle);
+    system.Pin(grid.firstParticle + kClothSize - 1);
+    system.AddCollider(Math::Sphere(Vector3(0.0f, 1.5f, 0.0f), 1.0f));
+    system.AddCollider(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    return grid;
+}
+
+/// @brief 同じ初期状態から進めた2つのワールドが毎ステップ一致するかを確かめる
+bool VerifyReproducibility() {
+    PhysicsWorld worlds[2];
+    for (auto &world : worlds) {
+        BuildStacks(world);
+    }
+    for (int step = 0; step < kReproduceStepCount; ++step) {
+        worlds[0].StepFixed();
+        worlds[1].StepFixed();
+        if (worlds[0].ComputeStateHash() != worlds[1].ComputeStateHash()) {
+            Log(std::format("Physics world diverged at step {}", step), kLogLevelFlagError);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool RunPhysicsBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n=============== Physics Benchmarks ===============\n");
+    PhysicsWorld stackWorld;
+    BuildStacks(stackWorld);
+    stackWorld.SetSleepEnabled(false);
+    for (int i = 0; i < kSettleStepCount; ++i) {
+        stackWorld.StepFixed();
+    }
+    PhysicsWorld sleepingWorld;
+    BuildStacks(sleepingWorld);
+    for (int i = 0; i < kSettleStepCount; ++i) {
+        sleepingWorld.StepFixed();
+    }
+    PhysicsWorld scatterWorld;
+    SpringSystem parallelCloth;
+    SpringSystem serialCloth;
+    BuildCloth(parallelCloth, true);
+    BuildCloth(serialCloth, false);
+
+    MyStd::Benchmark benchmark;
+    benchmark.SetSampleCount(7);
+    // 1回で1ステップ進める(積み上げた状態は計測中もほぼ変わらない)
+    benchmark.Add("Physics/Stacks2000Boxes", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            stackWorld.StepFixed();
+        }
+        DoNotOptimize(stackWorld.GetContacts().data());
+    });
+    benchmark.Add("Physics/Stacks2000BoxesSleeping", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            sleepingWorld.StepFixed();
+        }
+        DoNotOptimize(sleepingWorld.GetContacts().data());
+    });
+    // 1回でばらまいた球が積もるまでの60ステップ
+    benchmark.Add("Physics/Scatter4000Spheres60Steps", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            BuildScatter(scatterWorld);
+            for (int step = 0; step < 60; ++step) {
+                scatterWorld.StepFixed();
+            }
+        }
+        DoNotOptimize(scatterWorld.GetContacts().data());
+    });
+    // 1回で布の1フレーム(8サブステップ)
+    benchmark.Add("Physics/Cloth256x256", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            parallelCloth.Update(kClothDeltaTime);
+        }
+        DoNotOptimize(parallelCloth.GetPosition(0));
+    });
+    benchmark.Add("Physics/Cloth256x256Serial", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            serialCloth.Update(kClothDeltaTime);
+        }
+        DoNotOptimize(serialCloth.GetPosition(0));
+    });
+    const auto results = benchmark.Run();
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<40} {:12.3f} us  (min {:.3f} us, max {:.3f} us, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration / 1000.0, result.minNanosecondsPerIteration / 1000.0,
+            result.maxNanosecondsPerIteration / 1000.0, result.iterationCount, result.sampleCount));
+    }
+    LogSimple(std::format("Stacks: {} bodies, {} contacts, {} islands; sleeping: {} awake bodies",
+        stackWorld.GetBodyCount(), stackWorld.GetContacts().size(), stackWorld.GetIslandCount(),
+        sleepingWorld.GetAwakeBodyCount()));
+    LogSimple(std::format("Cloth: {} particles, {} springs, {} batches", parallelCloth.GetParticleCount(),
+        parallelCloth.GetSpringCount(), parallelCloth.GetBatchCount()));
+    const bool isReproduced = VerifyReproducibility();
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance) && isReproduced;
+    Log(std::format("Physics benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief 物理ワールドのベンチマークを実行する。
+/// 積み上げた2000個の箱(眠らせない・眠らせる)と、落下する4000個の球の1ステップの時間、
+/// 256x256 の布(並列・逐次)の1フレームの時間を計測する。
+/// 同じ初期状態から進めた2つのワールドの状態が一致するかも確かめる。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものと結果の違いが無かったかどうか
+bool RunPhysicsBenchmarks(const std::string &outputPath = "Logs/Benchmarks/physics.json",
+    const std::string &baselinePath = "Benchmarks/physics_baseline.json", double tolerance = 0.25);
+
+} // namespace KashipanEngine
\ No newline at end of file
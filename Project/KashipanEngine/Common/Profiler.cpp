@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <json.hpp>
+#include <FlatHashMap.h>
+#include "Common/JsoncLoader.h"
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+#include "Common/StringId.h"
+#include "Profiler.h"
+
+namespace KashipanEngine {
+
+#if USE_PROFILER
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// スレッドごとに保持するゾーン数(2の累乗)
+constexpr uint64_t kThreadBufferCapacity = 1 << 15;
+// 統計に使うフレーム数
+constexpr size_t kStatsFrameCount = 120;
+// トレース書き出し用に保持する時間(秒)
+constexpr double kHistorySeconds = 5.0;
+
+/// @brief 記録したゾーン。書き込み中に集計スレッドから読まれるので各値はアトミックにする
+struct ZoneEvent {
+    std::atomic<const char *> name{ nullptr };
+    std::atomic<uint64_t> begin{ 0 };
+    std::atomic<uint64_t> end{ 0 };
+};
+
+/// @brief スレッド専用のリングバッファ。書き込むのは持ち主のスレッドだけ
+struct ThreadBuffer {
+    uint32_t threadIndex = 0;
+    std::string threadName;
+    std::unique_ptr<ZoneEvent[]> events = std::make_unique<ZoneEvent[]>(kThreadBufferCapacity);
+    std::atomic<uint64_t> writeCount{ 0 };
+    // ここまで集計した位置(集計側だけが触る)
+    uint64_t readCount = 0;
+    // 持ち主のスレッドが終了して、別のスレッドが使っても良いかどうか
+    std::atomic<bool> isRetired{ false };
+};
+
+/// @brief スレッドの終了時にバッファを手放す
+struct ThreadBufferOwner {
+    ThreadBuffer *buffer = nullptr;
+    ~ThreadBufferOwner() {
+        if (buffer) {
+            buffer->isRetired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+/// @brief 集計済みのゾーン
+struct CollectedZone {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t threadIndex;
+};
+
+/// @brief ゾーンごとのフレーム単位の処理時間の履歴
+struct ZoneHistory {
+    const char *name = nullptr;
+    std::array<double, kStatsFrameCount> frames{};
+    size_t frameCount = 0;
+    // 集計中のフレームの合計
+    uint64_t pendingTicks = 0;
+    uint32_t pendingCallCount = 0;
+    uint32_t lastCallCount = 0;
+    double last = 0.0;
+};
+
+struct ProfilerState {
+    std::mutex bufferMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::mutex collectMutex;
+    std::deque<CollectedZone> history;
+    MyStd::FlatHashMap<StringId::HashType, ZoneHistory> zones;
+    std::vector<CollectedZone> scratch;
+
+    // 時刻の単位を秒に変換するための基準
+    const uint64_t baseTimestamp = Profiler::GetTimestamp();
+    const Clock::time_point baseTime = Clock::now();
+};
+
+ProfilerState &GetState() {
+    // 静的初期化中のスレッドから記録されることもあるので関数内で生成する
+    static ProfilerState state;
+    return state;
+}
+
+// 記録のたびに触るのでデストラクタを持たない方に入れておく
+thread_local ThreadBuffer *tThreadBuffer = nullptr;
+thread_local ThreadBufferOwner tThreadBufferOwner;
+// 登録していないスレッドから記録されて捨てたゾーンの数
+std::atomic<uint64_t> sDroppedZoneCount{ 0 };
+
+/// @brief 呼び出したスレッドのバッファを取得する。無ければ確保する
+ThreadBuffer &GetThreadBuffer() {
+    if (tThreadBuffer == nullptr) {
+        // バッファはスレッドが終了しても使い回すので、プログラム終了まで解放しない
+        MEMORY_TAG_SCOPE(kPersistent);
+        auto &state = GetState();
+        std::lock_guard<std::mutex> lock(state.bufferMutex);
+        // 終了したスレッドのバッファがあれば使い回す。
+        // 書き込み位置は続きからなので、未集計のゾーンもそのまま集計される
+        ThreadBuffer *buffer = nullptr;
+        for (auto &retired : state.buffers) {
+            if (retired->isRetired.load(std::memory_order_acquire)) {
+                buffer = retired.get();
+                buffer->isRetired.store(false, std::memory_order_relaxed);
+                break;
+            }
+        }
+        if (buffer == nullptr) {
+            // スレッドが終了しても集計できるよう、バッファはプロファイラが持ち続ける
+            state.buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = state.buffers.back().get();
+            buffer->threadIndex = static_cast<uint32_t>(state.buffers.size() - 1);
+        }
+        buffer->threadName = "Thread " + std::to_string(buffer->threadIndex);
+        tThreadBuffer = buffer;
+        tThreadBufferOwner.buffer = buffer;
+    }
+    return *tThreadBuffer;
+}
+
+/// @brief 1秒あたりの時刻の刻み数
+double GetTicksPerSecond() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    // rdtsc の周波数は起動からの経過時間と比べて求める
+    auto &state = GetState();
+    auto elapsed = Clock::now() - state.baseTime;
+    while (elapsed < std::chrono::milliseconds(1)) {
+        elapsed = Clock::now() - state.baseTime;
+    }
+    const uint64_t ticks = Profiler::GetTimestamp() - state.baseTimestamp;
+    return static_cast<double>(ticks) / std::chrono::duration<double>(elapsed).count();
+#else
+    return static_cast<double>(Clock::period::den) / static_cast<double>(Clock::period::num);
+#endif
+}
+
+/// @brief 各スレッドのバッファから未集計のゾーンを取り出す。collectMutex をロックした状態で呼ぶ
+void CollectZones(ProfilerState &state, std::vector<CollectedZone> &zones) {
+    std::vector<ThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> lock(state.bufferMutex);
+        for (auto &buffer : state.buffers) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    for (ThreadBuffer *buffer : buffers) {
+        const uint64_t end = buffer->writeCount.load(std::memory_order_acquire);
+        uint64_t begin = std::max(buffer->readCount, end > kThreadBufferCapacity ? end - kThreadBufferCapacity : 0);
+        const size_t firstIndex = zones.size();
+        for (uint64_t i = begin; i < end; ++i) {
+            const ZoneEvent &event = buffer->events[i & (kThreadBufferCapacity - 1)];
+            zones.push_back({
+                event.name.load(std::memory_order_relaxed),
+                event.begin.load(std::memory_order_relaxed),
+                event.end.load(std::memory_order_relaxed),
+                buffer->threadIndex
+            });
+        }
+        // 読んでいる間に一周して上書きされたかもしれない分は捨てる
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = buffer->writeCount.load(std::memory_order_relaxed);
+        if (after >= kThreadBufferCapacity && after - kThreadBufferCapacity + 1 > begin) {
+            const uint64_t overwritten = std::min(after - kThreadBufferCapacity + 1, end) - begin;
+            zones.erase(zones.begin() + firstIndex, zones.begin() + firstIndex + static_cast<size_t>(overwritten));
+        }
+        buffer->readCount = end;
+    }
+}
+
+/// @brief 保持しているゾーンから Chrome の Trace Event 形式のJSONを作る
+nlohmann::json CreateChromeTrace(double lastSeconds) {
+    auto &state = GetState();
+    std::vector<CollectedZone> zones;
+    std::vector<std::pair<uint32_t, std::string>> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(state.collectMutex);
+        zones.assign(state.history.begin(), state.history.end());
+    }
+    {
+        std::lock_guard<std::mutex> lock(state.bufferMutex);
+        for (const auto &buffer : state.buffers) {
+            threadNames.emplace_back(buffer->threadIndex, buffer->threadName);
+        }
+    }
+
+    const double microsecondsPerTick = 1000000.0 / GetTicksPerSecond();
+    uint64_t newest = 0;
+    for (const auto &zone : zones) {
+        newest = std::max(newest, zone.end);
+    }
+    const uint64_t oldestAllowed = lastSeconds > 0.0
+        ? newest - std::min(newest, static_cast<uint64_t>(lastSeconds * 1000000.0 / microsecondsPerTick))
+        : 0;
+    uint64_t origin = UINT64_MAX;
+    for (const auto &zone : zones) {
+        if (zone.end >= oldestAllowed) {
+            origin = std::min(origin, zone.begin);
+        }
+    }
+
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto &[threadIndex, threadName] : threadNames) {
+        events.push_back({
+            { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", threadIndex },
+            { "args", { { "name", threadName } } },
+        });
+    }
+    for (const auto &zone : zones) {
+        if (zone.end < oldestAllowed) {
+            continue;
+        }
+        events.push_back({
+            { "name", zone.name }, { "ph", "X" }, { "pid", 1 }, { "tid", zone.threadIndex },
+            { "ts", static_cast<double>(zone.begin - origin) * microsecondsPerTick },
+            { "dur", static_cast<double>(zone.end - zone.begin) * microsecondsPerTick },
+        });
+    }
+
+    return nlohmann::json{ { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } };
+}
+
+} // namespace
+
+void Profiler::RegisterThread(const std::string &name) {
+    MEMORY_TAG_SCOPE(kPersistent);
+    ThreadBuffer &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetState().bufferMutex);
+    buffer.threadName = name;
+}
+
+uint64_t Profiler::GetDroppedZoneCount() noexcept {
+    return sDroppedZoneCount.load(std::memory_order_relaxed);
+}
+
+void Profiler::RecordZone(const char *name, uint64_t begin, uint64_t end) noexcept {
+    // バッファ(約 800 KB)の確保は RegisterThread で済ませておき、ここでは確保しない
+    ThreadBuffer *threadBuffer = tThreadBuffer;
+    if (threadBuffer == nullptr) {
+        sDroppedZoneCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ThreadBuffer &buffer = *threadBuffer;
+    const uint64_t index = buffer.writeCount.load(std::memory_order_relaxed);
+    ZoneEvent &event = buffer.events[index & (kThreadBufferCapacity - 1)];
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(begin, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    buffer.writeCount.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::EndFrame() {
+    // 集計用の表と履歴はプログラム終了まで持ち続ける
+    MEMORY_TAG_SCOPE(kPersistent);
+    auto &state = GetState();
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+
+    state.scratch.clear();
+    CollectZones(state, state.scratch);
+
+    // ゾーンごとにこのフレームの合計時間を集計する
+    uint64_t newest = 0;
+    for (const auto &zone : state.scratch) {
+        newest = std::max(newest, zone.end);
+        ZoneHistory &history = state.zones[StringId::Hash(zone.name)];
+        history.name = zone.name;
+        history.pendingTicks += zone.end - zone.begin;
+        ++history.pendingCallCount;
+        state.history.push_back(zone);
+    }
+    const double millisecondsPerTick = 1000.0 / GetTicksPerSecond();
+    for (auto &[hash, history] : state.zones) {
+        history.lastCallCount = history.pendingCallCount;
+        if (history.pendingCallCount == 0) {
+            continue;
+        }
+        history.last = static_cast<double>(history.pendingTicks) * millisecondsPerTick;
+        history.frames[history.frameCount % kStatsFrameCount] = history.last;
+        ++history.frameCount;
+        history.pendingTicks = 0;
+        history.pendingCallCount = 0;
+    }
+
+    // 古いゾーンはトレース用の履歴から捨てる
+    if (newest != 0) {
+        const uint64_t keepTicks = static_cast<uint64_t>(kHistorySeconds * 1000.0 / millisecondsPerTick);
+        while (!state.history.empty() && state.history.front().end + keepTicks < newest) {
+            state.history.pop_front();
+        }
+    }
+}
+
+std::vector<Profiler::ZoneStats> Profiler::GetZoneStats() {
+    auto &state = GetState();
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+
+    std::vector<ZoneStats> result;
+    std::vector<double> samples;
+    for (const auto &[hash, history] : state.zones) {
+        const size_t count = std::min(history.frameCount, kStatsFrameCount);
+        if (count == 0) {
+            continue;
+        }
+        samples.assign(history.frames.begin(), history.frames.begin() + count);
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        ZoneStats stats;
+        stats.name = history.name;
+        stats.frameCount = static_cast<uint32_t>(count);
+        stats.lastCallCount = history.lastCallCount;
+        stats.last = history.last;
+        stats.min = samples.front();
+        stats.average = sum / static_cast<double>(count);
+        stats.p99 = samples[static_cast<size_t>(0.99 * static_cast<double>(count - 1) + 0.5)];
+        stats.max = samples.back();
+        result.push_back(std::move(stats));
+    }
+    std::sort(result.begin(), result.end(), [](const ZoneStats &a, const ZoneStats &b) {
+        return a.average > b.average;
+    });
+    return result;
+}
+
+bool Profiler::ExportChromeTrace(const std::string &filePath, double lastSeconds) {
+    std::ofstream file(filePath);
+    if (!file) {
+        Log("Failed to open trace file: " + filePath, kLogLevelFlagError);
+        return false;
+    }
+    file << CreateChromeTrace(lastSeconds).dump();
+    Log("Exported profiler trace: " + filePath);
+    return true;
+}
+
+std::shared_future<bool> Profiler::ExportChromeTraceAsync(const std::string &filePath, double lastSeconds) {
+    // 集計済みのゾーンの複製までをここで行い、文字列化と書き込みは保存用のスレッドに任せる
+    return SaveJsoncAsync(CreateChromeTrace(lastSeconds), filePath, -1);
+}
+#else
+void Profiler::RegisterThread(const std::string &) {}
+uint64_t Profiler::GetDroppedZoneCount() noexcept {
+    return 0;
+}
+void Profiler::RecordZone(const char *, uint64_t, uint64_t) noexcept {}
+void Profiler::EndFrame() {}
+std::vector<Profiler::ZoneStats> Profiler::GetZoneStats() {
+    return {};
+}
+bool Profiler::ExportChromeTrace(const std::string &, double) {
+    return false;
+}
+std::shared_future<bool> Profiler::ExportChromeTraceAsync(const std::string &, double) {
+    std::promise<bool> promise;
+    promise.set_value(false);
+    return promise.get_future().share();
+}
+#endif
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <future>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// プロファイラはリリースビルドでは完全に取り除く
+#if !RELEASE_BUILD
+#define USE_PROFILER 1
+#else
+#define USE_PROFILER 0
+#endif
+
+namespace KashipanEngine {
+
+/// @brief 区間(ゾーン)ごとの処理時間を計測するプロファイラ。
+/// 各スレッドは自分専用のバッファに書き込むだけなので計測中にロックは取らない
+class Profiler {
+public:
+    Profiler() = delete;
+    ~Profiler() = delete;
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    /// @brief ゾーンの1フレームあたりの処理時間の統計(ミリ秒)
+    struct ZoneStats {
+        std::string name;
+        /// @brief 統計に使ったフレーム数
+        uint32_t frameCount = 0;
+        /// @brief 直近のフレームでの呼び出し回数
+        uint32_t lastCallCount = 0;
+        double last = 0.0;
+        double min = 0.0;
+        double average = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /// @brief 計測の有効・無効の設定
+    static void SetEnabled(bool isEnabled) noexcept {
+        isEnabled_.store(isEnabled, std::memory_order_relaxed);
+    }
+    /// @brief 計測が有効かどうか
+    static bool IsEnabled() noexcept {
+        return isEnabled_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief 呼び出したスレッドを登録し、記録用のバッファを確保する。
+    /// RecordZone は確保をしないので、ゾーンを記録するスレッドは始めに呼んでおく(登録前のゾーンは捨てる)。
+    /// 登録済みのスレッドで呼ぶと名前だけ変える
+    /// @param name スレッド名(トレース表示用)
+    static void RegisterThread(const std::string &name);
+
+    /// @brief 登録していないスレッドから記録されて捨てたゾーンの数
+    static uint64_t GetDroppedZoneCount() noexcept;
+
+    /// @brief フレームの終わりに呼び、各スレッドの計測結果を集計する
+    static void EndFrame();
+
+    /// @brief ゾーンごとの統計の取得(直近の平均が大きい順)
+    static std::vector<ZoneStats> GetZoneStats();
+
+    /// @brief Chrome の Trace Event 形式(chrome://tracing や Perfetto で開ける)で書き出す
+    /// @param filePath 書き出すファイルのパス
+    /// @param lastSeconds 直近何秒分を書き出すか。0以下なら保持している全て
+    /// @return 書き出せたかどうか
+    static bool ExportChromeTrace(const std::string &filePath, double lastSeconds = 0.0);
+
+    /// @brief ExportChromeTrace と同じ内容を保存用のスレッドで書き出す(SaveJsoncAsync を使う)
+    /// @param filePath 書き出すファイルのパス
+    /// @param lastSeconds 直近何秒分を書き出すか。0以下なら保持している全て
+    /// @return 書き出せたかどうかを受け取る future
+    static std::shared_future<bool> ExportChromeTraceAsync(const std::string &filePath, double lastSeconds = 0.0);
+
+    /// @brief 計測用の時刻の取得
+    static uint64_t GetTimestamp() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /// @brief ゾーンの記録。通常は PROFILE_SCOPE から呼ばれる。
+    /// 確保もロックもしない。RegisterThread していないスレッドでは何もしない
+    /// @param name ゾーン名(文字列リテラルなど、プログラム終了まで有効な文字列)
+    /// @param begin 開始時刻
+    /// @param end 終了時刻
+    static void RecordZone(const char *name, uint64_t begin, uint64_t end) noexcept;
+
+private:
+    static inline std::atomic<bool> isEnabled_{ true };
+};
+
+/// @brief スコープを抜けるまでをゾーンとして記録する
+class ProfileScope {
+public:
+    explicit ProfileScope(const char *name) noexcept :
+        name_(name), begin_(Profiler::IsEnabled() ? Profiler::GetTimestamp() : 0) {}
+    ~ProfileScope() noexcept {
+        if (begin_ != 0) {
+            Profiler::RecordZone(name_, begin_, Profiler::GetTimestamp());
+        }
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *name_;
+    uint64_t begin_;
+};
+
+} // namespace KashipanEngine
+
+#if USE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+/// @brief スコープを抜けるまでを name のゾーンとして計測する
+#define PROFILE_SCOPE(name) ::KashipanEngine::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+/// @brief 関数全体を関数名のゾーンとして計測する
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#define PROFILE_FUNCTION() static_cast<void>(0)
+#endif
\ No newline at end of file
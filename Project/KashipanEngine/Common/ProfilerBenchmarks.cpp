@@ -0,0 +1,83 @@
+#include <format>
+#include "ProfilerBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+#include "Common/Profiler.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// 有効なゾーン 1 個にかけてよい時間(ナノ秒)
+const double kZoneBudgetNanoseconds = 50.0;
+// 予算と比べるベンチマークの名前
+const char kEnabledZoneName[] = "Profiler/PROFILE_SCOPE enabled";
+
+} // namespace
+
+bool RunProfilerBenchmarks(const std::string &outputPath, const std::string &baselinePath, double tolerance) {
+#if USE_PROFILER
+    // 計測前に登録してバッファを確保しておく(登録していないとゾーンは捨てられる)
+    Profiler::RegisterThread("Main");
+    const bool wasEnabled = Profiler::IsEnabled();
+
+    MyStd::Benchmark benchmark;
+    benchmark.SetSampleCount(15);
+    benchmark.Add("Profiler/GetTimestamp", [](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            DoNotOptimize(Profiler::GetTimestamp());
+        }
+    });
+    // 時刻の取得を除いた、バッファへの書き込みだけの時間
+    benchmark.Add("Profiler/RecordZone", [](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            Profiler::RecordZone("ProfilerBenchmarks", i, i + 1);
+        }
+    });
+    benchmark.Add(kEnabledZoneName, [](uint64_t iterationCount) {
+        Profiler::SetEnabled(true);
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            PROFILE_SCOPE("ProfilerBenchmarks");
+        }
+    });
+    benchmark.Add("Profiler/PROFILE_SCOPE disabled", [](uint64_t iterationCount) {
+        Profiler::SetEnabled(false);
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            PROFILE_SCOPE("ProfilerBenchmarks");
+        }
+    });
+    const auto results = benchmark.Run();
+    Profiler::SetEnabled(wasEnabled);
+    // 計測で書き込んだゾーンを統計に混ぜない
+    Profiler::EndFrame();
+
+    bool isInBudget = true;
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<36} {:14.2f} ns  (min {:.2f} ns, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration, result.minNanosecondsPerIteration,
+            result.iterationCount, result.sampleCount));
+        // ばらつきの影響を受けないよう、予算とは最小値で比べる
+        if (result.name == kEnabledZoneName && result.minNanosecondsPerIteration > kZoneBudgetNanoseconds) {
+            Log(std::format("{}: {:.2f} ns exceeds the budget of {:.0f} ns", result.name,
+                result.minNanosecondsPerIteration, kZoneBudgetNanoseconds), kLogLevelFlagWarning);
+            isInBudget = false;
+        }
+    }
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance) && isInBudget;
+    Log(std::format("Profiler benchmarks finished: {} benchmarks, {}", results.size(),
+        isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+#else
+    static_cast<void>(outputPath);
+    static_cast<void>(baselinePath);
+    static_cast<void>(tolerance);
+    Log("Profiler benchmarks skipped: the profiler is compiled out", kLogLevelFlagWarning);
+    return true;
+#endif
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief プロファイラのベンチマークを実行する。
+/// 時刻の取得・RecordZone・PROFILE_SCOPE(有効・無効)の1回あたりの時間を計り、
+/// 有効なゾーンが 1 個 50 ns の予算に収まっているかを確かめる。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったもの・予算を超えたものが無かったかどうか
+bool RunProfilerBenchmarks(const std::string &outputPath = "Logs/Benchmarks/profiler.json",
+    const std::string &baselinePath = "Benchmarks/profiler_baseline.json", double tolerance = 0.25);
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -6,11 +6,22 @@ namespace KashipanEngine {
 
 namespace {
 std::mt19937 randomEngine;
+// 最後に設定したシード値
+uint32_t sRandomSeed = std::mt19937::default_seed;
 } // namespace
 
 void InitializeRandom() {
     std::random_device rd;
-    randomEngine.seed(rd());
+    SetRandomSeed(rd());
+}
+
+void SetRandomSeed(uint32_t seed) {
+    sRandomSeed = seed;
+    randomEngine.seed(seed);
+}
+
+uint32_t GetRandomSeed() {
+    return sRandomSeed;
 }
 
 int GetRandomInt() {
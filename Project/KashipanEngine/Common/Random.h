@@ -1,10 +1,19 @@
 #pragma once
+#include <cstdint>
 
 namespace KashipanEngine {
 
-/// @brief 乱数初期化用関数
+/// @brief 乱数初期化用関数。シード値は毎回変わる
 void InitializeRandom();
 
+/// @brief 乱数のシード値の設定。同じシード値からは同じ乱数列になる(入力の記録の再生用)
+/// @param seed シード値
+void SetRandomSeed(uint32_t seed);
+
+/// @brief 最後に設定したシード値の取得
+/// @return シード値
+uint32_t GetRandomSeed();
+
 /// @brief 乱数の生成
 /// @return int型の最小値以上最大値以下の乱数
 int GetRandomInt();
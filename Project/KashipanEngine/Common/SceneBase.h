@@ -1,7 +1,9 @@
 #pragma once
-#include "KashipanEngine.h"
 #include <string>
 
+// 前方宣言(KashipanEngine.h は Windows に依存するので、シーンの実装側でインクルードする)
+class Engine;
+
 namespace KashipanEngine {
 
 class SceneBase {
@@ -14,7 +16,11 @@ public:
     virtual void Initialize() = 0;
     virtual void Finalize() = 0;
 
+    /// @brief フレームごとの更新。入力の受け付けや UI など、描画に合わせて動かす処理を書く
     virtual void Update() = 0;
+    /// @brief 固定ステップ更新。Engine::BeginFixedUpdate が true を返す間、1ティックごとに呼ばれる。
+    /// 物理(PhysicsWorld::StepFixed)や KeyFrameAnimation など、フレームレートで結果が変わってはいけない処理を書く
+    virtual void FixedUpdate() {}
     virtual void Draw() = 0;
 
     bool IsInitialized() const { return isInitialized_; }
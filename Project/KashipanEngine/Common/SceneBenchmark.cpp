@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include "Base/SceneManager.h"
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+#include "SceneBenchmark.h"
+
+namespace KashipanEngine {
+
+SceneBenchmarkResult RunSceneBenchmark(const std::string &sceneName, uint32_t frameCount, uint32_t warmupFrameCount,
+    const SceneBenchmarkFrameFunctions &frameFunctions) {
+    SceneBenchmarkResult result;
+    result.sceneName = sceneName;
+    const auto sceneNames = SceneManager::GetSceneNames();
+    if (std::find(sceneNames.begin(), sceneNames.end(), sceneName) == sceneNames.end()) {
+        Log("Benchmark scene '" + sceneName + "' does not exist.", kLogLevelFlagWarning);
+        return result;
+    }
+    SceneManager::SetActiveScene(sceneName);
+
+    MyStd::FrameTimeStats frameTimeStats(frameCount);
+    uint64_t drawCallCount = 0;
+    uint64_t instanceCount = 0;
+    uint64_t heapAllocationCount = 0;
+    for (uint32_t i = 0; i < warmupFrameCount + frameCount; ++i) {
+        if (frameFunctions.processMessage() == false) {
+            break;
+        }
+        const auto frameBegin = std::chrono::steady_clock::now();
+        if (frameFunctions.beginFrame() == false) {
+            continue;
+        }
+        SceneManager::UpdateActiveScene();
+        while (frameFunctions.beginFixedUpdate()) {
+            SceneManager::FixedUpdateActiveScene();
+        }
+        SceneManager::DrawActiveScene();
+        frameFunctions.endFrame();
+        const auto frameEnd = std::chrono::steady_clock::now();
+        if (i < warmupFrameCount) {
+            continue;
+        }
+        frameTimeStats.AddFrame(std::chrono::duration<double, std::milli>(frameEnd - frameBegin).count());
+        const DrawStats drawStats = frameFunctions.getDrawStats();
+        drawCallCount += drawStats.drawCallCount;
+        instanceCount += drawStats.instanceCount;
+        heapAllocationCount += MemoryTracker::GetFrameAllocationCount();
+    }
+
+    result.frameTime = frameTimeStats.GetSummary();
+    if (result.frameTime.sampleCount > 0) {
+        const double sampleCount = static_cast<double>(result.frameTime.sampleCount);
+        result.drawCallsPerFrame = static_cast<double>(drawCallCount) / sampleCount;
+        result.instancesPerFrame = static_cast<double>(instanceCount) / sampleCount;
+        result.heapAllocationsPerFrame = static_cast<double>(heapAllocationCount) / sampleCount;
+    }
+    Log(std::format("Benchmark [{}]: {} frames, avg {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms, "
+        "{:.1f} draws/frame, {:.1f} instances/frame, {:.1f} allocs/frame",
+        sceneName, result.frameTime.sampleCount, result.frameTime.average, result.frameTime.p50, result.frameTime.p95,
+        result.frameTime.p99, result.frameTime.max, result.drawCallsPerFrame, result.instancesPerFrame, result.heapAllocationsPerFrame));
+    return result;
+}
+
+std::vector<SceneBenchmarkResult> RunSceneBenchmarks(uint32_t frameCount, uint32_t warmupFrameCount,
+    const SceneBenchmarkFrameFunctions &frameFunctions) {
+    std::vector<SceneBenchmarkResult> results;
+    const auto sceneNames = SceneManager::GetSceneNames();
+    if (sceneNames.empty()) {
+        Log("No scenes to benchmark.", kLogLevelFlagWarning);
+        return results;
+    }
+    const std::string activeSceneName = SceneManager::GetActiveSceneName();
+    for (const auto &sceneName : sceneNames) {
+        results.push_back(RunSceneBenchmark(sceneName, frameCount, warmupFrameCount, frameFunctions));
+    }
+    if (!activeSceneName.empty()) {
+        SceneManager::SetActiveScene(activeSceneName);
+    }
+    return results;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
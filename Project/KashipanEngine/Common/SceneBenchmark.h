@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <FrameTimeStats.h>
+#include "Common/DrawStats.h"
+
+namespace KashipanEngine {
+
+/// @brief シーンのベンチマークの結果
+struct SceneBenchmarkResult {
+    /// @brief シーン名
+    std::string sceneName;
+    /// @brief CPUのフレーム時間の統計(ミリ秒)
+    MyStd::FrameTimeStats::Summary frameTime;
+    /// @brief 1フレームあたりの描画コマンドの数
+    double drawCallsPerFrame = 0.0;
+    /// @brief 1フレームあたりの描画したインスタンスの数
+    double instancesPerFrame = 0.0;
+    /// @brief 1フレームあたりのヒープの確保回数
+    double heapAllocationsPerFrame = 0.0;
+};
+
+/// @brief シーンのベンチマークでフレームを進める処理。
+/// Engine はウィンドウと DirectX を使う処理を、テストはウィンドウも GPU も使わない処理を渡す
+struct SceneBenchmarkFrameFunctions {
+    /// @brief フレームの前の処理。false なら計測を打ち切る(ウィンドウが閉じられた場合など)
+    std::function<bool()> processMessage;
+    /// @brief フレームの開始。false ならこのフレームは更新も描画もしない
+    std::function<bool()> beginFrame;
+    /// @brief 固定ステップ更新の1ティック開始。false になるまでシーンの固定ステップ更新を呼ぶ
+    std::function<bool()> beginFixedUpdate;
+    /// @brief フレームの終了。描画リストの描画と、フレームごとの集計(MemoryTracker::EndFrame)を行う
+    std::function<void()> endFrame;
+    /// @brief 直近のフレームの描画コマンドの数
+    std::function<DrawStats()> getDrawStats;
+};
+
+/// @brief シーンを指定フレーム数だけ回し、CPUのフレーム時間と描画コマンドの数をログに出力する
+/// @param sceneName 計測するシーン名(SceneManager に登録されていること)
+/// @param frameCount 計測するフレーム数
+/// @param warmupFrameCount 計測前に回すフレーム数
+/// @param frameFunctions フレームを進める処理
+/// @return 計測結果。シーンが無ければフレーム数0の結果
+SceneBenchmarkResult RunSceneBenchmark(const std::string &sceneName, uint32_t frameCount, uint32_t warmupFrameCount,
+    const SceneBenchmarkFrameFunctions &frameFunctions);
+
+/// @brief SceneManager に登録されているすべてのシーンのベンチマーク。終了後は元のシーンに戻す
+/// @param frameCount シーンごとに計測するフレーム数
+/// @param warmupFrameCount 計測前に回すフレーム数
+/// @param frameFunctions フレームを進める処理
+/// @return シーンごとの計測結果
+std::vector<SceneBenchmarkResult> RunSceneBenchmarks(uint32_t frameCount, uint32_t warmupFrameCount,
+    const SceneBenchmarkFrameFunctions &frameFunctions);
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <cassert>
+#include <cstdio>
+#include <mutex>
+#include <FlatHashMap.h>
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+#include "StringId.h"
+
+namespace KashipanEngine {
+
+#if !RELEASE_BUILD
+namespace {
+
+/// @brief ハッシュ値から文字列を引く表
+struct InternTable {
+    std::mutex mutex;
+    MyStd::FlatHashMap<StringId::HashType, std::string> strings;
+};
+
+InternTable &GetInternTable() {
+    // 静的初期化中に登録されることもあるので関数内で生成する
+    static InternTable table;
+    return table;
+}
+
+} // namespace
+
+StringId StringId::Intern(std::string_view str) {
+    const StringId id(str);
+    auto &table = GetInternTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.strings.find(id.hash_);
+    if (it == table.strings.end()) {
+        // 逆引き表はプログラム終了まで持ち続ける
+        MEMORY_TAG_SCOPE(kPersistent);
+        table.strings.emplace(id.hash_, std::string(str));
+        return id;
+    }
+    if (it->second != str) {
+        Log("StringId collision: '" + it->second + "' and '" + std::string(str) + "'", kLogLevelFlagError);
+        assert(false);
+    }
+    return id;
+}
+#endif
+
+std::string StringId::GetString() const {
+#if !RELEASE_BUILD
+    {
+        auto &table = GetInternTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto it = table.strings.find(hash_);
+        if (it != table.strings.end()) {
+            return it->second;
+        }
+    }
+#endif
+    char buffer[20];
+    std::snprintf(buffer, sizeof(buffer), "#%016llx", static_cast<unsigned long long>(hash_));
+    return buffer;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
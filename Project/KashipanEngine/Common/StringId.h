@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <functional>
+
+namespace KashipanEngine {
+
+/// @brief 文字列をハッシュ値で表す識別子。
+/// 比較は整数1回で済み、文字列リテラルからはコンパイル時に計算できる。
+/// 生成はハッシュ値の計算だけで、逆引き用の表への登録は Intern か STRING_ID_CONSTANT で名前を定義する所だけで行う
+class StringId {
+public:
+    using HashType = uint64_t;
+
+    /// @brief FNV-1a(64bit) でハッシュ値を計算する
+    /// @param str 文字列
+    /// @return ハッシュ値
+    static constexpr HashType Hash(std::string_view str) noexcept {
+        HashType hash = kOffsetBasis;
+        for (char c : str) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= kPrime;
+        }
+        return hash;
+    }
+
+    constexpr StringId() noexcept = default;
+    constexpr StringId(const char *str) noexcept : StringId(std::string_view(str)) {}
+    constexpr StringId(std::string_view str) noexcept : hash_(Hash(str)) {}
+    StringId(const std::string &str) noexcept : StringId(std::string_view(str)) {}
+
+#if !RELEASE_BUILD
+    /// @brief 文字列から生成し、逆引き用の表に登録する。別の文字列と衝突した場合はエラーにする。
+    /// 登録はロックと確保を伴うので、毎フレームの変換ではなく名前を定義する所(パイプラインやシーンの追加、設定の読み込み)で使う
+    /// @param str 文字列
+    /// @return 識別子
+    static StringId Intern(std::string_view str);
+#else
+    static constexpr StringId Intern(std::string_view str) noexcept { return StringId(str); }
+#endif
+
+    /// @brief ハッシュ値から生成する(保存したハッシュ値の復元用)
+    /// @param hash ハッシュ値
+    /// @return 識別子
+    static constexpr StringId FromHash(HashType hash) noexcept {
+        StringId id;
+        id.hash_ = hash;
+        return id;
+    }
+
+    /// @brief ハッシュ値の取得
+    constexpr HashType GetHash() const noexcept { return hash_; }
+    /// @brief 空の識別子でないかどうか
+    constexpr bool IsValid() const noexcept { return hash_ != 0; }
+
+    /// @brief 元の文字列の取得。リリースビルドや Intern されていない場合はハッシュ値の16進表記を返す
+    /// @return 元の文字列
+    std::string GetString() const;
+
+    constexpr bool operator==(const StringId &other) const noexcept { return hash_ == other.hash_; }
+    constexpr bool operator!=(const StringId &other) const noexcept { return hash_ != other.hash_; }
+    constexpr bool operator<(const StringId &other) const noexcept { return hash_ < other.hash_; }
+
+private:
+    static constexpr HashType kOffsetBasis = 0xCBF29CE484222325ull;
+    static constexpr HashType kPrime = 0x100000001B3ull;
+
+    HashType hash_ = 0;
+};
+
+} // namespace KashipanEngine
+
+/// @brief 名前空間スコープの StringId の定数を宣言し、逆引き用の表にも登録する。
+/// constexpr の生成では登録されないので、GetString でログに出す定数はこれで宣言する
+#define STRING_ID_CONSTANT(name, str) \
+    constexpr ::KashipanEngine::StringId name = str; \
+    [[maybe_unused]] const ::KashipanEngine::StringId name##Interned = ::KashipanEngine::StringId::Intern(str)
+
+template<>
+struct std::hash<KashipanEngine::StringId> {
+    size_t operator()(const KashipanEngine::StringId &id) const noexcept {
+        return static_cast<size_t>(id.GetHash());
+    }
+};
\ No newline at end of file
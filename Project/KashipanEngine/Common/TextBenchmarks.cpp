@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <utf8.h>
+#include "TextBenchmarks.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+#include "Font/FontLoader.h"
+#include "Font/FontRegistry.h"
+#include "Font/TextBatcher.h"
+#include "Font/TextLayout.h"
+#include "Objects/Text.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+using MyStd::DoNotOptimize;
+
+// レイアウトする文字列のサイズ(バイト)
+const size_t kLayoutTextBytes = 1024 * 1024;
+// 追加・編集を計測する文字列のサイズ(10k文字程度になるバイト数)
+const size_t kEditTextBytes = 24 * 1024;
+// 折り返す幅
+const float kEditMaxWidth = 1024.0f;
+// まとめて描画するテキストの数
+const size_t kBatchTextCount = 1000;
+// まとめて描画するテキストの色の種類
+const size_t kBatchColorCount = 4;
+// メモリを計測する Text の文字数
+const uint32_t kMemoryTextCount = 64;
+
+/// @brief 文字列の元になる行。ASCII・ラテン文字・かな・漢字・全角記号に、フォントに無いことが多い文字(キリル文字・ハングル)を混ぜる
+const char8_t *const kSampleLines[] = {
+    u8"The quick brown fox jumps over the lazy dog. 0123456789 !?#$%&()[]{}",
+    u8"Café, naïve, façade, Straße, smørrebrød, Ångström, œuvre, déjà vu.",
+    u8"いろはにほへと ちりぬるを わかよたれそ つねならむ うゐのおくやま けふこえて",
+    u8"カタカナのテキストとひらがなのテキストを、交互にレイアウトします。",
+    u8"吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。",
+    u8"スコア: 1234567  残り時間: 03:21  ＨＰ ５０／１００  【ステージ１】",
+    u8"Съешь же ещё этих мягких французских булок. 다람쥐 헌 쳇바퀴에 타고파.",
+};
+
+/// @brief 約 targetBytes バイトの複数の文字種が混ざったUTF8文字列を作る
+std::u8string CreateMixedText(size_t targetBytes) {
+    std::u8string text;
+    text.reserve(targetBytes + 256);
+    size_t lineIndex = 0;
+    while (text.size() < targetBytes) {
+        text += kSampleLines[lineIndex % std::size(kSampleLines)];
+        text += u8'\n';
+        ++lineIndex;
+    }
+    return text;
+}
+
+/// @brief 折り返しの確認用の、幅の決まった数文字だけのフォントを作る(A=30, 空白=10, H=50, i=5)
+FontData CreateWrapTestFont() {
+    FontData fontData{};
+    fontData.common.lineHeight = 32.0f;
+    fontData.common.base = 26.0f;
+    fontData.common.scaleW = 256.0f;
+    fontData.common.scaleH = 256.0f;
+    fontData.common.pages = 1;
+    std::vector<CharInfo> chars;
+    const std::pair<int, float> advances[] = { { ' ', 10.0f }, { 'A', 30.0f }, { 'H', 50.0f }, { 'i', 5.0f } };
+    for (const auto &[codePoint, advance] : advances) {
+        CharInfo charInfo{};
+        charInfo.id = codePoint;
+        charInfo.width = advance;
+        charInfo.height = 32.0f;
+        charInfo.xAdvance = advance;
+        chars.push_back(charInfo);
+    }
+    fontData.charsCount = static_cast<int>(chars.size());
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+/// @brief 部分的に計算したレイアウトが、同じ文字列で全体を計算し直した結果と同じかどうか
+bool IsSameAsFullLayout(const TextLayout &layout, const FontData &fontData, float maxWidth, const std::u8string &text) {
+    TextLayout fullLayout;
+    fullLayout.SetFont(&fontData);
+    fullLayout.SetMaxWidth(maxWidth);
+    fullLayout.SetAlign(layout.GetAlignX(), layout.GetAlignY());
+    fullLayout.SetText(text);
+    return layout.IsSameLayout(fullLayout);
+}
+
+/// @brief 文字列を少しずつ変えながら、部分的に計算したレイアウトが全体を計算し直した結果と同じになるかを確かめる
+/// @return すべて同じだったかどうか
+bool VerifyIncrementalLayout(const FontData &fontData) {
+    // 折り返し無し・折り返し有り(欧文の幅・かなの幅)で確かめる
+    const float maxWidths[] = { 0.0f, 1024.0f, 300.0f };
+    // 末尾への追加・末尾の削除・途中への挿入・途中の削除・改行の追加と削除
+    const std::u8string edits[] = { u8"a", u8" ", u8"あ", u8"。", u8"漢字", u8"\n", u8"Hello ", u8"é", u8"Ж" };
+    const std::u8string baseText = CreateMixedText(kEditTextBytes / 4);
+    size_t caseCount = 0;
+    size_t mismatchCount = 0;
+    for (const float maxWidth : maxWidths) {
+        TextLayout layout;
+        layout.SetFont(&fontData);
+        layout.SetMaxWidth(maxWidth);
+        layout.SetAlign(TextAlignX::Center, TextAlignY::Bottom);
+        std::u8string text = baseText;
+        layout.SetText(text);
+        for (size_t i = 0; i < 200; ++i) {
+            const std::u8string &edit = edits[i % std::size(edits)];
+            // コードポイントの途中にならない位置を選ぶ
+            size_t position = (i * 7919) % (text.size() + 1);
+            while (position < text.size() && (static_cast<uint8_t>(text[position]) & 0xC0) == 0x80) {
+                ++position;
+            }
+            switch (i % 4) {
+                case 0:
+                    text += edit;
+                    break;
+                case 1:
+                    text.insert(position, edit);
+                    break;
+                case 2:
+                    text.erase(position, std::min(edit.size(), text.size() - position));
+                    // 削除でコードポイントが途中で切れたら、切れた部分も消す
+                    while (position < text.size() && (static_cast<uint8_t>(text[position]) & 0xC0) == 0x80) {
+                        text.erase(position, 1);
+                    }
+                    break;
+                default:
+                    text.resize(text.size() - std::min(edit.size(), text.size()));
+                    // 末尾のコードポイントが途中で切れたら、残った部分も消す
+                    while (!text.empty() && (static_cast<uint8_t>(text.back()) & 0xC0) == 0x80) {
+                        text.pop_back();
+                    }
+                    if (!text.empty() && (static_cast<uint8_t>(text.back()) & 0xC0) == 0xC0) {
+                        text.pop_back();
+                    }
+                    break;
+            }
+            layout.SetText(text);
+            ++caseCount;
+            if (!IsSameAsFullLayout(layout, fontData, maxWidth, text)) {
+                ++mismatchCount;
+            }
+        }
+    }
+
+    // 3行に折り返した段落の最後の行を変えると、段落全体が1行に詰まる("A " / "AA" / "H" -> "A AAi")
+    {
+        const FontData wrapTestFont = CreateWrapTestFont();
+        const float wrapMaxWidth = 105.0f;
+        TextLayout layout;
+        layout.SetFont(&wrapTestFont);
+        layout.SetMaxWidth(wrapMaxWidth);
+        layout.SetText(u8"A AAH");
+        layout.SetText(u8"A AAi");
+        ++caseCount;
+        if (layout.GetLines().size() != 1 || !IsSameAsFullLayout(layout, wrapTestFont, wrapMaxWidth, u8"A AAi")) {
+            ++mismatchCount;
+        }
+    }
+    if (mismatchCount > 0) {
+        Log(std::format("Incremental text layout differs from full layout: {} / {} cases", mismatchCount, caseCount),
+            kLogLevelFlagError);
+        return false;
+    }
+    LogSimple(std::format("Incremental text layout matches full layout: {} cases", caseCount));
+    return true;
+}
+
+/// @brief fontData の文字を2ページに振り分けたフォントデータを作る(複数ページのまとめ方の確認用)
+FontData CreateTwoPageFont(const FontData &fontData) {
+    FontData twoPageFont = fontData;
+    FontPage page = fontData.pages.empty() ? FontPage{ 0, TextureHandle{}, "" } : fontData.pages[0];
+    twoPageFont.pages.assign(1, page);
+    page.id = 1;
+    page.textureHandle.index += 1;
+    twoPageFont.pages.push_back(page);
+    std::vector<CharInfo> chars = fontData.chars.GetChars();
+    for (auto &charInfo : chars) {
+        charInfo.page = charInfo.id % 2;
+    }
+    twoPageFont.chars.Build(std::move(chars));
+    twoPageFont.common.pages = 2;
+    return twoPageFont;
+}
+
+/// @brief まとめて描画する1k個のテキストのレイアウトを作る(1行から3行の長さ、位置をずらして並べる)
+std::vector<TextLayout> CreateBatchLayouts(const FontData &fontData) {
+    std::vector<TextLayout> layouts(kBatchTextCount);
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        std::u8string text = kSampleLines[i % std::size(kSampleLines)];
+        if (i % 3 == 0) {
+            text += u8'\n';
+            text += kSampleLines[(i + 1) % std::size(kSampleLines)];
+        }
+        layouts[i].SetFont(&fontData);
+        layouts[i].SetMaxWidth(i % 2 == 0 ? 0.0f : 600.0f);
+        layouts[i].SetAlign(static_cast<TextAlignX>(i % 3), TextAlignY::Top);
+        layouts[i].SetText(text);
+    }
+    return layouts;
+}
+
+/// @brief 1k個のテキストを TextBatcher に追加して頂点を生成する
+void BuildTextBatch(TextBatcher &batcher, const std::vector<TextLayout> &layouts, const FontData &fontData) {
+    const Vector4 colors[kBatchColorCount] = {
+        { 255.0f, 255.0f, 255.0f, 255.0f },
+        { 255.0f, 64.0f, 64.0f, 255.0f },
+        { 64.0f, 255.0f, 64.0f, 255.0f },
+        { 64.0f, 64.0f, 255.0f, 255.0f },
+    };
+    batcher.Clear();
+    TextBatcher::TextState textState;
+    textState.fontData = &fontData;
+    textState.maxGlyphCount = 256;
+    textState.material.lightingType = 0;
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        textState.layout = &layouts[i];
+        textState.material.color = colors[i % kBatchColorCount];
+        textState.worldMatrix.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.1f * static_cast<float>(i % 7) },
+            { static_cast<float>(i % 32) * 60.0f, static_cast<float>(i / 32) * 34.0f, 0.0f });
+        batcher.Add(textState);
+    }
+    batcher.Build();
+}
+
+/// @brief まとめて生成した頂点が、テキストごとに行列で変換した位置と同じになるかを確かめる
+/// @return すべて同じだったかどうか
+bool VerifyTextBatch(const std::vector<TextLayout> &layouts, const TextBatcher &batcher, size_t pageCount) {
+    const auto &batches = batcher.GetBatches();
+    const auto &vertices = batcher.GetVertices();
+    bool isMatched = batches.size() == kBatchColorCount * pageCount;
+
+    // 1つ目のテキストの文字は、1つ目の色のページごとの単位の先頭に順に並ぶ
+    const TextLayout &layout = layouts[0];
+    Matrix4x4 worldMatrix;
+    worldMatrix.MakeAffine({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
+    std::vector<uint32_t> cursors(pageCount);
+    for (size_t page = 0; page < pageCount && page < batches.size(); ++page) {
+        cursors[page] = batches[page].vertexOffset;
+    }
+    const auto &lines = layout.GetLines();
+    for (size_t lineIndex = 0; lineIndex < lines.size() && isMatched; ++lineIndex) {
+        float originX = 0.0f;
+        float originY = 0.0f;
+        layout.GetLineOrigin(lineIndex, originX, originY);
+        for (size_t i = lines[lineIndex].beginGlyph; i < lines[lineIndex].endGlyph; ++i) {
+            const auto &glyph = layout.GetGlyphs()[i];
+            const size_t page = pageCount > 1 ? static_cast<size_t>(glyph.page) : 0;
+            const Vector3 expected = Vector3(originX + glyph.x, originY + glyph.y, 0.0f).Transform(worldMatrix);
+            const auto &position = vertices[cursors[page] + 1].position;
+            if (std::abs(position.x - expected.x) > 1e-3f || std::abs(position.y - expected.y) > 1e-3f) {
+                isMatched = false;
+                break;
+            }
+            cursors[page] += 4;
+        }
+    }
+
+    size_t glyphCount = 0;
+    for (const auto &batch : batches) {
+        glyphCount += batch.glyphCount;
+    }
+    isMatched = isMatched && glyphCount == batcher.GetGlyphCount() && vertices.size() == glyphCount * 4;
+    if (!isMatched) {
+        Log(std::format("Text batch is incorrect: {} batches for {} pages, {} glyphs", batches.size(), pageCount,
+            glyphCount), kLogLevelFlagError);
+    }
+    return isMatched;
+}
+
+/// @brief Text 1つあたりのヒープの確保量を計測してログに出力する
+void LogTextMemory(FontHandle fontHandle, const FontData &fontData) {
+    const std::u8string text = kSampleLines[0];
+    const uint64_t allocatedBytes = MemoryTracker::GetTotalAllocatedBytes();
+    const uint64_t allocationCount = MemoryTracker::GetTotalAllocationCount();
+    {
+        Text textObject(kMemoryTextCount);
+        textObject.SetFont(fontHandle);
+        textObject.SetText(text);
+        const uint64_t textBytes = MemoryTracker::GetTotalAllocatedBytes() - allocatedBytes;
+        const uint64_t textAllocations = MemoryTracker::GetTotalAllocationCount() - allocationCount;
+        LogSimple(std::format("Text memory ({} chars): sizeof {} bytes, heap {} bytes in {} allocs per instance",
+            kMemoryTextCount, sizeof(Text), textBytes, textAllocations));
+    }
+    LogSimple(std::format("Font memory: {} bytes shared by all Text instances ({} chars, {} kernings)",
+        fontData.GetMemoryBytes(), fontData.chars.GetCount(), fontData.kernings.size()));
+}
+
+} // namespace
+
+bool RunTextBenchmarks(const std::string &fontFilePath, const std::string &outputPath,
+    const std::string &baselinePath, double tolerance) {
+    LogInsertPartition("\n================ Text Benchmarks =================\n");
+    // レイアウトはCPU側だけで計るので、テクスチャは読み込まずに登録する
+    const std::string benchmarkFontName = fontFilePath + "#Benchmark";
+    FontHandle fontHandle = FontRegistry::Find(fontFilePath);
+    if (!fontHandle.IsValid()) {
+        fontHandle = FontRegistry::Find(benchmarkFontName);
+    }
+    if (!fontHandle.IsValid()) {
+        try {
+            fontHandle = FontRegistry::Add(benchmarkFontName, LoadFNT(fontFilePath.c_str()));
+        } catch (const std::exception &e) {
+            Log(e.what(), kLogLevelFlagError);
+            return false;
+        }
+    }
+    const FontData &fontData = *FontRegistry::Get(fontHandle);
+
+    const std::u8string text = CreateMixedText(kLayoutTextBytes);
+    std::vector<int> codePoints;
+    utf8::utf8to32(text.begin(), text.end(), std::back_inserter(codePoints));
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetText(text);
+
+    // 追加・編集用の文字列(末尾に1文字足したものと、真ん中の1文字を変えたもの)
+    const std::u8string editText = CreateMixedText(kEditTextBytes);
+    const std::u8string appendedText = editText + u8"x";
+    size_t middle = editText.size() / 2;
+    while (middle < editText.size() && (static_cast<uint8_t>(editText[middle]) & 0x80) != 0) {
+        ++middle;
+    }
+    std::u8string editedTexts[2] = { editText, editText };
+    editedTexts[0][middle] = u8'A';
+    editedTexts[1][middle] = u8'W';
+    TextLayout editLayout;
+    editLayout.SetFont(&fontData);
+    editLayout.SetMaxWidth(kEditMaxWidth);
+    editLayout.SetText(editText);
+
+    // まとめて描画する1k個のテキスト(1ページのフォントと2ページのフォント)
+    const FontData twoPageFont = CreateTwoPageFont(fontData);
+    const std::vector<TextLayout> batchLayouts = CreateBatchLayouts(fontData);
+    const std::vector<TextLayout> twoPageBatchLayouts = CreateBatchLayouts(twoPageFont);
+    TextBatcher batcher;
+
+    MyStd::Benchmark benchmark;
+    benchmark.SetSampleCount(7);
+    benchmark.Add("Text/GlyphLookup1MB", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            float advance = 0.0f;
+            for (const int codePoint : codePoints) {
+                const CharInfo *charData = fontData.FindChar(codePoint);
+                advance += charData ? charData->xAdvance : 0.0f;
+            }
+            DoNotOptimize(advance);
+        }
+    });
+    benchmark.Add("Text/Layout1MB", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            layout.Rebuild();
+            DoNotOptimize(layout.GetGlyphs().data());
+        }
+    });
+    benchmark.Add("Text/FullLayout10k", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            editLayout.Rebuild();
+            DoNotOptimize(editLayout.GetGlyphs().data());
+        }
+    });
+    // 1回で末尾に1文字足して元に戻す(2回の更新)
+    benchmark.Add("Text/AppendRemove10k", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            editLayout.SetText(appendedText);
+            editLayout.SetText(editText);
+            DoNotOptimize(editLayout.GetGlyphs().data());
+        }
+    });
+    // 1回で真ん中の1文字を変える(幅の違う文字と交互に入れ替える)
+    benchmark.Add("Text/EditMiddle10k", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            editLayout.SetText(editedTexts[i & 1]);
+            DoNotOptimize(editLayout.GetGlyphs().data());
+        }
+    });
+    // 1フレーム分(テキストの追加と頂点の生成)
+    benchmark.Add("Text/Batch1kTexts", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            BuildTextBatch(batcher, batchLayouts, fontData);
+            DoNotOptimize(batcher.GetVertices().data());
+        }
+    });
+    benchmark.Add("Text/Batch1kTextsTwoPages", [&](uint64_t iterationCount) {
+        for (uint64_t i = 0; i < iterationCount; ++i) {
+            BuildTextBatch(batcher, twoPageBatchLayouts, twoPageFont);
+            DoNotOptimize(batcher.GetVertices().data());
+        }
+    });
+    const auto results = benchmark.Run();
+    LogSimple(std::format("Layout text: {} bytes, {} code points, {} glyphs, {} lines", text.size(), codePoints.size(),
+        layout.GetGlyphs().size(), layout.GetLines().size()));
+    LogSimple(std::format("Edit text: {} bytes, {} code points, {} lines (wrap {:.0f})", editText.size(),
+        editLayout.GetCodePoints().size(), editLayout.GetLines().size(), kEditMaxWidth));
+    for (const auto &result : results) {
+        LogSimple(std::format("{:<40} {:12.3f} us  (min {:.3f} us, max {:.3f} us, {} iterations x {})",
+            result.name, result.nanosecondsPerIteration / 1000.0, result.minNanosecondsPerIteration / 1000.0,
+            result.maxNanosecondsPerIteration / 1000.0, result.iterationCount, result.sampleCount));
+    }
+    BuildTextBatch(batcher, batchLayouts, fontData);
+    LogSimple(std::format("Batch: {} texts, {} glyphs, {} vertices in {} draws (one per color)", batcher.GetTextCount(),
+        batcher.GetGlyphCount(), batcher.GetVertices().size(), batcher.GetBatches().size()));
+    bool isBatchMatched = VerifyTextBatch(batchLayouts, batcher, 1);
+    BuildTextBatch(batcher, twoPageBatchLayouts, twoPageFont);
+    LogSimple(std::format("Batch with two pages: {} glyphs in {} draws (one per color and page)",
+        batcher.GetGlyphCount(), batcher.GetBatches().size()));
+    isBatchMatched = VerifyTextBatch(twoPageBatchLayouts, batcher, 2) && isBatchMatched;
+    const bool isLayoutMatched = VerifyIncrementalLayout(fontData);
+    LogTextMemory(fontHandle, fontData);
+
+    SaveBenchmarkResults(results, outputPath);
+    const bool isPassed = CheckBenchmarkRegressions(results, baselinePath, tolerance) && isLayoutMatched &&
+        isBatchMatched;
+    Log(std::format("Text benchmarks finished: {} benchmarks, {}", results.size(), isPassed ? "no regressions" : "REGRESSED"));
+    return isPassed;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
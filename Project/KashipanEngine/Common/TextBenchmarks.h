@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+namespace KashipanEngine {
+
+/// @brief テキストのベンチマークを実行する。
+/// 複数の文字種が混ざった約1MBの文字列を fontFilePath のフォントでレイアウトする時間、約10k文字の文字列への追加と編集の時間、
+/// 1k個のテキストの文字をまとめて頂点を生成する時間、Text 1つあたりのメモリを計測する。
+/// 部分的に計算したレイアウトが全体を計算し直した結果と同じになるか、まとめた頂点が正しいかも確かめる。
+/// 結果を outputPath に保存し、baselinePath の基準と比べる
+/// @param fontFilePath 使用するフォントファイル(.fnt)のパス
+/// @param outputPath 結果の保存先のパス
+/// @param baselinePath 基準のファイルへのパス
+/// @param tolerance 許容する遅くなった割合
+/// @return 遅くなったものと結果の違いが無かったかどうか
+bool RunTextBenchmarks(const std::string &fontFilePath = "Resources/Font/test.fnt",
+    const std::string &outputPath = "Logs/Benchmarks/text.json",
+    const std::string &baselinePath = "Benchmarks/text_baseline.json", double tolerance = 0.15);
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -2,13 +2,14 @@
 #include <d3d12.h>
 #include <wrl.h>
 #include <string>
+#include "Common/TextureHandle.h"
 
 namespace KashipanEngine {
 
 struct TextureData {
     /// @brief テクスチャの名前
     std::string name;
-    /// @brief テクスチャが読み込まれたインデックス
+    /// @brief テクスチャが読み込まれたインデックス(UI のデータなど、数値で指定する場合に使う)
     uint32_t index = 0;
     /// @brief テクスチャリソース
     Microsoft::WRL::ComPtr<ID3D12Resource> resource;
@@ -22,6 +23,8 @@ struct TextureData {
     uint32_t width;
     /// @brief テクスチャの高さ
     uint32_t height;
+    /// @brief テクスチャのハンドル
+    TextureHandle handle;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+#include <SlotMap.h>
+
+namespace KashipanEngine {
+
+/// @brief Texture が管理するテクスチャを指すハンドル。
+/// 世代を持つので、削除や作り直しで別のテクスチャを指すことがない
+using TextureHandle = MyStd::SlotHandle;
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include "CookedFont.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 変換済みファイルの識別子("KFNT")
+constexpr uint32_t kCookedMagic = 0x544E464B;
+// 変換済みファイルの形式のバージョン
+constexpr uint32_t kCookedVersion = 1;
+
+/// @brief 変換済みファイルのヘッダー。後ろにフォントのデータが続く
+struct CookedHeader {
+    uint32_t magic;
+    uint32_t version;
+    // 元のファイルのハッシュ値
+    uint64_t sourceHash;
+    // データのサイズ
+    uint64_t payloadSize;
+};
+
+/// @brief 変換済みファイルのカーニング
+struct CookedKerning {
+    int32_t first;
+    int32_t second;
+    float amount;
+};
+
+// 文字情報はパディングの無い構造体なので、配列のままコピーする
+static_assert(std::is_trivially_copyable_v<CharInfo> && sizeof(CharInfo) == 40);
+
+void WriteBytes(std::string &out, const void *data, size_t size) {
+    out.append(static_cast<const char *>(data), size);
+}
+
+template<typename T>
+void WriteValue(std::string &out, T value) {
+    WriteBytes(out, &value, sizeof(T));
+}
+
+void WriteString(std::string &out, const std::string &str) {
+    WriteValue(out, static_cast<uint32_t>(str.size()));
+    out += str;
+}
+
+void WriteFontInfo(std::string &out, const FontInfo &info) {
+    WriteString(out, info.face);
+    WriteString(out, info.charset);
+    WriteValue(out, info.stretchH);
+    WriteValue(out, static_cast<int32_t>(info.size));
+    WriteValue(out, static_cast<int32_t>(info.aa));
+    for (int padding : info.padding) {
+        WriteValue(out, static_cast<int32_t>(padding));
+    }
+    for (int spacing : info.spacing) {
+        WriteValue(out, static_cast<int32_t>(spacing));
+    }
+    WriteValue(out, static_cast<int32_t>(info.outline));
+    WriteValue(out, static_cast<uint8_t>(info.isBold));
+    WriteValue(out, static_cast<uint8_t>(info.isItalic));
+    WriteValue(out, static_cast<uint8_t>(info.isUnicode));
+    WriteValue(out, static_cast<uint8_t>(info.isSmooth));
+}
+
+void WriteFontCommon(std::string &out, const FontCommon &common) {
+    WriteValue(out, common.lineHeight);
+    WriteValue(out, common.base);
+    WriteValue(out, common.scaleW);
+    WriteValue(out, common.scaleH);
+    WriteValue(out, static_cast<int32_t>(common.pages));
+    WriteValue(out, static_cast<int32_t>(common.alphaChannel));
+    WriteValue(out, static_cast<int32_t>(common.redChannel));
+    WriteValue(out, static_cast<int32_t>(common.greenChannel));
+    WriteValue(out, static_cast<int32_t>(common.blueChannel));
+    WriteValue(out, static_cast<uint8_t>(common.isPacked));
+}
+
+/// @brief 変換済みデータの読み込み用クラス。範囲外を読もうとしたら失敗にする
+class CookedReader {
+public:
+    explicit CookedReader(std::string_view bytes) : current_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+    bool IsSucceeded() const { return isSucceeded_ && current_ == end_; }
+    bool HasError() const { return !isSucceeded_; }
+
+    template<typename T>
+    T Read() {
+        T value{};
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+    int ReadInt() {
+        return static_cast<int>(Read<int32_t>());
+    }
+    bool ReadBool() {
+        return Read<uint8_t>() != 0;
+    }
+    std::string ReadString() {
+        const uint32_t size = Read<uint32_t>();
+        if (!isSucceeded_ || static_cast<size_t>(end_ - current_) < size) {
+            isSucceeded_ = false;
+            return {};
+        }
+        std::string str(current_, size);
+        current_ += size;
+        return str;
+    }
+    /// @brief 要素数と配列をまとめて読み込む
+    template<typename T>
+    std::vector<T> ReadArray() {
+        const uint32_t count = Read<uint32_t>();
+        // 壊れたデータで巨大な確保をしないよう、残りのバイト数と比べてから確保する
+        if (!isSucceeded_ || static_cast<size_t>(end_ - current_) / sizeof(T) < count) {
+            isSucceeded_ = false;
+            return {};
+        }
+        std::vector<T> values(count);
+        ReadBytes(values.data(), sizeof(T) * count);
+        return values;
+    }
+
+private:
+    void ReadBytes(void *out, size_t size) {
+        if (!isSucceeded_ || static_cast<size_t>(end_ - current_) < size) {
+            isSucceeded_ = false;
+            return;
+        }
+        if (size != 0) {
+            std::memcpy(out, current_, size);
+        }
+        current_ += size;
+    }
+
+    const char *current_;
+    const char *end_;
+    bool isSucceeded_ = true;
+};
+
+FontInfo ReadFontInfo(CookedReader &reader) {
+    FontInfo info{};
+    info.face = reader.ReadString();
+    info.charset = reader.ReadString();
+    info.stretchH = reader.Read<float>();
+    info.size = reader.ReadInt();
+    info.aa = reader.ReadInt();
+    for (int &padding : info.padding) {
+        padding = reader.ReadInt();
+    }
+    for (int &spacing : info.spacing) {
+        spacing = reader.ReadInt();
+    }
+    info.outline = reader.ReadInt();
+    info.isBold = reader.ReadBool();
+    info.isItalic = reader.ReadBool();
+    info.isUnicode = reader.ReadBool();
+    info.isSmooth = reader.ReadBool();
+    return info;
+}
+
+FontCommon ReadFontCommon(CookedReader &reader) {
+    FontCommon common{};
+    common.lineHeight = reader.Read<float>();
+    common.base = reader.Read<float>();
+    common.scaleW = reader.Read<float>();
+    common.scaleH = reader.Read<float>();
+    common.pages = reader.ReadInt();
+    common.alphaChannel = reader.ReadInt();
+    common.redChannel = reader.ReadInt();
+    common.greenChannel = reader.ReadInt();
+    common.blueChannel = reader.ReadInt();
+    common.isPacked = reader.ReadBool();
+    return common;
+}
+
+} // namespace
+
+std::string CookFont(const FontData &fontData, uint64_t sourceHash) {
+    std::string out(sizeof(CookedHeader), '\0');
+    WriteFontInfo(out, fontData.info);
+    WriteFontCommon(out, fontData.common);
+    WriteValue(out, static_cast<int32_t>(fontData.charsCount));
+
+    WriteValue(out, static_cast<uint32_t>(fontData.pages.size()));
+    for (const auto &page : fontData.pages) {
+        WriteValue(out, static_cast<int32_t>(page.id));
+        WriteString(out, page.file);
+    }
+
+    // 文字情報は文字IDの順に並んでいるので、読み込み時にソートし直さずに済む
+    const auto &chars = fontData.chars.GetChars();
+    WriteValue(out, static_cast<uint32_t>(chars.size()));
+    WriteBytes(out, chars.data(), sizeof(CharInfo) * chars.size());
+
+    // ハッシュマップの順番は決まらないので、毎回同じ内容になるよう並べてから書き出す
+    std::vector<CookedKerning> kernings;
+    kernings.reserve(fontData.kernings.size());
+    for (const auto &[key, amount] : fontData.kernings) {
+        kernings.push_back({ static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFFu), amount });
+    }
+    std::sort(kernings.begin(), kernings.end(), [](const CookedKerning &a, const CookedKerning &b) {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    WriteValue(out, static_cast<uint32_t>(kernings.size()));
+    WriteBytes(out, kernings.data(), sizeof(CookedKerning) * kernings.size());
+
+    CookedHeader header{ kCookedMagic, kCookedVersion, sourceHash, out.size() - sizeof(CookedHeader) };
+    std::memcpy(out.data(), &header, sizeof(CookedHeader));
+    return out;
+}
+
+std::optional<FontData> UncookFont(std::string_view bytes, const uint64_t *expectedHash) {
+    if (bytes.size() < sizeof(CookedHeader)) {
+        return std::nullopt;
+    }
+    CookedHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(CookedHeader));
+    if (header.magic != kCookedMagic || header.version != kCookedVersion ||
+        header.payloadSize != bytes.size() - sizeof(CookedHeader)) {
+        return std::nullopt;
+    }
+    if (expectedHash != nullptr && header.sourceHash != *expectedHash) {
+        return std::nullopt;
+    }
+
+    CookedReader reader(bytes.substr(sizeof(CookedHeader)));
+    FontData fontData{};
+    fontData.info = ReadFontInfo(reader);
+    fontData.common = ReadFontCommon(reader);
+    fontData.charsCount = reader.ReadInt();
+
+    const uint32_t pageCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < pageCount && !reader.HasError(); ++i) {
+        FontPage page{};
+        page.id = reader.ReadInt();
+        page.file = reader.ReadString();
+        fontData.pages.push_back(std::move(page));
+    }
+
+    fontData.chars.Build(reader.ReadArray<CharInfo>());
+
+    const auto kernings = reader.ReadArray<CookedKerning>();
+    fontData.kernings.reserve(kernings.size());
+    for (const auto &kerning : kernings) {
+        fontData.kernings[FontData::MakeKerningKey(kerning.first, kerning.second)] = kerning.amount;
+    }
+
+    if (!reader.IsSucceeded()) {
+        return std::nullopt;
+    }
+    return fontData;
+}
+
+std::optional<FontData> LoadCookedFont(const std::string &cookedPath, const uint64_t *expectedHash) {
+    std::ifstream file(cookedPath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    const std::streamoff size = file.tellg();
+    if (size <= 0) {
+        return std::nullopt;
+    }
+    std::string bytes(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    if (!file.read(bytes.data(), size)) {
+        return std::nullopt;
+    }
+    return UncookFont(bytes, expectedHash);
+}
+
+bool SaveCookedFont(const std::string &cookedPath, uint64_t sourceHash, const FontData &fontData) {
+    const std::string bytes = CookFont(fontData, sourceHash);
+    std::ofstream file(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Font/FontStructs.h"
+
+namespace KashipanEngine {
+
+// 変換済み(バイナリ)フォントファイルの拡張子。元のファイル名の後ろに付ける
+inline constexpr char kCookedFontExtension[] = ".cooked";
+
+/// @brief フォントデータを変換済み形式(文字情報とカーニングを配列のまま並べたバイナリ)にする
+/// @param fontData 変換するフォントデータ
+/// @param sourceHash 元のファイルのハッシュ値
+/// @return 変換済みのデータ
+std::string CookFont(const FontData &fontData, uint64_t sourceHash);
+
+/// @brief 変換済み形式からフォントデータを復元する
+/// @param bytes 変換済みのデータ
+/// @param expectedHash 元のファイルのハッシュ値。nullptrなら検証しない
+/// @return 復元したフォントデータ。形式が違うか古い場合は std::nullopt
+std::optional<FontData> UncookFont(std::string_view bytes, const uint64_t *expectedHash);
+
+/// @brief 変換済みファイルの読み込み(ファイル全体を1回で読み込む)
+/// @param cookedPath 変換済みファイルのパス
+/// @param expectedHash 元のファイルのハッシュ値。nullptrなら検証しない
+/// @return 読み込んだフォントデータ。無いか古い場合は std::nullopt
+std::optional<FontData> LoadCookedFont(const std::string &cookedPath, const uint64_t *expectedHash);
+
+/// @brief 変換済みファイルの保存
+/// @param cookedPath 変換済みファイルのパス
+/// @param sourceHash 元のファイルのハッシュ値
+/// @param fontData 保存するフォントデータ
+/// @return 保存できたかどうか
+bool SaveCookedFont(const std::string &cookedPath, uint64_t sourceHash, const FontData &fontData);
+
+} // namespace KashipanEngine
\ No newline at end of file
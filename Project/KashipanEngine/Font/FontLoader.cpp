@@ -1,11 +1,27 @@
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include "FontLoader.h"
+#include "Font/CookedFont.h"
+#include "Common/MemoryTracker.h"
+#include "Common/StringId.h"
 
 namespace KashipanEngine {
 
 namespace {
 
+// バイナリ形式のブロックの種類
+const uint8_t kBinaryBlockInfo = 1;
+const uint8_t kBinaryBlockCommon = 2;
+const uint8_t kBinaryBlockPages = 3;
+const uint8_t kBinaryBlockChars = 4;
+const uint8_t kBinaryBlockKerning = 5;
+// バイナリ形式の文字情報とカーニングの1つあたりのサイズ
+const size_t kBinaryCharSize = 20;
+const size_t kBinaryKerningSize = 10;
+
 /// @brief 文字の両辺にあるダブルクォーテーションを消す
 /// @param input ダブルクォーテーションを消したい文字列
 /// @return ダブルクォーテーションを消した後の文字列
@@ -281,15 +297,45 @@ CharInfo LoadCharInfo(std::istringstream &iss) {
     return charInfo;
 }
 
-} // namespace
+/// @brief カーニングの読み込み
+/// @param iss 読み込む行
+/// @param first 前の文字IDの格納先
+/// @param second 次の文字IDの格納先
+/// @return 次の文字の位置の補正量
+float LoadKerning(std::istringstream &iss, int &first, int &second) {
+    float amount = 0.0f;
 
-FontData LoadFNT(const char *fntFilePath) {
-    FontData fontData;
-    std::ifstream file(fntFilePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open font file: " + std::string(fntFilePath));
+    // 行を空白ごとに読み込み
+    std::string param;
+    while (iss >> param) {
+        // 区切った文字を "=" で区切る
+        size_t pos = param.find('=');
+        if (pos == std::string::npos) {
+            continue; // '='が見つからないものは無視
+        }
+        std::string key = param.substr(0, pos);
+        std::string value = param.substr(pos + 1);
+
+        if (key == "first") {
+            first = std::stoi(value);
+        } else if (key == "second") {
+            second = std::stoi(value);
+        } else if (key == "amount") {
+            amount = std::stof(value);
+        }
     }
 
+    return amount;
+}
+
+/// @brief テキスト形式の.fntの解析
+FontData ParseTextFNT(std::string_view bytes) {
+    FontData fontData{};
+    std::istringstream file{ std::string(bytes) };
+
+    // 文字情報は読み終えてから表にまとめる
+    std::vector<CharInfo> chars;
+
     // 行ごとの読み込み
     std::string line;
     while (std::getline(file, line)) {
@@ -299,15 +345,21 @@ FontData LoadFNT(const char *fntFilePath) {
         
         // 行の先頭の文字ごとに処理切り替え
         if (identifier == "char") {
-            CharInfo charInfo = LoadCharInfo(iss);
-            fontData.chars.emplace(charInfo.id, charInfo);
+            chars.push_back(LoadCharInfo(iss));
+
+        } else if (identifier == "kerning") {
+            int first = 0;
+            int second = 0;
+            const float amount = LoadKerning(iss, first, second);
+            fontData.kernings[FontData::MakeKerningKey(first, second)] = amount;
 
         } else if (identifier == "chars") {
-            std::string chars;
-            iss >> chars;
-            size_t pos = chars.find('=');
+            std::string charsCount;
+            iss >> charsCount;
+            size_t pos = charsCount.find('=');
             if (pos != std::string::npos) {
-                fontData.charsCount = std::stoi(chars.substr(pos + 1));
+                fontData.charsCount = std::stoi(charsCount.substr(pos + 1));
+                chars.reserve(static_cast<size_t>(std::max(fontData.charsCount, 0)));
             }
 
         } else if (identifier == "page") {
@@ -322,7 +374,212 @@ FontData LoadFNT(const char *fntFilePath) {
         }
     }
 
-    file.close();
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+/// @brief バイナリ形式の.fntかどうか("BMF" とバージョンの1バイトで始まる)
+bool IsBinaryFNT(std::string_view bytes) {
+    return bytes.size() >= 4 && bytes.substr(0, 3) == "BMF";
+}
+
+/// @brief バイナリ形式の.fntの読み込み用クラス。範囲外を読もうとしたら例外を投げる
+class BinaryFNTReader {
+public:
+    BinaryFNTReader(const char *data, size_t size) : current_(data), end_(data + size) {}
+
+    bool IsEnd() const { return current_ == end_; }
+    size_t GetRemainSize() const { return static_cast<size_t>(end_ - current_); }
+
+    /// @brief リトルエンディアンの値の読み込み
+    template<typename T>
+    T Read() {
+        Require(sizeof(T));
+        T value{};
+        std::memcpy(&value, current_, sizeof(T));
+        current_ += sizeof(T);
+        return value;
+    }
+    /// @brief null終端の文字列の読み込み
+    std::string ReadString() {
+        const char *terminator = static_cast<const char *>(std::memchr(current_, '\0', GetRemainSize()));
+        if (terminator == nullptr) {
+            throw std::runtime_error("Invalid binary font file: unterminated string");
+        }
+        std::string str(current_, terminator);
+        current_ = terminator + 1;
+        return str;
+    }
+    /// @brief 指定サイズだけ切り出した読み込み用クラス
+    BinaryFNTReader ReadBlock(size_t size) {
+        Require(size);
+        BinaryFNTReader block(current_, size);
+        current_ += size;
+        return block;
+    }
+
+private:
+    void Require(size_t size) const {
+        if (GetRemainSize() < size) {
+            throw std::runtime_error("Invalid binary font file: unexpected end of data");
+        }
+    }
+
+    const char *current_;
+    const char *end_;
+};
+
+/// @brief バイナリ形式の文字セットの番号をテキスト形式と同じ名前にする
+std::string GetCharsetName(uint8_t charset) {
+    switch (charset) {
+        case 0:   return "ANSI";
+        case 1:   return "DEFAULT";
+        case 2:   return "SYMBOL";
+        case 128: return "SHIFTJIS";
+        case 129: return "HANGUL";
+        case 134: return "GB2312";
+        case 136: return "CHINESEBIG5";
+        default:  return std::to_string(charset);
+    }
+}
+
+/// @brief バイナリ形式(バージョン3)の.fntの解析
+FontData ParseBinaryFNT(std::string_view bytes) {
+    if (static_cast<uint8_t>(bytes[3]) != 3) {
+        throw std::runtime_error("Unsupported binary font version: " + std::to_string(static_cast<uint8_t>(bytes[3])));
+    }
+    FontData fontData{};
+    std::vector<CharInfo> chars;
+
+    // ヘッダーの後ろに [種類(1バイト), サイズ(4バイト), 中身] のブロックが続く
+    BinaryFNTReader reader(bytes.data() + 4, bytes.size() - 4);
+    while (!reader.IsEnd()) {
+        const uint8_t blockType = reader.Read<uint8_t>();
+        const uint32_t blockSize = reader.Read<uint32_t>();
+        BinaryFNTReader block = reader.ReadBlock(blockSize);
+
+        if (blockType == kBinaryBlockInfo) {
+            //--------- info ---------//
+            FontInfo &info = fontData.info;
+            info.size = block.Read<int16_t>();
+            const uint8_t flags = block.Read<uint8_t>();
+            info.isSmooth = (flags & 0x80) != 0;
+            info.isUnicode = (flags & 0x40) != 0;
+            info.isItalic = (flags & 0x20) != 0;
+            info.isBold = (flags & 0x10) != 0;
+            const uint8_t charset = block.Read<uint8_t>();
+            info.charset = info.isUnicode ? "" : GetCharsetName(charset);
+            info.stretchH = static_cast<float>(block.Read<uint16_t>()) / 100.0f;
+            info.aa = block.Read<uint8_t>();
+            for (int &padding : info.padding) {
+                padding = block.Read<uint8_t>();
+            }
+            for (int &spacing : info.spacing) {
+                spacing = block.Read<uint8_t>();
+            }
+            info.outline = block.Read<uint8_t>();
+            info.face = block.ReadString();
+
+        } else if (blockType == kBinaryBlockCommon) {
+            //--------- common ---------//
+            FontCommon &common = fontData.common;
+            common.lineHeight = static_cast<float>(block.Read<uint16_t>());
+            common.base = static_cast<float>(block.Read<uint16_t>());
+            common.scaleW = static_cast<float>(block.Read<uint16_t>());
+            common.scaleH = static_cast<float>(block.Read<uint16_t>());
+            common.pages = block.Read<uint16_t>();
+            common.isPacked = (block.Read<uint8_t>() & 0x01) != 0;
+            common.alphaChannel = block.Read<uint8_t>();
+            common.redChannel = block.Read<uint8_t>();
+            common.greenChannel = block.Read<uint8_t>();
+            common.blueChannel = block.Read<uint8_t>();
+
+        } else if (blockType == kBinaryBlockPages) {
+            //--------- pages ---------//
+            while (!block.IsEnd()) {
+                FontPage fontPage{};
+                fontPage.id = static_cast<int>(fontData.pages.size());
+                fontPage.file = block.ReadString();
+                fontData.pages.push_back(std::move(fontPage));
+            }
+
+        } else if (blockType == kBinaryBlockChars) {
+            //--------- chars ---------//
+            chars.reserve(blockSize / kBinaryCharSize);
+            while (block.GetRemainSize() >= kBinaryCharSize) {
+                CharInfo charInfo{};
+                charInfo.id = static_cast<int>(block.Read<uint32_t>());
+                charInfo.x = static_cast<float>(block.Read<uint16_t>());
+                charInfo.y = static_cast<float>(block.Read<uint16_t>());
+                charInfo.width = static_cast<float>(block.Read<uint16_t>());
+                charInfo.height = static_cast<float>(block.Read<uint16_t>());
+                charInfo.xOffset = static_cast<float>(block.Read<int16_t>());
+                charInfo.yOffset = static_cast<float>(block.Read<int16_t>());
+                charInfo.xAdvance = static_cast<float>(block.Read<int16_t>());
+                charInfo.page = block.Read<uint8_t>();
+                charInfo.channel = block.Read<uint8_t>();
+                chars.push_back(charInfo);
+            }
+            fontData.charsCount = static_cast<int>(chars.size());
+
+        } else if (blockType == kBinaryBlockKerning) {
+            //--------- kerning ---------//
+            fontData.kernings.reserve(blockSize / kBinaryKerningSize);
+            while (block.GetRemainSize() >= kBinaryKerningSize) {
+                const int first = static_cast<int>(block.Read<uint32_t>());
+                const int second = static_cast<int>(block.Read<uint32_t>());
+                const float amount = static_cast<float>(block.Read<int16_t>());
+                fontData.kernings[FontData::MakeKerningKey(first, second)] = amount;
+            }
+        }
+    }
+
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+/// @brief ファイルの中身をすべて読み込む
+bool ReadFileBytes(const char *filePath, std::string &out) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::streamoff size = file.tellg();
+    out.assign(static_cast<size_t>(std::max<std::streamoff>(size, 0)), '\0');
+    file.seekg(0);
+    return static_cast<bool>(file.read(out.data(), static_cast<std::streamsize>(out.size())));
+}
+
+} // namespace
+
+FontData ParseFNT(std::string_view bytes) {
+    MEMORY_TAG_SCOPE(kFont);
+    if (IsBinaryFNT(bytes)) {
+        return ParseBinaryFNT(bytes);
+    }
+    return ParseTextFNT(bytes);
+}
+
+FontData LoadFNT(const char *fntFilePath) {
+    MEMORY_TAG_SCOPE(kFont);
+    const std::string cookedPath = std::string(fntFilePath) + kCookedFontExtension;
+    // リリースビルドでも元のファイルがあればハッシュを確かめる(古い変換済みファイルを使わないように)
+    std::string bytes;
+    if (!ReadFileBytes(fntFilePath, bytes)) {
+        // 元のファイルが無い場合は変換済みファイルだけでも読む
+        if (auto cooked = LoadCookedFont(cookedPath, nullptr)) {
+            return std::move(*cooked);
+        }
+        throw std::runtime_error("Failed to open font file: " + std::string(fntFilePath));
+    }
+
+    // 元のファイルが変わっていなければ変換済みファイルを使う
+    const uint64_t sourceHash = StringId::Hash(bytes);
+    if (auto cooked = LoadCookedFont(cookedPath, &sourceHash)) {
+        return std::move(*cooked);
+    }
+    FontData fontData = ParseFNT(bytes);
+    SaveCookedFont(cookedPath, sourceHash, fontData);
     return fontData;
 }
 
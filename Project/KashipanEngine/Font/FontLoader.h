@@ -1,9 +1,16 @@
 #pragma once
+#include <string_view>
 #include "Font/FontStructs.h"
 
 namespace KashipanEngine {
 
-/// @brief フォントデータ(.fnt)の読み込み
+/// @brief フォントデータ(.fnt)の解析。BMFontのテキスト形式とバイナリ形式(バージョン3)に対応する
+/// @param bytes .fntファイルの中身
+/// @return 解析したフォントデータ。ページのテクスチャのインデックスは0
+FontData ParseFNT(std::string_view bytes);
+
+/// @brief フォントデータ(.fnt)の読み込み。
+/// 解析結果を変換済みファイル(.fnt.cooked)に保存し、元のファイルが変わっていなければ次からはそちらを読み込む
 /// @param fntFilePath フォントファイル(.fnt)のパス
 /// @return 読み込んだフォントデータ
 FontData LoadFNT(const char *fntFilePath);
@@ -0,0 +1,80 @@
+#include <filesystem>
+#include <format>
+#include <memory>
+#include "FontRegistry.h"
+#include "Font/FontLoader.h"
+#include "Base/Texture.h"
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+/// @brief 登録されているフォント。
+/// SlotMap は追加で要素が移動するので、Get で返したポインタが無効にならないよう別に確保して持つ
+MyStd::NamedSlotMap<std::string, std::unique_ptr<const FontData>> sFontMap;
+
+} // namespace
+
+FontHandle FontRegistry::Load(const std::string &fntFilePath) {
+    MEMORY_TAG_SCOPE(kFont);
+    // 読み込み済みならそれを使う
+    const FontHandle loadedHandle = sFontMap.find(fntFilePath);
+    if (loadedHandle.IsValid()) {
+        return loadedHandle;
+    }
+
+    FontData fontData;
+    try {
+        fontData = LoadFNT(fntFilePath.c_str());
+    } catch (const std::exception &e) {
+        Log(e.what(), kLogLevelFlagError);
+        return FontHandle{};
+    }
+    if (fontData.pages.empty()) {
+        Log(std::format("Font has no pages: {}", fntFilePath), kLogLevelFlagError);
+        return FontHandle{};
+    }
+
+    // ページのテクスチャはフォントファイルと同じフォルダから読み込む
+    const std::string directory = std::filesystem::path(fntFilePath).parent_path().string();
+    for (auto &page : fontData.pages) {
+        page.textureHandle = Texture::Load(directory + '/' + page.file);
+    }
+
+    LogSimple(std::format("Complete Load Font: {} ({} chars, {} kernings, {} bytes)",
+        fntFilePath, fontData.chars.GetCount(), fontData.kernings.size(), fontData.GetMemoryBytes()));
+    return Add(fntFilePath, std::move(fontData));
+}
+
+FontHandle FontRegistry::Add(const std::string &name, FontData fontData) {
+    MEMORY_TAG_SCOPE(kFont);
+    // 置き換えると古いデータを指している TextLayout が残るので、登録済みのものを使い続ける
+    const FontHandle registeredHandle = sFontMap.find(name);
+    if (registeredHandle.IsValid()) {
+        Log(std::format("Font '{}' is already registered. Keeping the registered font.", name), kLogLevelFlagWarning);
+        return registeredHandle;
+    }
+    return sFontMap.insert(name, std::make_unique<const FontData>(std::move(fontData)));
+}
+
+FontHandle FontRegistry::Find(const std::string &name) {
+    return sFontMap.find(name);
+}
+
+const FontData *FontRegistry::Get(FontHandle handle) {
+    const auto *fontData = sFontMap.get(handle);
+    return fontData ? fontData->get() : nullptr;
+}
+
+size_t FontRegistry::GetCount() {
+    return sFontMap.size();
+}
+
+void FontRegistry::Finalize() {
+    sFontMap.clear();
+    Log("FontRegistry Finalized.");
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
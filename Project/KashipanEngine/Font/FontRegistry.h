@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <SlotMap.h>
+#include "Font/FontStructs.h"
+
+namespace KashipanEngine {
+
+/// @brief フォントのハンドル
+using FontHandle = MyStd::SlotHandle;
+
+/// @brief 読み込んだフォントの管理クラス。
+/// フォントは1回だけ読み込んで変更せずに保持し、Text からはハンドルで共有して参照する
+class FontRegistry {
+public:
+    FontRegistry() = delete;
+    ~FontRegistry() = delete;
+    FontRegistry(const FontRegistry &) = delete;
+    FontRegistry &operator=(const FontRegistry &) = delete;
+
+    /// @brief フォント(.fnt)とページのテクスチャの読み込み。読み込み済みならそのハンドルを返す
+    /// @param fntFilePath フォントファイル(.fnt)のパス
+    /// @return フォントのハンドル。読み込めなければ無効なハンドル
+    static FontHandle Load(const std::string &fntFilePath);
+
+    /// @brief 作成済みのフォントデータの登録。
+    /// Get で返したポインタを無効にしないよう、同じ名前があれば置き換えずに警告を出して登録済みのハンドルを返す
+    /// @param name フォントの名前
+    /// @param fontData 登録するフォントデータ(ページのテクスチャのインデックスは設定済みであること)
+    /// @return フォントのハンドル
+    static FontHandle Add(const std::string &name, FontData fontData);
+
+    /// @brief フォントのハンドルの検索
+    /// @param name フォントの名前(読み込んだフォントはファイルパス)
+    /// @return フォントのハンドル。見つからなければ無効なハンドル
+    static FontHandle Find(const std::string &name);
+
+    /// @brief フォントデータの取得。ポインタは Finalize するまで有効
+    /// @param handle フォントのハンドル
+    /// @return フォントデータ。無効なハンドルならnullptr
+    static const FontData *Get(FontHandle handle);
+
+    /// @brief 登録されているフォントの数
+    static size_t GetCount();
+
+    /// @brief 登録されているフォントの解放
+    static void Finalize();
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
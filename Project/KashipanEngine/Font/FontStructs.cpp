@@ -0,0 +1,53 @@
+#include "FontStructs.h"
+
+namespace KashipanEngine {
+
+void GlyphTable::Build(std::vector<CharInfo> chars) {
+    // 文字IDの順に並べ、同じ文字IDは後に読み込んだものを残す(変換済みファイルは並んでいるのでソートしない)
+    auto compareId = [](const CharInfo &a, const CharInfo &b) { return a.id < b.id; };
+    if (!std::is_sorted(chars.begin(), chars.end(), compareId)) {
+        std::stable_sort(chars.begin(), chars.end(), compareId);
+    }
+    chars_.clear();
+    chars_.reserve(chars.size());
+    for (const auto &charInfo : chars) {
+        if (!chars_.empty() && chars_.back().id == charInfo.id) {
+            chars_.back() = charInfo;
+        } else {
+            chars_.push_back(charInfo);
+        }
+    }
+    chars_.shrink_to_fit();
+
+    denseIndices_.assign(kDenseCount, kInvalidIndex);
+    sparseIds_.clear();
+    sparseBegin_ = chars_.size();
+    for (size_t i = 0; i < chars_.size(); ++i) {
+        const int id = chars_[i].id;
+        if (id >= 0 && id < kDenseCount) {
+            denseIndices_[id] = static_cast<uint32_t>(i);
+        } else if (id >= kDenseCount) {
+            if (sparseIds_.empty()) {
+                sparseBegin_ = i;
+            }
+            sparseIds_.push_back(id);
+        }
+    }
+    sparseIds_.shrink_to_fit();
+}
+
+bool FontData::operator==(const FontData &other) const {
+    if (info != other.info || common != other.common || pages != other.pages ||
+        chars != other.chars || charsCount != other.charsCount || kernings.size() != other.kernings.size()) {
+        return false;
+    }
+    for (const auto &[key, amount] : kernings) {
+        auto it = other.kernings.find(key);
+        if (it == other.kernings.end() || it->second != amount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
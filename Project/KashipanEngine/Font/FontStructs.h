@@ -1,7 +1,11 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <array>
-#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <FlatHashMap.h>
+#include "Common/TextureHandle.h"
 
 namespace KashipanEngine {
 
@@ -31,6 +35,8 @@ struct FontInfo {
     bool isItalic;      ///< 斜体フラグ
     bool isUnicode;     ///< Unicode使用フラグ
     bool isSmooth;      ///< アンチエイリアスフラグ
+
+    bool operator==(const FontInfo &) const = default;
 };
 
 /// @brief 描画に必要な共通設定
@@ -45,13 +51,17 @@ struct FontCommon {
     int greenChannel;   ///< 緑チャンネルの使用状況
     int blueChannel;    ///< 青チャンネルの使用状況
     bool isPacked;      ///< テクスチャが圧縮されているか
+
+    bool operator==(const FontCommon &) const = default;
 };
 
 /// @brief フォント画像(テクスチャ)の情報
 struct FontPage {
     int id;             ///< ページID (0から始まる)
-    int textureIndex;   ///< 使用するテクスチャのインデックス
+    TextureHandle textureHandle;    ///< 使用するテクスチャのハンドル
     std::string file;   ///< ページに対応する画像ファイル名
+
+    bool operator==(const FontPage &) const = default;
 };
 
 /// @brief 文字ごとの情報
@@ -66,6 +76,63 @@ struct CharInfo {
     float xOffset;      ///< 描画位置のXオフセット
     float yOffset;      ///< 描画位置のYオフセット
     float xAdvance;     ///< 次の文字の描画位置
+
+    bool operator==(const CharInfo &) const = default;
+};
+
+/// @brief 文字情報の表。ASCII・ラテン文字の範囲は配列で直接引き、それ以外は文字IDでソートした配列を二分探索する。
+/// 検索しても要素が増えることは無い
+class GlyphTable {
+public:
+    /// @brief 配列で直接引く文字IDの数(U+0000~U+024F: ASCII・ラテン文字)
+    static constexpr int kDenseCount = 0x250;
+
+    /// @brief 文字情報から表を作る。同じ文字IDがあれば後のものを使う
+    /// @param chars 文字情報
+    void Build(std::vector<CharInfo> chars);
+
+    /// @brief 文字情報の検索
+    /// @param codePoint 文字ID(Unicode)
+    /// @return 文字情報。見つからなければnullptr
+    const CharInfo *Find(int codePoint) const {
+        if (static_cast<uint32_t>(codePoint) < static_cast<uint32_t>(kDenseCount)) {
+            if (denseIndices_.empty()) {
+                return nullptr;
+            }
+            const uint32_t index = denseIndices_[codePoint];
+            return index != kInvalidIndex ? &chars_[index] : nullptr;
+        }
+        auto it = std::lower_bound(sparseIds_.begin(), sparseIds_.end(), codePoint);
+        if (it == sparseIds_.end() || *it != codePoint) {
+            return nullptr;
+        }
+        return &chars_[sparseBegin_ + static_cast<size_t>(it - sparseIds_.begin())];
+    }
+
+    /// @brief 文字IDの順に並んだすべての文字情報
+    const std::vector<CharInfo> &GetChars() const { return chars_; }
+    /// @brief 文字の数
+    size_t GetCount() const { return chars_.size(); }
+    /// @brief 文字情報がすべて同じかどうか
+    bool operator==(const GlyphTable &other) const { return chars_ == other.chars_; }
+
+    /// @brief 表が使っているヒープのサイズ(バイト)
+    size_t GetMemoryBytes() const {
+        return denseIndices_.capacity() * sizeof(uint32_t) + chars_.capacity() * sizeof(CharInfo)
+            + sparseIds_.capacity() * sizeof(int);
+    }
+
+private:
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    /// @brief 文字IDから chars_ へのインデックス(kDenseCount 未満の文字ID用)
+    std::vector<uint32_t> denseIndices_;
+    /// @brief 文字IDの順に並んだ文字情報
+    std::vector<CharInfo> chars_;
+    /// @brief kDenseCount 以上の文字ID(chars_[sparseBegin_] 以降と同じ順)
+    std::vector<int> sparseIds_;
+    /// @brief kDenseCount 以上の文字IDの最初の chars_ のインデックス
+    size_t sparseBegin_ = 0;
 };
 
 /// @brief フォント全体のデータ構造
@@ -76,10 +143,43 @@ struct FontData {
     FontCommon common;
     // 使用するフォントページの情報
     std::vector<FontPage> pages;
-    // 文字ごとの情報 (文字IDをキーとするマップ)
-    std::unordered_map<int, CharInfo> chars;
+    // 文字ごとの情報
+    GlyphTable chars;
+    // カーニング (前の文字IDと次の文字IDの組をキーとする、次の文字の位置の補正量)
+    MyStd::FlatHashMap<uint64_t, float> kernings;
     // 文字の数
     int charsCount;
+
+    /// @brief 文字情報の検索
+    /// @param codePoint 文字ID(Unicode)
+    /// @return 文字情報。見つからなければnullptr
+    const CharInfo *FindChar(int codePoint) const { return chars.Find(codePoint); }
+
+    /// @brief カーニングの補正量の取得
+    /// @param first 前の文字ID
+    /// @param second 次の文字ID
+    /// @return 次の文字の位置の補正量。カーニングが無ければ0
+    float GetKerning(int first, int second) const {
+        if (kernings.empty()) {
+            return 0.0f;
+        }
+        auto it = kernings.find(MakeKerningKey(first, second));
+        return it != kernings.end() ? it->second : 0.0f;
+    }
+
+    /// @brief カーニングのキーの作成
+    static uint64_t MakeKerningKey(int first, int second) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32) | static_cast<uint32_t>(second);
+    }
+
+    /// @brief 内容がすべて同じかどうか(変換済みファイルとの往復の確認用)
+    bool operator==(const FontData &other) const;
+
+    /// @brief フォントデータが使っているヒープのおおよそのサイズ(バイト)
+    size_t GetMemoryBytes() const {
+        return chars.GetMemoryBytes() + pages.capacity() * sizeof(FontPage)
+            + kernings.capacity() * (sizeof(std::pair<const uint64_t, float>) + 1);
+    }
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
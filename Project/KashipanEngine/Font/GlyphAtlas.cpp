@@ -0,0 +1,526 @@
+// imgui の imstb_rectpack・imstb_truetype の実装は imgui_draw.cpp の中に static で閉じているので、このファイル用にも static で持つ。
+// 警告の抑制は imgui_draw.cpp に合わせる
+#ifdef _MSC_VER
+#pragma warning(disable: 4505) // 使っていない static 関数が削除された(翻訳単位の最後に出るので push の外で抑制する)
+#pragma warning(push)
+#pragma warning(disable: 4127 4456 4996 6011 6385 28182)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include "GlyphAtlas.h"
+#include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 文字の間に空ける隙間(ピクセル)。線形補間で隣の文字の距離を拾わないようにする
+const int kGlyphSpacing = 1;
+// SDFで文字の輪郭にあたる値
+const unsigned char kOnEdgeValue = 128;
+
+} // namespace
+
+/// @brief 読み込んだTrueTypeフォント
+struct GlyphAtlas::TrueTypeFont {
+    std::vector<uint8_t> data;
+    stbtt_fontinfo info{};
+    // 基準サイズへの拡大率
+    float scale = 0.0f;
+    FontMetrics metrics;
+};
+
+/// @brief アトラスの区画。区画ごとに詰めて、区画ごとに追い出す
+struct GlyphAtlas::Region {
+    stbrp_context context{};
+    std::vector<stbrp_node> nodes;
+    // 入っている文字のキー
+    std::vector<uint64_t> keys;
+    // 文字が使っているピクセル数
+    uint64_t usedPixelCount = 0;
+    // 使い始めているかどうか
+    bool isUsed = false;
+    // 前回の反映から画素が変わったかどうか
+    bool isDirty = false;
+
+    /// @brief 空にする
+    void Reset(int size) {
+        nodes.resize(static_cast<size_t>(size));
+        stbrp_init_target(&context, size, size, nodes.data(), size);
+        keys.clear();
+        usedPixelCount = 0;
+        isUsed = false;
+    }
+
+    /// @brief 四角形を詰める
+    /// @return 詰められたかどうか
+    bool Pack(int width, int height, int &x, int &y) {
+        stbrp_rect rect{};
+        rect.w = width;
+        rect.h = height;
+        stbrp_pack_rects(&context, &rect, 1);
+        x = rect.x;
+        y = rect.y;
+        return rect.was_packed != 0;
+    }
+};
+
+GlyphAtlas::GlyphAtlas(const GlyphAtlasDesc &desc) : desc_(desc) {
+    if (desc_.regionSize == 0 || desc_.regionSize > desc_.atlasSize || desc_.atlasSize % desc_.regionSize != 0) {
+        Log(std::format("Invalid glyph atlas region size {} for atlas size {}. Using one region.",
+            desc_.regionSize, desc_.atlasSize), kLogLevelFlagWarning);
+        desc_.regionSize = desc_.atlasSize;
+    }
+    desc_.sdfPadding = std::max(desc_.sdfPadding, 1);
+    regionsPerRow_ = desc_.atlasSize / desc_.regionSize;
+    const uint32_t regionCount = regionsPerRow_ * regionsPerRow_;
+
+    {
+        MEMORY_TAG_SCOPE(kFont);
+        regions_.resize(regionCount);
+        for (auto &region : regions_) {
+            region.Reset(static_cast<int>(desc_.regionSize));
+        }
+        regionLastUsedFrames_ = std::make_unique<std::atomic<uint64_t>[]>(regionCount);
+        pixels_.assign(static_cast<size_t>(desc_.atlasSize) * desc_.atlasSize, 0);
+        workPixels_.assign(pixels_.size(), 0);
+    }
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        regionLastUsedFrames_[i].store(0, std::memory_order_relaxed);
+    }
+
+    workers_.reserve(desc_.workerCount);
+    for (uint32_t i = 0; i < desc_.workerCount; ++i) {
+        workers_.emplace_back(&GlyphAtlas::WorkerLoop, this);
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+    }
+    requestCondition_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+int GlyphAtlas::LoadFont(const std::string &filePath, int fontIndex) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        Log(std::format("Failed to open TrueType font file: {}", filePath), kLogLevelFlagError);
+        return -1;
+    }
+    std::vector<uint8_t> data;
+    {
+        MEMORY_TAG_SCOPE(kFont);
+        data.resize(static_cast<size_t>(file.tellg()));
+    }
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        Log(std::format("Failed to read TrueType font file: {}", filePath), kLogLevelFlagError);
+        return -1;
+    }
+    return AddFont(std::move(data), fontIndex);
+}
+
+int GlyphAtlas::AddFont(std::vector<uint8_t> data, int fontIndex) {
+    MEMORY_TAG_SCOPE(kFont);
+    auto font = std::make_unique<TrueTypeFont>();
+    font->data = std::move(data);
+    const int offset = font->data.empty() ? -1 : stbtt_GetFontOffsetForIndex(font->data.data(), fontIndex);
+    if (offset < 0 || !stbtt_InitFont(&font->info, font->data.data(), offset)) {
+        Log(std::format("Invalid TrueType font data (font index {}).", fontIndex), kLogLevelFlagError);
+        return -1;
+    }
+    font->scale = stbtt_ScaleForPixelHeight(&font->info, desc_.sdfPixelHeight);
+    int ascent = 0;
+    int descent = 0;
+    int lineGap = 0;
+    stbtt_GetFontVMetrics(&font->info, &ascent, &descent, &lineGap);
+    font->metrics.ascent = static_cast<float>(ascent) * font->scale;
+    font->metrics.descent = static_cast<float>(descent) * font->scale;
+    font->metrics.lineGap = static_cast<float>(lineGap) * font->scale;
+    font->metrics.lineHeight = font->metrics.ascent - font->metrics.descent + font->metrics.lineGap;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    fonts_.push_back(std::move(font));
+    return static_cast<int>(fonts_.size() - 1);
+}
+
+void GlyphAtlas::BeginFrame() {
+    frameIndex_.fetch_add(1, std::memory_order_relaxed);
+    ApplyEvents();
+}
+
+const GlyphAtlas::Glyph *GlyphAtlas::FindGlyph(int fontId, int codePoint) {
+    const uint64_t key = MakeKey(fontId, codePoint);
+    auto it = glyphs_.find(key);
+    if (it != glyphs_.end()) {
+        ++stats_.hitCount;
+        if (it->second.regionIndex != kNoRegion) {
+            regionLastUsedFrames_[it->second.regionIndex].store(
+                frameIndex_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return &it->second;
+    }
+
+    // 要求済みでなければワーカーに頼む
+    if (pendingKeys_.try_emplace(key, 0u).second) {
+        ++stats_.missCount;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            requests_.push_back(key);
+        }
+        requestCondition_.notify_one();
+    }
+    return nullptr;
+}
+
+void GlyphAtlas::WaitIdle() {
+    if (!workers_.empty()) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idleCondition_.wait(lock, [this]() { return requests_.empty() && activeWorkerCount_ == 0; });
+    }
+    ApplyEvents();
+}
+
+void GlyphAtlas::Clear() {
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &region : regions_) {
+            region.Reset(static_cast<int>(desc_.regionSize));
+            region.isDirty = true;
+        }
+        std::fill(workPixels_.begin(), workPixels_.end(), static_cast<uint8_t>(0));
+        events_.clear();
+    }
+    for (size_t i = 0; i < regions_.size(); ++i) {
+        regionLastUsedFrames_[i].store(0, std::memory_order_relaxed);
+    }
+    glyphs_.clear();
+    pendingKeys_.clear();
+    ApplyEvents();
+}
+
+std::vector<uint8_t> GlyphAtlas::RasterizeGlyph(int fontId, int codePoint, int &width, int &height) const {
+    width = 0;
+    height = 0;
+    const TrueTypeFont *font = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fontId >= 0 && static_cast<size_t>(fontId) < fonts_.size()) {
+            font = fonts_[fontId].get();
+        }
+    }
+    std::vector<uint8_t> bitmap;
+    if (font == nullptr) {
+        return bitmap;
+    }
+    int xOffset = 0;
+    int yOffset = 0;
+    unsigned char *sdf = stbtt_GetCodepointSDF(&font->info, font->scale, codePoint, desc_.sdfPadding, kOnEdgeValue,
+        static_cast<float>(kOnEdgeValue - 1) / static_cast<float>(desc_.sdfPadding), &width, &height, &xOffset, &yOffset);
+    if (sdf == nullptr) {
+        width = 0;
+        height = 0;
+        return bitmap;
+    }
+    bitmap.assign(sdf, sdf + static_cast<size_t>(width) * height);
+    stbtt_FreeSDF(sdf, nullptr);
+    return bitmap;
+}
+
+bool GlyphAtlas::HasGlyph(int fontId, int codePoint) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fontId < 0 || static_cast<size_t>(fontId) >= fonts_.size()) {
+        return false;
+    }
+    return stbtt_FindGlyphIndex(&fonts_[fontId]->info, codePoint) != 0;
+}
+
+GlyphAtlas::FontMetrics GlyphAtlas::GetFontMetrics(int fontId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fontId < 0 || static_cast<size_t>(fontId) >= fonts_.size()) {
+        return {};
+    }
+    return fonts_[fontId]->metrics;
+}
+
+void GlyphAtlas::GetRegionOrigin(uint32_t regionIndex, uint32_t &x, uint32_t &y) const {
+    x = (regionIndex % regionsPerRow_) * desc_.regionSize;
+    y = (regionIndex / regionsPerRow_) * desc_.regionSize;
+}
+
+void GlyphAtlas::WorkerLoop() {
+    // このスレッドでの確保は全てSDFのラスタライズなのでフォントとして数える
+    MEMORY_TAG_SCOPE(kFont);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        requestCondition_.wait(lock, [this]() { return isStopped_ || !requests_.empty(); });
+        if (isStopped_) {
+            break;
+        }
+        const uint64_t key = requests_.front();
+        requests_.pop_front();
+        ++activeWorkerCount_;
+        lock.unlock();
+        ProcessRequest(key);
+        lock.lock();
+        --activeWorkerCount_;
+        if (requests_.empty() && activeWorkerCount_ == 0) {
+            idleCondition_.notify_all();
+        }
+    }
+}
+
+void GlyphAtlas::ProcessRequest(uint64_t key) {
+    const int fontId = static_cast<int>(key >> 32);
+    const int codePoint = static_cast<int>(static_cast<uint32_t>(key));
+
+    // ラスタライズは重いのでロックせずに行う(フォントは読み取りだけなので複数スレッドから使える)
+    const TrueTypeFont *font = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fontId >= 0 && static_cast<size_t>(fontId) < fonts_.size()) {
+            font = fonts_[fontId].get();
+        }
+    }
+    Event event;
+    event.key = key;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> bitmap;
+    if (font) {
+        int advance = 0;
+        int leftSideBearing = 0;
+        stbtt_GetCodepointHMetrics(&font->info, codePoint, &advance, &leftSideBearing);
+        event.glyph.xAdvance = static_cast<float>(advance) * font->scale;
+
+        int xOffset = 0;
+        int yOffset = 0;
+        unsigned char *sdf = stbtt_GetCodepointSDF(&font->info, font->scale, codePoint, desc_.sdfPadding, kOnEdgeValue,
+            static_cast<float>(kOnEdgeValue - 1) / static_cast<float>(desc_.sdfPadding), &width, &height, &xOffset, &yOffset);
+        if (sdf) {
+            bitmap.assign(sdf, sdf + static_cast<size_t>(width) * height);
+            stbtt_FreeSDF(sdf, nullptr);
+        } else {
+            width = 0;
+            height = 0;
+        }
+        // ベースラインからの位置を行の上端からの位置にする
+        event.glyph.xOffset = static_cast<float>(xOffset);
+        event.glyph.yOffset = static_cast<float>(yOffset) + font->metrics.ascent;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (font == nullptr) {
+        event.isFailed = true;
+        events_.push_back(std::move(event));
+        return;
+    }
+    ++rasterizedCount_;
+    if (width == 0 || height == 0) {
+        // 見た目の無い文字は区画を使わない
+        event.glyph.regionIndex = kNoRegion;
+        events_.push_back(std::move(event));
+        return;
+    }
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    const uint32_t regionIndex = PackGlyph(width, height, x, y);
+    if (regionIndex == kNoRegion) {
+        event.isFailed = true;
+        events_.push_back(std::move(event));
+        return;
+    }
+    for (int row = 0; row < height; ++row) {
+        std::memcpy(&workPixels_[(static_cast<size_t>(y) + row) * desc_.atlasSize + x],
+            &bitmap[static_cast<size_t>(row) * width], static_cast<size_t>(width));
+    }
+    Region &region = regions_[regionIndex];
+    region.keys.push_back(key);
+    region.usedPixelCount += static_cast<uint64_t>(width) * height;
+    region.isDirty = true;
+    // 詰めたフレームのうちに追い出されないようにする
+    regionLastUsedFrames_[regionIndex].store(frameIndex_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    const float atlasSize = static_cast<float>(desc_.atlasSize);
+    Glyph &glyph = event.glyph;
+    glyph.x = static_cast<uint16_t>(x);
+    glyph.y = static_cast<uint16_t>(y);
+    glyph.width = static_cast<uint16_t>(width);
+    glyph.height = static_cast<uint16_t>(height);
+    glyph.uvLeft = static_cast<float>(x) / atlasSize;
+    glyph.uvTop = static_cast<float>(y) / atlasSize;
+    glyph.uvRight = static_cast<float>(x + width) / atlasSize;
+    glyph.uvBottom = static_cast<float>(y + height) / atlasSize;
+    glyph.regionIndex = regionIndex;
+    events_.push_back(std::move(event));
+}
+
+uint32_t GlyphAtlas::PackGlyph(int width, int height, uint32_t &x, uint32_t &y) {
+    const int packWidth = width + kGlyphSpacing;
+    const int packHeight = height + kGlyphSpacing;
+    if (packWidth > static_cast<int>(desc_.regionSize) || packHeight > static_cast<int>(desc_.regionSize)) {
+        return kNoRegion;
+    }
+    auto tryPack = [&](uint32_t regionIndex) {
+        int packX = 0;
+        int packY = 0;
+        if (!regions_[regionIndex].Pack(packWidth, packHeight, packX, packY)) {
+            return false;
+        }
+        GetRegionOrigin(regionIndex, x, y);
+        x += static_cast<uint32_t>(packX);
+        y += static_cast<uint32_t>(packY);
+        return true;
+    };
+
+    // 使い始めている区画に空きがあれば詰める
+    const uint32_t regionCount = static_cast<uint32_t>(regions_.size());
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        if (regions_[i].isUsed && tryPack(i)) {
+            return i;
+        }
+    }
+    // 空の区画を使い始める
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        if (!regions_[i].isUsed) {
+            regions_[i].isUsed = true;
+            return tryPack(i) ? i : kNoRegion;
+        }
+    }
+    // 最後に使われたのが最も古い区画を追い出す(今のフレームで使われた区画は描画中なので追い出さない)
+    const uint64_t frameIndex = frameIndex_.load(std::memory_order_relaxed);
+    uint32_t evictIndex = kNoRegion;
+    uint64_t oldestFrame = frameIndex;
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        const uint64_t lastUsedFrame = regionLastUsedFrames_[i].load(std::memory_order_relaxed);
+        if (lastUsedFrame < oldestFrame) {
+            oldestFrame = lastUsedFrame;
+            evictIndex = i;
+        }
+    }
+    if (evictIndex == kNoRegion) {
+        return kNoRegion;
+    }
+    EvictRegion(evictIndex);
+    regions_[evictIndex].isUsed = true;
+    return tryPack(evictIndex) ? evictIndex : kNoRegion;
+}
+
+void GlyphAtlas::EvictRegion(uint32_t regionIndex) {
+    Region &region = regions_[regionIndex];
+    ++evictedRegionCount_;
+    evictedGlyphCount_ += region.keys.size();
+
+    // メインスレッドには、区画に入っていた文字を次の反映で消すよう伝える
+    Event event;
+    event.evictedRegion = regionIndex;
+    event.evictedKeys = std::move(region.keys);
+    events_.push_back(std::move(event));
+
+    region.Reset(static_cast<int>(desc_.regionSize));
+    region.isDirty = true;
+    uint32_t originX = 0;
+    uint32_t originY = 0;
+    GetRegionOrigin(regionIndex, originX, originY);
+    for (uint32_t row = 0; row < desc_.regionSize; ++row) {
+        std::memset(&workPixels_[(static_cast<size_t>(originY) + row) * desc_.atlasSize + originX], 0, desc_.regionSize);
+    }
+}
+
+void GlyphAtlas::ApplyEvents() {
+    if (workers_.empty()) {
+        // ワーカーが無ければここでラスタライズする
+        while (true) {
+            uint64_t key = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (requests_.empty()) {
+                    break;
+                }
+                key = requests_.front();
+                requests_.pop_front();
+            }
+            ProcessRequest(key);
+        }
+    }
+
+    updatedRegions_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        appliedEvents_.swap(events_);
+        // 追い出しと文字の追加と同じ時点の画素を写す
+        for (uint32_t i = 0; i < static_cast<uint32_t>(regions_.size()); ++i) {
+            if (!regions_[i].isDirty) {
+                continue;
+            }
+            regions_[i].isDirty = false;
+            updatedRegions_.push_back(i);
+            uint32_t originX = 0;
+            uint32_t originY = 0;
+            GetRegionOrigin(i, originX, originY);
+            for (uint32_t row = 0; row < desc_.regionSize; ++row) {
+                const size_t offset = (static_cast<size_t>(originY) + row) * desc_.atlasSize + originX;
+                std::memcpy(&pixels_[offset], &workPixels_[offset], desc_.regionSize);
+            }
+        }
+        stats_.rasterizedCount = rasterizedCount_;
+        stats_.evictedRegionCount = evictedRegionCount_;
+        stats_.evictedGlyphCount = evictedGlyphCount_;
+        stats_.usedRegionCount = 0;
+        stats_.usedPixelCount = 0;
+        for (const auto &region : regions_) {
+            stats_.usedRegionCount += region.isUsed ? 1 : 0;
+            stats_.usedPixelCount += region.usedPixelCount;
+        }
+    }
+
+    // ワーカーが処理した順に反映する(追い出した区画に後から詰めた文字を消さないように)
+    for (auto &event : appliedEvents_) {
+        if (event.evictedRegion != kNoRegion) {
+            for (const uint64_t key : event.evictedKeys) {
+                glyphs_.erase(key);
+            }
+            continue;
+        }
+        pendingKeys_.erase(event.key);
+        if (event.isFailed) {
+            ++stats_.failedCount;
+            continue;
+        }
+        glyphs_.insert_or_assign(event.key, event.glyph);
+    }
+    appliedEvents_.clear();
+
+    stats_.glyphCount = glyphs_.size();
+    stats_.pendingCount = pendingKeys_.size();
+    stats_.occupancy = static_cast<double>(stats_.usedPixelCount) /
+        (static_cast<double>(desc_.atlasSize) * static_cast<double>(desc_.atlasSize));
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,230 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <FlatHashMap.h>
+
+namespace KashipanEngine {
+
+/// @brief SDFグリフアトラスの生成情報
+struct GlyphAtlasDesc {
+    // アトラスの幅と高さ(ピクセル)
+    uint32_t atlasSize = 1024;
+    // 追い出しの単位にする区画の幅と高さ(ピクセル)。atlasSize を割り切れること
+    uint32_t regionSize = 256;
+    // SDFを作る基準の文字の高さ(ピクセル)。すべての文字サイズはこれを拡大縮小して描画する
+    float sdfPixelHeight = 48.0f;
+    // SDFの文字の周りの余白(ピクセル)。距離を表せる範囲にもなる
+    int sdfPadding = 6;
+    // ラスタライズとパッキングを行うワーカースレッドの数。0なら BeginFrame・WaitIdle の中で行う
+    uint32_t workerCount = 2;
+};
+
+/// @brief TrueTypeフォントの文字を必要になった時にSDF(符号付き距離場)でラスタライズし、
+/// 1枚の共有アトラス(1チャンネル8ビット)に詰めていくキャッシュ。
+/// SDFは基準サイズで1回だけ作るので、どの文字サイズも同じアトラスから描画できる。
+/// アトラスは regionSize ごとの区画に分けて区画ごとに imstb_rectpack で詰め、空きが無くなったら
+/// 最後に使われたのが最も古い区画を丸ごと追い出す(使用中のフレームの区画は追い出さない)。
+///
+/// ラスタライズとパッキングはワーカースレッドで行い、結果はメインスレッドの BeginFrame でまとめて反映する。
+/// FindGlyph が返す文字と GetPixels の内容は、次の BeginFrame まで変わらない。
+///
+/// まだエンジンの描画には使っていない(使っているのはベンチマークとテストだけ)。
+/// Text で使うには、SDF用のシェーダーと GetUpdatedRegions の区画をテクスチャへ転送する処理が別途必要
+class GlyphAtlas {
+public:
+    /// @brief アトラスに入っている文字
+    struct Glyph {
+        // アトラス上の左上の位置と大きさ(ピクセル、余白を含む)。空白などの見た目の無い文字は大きさが0
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        // 基準サイズでの、行の左上から見た四角形の左上の位置
+        float xOffset = 0.0f;
+        float yOffset = 0.0f;
+        // 基準サイズでの次の文字までの距離
+        float xAdvance = 0.0f;
+        // テクスチャ座標
+        float uvLeft = 0.0f;
+        float uvTop = 0.0f;
+        float uvRight = 0.0f;
+        float uvBottom = 0.0f;
+        // 入っている区画のインデックス(見た目の無い文字は kNoRegion)
+        uint32_t regionIndex = 0;
+    };
+
+    /// @brief 統計情報
+    struct Stats {
+        // アトラスに入っている文字数
+        size_t glyphCount = 0;
+        // ラスタライズ待ちの文字数
+        size_t pendingCount = 0;
+        // FindGlyph で見つかった回数
+        uint64_t hitCount = 0;
+        // FindGlyph で見つからずラスタライズを要求した回数
+        uint64_t missCount = 0;
+        // ラスタライズした文字数
+        uint64_t rasterizedCount = 0;
+        // 追い出した区画の数
+        uint64_t evictedRegionCount = 0;
+        // 追い出した文字数
+        uint64_t evictedGlyphCount = 0;
+        // 追い出せる区画が無く入れられなかった回数
+        uint64_t failedCount = 0;
+        // 使用中の区画の数
+        uint32_t usedRegionCount = 0;
+        // 文字が使っているピクセル数
+        uint64_t usedPixelCount = 0;
+        // 文字が使っているピクセルの割合(0~1)
+        double occupancy = 0.0;
+    };
+
+    /// @brief フォントの縦方向の寸法(基準サイズ)
+    struct FontMetrics {
+        float ascent = 0.0f;
+        float descent = 0.0f;
+        float lineGap = 0.0f;
+        float lineHeight = 0.0f;
+    };
+
+    /// @brief 区画に入っていないことを表す値
+    static constexpr uint32_t kNoRegion = UINT32_MAX;
+
+    explicit GlyphAtlas(const GlyphAtlasDesc &desc = {});
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas &) = delete;
+    GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+    /// @brief TrueTypeフォント(.ttf, .ttc)の読み込み
+    /// @param filePath フォントファイルのパス
+    /// @param fontIndex .ttc の場合のフォントの番号
+    /// @return フォントのID。失敗したら-1
+    int LoadFont(const std::string &filePath, int fontIndex = 0);
+
+    /// @brief メモリ上のTrueTypeフォントの追加
+    /// @param data フォントファイルの中身
+    /// @param fontIndex .ttc の場合のフォントの番号
+    /// @return フォントのID。失敗したら-1
+    int AddFont(std::vector<uint8_t> data, int fontIndex = 0);
+
+    /// @brief フレームの開始処理。ワーカーが終えた文字と追い出しを反映し、フレーム番号を進める
+    void BeginFrame();
+
+    /// @brief 文字の検索。無ければラスタライズを要求して nullptr を返す(数フレーム後に見つかるようになる)
+    /// @param fontId フォントのID
+    /// @param codePoint 文字(Unicode)
+    /// @return アトラスの文字。次の BeginFrame まで有効
+    const Glyph *FindGlyph(int fontId, int codePoint);
+
+    /// @brief 要求済みのラスタライズがすべて終わるまで待って反映する(ツール・ベンチマーク用)。
+    /// 反映するので、それまでに FindGlyph で取得したポインタは無効になる
+    void WaitIdle();
+
+    /// @brief アトラスを空にする(ワーカーの処理が終わるまで待つ)
+    void Clear();
+
+    /// @brief SDFのラスタライズ。アトラスには入れない(ワーカーと同じ処理。内容の確認用)
+    /// @param fontId フォントのID
+    /// @param codePoint 文字(Unicode)
+    /// @param width 幅の格納先
+    /// @param height 高さの格納先
+    /// @return SDFの画素(width * height)。見た目の無い文字は空
+    std::vector<uint8_t> RasterizeGlyph(int fontId, int codePoint, int &width, int &height) const;
+
+    /// @brief フォントに文字があるかどうか
+    /// @param fontId フォントのID
+    /// @param codePoint 文字(Unicode)
+    bool HasGlyph(int fontId, int codePoint) const;
+
+    /// @brief フォントの縦方向の寸法(基準サイズ)
+    FontMetrics GetFontMetrics(int fontId) const;
+    /// @brief 基準サイズから pixelHeight の文字サイズへの拡大率
+    float GetScale(float pixelHeight) const { return pixelHeight / desc_.sdfPixelHeight; }
+    /// @brief 生成情報
+    const GlyphAtlasDesc &GetDesc() const { return desc_; }
+    /// @brief アトラスの画素(atlasSize * atlasSize、1ピクセル1バイト)。次の BeginFrame まで変わらない
+    const std::vector<uint8_t> &GetPixels() const { return pixels_; }
+    /// @brief 直前の BeginFrame・WaitIdle で画素が変わった区画(GPUへの転送用)
+    const std::vector<uint32_t> &GetUpdatedRegions() const { return updatedRegions_; }
+    /// @brief 区画の左上の位置(ピクセル)
+    void GetRegionOrigin(uint32_t regionIndex, uint32_t &x, uint32_t &y) const;
+    /// @brief 統計情報(直前の BeginFrame・WaitIdle の時点)
+    const Stats &GetStats() const { return stats_; }
+
+private:
+    struct TrueTypeFont;
+    struct Region;
+
+    /// @brief ワーカーからメインスレッドへの通知
+    struct Event {
+        // 追加した文字のキー(区画を追い出した場合は evictedRegion が有効)
+        uint64_t key = 0;
+        Glyph glyph;
+        // 追い出した区画(追い出していなければ kNoRegion)
+        uint32_t evictedRegion = kNoRegion;
+        // 追い出した区画に入っていた文字のキー
+        std::vector<uint64_t> evictedKeys;
+        // 入れられなかったかどうか
+        bool isFailed = false;
+    };
+
+    static uint64_t MakeKey(int fontId, int codePoint) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(fontId)) << 32) | static_cast<uint32_t>(codePoint);
+    }
+
+    /// @brief ワーカースレッドの処理
+    void WorkerLoop();
+    /// @brief 1文字をラスタライズしてアトラスに詰める(mutex_ はロックしていない状態で呼ぶ)
+    void ProcessRequest(uint64_t key);
+    /// @brief 文字を入れる区画を決めて詰める。空きが無ければ区画を追い出す(mutex_ をロックした状態で呼ぶ)
+    /// @return 詰めた区画。入れられなければ kNoRegion
+    uint32_t PackGlyph(int width, int height, uint32_t &x, uint32_t &y);
+    /// @brief 区画を空にして、入っていた文字の追い出しを通知する(mutex_ をロックした状態で呼ぶ)
+    void EvictRegion(uint32_t regionIndex);
+    /// @brief ワーカーの結果をメインスレッド側に反映する
+    void ApplyEvents();
+
+    GlyphAtlasDesc desc_;
+    uint32_t regionsPerRow_ = 0;
+
+    // ---- メインスレッドだけが触るもの ----
+    MyStd::FlatHashMap<uint64_t, Glyph> glyphs_;
+    // ラスタライズを要求済みの文字
+    MyStd::FlatHashMap<uint64_t, uint32_t> pendingKeys_;
+    std::vector<uint8_t> pixels_;
+    std::vector<uint32_t> updatedRegions_;
+    // ワーカーから受け取った通知(確保し直さないよう使い回す)
+    std::vector<Event> appliedEvents_;
+    Stats stats_;
+
+    // ---- mutex_ で守るもの ----
+    mutable std::mutex mutex_;
+    std::condition_variable requestCondition_;
+    std::condition_variable idleCondition_;
+    std::vector<std::unique_ptr<TrueTypeFont>> fonts_;
+    std::deque<uint64_t> requests_;
+    std::vector<Event> events_;
+    std::vector<Region> regions_;
+    // ワーカーが書き込む画素(BeginFrame で pixels_ に写す)
+    std::vector<uint8_t> workPixels_;
+    size_t activeWorkerCount_ = 0;
+    uint64_t rasterizedCount_ = 0;
+    uint64_t evictedRegionCount_ = 0;
+    uint64_t evictedGlyphCount_ = 0;
+    bool isStopped_ = false;
+
+    // 区画ごとの最後に使われたフレーム番号(メインスレッドが書き込み、ワーカーが追い出す区画を選ぶ)
+    std::unique_ptr<std::atomic<uint64_t>[]> regionLastUsedFrames_;
+    std::atomic<uint64_t> frameIndex_ = 1;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <LinearArena.h>
+#include "TextBatcher.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 同じハッシュ値の次の単位が無いことを表す値
+constexpr uint32_t kNoBatch = UINT32_MAX;
+
+/// @brief まとめる単位のキーのハッシュ値
+uint64_t HashBatchKey(const TextBatcher::TextState &textState, const TextureHandle &textureHandle) {
+    const std::string_view materialBytes(reinterpret_cast<const char *>(&textState.material), sizeof(Material));
+    uint64_t hash = StringId::Hash(materialBytes);
+    hash ^= textState.pipeLineName.GetHash() + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    const uint64_t texture = (static_cast<uint64_t>(textureHandle.generation) << 32) | textureHandle.index;
+    hash ^= texture * 2 + (textState.isUseCamera ? 1 : 0);
+    hash ^= static_cast<uint64_t>(textState.layer) * 0x9E3779B97F4A7C15ull;
+    return hash;
+}
+
+/// @brief 同じ単位にまとめられるかどうか
+bool IsSameBatch(const TextBatcher::Batch &batch, const TextBatcher::TextState &textState, const TextureHandle &textureHandle) {
+    return batch.textureHandle == textureHandle && batch.pipeLineName == textState.pipeLineName &&
+        batch.isUseCamera == textState.isUseCamera && batch.layer == textState.layer &&
+        std::memcmp(&batch.material, &textState.material, sizeof(Material)) == 0;
+}
+
+/// @brief 行の左上を原点にした文字の四角形の頂点への変換
+TextBatcher::QuadTransform MakeLineTransform(const TextBatcher::QuadTransform &transform, float x, float y) {
+    TextBatcher::QuadTransform lineTransform = transform;
+    lineTransform.origin.x += transform.axisX.x * x + transform.axisY.x * y;
+    lineTransform.origin.y += transform.axisX.y * x + transform.axisY.y * y;
+    lineTransform.origin.z += transform.axisX.z * x + transform.axisY.z * y;
+    return lineTransform;
+}
+
+/// @brief 頂点の書き込み。ベクトルの代入演算子は関数呼び出しになるので、要素ごとに書き込む
+inline void SetVertex(VertexData &vertex, float x, float y, float z, float u, float v) {
+    vertex.position.x = x;
+    vertex.position.y = y;
+    vertex.position.z = z;
+    vertex.position.w = 1.0f;
+    vertex.texCoord.x = u;
+    vertex.texCoord.y = v;
+    vertex.normal.x = 0.0f;
+    vertex.normal.y = 0.0f;
+    vertex.normal.z = -1.0f;
+}
+
+} // namespace
+
+void TextBatcher::Clear(std::pmr::memory_resource *resource) {
+    MyStd::ResetPmrVector(texts_, resource);
+    MyStd::ResetPmrVector(pageBatchIndices_, resource);
+    MyStd::ResetPmrVector(nextBatchIndices_, resource);
+    MyStd::ResetPmrVector(batchCursors_, resource);
+    batches_.clear();
+    batchIndexMap_.clear();
+    // 頂点は Build で上書きするので、要素を作り直さないようサイズは残す
+    glyphCount_ = 0;
+}
+
+void TextBatcher::Add(const TextState &textState) {
+    if (textState.layout == nullptr || textState.fontData == nullptr || textState.fontData->pages.empty()) {
+        return;
+    }
+    const auto &glyphs = textState.layout->GetGlyphs();
+    const uint32_t glyphCount = static_cast<uint32_t>(std::min<size_t>(glyphs.size(), textState.maxGlyphCount));
+    if (glyphCount == 0) {
+        return;
+    }
+
+    TextEntry &entry = texts_.emplace_back();
+    entry.layout = textState.layout;
+    entry.glyphCount = glyphCount;
+    // 行ベクトルに掛ける行列なので、1行目がX軸、2行目がY軸、4行目が平行移動
+    const auto &m = textState.worldMatrix.m;
+    entry.transform.axisX = { m[0][0], m[0][1], m[0][2] };
+    entry.transform.axisY = { m[1][0], m[1][1], m[1][2] };
+    entry.transform.origin = { m[3][0], m[3][1], m[3][2] };
+
+    // ページごとにまとめる単位を決める
+    const auto &pages = textState.fontData->pages;
+    entry.pageBatchBegin = static_cast<uint32_t>(pageBatchIndices_.size());
+    entry.pageCount = static_cast<uint32_t>(pages.size());
+    for (const auto &page : pages) {
+        pageBatchIndices_.push_back(FindOrAddBatch(textState, page.textureHandle));
+    }
+
+    // まとめる単位ごとの文字数を数える
+    if (entry.pageCount == 1) {
+        batches_[pageBatchIndices_[entry.pageBatchBegin]].glyphCount += glyphCount;
+    } else {
+        for (uint32_t i = 0; i < glyphCount; ++i) {
+            const uint32_t page = std::min(static_cast<uint32_t>(glyphs[i].page), entry.pageCount - 1);
+            ++batches_[pageBatchIndices_[entry.pageBatchBegin + page]].glyphCount;
+        }
+    }
+    glyphCount_ += glyphCount;
+}
+
+void TextBatcher::Build() {
+    // まとめる単位ごとに頂点が連続して並ぶよう、書き込み位置を決める
+    batchCursors_.resize(batches_.size());
+    uint32_t vertexOffset = 0;
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        batches_[i].vertexOffset = vertexOffset;
+        batchCursors_[i] = vertexOffset;
+        vertexOffset += batches_[i].glyphCount * 4;
+    }
+    vertices_.resize(vertexOffset);
+
+    for (const auto &entry : texts_) {
+        const TextLayout &layout = *entry.layout;
+        const auto &glyphs = layout.GetGlyphs();
+        const auto &lines = layout.GetLines();
+        for (size_t lineIndex = 0; lineIndex < lines.size() && lines[lineIndex].beginGlyph < entry.glyphCount; ++lineIndex) {
+            const auto &line = lines[lineIndex];
+            const size_t glyphEnd = std::min<size_t>(line.endGlyph, entry.glyphCount);
+            if (line.beginGlyph >= glyphEnd) {
+                continue;
+            }
+            float originX = 0.0f;
+            float originY = 0.0f;
+            layout.GetLineOrigin(lineIndex, originX, originY);
+            const QuadTransform lineTransform = MakeLineTransform(entry.transform, originX, originY);
+
+            if (entry.pageCount == 1) {
+                // 1ページのフォントは行の文字をまとめて書き込む
+                uint32_t &cursor = batchCursors_[pageBatchIndices_[entry.pageBatchBegin]];
+                const size_t count = glyphEnd - line.beginGlyph;
+                BuildQuads(&glyphs[line.beginGlyph], count, lineTransform, &vertices_[cursor]);
+                cursor += static_cast<uint32_t>(count * 4);
+            } else {
+                // 複数ページのフォントは文字ごとにページの単位へ振り分ける
+                for (size_t i = line.beginGlyph; i < glyphEnd; ++i) {
+                    const uint32_t page = std::min(static_cast<uint32_t>(glyphs[i].page), entry.pageCount - 1);
+                    uint32_t &cursor = batchCursors_[pageBatchIndices_[entry.pageBatchBegin + page]];
+                    BuildQuads(&glyphs[i], 1, lineTransform, &vertices_[cursor]);
+                    cursor += 4;
+                }
+            }
+        }
+    }
+}
+
+void TextBatcher::BuildQuads(const TextLayout::Glyph *glyphs, size_t glyphCount, const QuadTransform &transform,
+    VertexData *vertices) {
+    const Vector3 axisX = transform.axisX;
+    const Vector3 axisY = transform.axisY;
+    const Vector3 origin = transform.origin;
+    for (size_t i = 0; i < glyphCount; ++i) {
+        const TextLayout::Glyph &glyph = glyphs[i];
+        const float left = glyph.x;
+        const float top = glyph.y;
+        const float right = left + glyph.width;
+        const float bottom = top + glyph.height;
+
+        // 4頂点で共有する軸ごとの成分を先に計算する
+        const float leftX = origin.x + axisX.x * left;
+        const float leftY = origin.y + axisX.y * left;
+        const float leftZ = origin.z + axisX.z * left;
+        const float rightX = origin.x + axisX.x * right;
+        const float rightY = origin.y + axisX.y * right;
+        const float rightZ = origin.z + axisX.z * right;
+        const float topX = axisY.x * top;
+        const float topY = axisY.y * top;
+        const float topZ = axisY.z * top;
+        const float bottomX = axisY.x * bottom;
+        const float bottomY = axisY.y * bottom;
+        const float bottomZ = axisY.z * bottom;
+
+        VertexData *vertex = vertices + i * 4;
+        SetVertex(vertex[0], leftX + bottomX, leftY + bottomY, leftZ + bottomZ, glyph.uvLeft, glyph.uvBottom);
+        SetVertex(vertex[1], leftX + topX, leftY + topY, leftZ + topZ, glyph.uvLeft, glyph.uvTop);
+        SetVertex(vertex[2], rightX + bottomX, rightY + bottomY, rightZ + bottomZ, glyph.uvRight, glyph.uvBottom);
+        SetVertex(vertex[3], rightX + topX, rightY + topY, rightZ + topZ, glyph.uvRight, glyph.uvTop);
+    }
+}
+
+uint32_t TextBatcher::FindOrAddBatch(const TextState &textState, const TextureHandle &textureHandle) {
+    // 直前のテキストと同じ見た目なら探さずに済ませる
+    if (!batches_.empty() && IsSameBatch(batches_.back(), textState, textureHandle)) {
+        return static_cast<uint32_t>(batches_.size() - 1);
+    }
+
+    const uint64_t hash = HashBatchKey(textState, textureHandle);
+    auto it = batchIndexMap_.find(hash);
+    if (it != batchIndexMap_.end()) {
+        uint32_t index = it->second;
+        while (true) {
+            if (IsSameBatch(batches_[index], textState, textureHandle)) {
+                return index;
+            }
+            if (nextBatchIndices_[index] == kNoBatch) {
+                break;
+            }
+            index = nextBatchIndices_[index];
+        }
+        // ハッシュ値が衝突したので、同じハッシュ値の最後の単位につなぐ
+        nextBatchIndices_[index] = static_cast<uint32_t>(batches_.size());
+    } else {
+        batchIndexMap_.emplace(hash, static_cast<uint32_t>(batches_.size()));
+    }
+
+    Batch &batch = batches_.emplace_back();
+    batch.pipeLineName = textState.pipeLineName;
+    batch.isUseCamera = textState.isUseCamera;
+    batch.layer = textState.layer;
+    batch.textureHandle = textureHandle;
+    batch.material = textState.material;
+    nextBatchIndices_.push_back(kNoBatch);
+    return static_cast<uint32_t>(batches_.size() - 1);
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
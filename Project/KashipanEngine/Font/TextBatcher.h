@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include <FlatHashMap.h>
+#include "Math/Matrix4x4.h"
+#include "Math/Vector3.h"
+#include "Common/Material.h"
+#include "Common/StringId.h"
+#include "Common/VertexData.h"
+#include "Font/FontStructs.h"
+#include "Font/TextLayout.h"
+
+namespace KashipanEngine {
+
+/// @brief 1フレームに描画するすべてのテキストの文字の四角形を集めて、
+/// 同じパイプライン・マテリアル・テクスチャ(フォントのページ)ごとに1つの頂点配列にまとめるクラス。
+/// GPUは使わないので、描画せずに頂点の生成だけ計測・確認できる
+class TextBatcher {
+public:
+    /// @brief 描画するテキストの情報
+    struct TextState {
+        /// @brief レイアウトへのポインタ(Build まで生存していること)
+        const TextLayout *layout = nullptr;
+        /// @brief フォントデータへのポインタ(ページのテクスチャの参照用)
+        const FontData *fontData = nullptr;
+        /// @brief ワールド行列
+        Matrix4x4 worldMatrix = Matrix4x4::Identity();
+        /// @brief マテリアル
+        Material material;
+        /// @brief 表示する最大の文字数
+        uint32_t maxGlyphCount = 0;
+        /// @brief 使用するレンダリングパイプライン名
+        StringId pipeLineName = "Object3d.Solid.BlendNormal";
+        /// @brief カメラを使用するかどうか
+        bool isUseCamera = false;
+        /// @brief 描画順の区切り。layer が違うテキストは同じ単位にまとめない。
+        /// Renderer が前に追加された2Dオブジェクトの数を設定し、間に描画するオブジェクトとの前後関係を保つ
+        uint32_t layer = 0;
+    };
+
+    /// @brief 1回の描画でまとめて描画する文字の範囲
+    struct Batch {
+        /// @brief 使用するレンダリングパイプライン名
+        StringId pipeLineName;
+        /// @brief カメラを使用するかどうか
+        bool isUseCamera = false;
+        /// @brief 描画順の区切り
+        uint32_t layer = 0;
+        /// @brief テクスチャのハンドル
+        TextureHandle textureHandle;
+        /// @brief マテリアル
+        Material material;
+        /// @brief 最初の頂点のインデックス
+        uint32_t vertexOffset = 0;
+        /// @brief 文字数(頂点数は4倍、インデックス数は6倍)
+        uint32_t glyphCount = 0;
+    };
+
+    /// @brief 文字の四角形の頂点への変換。位置 = origin + x * axisX + y * axisY
+    struct QuadTransform {
+        Vector3 axisX;
+        Vector3 axisY;
+        Vector3 origin;
+    };
+
+    /// @brief 集めたテキストと頂点をクリアする(確保した領域は使い回す)
+    /// @param resource 次に集めるテキストの作業用の配列を確保するリソース。
+    /// フレーム単位のアロケータを渡すと、作業用の配列はそのフレームの間だけ使う領域から確保する
+    void Clear(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /// @brief 描画するテキストを追加する
+    /// @param textState 描画するテキストの情報
+    void Add(const TextState &textState);
+
+    /// @brief 追加したテキストの頂点をまとめて生成する
+    void Build();
+
+    /// @brief 生成した頂点(文字ごとに4頂点。まとめる単位ごとに連続して並ぶ)
+    const std::vector<VertexData> &GetVertices() const { return vertices_; }
+    /// @brief まとめる単位(最初に追加された順。layer を追加順に増やせば layer の小さい順に並ぶ)
+    const std::vector<Batch> &GetBatches() const { return batches_; }
+    /// @brief 追加したテキストの数
+    size_t GetTextCount() const { return texts_.size(); }
+    /// @brief 追加した文字の数
+    size_t GetGlyphCount() const { return glyphCount_; }
+
+    /// @brief 文字の四角形の頂点を生成する。分岐の無い連続したループなので、コンパイラがベクトル化しやすい
+    /// @param glyphs 配置した文字の配列
+    /// @param glyphCount 文字数
+    /// @param transform 頂点への変換
+    /// @param vertices 頂点の書き込み先(glyphCount * 4 個)
+    static void BuildQuads(const TextLayout::Glyph *glyphs, size_t glyphCount, const QuadTransform &transform,
+        VertexData *vertices);
+
+private:
+    /// @brief 追加したテキスト
+    struct TextEntry {
+        const TextLayout *layout = nullptr;
+        QuadTransform transform;
+        // 表示する文字数
+        uint32_t glyphCount = 0;
+        // ページごとのまとめる単位のインデックスの、pageBatchIndices_ での開始位置
+        uint32_t pageBatchBegin = 0;
+        // ページ数
+        uint32_t pageCount = 0;
+    };
+
+    /// @brief まとめる単位を探す。無ければ追加する
+    /// @return まとめる単位のインデックス
+    uint32_t FindOrAddBatch(const TextState &textState, const TextureHandle &textureHandle);
+
+    // 1フレームだけ使う作業用の配列は Clear で渡されたリソースから確保する
+    std::pmr::vector<TextEntry> texts_;
+    std::pmr::vector<uint32_t> pageBatchIndices_;
+    std::vector<Batch> batches_;
+    // まとめる単位のキーのハッシュ値から、同じハッシュ値の最初の単位のインデックス
+    MyStd::FlatHashMap<uint64_t, uint32_t> batchIndexMap_;
+    // 同じハッシュ値の次の単位のインデックス(無ければ UINT32_MAX)
+    std::pmr::vector<uint32_t> nextBatchIndices_;
+    // 頂点の書き込み位置(まとめる単位ごと)
+    std::pmr::vector<uint32_t> batchCursors_;
+    std::vector<VertexData> vertices_;
+    size_t glyphCount_ = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <iterator>
+#include <utf8.h>
+#include "TextLayout.h"
+
+namespace KashipanEngine {
+
+namespace {
+
+// 折り返す位置が無いことを表すインデックス
+constexpr size_t kNoBreak = static_cast<size_t>(-1);
+
+/// @brief UTF8の2バイト目以降のバイトかどうか
+bool IsContinuationByte(char8_t c) {
+    return (static_cast<uint8_t>(c) & 0xC0) == 0x80;
+}
+
+/// @brief 範囲内のコードポイントの数(2バイト目以降のバイト以外を数える)
+size_t CountCodePoints(const char8_t *begin, const char8_t *end) {
+    size_t count = 0;
+    for (const char8_t *it = begin; it != end; ++it) {
+        count += IsContinuationByte(*it) ? 0 : 1;
+    }
+    return count;
+}
+
+/// @brief 空白かどうか(空白の後ろで折り返せる)
+bool IsSpace(int codePoint) {
+    return codePoint == ' ' || codePoint == '\t' || codePoint == 0x3000;
+}
+
+/// @brief 単語の区切りが無くても前後で折り返せる文字(かな・漢字・ハングル・全角文字)かどうか
+bool IsBreakableCharacter(int codePoint) {
+    return (codePoint >= 0x3000 && codePoint <= 0x30FF) ||
+        (codePoint >= 0x3400 && codePoint <= 0x4DBF) ||
+        (codePoint >= 0x4E00 && codePoint <= 0x9FFF) ||
+        (codePoint >= 0xAC00 && codePoint <= 0xD7AF) ||
+        (codePoint >= 0xF900 && codePoint <= 0xFAFF) ||
+        (codePoint >= 0xFF00 && codePoint <= 0xFFEF);
+}
+
+/// @brief 行の先頭に置かない文字(句読点・閉じ括弧・長音など)かどうか
+bool IsNoBreakBefore(int codePoint) {
+    switch (codePoint) {
+        case 0x3001: // 、
+        case 0x3002: // 。
+        case 0xFF0C: // ，
+        case 0xFF0E: // ．
+        case 0x300D: // 」
+        case 0x300F: // 』
+        case 0x3011: // 】
+        case 0xFF09: // ）
+        case 0xFF01: // ！
+        case 0xFF1F: // ？
+        case 0x30FC: // ー
+        case 0x3041: case 0x3043: case 0x3045: case 0x3047: case 0x3049: // ぁぃぅぇぉ
+        case 0x3063: case 0x3083: case 0x3085: case 0x3087: // っゃゅょ
+        case 0x30A1: case 0x30A3: case 0x30A5: case 0x30A7: case 0x30A9: // ァィゥェォ
+        case 0x30C3: case 0x30E3: case 0x30E5: case 0x30E7: // ッャュョ
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief vector の [first, last) を source で置き換える(後ろの要素の移動は1回で済ませる)
+template<typename T>
+void ReplaceRange(std::vector<T> &target, size_t first, size_t last, const std::vector<T> &source) {
+    const size_t oldCount = last - first;
+    const size_t commonCount = std::min(oldCount, source.size());
+    std::copy(source.begin(), source.begin() + commonCount, target.begin() + first);
+    if (source.size() > oldCount) {
+        target.insert(target.begin() + last, source.begin() + commonCount, source.end());
+    } else {
+        target.erase(target.begin() + first + commonCount, target.begin() + last);
+    }
+}
+
+} // namespace
+
+void TextLayout::SetFont(const FontData *fontData) {
+    if (fontData_ == fontData) {
+        return;
+    }
+    fontData_ = fontData;
+    isInvalidated_ = true;
+    Rebuild();
+}
+
+void TextLayout::SetMaxWidth(float maxWidth) {
+    maxWidth = std::max(maxWidth, 0.0f);
+    if (maxWidth_ == maxWidth) {
+        return;
+    }
+    maxWidth_ = maxWidth;
+    isInvalidated_ = true;
+    Rebuild();
+}
+
+void TextLayout::SetAlign(TextAlignX alignX, TextAlignY alignY) {
+    if (alignX_ == alignX && alignY_ == alignY) {
+        return;
+    }
+    alignX_ = alignX;
+    alignY_ = alignY;
+    // 配置は揃え方に依らないので、計算し直さない(表示位置は GetLineOrigin で反映する)
+}
+
+void TextLayout::SetText(const std::u8string &text) {
+    if (isInvalidated_) {
+        text_ = text;
+        Rebuild();
+        return;
+    }
+    if (text_ == text) {
+        return;
+    }
+
+    // 前後の同じ部分を探す(コードポイントの途中で区切らないよう、文字の先頭まで戻す)
+    const size_t oldSize = text_.size();
+    const size_t newSize = text.size();
+    size_t prefix = static_cast<size_t>(
+        std::mismatch(text_.begin(), text_.end(), text.begin(), text.end()).first - text_.begin());
+    while (prefix > 0 && ((prefix < oldSize && IsContinuationByte(text_[prefix])) ||
+        (prefix < newSize && IsContinuationByte(text[prefix])))) {
+        --prefix;
+    }
+    const size_t maxSuffix = std::min(oldSize, newSize) - prefix;
+    size_t suffix = 0;
+    while (suffix < maxSuffix && text_[oldSize - suffix - 1] == text[newSize - suffix - 1]) {
+        ++suffix;
+    }
+    while (suffix > 0 && (IsContinuationByte(text_[oldSize - suffix]) || IsContinuationByte(text[newSize - suffix]))) {
+        --suffix;
+    }
+
+    // 変わった部分だけデコードし、前後は前回のコードポイントを使う
+    const size_t prefixCodePoints = CountCodePoints(text.data(), text.data() + prefix);
+    const size_t suffixCodePoints = CountCodePoints(text.data() + newSize - suffix, text.data() + newSize);
+    const size_t oldChangeEnd = codePoints_.size() - suffixCodePoints;
+    std::vector<int> changedCodePoints;
+    utf8::utf8to32(text.begin() + prefix, text.begin() + (newSize - suffix),
+        std::back_inserter(changedCodePoints));
+    codePoints_.erase(codePoints_.begin() + prefixCodePoints, codePoints_.begin() + oldChangeEnd);
+    codePoints_.insert(codePoints_.begin() + prefixCodePoints, changedCodePoints.begin(), changedCodePoints.end());
+    text_ = text;
+
+    Relayout(prefixCodePoints, prefixCodePoints + changedCodePoints.size(), oldChangeEnd);
+}
+
+void TextLayout::Rebuild() {
+    codePoints_.clear();
+    utf8::utf8to32(text_.begin(), text_.end(), std::back_inserter(codePoints_));
+    glyphs_.clear();
+    lines_.clear();
+    if (fontData_ == nullptr) {
+        // フォントが設定されたら計算する
+        isInvalidated_ = true;
+        return;
+    }
+    isInvalidated_ = false;
+
+    size_t codePointIndex = 0;
+    bool isWrapped = false;
+    for (;;) {
+        bool isEnded = false;
+        const size_t nextCodePointIndex = LayoutLine(codePointIndex, isWrapped, 0, glyphs_, lines_, isEnded);
+        if (isEnded) {
+            break;
+        }
+        isWrapped = codePoints_[nextCodePointIndex - 1] != '\n';
+        codePointIndex = nextCodePointIndex;
+    }
+}
+
+void TextLayout::Relayout(size_t changeBegin, size_t newChangeEnd, size_t oldChangeEnd) {
+    // 変わった文字を含む行を探す。折り返して始まった行なら、前の行の折り返し位置も変わりうる。
+    // 前の行が詰まると更に前の行にも入りうるので、折り返しでない行(段落の最初の行)まで戻る
+    auto lineIt = std::upper_bound(lines_.begin(), lines_.end(), changeBegin,
+        [](size_t index, const Line &line) { return index < line.beginCodePoint; });
+    size_t startLine = lineIt == lines_.begin() ? 0 : static_cast<size_t>(lineIt - lines_.begin()) - 1;
+    while (startLine > 0 && lines_[startLine].isWrapped) {
+        --startLine;
+    }
+    const size_t startGlyph = lines_[startLine].beginGlyph;
+
+    // 前の文字列でのインデックスとのずれ
+    const ptrdiff_t codePointDelta = static_cast<ptrdiff_t>(newChangeEnd) - static_cast<ptrdiff_t>(oldChangeEnd);
+
+    // 計算し直した行は別の領域に並べ、最後に前回の結果の該当範囲と置き換える
+    newGlyphs_.clear();
+    newLines_.clear();
+    size_t codePointIndex = lines_[startLine].beginCodePoint;
+    bool isWrapped = lines_[startLine].isWrapped;
+    size_t reusedLine = lines_.size();
+    for (;;) {
+        // 変わった部分より後ろで、前回も同じ文字から始まる行があれば、そこから先は前回の結果を使う
+        if (codePointIndex >= newChangeEnd && !newLines_.empty()) {
+            const size_t oldCodePointIndex = static_cast<size_t>(static_cast<ptrdiff_t>(codePointIndex) - codePointDelta);
+            auto oldIt = std::lower_bound(lines_.begin() + startLine, lines_.end(), oldCodePointIndex,
+                [](const Line &line, size_t index) { return line.beginCodePoint < index; });
+            if (oldIt != lines_.end() && oldIt->beginCodePoint == oldCodePointIndex) {
+                reusedLine = static_cast<size_t>(oldIt - lines_.begin());
+                break;
+            }
+        }
+
+        bool isEnded = false;
+        const size_t nextCodePointIndex = LayoutLine(codePointIndex, isWrapped, startGlyph, newGlyphs_, newLines_, isEnded);
+        if (isEnded) {
+            break;
+        }
+        isWrapped = codePoints_[nextCodePointIndex - 1] != '\n';
+        codePointIndex = nextCodePointIndex;
+    }
+
+    if (reusedLine < lines_.size()) {
+        // 使い回す行のインデックスをずらす。最初の行の始まり方は直前の行の終わり方で決まる
+        const size_t oldReusedGlyph = lines_[reusedLine].beginGlyph;
+        const size_t reusedGlyphBegin = startGlyph + newGlyphs_.size();
+        const ptrdiff_t glyphDelta = static_cast<ptrdiff_t>(reusedGlyphBegin) - static_cast<ptrdiff_t>(oldReusedGlyph);
+        for (size_t i = reusedLine; i < lines_.size(); ++i) {
+            Line &line = lines_[i];
+            line.beginCodePoint = static_cast<size_t>(static_cast<ptrdiff_t>(line.beginCodePoint) + codePointDelta);
+            line.endCodePoint = static_cast<size_t>(static_cast<ptrdiff_t>(line.endCodePoint) + codePointDelta);
+            line.beginGlyph = static_cast<size_t>(static_cast<ptrdiff_t>(line.beginGlyph) + glyphDelta);
+            line.endGlyph = static_cast<size_t>(static_cast<ptrdiff_t>(line.endGlyph) + glyphDelta);
+        }
+        lines_[reusedLine].isWrapped = isWrapped;
+        ReplaceRange(glyphs_, startGlyph, oldReusedGlyph, newGlyphs_);
+    } else {
+        ReplaceRange(glyphs_, startGlyph, glyphs_.size(), newGlyphs_);
+    }
+    ReplaceRange(lines_, startLine, reusedLine, newLines_);
+}
+
+size_t TextLayout::LayoutLine(size_t codePointIndex, bool isWrapped, size_t glyphOffset,
+    std::vector<Glyph> &glyphs, std::vector<Line> &lines, bool &isEnded) const {
+    Line line;
+    line.beginCodePoint = codePointIndex;
+    line.beginGlyph = glyphOffset + glyphs.size();
+    line.isWrapped = isWrapped;
+    const size_t lineGlyphBegin = glyphs.size();
+
+    const float scaleW = fontData_->common.scaleW;
+    const float scaleH = fontData_->common.scaleH;
+    // フォントに無い文字の代わりに表示する文字
+    const CharInfo *fallbackCharInfo = fontData_->FindChar('?');
+
+    float cursorX = 0.0f;
+    int prevCodePoint = -1;
+    // 折り返せる位置(次の行の最初の文字・その時点の文字数・行の幅)
+    size_t breakCodePoint = kNoBreak;
+    size_t breakGlyph = 0;
+    float breakWidth = 0.0f;
+
+    const size_t codePointCount = codePoints_.size();
+    size_t nextCodePointIndex = codePointCount;
+    isEnded = true;
+    for (size_t i = codePointIndex; i < codePointCount; ++i) {
+        const int codePoint = codePoints_[i];
+        if (codePoint == '\n') {
+            nextCodePointIndex = i + 1;
+            isEnded = false;
+            break;
+        }
+
+        // フォントに無い文字は代わりの文字にし、それも無ければ飛ばす
+        const CharInfo *charInfo = fontData_->FindChar(codePoint);
+        if (charInfo == nullptr) {
+            charInfo = fallbackCharInfo;
+            if (charInfo == nullptr) {
+                continue;
+            }
+        }
+
+        const bool isSpace = IsSpace(codePoint);
+        const bool isBreakable = IsBreakableCharacter(codePoint);
+        // かな・漢字などはその前で折り返せる
+        if (isBreakable && i > codePointIndex && !IsNoBreakBefore(codePoint)) {
+            breakCodePoint = i;
+            breakGlyph = glyphs.size();
+            breakWidth = cursorX;
+        }
+
+        const float penX = cursorX + (prevCodePoint >= 0 ? fontData_->GetKerning(prevCodePoint, charInfo->id) : 0.0f);
+        // 幅を超えたら折り返す(空白は行末にはみ出してもよい)
+        if (maxWidth_ > 0.0f && !isSpace && glyphs.size() > lineGlyphBegin &&
+            penX + charInfo->xOffset + charInfo->width > maxWidth_) {
+            if (breakCodePoint != kNoBreak) {
+                glyphs.resize(breakGlyph);
+                cursorX = breakWidth;
+                nextCodePointIndex = breakCodePoint;
+            } else {
+                // 折り返せる位置が無ければ文字の途中で折り返す
+                nextCodePointIndex = i;
+            }
+            isEnded = false;
+            break;
+        }
+
+        Glyph &glyph = glyphs.emplace_back();
+        glyph.codePoint = charInfo->id;
+        glyph.page = charInfo->page;
+        glyph.x = penX + charInfo->xOffset;
+        glyph.y = charInfo->yOffset;
+        glyph.width = charInfo->width;
+        glyph.height = charInfo->height;
+        glyph.uvLeft = charInfo->x / scaleW;
+        glyph.uvTop = charInfo->y / scaleH;
+        glyph.uvRight = (charInfo->x + charInfo->width) / scaleW;
+        glyph.uvBottom = (charInfo->y + charInfo->height) / scaleH;
+        cursorX = penX + charInfo->xAdvance;
+        prevCodePoint = charInfo->id;
+
+        if (isSpace) {
+            // 空白の後ろで折り返せる(空白は行の幅に含めない)
+            breakCodePoint = i + 1;
+            breakGlyph = glyphs.size();
+            breakWidth = penX;
+        } else if (isBreakable && !(i + 1 < codePointCount && IsNoBreakBefore(codePoints_[i + 1]))) {
+            breakCodePoint = i + 1;
+            breakGlyph = glyphs.size();
+            breakWidth = cursorX;
+        }
+    }
+
+    line.endCodePoint = nextCodePointIndex;
+    line.endGlyph = glyphOffset + glyphs.size();
+    line.width = cursorX;
+    lines.push_back(line);
+    return nextCodePointIndex;
+}
+
+void TextLayout::GetLineOrigin(size_t lineIndex, float &x, float &y) const {
+    x = 0.0f;
+    if (lineIndex < lines_.size()) {
+        if (alignX_ == TextAlignX::Center) {
+            x = -lines_[lineIndex].width / 2.0f;
+        } else if (alignX_ == TextAlignX::Right) {
+            x = -lines_[lineIndex].width;
+        }
+    }
+    const float lineHeight = GetLineHeight();
+    const float totalHeight = lineHeight * static_cast<float>(lines_.size());
+    y = lineHeight * static_cast<float>(lineIndex);
+    if (alignY_ == TextAlignY::Center) {
+        y -= totalHeight / 2.0f;
+    } else if (alignY_ == TextAlignY::Bottom) {
+        y -= totalHeight;
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Font/FontStructs.h"
+
+namespace KashipanEngine {
+
+enum class TextAlignX {
+    Left,   ///< 左揃え
+    Center, ///< 中央揃え
+    Right,  ///< 右揃え
+};
+
+enum class TextAlignY {
+    Top,    ///< 上揃え
+    Center, ///< 中央揃え
+    Bottom, ///< 下揃え
+};
+
+/// @brief 文字列のレイアウト(文字の配置)を計算するクラス。GPUは使わない。
+/// 行ごとの文字の並びと幅を保持しておき、文字列が変わったときは最初に変わった文字を含む段落の最初の行から計算し直す。
+/// 変わった部分より後ろで行の始まりが前回と揃ったら、それ以降の行は前回の結果をそのまま使う。
+/// 使い回すのはレイアウトの結果まで。文字の四角形の頂点は TextBatcher が毎フレームすべて生成し直す
+class TextLayout {
+public:
+    /// @brief 配置した文字。座標は行の左上からの位置
+    struct Glyph {
+        // 表示する文字ID(フォントに無い文字は代わりの文字のID)
+        int codePoint = 0;
+        // 文字が属するフォントのページ番号
+        int page = 0;
+        // 左上の位置
+        float x = 0.0f;
+        float y = 0.0f;
+        // 大きさ
+        float width = 0.0f;
+        float height = 0.0f;
+        // テクスチャ座標
+        float uvLeft = 0.0f;
+        float uvTop = 0.0f;
+        float uvRight = 0.0f;
+        float uvBottom = 0.0f;
+
+        bool operator==(const Glyph &) const = default;
+    };
+
+    /// @brief 1行の情報
+    struct Line {
+        // 行の最初の文字のインデックス(コードポイント単位)
+        size_t beginCodePoint = 0;
+        // 行の最後の文字の次のインデックス(改行文字を含む)
+        size_t endCodePoint = 0;
+        // 行の最初の配置した文字のインデックス
+        size_t beginGlyph = 0;
+        // 行の最後の配置した文字の次のインデックス
+        size_t endGlyph = 0;
+        // 行の幅(行末の空白は含まない)
+        float width = 0.0f;
+        // 前の行から折り返して始まった行かどうか
+        bool isWrapped = false;
+
+        bool operator==(const Line &) const = default;
+    };
+
+    /// @brief フォントの設定。変わった場合はすべて計算し直す
+    /// @param fontData フォントデータ(TextLayout より長く生存していること)
+    void SetFont(const FontData *fontData);
+
+    /// @brief 折り返す幅の設定。変わった場合はすべて計算し直す
+    /// @param maxWidth 折り返す幅。0以下なら改行文字以外では折り返さない
+    void SetMaxWidth(float maxWidth);
+
+    /// @brief 揃え方の設定
+    /// @param alignX 水平方向の揃え方
+    /// @param alignY 垂直方向の揃え方
+    void SetAlign(TextAlignX alignX, TextAlignY alignY);
+
+    /// @brief 文字列の設定(UTF8)。前回の文字列と比べて変わった行だけ計算し直す
+    /// @param text 文字列
+    void SetText(const std::u8string &text);
+
+    /// @brief 前回の結果を使わずにすべて計算し直す
+    void Rebuild();
+
+    /// @brief 文字列の取得
+    const std::u8string &GetText() const { return text_; }
+    /// @brief 文字列のコードポイント
+    const std::vector<int> &GetCodePoints() const { return codePoints_; }
+    /// @brief 配置した文字
+    const std::vector<Glyph> &GetGlyphs() const { return glyphs_; }
+    /// @brief 行の情報(文字列が空でも1行ある)
+    const std::vector<Line> &GetLines() const { return lines_; }
+    /// @brief フォントデータ
+    const FontData *GetFont() const { return fontData_; }
+    /// @brief 水平方向の揃え方
+    TextAlignX GetAlignX() const { return alignX_; }
+    /// @brief 垂直方向の揃え方
+    TextAlignY GetAlignY() const { return alignY_; }
+
+    /// @brief 行の高さ
+    float GetLineHeight() const { return fontData_ ? fontData_->common.lineHeight : 0.0f; }
+    /// @brief 揃え方を反映した行の左上の位置
+    /// @param lineIndex 行のインデックス
+    /// @param x X座標の格納先
+    /// @param y Y座標の格納先
+    void GetLineOrigin(size_t lineIndex, float &x, float &y) const;
+
+    /// @brief 同じレイアウトかどうか(部分的な計算と全体の計算の結果の確認用)
+    bool IsSameLayout(const TextLayout &other) const {
+        return codePoints_ == other.codePoints_ && glyphs_ == other.glyphs_ && lines_ == other.lines_;
+    }
+
+private:
+    /// @brief codePointIndex から1行を配置して lines と glyphs の末尾に追加する
+    /// @param isWrapped 前の行から折り返して始まった行かどうか
+    /// @param glyphOffset glyphs の最初の要素の文字のインデックス
+    /// @param glyphs 配置した文字の追加先
+    /// @param lines 行の情報の追加先
+    /// @param isEnded 文字列の最後まで配置したかどうかの格納先
+    /// @return 次の行の最初の文字のインデックス
+    size_t LayoutLine(size_t codePointIndex, bool isWrapped, size_t glyphOffset,
+        std::vector<Glyph> &glyphs, std::vector<Line> &lines, bool &isEnded) const;
+
+    /// @brief 文字列が変わった範囲から計算し直す
+    /// @param changeBegin 変わった最初の文字のインデックス
+    /// @param newChangeEnd 新しい文字列で変わった部分の次のインデックス
+    /// @param oldChangeEnd 前の文字列で変わった部分の次のインデックス
+    void Relayout(size_t changeBegin, size_t newChangeEnd, size_t oldChangeEnd);
+
+    const FontData *fontData_ = nullptr;
+    float maxWidth_ = 0.0f;
+    TextAlignX alignX_ = TextAlignX::Left;
+    TextAlignY alignY_ = TextAlignY::Top;
+
+    std::u8string text_;
+    std::vector<int> codePoints_;
+    std::vector<Glyph> glyphs_;
+    std::vector<Line> lines_;
+    // 次の SetText ですべて計算し直すかどうか
+    bool isInvalidated_ = true;
+
+    // 計算し直した行を並べておく領域(確保し直さないよう使い回す)
+    std::vector<Glyph> newGlyphs_;
+    std::vector<Line> newLines_;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -4,7 +4,15 @@
 #include <vector>
 #include <memory>
 #include <thread>
+#include <chrono>
 #include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <utility>
+#include <TaskGraph.h>
+#include <FramePacer.h>
+#include <FixedTimestep.h>
+#include <FrameTimeStats.h>
 
 #include "Common/ConvertString.h"
 #include "Common/VertexData.h"
@@ -17,17 +25,24 @@
 #include "Common/Descriptors/UAV.h"
 #include "Common/SceneBase.h"
 #include "Common/Random.h"
+#include "Common/FrameAllocator.h"
+#include "Common/JsoncLoader.h"
+#include "Common/Profiler.h"
+#include "Common/FrameStatistics.h"
+#include "Common/MemoryTracker.h"
 #include "Base/WinApp.h"
 #include "Base/DirectXCommon.h"
 #include "Base/Texture.h"
 #include "Base/CrashHandler.h"
 #include "Base/ResourceLeakChecker.h"
 #include "Base/Renderer.h"
+#include "Base/SceneManager.h"
 #include "Base/Input.h"
 #include "Base/Sound.h"
 #include "Base/ScreenBuffer.h"
 #include "Base/PipeLines/PipeLines.h"
 #include "Base/PipeLineManager.h"
+#include "Font/FontRegistry.h"
 #ifdef USE_IMGUI
 #include "2d/ImGuiManager.h"
 #endif
@@ -73,25 +88,181 @@ std::unique_ptr<Sprite> sMainScreenSprite;
 
 // フレーム時間計算用変数
 int sFrameRate = 60;
-LONGLONG sFrequency = 0;
-LONGLONG sElapsedTime = 0;
-LONGLONG sLastTime = 0;
-LARGE_INTEGER sNowTime;
 unsigned int sCountFps = 0;
-float sElapsedSeconds = 0.0f;
 float sDeltaTime = 0.0f;
+// 実際に経過したフレーム時間(入力の再生中も統計にはこちらを使う)
+float sFrameTime = 0.0f;
+// フレームの開始時刻を揃えるためのクラス
+MyStd::FramePacer sFramePacer;
+// 高精度の待機用タイマー
+HANDLE sFrameTimer = nullptr;
+// リフレッシュレートを取得したモニター
+HMONITOR sMonitor = nullptr;
+// モニターのリフレッシュレート
+int sMonitorFrameRate = 60;
+// 固定ステップ更新用のアキュムレータ
+MyStd::FixedTimestep sFixedTimestep(60.0, 8);
+// このフレームで残っているティック数
+uint32_t sPendingTickCount = 0;
+// 固定ステップ更新中かどうか
+bool sIsInFixedUpdate = false;
+
+// 入力を最大速度で再生しているかどうか
+bool sIsMaxSpeedReplay = false;
+// 最大速度で再生したフレームの時間の統計
+MyStd::FrameTimeStats sReplayFrameTimeStats;
+
+// ヘッドレスモードかどうか
+bool sIsHeadless = false;
+// シーンのベンチマーク中かどうか
+bool sIsBenchmarking = false;
 
 // ゲーム終了フラグ
 bool sIsQuitGame = false;
 
+// フレーム単位のアロケータの1フレームあたりの容量
+const size_t kFrameAllocatorCapacity = 4 * 1024 * 1024;
+// タグごとのヒープの予算。超えるとフレームの終わりに警告する
+const std::pair<MemoryTag, size_t> kMemoryBudgets[] = {
+    { MemoryTag::kTexture, 256 * 1024 * 1024 },
+    { MemoryTag::kModel, 128 * 1024 * 1024 },
+    { MemoryTag::kFont, 32 * 1024 * 1024 },
+    { MemoryTag::kJson, 32 * 1024 * 1024 },
+    { MemoryTag::kPersistent, 32 * 1024 * 1024 },
+};
+// 初期化に使うワーカースレッドの最大数
+const size_t kMaxInitializeWorkerCount = 4;
+// フレームレートとして指定できる最低値
+const int kMinFrameRate = 24;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+/// @brief 待機用タイマーで指定時間眠る
+/// @param duration 眠る時間
+void SleepWithFrameTimer(MyStd::FramePacer::Clock::duration duration) {
+    // 100ナノ秒単位の負の値で相対時間を表す
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 100);
+    if (dueTime.QuadPart < 0 && SetWaitableTimer(sFrameTimer, &dueTime, 0, nullptr, nullptr, FALSE)) {
+        WaitForSingleObject(sFrameTimer, INFINITE);
+    }
+}
+
+/// @brief 指定のフレームレートとモニターのリフレッシュレートから待機間隔を決める
+void ApplyFrameRate() {
+    // 指定のフレームレートが最低値未満かモニターのFPS以上なら垂直同期に任せる
+    int frameRate = sFrameRate;
+    if (frameRate < kMinFrameRate || frameRate > sMonitorFrameRate) {
+        frameRate = sMonitorFrameRate;
+    }
+    // ヘッドレスモードや最大速度で再生中、ベンチマーク中は待たない
+    if (sIsHeadless || sIsMaxSpeedReplay || sIsBenchmarking) {
+        frameRate = 0;
+    }
+    sFramePacer.SetFrameRate(static_cast<double>(frameRate));
+}
+
+/// @brief 最大速度での入力の再生を終了し、フレーム時間の統計をログに出力する
+void FinishMaxSpeedReplay() {
+    sIsMaxSpeedReplay = false;
+    const auto summary = sReplayFrameTimeStats.GetSummary();
+    Log(std::format("Replay frame time: {} frames, avg {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+        summary.sampleCount, summary.average, summary.p50, summary.p95, summary.p99, summary.max));
+    sDxCommon->SetVSync(!sIsHeadless);
+    ApplyFrameRate();
+    sFramePacer.Reset();
+}
+
+/// @brief ウィンドウが別のモニターに移った時だけリフレッシュレートを取得し直す
+void UpdateMonitorFrameRate() {
+    HWND hwnd = sWinApp->GetWindowHandle();
+    HMONITOR monitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
+    if (monitor == sMonitor) {
+        return;
+    }
+    sMonitor = monitor;
+    HDC hdc = GetDC(hwnd);
+    int monitorFrameRate = GetDeviceCaps(hdc, VREFRESH);
+    ReleaseDC(hwnd, hdc);
+    // 0や1はハードウェア既定値を表すので使わない
+    if (monitorFrameRate > 1) {
+        sMonitorFrameRate = monitorFrameRate;
+    }
+    ApplyFrameRate();
+}
+
+/// @brief 初期化処理ごとの時間をログに出力
+/// @param graph 実行済みの初期化グラフ
+void LogInitializeReport(const MyStd::TaskGraph &graph) {
+    using TaskGraph = MyStd::TaskGraph;
+    Log(std::format("Initialize Report: {:.2f} ms", graph.GetTotalMilliseconds()));
+    double serialMilliseconds = 0.0;
+    for (const auto &result : graph.GetResults()) {
+        const char *state = "";
+        switch (result.state) {
+            case TaskGraph::TaskState::kSucceeded: state = "OK"; break;
+            case TaskGraph::TaskState::kFailed:    state = "FAILED"; break;
+            case TaskGraph::TaskState::kSkipped:   state = "SKIPPED"; break;
+            default:                               state = "PENDING"; break;
+        }
+        const char *thread = result.thread == TaskGraph::TaskThread::kMain ? "main" : "worker";
+        LogSimple(std::format("{:<16} [{:<6}] start {:8.2f} ms  time {:8.2f} ms  {}",
+            result.name, thread, result.beginMilliseconds, result.durationMilliseconds, state));
+        serialMilliseconds += result.durationMilliseconds;
+    }
+    LogSimple(std::format("Sum of task times: {:.2f} ms", serialMilliseconds));
+}
+
+/// @brief シーンのベンチマーク中は垂直同期とフレームの待機を止める
+/// @param isBenchmarking ベンチマーク中かどうか
+void SetBenchmarking(bool isBenchmarking) {
+    sIsBenchmarking = isBenchmarking;
+    sDxCommon->SetVSync(!sIsHeadless && !isBenchmarking);
+    ApplyFrameRate();
+    sFramePacer.Reset();
+}
+
+/// @brief エンジンのフレームでシーンのベンチマークを進める処理
+/// @param engine エンジン
+SceneBenchmarkFrameFunctions MakeSceneBenchmarkFrameFunctions(Engine *engine) {
+    SceneBenchmarkFrameFunctions frameFunctions;
+    frameFunctions.processMessage = [engine]() { return engine->ProccessMessage() != -1; };
+    frameFunctions.beginFrame = [engine]() {
+        engine->BeginFrame();
+        return engine->BeginGameLoop();
+    };
+    frameFunctions.beginFixedUpdate = [engine]() { return engine->BeginFixedUpdate(); };
+    frameFunctions.endFrame = [engine]() { engine->EndFrame(); };
+    frameFunctions.getDrawStats = []() { return sRenderer->GetDrawStats(); };
+    return frameFunctions;
+}
+
 } // namespace
 
 Engine::Engine(const char *title, int width, int height, bool enableDebugLayer,
-    const std::filesystem::path &projectDir) {
+    const std::filesystem::path &projectDir, bool isHeadless) {
+    sIsHeadless = isHeadless;
     // ログの初期化
     InitializeLog("Logs", projectDir.string());
     LogInsertPartition("\n================ Engine Initialize ===============\n");
 
+    // フレーム単位のアロケータの初期化
+    InitializeFrameAllocator(kFrameAllocatorCapacity);
+    // プロファイラにメインスレッドを登録する(記録用のバッファを確保する)
+    Profiler::RegisterThread("Main");
+    // フレーム時間の統計とヒッチの報告の出力先
+    InitializeFrameStatistics("Logs/Hitches");
+    // ここから終了処理までに確保して解放されなかったメモリを終了時に報告する。
+    // 直近のログはプログラム終了まで保持するので対象外
+    MemoryTracker::BeginLeakCheck();
+    MemoryTracker::SetLeakCheckIgnored(MemoryTag::kLog, true);
+    for (const auto &[tag, budgetBytes] : kMemoryBudgets) {
+        MemoryTracker::SetBudget(tag, budgetBytes);
+    }
+    MEMORY_TAG_SCOPE(kEngine);
+
     // COMの初期化
     HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
     if (FAILED(hr)) {
@@ -104,78 +275,167 @@ Engine::Engine(const char *title, int width, int height, bool enableDebugLayer,
 
     // タイトル名がそのままだと使えないので変換
     std::wstring wTitle = ConvertString(title);
+
+    // 各サブシステムの初期化を依存関係で繋ぎ、独立したものはワーカースレッドで並行に行う。
+    // ウィンドウやコマンドリスト、ディスクリプタヒープを触るものはメインスレッドで元の順番のまま行う
+    using TaskThread = MyStd::TaskGraph::TaskThread;
+    MyStd::TaskGraph initializeGraph;
+
     // Windowsアプリ初期化
-    sWinApp = std::make_unique<WinApp>(
-        wTitle,
-        WS_OVERLAPPEDWINDOW & ~(WS_MAXIMIZEBOX | WS_THICKFRAME),
-        width,
-        height
-    );
-    sWinApp->SetSizeChangeMode(KashipanEngine::SizeChangeMode::kNone);
+    initializeGraph.AddTask("WinApp", TaskThread::kMain, [&]() {
+        sWinApp = std::make_unique<WinApp>(
+            wTitle,
+            WS_OVERLAPPEDWINDOW & ~(WS_MAXIMIZEBOX | WS_THICKFRAME),
+            width,
+            height,
+            !sIsHeadless
+        );
+        sWinApp->SetSizeChangeMode(KashipanEngine::SizeChangeMode::kNone);
+    });
 
     // DirectX初期化
-    sDxCommon = std::make_unique<DirectXCommon>(enableDebugLayer, sWinApp.get());
-
-    // InputManager初期化
-    Input::Initialize(sWinApp.get());
+    initializeGraph.AddTask("DirectXCommon", TaskThread::kMain, [&]() {
+        sDxCommon = std::make_unique<DirectXCommon>(enableDebugLayer, sWinApp.get());
+        // ヘッドレスモードでは画面に表示しない
+        sDxCommon->SetPresentEnabled(!sIsHeadless);
+        sDxCommon->SetVSync(!sIsHeadless);
+    }, { "WinApp" });
+
+    // InputManager初期化(DirectInput は COM オブジェクトなので、プロセスの終了まで使うメインスレッドで作る)
+    initializeGraph.AddTask("InputDevices", TaskThread::kMain, [&]() {
+        Input::InitializeDevices(sWinApp.get());
+    }, { "WinApp" });
+    initializeGraph.AddTask("Input", TaskThread::kMain, []() {
+        Input::AttachWindow();
+    }, { "InputDevices" });
 
     // UAV初期化
-    UAV::Initialize(sDxCommon.get());
+    initializeGraph.AddTask("UAV", TaskThread::kMain, [&]() {
+        UAV::Initialize(sDxCommon.get());
+    }, { "DirectXCommon" });
 
     // プリミティブ描画クラス初期化
-    PrimitiveDrawer::Initialize(sDxCommon.get());
-
-    // 音声初期化
-    Sound::Initialize();
+    initializeGraph.AddTask("PrimitiveDrawer", TaskThread::kMain, [&]() {
+        PrimitiveDrawer::Initialize(sDxCommon.get());
+    }, { "UAV" });
+
+    // 音声初期化(XAudio2 と Media Foundation も COM なのでメインスレッドで作る)
+    initializeGraph.AddTask("Sound", TaskThread::kMain, []() {
+        Sound::Initialize();
+    });
+
+    // アセットの先読み。デフォルトのテクスチャと Objects.json に書かれたテクスチャをワーカーでデコードしておき、
+    // メインスレッドの Load では GPU への転送だけを行う
+    initializeGraph.AddTask("AssetPrefetch", TaskThread::kAny, []() {
+        Texture::Prefetch("Resources/white1x1.png");
+        Texture::PrefetchFromJson("Resources/Objects.json");
+    });
 
     // srvDescriptorHeapの初期化
-    SRV::Initialize(sDxCommon.get());
+    initializeGraph.AddTask("SRV", TaskThread::kMain, [&]() {
+        SRV::Initialize(sDxCommon.get());
+    }, { "PrimitiveDrawer" });
 
 #ifdef USE_IMGUI
     // ImGui初期化
-    sImGuiManager = std::make_unique<ImGuiManager>(sWinApp.get(), sDxCommon.get());
+    initializeGraph.AddTask("ImGui", TaskThread::kMain, [&]() {
+        sImGuiManager = std::make_unique<ImGuiManager>(sWinApp.get(), sDxCommon.get());
+        // ヘッドレスモードではUIの処理だけ行い、描画コマンドは積まない
+        sImGuiManager->SetCommandRecordingEnabled(!sIsHeadless);
+    }, { "SRV" });
+    const std::string textureDependency = "ImGui";
+#else
+    const std::string textureDependency = "SRV";
 #endif
 
     // テクスチャ管理クラス初期化
-    Texture::Initialize(sDxCommon.get());
-
-    // パイプライン初期化
-    PipeLines::Initialize(sDxCommon.get());
-
-    // パイプラインマネージャ初期化
-    sPipeLineManager = std::make_unique<PipeLineManager>(sDxCommon.get());
+    initializeGraph.AddTask("Texture", TaskThread::kMain, [&]() {
+        Texture::Initialize(sDxCommon.get());
+    }, { textureDependency, "AssetPrefetch" });
+
+    // パイプラインの初期化(設定ファイルの読み込みとシェーダーのコンパイル)は並行に行う。
+    // 使うのはどのスレッドからでも呼べる ID3D12Device の Create 系の関数と、この処理の中で作って閉じる DXC だけで、
+    // コマンドリスト・ディスクリプタヒープには触れない(DirectXCommon のコマンドリストの取得はメインスレッド以外だと assert になる)。
+    // Log・StringId::Intern・LoadJsonc はスレッドセーフで、作ったものは Run の完了後にメインスレッドが受け取る
+    initializeGraph.AddTask("PipeLineManager", TaskThread::kAny, [&]() {
+        PipeLines::Initialize(sDxCommon.get());
+        sPipeLineManager = std::make_unique<PipeLineManager>(sDxCommon.get());
+    }, { "DirectXCommon" });
 
     // 描画用クラス初期化
+    initializeGraph.AddTask("Renderer", TaskThread::kMain, [&]() {
 #if DEBUG_BUILD || DEVELOP_BUILD
-    sRenderer = std::make_unique<Renderer>(sWinApp.get(), sDxCommon.get(), sImGuiManager.get(), sPipeLineManager.get());
+        sRenderer = std::make_unique<Renderer>(sWinApp.get(), sDxCommon.get(), sImGuiManager.get(), sPipeLineManager.get());
 #else
-    sRenderer = std::make_unique<Renderer>(sWinApp.get(), sDxCommon.get(), nullptr, sPipeLineManager.get());
+        sRenderer = std::make_unique<Renderer>(sWinApp.get(), sDxCommon.get(), nullptr, sPipeLineManager.get());
 #endif
+        // ヘッドレスモードでは描画コマンドを数えるだけにする
+        sRenderer->SetCommandRecordingEnabled(!sIsHeadless);
+    }, { "Texture", "PipeLineManager" });
 
     // オブジェクト初期化
-    Object::Initialize(this);
+    initializeGraph.AddTask("Object", TaskThread::kMain, [&]() {
+        Object::Initialize(this);
+    }, { "Renderer" });
 
     // ライン初期化
-    Lines::Initialize(sRenderer.get());
+    initializeGraph.AddTask("Lines", TaskThread::kMain, [&]() {
+        Lines::Initialize(sRenderer.get());
+    }, { "Object" });
 
     // スクリーンバッファ初期化
-    ScreenBuffer::Initialize(sWinApp.get(), sDxCommon.get(), sPipeLineManager.get());
-    sMainScreenBuffer = std::make_unique<ScreenBuffer>("MainScreen", static_cast<uint32_t>(width), static_cast<uint32_t>(height));
-    auto screenIndex = KashipanEngine::Texture::FindIndex("MainScreen");
-    sMainScreenSprite = std::make_unique<Sprite>(static_cast<uint32_t>(screenIndex));
-    sMainScreenSprite->GetStatePtr().transform->translate = { width / 2.0f, height / 2.0f, 0.0f };
-    Input::SetMainScreen(sMainScreenBuffer.get());
+    initializeGraph.AddTask("ScreenBuffer", TaskThread::kMain, [&]() {
+        ScreenBuffer::Initialize(sWinApp.get(), sDxCommon.get(), sPipeLineManager.get());
+        sMainScreenBuffer = std::make_unique<ScreenBuffer>("MainScreen", static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        sMainScreenSprite = std::make_unique<Sprite>(sMainScreenBuffer->GetTextureHandle());
+        sMainScreenSprite->GetStatePtr().transform->translate = { width / 2.0f, height / 2.0f, 0.0f };
+        Input::SetMainScreen(sMainScreenBuffer.get());
+    }, { "Lines", "Input" });
+
+    // 乱数の初期化
+    initializeGraph.AddTask("Random", TaskThread::kAny, []() {
+        InitializeRandom();
+    });
 
     // シーンの初期化
-    SceneBase::Initialize(this);
+    initializeGraph.AddTask("SceneBase", TaskThread::kMain, [&]() {
+        SceneBase::Initialize(this);
+    }, { "ScreenBuffer", "Sound", "Random" });
+
+    // ワーカーでは画像のデコード(WIC)に COM を使うのでスレッドごとに初期化する。
+    // ワーカーで作った COM オブジェクトを処理の外に持ち出すことは無い
+    // (DirectXTex が使い回す WIC のファクトリはフリースレッドで、メインスレッドが終了処理まで MTA を保つ)。
+    // ワーカーでもゾーンを記録するので、プロファイラにも登録しておく
+    initializeGraph.SetWorkerCallbacks(
+        []() {
+            CoInitializeEx(0, COINIT_MULTITHREADED);
+            Profiler::RegisterThread("Initialize Worker");
+        },
+        []() { CoUninitialize(); }
+    );
+    const size_t hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 2u);
+    const size_t workerCount = std::min<size_t>(hardwareThreadCount - 1, kMaxInitializeWorkerCount);
+    const bool isInitializeSucceeded = initializeGraph.Run(workerCount);
+    LogInitializeReport(initializeGraph);
+    if (!isInitializeSucceeded) {
+        Log("Failed to initialize engine: " + initializeGraph.GetErrorMessage(), kLogLevelFlagError);
+        assert(false);
+        // 例外フィルタでダンプを出力させる
+        throw std::runtime_error(initializeGraph.GetErrorMessage());
+    }
 
-    // 乱数の初期化
-    InitializeRandom();
+    // フレーム時間の初期化。高精度タイマーが使えない環境では標準の sleep で待つ
+    sFrameTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (sFrameTimer) {
+        sFramePacer.SetSleepFunction(SleepWithFrameTimer);
+    } else {
+        Log("High resolution waitable timer is not supported.", kLogLevelFlagWarning);
+    }
+    UpdateMonitorFrameRate();
 
-    // フレーム時間の初期化
-    LARGE_INTEGER freq;
-    QueryPerformanceFrequency(&freq);
-    sFrequency = freq.QuadPart;
+    if (sIsHeadless) {
+        Log("Engine is running in headless mode.");
+    }
 
     // 初期化完了のログを出力
     Log("Engine Initialized.");
@@ -184,6 +444,8 @@ Engine::Engine(const char *title, int width, int height, bool enableDebugLayer,
 
 Engine::~Engine() {
     LogInsertPartition("\n================= Engine Finalize ================\n");
+    // 保存待ちのファイルを書き込んでから終了する
+    FinalizeJsoncSaveQueue();
     ParticleManager::ClearAllParticleGroups();
     // 各クラスの終了処理
     ModelData::ClearAllModelData();
@@ -191,6 +453,7 @@ Engine::~Engine() {
     sPipeLineManager.reset();
     sRenderer.reset();
     Sound::Finalize();
+    FontRegistry::Finalize();
     Texture::Finalize();
 #ifdef USE_IMGUI
     sImGuiManager.reset();
@@ -202,7 +465,13 @@ Engine::~Engine() {
     RTV::Finalize();
     DSV::Finalize();
     SRV::Finalize();
+    if (sFrameTimer) {
+        CloseHandle(sFrameTimer);
+        sFrameTimer = nullptr;
+    }
     CoUninitialize();
+    // 解放されずに残っているメモリの報告
+    MemoryTracker::ReportLeaks();
     // 終了処理完了のログを出力
     Log("Engine Finalized.");
     LogInsertPartition("\n============= Engine Finalize Finish =============\n");
@@ -214,65 +483,105 @@ void Engine::BeginFrame() {
         sDxCommon->Resize();
         sWinApp->SizingDisable();
     }
-
-    // 時間取得
-    QueryPerformanceCounter(&sNowTime);
-    // sLastTimeが0の場合は代入だけして終わる
-    if (sLastTime == 0) {
-        sLastTime = sNowTime.QuadPart;
-        return;
-    }
-
-    // 時間計算
-    sElapsedTime = sNowTime.QuadPart - sLastTime;
-    sElapsedSeconds = static_cast<float>(sElapsedTime) / sFrequency;
-    sDeltaTime = sElapsedSeconds;
 }
 
 bool Engine::BeginGameLoop() {
-    // モニターのフレームレートを取得
-    HDC hdc = GetDC(sWinApp->GetWindowHandle());
-    int monitorFrameRate = GetDeviceCaps(hdc, VREFRESH);
-    ReleaseDC(sWinApp->GetWindowHandle(), hdc);
+    UpdateMonitorFrameRate();
+
+    // 次のフレームの開始時刻まで待つ(大半は眠り、最後だけ空回りで待つ)
+    {
+        PROFILE_SCOPE("Engine::WaitForNextFrame");
+        sFrameTime = static_cast<float>(sFramePacer.WaitForNextFrame());
+    }
+    if (sFrameTime > 0.0f) {
+        sCountFps = static_cast<unsigned int>(1.0f / sFrameTime + 0.5f);
+    }
+    // 最大速度での再生中は、再生したフレームにかかった時間を集計する
+    if (sIsMaxSpeedReplay && Input::GetReplayFrameIndex() > 0) {
+        sReplayFrameTimeStats.AddFrame(static_cast<double>(sFrameTime) * 1000.0);
+    }
 
-    // 指定のフレームレートがモニターのFPS以上なら垂直同期
-    if (sFrameRate > monitorFrameRate) {
-        sFrameRate = monitorFrameRate;
+    // 入力の更新。記録中はフレーム時間も記録し、再生中は記録した入力とフレーム時間を使う
+    Input::Update(sFrameTime);
+    sDeltaTime = Input::IsReplaying() ? Input::GetReplayDeltaTime() : sFrameTime;
+    if (sIsMaxSpeedReplay && !Input::IsReplaying()) {
+        FinishMaxSpeedReplay();
     }
+    // このフレームで進めるティック数を決める
+    sPendingTickCount = sFixedTimestep.Advance(sDeltaTime);
+    sIsInFixedUpdate = false;
 
-    if (sDeltaTime > 1.0f / static_cast<float>(sFrameRate)) {
-        sLastTime = sNowTime.QuadPart;
-        sCountFps = static_cast<unsigned int>(1.0f / sDeltaTime);
-        
+    PROFILE_SCOPE("Engine::BeginGameLoop");
+    // ヘッドレスモードでは画面のクリアなどのコマンドも積まない
+    if (!sIsHeadless) {
         sMainScreenBuffer->PreDraw();
+    }
 #ifdef USE_IMGUI
-        sImGuiManager->BeginFrame();
+    sImGuiManager->BeginFrame();
 #endif
-        sRenderer->PreDraw();
-        Input::Update();
-        return true;
+    sRenderer->PreDraw();
+    return true;
+}
+
+bool Engine::BeginFixedUpdate() {
+    if (sPendingTickCount == 0) {
+        sIsInFixedUpdate = false;
+        return false;
     }
-    return false;
+    --sPendingTickCount;
+    sIsInFixedUpdate = true;
+    // このティックで動かす前の姿勢を補間の開始点にする
+    Object::SaveInterpolationStates();
+    return true;
 }
 
 void Engine::EndFrame() {
-    sRenderer->PostDraw();
-    sMainScreenBuffer->PostDraw();
+    sIsInFixedUpdate = false;
+    {
+        PROFILE_SCOPE("Engine::EndFrame");
+        sRenderer->PostDraw();
+        if (sIsHeadless) {
+            // 画面への書き込みは行わず、UIのフレームだけ閉じる。
+            // テクスチャの転送などで積まれたコマンドがあれば実行し、完了を待つ
+#ifdef USE_IMGUI
+            sImGuiManager->EndFrame();
+#endif
+            sDxCommon->CommandExecute(false);
+        } else {
+            sMainScreenBuffer->PostDraw();
 
-    sDxCommon->PreDraw();
+            sDxCommon->PreDraw();
 #if RELEASE_BUILD
-    DirectionalLight *light = sRenderer->GetLight();
-    sRenderer->PreDraw();
-    sRenderer->SetLight(light);
-    sMainScreenSprite->Draw();
-    sRenderer->PostDraw();
+            DirectionalLight *light = sRenderer->GetLight();
+            sRenderer->PreDraw();
+            sRenderer->SetLight(light);
+            sMainScreenSprite->Draw();
+            sRenderer->PostDraw();
 #else
-    sMainScreenBuffer->DrawToImGui();
+            sMainScreenBuffer->DrawToImGui();
 #ifdef USE_IMGUI
-    sImGuiManager->EndFrame();
+            sImGuiManager->EndFrame();
 #endif
 #endif
-    sDxCommon->PostDraw();
+            PROFILE_SCOPE("Engine::Present");
+            sDxCommon->PostDraw();
+        }
+    }
+
+    // このフレームのヒープの確保回数の集計と予算の確認
+    MemoryTracker::EndFrame();
+    // 切り替えで消える前に、このフレームのアロケータの使用状況を取っておく
+    const MyStd::LinearArena &frameArena = GetFrameArena().GetArena();
+    const FrameAllocationSample allocation{
+        frameArena.GetAllocationCount(), frameArena.GetUsed(), frameArena.GetOverflowCount(),
+        MemoryTracker::GetFrameAllocationCount(), MemoryTracker::GetFrameAllocatedBytes()
+    };
+    // フレーム単位のアロケータを次のフレームに切り替える
+    EndFrameAllocator();
+    // このフレームの計測結果を集計する
+    Profiler::EndFrame();
+    // フレーム時間を記録し、ヒッチであれば直前の計測結果を書き出す
+    UpdateFrameStatistics(sFrameTime, allocation);
 }
 
 void Engine::QuitGame() {
@@ -281,22 +590,88 @@ void Engine::QuitGame() {
 
 void Engine::SetFrameRate(int frameRate) {
     sFrameRate = frameRate;
-    // 指定のフレームレートが24以下なら垂直同期
-    if (sFrameRate < 24) {
-        // モニターのフレームレートを取得
-        HDC hdc = GetDC(sWinApp->GetWindowHandle());
-        sFrameRate = GetDeviceCaps(hdc, VREFRESH);
-        ReleaseDC(sWinApp->GetWindowHandle(), hdc);
+    ApplyFrameRate();
+    sFramePacer.Reset();
+}
+
+void Engine::StartInputRecording() {
+    Input::StartRecording();
+}
+
+bool Engine::StopInputRecording(const std::string &filePath) {
+    return Input::StopRecording(filePath);
+}
+
+bool Engine::StartInputReplay(const std::string &filePath, bool isMaxSpeed) {
+    if (!Input::StartReplay(filePath)) {
+        return false;
     }
+    sIsMaxSpeedReplay = isMaxSpeed;
+    if (isMaxSpeed) {
+        sReplayFrameTimeStats = MyStd::FrameTimeStats(Input::GetReplayFrameCount());
+        sDxCommon->SetVSync(false);
+        ApplyFrameRate();
+    }
+    return true;
+}
+
+Engine::SceneBenchmarkResult Engine::RunSceneBenchmark(const std::string &sceneName, uint32_t frameCount, uint32_t warmupFrameCount) {
+    SetBenchmarking(true);
+    const auto result = KashipanEngine::RunSceneBenchmark(sceneName, frameCount, warmupFrameCount, MakeSceneBenchmarkFrameFunctions(this));
+    SetBenchmarking(false);
+    return result;
+}
+
+std::vector<Engine::SceneBenchmarkResult> Engine::RunSceneBenchmarks(uint32_t frameCount, uint32_t warmupFrameCount) {
+    SetBenchmarking(true);
+    const auto results = KashipanEngine::RunSceneBenchmarks(frameCount, warmupFrameCount, MakeSceneBenchmarkFrameFunctions(this));
+    SetBenchmarking(false);
+    return results;
+}
+
+void Engine::SetTickRate(int tickRate) {
+    sFixedTimestep.SetTickRate(static_cast<double>(tickRate));
+}
+
+void Engine::SetMaxSubsteps(uint32_t maxSubsteps) {
+    sFixedTimestep.SetMaxSubsteps(maxSubsteps);
 }
 
 float Engine::GetDeltaTime() {
+    if (sIsInFixedUpdate) {
+        return GetFixedDeltaTime();
+    }
     return sDeltaTime;
 }
 
+float Engine::GetFixedDeltaTime() {
+    return static_cast<float>(sFixedTimestep.GetTickDelta());
+}
+
+float Engine::GetInterpolationAlpha() {
+    return static_cast<float>(sFixedTimestep.GetAlpha());
+}
+
 unsigned int Engine::GetFPS() {
-    // 補正値として1を入れておく
-    return sCountFps + 1;
+    // 以前は空回りで待った分だけ間隔が長くなり、切り捨てると1少なくなるので +1 で補正していた。
+    // 今は予定時刻に合わせて始めるので、四捨五入した値をそのまま返す
+    return sCountFps;
+}
+
+bool Engine::IsHeadless() {
+    return sIsHeadless;
+}
+
+MyStd::FramePacer::Stats Engine::GetFramePacingStats() {
+    return sFramePacer.GetStats();
+}
+
+MyStd::FrameTimeStats::Summary Engine::GetFrameTimeStats() {
+    return KashipanEngine::GetFrameTimeStats().GetSummary();
+}
+
+void Engine::SetHitchThreshold(double medianMultiplier, double minimumMilliseconds) {
+    KashipanEngine::GetFrameTimeStats().SetHitchThreshold(medianMultiplier, minimumMilliseconds);
 }
 
 KashipanEngine::WinApp *Engine::GetWinApp() const {
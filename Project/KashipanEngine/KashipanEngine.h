@@ -2,8 +2,12 @@
 #include <Windows.h>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <filesystem>
+#include <FramePacer.h>
+#include <FrameTimeStats.h>
 
+#include "Common/SceneBenchmark.h"
 #include "Common/VertexData.h"
 #include "Math/Transform.h"
 #include "Math/Vector4.h"
@@ -21,17 +25,30 @@ class ImGuiManager;
 /// @brief 自作エンジンクラス
 class Engine final {
 public:
+    /// @brief シーンのベンチマークの結果
+    using SceneBenchmarkResult = KashipanEngine::SceneBenchmarkResult;
+
+    /// @brief コンストラクタ
+    /// @param isHeadless ヘッドレスモードにするかどうか。
+    /// ウィンドウを表示せず、描画コマンドは数えるだけでGPUに積まず、画面への表示とフレームの待機もしない
     Engine(const char *title, int width = 1280, int height = 720, bool enableDebugLayer = true,
-        const std::filesystem::path &projectDir = std::filesystem::current_path());
+        const std::filesystem::path &projectDir = std::filesystem::current_path(), bool isHeadless = false);
     ~Engine();
 
     /// @brief フレーム開始処理
     void BeginFrame();
 
-    /// @brief ゲームループ開始処理
+    /// @brief ゲームループ開始処理。次のフレームの開始時刻まで待ってから描画の準備をする
     /// @return ゲームループを開始するかどうか
     bool BeginGameLoop();
 
+    /// @brief 固定ステップ更新の1ティック開始。
+    /// while (engine->BeginFixedUpdate()) { ... } の形で、このフレームで進めるティック数だけ更新処理を回す。
+    /// 固定ステップで進むのはこのループの中で呼んだ処理だけで、シーンは SceneManager::FixedUpdateActiveScene をここで呼ぶ。
+    /// ループの外で呼んだ KeyFrameAnimation::Update などはフレームの経過時間で進む
+    /// @return まだ進めるティックが残っているかどうか
+    bool BeginFixedUpdate();
+
     /// @brief フレーム終了処理
     void EndFrame();
 
@@ -42,14 +59,76 @@ public:
     /// @param frameRate フレームレート。最低24まで。無効な値(例: 24未満やモニターのFPS以上)の場合は垂直同期
     void SetFrameRate(int frameRate);
 
-    /// @brief デルタタイム取得
+    /// @brief 入力の記録開始。各フレームの入力をフレーム時間と一緒に記録する
+    void StartInputRecording();
+
+    /// @brief 入力の記録を終了してファイルに保存
+    /// @param filePath 保存先のパス
+    /// @return 保存できたかどうか
+    bool StopInputRecording(const std::string &filePath);
+
+    /// @brief 記録した入力の再生開始。再生中は入力とデルタタイムが記録したものに置き換わる
+    /// @param filePath 記録のパス
+    /// @param isMaxSpeed 待機や垂直同期をせずに最大速度で再生し、終了時にフレーム時間の統計をログに出力するかどうか
+    /// @return 再生を開始できたかどうか
+    bool StartInputReplay(const std::string &filePath, bool isMaxSpeed = false);
+
+    /// @brief シーンを指定フレーム数だけ最大速度で回し、CPUのフレーム時間と描画コマンドの数をログに出力する。
+    /// 計測中は垂直同期とフレームの待機を止める。ヘッドレスでない場合はGPUの完了待ちも含む
+    /// @param sceneName 計測するシーン名
+    /// @param frameCount 計測するフレーム数
+    /// @param warmupFrameCount 計測前に回すフレーム数
+    /// @return 計測結果
+    SceneBenchmarkResult RunSceneBenchmark(const std::string &sceneName, uint32_t frameCount, uint32_t warmupFrameCount = 30);
+
+    /// @brief 登録されているすべてのシーンのベンチマーク。終了後は元のシーンに戻す
+    /// @param frameCount シーンごとに計測するフレーム数
+    /// @param warmupFrameCount 計測前に回すフレーム数
+    /// @return シーンごとの計測結果
+    std::vector<SceneBenchmarkResult> RunSceneBenchmarks(uint32_t frameCount, uint32_t warmupFrameCount = 30);
+
+    /// @brief 固定ステップ更新の1秒あたりのティック数設定
+    /// @param tickRate 1秒あたりのティック数
+    void SetTickRate(int tickRate);
+
+    /// @brief 1フレームで進める最大ティック数設定。処理落ちで更新が追いつかなくなるのを防ぐ
+    /// @param maxSubsteps 最大ティック数
+    void SetMaxSubsteps(uint32_t maxSubsteps);
+
+    /// @brief デルタタイム取得。固定ステップ更新中は1ティックの時間を返す
     /// @return デルタタイム
     static float GetDeltaTime();
 
+    /// @brief 1ティックの時間取得
+    /// @return 1ティックの時間(秒)
+    static float GetFixedDeltaTime();
+
+    /// @brief 最後のティックから次のティックまでの進み具合取得。描画時の姿勢の補間に使う
+    /// @return 0以上1未満の補間係数
+    static float GetInterpolationAlpha();
+
     /// @brief フレームレート取得
-    /// @return フレームレート
+    /// @return 直前のフレームの間隔から求めたフレームレート(四捨五入)
     static unsigned int GetFPS();
 
+    /// @brief ヘッドレスモードかどうか
+    /// @return ヘッドレスモードならtrue
+    static bool IsHeadless();
+
+    /// @brief フレーム開始時刻のずれの統計取得
+    /// @return 直近のフレームのずれの統計(ミリ秒)
+    static MyStd::FramePacer::Stats GetFramePacingStats();
+
+    /// @brief フレーム時間の統計取得
+    /// @return 直近のフレーム時間の統計(ミリ秒)とこれまでのヒッチの数
+    static MyStd::FrameTimeStats::Summary GetFrameTimeStats();
+
+    /// @brief ヒッチとみなすフレーム時間の条件設定。
+    /// ヒッチを検出すると Logs/Hitches に直前の計測結果を書き出す(リリースビルドを除く)
+    /// @param medianMultiplier 直近のフレーム時間の中央値の何倍を超えたらヒッチとするか
+    /// @param minimumMilliseconds これより短いフレームはヒッチとしない
+    static void SetHitchThreshold(double medianMultiplier, double minimumMilliseconds);
+
     /// @brief WinAppクラスのポインタ取得
     /// @return WinAppクラスのポインタ
     KashipanEngine::WinApp *GetWinApp() const;
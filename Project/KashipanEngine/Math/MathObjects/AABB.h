@@ -15,6 +15,7 @@ struct AABB {
     AABB() noexcept = default;
     AABB(const Vector3 &min, const Vector3 &max) noexcept;
     AABB(const AABB &aabb) noexcept;
+    AABB &operator=(const AABB &aabb) noexcept = default;
 
     /// @brief minとmaxを正しくする
     void Sort() noexcept;
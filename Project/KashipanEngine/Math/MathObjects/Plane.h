@@ -26,6 +26,7 @@ struct Plane {
     Plane(const Plane &plane) noexcept :
         normal(plane.normal), distance(plane.distance)
     {}
+    Plane &operator=(const Plane &plane) noexcept = default;
 
     /// @brief 法線と平面上の点から平面を設定する
     /// @param n 法線ベクトル
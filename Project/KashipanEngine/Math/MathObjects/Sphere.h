@@ -16,6 +16,7 @@ struct Sphere {
     Sphere(const Sphere &sphere) noexcept :
         center(sphere.center), radius(sphere.radius)
     {}
+    Sphere &operator=(const Sphere &sphere) noexcept = default;
 
     /// @brief 弾との衝突判定
     /// @param sphere 衝突判定を行う球
@@ -0,0 +1,344 @@
+#include "ContactManifold.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/MathObjects/Plane.h"
+#include "Math/MathObjects/AABB.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace KashipanEngine {
+
+namespace ContactGenerator {
+
+namespace {
+
+// 正規化できない長さとみなす閾値
+const float kEpsilon = 1.0e-6f;
+
+/// @brief 接触点の追加
+void AddPoint(ContactManifold &manifold, const Vector3 &position, float penetration, uint32_t featureId) {
+    if (manifold.pointCount >= ContactManifold::kMaxPoints) {
+        return;
+    }
+    manifold.points[manifold.pointCount++] = { position, penetration, featureId };
+}
+
+/// @brief 軸ごとの値の取得
+float GetAxis(const Vector3 &v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+/// @brief 軸ごとの値の設定
+void SetAxis(Vector3 &v, int axis, float value) {
+    if (axis == 0) {
+        v.x = value;
+    } else if (axis == 1) {
+        v.y = value;
+    } else {
+        v.z = value;
+    }
+}
+
+} // namespace
+
+bool Generate(const Math::Sphere &a, const Math::Sphere &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    const Vector3 diff = b.center - a.center;
+    const float radiusSum = a.radius + b.radius;
+    const float distanceSquared = diff.Dot(diff);
+    if (distanceSquared > radiusSum * radiusSum) {
+        return false;
+    }
+
+    // 中心が重なっている場合は上方向に押し出す
+    const float distance = std::sqrt(distanceSquared);
+    manifold.normal = distance > kEpsilon ? diff / distance : Vector3(0.0f, 1.0f, 0.0f);
+    const float penetration = radiusSum - distance;
+    AddPoint(manifold, a.center + manifold.normal * (a.radius - penetration * 0.5f), penetration, 0);
+    return true;
+}
+
+bool Generate(const Math::Sphere &a, const Math::Plane &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    // 平面は法線の裏側を中身とする半空間として扱う
+    const float signedDistance = b.normal.Dot(a.center) - b.distance;
+    if (signedDistance > a.radius) {
+        return false;
+    }
+
+    manifold.normal = -b.normal;
+    const float penetration = a.radius - signedDistance;
+    AddPoint(manifold, a.center - b.normal * ((a.radius + signedDistance) * 0.5f), penetration, 0);
+    return true;
+}
+
+bool Generate(const Math::Sphere &a, const Math::AABB &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    const Vector3 closest(
+        std::clamp(a.center.x, b.min.x, b.max.x),
+        std::clamp(a.center.y, b.min.y, b.max.y),
+        std::clamp(a.center.z, b.min.z, b.max.z)
+    );
+    const Vector3 diff = closest - a.center;
+    const float distanceSquared = diff.Dot(diff);
+
+    if (distanceSquared > kEpsilon * kEpsilon) {
+        // 中心がAABBの外にある場合
+        if (distanceSquared > a.radius * a.radius) {
+            return false;
+        }
+        const float distance = std::sqrt(distanceSquared);
+        manifold.normal = diff / distance;
+        const float penetration = a.radius - distance;
+        AddPoint(manifold, (a.center + manifold.normal * a.radius + closest) * 0.5f, penetration, 0);
+        return true;
+    }
+
+    // 中心がAABBの中にある場合は一番近い面から押し出す
+    float minDistance = (std::numeric_limits<float>::max)();
+    int bestAxis = 0;
+    float bestSign = 1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float toMin = GetAxis(a.center, axis) - GetAxis(b.min, axis);
+        const float toMax = GetAxis(b.max, axis) - GetAxis(a.center, axis);
+        if (toMin < minDistance) {
+            minDistance = toMin;
+            bestAxis = axis;
+            bestSign = -1.0f;
+        }
+        if (toMax < minDistance) {
+            minDistance = toMax;
+            bestAxis = axis;
+            bestSign = 1.0f;
+        }
+    }
+    // 押し出す面の外向き法線の逆がAからBへの向き
+    manifold.normal = Vector3(0.0f);
+    SetAxis(manifold.normal, bestAxis, -bestSign);
+    AddPoint(manifold, a.center, a.radius + minDistance, 0);
+    return true;
+}
+
+bool Generate(const Math::Sphere &a, const CapsuleY &b, ContactManifold &manifold) {
+    // カプセルの線分上で球の中心に最も近い点を球とみなす
+    const Vector3 closest(
+        b.center.x,
+        std::clamp(a.center.y, b.center.y - b.halfHeight, b.center.y + b.halfHeight),
+        b.center.z
+    );
+    return Generate(a, Math::Sphere(closest, b.radius), manifold);
+}
+
+bool Generate(const Math::AABB &a, const Math::AABB &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    Vector3 overlapMin(
+        (std::max)(a.min.x, b.min.x),
+        (std::max)(a.min.y, b.min.y),
+        (std::max)(a.min.z, b.min.z)
+    );
+    Vector3 overlapMax(
+        (std::min)(a.max.x, b.max.x),
+        (std::min)(a.max.y, b.max.y),
+        (std::min)(a.max.z, b.max.z)
+    );
+
+    // 重なりの一番小さい軸を分離方向にする
+    int axis = -1;
+    float penetration = (std::numeric_limits<float>::max)();
+    for (int i = 0; i < 3; ++i) {
+        const float overlap = GetAxis(overlapMax, i) - GetAxis(overlapMin, i);
+        if (overlap < 0.0f) {
+            return false;
+        }
+        if (overlap < penetration) {
+            penetration = overlap;
+            axis = i;
+        }
+    }
+
+    const float centerA = (GetAxis(a.min, axis) + GetAxis(a.max, axis)) * 0.5f;
+    const float centerB = (GetAxis(b.min, axis) + GetAxis(b.max, axis)) * 0.5f;
+    const float sign = centerB >= centerA ? 1.0f : -1.0f;
+    manifold.normal = Vector3(0.0f);
+    SetAxis(manifold.normal, axis, sign);
+
+    // 重なり領域の接触面の4隅を接触点にする
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const float plane = (GetAxis(overlapMin, axis) + GetAxis(overlapMax, axis)) * 0.5f;
+    const uint32_t featureBase = (static_cast<uint32_t>(axis) << 3) | (sign > 0.0f ? 0u : 4u);
+    for (uint32_t corner = 0; corner < 4; ++corner) {
+        Vector3 position(0.0f);
+        SetAxis(position, axis, plane);
+        SetAxis(position, u, (corner & 1) ? GetAxis(overlapMax, u) : GetAxis(overlapMin, u));
+        SetAxis(position, v, (corner & 2) ? GetAxis(overlapMax, v) : GetAxis(overlapMin, v));
+        AddPoint(manifold, position, penetration, featureBase | corner);
+    }
+    return true;
+}
+
+bool Generate(const Math::AABB &a, const Math::Plane &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    struct Candidate {
+        float signedDistance;
+        uint32_t vertex;
+    };
+    Candidate candidates[8];
+    uint32_t candidateCount = 0;
+    for (uint32_t i = 0; i < 8; ++i) {
+        const Vector3 vertex(
+            (i & 1) ? a.max.x : a.min.x,
+            (i & 2) ? a.max.y : a.min.y,
+            (i & 4) ? a.max.z : a.min.z
+        );
+        const float signedDistance = b.normal.Dot(vertex) - b.distance;
+        if (signedDistance <= 0.0f) {
+            candidates[candidateCount++] = { signedDistance, i };
+        }
+    }
+    if (candidateCount == 0) {
+        return false;
+    }
+
+    // 深い順に最大4点まで採用する
+    std::sort(candidates, candidates + candidateCount, [](const Candidate &l, const Candidate &r) {
+        return l.signedDistance != r.signedDistance ? l.signedDistance < r.signedDistance : l.vertex < r.vertex;
+    });
+    manifold.normal = -b.normal;
+    const uint32_t count = (std::min)(candidateCount, ContactManifold::kMaxPoints);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t index = candidates[i].vertex;
+        const Vector3 vertex(
+            (index & 1) ? a.max.x : a.min.x,
+            (index & 2) ? a.max.y : a.min.y,
+            (index & 4) ? a.max.z : a.min.z
+        );
+        const float signedDistance = candidates[i].signedDistance;
+        AddPoint(manifold, vertex - b.normal * (signedDistance * 0.5f), -signedDistance, index);
+    }
+    return true;
+}
+
+bool Generate(const Math::AABB &a, const CapsuleY &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    const float segmentBottom = b.center.y - b.halfHeight;
+    const float segmentTop = b.center.y + b.halfHeight;
+    const float overlapBottom = (std::max)(a.min.y, segmentBottom);
+    const float overlapTop = (std::min)(a.max.y, segmentTop);
+
+    if (overlapBottom > overlapTop) {
+        // 線分がAABBの高さ範囲外なら近い方の端を球として判定する
+        const float endY = segmentBottom > a.max.y ? segmentBottom : segmentTop;
+        if (!Generate(Math::Sphere(Vector3(b.center.x, endY, b.center.z), b.radius), a, manifold)) {
+            return false;
+        }
+        Flip(manifold);
+        return true;
+    }
+
+    // 線分がAABBの高さ範囲内にある場合はXZ平面上の円と矩形で判定する
+    const float closestX = std::clamp(b.center.x, a.min.x, a.max.x);
+    const float closestZ = std::clamp(b.center.z, a.min.z, a.max.z);
+    const float dx = b.center.x - closestX;
+    const float dz = b.center.z - closestZ;
+    const float distanceSquared = dx * dx + dz * dz;
+
+    if (distanceSquared > kEpsilon * kEpsilon) {
+        if (distanceSquared > b.radius * b.radius) {
+            return false;
+        }
+        const float distance = std::sqrt(distanceSquared);
+        manifold.normal = Vector3(dx / distance, 0.0f, dz / distance);
+        const float penetration = b.radius - distance;
+        const float offset = penetration * 0.5f;
+        AddPoint(manifold, Vector3(closestX, overlapBottom, closestZ) - manifold.normal * offset, penetration, 0);
+        if (overlapTop - overlapBottom > kEpsilon) {
+            AddPoint(manifold, Vector3(closestX, overlapTop, closestZ) - manifold.normal * offset, penetration, 1);
+        }
+        return true;
+    }
+
+    // 線分がAABBを貫いている場合は一番浅い方向へ押し出す
+    const float candidates[6] = {
+        (b.center.x - a.min.x) + b.radius,      // -X
+        (a.max.x - b.center.x) + b.radius,      // +X
+        (segmentTop - a.min.y) + b.radius,      // -Y
+        (a.max.y - segmentBottom) + b.radius,   // +Y
+        (b.center.z - a.min.z) + b.radius,      // -Z
+        (a.max.z - b.center.z) + b.radius,      // +Z
+    };
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < 6; ++i) {
+        if (candidates[i] < candidates[best]) {
+            best = i;
+        }
+    }
+    const int axis = static_cast<int>(best / 2);
+    const float sign = (best & 1) ? 1.0f : -1.0f;
+    manifold.normal = Vector3(0.0f);
+    SetAxis(manifold.normal, axis, sign);
+    if (axis == 1) {
+        AddPoint(manifold, Vector3(b.center.x, sign > 0.0f ? segmentBottom : segmentTop, b.center.z), candidates[best], 2 + best);
+    } else {
+        AddPoint(manifold, Vector3(b.center.x, overlapBottom, b.center.z), candidates[best], 2 + best);
+        if (overlapTop - overlapBottom > kEpsilon) {
+            AddPoint(manifold, Vector3(b.center.x, overlapTop, b.center.z), candidates[best], 8 + best);
+        }
+    }
+    return true;
+}
+
+bool Generate(const CapsuleY &a, const CapsuleY &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    const float overlapBottom = (std::max)(a.center.y - a.halfHeight, b.center.y - b.halfHeight);
+    const float overlapTop = (std::min)(a.center.y + a.halfHeight, b.center.y + b.halfHeight);
+
+    if (overlapBottom > overlapTop) {
+        // 高さ方向に重なりが無い場合は向かい合う端同士を球として判定する
+        const bool isAAbove = a.center.y > b.center.y;
+        const Vector3 endA(a.center.x, isAAbove ? a.center.y - a.halfHeight : a.center.y + a.halfHeight, a.center.z);
+        const Vector3 endB(b.center.x, isAAbove ? b.center.y + b.halfHeight : b.center.y - b.halfHeight, b.center.z);
+        return Generate(Math::Sphere(endA, a.radius), Math::Sphere(endB, b.radius), manifold);
+    }
+
+    // 線分同士が平行なのでXZ平面上の円同士で判定する
+    const float dx = b.center.x - a.center.x;
+    const float dz = b.center.z - a.center.z;
+    const float radiusSum = a.radius + b.radius;
+    const float distanceSquared = dx * dx + dz * dz;
+    if (distanceSquared > radiusSum * radiusSum) {
+        return false;
+    }
+    const float distance = std::sqrt(distanceSquared);
+    manifold.normal = distance > kEpsilon ? Vector3(dx / distance, 0.0f, dz / distance) : Vector3(1.0f, 0.0f, 0.0f);
+    const float penetration = radiusSum - distance;
+    const float offset = a.radius - penetration * 0.5f;
+    AddPoint(manifold, Vector3(a.center.x, overlapBottom, a.center.z) + manifold.normal * offset, penetration, 0);
+    if (overlapTop - overlapBottom > kEpsilon) {
+        AddPoint(manifold, Vector3(a.center.x, overlapTop, a.center.z) + manifold.normal * offset, penetration, 1);
+    }
+    return true;
+}
+
+bool Generate(const CapsuleY &a, const Math::Plane &b, ContactManifold &manifold) {
+    manifold.pointCount = 0;
+    manifold.normal = -b.normal;
+    // 線分の両端の球をそれぞれ平面と判定する
+    for (uint32_t i = 0; i < 2; ++i) {
+        const Vector3 end(a.center.x, a.center.y + (i == 0 ? -a.halfHeight : a.halfHeight), a.center.z);
+        const float signedDistance = b.normal.Dot(end) - b.distance;
+        if (signedDistance > a.radius) {
+            continue;
+        }
+        AddPoint(manifold, end - b.normal * ((a.radius + signedDistance) * 0.5f), a.radius - signedDistance, i);
+    }
+    return manifold.pointCount > 0;
+}
+
+void Flip(ContactManifold &manifold) {
+    manifold.normal = -manifold.normal;
+}
+
+} // namespace ContactGenerator
+
+} // namespace KashipanEngine
\ No newline at end of file
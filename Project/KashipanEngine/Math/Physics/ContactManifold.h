@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include "Math/Vector3.h"
+
+namespace KashipanEngine {
+
+namespace Math {
+struct Sphere;
+struct Plane;
+struct AABB;
+} // namespace Math
+
+/// @brief Y軸に沿ったカプセル
+struct CapsuleY {
+    // 中心位置
+    Vector3 center;
+    // 中心から線分の端までの長さ
+    float halfHeight;
+    // 半径
+    float radius;
+};
+
+/// @brief 接触点
+struct ContactPoint {
+    // 接触位置
+    Vector3 position;
+    // めり込み量
+    float penetration;
+    // ウォームスタート用の特徴ID
+    uint32_t featureId;
+};
+
+/// @brief 接触情報(マニフォールド)
+struct ContactManifold {
+    // 最大接触点数
+    static constexpr uint32_t kMaxPoints = 4;
+
+    // AからBへ向かう法線
+    Vector3 normal;
+    // 接触点
+    ContactPoint points[kMaxPoints];
+    // 接触点の数
+    uint32_t pointCount = 0;
+};
+
+namespace ContactGenerator {
+
+/// @brief 球と球の接触生成
+/// @param a 球A
+/// @param b 球B
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::Sphere &a, const Math::Sphere &b, ContactManifold &manifold);
+
+/// @brief 球と平面の接触生成
+/// @param a 球
+/// @param b 平面
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::Sphere &a, const Math::Plane &b, ContactManifold &manifold);
+
+/// @brief 球とAABBの接触生成
+/// @param a 球
+/// @param b AABB
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::Sphere &a, const Math::AABB &b, ContactManifold &manifold);
+
+/// @brief 球とカプセルの接触生成
+/// @param a 球
+/// @param b カプセル
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::Sphere &a, const CapsuleY &b, ContactManifold &manifold);
+
+/// @brief AABBとAABBの接触生成
+/// @param a AABB A
+/// @param b AABB B
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::AABB &a, const Math::AABB &b, ContactManifold &manifold);
+
+/// @brief AABBと平面の接触生成
+/// @param a AABB
+/// @param b 平面
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::AABB &a, const Math::Plane &b, ContactManifold &manifold);
+
+/// @brief AABBとカプセルの接触生成
+/// @param a AABB
+/// @param b カプセル
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const Math::AABB &a, const CapsuleY &b, ContactManifold &manifold);
+
+/// @brief カプセルとカプセルの接触生成
+/// @param a カプセルA
+/// @param b カプセルB
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const CapsuleY &a, const CapsuleY &b, ContactManifold &manifold);
+
+/// @brief カプセルと平面の接触生成
+/// @param a カプセル
+/// @param b 平面
+/// @param manifold 接触情報の出力先
+/// @return 接触しているかどうか
+bool Generate(const CapsuleY &a, const Math::Plane &b, ContactManifold &manifold);
+
+/// @brief 接触情報の法線を反転する(A,Bの入れ替え)
+/// @param manifold 反転する接触情報
+void Flip(ContactManifold &manifold);
+
+} // namespace ContactGenerator
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,710 @@
+#include "PhysicsWorld.h"
+#include "Math/MathObjects/Sphere.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace KashipanEngine {
+
+namespace {
+
+// めり込みの許容量
+const float kAllowedPenetration = 0.01f;
+// めり込み補正の強さ
+const float kBaumgarte = 0.2f;
+// 反発を適用する最低の衝突速度
+const float kRestitutionThreshold = 1.0f;
+// スイープ&プルーンの軸を切り替える、今の軸に対するばらつきの比
+const float kSweepAxisSwitchRatio = 1.5f;
+
+/// @brief ペアのキーを作成する
+uint64_t MakePairKey(uint32_t idA, uint32_t idB) {
+    return (static_cast<uint64_t>(idA) << 32) | static_cast<uint64_t>(idB);
+}
+
+/// @brief 接触情報のキーを取得する
+uint64_t GetPairKey(const PhysicsContact &contact) {
+    return MakePairKey(contact.bodyA, contact.bodyB);
+}
+
+/// @brief 法線に垂直な2つの接線を求める
+void ComputeTangents(const Vector3 &normal, Vector3 &tangent1, Vector3 &tangent2) {
+    if (std::abs(normal.x) >= 0.57735f) {
+        tangent1 = Vector3(normal.y, -normal.x, 0.0f).Normalize();
+    } else {
+        tangent1 = Vector3(0.0f, normal.z, -normal.y).Normalize();
+    }
+    tangent2 = normal.Cross(tangent1);
+}
+
+/// @brief 軸の成分を取得する
+float GetAxis(const Vector3 &vector, int axis) {
+    return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+}
+
+/// @brief FNV-1aでハッシュを計算する
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+PhysicsWorld::PhysicsWorld(float fixedTimeStep, uint32_t maxSubSteps) :
+    fixedTimeStep_(fixedTimeStep), timestep_(1.0 / static_cast<double>(fixedTimeStep), maxSubSteps) {
+    assert(fixedTimeStep_ > 0.0f);
+    assert(maxSubSteps > 0);
+}
+
+uint32_t PhysicsWorld::AddBody(const RigidBodyDesc &desc) {
+    uint32_t id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        id = static_cast<uint32_t>(idToIndex_.size());
+        idToIndex_.push_back(kInvalidBody);
+    }
+    assert((id & kPlaneFlag) == 0);
+    idToIndex_[id] = static_cast<uint32_t>(ids_.size());
+
+    ids_.push_back(id);
+    positions_.push_back(desc.position);
+    velocities_.push_back(desc.mass > 0.0f ? desc.velocity : Vector3(0.0f));
+    forces_.push_back(Vector3(0.0f));
+    inverseMasses_.push_back(desc.mass > 0.0f ? 1.0f / desc.mass : 0.0f);
+    shapes_.push_back(desc.shape);
+    radii_.push_back(desc.radius);
+    halfHeights_.push_back(desc.halfHeight);
+    restitutions_.push_back(desc.restitution);
+    frictions_.push_back(desc.friction);
+    sleepTimers_.push_back(0.0f);
+    isAwake_.push_back(desc.mass > 0.0f ? 1 : 0);
+
+    // 境界箱計算用の半分の大きさ
+    switch (desc.shape) {
+        case RigidBodyShape::kSphere:
+            halfExtents_.push_back(Vector3(desc.radius));
+            break;
+        case RigidBodyShape::kAABB:
+            halfExtents_.push_back(desc.halfExtents);
+            break;
+        case RigidBodyShape::kCapsule:
+            halfExtents_.push_back(Vector3(desc.radius, desc.halfHeight + desc.radius, desc.radius));
+            break;
+    }
+    return id;
+}
+
+void PhysicsWorld::RemoveBody(uint32_t id) {
+    const uint32_t index = GetIndex(id);
+    const uint32_t last = static_cast<uint32_t>(ids_.size()) - 1;
+
+    // 末尾の剛体と入れ替えてから削除する
+    if (index != last) {
+        ids_[index] = ids_[last];
+        positions_[index] = positions_[last];
+        velocities_[index] = velocities_[last];
+        forces_[index] = forces_[last];
+        inverseMasses_[index] = inverseMasses_[last];
+        shapes_[index] = shapes_[last];
+        halfExtents_[index] = halfExtents_[last];
+        radii_[index] = radii_[last];
+        halfHeights_[index] = halfHeights_[last];
+        restitutions_[index] = restitutions_[last];
+        frictions_[index] = frictions_[last];
+        sleepTimers_[index] = sleepTimers_[last];
+        isAwake_[index] = isAwake_[last];
+        idToIndex_[ids_[index]] = index;
+    }
+    ids_.pop_back();
+    positions_.pop_back();
+    velocities_.pop_back();
+    forces_.pop_back();
+    inverseMasses_.pop_back();
+    shapes_.pop_back();
+    halfExtents_.pop_back();
+    radii_.pop_back();
+    halfHeights_.pop_back();
+    restitutions_.pop_back();
+    frictions_.pop_back();
+    sleepTimers_.pop_back();
+    isAwake_.pop_back();
+
+    idToIndex_[id] = kInvalidBody;
+    freeIds_.push_back(id);
+
+    // 削除した剛体の接触情報を破棄する
+    auto removeContacts = [id](std::vector<PhysicsContact> &contacts) {
+        contacts.erase(std::remove_if(contacts.begin(), contacts.end(),
+            [id](const PhysicsContact &c) { return c.bodyA == id || c.bodyB == id; }), contacts.end());
+    };
+    removeContacts(contacts_);
+    removeContacts(previousContacts_);
+}
+
+uint32_t PhysicsWorld::AddPlane(const Math::Plane &plane) {
+    planes_.push_back(plane);
+    return static_cast<uint32_t>(planes_.size()) - 1;
+}
+
+void PhysicsWorld::Clear() {
+    ids_.clear();
+    positions_.clear();
+    velocities_.clear();
+    forces_.clear();
+    inverseMasses_.clear();
+    shapes_.clear();
+    halfExtents_.clear();
+    radii_.clear();
+    halfHeights_.clear();
+    restitutions_.clear();
+    frictions_.clear();
+    sleepTimers_.clear();
+    isAwake_.clear();
+    idToIndex_.clear();
+    freeIds_.clear();
+    planes_.clear();
+    contacts_.clear();
+    previousContacts_.clear();
+    sortedIndices_.clear();
+    timestep_.Reset();
+    islandCount_ = 0;
+}
+
+uint32_t PhysicsWorld::Update(float deltaTime) {
+    // 処理が追いつかない分の時間は FixedTimestep が捨てる
+    const uint32_t stepCount = timestep_.Advance(deltaTime);
+    for (uint32_t i = 0; i < stepCount; ++i) {
+        StepFixed();
+    }
+    return stepCount;
+}
+
+void PhysicsWorld::StepFixed() {
+    const float deltaTime = fixedTimeStep_;
+    IntegrateVelocities(deltaTime);
+    BroadPhase();
+    NarrowPhase();
+    PrepareConstraints(deltaTime);
+    SolveVelocities();
+    IntegratePositions(deltaTime);
+    UpdateSleep(deltaTime);
+}
+
+const Vector3 &PhysicsWorld::GetPosition(uint32_t id) const {
+    return positions_[GetIndex(id)];
+}
+
+void PhysicsWorld::SetPosition(uint32_t id, const Vector3 &position) {
+    const uint32_t index = GetIndex(id);
+    positions_[index] = position;
+    WakeUp(id);
+}
+
+const Vector3 &PhysicsWorld::GetVelocity(uint32_t id) const {
+    return velocities_[GetIndex(id)];
+}
+
+void PhysicsWorld::SetVelocity(uint32_t id, const Vector3 &velocity) {
+    const uint32_t index = GetIndex(id);
+    if (!IsDynamic(index)) {
+        return;
+    }
+    velocities_[index] = velocity;
+    WakeUp(id);
+}
+
+void PhysicsWorld::AddForce(uint32_t id, const Vector3 &force) {
+    const uint32_t index = GetIndex(id);
+    if (!IsDynamic(index)) {
+        return;
+    }
+    forces_[index] += force;
+    WakeUp(id);
+}
+
+void PhysicsWorld::AddImpulse(uint32_t id, const Vector3 &impulse) {
+    const uint32_t index = GetIndex(id);
+    if (!IsDynamic(index)) {
+        return;
+    }
+    velocities_[index] += impulse * inverseMasses_[index];
+    WakeUp(id);
+}
+
+Math::AABB PhysicsWorld::GetBounds(uint32_t id) const {
+    const uint32_t index = GetIndex(id);
+    return Math::AABB(positions_[index] - halfExtents_[index], positions_[index] + halfExtents_[index]);
+}
+
+void PhysicsWorld::WakeUp(uint32_t id) {
+    const uint32_t index = GetIndex(id);
+    if (!IsDynamic(index)) {
+        return;
+    }
+    isAwake_[index] = 1;
+    sleepTimers_[index] = 0.0f;
+}
+
+bool PhysicsWorld::IsSleeping(uint32_t id) const {
+    const uint32_t index = GetIndex(id);
+    return IsDynamic(index) && !IsAwake(index);
+}
+
+bool PhysicsWorld::IsValid(uint32_t id) const {
+    return id < idToIndex_.size() && idToIndex_[id] != kInvalidBody;
+}
+
+uint32_t PhysicsWorld::GetAwakeBodyCount() const {
+    return static_cast<uint32_t>(std::count(isAwake_.begin(), isAwake_.end(), static_cast<uint8_t>(1)));
+}
+
+uint64_t PhysicsWorld::ComputeStateHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashBytes(hash, ids_.data(), ids_.size() * sizeof(uint32_t));
+    hash = HashBytes(hash, positions_.data(), positions_.size() * sizeof(Vector3));
+    hash = HashBytes(hash, velocities_.data(), velocities_.size() * sizeof(Vector3));
+    hash = HashBytes(hash, isAwake_.data(), isAwake_.size() * sizeof(uint8_t));
+    return hash;
+}
+
+void PhysicsWorld::SetSleepEnabled(bool isEnabled) {
+    isSleepEnabled_ = isEnabled;
+    if (isSleepEnabled_) {
+        return;
+    }
+    // 無効にした場合は全ての剛体を起こす
+    for (uint32_t i = 0; i < ids_.size(); ++i) {
+        if (IsDynamic(i)) {
+            isAwake_[i] = 1;
+            sleepTimers_[i] = 0.0f;
+        }
+    }
+}
+
+uint32_t PhysicsWorld::GetIndex(uint32_t id) const {
+    assert(IsValid(id));
+    return idToIndex_[id];
+}
+
+void PhysicsWorld::IntegrateVelocities(float deltaTime) {
+    const float damping = 1.0f / (1.0f + deltaTime * linearDamping_);
+    const size_t count = ids_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!isAwake_[i]) {
+            continue;
+        }
+        velocities_[i] += (gravity_ + forces_[i] * inverseMasses_[i]) * deltaTime;
+        velocities_[i] *= damping;
+        forces_[i] = Vector3(0.0f);
+    }
+}
+
+void PhysicsWorld::BroadPhase() {
+    const uint32_t count = static_cast<uint32_t>(ids_.size());
+    boundsMin_.resize(count);
+    boundsMax_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        boundsMin_[i] = positions_[i] - halfExtents_[i];
+        boundsMax_[i] = positions_[i] + halfExtents_[i];
+    }
+
+    // 中心のばらつきが最も大きい軸でスイープ&プルーンする。
+    // 積み上げた剛体は水平の軸に並べるとほぼ全てのペアが候補になるため、軸は毎ステップ選び直す。
+    // ばらつきが拮抗している間に軸が行き来すると毎回並べ直しになるので、今の軸より十分大きい場合だけ切り替える
+    const int previousAxis = sweepAxis_;
+    if (count > 0) {
+        Vector3 sum(0.0f);
+        Vector3 squaredSum(0.0f);
+        for (uint32_t i = 0; i < count; ++i) {
+            const Vector3 &center = positions_[i];
+            sum.x += center.x;
+            sum.y += center.y;
+            sum.z += center.z;
+            squaredSum.x += center.x * center.x;
+            squaredSum.y += center.y * center.y;
+            squaredSum.z += center.z * center.z;
+        }
+        const float inverseCount = 1.0f / static_cast<float>(count);
+        const float varianceX = squaredSum.x - sum.x * sum.x * inverseCount;
+        const float varianceY = squaredSum.y - sum.y * sum.y * inverseCount;
+        const float varianceZ = squaredSum.z - sum.z * sum.z * inverseCount;
+        const float variances[3] = { varianceX, varianceY, varianceZ };
+        const int largestAxis = varianceX >= varianceY ? (varianceX >= varianceZ ? 0 : 2) : (varianceY >= varianceZ ? 1 : 2);
+        // 剛体が増減したステップはどのみち並べ直すので、そのまま最も大きい軸にする
+        if (sortedIndices_.size() != count || variances[largestAxis] > variances[sweepAxis_] * kSweepAxisSwitchRatio) {
+            sweepAxis_ = largestAxis;
+        }
+    }
+    const int axis = sweepAxis_;
+    auto isLess = [this, axis](uint32_t l, uint32_t r) {
+        const float minL = GetAxis(boundsMin_[l], axis);
+        const float minR = GetAxis(boundsMin_[r], axis);
+        if (minL != minR) {
+            return minL < minR;
+        }
+        return ids_[l] < ids_[r];
+    };
+    if (sortedIndices_.size() != count || sweepAxis_ != previousAxis) {
+        // 剛体が増減した場合と軸が変わった場合は、前の順番が使えないので並べ直す
+        sortedIndices_.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            sortedIndices_[i] = i;
+        }
+        std::sort(sortedIndices_.begin(), sortedIndices_.end(), isLess);
+    } else {
+        // 前のステップの順番からの挿入ソート。ほぼ並んでいるのでほぼ線形時間で済む
+        for (uint32_t s = 1; s < count; ++s) {
+            const uint32_t index = sortedIndices_[s];
+            uint32_t t = s;
+            while (t > 0 && isLess(index, sortedIndices_[t - 1])) {
+                sortedIndices_[t] = sortedIndices_[t - 1];
+                --t;
+            }
+            sortedIndices_[t] = index;
+        }
+    }
+
+    pairs_.clear();
+    for (uint32_t s = 0; s < count; ++s) {
+        const uint32_t a = sortedIndices_[s];
+        const float maxA = GetAxis(boundsMax_[a], axis);
+        for (uint32_t t = s + 1; t < count; ++t) {
+            const uint32_t b = sortedIndices_[t];
+            if (GetAxis(boundsMin_[b], axis) > maxA) {
+                break;
+            }
+            // 起きている動的な剛体を含まないペアは判定しない
+            if (!IsAwake(a) && !IsAwake(b)) {
+                continue;
+            }
+            if (boundsMin_[a].x > boundsMax_[b].x || boundsMax_[a].x < boundsMin_[b].x ||
+                boundsMin_[a].y > boundsMax_[b].y || boundsMax_[a].y < boundsMin_[b].y ||
+                boundsMin_[a].z > boundsMax_[b].z || boundsMax_[a].z < boundsMin_[b].z) {
+                continue;
+            }
+            pairs_.push_back({ a, b });
+        }
+    }
+}
+
+void PhysicsWorld::NarrowPhase() {
+    std::swap(previousContacts_, contacts_);
+    contacts_.clear();
+
+    PhysicsContact contact{};
+    for (const auto &pair : pairs_) {
+        // 形状の種類順、同じ種類ならID順にして組み合わせを一意にする
+        uint32_t indexA = pair.indexA;
+        uint32_t indexB = pair.indexB;
+        if (shapes_[indexA] > shapes_[indexB] ||
+            (shapes_[indexA] == shapes_[indexB] && ids_[indexA] > ids_[indexB])) {
+            std::swap(indexA, indexB);
+        }
+        if (!GenerateContact(indexA, indexB, contact.manifold)) {
+            continue;
+        }
+        contact.bodyA = ids_[indexA];
+        contact.bodyB = ids_[indexB];
+        contacts_.push_back(contact);
+    }
+
+    // 平面との接触
+    const uint32_t count = static_cast<uint32_t>(ids_.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!IsAwake(i)) {
+            continue;
+        }
+        const Vector3 &position = positions_[i];
+        for (uint32_t p = 0; p < planes_.size(); ++p) {
+            const Math::Plane &plane = planes_[p];
+            bool isHit = false;
+            switch (shapes_[i]) {
+                case RigidBodyShape::kSphere:
+                    isHit = ContactGenerator::Generate(Math::Sphere(position, radii_[i]), plane, contact.manifold);
+                    break;
+                case RigidBodyShape::kAABB:
+                    isHit = ContactGenerator::Generate(Math::AABB(boundsMin_[i], boundsMax_[i]), plane, contact.manifold);
+                    break;
+                case RigidBodyShape::kCapsule:
+                    isHit = ContactGenerator::Generate(CapsuleY{ position, halfHeights_[i], radii_[i] }, plane, contact.manifold);
+                    break;
+            }
+            if (!isHit) {
+                continue;
+            }
+            contact.bodyA = ids_[i];
+            contact.bodyB = kPlaneFlag | p;
+            contacts_.push_back(contact);
+        }
+    }
+
+    // 解く順番を固定するためキー順に並べる
+    std::sort(contacts_.begin(), contacts_.end(), [](const PhysicsContact &l, const PhysicsContact &r) {
+        return GetPairKey(l) < GetPairKey(r);
+    });
+    for (auto &c : contacts_) {
+        WarmStart(c, previousContacts_);
+    }
+}
+
+bool PhysicsWorld::GenerateContact(uint32_t indexA, uint32_t indexB, ContactManifold &manifold) const {
+    const Vector3 &positionA = positions_[indexA];
+    const Vector3 &positionB = positions_[indexB];
+    const Math::Sphere sphereA(positionA, radii_[indexA]);
+    const Math::Sphere sphereB(positionB, radii_[indexB]);
+    const Math::AABB aabbA(boundsMin_[indexA], boundsMax_[indexA]);
+    const Math::AABB aabbB(boundsMin_[indexB], boundsMax_[indexB]);
+    const CapsuleY capsuleA{ positionA, halfHeights_[indexA], radii_[indexA] };
+    const CapsuleY capsuleB{ positionB, halfHeights_[indexB], radii_[indexB] };
+
+    switch (shapes_[indexA]) {
+        case RigidBodyShape::kSphere:
+            switch (shapes_[indexB]) {
+                case RigidBodyShape::kSphere:
+                    return ContactGenerator::Generate(sphereA, sphereB, manifold);
+                case RigidBodyShape::kAABB:
+                    return ContactGenerator::Generate(sphereA, aabbB, manifold);
+                case RigidBodyShape::kCapsule:
+                    return ContactGenerator::Generate(sphereA, capsuleB, manifold);
+            }
+            break;
+        case RigidBodyShape::kAABB:
+            switch (shapes_[indexB]) {
+                case RigidBodyShape::kAABB:
+                    return ContactGenerator::Generate(aabbA, aabbB, manifold);
+                case RigidBodyShape::kCapsule:
+                    return ContactGenerator::Generate(aabbA, capsuleB, manifold);
+                default:
+                    break;
+            }
+            break;
+        case RigidBodyShape::kCapsule:
+            if (shapes_[indexB] == RigidBodyShape::kCapsule) {
+                return ContactGenerator::Generate(capsuleA, capsuleB, manifold);
+            }
+            break;
+    }
+    return false;
+}
+
+void PhysicsWorld::WarmStart(PhysicsContact &contact, const std::vector<PhysicsContact> &previous) const {
+    for (uint32_t i = 0; i < contact.manifold.pointCount; ++i) {
+        contact.normalImpulses[i] = 0.0f;
+        contact.tangentImpulses[i][0] = 0.0f;
+        contact.tangentImpulses[i][1] = 0.0f;
+    }
+
+    // 前のステップで同じペアの接触があれば、同じ特徴の接触点の撃力を引き継ぐ
+    const uint64_t key = GetPairKey(contact);
+    auto it = std::lower_bound(previous.begin(), previous.end(), key, [](const PhysicsContact &c, uint64_t k) {
+        return GetPairKey(c) < k;
+    });
+    if (it == previous.end() || GetPairKey(*it) != key) {
+        return;
+    }
+    for (uint32_t i = 0; i < contact.manifold.pointCount; ++i) {
+        for (uint32_t j = 0; j < it->manifold.pointCount; ++j) {
+            if (contact.manifold.points[i].featureId != it->manifold.points[j].featureId) {
+                continue;
+            }
+            contact.normalImpulses[i] = it->normalImpulses[j];
+            contact.tangentImpulses[i][0] = it->tangentImpulses[j][0];
+            contact.tangentImpulses[i][1] = it->tangentImpulses[j][1];
+            break;
+        }
+    }
+}
+
+void PhysicsWorld::PrepareConstraints(float deltaTime) {
+    constraints_.resize(contacts_.size());
+    for (size_t c = 0; c < contacts_.size(); ++c) {
+        PhysicsContact &contact = contacts_[c];
+        ContactConstraint &constraint = constraints_[c];
+        const bool isPlane = (contact.bodyB & kPlaneFlag) != 0;
+        constraint.indexA = idToIndex_[contact.bodyA];
+        constraint.indexB = isPlane ? kInvalidBody : idToIndex_[contact.bodyB];
+
+        const float inverseMassA = inverseMasses_[constraint.indexA];
+        const float inverseMassB = isPlane ? 0.0f : inverseMasses_[constraint.indexB];
+        const float inverseMassSum = inverseMassA + inverseMassB;
+        constraint.mass = inverseMassSum > 0.0f ? 1.0f / inverseMassSum : 0.0f;
+
+        const float frictionB = isPlane ? frictions_[constraint.indexA] : frictions_[constraint.indexB];
+        const float restitutionB = isPlane ? restitutions_[constraint.indexA] : restitutions_[constraint.indexB];
+        constraint.friction = std::sqrt(frictions_[constraint.indexA] * frictionB);
+        const float restitution = (std::max)(restitutions_[constraint.indexA], restitutionB);
+
+        const Vector3 &normal = contact.manifold.normal;
+        ComputeTangents(normal, constraint.tangents[0], constraint.tangents[1]);
+
+        const Vector3 velocityB = isPlane ? Vector3(0.0f) : velocities_[constraint.indexB];
+        const Vector3 relativeVelocity = velocityB - velocities_[constraint.indexA];
+        const float normalVelocity = relativeVelocity.Dot(normal);
+
+        for (uint32_t i = 0; i < contact.manifold.pointCount; ++i) {
+            // めり込み補正と反発のうち大きい方を目標速度にする
+            const float penetration = contact.manifold.points[i].penetration;
+            const float positionBias = kBaumgarte / deltaTime * (std::max)(penetration - kAllowedPenetration, 0.0f);
+            const float restitutionBias = normalVelocity < -kRestitutionThreshold ? -restitution * normalVelocity : 0.0f;
+            constraint.velocityBias[i] = (std::max)(positionBias, restitutionBias);
+
+            // ウォームスタート
+            const Vector3 impulse = normal * contact.normalImpulses[i] +
+                constraint.tangents[0] * contact.tangentImpulses[i][0] +
+                constraint.tangents[1] * contact.tangentImpulses[i][1];
+            velocities_[constraint.indexA] -= impulse * inverseMassA;
+            if (!isPlane) {
+                velocities_[constraint.indexB] += impulse * inverseMassB;
+            }
+        }
+    }
+}
+
+void PhysicsWorld::SolveVelocities() {
+    const Vector3 zero(0.0f);
+    for (uint32_t iteration = 0; iteration < solverIterations_; ++iteration) {
+        for (size_t c = 0; c < contacts_.size(); ++c) {
+            PhysicsContact &contact = contacts_[c];
+            const ContactConstraint &constraint = constraints_[c];
+            if (constraint.mass == 0.0f) {
+                continue;
+            }
+            const bool isPlane = constraint.indexB == kInvalidBody;
+            Vector3 &velocityA = velocities_[constraint.indexA];
+            const float inverseMassA = inverseMasses_[constraint.indexA];
+            const float inverseMassB = isPlane ? 0.0f : inverseMasses_[constraint.indexB];
+            const Vector3 &normal = contact.manifold.normal;
+
+            for (uint32_t i = 0; i < contact.manifold.pointCount; ++i) {
+                const Vector3 &velocityB = isPlane ? zero : velocities_[constraint.indexB];
+
+                // 法線方向
+                {
+                    const float normalVelocity = (velocityB - velocityA).Dot(normal);
+                    float lambda = constraint.mass * (constraint.velocityBias[i] - normalVelocity);
+                    const float oldImpulse = contact.normalImpulses[i];
+                    contact.normalImpulses[i] = (std::max)(oldImpulse + lambda, 0.0f);
+                    lambda = contact.normalImpulses[i] - oldImpulse;
+                    const Vector3 impulse = normal * lambda;
+                    velocityA -= impulse * inverseMassA;
+                    if (!isPlane) {
+                        velocities_[constraint.indexB] += impulse * inverseMassB;
+                    }
+                }
+
+                // 接線方向(摩擦)
+                const float maxFriction = constraint.friction * contact.normalImpulses[i];
+                for (uint32_t t = 0; t < 2; ++t) {
+                    const Vector3 &tangent = constraint.tangents[t];
+                    const Vector3 &currentVelocityB = isPlane ? zero : velocities_[constraint.indexB];
+                    const float tangentVelocity = (currentVelocityB - velocityA).Dot(tangent);
+                    float lambda = -constraint.mass * tangentVelocity;
+                    const float oldImpulse = contact.tangentImpulses[i][t];
+                    contact.tangentImpulses[i][t] = std::clamp(oldImpulse + lambda, -maxFriction, maxFriction);
+                    lambda = contact.tangentImpulses[i][t] - oldImpulse;
+                    const Vector3 impulse = tangent * lambda;
+                    velocityA -= impulse * inverseMassA;
+                    if (!isPlane) {
+                        velocities_[constraint.indexB] += impulse * inverseMassB;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void PhysicsWorld::IntegratePositions(float deltaTime) {
+    const size_t count = ids_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!isAwake_[i]) {
+            continue;
+        }
+        positions_[i] += velocities_[i] * deltaTime;
+    }
+}
+
+void PhysicsWorld::UpdateSleep(float deltaTime) {
+    const uint32_t count = static_cast<uint32_t>(ids_.size());
+    const float sleepVelocitySquared = sleepVelocity_ * sleepVelocity_;
+
+    // 静止している時間の更新
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!IsDynamic(i) || !IsAwake(i)) {
+            continue;
+        }
+        if (velocities_[i].Dot(velocities_[i]) < sleepVelocitySquared) {
+            sleepTimers_[i] += deltaTime;
+        } else {
+            sleepTimers_[i] = 0.0f;
+        }
+    }
+
+    // 接触している動的な剛体同士をアイランドにまとめる
+    islandParents_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        islandParents_[i] = i;
+    }
+    for (const auto &contact : contacts_) {
+        if (contact.bodyB & kPlaneFlag) {
+            continue;
+        }
+        const uint32_t indexA = idToIndex_[contact.bodyA];
+        const uint32_t indexB = idToIndex_[contact.bodyB];
+        if (!IsDynamic(indexA) || !IsDynamic(indexB)) {
+            continue;
+        }
+        const uint32_t rootA = FindRoot(indexA);
+        const uint32_t rootB = FindRoot(indexB);
+        if (rootA != rootB) {
+            // 添え字の小さい方を根にして結果を決定的にする
+            islandParents_[(std::max)(rootA, rootB)] = (std::min)(rootA, rootB);
+        }
+    }
+
+    // アイランド内で一番短い静止時間を求める
+    islandSleepTimers_.assign(count, (std::numeric_limits<float>::max)());
+    islandCount_ = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!IsDynamic(i)) {
+            continue;
+        }
+        const uint32_t root = FindRoot(i);
+        if (root == i) {
+            ++islandCount_;
+        }
+        islandSleepTimers_[root] = (std::min)(islandSleepTimers_[root], sleepTimers_[i]);
+    }
+
+    // アイランド単位で眠らせるか起こすかを決める
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!IsDynamic(i)) {
+            continue;
+        }
+        const bool isSleep = isSleepEnabled_ && islandSleepTimers_[FindRoot(i)] >= timeToSleep_;
+        if (isSleep) {
+            isAwake_[i] = 0;
+            velocities_[i] = Vector3(0.0f);
+        } else if (!isAwake_[i]) {
+            // アイランドに起こされた剛体は、眠っていた間の静止時間を引き継がない
+            isAwake_[i] = 1;
+            sleepTimers_[i] = 0.0f;
+        }
+    }
+}
+
+uint32_t PhysicsWorld::FindRoot(uint32_t index) {
+    while (islandParents_[index] != index) {
+        islandParents_[index] = islandParents_[islandParents_[index]];
+        index = islandParents_[index];
+    }
+    return index;
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <FixedTimestep.h>
+#include "Math/Vector3.h"
+#include "Math/MathObjects/Plane.h"
+#include "Math/MathObjects/AABB.h"
+#include "Math/Physics/ContactManifold.h"
+
+namespace KashipanEngine {
+
+/// @brief 剛体の形状
+enum class RigidBodyShape : uint8_t {
+    kSphere,    // 球
+    kAABB,      // 軸平行境界箱
+    kCapsule,   // Y軸に沿ったカプセル
+};
+
+/// @brief 剛体の生成情報
+struct RigidBodyDesc {
+    // 形状
+    RigidBodyShape shape = RigidBodyShape::kSphere;
+    // 初期位置
+    Vector3 position = { 0.0f, 0.0f, 0.0f };
+    // 初期速度
+    Vector3 velocity = { 0.0f, 0.0f, 0.0f };
+    // 質量。0以下なら静的な剛体
+    float mass = 1.0f;
+    // 半径(球、カプセル)
+    float radius = 0.5f;
+    // 半分の大きさ(AABB)
+    Vector3 halfExtents = { 0.5f, 0.5f, 0.5f };
+    // 線分の半分の長さ(カプセル)
+    float halfHeight = 0.5f;
+    // 反発係数
+    float restitution = 0.0f;
+    // 摩擦係数
+    float friction = 0.5f;
+};
+
+/// @brief 剛体同士の接触情報
+struct PhysicsContact {
+    // 剛体AのID
+    uint32_t bodyA;
+    // 剛体BのID。平面の場合は PhysicsWorld::kPlaneFlag と平面番号の組み合わせ
+    uint32_t bodyB;
+    // 接触情報
+    ContactManifold manifold;
+    // 接触点ごとの法線方向の累積撃力
+    float normalImpulses[ContactManifold::kMaxPoints];
+    // 接触点ごとの接線方向の累積撃力
+    float tangentImpulses[ContactManifold::kMaxPoints][2];
+};
+
+/// @brief 固定ステップで剛体の接触を解決する物理ワールド
+class PhysicsWorld {
+public:
+    // 無効な剛体ID
+    static constexpr uint32_t kInvalidBody = 0xFFFFFFFFu;
+    // 接触相手が平面であることを表すフラグ
+    static constexpr uint32_t kPlaneFlag = 0x80000000u;
+
+    /// @brief コンストラクタ
+    /// @param fixedTimeStep 1ステップの時間
+    /// @param maxSubSteps 1回の更新で進める最大ステップ数
+    PhysicsWorld(float fixedTimeStep = 1.0f / 60.0f, uint32_t maxSubSteps = 4);
+    ~PhysicsWorld() = default;
+
+    /// @brief 剛体の追加
+    /// @param desc 生成情報
+    /// @return 剛体ID
+    uint32_t AddBody(const RigidBodyDesc &desc);
+
+    /// @brief 剛体の削除
+    /// @param id 剛体ID
+    void RemoveBody(uint32_t id);
+
+    /// @brief 静的な平面の追加。法線の裏側が中身として扱われる
+    /// @param plane 平面
+    /// @return 平面番号
+    uint32_t AddPlane(const Math::Plane &plane);
+
+    /// @brief 全剛体と平面の削除
+    void Clear();
+
+    /// @brief 経過時間分だけ固定ステップで更新する
+    /// @param deltaTime 前回の更新からの経過時間
+    /// @return 実行したステップ数
+    uint32_t Update(float deltaTime);
+
+    /// @brief 1ステップ分の更新
+    void StepFixed();
+
+    /// @brief 位置の取得
+    [[nodiscard]] const Vector3 &GetPosition(uint32_t id) const;
+    /// @brief 位置の設定
+    void SetPosition(uint32_t id, const Vector3 &position);
+    /// @brief 速度の取得
+    [[nodiscard]] const Vector3 &GetVelocity(uint32_t id) const;
+    /// @brief 速度の設定
+    void SetVelocity(uint32_t id, const Vector3 &velocity);
+    /// @brief 力を加える(次のステップで適用)
+    void AddForce(uint32_t id, const Vector3 &force);
+    /// @brief 撃力を加える
+    void AddImpulse(uint32_t id, const Vector3 &impulse);
+    /// @brief 境界箱の取得
+    [[nodiscard]] Math::AABB GetBounds(uint32_t id) const;
+
+    /// @brief 剛体を起こす
+    void WakeUp(uint32_t id);
+    /// @brief 剛体が眠っているかどうか
+    [[nodiscard]] bool IsSleeping(uint32_t id) const;
+    /// @brief 剛体が存在するかどうか
+    [[nodiscard]] bool IsValid(uint32_t id) const;
+
+    /// @brief 現在の接触情報の取得
+    [[nodiscard]] const std::vector<PhysicsContact> &GetContacts() const { return contacts_; }
+    /// @brief 剛体数の取得
+    [[nodiscard]] uint32_t GetBodyCount() const { return static_cast<uint32_t>(ids_.size()); }
+    /// @brief 起きている剛体数の取得
+    [[nodiscard]] uint32_t GetAwakeBodyCount() const;
+    /// @brief 直近のステップでのアイランド数の取得
+    [[nodiscard]] uint32_t GetIslandCount() const { return islandCount_; }
+    /// @brief 補間係数の取得(描画の補間用)
+    [[nodiscard]] float GetInterpolationAlpha() const { return static_cast<float>(timestep_.GetAlpha()); }
+
+    /// @brief 全剛体の状態のハッシュ値を計算する(再現性の確認用)
+    [[nodiscard]] uint64_t ComputeStateHash() const;
+
+    void SetGravity(const Vector3 &gravity) { gravity_ = gravity; }
+    void SetSolverIterations(uint32_t iterations) { solverIterations_ = iterations; }
+    void SetLinearDamping(float damping) { linearDamping_ = damping; }
+    void SetSleepEnabled(bool isEnabled);
+    void SetTimeToSleep(float time) { timeToSleep_ = time; }
+    void SetSleepVelocity(float velocity) { sleepVelocity_ = velocity; }
+
+private:
+    /// @brief 接触の拘束情報
+    struct ContactConstraint {
+        uint32_t indexA;
+        uint32_t indexB;
+        Vector3 tangents[2];
+        float mass;
+        float friction;
+        float velocityBias[ContactManifold::kMaxPoints];
+    };
+
+    /// @brief 候補ペア
+    struct BodyPair {
+        uint32_t indexA;
+        uint32_t indexB;
+    };
+
+    uint32_t GetIndex(uint32_t id) const;
+    bool IsDynamic(uint32_t index) const { return inverseMasses_[index] > 0.0f; }
+    bool IsAwake(uint32_t index) const { return isAwake_[index] != 0; }
+
+    void IntegrateVelocities(float deltaTime);
+    void BroadPhase();
+    void NarrowPhase();
+    bool GenerateContact(uint32_t indexA, uint32_t indexB, ContactManifold &manifold) const;
+    void WarmStart(PhysicsContact &contact, const std::vector<PhysicsContact> &previous) const;
+    void PrepareConstraints(float deltaTime);
+    void SolveVelocities();
+    void IntegratePositions(float deltaTime);
+    void UpdateSleep(float deltaTime);
+    uint32_t FindRoot(uint32_t index);
+
+    // 固定ステップの時間
+    float fixedTimeStep_;
+    // 経過時間をステップに分けるアキュムレータ
+    MyStd::FixedTimestep timestep_;
+
+    Vector3 gravity_ = { 0.0f, -9.8f, 0.0f };
+    uint32_t solverIterations_ = 8;
+    float linearDamping_ = 0.01f;
+    bool isSleepEnabled_ = true;
+    float timeToSleep_ = 0.5f;
+    float sleepVelocity_ = 0.05f;
+
+    //==================================================
+    // 剛体データ(SoA)
+    //==================================================
+
+    std::vector<uint32_t> ids_;
+    std::vector<Vector3> positions_;
+    std::vector<Vector3> velocities_;
+    std::vector<Vector3> forces_;
+    std::vector<float> inverseMasses_;
+    std::vector<RigidBodyShape> shapes_;
+    std::vector<Vector3> halfExtents_;
+    std::vector<float> radii_;
+    std::vector<float> halfHeights_;
+    std::vector<float> restitutions_;
+    std::vector<float> frictions_;
+    std::vector<float> sleepTimers_;
+    std::vector<uint8_t> isAwake_;
+
+    // IDから配列の添え字への変換表
+    std::vector<uint32_t> idToIndex_;
+    // 再利用可能なID
+    std::vector<uint32_t> freeIds_;
+
+    // 静的な平面
+    std::vector<Math::Plane> planes_;
+
+    //==================================================
+    // ステップ中の作業データ
+    //==================================================
+
+    std::vector<Vector3> boundsMin_;
+    std::vector<Vector3> boundsMax_;
+    // 前のステップで並べた順番(剛体はあまり動かないので、次のステップはこの順番から並べ直す)
+    std::vector<uint32_t> sortedIndices_;
+    // 並べる軸(0: X, 1: Y, 2: Z)
+    int sweepAxis_ = 0;
+    std::vector<BodyPair> pairs_;
+    std::vector<PhysicsContact> contacts_;
+    std::vector<PhysicsContact> previousContacts_;
+    std::vector<ContactConstraint> constraints_;
+    std::vector<uint32_t> islandParents_;
+    std::vector<float> islandSleepTimers_;
+    uint32_t islandCount_ = 0;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,425 @@
+#include "SpringSystem.h"
+#include "Common/VertexData.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace KashipanEngine {
+
+namespace {
+
+// 1つの作業単位で処理する要素数
+const size_t kChunkSize = 1024;
+// 色分けに使える最大の色数。超えた分は最後のバッチで逐次処理する
+const uint32_t kMaxColors = 64;
+// 長さが0とみなす閾値
+const float kEpsilon = 1.0e-6f;
+
+/// @brief 範囲を分割して並列に処理する
+/// @param count 要素数
+/// @param isParallel 並列で処理するかどうか
+/// @param function 範囲ごとの処理 (begin, end)
+template<typename Function>
+void ParallelFor(size_t count, bool isParallel, Function function) {
+    if (!isParallel || count <= kChunkSize) {
+        function(size_t(0), count);
+        return;
+    }
+    std::vector<size_t> chunks((count + kChunkSize - 1) / kChunkSize);
+    std::iota(chunks.begin(), chunks.end(), size_t(0));
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_t chunk) {
+        const size_t begin = chunk * kChunkSize;
+        function(begin, (std::min)(begin + kChunkSize, count));
+    });
+}
+
+/// @brief ビットが0の一番下の位置を求める
+uint32_t FindFirstZeroBit(uint64_t bits) {
+    uint32_t index = 0;
+    while (index < kMaxColors && (bits & (uint64_t(1) << index))) {
+        ++index;
+    }
+    return index;
+}
+
+} // namespace
+
+uint32_t SpringSystem::AddParticle(const Vector3 &position, float mass) {
+    positionX_.push_back(position.x);
+    positionY_.push_back(position.y);
+    positionZ_.push_back(position.z);
+    previousX_.push_back(position.x);
+    previousY_.push_back(position.y);
+    previousZ_.push_back(position.z);
+    inverseMass_.push_back(mass > 0.0f ? 1.0f / mass : 0.0f);
+    return static_cast<uint32_t>(positionX_.size()) - 1;
+}
+
+void SpringSystem::AddSpring(uint32_t particleA, uint32_t particleB, float restLength, float stiffness) {
+    assert(particleA < GetParticleCount() && particleB < GetParticleCount());
+    assert(particleA != particleB);
+    if (restLength < 0.0f) {
+        restLength = (GetPosition(particleA) - GetPosition(particleB)).Length();
+    }
+    springA_.push_back(particleA);
+    springB_.push_back(particleB);
+    restLength_.push_back(restLength);
+    compliance_.push_back(stiffness > 0.0f ? 1.0f / stiffness : 0.0f);
+    lambda_.push_back(0.0f);
+    isBatchDirty_ = true;
+}
+
+void SpringSystem::AddSpring(uint32_t particle, const Spring &spring) {
+    // アンカーは動かない質点として扱う
+    const uint32_t anchor = AddParticle(spring.anchor, 0.0f);
+    AddSpring(anchor, particle, spring.naturalLength, spring.stiffness);
+}
+
+uint32_t SpringSystem::CreateRope(const Vector3 &start, const Vector3 &end, uint32_t segmentCount,
+    float massPerParticle, float stiffness) {
+    assert(segmentCount > 0);
+    const uint32_t first = GetParticleCount();
+    for (uint32_t i = 0; i <= segmentCount; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(segmentCount);
+        AddParticle(Vector3::Lerp(start, end, t), massPerParticle);
+        if (i > 0) {
+            AddSpring(first + i - 1, first + i, -1.0f, stiffness);
+        }
+    }
+    return first;
+}
+
+ClothGrid SpringSystem::CreateCloth(const Vector3 &origin, const Vector3 &right, const Vector3 &down,
+    uint32_t width, uint32_t height, float massPerParticle, float stiffness) {
+    assert(width >= 2 && height >= 2);
+    ClothGrid grid{ GetParticleCount(), width, height };
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            AddParticle(origin + right * static_cast<float>(x) + down * static_cast<float>(y), massPerParticle);
+        }
+    }
+
+    auto index = [&grid](uint32_t x, uint32_t y) {
+        return grid.firstParticle + y * grid.width + x;
+    };
+    // 曲げのバネは少し柔らかくする
+    const float bendStiffness = stiffness > 0.0f ? stiffness * 0.5f : 0.0f;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            // 構造
+            if (x + 1 < width) {
+                AddSpring(index(x, y), index(x + 1, y), -1.0f, stiffness);
+            }
+            if (y + 1 < height) {
+                AddSpring(index(x, y), index(x, y + 1), -1.0f, stiffness);
+            }
+            // せん断
+            if (x + 1 < width && y + 1 < height) {
+                AddSpring(index(x, y), index(x + 1, y + 1), -1.0f, stiffness);
+                AddSpring(index(x + 1, y), index(x, y + 1), -1.0f, stiffness);
+            }
+            // 曲げ
+            if (x + 2 < width) {
+                AddSpring(index(x, y), index(x + 2, y), -1.0f, bendStiffness);
+            }
+            if (y + 2 < height) {
+                AddSpring(index(x, y), index(x, y + 2), -1.0f, bendStiffness);
+            }
+        }
+    }
+    return grid;
+}
+
+void SpringSystem::Pin(uint32_t particle) {
+    assert(particle < GetParticleCount());
+    inverseMass_[particle] = 0.0f;
+}
+
+void SpringSystem::Clear() {
+    positionX_.clear();
+    positionY_.clear();
+    positionZ_.clear();
+    previousX_.clear();
+    previousY_.clear();
+    previousZ_.clear();
+    inverseMass_.clear();
+    springA_.clear();
+    springB_.clear();
+    restLength_.clear();
+    compliance_.clear();
+    lambda_.clear();
+    batchOffsets_.clear();
+    sphereColliders_.clear();
+    planeColliders_.clear();
+    isBatchDirty_ = true;
+}
+
+void SpringSystem::Update(float deltaTime) {
+    if (deltaTime <= 0.0f || subSteps_ == 0) {
+        return;
+    }
+    if (isBatchDirty_) {
+        BuildBatches();
+    }
+
+    // 小さいステップに分けて1回ずつ解く
+    const float subDeltaTime = deltaTime / static_cast<float>(subSteps_);
+    for (uint32_t step = 0; step < subSteps_; ++step) {
+        Integrate(subDeltaTime);
+        SolveSprings(subDeltaTime);
+        SolveCollisions();
+    }
+}
+
+Vector3 SpringSystem::GetPosition(uint32_t particle) const {
+    return Vector3(positionX_[particle], positionY_[particle], positionZ_[particle]);
+}
+
+void SpringSystem::SetPosition(uint32_t particle, const Vector3 &position) {
+    positionX_[particle] = previousX_[particle] = position.x;
+    positionY_[particle] = previousY_[particle] = position.y;
+    positionZ_[particle] = previousZ_[particle] = position.z;
+}
+
+void SpringSystem::WriteClothVertices(const ClothGrid &grid, VertexData *vertices) const {
+    assert(vertices != nullptr);
+    const uint32_t width = grid.width;
+    const uint32_t height = grid.height;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t particle = grid.firstParticle + y * width + x;
+            VertexData &vertex = vertices[y * width + x];
+            vertex.position = { positionX_[particle], positionY_[particle], positionZ_[particle], 1.0f };
+            vertex.texCoord = {
+                static_cast<float>(x) / static_cast<float>(width - 1),
+                static_cast<float>(y) / static_cast<float>(height - 1)
+            };
+
+            // 隣の質点との差分から法線を求める
+            const uint32_t left = grid.firstParticle + y * width + (x > 0 ? x - 1 : x);
+            const uint32_t right = grid.firstParticle + y * width + (x + 1 < width ? x + 1 : x);
+            const uint32_t up = grid.firstParticle + (y > 0 ? y - 1 : y) * width + x;
+            const uint32_t down = grid.firstParticle + (y + 1 < height ? y + 1 : y) * width + x;
+            const Vector3 tangentX = GetPosition(right) - GetPosition(left);
+            const Vector3 tangentY = GetPosition(down) - GetPosition(up);
+            const Vector3 normal = tangentY.Cross(tangentX);
+            const float length = normal.Length();
+            vertex.normal = length > kEpsilon ? normal / length : Vector3(0.0f, 1.0f, 0.0f);
+        }
+    }
+}
+
+void SpringSystem::WriteClothIndices(const ClothGrid &grid, uint32_t *indices) {
+    assert(indices != nullptr);
+    uint32_t count = 0;
+    for (uint32_t y = 0; y + 1 < grid.height; ++y) {
+        for (uint32_t x = 0; x + 1 < grid.width; ++x) {
+            const uint32_t topLeft = y * grid.width + x;
+            const uint32_t topRight = topLeft + 1;
+            const uint32_t bottomLeft = topLeft + grid.width;
+            const uint32_t bottomRight = bottomLeft + 1;
+            indices[count++] = topLeft;
+            indices[count++] = topRight;
+            indices[count++] = bottomLeft;
+            indices[count++] = topRight;
+            indices[count++] = bottomRight;
+            indices[count++] = bottomLeft;
+        }
+    }
+}
+
+uint32_t SpringSystem::GetBatchCount() const {
+    return batchOffsets_.empty() ? 0 : static_cast<uint32_t>(batchOffsets_.size()) - 1;
+}
+
+void SpringSystem::BuildBatches() {
+    const size_t springCount = springA_.size();
+
+    // 同じ質点を共有しないようにバネを貪欲法で色分けする
+    std::vector<uint64_t> particleColors(GetParticleCount(), 0);
+    std::vector<uint32_t> springColors(springCount);
+    std::vector<size_t> colorCounts(kMaxColors + 1, 0);
+    for (size_t i = 0; i < springCount; ++i) {
+        const uint32_t a = springA_[i];
+        const uint32_t b = springB_[i];
+        const uint32_t color = FindFirstZeroBit(particleColors[a] | particleColors[b]);
+        if (color < kMaxColors) {
+            particleColors[a] |= uint64_t(1) << color;
+            particleColors[b] |= uint64_t(1) << color;
+        }
+        springColors[i] = color;
+        ++colorCounts[color];
+    }
+
+    // 色ごとの開始位置を求めて並べ替える
+    std::vector<size_t> offsets(kMaxColors + 2, 0);
+    for (uint32_t color = 0; color <= kMaxColors; ++color) {
+        offsets[color + 1] = offsets[color] + colorCounts[color];
+    }
+    std::vector<size_t> order(springCount);
+    {
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < springCount; ++i) {
+            order[cursor[springColors[i]]++] = i;
+        }
+    }
+    auto reorder = [&order](auto &values) {
+        auto sorted = values;
+        for (size_t i = 0; i < order.size(); ++i) {
+            sorted[i] = values[order[i]];
+        }
+        values.swap(sorted);
+    };
+    reorder(springA_);
+    reorder(springB_);
+    reorder(restLength_);
+    reorder(compliance_);
+    reorder(lambda_);
+
+    // 空の色を除いてバッチの区切りを保存する
+    batchOffsets_.clear();
+    batchOffsets_.push_back(0);
+    for (uint32_t color = 0; color <= kMaxColors; ++color) {
+        if (colorCounts[color] > 0) {
+            batchOffsets_.push_back(offsets[color + 1]);
+        }
+    }
+    isBatchDirty_ = false;
+}
+
+void SpringSystem::Integrate(float deltaTime) {
+    const float gravityX = gravity_.x * deltaTime * deltaTime;
+    const float gravityY = gravity_.y * deltaTime * deltaTime;
+    const float gravityZ = gravity_.z * deltaTime * deltaTime;
+    // 減衰は経過時間に比例させる(サブステップ数で効き方が変わらないように)
+    const float keep = 1.0f / (1.0f + deltaTime * damping_);
+    float *positionX = positionX_.data();
+    float *positionY = positionY_.data();
+    float *positionZ = positionZ_.data();
+    float *previousX = previousX_.data();
+    float *previousY = previousY_.data();
+    float *previousZ = previousZ_.data();
+    const float *inverseMass = inverseMass_.data();
+
+    // ベルレ積分。固定された質点は重み0で動かないようにする
+    ParallelFor(positionX_.size(), isParallel_, [=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float movable = inverseMass[i] > 0.0f ? 1.0f : 0.0f;
+            const float x = positionX[i];
+            const float y = positionY[i];
+            const float z = positionZ[i];
+            positionX[i] += movable * ((x - previousX[i]) * keep + gravityX);
+            positionY[i] += movable * ((y - previousY[i]) * keep + gravityY);
+            positionZ[i] += movable * ((z - previousZ[i]) * keep + gravityZ);
+            previousX[i] = x;
+            previousY[i] = y;
+            previousZ[i] = z;
+        }
+    });
+}
+
+void SpringSystem::SolveSprings(float deltaTime) {
+    std::fill(lambda_.begin(), lambda_.end(), 0.0f);
+    const float alphaScale = 1.0f / (deltaTime * deltaTime);
+
+    // 同じ色のバネは質点を共有しないので並列に解ける
+    const uint32_t batchCount = GetBatchCount();
+    for (uint32_t batch = 0; batch < batchCount; ++batch) {
+        const size_t begin = batchOffsets_[batch];
+        const size_t end = batchOffsets_[batch + 1];
+        // 色が足りずに溢れたバネ(最後のバッチ)は逐次処理する
+        const bool isOverflow = batch == kMaxColors;
+        ParallelFor(end - begin, isParallel_ && !isOverflow, [&](size_t rangeBegin, size_t rangeEnd) {
+            SolveSpringRange(begin + rangeBegin, begin + rangeEnd, alphaScale);
+        });
+    }
+}
+
+void SpringSystem::SolveSpringRange(size_t begin, size_t end, float alphaScale) {
+    float *positionX = positionX_.data();
+    float *positionY = positionY_.data();
+    float *positionZ = positionZ_.data();
+    const float *inverseMass = inverseMass_.data();
+
+    for (size_t i = begin; i < end; ++i) {
+        const uint32_t a = springA_[i];
+        const uint32_t b = springB_[i];
+        const float weightA = inverseMass[a];
+        const float weightB = inverseMass[b];
+        const float alpha = compliance_[i] * alphaScale;
+        const float weightSum = weightA + weightB + alpha;
+        if (weightSum <= 0.0f) {
+            continue;
+        }
+
+        const float dx = positionX[b] - positionX[a];
+        const float dy = positionY[b] - positionY[a];
+        const float dz = positionZ[b] - positionZ[a];
+        const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (length < kEpsilon) {
+            continue;
+        }
+
+        // XPBDの距離拘束
+        const float constraint = length - restLength_[i];
+        const float deltaLambda = (-constraint - alpha * lambda_[i]) / weightSum;
+        lambda_[i] += deltaLambda;
+        const float scale = deltaLambda / length;
+        positionX[a] -= dx * scale * weightA;
+        positionY[a] -= dy * scale * weightA;
+        positionZ[a] -= dz * scale * weightA;
+        positionX[b] += dx * scale * weightB;
+        positionY[b] += dy * scale * weightB;
+        positionZ[b] += dz * scale * weightB;
+    }
+}
+
+void SpringSystem::SolveCollisions() {
+    if (sphereColliders_.empty() && planeColliders_.empty()) {
+        return;
+    }
+    ParallelFor(positionX_.size(), isParallel_, [this](size_t begin, size_t end) {
+        SolveCollisionRange(begin, end);
+    });
+}
+
+void SpringSystem::SolveCollisionRange(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (inverseMass_[i] <= 0.0f) {
+            continue;
+        }
+        float &x = positionX_[i];
+        float &y = positionY_[i];
+        float &z = positionZ_[i];
+
+        // 球の外へ押し出す
+        for (const auto &sphere : sphereColliders_) {
+            const float dx = x - sphere.center.x;
+            const float dy = y - sphere.center.y;
+            const float dz = z - sphere.center.z;
+            const float distanceSquared = dx * dx + dy * dy + dz * dz;
+            if (distanceSquared >= sphere.radius * sphere.radius || distanceSquared < kEpsilon) {
+                continue;
+            }
+            const float scale = sphere.radius / std::sqrt(distanceSquared);
+            x = sphere.center.x + dx * scale;
+            y = sphere.center.y + dy * scale;
+            z = sphere.center.z + dz * scale;
+        }
+
+        // 平面の表側へ押し出す
+        for (const auto &plane : planeColliders_) {
+            const float signedDistance = plane.normal.x * x + plane.normal.y * y + plane.normal.z * z - plane.distance;
+            if (signedDistance >= 0.0f) {
+                continue;
+            }
+            x -= plane.normal.x * signedDistance;
+            y -= plane.normal.y * signedDistance;
+            z -= plane.normal.z * signedDistance;
+        }
+    }
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
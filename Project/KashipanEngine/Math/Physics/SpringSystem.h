@@ -0,0 +1,163 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Math/Vector3.h"
+#include "Math/MathObjects/Plane.h"
+#include "Math/MathObjects/Sphere.h"
+#include "Math/Physics/Spring.h"
+
+namespace KashipanEngine {
+
+struct VertexData;
+
+/// @brief 格子状に並べた布の情報
+struct ClothGrid {
+    // 先頭の質点番号
+    uint32_t firstParticle = 0;
+    // 横の質点数
+    uint32_t width = 0;
+    // 縦の質点数
+    uint32_t height = 0;
+};
+
+/// @brief 質点とバネのネットワークを位置ベースで解くクラス
+class SpringSystem {
+public:
+    SpringSystem() = default;
+    ~SpringSystem() = default;
+
+    /// @brief 質点の追加
+    /// @param position 初期位置
+    /// @param mass 質量。0以下なら固定された質点
+    /// @return 質点番号
+    uint32_t AddParticle(const Vector3 &position, float mass = 1.0f);
+
+    /// @brief 質点同士をつなぐバネの追加
+    /// @param particleA 質点A
+    /// @param particleB 質点B
+    /// @param restLength 自然長。負の値なら現在の距離を使う
+    /// @param stiffness 剛性。0以下なら伸び縮みしない
+    void AddSpring(uint32_t particleA, uint32_t particleB, float restLength = -1.0f, float stiffness = 0.0f);
+
+    /// @brief アンカーに固定されたバネの追加
+    /// @param particle バネの先につながる質点
+    /// @param spring バネの情報
+    void AddSpring(uint32_t particle, const Spring &spring);
+
+    /// @brief 縄(質点の列)の生成
+    /// @param start 始点
+    /// @param end 終点
+    /// @param segmentCount 分割数
+    /// @param massPerParticle 質点1つあたりの質量
+    /// @param stiffness 剛性。0以下なら伸び縮みしない
+    /// @return 先頭の質点番号
+    uint32_t CreateRope(const Vector3 &start, const Vector3 &end, uint32_t segmentCount,
+        float massPerParticle = 1.0f, float stiffness = 0.0f);
+
+    /// @brief 布(格子状の質点)の生成。構造・せん断・曲げのバネを張る
+    /// @param origin 左上の位置
+    /// @param right 横方向の1マス分のベクトル
+    /// @param down 縦方向の1マス分のベクトル
+    /// @param width 横の質点数
+    /// @param height 縦の質点数
+    /// @param massPerParticle 質点1つあたりの質量
+    /// @param stiffness 剛性。0以下なら伸び縮みしない
+    /// @return 布の情報
+    ClothGrid CreateCloth(const Vector3 &origin, const Vector3 &right, const Vector3 &down,
+        uint32_t width, uint32_t height, float massPerParticle = 1.0f, float stiffness = 0.0f);
+
+    /// @brief 質点の固定
+    /// @param particle 質点番号
+    void Pin(uint32_t particle);
+
+    /// @brief 衝突用の球の追加
+    void AddCollider(const Math::Sphere &sphere) { sphereColliders_.push_back(sphere); }
+    /// @brief 衝突用の平面の追加。法線の裏側が中身として扱われる
+    void AddCollider(const Math::Plane &plane) { planeColliders_.push_back(plane); }
+    /// @brief 衝突用の球の取得
+    std::vector<Math::Sphere> &GetSphereColliders() { return sphereColliders_; }
+    /// @brief 衝突用の平面の取得
+    std::vector<Math::Plane> &GetPlaneColliders() { return planeColliders_; }
+
+    /// @brief 全データの削除
+    void Clear();
+
+    /// @brief 更新
+    /// @param deltaTime 前回の更新からの経過時間
+    void Update(float deltaTime);
+
+    /// @brief 質点の位置の取得
+    [[nodiscard]] Vector3 GetPosition(uint32_t particle) const;
+    /// @brief 質点の位置の設定(速度は0になる)
+    void SetPosition(uint32_t particle, const Vector3 &position);
+
+    /// @brief 布の頂点データの書き込み
+    /// @param grid 布の情報
+    /// @param vertices 書き込み先(width * height 個)
+    void WriteClothVertices(const ClothGrid &grid, VertexData *vertices) const;
+
+    /// @brief 布のインデックスデータの書き込み
+    /// @param grid 布の情報
+    /// @param indices 書き込み先((width - 1) * (height - 1) * 6 個)
+    static void WriteClothIndices(const ClothGrid &grid, uint32_t *indices);
+
+    /// @brief 質点数の取得
+    [[nodiscard]] uint32_t GetParticleCount() const { return static_cast<uint32_t>(positionX_.size()); }
+    /// @brief バネの数の取得
+    [[nodiscard]] uint32_t GetSpringCount() const { return static_cast<uint32_t>(springA_.size()); }
+    /// @brief 色分けしたバッチ数の取得
+    [[nodiscard]] uint32_t GetBatchCount() const;
+
+    void SetGravity(const Vector3 &gravity) { gravity_ = gravity; }
+    void SetSubSteps(uint32_t subSteps) { subSteps_ = subSteps; }
+    /// @brief 減衰の設定
+    /// @param damping 1秒あたりの減衰率。サブステップ数やフレームレートが変わっても同じだけ減衰する
+    void SetDamping(float damping) { damping_ = damping; }
+    void SetParallel(bool isParallel) { isParallel_ = isParallel; }
+
+private:
+    void BuildBatches();
+    void Integrate(float deltaTime);
+    void SolveSprings(float deltaTime);
+    void SolveSpringRange(size_t begin, size_t end, float alphaScale);
+    void SolveCollisions();
+    void SolveCollisionRange(size_t begin, size_t end);
+
+    Vector3 gravity_ = { 0.0f, -9.8f, 0.0f };
+    uint32_t subSteps_ = 8;
+    // 1秒あたりの減衰率(60fps・8サブステップで、以前のサブステップごとの 0.01 とほぼ同じ)
+    float damping_ = 5.0f;
+    bool isParallel_ = true;
+
+    //==================================================
+    // 質点データ(SoA)
+    //==================================================
+
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    std::vector<float> positionZ_;
+    std::vector<float> previousX_;
+    std::vector<float> previousY_;
+    std::vector<float> previousZ_;
+    std::vector<float> inverseMass_;
+
+    //==================================================
+    // バネデータ(SoA)。色ごとにまとめて並べる
+    //==================================================
+
+    std::vector<uint32_t> springA_;
+    std::vector<uint32_t> springB_;
+    std::vector<float> restLength_;
+    std::vector<float> compliance_;
+    std::vector<float> lambda_;
+    // 色ごとのバネの開始位置。末尾はバネの総数
+    std::vector<size_t> batchOffsets_;
+    // バッチの再構築が必要かどうか
+    bool isBatchDirty_ = true;
+
+    // 衝突用の形状
+    std::vector<Math::Sphere> sphereColliders_;
+    std::vector<Math::Plane> planeColliders_;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
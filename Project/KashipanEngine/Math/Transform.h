@@ -7,6 +7,19 @@ struct Transform {
     Vector3 scale = { 1.0f, 1.0f, 1.0f };
     Vector3 rotate = { 0.0f, 0.0f, 0.0f };
     Vector3 translate = { 0.0f, 0.0f, 0.0f };
+
+    /// @brief 2つの姿勢の線形補間(回転はオイラー角のまま補間する)
+    /// @param start 開始の姿勢
+    /// @param end 終了の姿勢
+    /// @param t 補間係数
+    /// @return 補間された姿勢
+    static Transform Lerp(const Transform &start, const Transform &end, float t) noexcept {
+        return {
+            Vector3::Lerp(start.scale, end.scale, t),
+            Vector3::Lerp(start.rotate, end.rotate, t),
+            Vector3::Lerp(start.translate, end.translate, t),
+        };
+    }
 };
 
 }
\ No newline at end of file
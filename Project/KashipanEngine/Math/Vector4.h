@@ -13,6 +13,7 @@ struct Vector4 final {
     explicit constexpr Vector4(float value) : x(value), y(value), z(value), w(value) {}
     Vector4(const Vector2 &vector2) noexcept;
     Vector4(const Vector3 &vector3) noexcept;
+    Vector4(const Vector4 &vector) noexcept = default;
     
     Vector4 &operator=(const Vector4 &vector) noexcept;
     Vector4 &operator+=(const Vector4 &vector) noexcept;
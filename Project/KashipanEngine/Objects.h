@@ -1,5 +1,6 @@
 #pragma once
 #include "Objects/BillBoard.h"
+#include "Objects/Cloth.h"
 #include "Objects/Lines.h"
 #include "Objects/Model.h"
 #include "Objects/Plane.h"
@@ -0,0 +1,29 @@
+#include "Cloth.h"
+#include <cassert>
+
+namespace KashipanEngine {
+
+Cloth::Cloth(const SpringSystem *springSystem, const ClothGrid &grid) :
+    springSystem_(springSystem), grid_(grid) {
+    assert(springSystem_ != nullptr);
+    Create(grid_.width * grid_.height, (grid_.width - 1) * (grid_.height - 1) * 6);
+    isUseCamera_ = true;
+    SpringSystem::WriteClothIndices(grid_, mesh_->indexBufferMap);
+    springSystem_->WriteClothVertices(grid_, mesh_->vertexBufferMap);
+}
+
+void Cloth::Draw() {
+    // 質点の位置を頂点に反映
+    springSystem_->WriteClothVertices(grid_, mesh_->vertexBufferMap);
+    // 描画共通処理を呼び出す
+    DrawCommon();
+}
+
+void Cloth::Draw(WorldTransform &worldTransform) {
+    // 質点の位置を頂点に反映
+    springSystem_->WriteClothVertices(grid_, mesh_->vertexBufferMap);
+    // 描画共通処理を呼び出す
+    DrawCommon(worldTransform);
+}
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "Objects/Object.h"
+#include "Math/Physics/SpringSystem.h"
+
+namespace KashipanEngine {
+
+/// @brief SpringSystem の布を描画するオブジェクト
+class Cloth : public Object {
+public:
+    /// @brief コンストラクタ
+    /// @param springSystem 布を含むバネシステム
+    /// @param grid 布の情報
+    Cloth(const SpringSystem *springSystem, const ClothGrid &grid);
+
+    /// @brief オブジェクト情報へのポインタを取得
+    /// @return オブジェクト情報へのポインタ
+    [[nodiscard]] StatePtr GetStatePtr() override {
+        return { mesh_.get(), &transform_, &uvTransform_, &material_, &useTextureHandle_, &normalType_, &pipeLineName_};
+    }
+
+    /// @brief 描画処理
+    void Draw();
+
+    /// @brief 描画処理
+    void Draw(WorldTransform &worldTransform);
+
+private:
+    const SpringSystem *springSystem_;
+    ClothGrid grid_;
+};
+
+} // namespace KashipanEngine
\ No newline at end of file
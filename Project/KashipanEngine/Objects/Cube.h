@@ -10,7 +10,7 @@ public:
     /// @brief オブジェクト情報へのポインタを取得
     /// @return オブジェクト情報へのポインタ
     [[nodiscard]] StatePtr GetStatePtr() override {
-        return { mesh_.get(), &transform_, &uvTransform_, &material_, &useTextureIndex_, &normalType_, &pipeLineName_ };
+        return { mesh_.get(), &transform_, &uvTransform_, &material_, &useTextureHandle_, &normalType_, &pipeLineName_ };
     }
 };
 
@@ -6,6 +6,7 @@
 #include "Common/LineOption.h"
 #include "Common/Mesh.h"
 #include "Common/TransformationMatrix.h"
+#include "Common/StringId.h"
 
 namespace KashipanEngine {
 
@@ -43,7 +44,7 @@ private:
 
     Renderer *renderer_ = nullptr;
     LineType lineType_ = kLineNormal;
-    std::string pipelineName_ = "Line.Normal";
+    StringId pipelineName_ = "Line.Normal";
 
     std::unique_ptr<Mesh<VertexDataLine>> mesh_;
     Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource_;
@@ -1,7 +1,7 @@
 #include <fstream>
 #include <sstream>
 #include <cassert>
-#include <unordered_map>
+#include <FlatHashMap.h>
 #include <memory>
 
 #include "Model.h"
@@ -10,12 +10,14 @@
 #include "Math/Vector4.h"
 #include "Common/Logs.h"
 #include "Base/Texture.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
 
 namespace KashipanEngine {
 
 namespace {
 /// @brief モデルデータのマップ
-std::unordered_map<std::string, std::vector<std::unique_ptr<ModelData>>> sModelDataMap;
+MyStd::FlatHashMap<std::string, std::vector<std::unique_ptr<ModelData>>> sModelDataMap;
 
 /// @brief 指定のマテリアル情報を取得
 /// @param directoryPath ディレクトリのパス
@@ -78,56 +80,15 @@ MaterialData LoadMaterialFile(const std::string &directoryPath, const std::strin
 
 } // namespace
 
-void ModelData::ClearAllModelData() {
-    sModelDataMap.clear();
-}
-
-void ModelData::CreateData(std::vector<VertexData> &vertexData, std::vector<uint32_t> &indexData, MaterialData &materialData) {
-    isUseCamera_ = true;
-    // メッシュの生成
-    Create(static_cast<UINT>(vertexData.size()), static_cast<UINT>(indexData.size()));
-    // メッシュの頂点バッファにデータをコピー
-    std::memcpy(mesh_->vertexBufferMap, vertexData.data(), sizeof(VertexData) * vertexData.size());
-    // メッシュのインデックスバッファにデータをコピー
-    std::memcpy(mesh_->indexBufferMap, indexData.data(), sizeof(uint32_t) * indexData.size());
-
-    // マテリアルの設定
-    materialData_ = materialData;
-    if (materialData_.textureFilePath.empty()) {
-        // テクスチャが指定されていない場合は0を指定
-        useTextureIndex_ = 0;
-    } else {
-        useTextureIndex_ = Texture::Load(materialData_.textureFilePath);
-    }
-}
-
-void ModelData::Draw() {
-    isUseCamera_ = true;
-    DrawCommon();
-}
-
-void ModelData::Draw(WorldTransform &worldTransform) {
-    isUseCamera_ = true;
-    DrawCommon(worldTransform);
-}
-
-Model::Model(std::string directoryPath, std::string fileName) {
-    // ディレクトリパス + ファイル名をオブジェクトの名前にする
-    name_ = directoryPath + '/' + fileName;
-
-    // 既に読み込まれている場合は共有データを参照するだけ
-    if (auto it = sModelDataMap.find(name_); it != sModelDataMap.end()) {
-        for (auto &mdl : it->second) {
-            models_.push_back(mdl.get());
-        }
-        return;
-    }
-
+std::vector<ObjMeshData> LoadObjFile(const std::string &directoryPath, const std::string &fileName) {
+    PROFILE_FUNCTION();
     std::vector<Vector4> positions;     // 位置
     std::vector<Vector3> normals;       // 法線
     std::vector<Vector2> texCoords;     // テクスチャ座標
     std::vector<uint32_t> index;        // インデックスデータ
     std::vector<VertexData> vertices;   // 頂点データ
+    std::vector<ObjMeshData> meshes;    // 読み込んだメッシュ
+    bool isMeshPending = false;         // 書き込んでいないメッシュがあるかどうか
     std::string materialFileName;       // マテリアルファイルの名前
     std::string usemtl;                 // 使用するマテリアル名
     std::string line;                   // ファイルから読み込んだ1行を格納するもの
@@ -137,11 +98,9 @@ Model::Model(std::string directoryPath, std::string fileName) {
     if (!file.is_open()) {
         Log("Failed to open file: " + directoryPath + "/" + fileName, kLogLevelFlagError);
         assert(false);
+        return meshes;
     }
 
-    // ロード結果を一時的に保持する（ロード後にキャッシュへ移動）
-    std::vector<std::unique_ptr<ModelData>> loadedModels;
-
     // ファイルを1行ずつ読み込む
     std::string preIdentifier;
     std::string identifier;
@@ -160,8 +119,8 @@ Model::Model(std::string directoryPath, std::string fileName) {
         // 前まで面情報を読み込んでいて、
         // かつ今は面情報じゃない行を読み込んでいたらモデルデータに書き込み
         if (preIdentifier == "f" && identifier != "f") {
-            MaterialData materialData = LoadMaterialFile(directoryPath, materialFileName, usemtl);
-            loadedModels.back()->CreateData(vertices, index, materialData);
+            meshes.push_back({ std::move(vertices), std::move(index), LoadMaterialFile(directoryPath, materialFileName, usemtl) });
+            isMeshPending = false;
 
             // 読み込んだデータを一部リセット
             vertices.clear();
@@ -213,9 +172,9 @@ Model::Model(std::string directoryPath, std::string fileName) {
         } else if (identifier == "f") {
             //--------- 他データ(面やマテリアル情報)読み込み ---------//
 
-            // 前までのIDがfでなければ新しくモデルデータを追加
+            // 前までのIDがfでなければ新しいメッシュの開始
             if (preIdentifier != "f") {
-                loadedModels.push_back(std::make_unique<ModelData>());
+                isMeshPending = true;
             }
 
             std::vector<VertexData> faceVertices;
@@ -293,10 +252,66 @@ Model::Model(std::string directoryPath, std::string fileName) {
         }
     }
 
-    // モデルデータの最後の要素のmeshがemptyなら書き込み
-    if (!loadedModels.empty() && !loadedModels.back()->isMeshExist()) {
-        MaterialData materialData = LoadMaterialFile(directoryPath, materialFileName, usemtl);
-        loadedModels.back()->CreateData(vertices, index, materialData);
+    // 面情報でファイルが終わっていれば最後のメッシュを書き込み
+    if (isMeshPending) {
+        meshes.push_back({ std::move(vertices), std::move(index), LoadMaterialFile(directoryPath, materialFileName, usemtl) });
+    }
+    return meshes;
+
+}
+
+void ModelData::ClearAllModelData() {
+    sModelDataMap.clear();
+}
+
+void ModelData::CreateData(std::vector<VertexData> &vertexData, std::vector<uint32_t> &indexData, MaterialData &materialData) {
+    isUseCamera_ = true;
+    // メッシュの生成
+    Create(static_cast<UINT>(vertexData.size()), static_cast<UINT>(indexData.size()));
+    // メッシュの頂点バッファにデータをコピー
+    std::memcpy(mesh_->vertexBufferMap, vertexData.data(), sizeof(VertexData) * vertexData.size());
+    // メッシュのインデックスバッファにデータをコピー
+    std::memcpy(mesh_->indexBufferMap, indexData.data(), sizeof(uint32_t) * indexData.size());
+
+    // マテリアルの設定
+    materialData_ = materialData;
+    if (materialData_.textureFilePath.empty()) {
+        // テクスチャが指定されていない場合はデフォルトのテクスチャを使う
+        useTextureHandle_ = TextureHandle{};
+    } else {
+        useTextureHandle_ = Texture::Load(materialData_.textureFilePath);
+    }
+}
+
+void ModelData::Draw() {
+    isUseCamera_ = true;
+    DrawCommon();
+}
+
+void ModelData::Draw(WorldTransform &worldTransform) {
+    isUseCamera_ = true;
+    DrawCommon(worldTransform);
+}
+
+Model::Model(std::string directoryPath, std::string fileName) {
+    PROFILE_FUNCTION();
+    MEMORY_TAG_SCOPE(kModel);
+    // ディレクトリパス + ファイル名をオブジェクトの名前にする
+    name_ = directoryPath + '/' + fileName;
+
+    // 既に読み込まれている場合は共有データを参照するだけ
+    if (auto it = sModelDataMap.find(name_); it != sModelDataMap.end()) {
+        for (auto &mdl : it->second) {
+            models_.push_back(mdl.get());
+        }
+        return;
+    }
+
+    // ファイルを解析して、メッシュごとにモデルデータを作る
+    std::vector<std::unique_ptr<ModelData>> loadedModels;
+    for (auto &meshData : LoadObjFile(directoryPath, fileName)) {
+        loadedModels.push_back(std::make_unique<ModelData>());
+        loadedModels.back()->CreateData(meshData.vertices, meshData.indices, meshData.material);
     }
 
     // キャッシュに登録
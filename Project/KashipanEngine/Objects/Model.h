@@ -14,6 +14,19 @@ struct MaterialData {
     std::string textureFilePath;
 };
 
+/// @brief OBJファイルから読み込んだ1つのメッシュ(GPUのリソースは作らない)
+struct ObjMeshData {
+    std::vector<VertexData> vertices;
+    std::vector<uint32_t> indices;
+    MaterialData material;
+};
+
+/// @brief OBJファイルの解析。マテリアルファイルも読むが、テクスチャの読み込みやGPUのリソースの作成はしない
+/// @param directoryPath モデルのディレクトリパス
+/// @param fileName モデルのファイル名
+/// @return 面情報のまとまりごとのメッシュ
+std::vector<ObjMeshData> LoadObjFile(const std::string &directoryPath, const std::string &fileName);
+
 /// @brief モデルデータ
 class ModelData : public Object {
 public:
@@ -1,15 +1,20 @@
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include "KashipanEngine.h"
 #include "Object.h"
 #include "Base/Renderer.h"
 #include "Common/ConvertColor.h"
 #include "Common/Logs.h"
+#include "Common/MemoryTracker.h"
 
 namespace KashipanEngine {
 
 namespace {
 Engine *sKashipanEngine = nullptr;
+// ティック間の姿勢を補間するオブジェクト
+std::vector<Object *> sInterpolatedObjects;
 } // namespace
 
 void Object::Initialize(Engine *engine) {
@@ -20,7 +25,48 @@ Object::Object() noexcept {
     renderer_ = sKashipanEngine->GetRenderer();
 }
 
+Object::~Object() noexcept {
+    SetInterpolation(false);
+}
+
+void Object::SetInterpolation(bool isInterpolate) {
+    if (isInterpolate_ == isInterpolate) {
+        return;
+    }
+    isInterpolate_ = isInterpolate;
+    if (isInterpolate) {
+        previousTransform_ = transform_;
+        // 登録の配列の容量はプログラム終了まで持ち続ける
+        MEMORY_TAG_SCOPE(kPersistent);
+        sInterpolatedObjects.push_back(this);
+    } else {
+        auto it = std::find(sInterpolatedObjects.begin(), sInterpolatedObjects.end(), this);
+        if (it != sInterpolatedObjects.end()) {
+            *it = sInterpolatedObjects.back();
+            sInterpolatedObjects.pop_back();
+        }
+    }
+}
+
+void Object::SaveInterpolationStates() {
+    for (Object *object : sInterpolatedObjects) {
+        object->previousTransform_ = object->transform_;
+    }
+}
+
 Object::Object(Object &&other) noexcept {
+    // 補間の登録も引き継ぐ(移動元のポインタが残ると破棄後に参照される)
+    transform_ = other.transform_;
+    previousTransform_ = other.previousTransform_;
+    if (other.isInterpolate_) {
+        auto it = std::find(sInterpolatedObjects.begin(), sInterpolatedObjects.end(), &other);
+        if (it != sInterpolatedObjects.end()) {
+            *it = this;
+        }
+        isInterpolate_ = true;
+        other.isInterpolate_ = false;
+    }
+
     if (!other.mesh_) {
         return;
     }
@@ -32,7 +78,7 @@ Object::Object(Object &&other) noexcept {
     transformationMatrixMap_ = other.transformationMatrixMap_;
     vertexCount_ = other.vertexCount_;
     indexCount_ = other.indexCount_;
-    useTextureIndex_ = other.useTextureIndex_;
+    useTextureHandle_ = other.useTextureHandle_;
 }
 
 void Object::DrawCommon() {
@@ -57,11 +103,7 @@ void Object::DrawCommon() {
     );
 
     // 行列を計算
-    worldMatrix_.MakeAffine(
-        transform_.scale,
-        transform_.rotate,
-        transform_.translate
-    );
+    CalculateWorldMatrix();
     // TransformationMatrixを転送
     transformationMatrixMap_->world = worldMatrix_;
 
@@ -73,13 +115,25 @@ void Object::DrawCommon() {
     objectState.worldMatrix = &worldMatrix_;
     objectState.vertexCount = vertexCount_;
     objectState.indexCount = indexCount_;
-    objectState.useTextureIndex = useTextureIndex_;
+    objectState.useTextureHandle = useTextureHandle_;
     objectState.pipeLineName = pipeLineName_;
     objectState.isUseCamera = isUseCamera_;
     bool isSemitransparent = (material_.color.w < 255.0f);
     renderer_->DrawSet(objectState, isUseCamera_, isSemitransparent);
 }
 
+void Object::CalculateWorldMatrix() {
+    // 補間する場合は前後のティックの姿勢の間を使う
+    const Transform transform = isInterpolate_
+        ? Transform::Lerp(previousTransform_, transform_, Engine::GetInterpolationAlpha())
+        : transform_;
+    worldMatrix_.MakeAffine(
+        transform.scale,
+        transform.rotate,
+        transform.translate
+    );
+}
+
 void Object::DrawCommon(WorldTransform &worldTransform) {
     // レンダラーが設定されていない場合はログを出力して終了
     if (renderer_ == nullptr) {
@@ -111,7 +165,7 @@ void Object::DrawCommon(WorldTransform &worldTransform) {
     objectState.worldMatrix = &worldTransform.worldMatrix_;
     objectState.vertexCount = vertexCount_;
     objectState.indexCount = indexCount_;
-    objectState.useTextureIndex = useTextureIndex_;
+    objectState.useTextureHandle = useTextureHandle_;
     objectState.pipeLineName = pipeLineName_;
     objectState.isUseCamera = isUseCamera_;
     bool isSemitransparent = (material_.color.w < 255.0f);
@@ -5,6 +5,8 @@
 #include "Common/VertexData.h"
 #include "Common/TransformationMatrix.h"
 #include "Common/Material.h"
+#include "Common/StringId.h"
+#include "Common/TextureHandle.h"
 #include "3d/PrimitiveDrawer.h"
 
 class Engine;
@@ -25,14 +27,14 @@ public:
         Transform *transform = nullptr;
         Transform *uvTransform = nullptr;
         Material *material = nullptr;
-        int *useTextureIndex = nullptr;
+        TextureHandle *useTextureHandle = nullptr;
         NormalType *normalType = nullptr;
-        std::string *pipeLineName = nullptr;
+        StringId *pipeLineName = nullptr;
     };
 
     static void Initialize(Engine *engine);
     Object() noexcept;
-    virtual ~Object() noexcept = default;
+    virtual ~Object() noexcept;
 
     Object(const Object &) = delete;
     Object &operator=(const Object &) = delete;
@@ -47,7 +49,7 @@ public:
 
     /// @brief 使用するレンダリングパイプライン名の設定
     /// @param pipelineName レンダリングパイプライン名
-    void SetPipelineName(const std::string &pipelineName) {
+    void SetPipelineName(StringId pipelineName) {
         pipeLineName_ = pipelineName;
     }
 
@@ -83,7 +85,7 @@ public:
     /// @brief オブジェクト情報へのポインタを取得
     /// @return オブジェクト情報へのポインタ
     [[nodiscard]] virtual StatePtr GetStatePtr() {
-        return { nullptr, &transform_, &uvTransform_, &material_, &useTextureIndex_, &normalType_, &pipeLineName_};
+        return { nullptr, &transform_, &uvTransform_, &material_, &useTextureHandle_, &normalType_, &pipeLineName_};
     }
 
     /// @brief オブジェクトの描画処理
@@ -106,6 +108,19 @@ public:
     void Hide() {
         isDraw_ = false;
     }
+
+    /// @brief 固定ステップ更新のティック間の姿勢を補間して描画するかどうかの設定
+    /// @param isInterpolate 補間するかどうか
+    void SetInterpolation(bool isInterpolate);
+
+    /// @brief 補間の開始点を現在の姿勢にする(瞬間移動させた時用)
+    void ResetInterpolation() {
+        previousTransform_ = transform_;
+    }
+
+    /// @brief 補間する全オブジェクトの現在の姿勢を補間の開始点として保存する。
+    /// ティックの開始時にエンジンから呼ばれる
+    static void SaveInterpolationStates();
     
 protected:
     //==================================================
@@ -120,6 +135,9 @@ protected:
     /// @brief オブジェクト共通の描画処理
     void DrawCommon();
 
+    /// @brief transform_ からワールド行列を計算する。補間する場合は前後のティックの姿勢の間を使う
+    void CalculateWorldMatrix();
+
     /// @brief オブジェクト共通の描画処理
     /// @param worldTransform ワールド変換データ
     /// @param color 色
@@ -132,7 +150,7 @@ protected:
     /// @brief オブジェクトの名前
     std::string name_;
     /// @brief 使用するレンダリングパイプライン名
-    std::string pipeLineName_ = "Object3d.Solid.BlendNormal";
+    StringId pipeLineName_ = "Object3d.Solid.BlendNormal";
 
     /// @brief レンダラーへのポインタ
     Renderer *renderer_ = nullptr;
@@ -165,13 +183,15 @@ protected:
         { 0.0f, 0.0f, 0.0f },   // 回転
         { 0.0f, 0.0f, 0.0f }    // 平行移動
     };
+    /// @brief 補間の開始点となる前のティックの姿勢
+    Transform previousTransform_;
     /// @brief ワールド行列
     Matrix4x4 worldMatrix_{};
     /// @brief マテリアルデータ
     Material material_;
 
-    /// @brief 使用するテクスチャのインデックス
-    int useTextureIndex_ = 0;
+    /// @brief 使用するテクスチャのハンドル(無効ならデフォルトのテクスチャ)
+    TextureHandle useTextureHandle_;
     /// @brief 法線のタイプ
     NormalType normalType_ = kNormalTypeVertex;
 
@@ -179,6 +199,8 @@ protected:
     bool isUseCamera_ = false;
     /// @brief 描画フラグ
     bool isDraw_ = true;
+    /// @brief ティック間の補間フラグ
+    bool isInterpolate_ = false;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <FlatHashMap.h>
 #include "Particle.h"
 #include "Base/DirectXCommon.h"
 #include "3d/PrimitiveDrawer.h"
@@ -6,22 +7,24 @@
 #include "Common/VertexData.h"
 #include "Common/Logs.h"
 #include "Base/Texture.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
 
 namespace KashipanEngine {
 
 namespace {
-std::unordered_map<std::string, std::unique_ptr<ParticleGroup>> sParticleGroups;
+MyStd::FlatHashMap<std::string, std::unique_ptr<ParticleGroup>> sParticleGroups;
 } // namespace
 
-ParticleGroup::ParticleGroup(DirectXCommon *dxCommon, uint32_t maxInstances, uint32_t textureIndex)
-    : dxCommon_(dxCommon), maxInstances_(maxInstances), textureIndex_(textureIndex) {
+ParticleGroup::ParticleGroup(DirectXCommon *dxCommon, uint32_t maxInstances, const TextureHandle &textureHandle)
+    : dxCommon_(dxCommon), maxInstances_(maxInstances), textureHandle_(textureHandle) {
     assert(dxCommon_);
     InitializeResources();
 }
 
 void ParticleGroup::InitializeResources() {
     pipeLineName_ = "Particle.Solid.BlendNormal";
-    useTextureIndex_ = static_cast<int>(textureIndex_);
+    useTextureHandle_ = textureHandle_;
 
     vertexCount_ = 4;
     indexCount_ = 6;
@@ -92,6 +95,7 @@ void ParticleGroup::KillParticle(size_t index) {
 }
 
 void ParticleGroup::UpdateMatrices(const Matrix4x4 &viewProjection) {
+    PROFILE_FUNCTION();
     activeInstanceCount_ = 0;
     for (size_t i = 0; i < particles_.size(); ++i) {
         auto &p = particles_[i];
@@ -106,6 +110,7 @@ void ParticleGroup::UpdateMatrices(const Matrix4x4 &viewProjection) {
 }
 
 void ParticleGroup::Draw() {
+    PROFILE_FUNCTION();
     if (!renderer_ || !isDraw_) { return; }
     renderer_->DrawParticles(this);
 }
@@ -114,8 +119,9 @@ void ParticleManager::ClearAllParticleGroups() {
     sParticleGroups.clear();
 }
 
-ParticleGroup *ParticleManager::CreateParticleGroup(const std::string &name, DirectXCommon *dxCommon, uint32_t maxInstances, uint32_t textureIndex) {
-    auto group = std::make_unique<ParticleGroup>(dxCommon, maxInstances, textureIndex);
+ParticleGroup *ParticleManager::CreateParticleGroup(const std::string &name, DirectXCommon *dxCommon, uint32_t maxInstances, const TextureHandle &textureHandle) {
+    MEMORY_TAG_SCOPE(kParticle);
+    auto group = std::make_unique<ParticleGroup>(dxCommon, maxInstances, textureHandle);
     sParticleGroups[name] = std::move(group);
     return sParticleGroups[name].get();
 }
@@ -30,8 +30,8 @@ public:
     /// @brief コンストラクタ
     /// @param dxCommon DirectX共通
     /// @param maxInstances 最大インスタンス数(バッファ確保数)
-    /// @param textureIndex 使用するテクスチャインデックス
-    ParticleGroup(DirectXCommon *dxCommon, uint32_t maxInstances, uint32_t textureIndex);
+    /// @param textureHandle 使用するテクスチャのハンドル
+    ParticleGroup(DirectXCommon *dxCommon, uint32_t maxInstances, const TextureHandle &textureHandle);
     ~ParticleGroup() = default;
 
     /// @brief パーティクル生成(グループの発生位置から生成)
@@ -59,8 +59,8 @@ public:
     [[nodiscard]] ID3D12Resource *GetMaterialResource() const { return materialResource_.Get(); }
     /// @brief TransformationMatrices 用 SRV GPUハンドル取得
     [[nodiscard]] D3D12_GPU_DESCRIPTOR_HANDLE GetMatricesSrvGPU() const { return matricesSrvGPU_; }
-    /// @brief テクスチャインデックス取得
-    [[nodiscard]] int GetTextureIndex() const { return static_cast<int>(textureIndex_); }
+    /// @brief テクスチャのハンドル取得
+    [[nodiscard]] const TextureHandle &GetTextureHandle() const { return textureHandle_; }
 
     /// @brief 生成(発生)位置を設定
     void SetSpawnPosition(const Vector3 &position) { spawnPosition_ = position; }
@@ -75,7 +75,7 @@ private:
 
     DirectXCommon *dxCommon_ = nullptr;
     uint32_t maxInstances_ = 0;
-    uint32_t textureIndex_ = 0;
+    TextureHandle textureHandle_;
 
     // パーティクル配列
     std::vector<std::unique_ptr<Particle>> particles_;
@@ -99,7 +99,7 @@ public:
     static void ClearAllParticleGroups();
 
     /// @brief パーティクルグループ作成
-    static ParticleGroup *CreateParticleGroup(const std::string &name, DirectXCommon *dxCommon, uint32_t maxInstances, uint32_t textureIndex);
+    static ParticleGroup *CreateParticleGroup(const std::string &name, DirectXCommon *dxCommon, uint32_t maxInstances, const TextureHandle &textureHandle);
     /// @brief 取得
     static ParticleGroup *GetParticleGroup(const std::string &name);
 };
@@ -9,19 +9,19 @@ Sprite::Sprite(const std::string &filePath) {
     SetTexture(filePath);
 }
 
-Sprite::Sprite(const uint32_t textureIndex) {
+Sprite::Sprite(const TextureHandle &textureHandle) {
     Initialize();
-    SetTexture(textureIndex);
+    SetTexture(textureHandle);
 }
 
 void Sprite::SetTexture(const std::string &filePath) {
-    useTextureIndex_ = Texture::Load(filePath);
+    useTextureHandle_ = Texture::Load(filePath);
     LoadTexture(Texture::GetTexture(filePath));
 }
 
-void Sprite::SetTexture(const uint32_t textureIndex) {
-    useTextureIndex_ = textureIndex;
-    LoadTexture(Texture::GetTexture(useTextureIndex_));
+void Sprite::SetTexture(const TextureHandle &textureHandle) {
+    useTextureHandle_ = textureHandle;
+    LoadTexture(Texture::GetTexture(useTextureHandle_));
 }
 
 void Sprite::SetAnchor(const Vector2 &pivot) {
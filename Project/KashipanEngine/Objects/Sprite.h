@@ -8,12 +8,12 @@ class Sprite : public Object {
 public:
     Sprite() = delete;
     Sprite(const std::string &filePath);
-    Sprite(const uint32_t textureIndex);
+    Sprite(const TextureHandle &textureHandle);
     
     // @brief オブジェクト情報へのポインタを取得
     /// @return オブジェクト情報へのポインタ
     [[nodiscard]] StatePtr GetStatePtr() override {
-        return { mesh_.get(), &transform_, &uvTransform_, &material_, &useTextureIndex_, &normalType_, &pipeLineName_ };
+        return { mesh_.get(), &transform_, &uvTransform_, &material_, &useTextureHandle_, &normalType_, &pipeLineName_ };
     }
     
     /// @brief テクスチャ設定用関数
@@ -21,8 +21,8 @@ public:
     void SetTexture(const std::string &filePath);
 
     /// @brief テクスチャ設定用関数
-    /// @param textureIndex テクスチャのインデックス
-    void SetTexture(const uint32_t textureIndex);
+    /// @param textureHandle テクスチャのハンドル
+    void SetTexture(const TextureHandle &textureHandle);
 
     /// @brief ピボットの設定
     /// @param pivot ピボット(0.0~1.0)
@@ -1,6 +1,7 @@
 #pragma once
 #include "Objects/Object.h"
-#include "Font/FontLoader.h"
+#include "Font/FontRegistry.h"
+#include "Font/TextLayout.h"
 
 namespace KashipanEngine {
 
@@ -9,45 +10,32 @@ enum class TextType {
     Shared, ///< 文字列をひとつのオブジェクトとして生成する
 };
 
-enum class TextAlignX {
-    Left,   ///< 左揃え
-    Center, ///< 中央揃え
-    Right,  ///< 右揃え
-};
-
-enum class TextAlignY {
-    Top,    ///< 上揃え
-    Center, ///< 中央揃え
-    Bottom, ///< 下揃え
-};
-
+/// @brief テキスト。テキストごとのGPUのバッファは持たず、描画時にレンダラーが
+/// すべてのテキストの文字をまとめて1つの頂点バッファに書き込み、フォントのページごとに描画する。
+/// テキストは2Dオブジェクトの後に描画される
 class Text : public Object {
 public:
-    struct LineInfo {
-        // 行の幅
-        float width = 0.0f;
-        // 行の高さ
-        float height = 0.0f;
-        // 行の最初の頂点インデックス
-        uint32_t beginVertexIndex = 0;
-        // 行の最後の頂点インデックス
-        uint32_t endVertexIndex = 0;
-    };
-
     Text() = delete;
     /// @brief テキストのコンストラクタ
-    /// @param textCount テキストの文字数
+    /// @param textCount 表示する最大の文字数
     Text(uint32_t textCount);
 
-    /// @brief テキストのフォントの設定
+    /// @brief テキストの描画処理(レンダラーにまとめて描画するよう登録する)
+    void Draw() override;
+
+    /// @brief テキストの描画処理(レンダラーにまとめて描画するよう登録する)
+    /// @param worldTransform ワールド変換データ
+    void Draw(WorldTransform &worldTransform) override;
+
+    /// @brief テキストのフォントの設定。フォントは FontRegistry で1回だけ読み込まれ、共有される
     /// @param fontFilePath フォントファイル(.fnt)のパス
     void SetFont(const char *fontFilePath);
 
     /// @brief テキストのフォントの設定
-    /// @param fontData フォントデータ
-    void SetFont(const FontData &fontData);
+    /// @param fontHandle FontRegistry のフォントのハンドル
+    void SetFont(FontHandle fontHandle);
 
-    /// @brief テキストの設定(UTF8文字列)
+    /// @brief テキストの設定(UTF8文字列)。前回のテキストから変わった行だけ配置し直す
     /// @param text テキストの文字列(""の前にu8と付けたUTF8形式の文字列。例: u8"Hello, World!")
     void SetText(const std::u8string &text);
 
@@ -56,31 +44,39 @@ public:
     /// @param textAlignY 垂直方向の揃え方
     void SetTextAlign(TextAlignX textAlignX, TextAlignY textAlignY);
 
+    /// @brief テキストを折り返す幅を設定する
+    /// @param maxWidth 折り返す幅。0以下なら改行文字以外では折り返さない
+    void SetMaxWidth(float maxWidth);
+
     /// @brief テキストのフォントデータを取得する
-    /// @return テキストのフォントデータ
-    const FontData &GetFontData() const { return fontData_; }
+    /// @return テキストのフォントデータ。設定されていなければnullptr
+    const FontData *GetFontData() const { return FontRegistry::Get(fontHandle_); }
+
+    /// @brief テキストのフォントのハンドルを取得する
+    /// @return FontRegistry のフォントのハンドル
+    FontHandle GetFontHandle() const { return fontHandle_; }
 
     /// @brief テキストの文字列を取得する
     /// @return テキストの文字列
-    const std::u8string &GetText() const { return text_; }
+    const std::u8string &GetText() const { return layout_.GetText(); }
 
     /// @brief テキストの文字数を取得する
     /// @return テキストの文字数
-    int GetTextCount() const { return static_cast<int>(text_.size()); }
+    int GetTextCount() const { return static_cast<int>(layout_.GetText().size()); }
+
+    /// @brief テキストのレイアウトを取得する
+    /// @return テキストのレイアウト
+    const TextLayout &GetLayout() const { return layout_; }
 
 private:
-    /// @brief @brief テキストのX軸方向の揃え方を計算する
-    void CalculateTextAlignX(TextAlignX newTextAlignX);
-    /// @brief テキストのY軸方向の揃え方を計算する
-    void CalculateTextAlignY(TextAlignY newTextAlignY);
-
-    FontData fontData_;
-    std::u8string text_;
-    std::vector<int> textCodePoints_;
-    std::vector<LineInfo> lineInfos_;
+    /// @brief レンダラーにまとめて描画するよう登録する
+    /// @param worldMatrix ワールド行列
+    void DrawSetText(const Matrix4x4 &worldMatrix);
+
+    FontHandle fontHandle_;
+    uint32_t maxGlyphCount_ = 0;
+    TextLayout layout_;
     TextType textType_ = TextType::Shared;
-    TextAlignX textAlignX_ = TextAlignX::Left;
-    TextAlignY textAlignY_ = TextAlignY::Top;
 };
 
 } // namespace KashipanEngine
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 namespace MyStd {
 
+/// @brief std::any を値に持つ木構造。互換用に残しているので、新しいコードでは Document を使う
 class AnyUnorderedMap {
 public:
     AnyUnorderedMap() = default;
@@ -62,6 +63,14 @@ public:
         erase(std::string(key));
     }
 
+    /// @brief 値を持っているかどうか
+    bool HasValue() const {
+        return value_.has_value();
+    }
+    /// @brief 値の取得
+    const std::any &GetAny() const {
+        return value_;
+    }
     const char *GetTypeName() const {
         return value_.type().name();
     }
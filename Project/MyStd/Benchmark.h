@@ -0,0 +1,167 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace MyStd {
+
+namespace BenchmarkDetail {
+/// @brief 最適化で計算が消されないように値のアドレスを書き込む先
+inline const void *volatile sDoNotOptimizeSink = nullptr;
+} // namespace BenchmarkDetail
+
+/// @brief 計算結果を使ったことにして、最適化で計算そのものが消されるのを防ぐ
+/// @param value 計算結果
+template<typename T>
+inline void DoNotOptimize(const T &value) noexcept {
+#if defined(_MSC_VER)
+    BenchmarkDetail::sDoNotOptimizeSink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// @brief 小さな処理の1回あたりの時間を計るマイクロベンチマーク。
+/// 1サンプルが一定時間以上になるよう繰り返し回数を決めてから複数回計り、中央値を結果にする
+class Benchmark {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// @brief 計測する処理。引数の回数だけ処理を繰り返す
+    using Function = std::function<void(uint64_t iterationCount)>;
+
+    /// @brief 1つのベンチマークの結果。時間の単位はナノ秒
+    struct Result {
+        std::string name;
+        /// @brief 1回あたりの時間の中央値
+        double nanosecondsPerIteration = 0.0;
+        /// @brief 1回あたりの時間の最小値
+        double minNanosecondsPerIteration = 0.0;
+        /// @brief 1回あたりの時間の最大値
+        double maxNanosecondsPerIteration = 0.0;
+        /// @brief 1サンプルでの繰り返し回数
+        uint64_t iterationCount = 0;
+        /// @brief サンプル数
+        uint32_t sampleCount = 0;
+    };
+
+    /// @brief 基準より遅くなったベンチマーク
+    struct Regression {
+        std::string name;
+        /// @brief 基準の1回あたりの時間
+        double baselineNanoseconds = 0.0;
+        /// @brief 今回の1回あたりの時間
+        double currentNanoseconds = 0.0;
+        /// @brief 基準に対する比(1.0より大きいほど遅い)
+        double ratio = 0.0;
+    };
+
+    /// @brief サンプル数の設定
+    void SetSampleCount(uint32_t sampleCount) { sampleCount_ = std::max<uint32_t>(sampleCount, 1); }
+    /// @brief 1サンプルにかける最低時間の設定
+    void SetMinSampleTime(Clock::duration minSampleTime) { minSampleTime_ = minSampleTime; }
+
+    /// @brief ベンチマークの追加
+    /// @param name 名前(結果の保存と基準との比較に使う)
+    /// @param function 計測する処理
+    void Add(std::string name, Function function) {
+        entries_.push_back({ std::move(name), std::move(function) });
+    }
+
+    /// @brief 追加したベンチマークの数
+    size_t GetCount() const { return entries_.size(); }
+
+    /// @brief 追加したすべてのベンチマークの実行
+    /// @return 追加した順の結果
+    std::vector<Result> Run() const {
+        std::vector<Result> results;
+        results.reserve(entries_.size());
+        for (const auto &entry : entries_) {
+            results.push_back(RunEntry(entry));
+        }
+        return results;
+    }
+
+    /// @brief 基準より許容範囲を超えて遅くなったベンチマークの検出。基準に無いものは無視する
+    /// @param results 今回の結果
+    /// @param baseline 名前と1回あたりの時間(ナノ秒)の組
+    /// @param tolerance 許容する遅くなった割合(0.1なら10%まで)
+    /// @return 遅くなったベンチマーク
+    static std::vector<Regression> FindRegressions(const std::vector<Result> &results,
+        const std::vector<std::pair<std::string, double>> &baseline, double tolerance) {
+        std::vector<Regression> regressions;
+        for (const auto &result : results) {
+            auto it = std::find_if(baseline.begin(), baseline.end(),
+                [&result](const auto &entry) { return entry.first == result.name; });
+            if (it == baseline.end() || it->second <= 0.0) {
+                continue;
+            }
+            const double ratio = result.nanosecondsPerIteration / it->second;
+            if (ratio > 1.0 + tolerance) {
+                regressions.push_back({ result.name, it->second, result.nanosecondsPerIteration, ratio });
+            }
+        }
+        return regressions;
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        Function function;
+    };
+
+    /// @brief 指定回数繰り返した時間(ナノ秒)
+    static double Measure(const Function &function, uint64_t iterationCount) {
+        const auto begin = Clock::now();
+        function(iterationCount);
+        const auto end = Clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count();
+    }
+
+    Result RunEntry(const Entry &entry) const {
+        // 1サンプルが最低時間以上になるまで繰り返し回数を増やす(キャッシュを温める意味もある)
+        const double minSampleNanoseconds = std::chrono::duration<double, std::nano>(minSampleTime_).count();
+        uint64_t iterationCount = 1;
+        for (;;) {
+            const double elapsed = Measure(entry.function, iterationCount);
+            if (elapsed >= minSampleNanoseconds || iterationCount >= kMaxIterationCount) {
+                break;
+            }
+            // 足りない分を見積もって一気に増やす(見積もりが外れても最大10倍まで)
+            const double scale = elapsed > 0.0 ? minSampleNanoseconds / elapsed * 1.2 : 10.0;
+            iterationCount = std::min(kMaxIterationCount,
+                std::max(iterationCount + 1, static_cast<uint64_t>(static_cast<double>(iterationCount) * std::min(scale, 10.0))));
+        }
+
+        std::vector<double> samples(sampleCount_);
+        for (auto &sample : samples) {
+            sample = Measure(entry.function, iterationCount) / static_cast<double>(iterationCount);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = entry.name;
+        result.nanosecondsPerIteration = samples[samples.size() / 2];
+        result.minNanosecondsPerIteration = samples.front();
+        result.maxNanosecondsPerIteration = samples.back();
+        result.iterationCount = iterationCount;
+        result.sampleCount = sampleCount_;
+        return result;
+    }
+
+    static constexpr uint64_t kMaxIterationCount = 1ull << 32;
+
+    std::vector<Entry> entries_;
+    uint32_t sampleCount_ = 15;
+    Clock::duration minSampleTime_ = std::chrono::milliseconds(2);
+};
+
+} // namespace MyStd
\ No newline at end of file
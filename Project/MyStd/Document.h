@@ -0,0 +1,584 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "LinearArena.h"
+
+namespace MyStd {
+
+class Document;
+class DocumentNode;
+class DocumentValue;
+
+/// @brief Document の値の種類
+enum class DocumentType : uint8_t {
+    Null,
+    Bool,
+    Int,
+    Float,
+    String,
+    Array,
+    Object,
+};
+
+/// @brief オブジェクトのメンバー(キーと値)
+struct DocumentMember {
+    // キーのハッシュ値。メンバーはこの値の順に並べる
+    uint64_t hash;
+    std::string_view key;
+    DocumentValue *value;
+
+    /// @brief キーのハッシュ値の計算。8バイトずつまとめて混ぜる
+    static uint64_t Hash(std::string_view key) {
+        constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+        const char *data = key.data();
+        size_t remaining = key.size();
+        uint64_t hash = 0xCBF29CE484222325ull ^ remaining;
+        while (remaining >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, 8);
+            hash = (hash ^ word) * kMultiplier;
+            hash ^= hash >> 32;
+            data += 8;
+            remaining -= 8;
+        }
+        uint64_t tail = 0;
+        for (size_t i = 0; i < remaining; ++i) {
+            tail |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+        }
+        hash = (hash ^ tail) * kMultiplier;
+        return hash ^ (hash >> 29);
+    }
+};
+
+/// @brief Document の値。種類ごとのタグを持ち、RTTI を使わずに型を調べられる
+class DocumentValue {
+public:
+    // アリーナを使わずに値の中に直接持てる文字列の長さ
+    static constexpr size_t kSmallStringCapacity = 16;
+
+    DocumentType GetType() const { return type_; }
+    bool IsNull() const { return type_ == DocumentType::Null; }
+    bool IsBool() const { return type_ == DocumentType::Bool; }
+    bool IsInt() const { return type_ == DocumentType::Int; }
+    bool IsFloat() const { return type_ == DocumentType::Float; }
+    bool IsNumber() const { return IsInt() || IsFloat(); }
+    bool IsString() const { return type_ == DocumentType::String; }
+    bool IsArray() const { return type_ == DocumentType::Array; }
+    bool IsObject() const { return type_ == DocumentType::Object; }
+
+    /// @brief 型名の取得
+    const char *GetTypeName() const {
+        switch (type_) {
+            case DocumentType::Bool:   return "bool";
+            case DocumentType::Int:    return "int";
+            case DocumentType::Float:  return "float";
+            case DocumentType::String: return "string";
+            case DocumentType::Array:  return "array";
+            case DocumentType::Object: return "object";
+            default:                   return "null";
+        }
+    }
+
+    /// @brief 文字列の取得。文字列でなければ空を返す
+    std::string_view GetString() const {
+        if (type_ != DocumentType::String) {
+            return {};
+        }
+        if (isSmallString_) {
+            return std::string_view(payload_.smallString, size_);
+        }
+        return std::string_view(payload_.string, size_);
+    }
+
+    /// @brief 配列の要素数、またはオブジェクトのメンバー数
+    size_t size() const {
+        return (type_ == DocumentType::Array || type_ == DocumentType::Object) ? size_ : 0;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /// @brief 配列の要素
+    std::span<DocumentValue *const> GetElements() const {
+        if (type_ != DocumentType::Array) {
+            return {};
+        }
+        return std::span<DocumentValue *const>(payload_.elements, size_);
+    }
+    /// @brief オブジェクトのメンバー(キーのハッシュ値の昇順)
+    std::span<const DocumentMember> GetMembers() const {
+        if (type_ != DocumentType::Object) {
+            return {};
+        }
+        return std::span<const DocumentMember>(payload_.members, size_);
+    }
+
+    /// @brief キーでメンバーを検索する(ハッシュ値の二分探索)
+    /// @return 値へのポインタ。見つからなければnullptr
+    const DocumentValue *Find(std::string_view key) const {
+        const size_t index = FindIndex(key, DocumentMember::Hash(key));
+        return index < size() ? payload_.members[index].value : nullptr;
+    }
+    bool contains(std::string_view key) const {
+        return Find(key) != nullptr;
+    }
+
+    const DocumentValue &at(std::string_view key) const {
+        const DocumentValue *value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("Key not found: " + std::string(key));
+        }
+        return *value;
+    }
+    const DocumentValue &at(size_t index) const {
+        if (type_ != DocumentType::Array || index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *payload_.elements[index];
+    }
+
+    /// @brief 値の取得を試みる
+    /// @param out 取得先
+    /// @return 型が合っていればtrue
+    template<typename T>
+    bool TryGet(T &out) const {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (type_ != DocumentType::Bool) { return false; }
+            out = payload_.boolean;
+        } else if constexpr (std::is_integral_v<T>) {
+            if (type_ != DocumentType::Int) { return false; }
+            out = static_cast<T>(payload_.integer);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if (type_ == DocumentType::Int) {
+                out = static_cast<T>(payload_.integer);
+            } else if (type_ == DocumentType::Float) {
+                out = static_cast<T>(payload_.number);
+            } else {
+                return false;
+            }
+        } else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+            if (type_ != DocumentType::String) { return false; }
+            out = T(GetString());
+        } else {
+            static_assert(sizeof(T) == 0, "Unsupported type for DocumentValue");
+        }
+        return true;
+    }
+
+    /// @brief 値の取得。型が合わなければ例外を投げる
+    template<typename T>
+    T GetTo() const {
+        T value{};
+        if (!TryGet(value)) {
+            throw std::invalid_argument(std::string("Document type mismatch: value is ") + GetTypeName());
+        }
+        return value;
+    }
+
+private:
+    friend class Document;
+    friend class DocumentNode;
+
+    /// @brief キーを挿入する位置(ハッシュ値、キーの順で最初に key 以上になる位置)
+    size_t LowerBound(std::string_view key, uint64_t hash) const {
+        if (type_ != DocumentType::Object) {
+            return 0;
+        }
+        const DocumentMember *begin = payload_.members;
+        const DocumentMember *end = begin + size_;
+        // 分岐予測の外れを避けるため、条件分岐を使わない二分探索にする
+        const DocumentMember *it = begin;
+        size_t count = size_;
+        while (count > 1) {
+            const size_t half = count / 2;
+            it = (it[half - 1].hash < hash) ? it + half : it;
+            count -= half;
+        }
+        if (count == 1 && it->hash < hash) {
+            ++it;
+        }
+        // ハッシュ値が衝突している間はキーで比べる
+        while (it != end && it->hash == hash && it->key < key) {
+            ++it;
+        }
+        return static_cast<size_t>(it - begin);
+    }
+    /// @brief キーの位置の検索
+    /// @return 位置。見つからなければ size()
+    size_t FindIndex(std::string_view key, uint64_t hash) const {
+        const size_t index = LowerBound(key, hash);
+        if (index < size() && payload_.members[index].hash == hash && payload_.members[index].key == key) {
+            return index;
+        }
+        return size();
+    }
+
+    union Payload {
+        bool boolean;
+        int64_t integer = 0;
+        double number;
+        const char *string;
+        char smallString[kSmallStringCapacity];
+        DocumentValue **elements;
+        DocumentMember *members;
+    } payload_;
+    // 文字列の長さ、または配列・オブジェクトの要素数
+    uint32_t size_ = 0;
+    // 配列・オブジェクトの確保済みの要素数
+    uint32_t capacity_ = 0;
+    DocumentType type_ = DocumentType::Null;
+    bool isSmallString_ = false;
+};
+
+/// @brief アリーナに値を確保する木構造のデータ。
+/// 個々の値は解放せず、Document の破棄か Clear でまとめて解放する。
+/// ムーブすると、ムーブ元から取得した DocumentNode は使えなくなる(値は残るが、ハンドルがムーブ元の Document を指すため)。
+/// ムーブ後は新しい Document から GetRoot で取得し直すこと
+class Document {
+public:
+    // アリーナの1ブロックあたりの既定の容量
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit Document(size_t blockSize = kDefaultBlockSize) : blockSize_(blockSize) {
+        root_ = NewValue();
+    }
+    ~Document() = default;
+    Document(const Document &) = delete;
+    Document &operator=(const Document &) = delete;
+    Document(Document &&) noexcept = default;
+    Document &operator=(Document &&) noexcept = default;
+
+    /// @brief ルートの取得
+    DocumentNode GetRoot();
+    /// @brief ルートの値の取得
+    const DocumentValue &GetRootValue() const { return *root_; }
+
+    DocumentNode operator[](std::string_view key);
+    DocumentNode operator[](size_t index);
+
+    /// @brief 全ての値を解放して空にする
+    void Clear() {
+        blocks_.clear();
+        root_ = NewValue();
+    }
+
+    /// @brief アリーナから確保したサイズの取得
+    size_t GetAllocatedBytes() const {
+        size_t bytes = 0;
+        for (const auto &block : blocks_) {
+            bytes += block->GetUsed();
+        }
+        return bytes;
+    }
+
+private:
+    friend class DocumentNode;
+
+    void *Allocate(size_t size, size_t alignment) {
+        if (blocks_.empty() || !Fits(*blocks_.back(), size, alignment)) {
+            // 足りなければ新しいブロックを追加する(大きな確保はそのサイズで確保)
+            blocks_.push_back(std::make_unique<LinearArena>(std::max(blockSize_, size + alignment)));
+        }
+        return blocks_.back()->Allocate(size, alignment);
+    }
+    template<typename T>
+    T *Allocate(size_t count) {
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    static bool Fits(const LinearArena &arena, size_t size, size_t alignment) {
+        const size_t alignedOffset = (arena.GetUsed() + alignment - 1) & ~(alignment - 1);
+        return alignedOffset + size <= arena.GetCapacity();
+    }
+
+    DocumentValue *NewValue() {
+        return new (Allocate<DocumentValue>(1)) DocumentValue();
+    }
+
+    void SetString(DocumentValue &value, std::string_view str) {
+        value.type_ = DocumentType::String;
+        value.size_ = static_cast<uint32_t>(str.size());
+        value.capacity_ = 0;
+        if (str.size() <= DocumentValue::kSmallStringCapacity) {
+            value.isSmallString_ = true;
+            std::memcpy(value.payload_.smallString, str.data(), str.size());
+        } else {
+            value.isSmallString_ = false;
+            value.payload_.string = CopyString(str);
+        }
+    }
+    const char *CopyString(std::string_view str) {
+        char *data = Allocate<char>(str.size());
+        std::memcpy(data, str.data(), str.size());
+        return data;
+    }
+
+    /// @brief 値の複製をこの Document のアリーナに作る
+    DocumentValue CloneValue(const DocumentValue &source) {
+        DocumentValue value;
+        switch (source.type_) {
+            case DocumentType::String:
+                SetString(value, source.GetString());
+                break;
+            case DocumentType::Array:
+                value.type_ = DocumentType::Array;
+                for (const DocumentValue *element : source.GetElements()) {
+                    AppendElement(value) = CloneValue(*element);
+                }
+                break;
+            case DocumentType::Object:
+                value.type_ = DocumentType::Object;
+                for (const DocumentMember &member : source.GetMembers()) {
+                    FindOrInsertMember(value, member.key) = CloneValue(*member.value);
+                }
+                break;
+            default:
+                value = source;
+                break;
+        }
+        return value;
+    }
+
+    /// @brief 配列に要素を1つ追加する
+    DocumentValue &AppendElement(DocumentValue &array) {
+        if (array.size_ == array.capacity_) {
+            const uint32_t newCapacity = std::max<uint32_t>(4, array.capacity_ * 2);
+            DocumentValue **elements = Allocate<DocumentValue *>(newCapacity);
+            std::copy_n(array.payload_.elements, array.size_, elements);
+            array.payload_.elements = elements;
+            array.capacity_ = newCapacity;
+        }
+        DocumentValue *element = NewValue();
+        array.payload_.elements[array.size_++] = element;
+        return *element;
+    }
+
+    /// @brief オブジェクトのメンバーを取得する。無ければ並び順を保つ位置に追加する
+    DocumentValue &FindOrInsertMember(DocumentValue &object, std::string_view key) {
+        const uint64_t hash = DocumentMember::Hash(key);
+        const size_t index = object.LowerBound(key, hash);
+        if (index < object.size_ && object.payload_.members[index].hash == hash && object.payload_.members[index].key == key) {
+            return *object.payload_.members[index].value;
+        }
+        if (object.size_ == object.capacity_) {
+            const uint32_t newCapacity = std::max<uint32_t>(4, object.capacity_ * 2);
+            DocumentMember *members = Allocate<DocumentMember>(newCapacity);
+            std::copy_n(object.payload_.members, object.size_, members);
+            object.payload_.members = members;
+            object.capacity_ = newCapacity;
+        }
+        DocumentMember *members = object.payload_.members;
+        std::copy_backward(members + index, members + object.size_, members + object.size_ + 1);
+        members[index] = DocumentMember{ hash, std::string_view(CopyString(key), key.size()), NewValue() };
+        ++object.size_;
+        return *members[index].value;
+    }
+
+    size_t blockSize_;
+    std::vector<std::unique_ptr<LinearArena>> blocks_;
+    DocumentValue *root_ = nullptr;
+};
+
+/// @brief Document の値を編集するためのハンドル。
+/// AnyUnorderedMap・AnyVector と同じ使い方ができる。値のアドレスは Clear まで変わらない。
+/// 取得元の Document へのポインタを持つので、Document をムーブ・破棄した後は使えない
+class DocumentNode {
+public:
+    DocumentNode(Document &document, DocumentValue &value) : document_(&document), value_(&value) {}
+    DocumentNode(const DocumentNode &) = default;
+
+    /// @brief 値の代入。ハンドルの付け替えではなく、参照先に値を複製する
+    DocumentNode &operator=(const DocumentNode &other) {
+        return *this = other.GetValue();
+    }
+    DocumentNode &operator=(const DocumentValue &value) {
+        if (value_ != &value) {
+            *value_ = document_->CloneValue(value);
+        }
+        return *this;
+    }
+
+    template<typename T>
+    operator T() const {
+        return GetTo<T>();
+    }
+
+    /// @brief メンバーの取得。無ければ追加する(null ならオブジェクトにする)
+    DocumentNode operator[](std::string_view key) {
+        if (value_->IsNull()) {
+            SetObject();
+        }
+        if (!value_->IsObject()) {
+            throw std::invalid_argument(std::string("Document value is not an object: ") + GetTypeName());
+        }
+        return DocumentNode(*document_, document_->FindOrInsertMember(*value_, key));
+    }
+    /// @brief 要素の取得。範囲外ならサイズを拡張する(null なら配列にする)
+    DocumentNode operator[](size_t index) {
+        if (value_->IsNull()) {
+            SetArray();
+        }
+        if (!value_->IsArray()) {
+            throw std::invalid_argument(std::string("Document value is not an array: ") + GetTypeName());
+        }
+        while (index >= value_->size_) {
+            document_->AppendElement(*value_);
+        }
+        return DocumentNode(*document_, *value_->payload_.elements[index]);
+    }
+
+    DocumentNode &operator=(std::nullptr_t) {
+        Reset(DocumentType::Null);
+        return *this;
+    }
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    DocumentNode &operator=(T value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            Reset(DocumentType::Bool);
+            value_->payload_.boolean = value;
+        } else if constexpr (std::is_integral_v<T>) {
+            Reset(DocumentType::Int);
+            value_->payload_.integer = static_cast<int64_t>(value);
+        } else {
+            Reset(DocumentType::Float);
+            value_->payload_.number = static_cast<double>(value);
+        }
+        return *this;
+    }
+    DocumentNode &operator=(std::string_view value) {
+        document_->SetString(*value_, value);
+        return *this;
+    }
+    DocumentNode &operator=(const std::string &value) {
+        return *this = std::string_view(value);
+    }
+    DocumentNode &operator=(const char *value) {
+        return *this = std::string_view(value);
+    }
+
+    /// @brief 空の配列にする
+    DocumentNode &SetArray() {
+        Reset(DocumentType::Array);
+        return *this;
+    }
+    /// @brief 空のオブジェクトにする
+    DocumentNode &SetObject() {
+        Reset(DocumentType::Object);
+        return *this;
+    }
+
+    DocumentNode at(std::string_view key) {
+        return DocumentNode(*document_, const_cast<DocumentValue &>(value_->at(key)));
+    }
+    DocumentNode at(size_t index) {
+        return DocumentNode(*document_, const_cast<DocumentValue &>(value_->at(index)));
+    }
+    bool contains(std::string_view key) const {
+        return value_->contains(key);
+    }
+
+    /// @brief 配列の末尾に追加する
+    /// @return 追加した要素
+    template<typename T>
+    DocumentNode push_back(const T &value) {
+        DocumentNode element = emplace_back();
+        element = value;
+        return element;
+    }
+    /// @brief 配列の末尾に null を追加する
+    /// @return 追加した要素
+    DocumentNode emplace_back() {
+        if (value_->IsNull()) {
+            SetArray();
+        }
+        if (!value_->IsArray()) {
+            throw std::invalid_argument(std::string("Document value is not an array: ") + GetTypeName());
+        }
+        return DocumentNode(*document_, document_->AppendElement(*value_));
+    }
+    void pop_back() {
+        if (value_->IsArray() && value_->size_ > 0) {
+            --value_->size_;
+        }
+    }
+    DocumentNode front() {
+        if (value_->empty()) {
+            throw std::out_of_range("Document array is empty");
+        }
+        return at(size_t{ 0 });
+    }
+    DocumentNode back() {
+        if (value_->empty()) {
+            throw std::out_of_range("Document array is empty");
+        }
+        return at(value_->size() - 1);
+    }
+
+    /// @brief メンバーの削除
+    void erase(std::string_view key) {
+        const size_t index = value_->FindIndex(key, DocumentMember::Hash(key));
+        if (index < value_->size()) {
+            DocumentMember *members = value_->payload_.members;
+            std::copy(members + index + 1, members + value_->size_, members + index);
+            --value_->size_;
+        }
+    }
+    /// @brief 要素・メンバーを全て削除する(確保済みの領域は再利用する)
+    void clear() {
+        if (value_->IsArray() || value_->IsObject()) {
+            value_->size_ = 0;
+        }
+    }
+    size_t size() const {
+        return value_->size();
+    }
+    bool empty() const {
+        return value_->empty();
+    }
+
+    const char *GetTypeName() const {
+        return value_->GetTypeName();
+    }
+    template<typename T>
+    T GetTo() const {
+        return value_->GetTo<T>();
+    }
+    template<typename T>
+    bool TryGet(T &out) const {
+        return value_->TryGet(out);
+    }
+
+    DocumentValue &GetValue() const {
+        return *value_;
+    }
+
+private:
+    void Reset(DocumentType type) {
+        *value_ = DocumentValue();
+        value_->type_ = type;
+    }
+
+    Document *document_;
+    DocumentValue *value_;
+};
+
+inline DocumentNode Document::GetRoot() {
+    return DocumentNode(*this, *root_);
+}
+inline DocumentNode Document::operator[](std::string_view key) {
+    return GetRoot()[key];
+}
+inline DocumentNode Document::operator[](size_t index) {
+    return GetRoot()[index];
+}
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+#include <any>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "AnyUnorderedMap.h"
+#include "AnyVector.h"
+#include "Document.h"
+
+namespace MyStd {
+
+/// @brief AnyUnorderedMap・AnyVector と Document の相互変換。
+/// std::any の値は bool・整数・浮動小数点数・文字列だけを扱い、それ以外は std::invalid_argument を投げる。
+/// Document は値と子要素を同時に持てないので、両方を持つ要素も std::invalid_argument を投げる
+namespace DocumentCompat {
+
+namespace Detail {
+
+/// @brief std::any の値を Document の値に書き込む
+inline void AssignAny(DocumentNode node, const std::any &value) {
+    const std::type_info &type = value.type();
+    if (type == typeid(bool)) {
+        node = std::any_cast<bool>(value);
+    } else if (type == typeid(int)) {
+        node = std::any_cast<int>(value);
+    } else if (type == typeid(unsigned int)) {
+        node = std::any_cast<unsigned int>(value);
+    } else if (type == typeid(long long)) {
+        node = std::any_cast<long long>(value);
+    } else if (type == typeid(long)) {
+        node = std::any_cast<long>(value);
+    } else if (type == typeid(size_t)) {
+        node = static_cast<int64_t>(std::any_cast<size_t>(value));
+    } else if (type == typeid(float)) {
+        node = std::any_cast<float>(value);
+    } else if (type == typeid(double)) {
+        node = std::any_cast<double>(value);
+    } else if (type == typeid(std::string)) {
+        node = std::any_cast<const std::string &>(value);
+    } else if (type == typeid(const char *)) {
+        node = std::any_cast<const char *>(value);
+    } else {
+        throw std::invalid_argument(std::string("Unsupported type for Document: ") + type.name());
+    }
+}
+
+/// @brief Document のスカラー値を std::any にする。
+/// Document は元の型を持たないので、整数は int(範囲外なら int64_t)、浮動小数点数は float にする
+inline std::any ToAny(const DocumentValue &value) {
+    switch (value.GetType()) {
+        case DocumentType::Bool:
+            return value.GetTo<bool>();
+        case DocumentType::Int: {
+            const int64_t integer = value.GetTo<int64_t>();
+            if (integer >= (std::numeric_limits<int>::min)() && integer <= (std::numeric_limits<int>::max)()) {
+                return static_cast<int>(integer);
+            }
+            return integer;
+        }
+        case DocumentType::Float:
+            return value.GetTo<float>();
+        case DocumentType::String:
+            return value.GetTo<std::string>();
+        default:
+            return {};
+    }
+}
+
+inline void Write(DocumentNode node, const AnyVector &source);
+
+inline void Write(DocumentNode node, const AnyUnorderedMap &source) {
+    if (source.HasValue() && !source.empty()) {
+        throw std::invalid_argument("AnyUnorderedMap element has both a value and children");
+    }
+    if (source.HasValue()) {
+        // 配列は AnyVector を値に持たせて表す
+        if (source.GetAny().type() == typeid(AnyVector)) {
+            Write(node, std::any_cast<const AnyVector &>(source.GetAny()));
+        } else {
+            AssignAny(node, source.GetAny());
+        }
+        return;
+    }
+    node.SetObject();
+    for (const auto &[key, child] : source) {
+        Write(node[key], child);
+    }
+}
+
+inline void Write(DocumentNode node, const AnyVector &source) {
+    if (source.HasValue() && !source.empty()) {
+        throw std::invalid_argument("AnyVector element has both a value and children");
+    }
+    if (source.HasValue()) {
+        if (source.GetAny().type() == typeid(AnyUnorderedMap)) {
+            Write(node, std::any_cast<const AnyUnorderedMap &>(source.GetAny()));
+        } else {
+            AssignAny(node, source.GetAny());
+        }
+        return;
+    }
+    node.SetArray();
+    for (const auto &child : source) {
+        Write(node.emplace_back(), child);
+    }
+}
+
+} // namespace Detail
+
+/// @brief AnyUnorderedMap の木を Document に変換する
+/// @param source 変換元
+/// @param document 書き込み先(中身は置き換える)
+inline void ToDocument(const AnyUnorderedMap &source, Document &document) {
+    document.Clear();
+    Detail::Write(document.GetRoot(), source);
+}
+
+/// @brief AnyVector の木を Document に変換する
+/// @param source 変換元
+/// @param document 書き込み先(中身は置き換える)
+inline void ToDocument(const AnyVector &source, Document &document) {
+    document.Clear();
+    Detail::Write(document.GetRoot(), source);
+}
+
+inline AnyVector ToAnyVector(const DocumentValue &value);
+
+/// @brief Document の値を AnyUnorderedMap に変換する。
+/// オブジェクトは子要素に、配列は AnyVector を値に持たせ、それ以外は値にする
+inline AnyUnorderedMap ToAnyUnorderedMap(const DocumentValue &value) {
+    AnyUnorderedMap result;
+    if (value.IsObject()) {
+        for (const DocumentMember &member : value.GetMembers()) {
+            result[std::string(member.key)] = ToAnyUnorderedMap(*member.value);
+        }
+    } else if (value.IsArray()) {
+        result = std::any(ToAnyVector(value));
+    } else if (!value.IsNull()) {
+        result = Detail::ToAny(value);
+    }
+    return result;
+}
+
+/// @brief Document の値を AnyVector に変換する。
+/// 配列は子要素に、オブジェクトは AnyUnorderedMap を値に持たせ、それ以外は値にする
+inline AnyVector ToAnyVector(const DocumentValue &value) {
+    AnyVector result;
+    if (value.IsArray()) {
+        for (const DocumentValue *element : value.GetElements()) {
+            result.push_back(ToAnyVector(*element));
+        }
+    } else if (value.IsObject()) {
+        result = std::any(ToAnyUnorderedMap(value));
+    } else if (!value.IsNull()) {
+        result = Detail::ToAny(value);
+    }
+    return result;
+}
+
+} // namespace DocumentCompat
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace MyStd {
+
+/// @brief 可変のフレーム時間を一定間隔のティックに分けるアキュムレータ。
+/// 描画はティックの途中になるので、前後のティックの状態を GetAlpha で補間して使う
+class FixedTimestep {
+public:
+    FixedTimestep() = default;
+    /// @param tickRate 1秒あたりのティック数
+    /// @param maxSubsteps 1フレームで進める最大ティック数
+    FixedTimestep(double tickRate, uint32_t maxSubsteps) {
+        SetTickRate(tickRate);
+        SetMaxSubsteps(maxSubsteps);
+    }
+
+    /// @brief 1秒あたりのティック数を設定する
+    void SetTickRate(double tickRate) {
+        tickDelta_ = tickRate > 0.0 ? 1.0 / tickRate : kDefaultTickDelta;
+        accumulator_ = std::min(accumulator_, tickDelta_);
+    }
+    /// @brief 1フレームで進める最大ティック数を設定する。
+    /// 処理落ちでティックが追いつかなくなる(処理が重くなりさらに遅れる)のを防ぐ
+    void SetMaxSubsteps(uint32_t maxSubsteps) {
+        maxSubsteps_ = std::max(maxSubsteps, 1u);
+    }
+
+    /// @brief フレームの経過時間を加え、このフレームで進めるティック数を求める
+    /// @param frameDeltaSeconds フレームの経過時間(秒)
+    /// @return 進めるティック数
+    uint32_t Advance(double frameDeltaSeconds) {
+        accumulator_ += std::max(frameDeltaSeconds, 0.0);
+        uint32_t tickCount = 0;
+        while (accumulator_ >= tickDelta_ && tickCount < maxSubsteps_) {
+            accumulator_ -= tickDelta_;
+            ++tickCount;
+        }
+        if (accumulator_ >= tickDelta_) {
+            // 追いつけない分は捨てて、次のフレームに持ち越さない
+            droppedSeconds_ += accumulator_ - std::fmod(accumulator_, tickDelta_);
+            accumulator_ = std::fmod(accumulator_, tickDelta_);
+        }
+        totalTickCount_ += tickCount;
+        return tickCount;
+    }
+
+    /// @brief 最後のティックから次のティックまでの進み具合(0以上1未満)
+    double GetAlpha() const { return accumulator_ / tickDelta_; }
+    /// @brief 1ティックの時間(秒)
+    double GetTickDelta() const { return tickDelta_; }
+    /// @brief 1フレームで進める最大ティック数
+    uint32_t GetMaxSubsteps() const { return maxSubsteps_; }
+    /// @brief これまでに進めたティック数
+    uint64_t GetTotalTickCount() const { return totalTickCount_; }
+    /// @brief 処理落ちで捨てた時間の合計(秒)
+    double GetDroppedSeconds() const { return droppedSeconds_; }
+
+    /// @brief 溜まっている時間と統計を捨てる
+    void Reset() {
+        accumulator_ = 0.0;
+        totalTickCount_ = 0;
+        droppedSeconds_ = 0.0;
+    }
+
+private:
+    static constexpr double kDefaultTickDelta = 1.0 / 60.0;
+
+    double tickDelta_ = kDefaultTickDelta;
+    double accumulator_ = 0.0;
+    uint32_t maxSubsteps_ = 8;
+    uint64_t totalTickCount_ = 0;
+    double droppedSeconds_ = 0.0;
+};
+
+} // namespace MyStd
\ No newline at end of file
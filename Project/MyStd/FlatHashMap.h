@@ -0,0 +1,646 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define MYSTD_FLAT_HASH_USE_SSE2 1
+#else
+#define MYSTD_FLAT_HASH_USE_SSE2 0
+#endif
+
+namespace MyStd {
+
+/// @brief FlatHashMap 用のハッシュ関数。文字列は std::string_view でも検索できる
+template<typename Key>
+struct FlatHash {
+    size_t operator()(const Key &key) const noexcept {
+        return std::hash<Key>{}(key);
+    }
+};
+template<>
+struct FlatHash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const noexcept {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+namespace FlatHashDetail {
+
+using Ctrl = int8_t;
+// 空きスロット
+constexpr Ctrl kEmpty = -128;
+// 削除済みスロット
+constexpr Ctrl kDeleted = -2;
+// 1回に調べる制御バイト数
+constexpr size_t kGroupWidth = 16;
+
+/// @brief ハッシュ値を全ビットに散らす(整数キーの std::hash は恒等関数のことがあるため)
+inline uint64_t Mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/// @brief 16個の制御バイトをまとめて比較するグループ
+struct Group {
+    explicit Group(const Ctrl *ctrl) {
+#if MYSTD_FLAT_HASH_USE_SSE2
+        bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            bytes[i] = ctrl[i];
+        }
+#endif
+    }
+
+    /// @brief 指定したハッシュ値の下位7ビットと一致するスロットのビットマスク
+    uint32_t Match(Ctrl h2) const {
+#if MYSTD_FLAT_HASH_USE_SSE2
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(bytes[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /// @brief 空きスロットのビットマスク
+    uint32_t MatchEmpty() const {
+        return Match(kEmpty);
+    }
+
+    /// @brief 空きか削除済みのスロットのビットマスク
+    uint32_t MatchEmptyOrDeleted() const {
+#if MYSTD_FLAT_HASH_USE_SSE2
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(bytes[i] < -1) << i;
+        }
+        return mask;
+#endif
+    }
+
+#if MYSTD_FLAT_HASH_USE_SSE2
+    __m128i bytes;
+#else
+    Ctrl bytes[kGroupWidth];
+#endif
+};
+
+/// @brief オープンアドレス法のハッシュテーブル本体。
+/// 制御バイトにハッシュ値の下位7ビットを持たせ、16個ずつまとめて比較する(Swiss table 方式)
+template<typename Policy, typename Hash, typename Eq>
+class Table {
+public:
+    using key_type = typename Policy::key_type;
+    using slot_type = typename Policy::slot_type;
+    using value_type = typename Policy::value_type;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+
+    template<bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+        using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+        using TablePointer = std::conditional_t<IsConst, const Table *, Table *>;
+
+        Iterator() = default;
+        Iterator(TablePointer table, size_t index) : table_(table), index_(index) {}
+        template<bool C = IsConst, typename = std::enable_if_t<!C>>
+        operator Iterator<true>() const {
+            return Iterator<true>(table_, index_);
+        }
+
+        reference operator*() const { return table_->slots_[index_]; }
+        pointer operator->() const { return &table_->slots_[index_]; }
+        Iterator &operator++() {
+            index_ = table_->SkipEmpty(index_ + 1);
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++*this;
+            return result;
+        }
+        bool operator==(const Iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+
+    private:
+        friend class Table;
+        TablePointer table_ = nullptr;
+        size_t index_ = 0;
+    };
+    using iterator = Iterator<Policy::kIsConstIterator>;
+    using const_iterator = Iterator<true>;
+
+    // 透過的な検索に使えるキーの型(イテレータは除く)
+    template<typename K, typename H>
+    using TransparentKey = std::enable_if_t<!std::is_convertible_v<const K &, const_iterator>, typename H::is_transparent>;
+
+    Table() = default;
+    Table(const Table &other) {
+        try {
+            reserve(other.size_);
+            for (const auto &slot : other) {
+                EmplaceUnique(Policy::GetKey(slot), slot);
+            }
+        } catch (...) {
+            // コンストラクタの途中ではデストラクタが呼ばれないので、ここで解放する
+            Destroy();
+            throw;
+        }
+    }
+    Table(Table &&other) noexcept {
+        Swap(other);
+    }
+    ~Table() {
+        Destroy();
+    }
+    Table &operator=(const Table &other) {
+        if (this != &other) {
+            Table copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+    Table &operator=(Table &&other) noexcept {
+        if (this != &other) {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    iterator begin() { return iterator(this, SkipEmpty(0)); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, SkipEmpty(0)); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    void clear() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~slot_type();
+            }
+        }
+        if (capacity_ > 0) {
+            std::fill(ctrl_, ctrl_ + capacity_ + kGroupWidth, kEmpty);
+        }
+        size_ = 0;
+        growthLeft_ = MaxLoad(capacity_);
+    }
+
+    /// @brief 指定数の要素を再ハッシュ無しで入れられるようにする
+    void reserve(size_t count) {
+        size_t capacity = kGroupWidth;
+        while (MaxLoad(capacity) < count) {
+            capacity *= 2;
+        }
+        if (capacity > capacity_) {
+            Rehash(capacity);
+        }
+    }
+
+    iterator find(const key_type &key) {
+        return iterator(this, FindIndex(key));
+    }
+    const_iterator find(const key_type &key) const {
+        return const_iterator(this, FindIndex(key));
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    iterator find(const K &key) {
+        return iterator(this, FindIndex(key));
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    const_iterator find(const K &key) const {
+        return const_iterator(this, FindIndex(key));
+    }
+
+    bool contains(const key_type &key) const {
+        return FindIndex(key) != capacity_;
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    bool contains(const K &key) const {
+        return FindIndex(key) != capacity_;
+    }
+    size_t count(const key_type &key) const {
+        return contains(key) ? 1 : 0;
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    size_t count(const K &key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    size_t erase(const key_type &key) {
+        return EraseKey(key);
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    size_t erase(const K &key) {
+        return EraseKey(key);
+    }
+    iterator erase(const_iterator position) {
+        EraseIndex(position.index_);
+        return iterator(this, SkipEmpty(position.index_ + 1));
+    }
+
+protected:
+    /// @brief キーが無ければ作って、スロット番号と追加したかどうかを返す。
+    /// 要素の構築で例外が出た場合は追加しなかった状態に戻す(再ハッシュ済みなら容量だけ増える)
+    template<typename K, typename... Args>
+    std::pair<size_t, bool> EmplaceUnique(const K &key, Args &&...args) {
+        const uint64_t hash = HashOf(key);
+        size_t index = FindIndex(key, hash);
+        if (index != capacity_) {
+            return { index, false };
+        }
+        PrepareGrowth();
+        index = FindInsertIndex(hash);
+        new (&slots_[index]) slot_type(std::forward<Args>(args)...);
+        // 構築できてから制御バイトを設定するので、例外が出ても空きスロットのまま
+        if (ctrl_[index] == kEmpty) {
+            --growthLeft_;
+        }
+        SetCtrl(index, H2(hash));
+        ++size_;
+        return { index, true };
+    }
+
+    slot_type *SlotAt(size_t index) { return &slots_[index]; }
+    const slot_type *SlotAt(size_t index) const { return &slots_[index]; }
+
+    template<typename K>
+    size_t FindIndex(const K &key) const {
+        return FindIndex(key, HashOf(key));
+    }
+
+    void Swap(Table &other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growthLeft_, other.growthLeft_);
+    }
+
+private:
+    static size_t MaxLoad(size_t capacity) {
+        // 負荷率は 7/8 まで
+        return capacity - capacity / 8;
+    }
+
+    template<typename K>
+    uint64_t HashOf(const K &key) const {
+        return Mix(static_cast<uint64_t>(Hash{}(key)));
+    }
+    static Ctrl H2(uint64_t hash) {
+        return static_cast<Ctrl>(hash & 0x7F);
+    }
+    static size_t H1(uint64_t hash) {
+        return static_cast<size_t>(hash >> 7);
+    }
+
+    size_t SkipEmpty(size_t index) const {
+        while (index < capacity_ && ctrl_[index] < 0) {
+            ++index;
+        }
+        return index;
+    }
+
+    void SetCtrl(size_t index, Ctrl value) {
+        ctrl_[index] = value;
+        // 先頭のグループは末尾にも複製して、折り返しを気にせず読めるようにする
+        if (index < kGroupWidth) {
+            ctrl_[capacity_ + index] = value;
+        }
+    }
+
+    template<typename K>
+    size_t FindIndex(const K &key, uint64_t hash) const {
+        if (capacity_ == 0) {
+            return capacity_;
+        }
+        const size_t mask = capacity_ - 1;
+        const Ctrl h2 = H2(hash);
+        size_t position = H1(hash) & mask;
+        size_t step = 0;
+        while (true) {
+            Group group(ctrl_ + position);
+            for (uint32_t bits = group.Match(h2); bits != 0; bits &= bits - 1) {
+                const size_t index = (position + std::countr_zero(bits)) & mask;
+                if (Eq{}(Policy::GetKey(slots_[index]), key)) {
+                    return index;
+                }
+            }
+            if (group.MatchEmpty() != 0) {
+                return capacity_;
+            }
+            step += kGroupWidth;
+            position = (position + step) & mask;
+        }
+    }
+
+    /// @brief 1つ追加できるように、空きが無ければ再ハッシュする
+    void PrepareGrowth() {
+        if (growthLeft_ == 0) {
+            // 削除済みが多いだけなら同じ容量で詰め直す
+            const size_t capacity = (capacity_ > 0 && size_ + 1 <= MaxLoad(capacity_) / 2) ?
+                capacity_ : (capacity_ == 0 ? kGroupWidth : capacity_ * 2);
+            Rehash(capacity);
+        }
+    }
+
+    size_t FindInsertIndex(uint64_t hash) const {
+        const size_t mask = capacity_ - 1;
+        size_t position = H1(hash) & mask;
+        size_t step = 0;
+        while (true) {
+            const uint32_t bits = Group(ctrl_ + position).MatchEmptyOrDeleted();
+            if (bits != 0) {
+                return (position + std::countr_zero(bits)) & mask;
+            }
+            step += kGroupWidth;
+            position = (position + step) & mask;
+        }
+    }
+
+    /// @brief 容量を変えて詰め直す。
+    /// 要素のムーブが例外を出し得る型はコピーするので、例外が出ても元の状態のまま(std::vector と同じ)
+    void Rehash(size_t newCapacity) {
+        Ctrl *oldCtrl = ctrl_;
+        slot_type *oldSlots = slots_;
+        const size_t oldCapacity = capacity_;
+        const size_t oldGrowthLeft = growthLeft_;
+
+        Ctrl *newCtrl = new Ctrl[newCapacity + kGroupWidth];
+        slot_type *newSlots = nullptr;
+        try {
+            newSlots = static_cast<slot_type *>(::operator new(sizeof(slot_type) * newCapacity, std::align_val_t(alignof(slot_type))));
+        } catch (...) {
+            delete[] newCtrl;
+            throw;
+        }
+        std::fill(newCtrl, newCtrl + newCapacity + kGroupWidth, kEmpty);
+        ctrl_ = newCtrl;
+        slots_ = newSlots;
+        capacity_ = newCapacity;
+        growthLeft_ = MaxLoad(newCapacity) - size_;
+
+        size_t movedCount = 0;
+        try {
+            for (size_t i = 0; i < oldCapacity; ++i) {
+                if (oldCtrl[i] >= 0) {
+                    const uint64_t hash = HashOf(Policy::GetKey(oldSlots[i]));
+                    const size_t index = FindInsertIndex(hash);
+                    new (&slots_[index]) slot_type(std::move_if_noexcept(oldSlots[i]));
+                    SetCtrl(index, H2(hash));
+                    ++movedCount;
+                }
+            }
+        } catch (...) {
+            // 作った分を壊して元の配列に戻す
+            for (size_t i = 0; i < newCapacity && movedCount > 0; ++i) {
+                if (ctrl_[i] >= 0) {
+                    slots_[i].~slot_type();
+                    --movedCount;
+                }
+            }
+            delete[] newCtrl;
+            ::operator delete(newSlots, std::align_val_t(alignof(slot_type)));
+            ctrl_ = oldCtrl;
+            slots_ = oldSlots;
+            capacity_ = oldCapacity;
+            growthLeft_ = oldGrowthLeft;
+            throw;
+        }
+        if (oldCapacity > 0) {
+            for (size_t i = 0; i < oldCapacity; ++i) {
+                if (oldCtrl[i] >= 0) {
+                    oldSlots[i].~slot_type();
+                }
+            }
+            delete[] oldCtrl;
+            ::operator delete(oldSlots, std::align_val_t(alignof(slot_type)));
+        }
+    }
+
+    template<typename K>
+    size_t EraseKey(const K &key) {
+        const size_t index = FindIndex(key);
+        if (index == capacity_) {
+            return 0;
+        }
+        EraseIndex(index);
+        return 1;
+    }
+
+    void EraseIndex(size_t index) {
+        slots_[index].~slot_type();
+        --size_;
+        // 前後のグループに空きがあり、このスロットを跨いで探索が続いたことが無ければ空きに戻せる
+        const size_t mask = capacity_ - 1;
+        const uint32_t emptyBefore = Group(ctrl_ + ((index - kGroupWidth) & mask)).MatchEmpty();
+        const uint32_t emptyAfter = Group(ctrl_ + index).MatchEmpty();
+        const bool wasNeverFull = emptyBefore != 0 && emptyAfter != 0 &&
+            static_cast<size_t>(std::countl_zero(static_cast<uint16_t>(emptyBefore)) + std::countr_zero(emptyAfter)) < kGroupWidth;
+        if (wasNeverFull) {
+            SetCtrl(index, kEmpty);
+            ++growthLeft_;
+        } else {
+            SetCtrl(index, kDeleted);
+        }
+    }
+
+    void Destroy() {
+        if (capacity_ == 0) {
+            return;
+        }
+        clear();
+        delete[] ctrl_;
+        ::operator delete(slots_, std::align_val_t(alignof(slot_type)));
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        growthLeft_ = 0;
+    }
+
+    Ctrl *ctrl_ = nullptr;
+    slot_type *slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t growthLeft_ = 0;
+};
+
+template<typename Key, typename Value>
+struct MapPolicy {
+    using key_type = Key;
+    using slot_type = std::pair<const Key, Value>;
+    using value_type = std::pair<const Key, Value>;
+    static constexpr bool kIsConstIterator = false;
+    static const Key &GetKey(const slot_type &slot) { return slot.first; }
+};
+
+template<typename Key>
+struct SetPolicy {
+    using key_type = Key;
+    using slot_type = Key;
+    using value_type = Key;
+    static constexpr bool kIsConstIterator = true;
+    static const Key &GetKey(const slot_type &slot) { return slot; }
+};
+
+} // namespace FlatHashDetail
+
+/// @brief 要素を連続したメモリに直接持つハッシュマップ。
+/// 追加や再ハッシュで要素の位置が変わるので、参照を保持し続ける場合は値を std::unique_ptr にすること
+template<typename Key, typename Value, typename Hash = FlatHash<Key>, typename Eq = std::equal_to<>>
+class FlatHashMap : public FlatHashDetail::Table<FlatHashDetail::MapPolicy<Key, Value>, Hash, Eq> {
+    using Base = FlatHashDetail::Table<FlatHashDetail::MapPolicy<Key, Value>, Hash, Eq>;
+    template<typename K, typename H>
+    using TransparentKey = typename Base::template TransparentKey<K, H>;
+
+public:
+    using mapped_type = Value;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::value_type;
+
+    FlatHashMap() = default;
+    FlatHashMap(std::initializer_list<value_type> values) {
+        this->reserve(values.size());
+        for (const auto &value : values) {
+            insert(value);
+        }
+    }
+
+    Value &operator[](const Key &key) {
+        return try_emplace(key).first->second;
+    }
+    Value &operator[](Key &&key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    Value &operator[](const K &key) {
+        const size_t index = this->FindIndex(key);
+        if (index != this->capacity()) {
+            return this->SlotAt(index)->second;
+        }
+        return try_emplace(Key(key)).first->second;
+    }
+
+    Value &at(const Key &key) {
+        return AtIndex(this->FindIndex(key));
+    }
+    const Value &at(const Key &key) const {
+        return const_cast<FlatHashMap *>(this)->AtIndex(this->FindIndex(key));
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    Value &at(const K &key) {
+        return AtIndex(this->FindIndex(key));
+    }
+    template<typename K, typename H = Hash, typename = TransparentKey<K, H>>
+    const Value &at(const K &key) const {
+        return const_cast<FlatHashMap *>(this)->AtIndex(this->FindIndex(key));
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+        auto [index, isInserted] = this->EmplaceUnique(key,
+            std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        return { iterator(this, index), isInserted };
+    }
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+        auto [index, isInserted] = this->EmplaceUnique(key,
+            std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        return { iterator(this, index), isInserted };
+    }
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type value(std::forward<Args>(args)...);
+        return insert(std::move(value));
+    }
+    std::pair<iterator, bool> insert(const value_type &value) {
+        auto [index, isInserted] = this->EmplaceUnique(value.first, value);
+        return { iterator(this, index), isInserted };
+    }
+    std::pair<iterator, bool> insert(value_type &&value) {
+        auto [index, isInserted] = this->EmplaceUnique(value.first, std::move(value));
+        return { iterator(this, index), isInserted };
+    }
+    template<typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key &key, V &&value) {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+private:
+    Value &AtIndex(size_t index) {
+        if (index == this->capacity()) {
+            throw std::out_of_range("Key not found");
+        }
+        return this->SlotAt(index)->second;
+    }
+};
+
+/// @brief 要素を連続したメモリに直接持つハッシュセット
+template<typename Key, typename Hash = FlatHash<Key>, typename Eq = std::equal_to<>>
+class FlatHashSet : public FlatHashDetail::Table<FlatHashDetail::SetPolicy<Key>, Hash, Eq> {
+    using Base = FlatHashDetail::Table<FlatHashDetail::SetPolicy<Key>, Hash, Eq>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    FlatHashSet() = default;
+    FlatHashSet(std::initializer_list<Key> values) {
+        this->reserve(values.size());
+        for (const auto &value : values) {
+            insert(value);
+        }
+    }
+
+    std::pair<const_iterator, bool> insert(const Key &key) {
+        auto [index, isInserted] = this->EmplaceUnique(key, key);
+        return { const_iterator(this, index), isInserted };
+    }
+    std::pair<const_iterator, bool> insert(Key &&key) {
+        auto [index, isInserted] = this->EmplaceUnique(key, std::move(key));
+        return { const_iterator(this, index), isInserted };
+    }
+    template<typename... Args>
+    std::pair<const_iterator, bool> emplace(Args &&...args) {
+        return insert(Key(std::forward<Args>(args)...));
+    }
+};
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+namespace MyStd {
+
+/// @brief フレーム開始時刻を一定間隔に揃えるためのクラス。
+/// 待ち時間の大半は眠り、寝過ごしに備えた残りの僅かな時間だけ空回りで待つ
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// @brief 指定時間眠る関数。環境ごとにより精度の高いタイマーへ差し替えられる
+    using SleepFunction = std::function<void(Clock::duration)>;
+    /// @brief 現在時刻を返す関数。テストで時刻の進み方を決められるよう差し替えられる
+    using NowFunction = std::function<Clock::time_point()>;
+
+    /// @brief フレーム間隔のずれ(実際の開始時刻 - 予定時刻)の統計。単位はミリ秒
+    struct Stats {
+        size_t sampleCount = 0;
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        /// @brief 現在の空回りで待つ時間
+        double spinMargin = 0.0;
+    };
+
+    FramePacer() :
+        sleepFunction_([](Clock::duration duration) { std::this_thread::sleep_for(duration); }),
+        nowFunction_([]() { return Clock::now(); }) {}
+
+    /// @brief 目標のフレームレートを設定する
+    /// @param frameRate フレームレート。0以下なら待たない
+    void SetFrameRate(double frameRate) {
+        if (frameRate <= 0.0) {
+            interval_ = Clock::duration::zero();
+        } else {
+            interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+        }
+    }
+    /// @brief 眠る関数を差し替える
+    void SetSleepFunction(SleepFunction sleepFunction) { sleepFunction_ = std::move(sleepFunction); }
+    /// @brief 現在時刻を返す関数を差し替える。空回りの待ちもこの時刻で判定する
+    void SetNowFunction(NowFunction nowFunction) { nowFunction_ = std::move(nowFunction); }
+
+    /// @brief 次のフレームの開始予定時刻まで待つ
+    /// @return 前のフレームの開始からの経過時間(秒)
+    double WaitForNextFrame() {
+        const auto now = nowFunction_();
+        if (!hasStarted_) {
+            hasStarted_ = true;
+            frameStart_ = now;
+            return 0.0;
+        }
+
+        auto target = frameStart_ + interval_;
+        if (now >= target) {
+            // 予定を過ぎていれば待たない。1フレーム以上遅れたら予定を今に合わせ直す
+            if (now - target >= interval_) {
+                target = now;
+            }
+        } else {
+            WaitUntil(target);
+        }
+
+        const auto frameStart = nowFunction_();
+        const auto jitter = frameStart - target;
+        // 予定時刻を基準にすることで誤差が積み重ならないようにする
+        const auto elapsed = frameStart - frameStart_;
+        frameStart_ = target;
+        RecordJitter(jitter);
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+    /// @brief 直近のフレームのずれの統計を取得
+    Stats GetStats() const {
+        Stats stats;
+        stats.sampleCount = std::min(jitterCount_, kJitterHistorySize);
+        stats.spinMargin = ToMilliseconds(spinMargin_);
+        if (stats.sampleCount == 0) {
+            return stats;
+        }
+        std::vector<double> samples(jitterHistory_.begin(), jitterHistory_.begin() + stats.sampleCount);
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        auto percentile = [&](double rate) {
+            size_t index = static_cast<size_t>(rate * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[index];
+        };
+        stats.average = sum / static_cast<double>(samples.size());
+        stats.p50 = percentile(0.50);
+        stats.p95 = percentile(0.95);
+        stats.p99 = percentile(0.99);
+        stats.max = samples.back();
+        return stats;
+    }
+
+    /// @brief 計測をやり直す(フレームレート変更時など)
+    void Reset() {
+        hasStarted_ = false;
+        jitterCount_ = 0;
+    }
+
+private:
+    static constexpr size_t kJitterHistorySize = 256;
+    // 空回りで待つ時間の下限と上限
+    static constexpr Clock::duration kMinSpinMargin = std::chrono::microseconds(200);
+    static constexpr Clock::duration kMaxSpinMargin = std::chrono::milliseconds(4);
+    // 寝過ごし時間の平均と分散の更新率
+    static constexpr double kOversleepSmoothing = 0.1;
+
+    void WaitUntil(Clock::time_point target) {
+        auto now = nowFunction_();
+        const auto sleepDuration = target - now - spinMargin_;
+        if (sleepDuration > Clock::duration::zero()) {
+            sleepFunction_(sleepDuration);
+            const auto woke = nowFunction_();
+            UpdateSpinMargin(woke - (now + sleepDuration));
+        }
+        // 残りは空回りで待つ
+        while (nowFunction_() < target) {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief 寝過ごした時間の平均と標準偏差から、次回から空回りで待つ時間を決める
+    void UpdateSpinMargin(Clock::duration oversleep) {
+        const double value = std::max(ToMilliseconds(oversleep), 0.0);
+        const double difference = value - oversleepAverage_;
+        oversleepAverage_ += kOversleepSmoothing * difference;
+        oversleepVariance_ = (1.0 - kOversleepSmoothing) * (oversleepVariance_ + kOversleepSmoothing * difference * difference);
+        const double margin = oversleepAverage_ + 3.0 * std::sqrt(oversleepVariance_);
+        spinMargin_ = std::clamp(
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(margin)),
+            kMinSpinMargin, kMaxSpinMargin);
+    }
+
+    void RecordJitter(Clock::duration jitter) {
+        jitterHistory_[jitterCount_ % kJitterHistorySize] = ToMilliseconds(jitter);
+        ++jitterCount_;
+    }
+
+    static double ToMilliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    SleepFunction sleepFunction_;
+    NowFunction nowFunction_;
+    Clock::duration interval_ = Clock::duration::zero();
+    Clock::duration spinMargin_ = std::chrono::milliseconds(1);
+    Clock::time_point frameStart_;
+    bool hasStarted_ = false;
+    double oversleepAverage_ = 0.0;
+    double oversleepVariance_ = 0.0;
+    std::array<double, kJitterHistorySize> jitterHistory_{};
+    size_t jitterCount_ = 0;
+};
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace MyStd {
+
+/// @brief 直近のフレーム時間の統計と、急に重くなったフレーム(ヒッチ)の検出
+class FrameTimeStats {
+public:
+    /// @brief 統計の要約。時間の単位はミリ秒
+    struct Summary {
+        size_t sampleCount = 0;
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        /// @brief これまでに検出したヒッチの数
+        uint64_t hitchCount = 0;
+    };
+
+    /// @param historySize 統計に使うフレーム数
+    explicit FrameTimeStats(size_t historySize = 240) : history_(std::max<size_t>(historySize, 1), 0.0) {}
+
+    /// @brief ヒッチとみなす条件の設定
+    /// @param medianMultiplier 中央値の何倍を超えたらヒッチとするか
+    /// @param minimumMilliseconds これより短いフレームはヒッチとしない
+    void SetHitchThreshold(double medianMultiplier, double minimumMilliseconds) {
+        medianMultiplier_ = medianMultiplier;
+        minimumMilliseconds_ = minimumMilliseconds;
+    }
+    /// @brief 検出を始めるまでのフレーム数(起動直後の不安定な時間を除く)
+    void SetWarmupFrames(size_t frames) { warmupFrames_ = frames; }
+    /// @brief ヒッチを検出してから次に検出するまでに空けるフレーム数
+    void SetCooldownFrames(size_t frames) { cooldownFrames_ = frames; }
+
+    /// @brief フレーム時間を追加する
+    /// @param milliseconds フレーム時間(ミリ秒)
+    /// @return このフレームがヒッチかどうか
+    bool AddFrame(double milliseconds) {
+        // 判定には今回のフレームを含めない中央値を使う
+        const size_t count = GetSampleCount();
+        median_ = count > 0 ? ComputeMedian(count) : milliseconds;
+
+        bool isHitch = false;
+        if (frameCount_ >= warmupFrames_ && (!hasHitch_ || framesSinceHitch_ >= cooldownFrames_)) {
+            isHitch = milliseconds >= minimumMilliseconds_ && milliseconds > median_ * medianMultiplier_;
+        }
+        if (isHitch) {
+            ++hitchCount_;
+            hasHitch_ = true;
+            framesSinceHitch_ = 0;
+        } else {
+            ++framesSinceHitch_;
+        }
+
+        history_[frameCount_ % history_.size()] = milliseconds;
+        ++frameCount_;
+        return isHitch;
+    }
+
+    /// @brief 直前に追加したフレームの判定に使った中央値
+    double GetMedian() const { return median_; }
+    /// @brief ヒッチとみなすフレーム時間の閾値(次のフレーム用の近似値)
+    double GetHitchThreshold() const { return std::max(median_ * medianMultiplier_, minimumMilliseconds_); }
+    /// @brief これまでに追加したフレーム数
+    uint64_t GetFrameCount() const { return frameCount_; }
+
+    /// @brief 統計の要約を取得
+    Summary GetSummary() const {
+        Summary summary;
+        summary.sampleCount = GetSampleCount();
+        summary.hitchCount = hitchCount_;
+        if (summary.sampleCount == 0) {
+            return summary;
+        }
+        std::vector<double> samples(history_.begin(), history_.begin() + summary.sampleCount);
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        auto percentile = [&](double rate) {
+            return samples[static_cast<size_t>(rate * static_cast<double>(samples.size() - 1) + 0.5)];
+        };
+        summary.average = sum / static_cast<double>(samples.size());
+        summary.p50 = percentile(0.50);
+        summary.p95 = percentile(0.95);
+        summary.p99 = percentile(0.99);
+        summary.max = samples.back();
+        return summary;
+    }
+
+    /// @brief 統計を捨てる
+    void Reset() {
+        frameCount_ = 0;
+        hasHitch_ = false;
+        framesSinceHitch_ = 0;
+        hitchCount_ = 0;
+        median_ = 0.0;
+    }
+
+private:
+    size_t GetSampleCount() const {
+        return static_cast<size_t>(std::min<uint64_t>(frameCount_, history_.size()));
+    }
+
+    double ComputeMedian(size_t count) const {
+        scratch_.assign(history_.begin(), history_.begin() + count);
+        auto middle = scratch_.begin() + count / 2;
+        std::nth_element(scratch_.begin(), middle, scratch_.end());
+        return *middle;
+    }
+
+    std::vector<double> history_;
+    mutable std::vector<double> scratch_;
+    uint64_t frameCount_ = 0;
+    // 最後のヒッチからのフレーム数。まだヒッチが無ければ使わない
+    uint64_t framesSinceHitch_ = 0;
+    bool hasHitch_ = false;
+    uint64_t hitchCount_ = 0;
+    double median_ = 0.0;
+    double medianMultiplier_ = 3.0;
+    double minimumMilliseconds_ = 8.0;
+    size_t warmupFrames_ = 60;
+    size_t cooldownFrames_ = 60;
+};
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,342 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <vector>
+
+namespace MyStd {
+
+/// @brief 1フレーム分のコントローラーの状態
+struct PadSnapshot {
+    bool isConnected = false;
+    uint16_t buttons = 0;
+    uint8_t leftTrigger = 0;
+    uint8_t rightTrigger = 0;
+    int16_t thumbLX = 0;
+    int16_t thumbLY = 0;
+    int16_t thumbRX = 0;
+    int16_t thumbRY = 0;
+
+    bool operator==(const PadSnapshot &) const = default;
+};
+
+/// @brief 1フレーム分の入力とフレーム時間
+struct InputSnapshot {
+    /// @brief フレーム時間(秒)
+    float deltaTime = 0.0f;
+    /// @brief キーごとの状態
+    std::array<uint8_t, 256> keys{};
+    /// @brief カーソルの座標
+    int32_t mouseX = 0;
+    int32_t mouseY = 0;
+    /// @brief マウスの移動量とホイールの回転量
+    int32_t mouseDeltaX = 0;
+    int32_t mouseDeltaY = 0;
+    int32_t mouseWheel = 0;
+    /// @brief マウスボタンごとの状態
+    std::array<uint8_t, 4> mouseButtons{};
+    /// @brief コントローラーごとの状態
+    std::array<PadSnapshot, 4> pads{};
+
+    bool operator==(const InputSnapshot &) const = default;
+};
+
+/// @brief フレームごとの入力の記録。
+/// 各フレームは前のフレームとの差分(変化したバイトだけ)で保存するので、入力が変わらないフレームは数バイトで済む。
+/// バイト列はエンディアンを固定しているので、記録した環境と違う環境でも同じ値に戻せる。
+/// 再生で同じ結果にするため、記録開始時の乱数のシード値もヘッダに保存する
+class InputRecording {
+public:
+    /// @brief 1フレームを固定長のバイト列にしたときのサイズ
+    static constexpr size_t kSnapshotSize = 4 + 256 + 4 * 5 + 4 + 4 * 13;
+
+    /// @brief フレームを追加する
+    void AddFrame(const InputSnapshot &snapshot) { frames_.push_back(snapshot); }
+    /// @brief フレームの取得
+    const InputSnapshot &GetFrame(size_t index) const { return frames_[index]; }
+    /// @brief フレーム数の取得
+    size_t GetFrameCount() const { return frames_.size(); }
+    /// @brief 全てのフレームとシード値を捨てる
+    void Clear() {
+        frames_.clear();
+        seed_ = 0;
+        hasSeed_ = false;
+    }
+
+    /// @brief 記録開始時の乱数のシード値の設定
+    void SetSeed(uint32_t seed) {
+        seed_ = seed;
+        hasSeed_ = true;
+    }
+    /// @brief 記録開始時の乱数のシード値の取得
+    uint32_t GetSeed() const { return seed_; }
+    /// @brief シード値が記録されているかどうか(シード値を保存する前の形式では記録されていない)
+    bool HasSeed() const { return hasSeed_; }
+
+    /// @brief バイト列に変換する
+    std::vector<uint8_t> Serialize() const {
+        std::vector<uint8_t> bytes;
+        WriteBytes(bytes, kMagic, sizeof(kMagic));
+        WriteUint(bytes, kVersion, 2);
+        WriteUint(bytes, kSnapshotSize, 2);
+        WriteUint(bytes, frames_.size(), 4);
+        WriteUint(bytes, hasSeed_ ? 1 : 0, 1);
+        WriteUint(bytes, seed_, 4);
+
+        std::array<uint8_t, kSnapshotSize> previous{};
+        std::array<uint8_t, kSnapshotSize> current{};
+        std::array<uint8_t, kSnapshotSize> difference{};
+        for (const auto &frame : frames_) {
+            Pack(frame, current);
+            for (size_t i = 0; i < kSnapshotSize; ++i) {
+                difference[i] = current[i] ^ previous[i];
+            }
+            EncodeDifference(bytes, difference);
+            previous = current;
+        }
+        return bytes;
+    }
+
+    /// @brief バイト列から復元する
+    /// @return 正しい形式だったかどうか。失敗した場合は空になる
+    bool Deserialize(const uint8_t *data, size_t size) {
+        Clear();
+        size_t position = 0;
+        uint64_t version = 0;
+        uint64_t snapshotSize = 0;
+        uint64_t frameCount = 0;
+        if (size < sizeof(kMagic) || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+            return false;
+        }
+        position += sizeof(kMagic);
+        if (!ReadUint(data, size, position, 2, version) || version < kMinVersion || version > kVersion ||
+            !ReadUint(data, size, position, 2, snapshotSize) || snapshotSize != kSnapshotSize ||
+            !ReadUint(data, size, position, 4, frameCount)) {
+            return false;
+        }
+        // バージョン1にはシード値が無い
+        if (version >= 2) {
+            uint64_t hasSeed = 0;
+            uint64_t seed = 0;
+            if (!ReadUint(data, size, position, 1, hasSeed) || hasSeed > 1 ||
+                !ReadUint(data, size, position, 4, seed)) {
+                return false;
+            }
+            seed_ = static_cast<uint32_t>(seed);
+            hasSeed_ = hasSeed != 0;
+        }
+        // 1フレームは最低2バイトなので、それより多いフレーム数は壊れている
+        if (frameCount > (size - position) / 2) {
+            return false;
+        }
+
+        frames_.reserve(static_cast<size_t>(frameCount));
+        std::array<uint8_t, kSnapshotSize> current{};
+        for (uint64_t frame = 0; frame < frameCount; ++frame) {
+            if (!DecodeDifference(data, size, position, current)) {
+                Clear();
+                return false;
+            }
+            frames_.push_back(Unpack(current));
+        }
+        if (position != size) {
+            Clear();
+            return false;
+        }
+        return true;
+    }
+    bool Deserialize(const std::vector<uint8_t> &bytes) { return Deserialize(bytes.data(), bytes.size()); }
+
+private:
+    static constexpr uint8_t kMagic[4] = { 'K', 'I', 'R', 'C' };
+    static constexpr uint64_t kVersion = 2;
+    // 読み込める最も古いバージョン
+    static constexpr uint64_t kMinVersion = 1;
+    // これより短い変化なしの区間は、区切るより変化ありの区間に含めた方が小さくなる
+    static constexpr size_t kMinSkipLength = 3;
+
+    //--------- 固定長のバイト列との変換 ---------//
+
+    static void Pack(const InputSnapshot &snapshot, std::array<uint8_t, kSnapshotSize> &bytes) {
+        size_t position = 0;
+        uint32_t deltaTimeBits = 0;
+        static_assert(sizeof(deltaTimeBits) == sizeof(snapshot.deltaTime));
+        std::memcpy(&deltaTimeBits, &snapshot.deltaTime, sizeof(deltaTimeBits));
+        PackUint(bytes, position, deltaTimeBits, 4);
+        for (uint8_t key : snapshot.keys) {
+            PackUint(bytes, position, key, 1);
+        }
+        PackUint(bytes, position, static_cast<uint32_t>(snapshot.mouseX), 4);
+        PackUint(bytes, position, static_cast<uint32_t>(snapshot.mouseY), 4);
+        PackUint(bytes, position, static_cast<uint32_t>(snapshot.mouseDeltaX), 4);
+        PackUint(bytes, position, static_cast<uint32_t>(snapshot.mouseDeltaY), 4);
+        PackUint(bytes, position, static_cast<uint32_t>(snapshot.mouseWheel), 4);
+        for (uint8_t button : snapshot.mouseButtons) {
+            PackUint(bytes, position, button, 1);
+        }
+        for (const auto &pad : snapshot.pads) {
+            PackUint(bytes, position, pad.isConnected ? 1 : 0, 1);
+            PackUint(bytes, position, pad.buttons, 2);
+            PackUint(bytes, position, pad.leftTrigger, 1);
+            PackUint(bytes, position, pad.rightTrigger, 1);
+            PackUint(bytes, position, static_cast<uint16_t>(pad.thumbLX), 2);
+            PackUint(bytes, position, static_cast<uint16_t>(pad.thumbLY), 2);
+            PackUint(bytes, position, static_cast<uint16_t>(pad.thumbRX), 2);
+            PackUint(bytes, position, static_cast<uint16_t>(pad.thumbRY), 2);
+        }
+    }
+
+    static InputSnapshot Unpack(const std::array<uint8_t, kSnapshotSize> &bytes) {
+        InputSnapshot snapshot;
+        size_t position = 0;
+        const uint32_t deltaTimeBits = static_cast<uint32_t>(UnpackUint(bytes, position, 4));
+        std::memcpy(&snapshot.deltaTime, &deltaTimeBits, sizeof(deltaTimeBits));
+        for (uint8_t &key : snapshot.keys) {
+            key = static_cast<uint8_t>(UnpackUint(bytes, position, 1));
+        }
+        snapshot.mouseX = static_cast<int32_t>(static_cast<uint32_t>(UnpackUint(bytes, position, 4)));
+        snapshot.mouseY = static_cast<int32_t>(static_cast<uint32_t>(UnpackUint(bytes, position, 4)));
+        snapshot.mouseDeltaX = static_cast<int32_t>(static_cast<uint32_t>(UnpackUint(bytes, position, 4)));
+        snapshot.mouseDeltaY = static_cast<int32_t>(static_cast<uint32_t>(UnpackUint(bytes, position, 4)));
+        snapshot.mouseWheel = static_cast<int32_t>(static_cast<uint32_t>(UnpackUint(bytes, position, 4)));
+        for (uint8_t &button : snapshot.mouseButtons) {
+            button = static_cast<uint8_t>(UnpackUint(bytes, position, 1));
+        }
+        for (auto &pad : snapshot.pads) {
+            pad.isConnected = UnpackUint(bytes, position, 1) != 0;
+            pad.buttons = static_cast<uint16_t>(UnpackUint(bytes, position, 2));
+            pad.leftTrigger = static_cast<uint8_t>(UnpackUint(bytes, position, 1));
+            pad.rightTrigger = static_cast<uint8_t>(UnpackUint(bytes, position, 1));
+            pad.thumbLX = static_cast<int16_t>(static_cast<uint16_t>(UnpackUint(bytes, position, 2)));
+            pad.thumbLY = static_cast<int16_t>(static_cast<uint16_t>(UnpackUint(bytes, position, 2)));
+            pad.thumbRX = static_cast<int16_t>(static_cast<uint16_t>(UnpackUint(bytes, position, 2)));
+            pad.thumbRY = static_cast<int16_t>(static_cast<uint16_t>(UnpackUint(bytes, position, 2)));
+        }
+        return snapshot;
+    }
+
+    static void PackUint(std::array<uint8_t, kSnapshotSize> &bytes, size_t &position, uint64_t value, size_t byteCount) {
+        for (size_t i = 0; i < byteCount; ++i) {
+            bytes[position++] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    static uint64_t UnpackUint(const std::array<uint8_t, kSnapshotSize> &bytes, size_t &position, size_t byteCount) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < byteCount; ++i) {
+            value |= static_cast<uint64_t>(bytes[position++]) << (8 * i);
+        }
+        return value;
+    }
+
+    //--------- 差分の符号化 ---------//
+
+    /// @brief 差分を「変化なしのバイト数」「変化ありのバイト数」「変化ありのバイト列」の繰り返しで書き込む
+    static void EncodeDifference(std::vector<uint8_t> &bytes, const std::array<uint8_t, kSnapshotSize> &difference) {
+        size_t position = 0;
+        while (position < kSnapshotSize) {
+            size_t skipEnd = position;
+            while (skipEnd < kSnapshotSize && difference[skipEnd] == 0) {
+                ++skipEnd;
+            }
+            // 短い変化なしの区間を挟んでも続く限り、変化ありの区間を伸ばす
+            size_t literalEnd = skipEnd;
+            while (literalEnd < kSnapshotSize) {
+                size_t zeroEnd = literalEnd;
+                while (zeroEnd < kSnapshotSize && difference[zeroEnd] == 0) {
+                    ++zeroEnd;
+                }
+                if (zeroEnd == kSnapshotSize || (zeroEnd - literalEnd >= kMinSkipLength)) {
+                    break;
+                }
+                literalEnd = zeroEnd;
+                while (literalEnd < kSnapshotSize && difference[literalEnd] != 0) {
+                    ++literalEnd;
+                }
+            }
+            WriteVarint(bytes, skipEnd - position);
+            WriteVarint(bytes, literalEnd - skipEnd);
+            WriteBytes(bytes, difference.data() + skipEnd, literalEnd - skipEnd);
+            position = literalEnd;
+        }
+    }
+
+    /// @brief 差分を読み、前のフレームに適用する
+    static bool DecodeDifference(const uint8_t *data, size_t size, size_t &position, std::array<uint8_t, kSnapshotSize> &snapshot) {
+        size_t snapshotPosition = 0;
+        while (snapshotPosition < kSnapshotSize) {
+            uint64_t skipLength = 0;
+            uint64_t literalLength = 0;
+            if (!ReadVarint(data, size, position, skipLength) || !ReadVarint(data, size, position, literalLength)) {
+                return false;
+            }
+            if (skipLength > kSnapshotSize - snapshotPosition ||
+                literalLength > kSnapshotSize - snapshotPosition - skipLength ||
+                literalLength > size - position) {
+                return false;
+            }
+            // 何も進まない区間は正しい記録には現れない(無限ループ防止)
+            if (skipLength + literalLength == 0) {
+                return false;
+            }
+            snapshotPosition += static_cast<size_t>(skipLength);
+            for (uint64_t i = 0; i < literalLength; ++i) {
+                snapshot[snapshotPosition++] ^= data[position++];
+            }
+        }
+        return true;
+    }
+
+    //--------- 可変長整数 ---------//
+
+    static void WriteVarint(std::vector<uint8_t> &bytes, uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    static bool ReadVarint(const uint8_t *data, size_t size, size_t &position, uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= size) {
+                return false;
+            }
+            const uint8_t byte = data[position++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void WriteUint(std::vector<uint8_t> &bytes, uint64_t value, size_t byteCount) {
+        for (size_t i = 0; i < byteCount; ++i) {
+            bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    static bool ReadUint(const uint8_t *data, size_t size, size_t &position, size_t byteCount, uint64_t &value) {
+        if (byteCount > size - position) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < byteCount; ++i) {
+            value |= static_cast<uint64_t>(data[position++]) << (8 * i);
+        }
+        return true;
+    }
+
+    static void WriteBytes(std::vector<uint8_t> &bytes, const uint8_t *data, size_t size) {
+        bytes.insert(bytes.end(), data, data + size);
+    }
+
+    std::vector<InputSnapshot> frames_;
+    uint32_t seed_ = 0;
+    bool hasSeed_ = false;
+};
+
+} // namespace MyStd
\ No newline at end of file
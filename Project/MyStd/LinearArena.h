@@ -0,0 +1,281 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <cassert>
+
+namespace MyStd {
+
+/// @brief 先頭から順に切り出すだけの線形アロケータ。
+/// 個別の解放はできず、Reset か Rewind でまとめて戻す
+class LinearArena {
+public:
+    // デバッグ時に確保した領域を埋める値
+    static constexpr uint8_t kAllocatedPattern = 0xCD;
+    // デバッグ時に解放した領域を埋める値
+    static constexpr uint8_t kFreedPattern = 0xDD;
+
+    LinearArena() = default;
+    explicit LinearArena(size_t capacity) {
+        Initialize(capacity);
+    }
+    ~LinearArena() {
+        ReleaseOverflow();
+    }
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+    /// @brief バッファの確保
+    /// @param capacity 容量(バイト)
+    void Initialize(size_t capacity) {
+        ReleaseOverflow();
+        buffer_ = std::make_unique<std::byte[]>(capacity);
+        capacity_ = capacity;
+        offset_ = 0;
+        highWater_ = 0;
+    }
+
+    /// @brief メモリの確保。容量が足りない場合はヒープから確保し、Reset で解放する
+    /// @param size サイズ(バイト)
+    /// @param alignment アライメント
+    /// @return 確保したメモリ
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        const size_t alignedOffset = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (buffer_ == nullptr || alignedOffset + size > capacity_) {
+            // 容量を超えた分はヒープから確保する
+            ++overflowCount_;
+            overflowBytes_ += size;
+            void *memory = ::operator new(size, std::align_val_t(alignment));
+            overflowBlocks_.push_back({ memory, alignment });
+            return memory;
+        }
+        void *memory = buffer_.get() + alignedOffset;
+        offset_ = alignedOffset + size;
+        if (offset_ > highWater_) {
+            highWater_ = offset_;
+        }
+        ++allocationCount_;
+#ifdef DEBUG_BUILD
+        std::memset(memory, kAllocatedPattern, size);
+#endif
+        return memory;
+    }
+
+    /// @brief 型を指定したメモリの確保(コンストラクタは呼ばれない)
+    template<typename T>
+    T *Allocate(size_t count = 1) {
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @brief 全て解放する
+    void Reset() {
+        Rewind(0);
+        ReleaseOverflow();
+        allocationCount_ = 0;
+    }
+
+    /// @brief 指定位置まで巻き戻す
+    /// @param marker GetMarker で取得した位置
+    void Rewind(size_t marker) {
+        assert(marker <= offset_);
+#ifdef DEBUG_BUILD
+        if (buffer_ != nullptr) {
+            std::memset(buffer_.get() + marker, kFreedPattern, offset_ - marker);
+        }
+#endif
+        offset_ = marker;
+    }
+
+    /// @brief 指定位置まで巻き戻し、それ以降にヒープから確保した分も解放する
+    /// @param marker GetMarker で取得した位置
+    /// @param overflowMarker GetOverflowMarker で取得した位置
+    void Rewind(size_t marker, size_t overflowMarker) {
+        Rewind(marker);
+        ReleaseOverflow(overflowMarker);
+    }
+
+    /// @brief 現在位置の取得
+    size_t GetMarker() const { return offset_; }
+    /// @brief ヒープから確保した分の現在位置の取得
+    size_t GetOverflowMarker() const { return overflowBlocks_.size(); }
+    /// @brief 使用中のサイズの取得
+    size_t GetUsed() const { return offset_; }
+    /// @brief 容量の取得
+    size_t GetCapacity() const { return capacity_; }
+    /// @brief これまでの最大使用量の取得
+    size_t GetHighWater() const { return highWater_; }
+    /// @brief 前回の Reset からの確保回数の取得
+    size_t GetAllocationCount() const { return allocationCount_; }
+    /// @brief 容量を超えてヒープから確保した回数の取得
+    size_t GetOverflowCount() const { return overflowCount_; }
+    /// @brief 容量を超えてヒープから確保したサイズの取得
+    size_t GetOverflowBytes() const { return overflowBytes_; }
+    /// @brief 統計情報のリセット
+    void ResetStats() {
+        highWater_ = offset_;
+        overflowCount_ = 0;
+        overflowBytes_ = 0;
+    }
+
+private:
+    struct OverflowBlock {
+        void *memory;
+        size_t alignment;
+    };
+
+    /// @brief ヒープから確保した分の解放
+    /// @param overflowMarker この位置より後に確保した分を解放する
+    void ReleaseOverflow(size_t overflowMarker = 0) {
+        assert(overflowMarker <= overflowBlocks_.size());
+        for (size_t i = overflowMarker; i < overflowBlocks_.size(); ++i) {
+            ::operator delete(overflowBlocks_[i].memory, std::align_val_t(overflowBlocks_[i].alignment));
+        }
+        overflowBlocks_.resize(overflowMarker);
+    }
+
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_ = 0;
+    size_t offset_ = 0;
+    size_t highWater_ = 0;
+    size_t allocationCount_ = 0;
+    size_t overflowCount_ = 0;
+    size_t overflowBytes_ = 0;
+    std::vector<OverflowBlock> overflowBlocks_;
+};
+
+/// @brief LinearArena を std::pmr のコンテナから使うためのアダプタ
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(LinearArena &arena) : arena_(&arena) {}
+
+    LinearArena &GetArena() const { return *arena_; }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        return arena_->Allocate(bytes, alignment);
+    }
+    void do_deallocate(void *, size_t, size_t) override {
+        // 個別の解放はしない
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        auto *resource = dynamic_cast<const ArenaResource *>(&other);
+        return resource != nullptr && resource->arena_ == arena_;
+    }
+
+    LinearArena *arena_;
+};
+
+/// @brief 2つのアリーナを交互に使うフレーム単位のアロケータ。
+/// 前のフレームで確保したメモリは次のフレームの終わりまで有効
+class FrameArena {
+public:
+    FrameArena() : resources_{ ArenaResource(arenas_[0]), ArenaResource(arenas_[1]) } {}
+    explicit FrameArena(size_t capacityPerFrame) : FrameArena() {
+        Initialize(capacityPerFrame);
+    }
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /// @brief バッファの確保
+    /// @param capacityPerFrame 1フレームあたりの容量(バイト)
+    void Initialize(size_t capacityPerFrame) {
+        arenas_[0].Initialize(capacityPerFrame);
+        arenas_[1].Initialize(capacityPerFrame);
+        current_ = 0;
+    }
+
+    /// @brief フレーム終了処理。使うアリーナを切り替えて、切り替え先を空にする
+    void EndFrame() {
+        current_ ^= 1;
+        arenas_[current_].Reset();
+    }
+
+    /// @brief メモリの確保
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        return arenas_[current_].Allocate(size, alignment);
+    }
+    template<typename T>
+    T *Allocate(size_t count = 1) {
+        return arenas_[current_].Allocate<T>(count);
+    }
+
+    /// @brief 現在のフレームのアリーナの取得
+    LinearArena &GetArena() { return arenas_[current_]; }
+    const LinearArena &GetArena() const { return arenas_[current_]; }
+    /// @brief 現在のフレームの std::pmr 用リソースの取得
+    std::pmr::memory_resource *GetResource() { return &resources_[current_]; }
+
+private:
+    LinearArena arenas_[2];
+    ArenaResource resources_[2];
+    uint32_t current_ = 0;
+};
+
+/// @brief スレッドごとの一時メモリ。ScratchScope を抜けると確保前の位置まで戻る
+class ScratchArena {
+public:
+    // スレッドごとの既定の容量
+    static constexpr size_t kDefaultCapacity = 256 * 1024;
+
+    /// @brief 現在のスレッドのアリーナの取得
+    static LinearArena &Get() {
+        thread_local LinearArena arena(kDefaultCapacity);
+        return arena;
+    }
+};
+
+/// @brief スコープを抜けると一時メモリを巻き戻すマーカー
+class ScratchScope {
+public:
+    ScratchScope() :
+        arena_(ScratchArena::Get()), marker_(arena_.GetMarker()), overflowMarker_(arena_.GetOverflowMarker()),
+        resource_(arena_) {}
+    ~ScratchScope() {
+        // 入れ子になっていても、このスコープの中で確保した分(ヒープに溢れた分も含む)だけを戻す
+        arena_.Rewind(marker_, overflowMarker_);
+    }
+    ScratchScope(const ScratchScope &) = delete;
+    ScratchScope &operator=(const ScratchScope &) = delete;
+
+    /// @brief メモリの確保
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        return arena_.Allocate(size, alignment);
+    }
+    template<typename T>
+    T *Allocate(size_t count = 1) {
+        return arena_.Allocate<T>(count);
+    }
+
+    /// @brief std::pmr 用リソースの取得
+    std::pmr::memory_resource *GetResource() { return &resource_; }
+
+private:
+    LinearArena &arena_;
+    size_t marker_;
+    size_t overflowMarker_;
+    ArenaResource resource_;
+};
+
+/// @brief std::pmr::vector を空にして、確保に使うリソースを切り替える。
+/// フレーム単位のアロケータで毎フレーム作り直す配列に使う。切り替える場合は元の容量を切り替え先で確保し直す
+/// @param vector 空にする配列
+/// @param resource 切り替え先のリソース
+template<typename T>
+void ResetPmrVector(std::pmr::vector<T> &vector, std::pmr::memory_resource *resource) {
+    if (vector.get_allocator().resource() == resource) {
+        vector.clear();
+        return;
+    }
+    const size_t capacity = vector.capacity();
+    // polymorphic_allocator は代入で伝播しないので、作り直してリソースを切り替える。
+    // 元の領域の解放は切り替え前のリソースに任せる(アリーナなら何もしない)
+    std::destroy_at(&vector);
+    std::construct_at(&vector, resource);
+    vector.reserve(capacity);
+}
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,326 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <stdexcept>
+#include <cassert>
+
+namespace MyStd {
+
+/// @brief SlotMap の要素を指すハンドル
+struct SlotHandle {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    /// @brief スロット番号
+    uint32_t index = kInvalidIndex;
+    /// @brief 世代。使用中のスロットは常に奇数
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != kInvalidIndex; }
+    bool operator==(const SlotHandle &other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle &other) const {
+        return !(*this == other);
+    }
+};
+
+/// @brief 世代付きハンドルで要素を管理するコンテナ。
+/// 追加と削除はO(1)で、値は詰めて保持されるので走査も速い
+template<typename T>
+class SlotMap {
+public:
+    SlotMap() = default;
+    ~SlotMap() = default;
+
+    /// @brief 値を追加する
+    /// @return 追加した値のハンドル
+    SlotHandle insert(const T &value) {
+        return emplace(value);
+    }
+    SlotHandle insert(T &&value) {
+        return emplace(std::move(value));
+    }
+    template<typename... Args>
+    SlotHandle emplace(Args &&...args) {
+        uint32_t slotIndex;
+        if (freeHead_ != SlotHandle::kInvalidIndex) {
+            // 空いているスロットを再利用
+            slotIndex = freeHead_;
+            freeHead_ = slots_[slotIndex].denseIndex;
+        } else {
+            slotIndex = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+        Slot &slot = slots_[slotIndex];
+        // 偶数(空き)から奇数(使用中)にする
+        ++slot.generation;
+        slot.denseIndex = static_cast<uint32_t>(values_.size());
+        values_.emplace_back(std::forward<Args>(args)...);
+        denseToSlot_.push_back(slotIndex);
+        return SlotHandle{ slotIndex, slot.generation };
+    }
+
+    /// @brief 値を削除する。削除済みのハンドルなら何もしない
+    /// @return 削除したかどうか
+    bool erase(const SlotHandle &handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        Slot &slot = slots_[handle.index];
+        const uint32_t denseIndex = slot.denseIndex;
+        const uint32_t lastIndex = static_cast<uint32_t>(values_.size()) - 1;
+        // 末尾の値を空いた位置に移して詰める
+        if (denseIndex != lastIndex) {
+            values_[denseIndex] = std::move(values_[lastIndex]);
+            denseToSlot_[denseIndex] = denseToSlot_[lastIndex];
+            slots_[denseToSlot_[denseIndex]].denseIndex = denseIndex;
+        }
+        values_.pop_back();
+        denseToSlot_.pop_back();
+        // 世代を進めて古いハンドルを無効にし、空きリストにつなぐ
+        ++slot.generation;
+        slot.denseIndex = freeHead_;
+        freeHead_ = handle.index;
+        return true;
+    }
+
+    /// @brief ハンドルが有効かどうか
+    bool contains(const SlotHandle &handle) const {
+        return handle.index < slots_.size() &&
+            (handle.generation & 1u) != 0 &&
+            slots_[handle.index].generation == handle.generation;
+    }
+
+    /// @brief 値の取得
+    /// @return 値へのポインタ。無効なハンドルならnullptr
+    T *get(const SlotHandle &handle) {
+        return contains(handle) ? &values_[slots_[handle.index].denseIndex] : nullptr;
+    }
+    const T *get(const SlotHandle &handle) const {
+        return contains(handle) ? &values_[slots_[handle.index].denseIndex] : nullptr;
+    }
+    T &at(const SlotHandle &handle) {
+        if (!contains(handle)) {
+            throw std::out_of_range("Invalid slot handle");
+        }
+        return values_[slots_[handle.index].denseIndex];
+    }
+    const T &at(const SlotHandle &handle) const {
+        if (!contains(handle)) {
+            throw std::out_of_range("Invalid slot handle");
+        }
+        return values_[slots_[handle.index].denseIndex];
+    }
+    T &operator[](const SlotHandle &handle) {
+        assert(contains(handle));
+        return values_[slots_[handle.index].denseIndex];
+    }
+    const T &operator[](const SlotHandle &handle) const {
+        assert(contains(handle));
+        return values_[slots_[handle.index].denseIndex];
+    }
+
+    /// @brief スロット番号から現在のハンドルを作る
+    /// @return ハンドル。空きスロットなら無効なハンドル
+    SlotHandle make_handle(uint32_t slotIndex) const {
+        if (slotIndex >= slots_.size() || (slots_[slotIndex].generation & 1u) == 0) {
+            return SlotHandle{};
+        }
+        return SlotHandle{ slotIndex, slots_[slotIndex].generation };
+    }
+
+    /// @brief 詰めて保持している位置からハンドルを取得
+    SlotHandle handle_at(size_t denseIndex) const {
+        const uint32_t slotIndex = denseToSlot_.at(denseIndex);
+        return SlotHandle{ slotIndex, slots_[slotIndex].generation };
+    }
+
+    size_t size() const {
+        return values_.size();
+    }
+    bool empty() const {
+        return values_.empty();
+    }
+    void reserve(size_t capacity) {
+        slots_.reserve(capacity);
+        values_.reserve(capacity);
+        denseToSlot_.reserve(capacity);
+    }
+    void clear() {
+        // 世代を残したまま全スロットを空きにする。番号の小さい順に再利用されるようにつなぐ
+        freeHead_ = SlotHandle::kInvalidIndex;
+        for (size_t i = slots_.size(); i > 0; --i) {
+            const uint32_t slotIndex = static_cast<uint32_t>(i - 1);
+            Slot &slot = slots_[slotIndex];
+            if ((slot.generation & 1u) != 0) {
+                ++slot.generation;
+            }
+            slot.denseIndex = freeHead_;
+            freeHead_ = slotIndex;
+        }
+        values_.clear();
+        denseToSlot_.clear();
+    }
+
+    auto begin() {
+        return values_.begin();
+    }
+    auto end() {
+        return values_.end();
+    }
+    auto begin() const {
+        return values_.begin();
+    }
+    auto end() const {
+        return values_.end();
+    }
+
+private:
+    struct Slot {
+        // 使用中なら値の位置、空きなら次の空きスロット番号
+        uint32_t denseIndex = SlotHandle::kInvalidIndex;
+        uint32_t generation = 0;
+    };
+
+    // スロット(ハンドルの参照先)
+    std::vector<Slot> slots_;
+    // 値の実体(詰めて保持)
+    std::vector<T> values_;
+    // 値の位置からスロット番号への変換表
+    std::vector<uint32_t> denseToSlot_;
+    // 空きスロットの先頭
+    uint32_t freeHead_ = SlotHandle::kInvalidIndex;
+};
+
+/// @brief キーからハンドルを引ける SlotMap。
+/// キーの検索は読み込み時だけにして、毎フレームの処理はハンドルで行う
+template<typename Key, typename T>
+class NamedSlotMap {
+public:
+    NamedSlotMap() = default;
+    ~NamedSlotMap() = default;
+
+    /// @brief キーと値を追加する。既に存在するキーなら値を上書きする
+    /// @return 値のハンドル
+    SlotHandle insert(const Key &key, const T &value) {
+        return insert(key, T(value));
+    }
+    SlotHandle insert(const Key &key, T &&value) {
+        auto it = keyToHandle_.find(key);
+        if (it != keyToHandle_.end()) {
+            slotMap_[it->second] = std::move(value);
+            return it->second;
+        }
+        const SlotHandle handle = slotMap_.insert(std::move(value));
+        keyToHandle_.emplace(key, handle);
+        if (slotKeys_.size() <= handle.index) {
+            slotKeys_.resize(handle.index + 1);
+        }
+        slotKeys_[handle.index] = key;
+        return handle;
+    }
+
+    /// @brief キーからハンドルを検索する
+    /// @return ハンドル。見つからなければ無効なハンドル
+    SlotHandle find(const Key &key) const {
+        auto it = keyToHandle_.find(key);
+        return it != keyToHandle_.end() ? it->second : SlotHandle{};
+    }
+
+    /// @brief ハンドルからキーを取得する
+    const Key &key_of(const SlotHandle &handle) const {
+        if (!slotMap_.contains(handle)) {
+            throw std::out_of_range("Invalid slot handle");
+        }
+        return slotKeys_[handle.index];
+    }
+
+    bool erase(const SlotHandle &handle) {
+        if (!slotMap_.contains(handle)) {
+            return false;
+        }
+        keyToHandle_.erase(slotKeys_[handle.index]);
+        slotKeys_[handle.index] = Key{};
+        return slotMap_.erase(handle);
+    }
+    bool erase(const Key &key) {
+        return erase(find(key));
+    }
+
+    bool contains(const SlotHandle &handle) const {
+        return slotMap_.contains(handle);
+    }
+    bool contains(const Key &key) const {
+        return keyToHandle_.find(key) != keyToHandle_.end();
+    }
+
+    T *get(const SlotHandle &handle) {
+        return slotMap_.get(handle);
+    }
+    const T *get(const SlotHandle &handle) const {
+        return slotMap_.get(handle);
+    }
+    T &at(const SlotHandle &handle) {
+        return slotMap_.at(handle);
+    }
+    const T &at(const SlotHandle &handle) const {
+        return slotMap_.at(handle);
+    }
+    T &at(const Key &key) {
+        return slotMap_.at(find(key));
+    }
+    T &operator[](const SlotHandle &handle) {
+        return slotMap_[handle];
+    }
+    const T &operator[](const SlotHandle &handle) const {
+        return slotMap_[handle];
+    }
+
+    SlotHandle make_handle(uint32_t slotIndex) const {
+        return slotMap_.make_handle(slotIndex);
+    }
+    SlotHandle handle_at(size_t denseIndex) const {
+        return slotMap_.handle_at(denseIndex);
+    }
+
+    size_t size() const {
+        return slotMap_.size();
+    }
+    bool empty() const {
+        return slotMap_.empty();
+    }
+    void reserve(size_t capacity) {
+        slotMap_.reserve(capacity);
+        keyToHandle_.reserve(capacity);
+    }
+    void clear() {
+        slotMap_.clear();
+        keyToHandle_.clear();
+        slotKeys_.clear();
+    }
+
+    auto begin() {
+        return slotMap_.begin();
+    }
+    auto end() {
+        return slotMap_.end();
+    }
+    auto begin() const {
+        return slotMap_.begin();
+    }
+    auto end() const {
+        return slotMap_.end();
+    }
+
+private:
+    // 値の実体
+    SlotMap<T> slotMap_;
+    // キーからハンドルへの変換表
+    std::unordered_map<Key, SlotHandle> keyToHandle_;
+    // スロット番号ごとのキー
+    std::vector<Key> slotKeys_;
+};
+
+} // namespace MyStd
\ No newline at end of file
@@ -0,0 +1,361 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <initializer_list>
+#include <exception>
+#include <stdexcept>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <utility>
+
+namespace MyStd {
+
+/// @brief 依存関係付きの処理をまとめて実行するグラフ。
+/// 依存が全て終わった処理から順に、呼び出し元スレッドとワーカースレッドで並行に実行する
+class TaskGraph {
+public:
+    /// @brief 処理を実行するスレッド
+    enum class TaskThread {
+        kAny,   // どのスレッドでも良い
+        kMain,  // Run を呼んだスレッドのみ
+    };
+
+    /// @brief 処理の状態
+    enum class TaskState {
+        kPending,   // 未実行
+        kSucceeded, // 成功
+        kFailed,    // 例外で失敗
+        kSkipped,   // 依存先が失敗したので実行しなかった
+    };
+
+    /// @brief 処理ごとの実行結果
+    struct TaskResult {
+        std::string name;
+        TaskThread thread = TaskThread::kAny;
+        TaskState state = TaskState::kPending;
+        /// @brief Run 開始からの開始時間(ミリ秒)
+        double beginMilliseconds = 0.0;
+        /// @brief 実行にかかった時間(ミリ秒)
+        double durationMilliseconds = 0.0;
+        /// @brief 失敗時のメッセージ
+        std::string error;
+    };
+
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+
+    /// @brief 処理を追加する。失敗は例外を投げることで伝える
+    /// @param name 処理名(重複不可)
+    /// @param thread 実行するスレッド
+    /// @param function 処理
+    /// @param dependencies 先に終わっている必要がある処理名。後から追加する処理名でも良い
+    void AddTask(std::string name, TaskThread thread, std::function<void()> function,
+        std::initializer_list<std::string> dependencies = {}) {
+        AddTask(std::move(name), thread, std::move(function), std::vector<std::string>(dependencies));
+    }
+    void AddTask(std::string name, TaskThread thread, std::function<void()> function,
+        std::vector<std::string> dependencies) {
+        if (taskIndices_.contains(name)) {
+            throw std::invalid_argument("TaskGraph: duplicate task name '" + name + "'");
+        }
+        taskIndices_.emplace(name, tasks_.size());
+        Task task;
+        task.result.name = std::move(name);
+        task.result.thread = thread;
+        task.function = std::move(function);
+        task.dependencyNames = std::move(dependencies);
+        tasks_.push_back(std::move(task));
+    }
+
+    /// @brief ワーカースレッドの開始時と終了時に呼ぶ処理を設定する(スレッドごとの初期化用)
+    void SetWorkerCallbacks(std::function<void()> onBegin, std::function<void()> onEnd) {
+        onWorkerBegin_ = std::move(onBegin);
+        onWorkerEnd_ = std::move(onEnd);
+    }
+
+    /// @brief 全ての処理を実行する。
+    /// 依存関係に循環や存在しない処理名がある場合は何も実行せずに失敗する
+    /// @param workerCount ワーカースレッド数。0なら全て呼び出し元スレッドで実行する
+    /// @return 全ての処理が成功したかどうか
+    bool Run(size_t workerCount) {
+        errorMessage_.clear();
+        if (!Resolve()) {
+            return false;
+        }
+
+        const size_t taskCount = tasks_.size();
+        workerCount_ = workerCount;
+        finishedCount_ = 0;
+        mainQueue_.clear();
+        workerQueue_.clear();
+        for (size_t i = 0; i < taskCount; ++i) {
+            Task &task = tasks_[i];
+            task.result.state = TaskState::kPending;
+            task.result.error.clear();
+            task.remainingDependencies = task.dependencies.size();
+            if (task.remainingDependencies == 0) {
+                GetQueue(task).push_back(i);
+            }
+        }
+        startTime_ = Clock::now();
+
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        // 呼び出し元スレッドはメインスレッド指定の処理を担当する
+        // (ワーカーが無い場合は全ての処理)
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [&]() {
+                    return !mainQueue_.empty() || finishedCount_ == taskCount;
+                });
+                if (mainQueue_.empty()) {
+                    break;
+                }
+                index = PopFront(mainQueue_);
+            }
+            Execute(index);
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        bool isSucceeded = true;
+        for (const auto &task : tasks_) {
+            if (task.result.state != TaskState::kSucceeded) {
+                isSucceeded = false;
+                if (task.result.state == TaskState::kFailed) {
+                    if (!errorMessage_.empty()) {
+                        errorMessage_ += '\n';
+                    }
+                    errorMessage_ += "'" + task.result.name + "' failed: " + task.result.error;
+                }
+            }
+        }
+        return isSucceeded;
+    }
+
+    /// @brief 実行結果の取得(追加した順)
+    std::vector<TaskResult> GetResults() const {
+        std::vector<TaskResult> results;
+        results.reserve(tasks_.size());
+        for (const auto &task : tasks_) {
+            results.push_back(task.result);
+        }
+        return results;
+    }
+
+    /// @brief 直前の Run にかかった時間(ミリ秒)
+    double GetTotalMilliseconds() const { return totalMilliseconds_; }
+    /// @brief 直前の Run が失敗した理由
+    const std::string &GetErrorMessage() const { return errorMessage_; }
+    /// @brief 処理数の取得
+    size_t size() const { return tasks_.size(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        TaskResult result;
+        std::function<void()> function;
+        std::vector<std::string> dependencyNames;
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+        size_t remainingDependencies = 0;
+    };
+
+    /// @brief 処理名を番号に解決し、循環がないか調べる
+    bool Resolve() {
+        for (auto &task : tasks_) {
+            task.dependencies.clear();
+            task.dependents.clear();
+        }
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            Task &task = tasks_[i];
+            for (const auto &dependencyName : task.dependencyNames) {
+                auto it = taskIndices_.find(dependencyName);
+                if (it == taskIndices_.end()) {
+                    errorMessage_ = "'" + task.result.name + "' depends on unknown task '" + dependencyName + "'";
+                    return false;
+                }
+                task.dependencies.push_back(it->second);
+                tasks_[it->second].dependents.push_back(i);
+            }
+        }
+
+        // Kahn 法で全ての処理を辿れなければ循環がある
+        std::vector<size_t> remaining(tasks_.size());
+        std::vector<size_t> ready;
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            remaining[i] = tasks_[i].dependencies.size();
+            if (remaining[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+        size_t visitedCount = 0;
+        while (!ready.empty()) {
+            size_t index = ready.back();
+            ready.pop_back();
+            ++visitedCount;
+            for (size_t dependent : tasks_[index].dependents) {
+                if (--remaining[dependent] == 0) {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        if (visitedCount != tasks_.size()) {
+            errorMessage_ = "dependency cycle: " + FindCycle(remaining);
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief 循環している処理名を "A -> B -> A" の形で返す
+    /// @param remaining Kahn 法で残った依存数(0でない処理は循環上かその先にある)
+    std::string FindCycle(const std::vector<size_t> &remaining) const {
+        // 残った処理から依存先を辿り続けると必ず循環に入る
+        size_t start = 0;
+        while (remaining[start] == 0) {
+            ++start;
+        }
+        std::vector<size_t> order(tasks_.size(), SIZE_MAX);
+        std::vector<size_t> path;
+        size_t current = start;
+        while (order[current] == SIZE_MAX) {
+            order[current] = path.size();
+            path.push_back(current);
+            for (size_t dependency : tasks_[current].dependencies) {
+                if (remaining[dependency] != 0) {
+                    current = dependency;
+                    break;
+                }
+            }
+        }
+        std::string text;
+        for (size_t i = order[current]; i < path.size(); ++i) {
+            text += tasks_[path[i]].result.name + " -> ";
+        }
+        text += tasks_[current].result.name;
+        return text;
+    }
+
+    std::vector<size_t> &GetQueue(const Task &task) {
+        if (task.result.thread == TaskThread::kMain || workerCount_ == 0) {
+            return mainQueue_;
+        }
+        return workerQueue_;
+    }
+
+    static size_t PopFront(std::vector<size_t> &queue) {
+        // 追加した順に実行したいので先頭から取り出す(処理数は少ないので詰め直しで十分)
+        size_t index = queue.front();
+        queue.erase(queue.begin());
+        return index;
+    }
+
+    void WorkerLoop() {
+        if (onWorkerBegin_) {
+            onWorkerBegin_();
+        }
+        const size_t taskCount = tasks_.size();
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [&]() {
+                    return !workerQueue_.empty() || finishedCount_ == taskCount;
+                });
+                if (workerQueue_.empty()) {
+                    break;
+                }
+                index = PopFront(workerQueue_);
+            }
+            Execute(index);
+        }
+        if (onWorkerEnd_) {
+            onWorkerEnd_();
+        }
+    }
+
+    void Execute(size_t index) {
+        Task &task = tasks_[index];
+        const auto begin = Clock::now();
+        TaskState state = TaskState::kSucceeded;
+        std::string error;
+        try {
+            task.function();
+        } catch (const std::exception &e) {
+            state = TaskState::kFailed;
+            error = e.what();
+        } catch (...) {
+            state = TaskState::kFailed;
+            error = "unknown exception";
+        }
+        const auto end = Clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        task.result.state = state;
+        task.result.error = std::move(error);
+        task.result.beginMilliseconds = ToMilliseconds(begin - startTime_);
+        task.result.durationMilliseconds = ToMilliseconds(end - begin);
+        totalMilliseconds_ = ToMilliseconds(end - startTime_);
+        Finish(index);
+        condition_.notify_all();
+    }
+
+    /// @brief 処理の完了を依存元に伝える。mutex_ をロックした状態で呼ぶ
+    void Finish(size_t index) {
+        ++finishedCount_;
+        const bool isSucceeded = tasks_[index].result.state == TaskState::kSucceeded;
+        for (size_t dependent : tasks_[index].dependents) {
+            Task &task = tasks_[dependent];
+            if (task.result.state != TaskState::kPending) {
+                // 別の依存先の失敗で既にスキップ済み
+                continue;
+            }
+            if (!isSucceeded) {
+                // 失敗は依存元へ連鎖させる
+                task.result.state = TaskState::kSkipped;
+                task.result.error = "dependency '" + tasks_[index].result.name + "' did not succeed";
+                Finish(dependent);
+            } else if (--task.remainingDependencies == 0) {
+                GetQueue(task).push_back(dependent);
+            }
+        }
+    }
+
+    static double ToMilliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    std::vector<Task> tasks_;
+    std::unordered_map<std::string, size_t> taskIndices_;
+    std::function<void()> onWorkerBegin_;
+    std::function<void()> onWorkerEnd_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<size_t> mainQueue_;
+    std::vector<size_t> workerQueue_;
+    size_t workerCount_ = 0;
+    size_t finishedCount_ = 0;
+    Clock::time_point startTime_;
+    double totalMilliseconds_ = 0.0;
+    std::string errorMessage_;
+};
+
+} // namespace MyStd
\ No newline at end of file
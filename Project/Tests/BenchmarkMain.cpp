@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include "TestLogs.h"
+#include "NullEngine.h"
+#include "Base/SceneManager.h"
+#include "Common/Benchmarks.h"
+#include "Common/ContainerBenchmarks.h"
+#include "Common/GlyphAtlasBenchmarks.h"
+#include "Common/JsonBenchmarks.h"
+#include "Common/PhysicsBenchmarks.h"
+#include "Common/ProfilerBenchmarks.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 毎フレーム描画リストに大量のオブジェクトを積むシーン
+class DrawListBenchmarkScene : public SceneBase {
+public:
+    DrawListBenchmarkScene(const std::string &name, Test::NullRenderer *renderer, int objectCount)
+        : SceneBase(name), renderer_(renderer), objectCount_(objectCount) {}
+
+    void Initialize() override { isInitialized_ = true; }
+    void Finalize() override { isInitialized_ = false; }
+    void Update() override {}
+    void Draw() override {
+        const StringId pipeLineNames[] = { "Object3d.Solid.BlendNormal", "Object3d.Solid.BlendAdd", "Object3d.Wireframe.BlendNormal" };
+        for (int i = 0; i < objectCount_; ++i) {
+            Test::NullRenderer::ObjectState objectState;
+            objectState.pipeLineName = pipeLineNames[i % 3];
+            objectState.indexCount = 36;
+            // 4つに1つは2D、8つに1つは半透明
+            renderer_->GetDrawList().AddObject(objectState, i % 4 != 0, i % 8 == 1);
+        }
+    }
+
+private:
+    Test::NullRenderer *renderer_ = nullptr;
+    int objectCount_ = 0;
+};
+
+/// @brief ウィンドウも GPU も使わずにシーンのベンチマーク(エンジンの --benchmark-scenes と同じ計測)を回す
+bool RunNullSceneBenchmarks() {
+    const uint32_t frameCount = 300;
+    Test::NullEngine engine;
+    SceneManager::AddScene<DrawListBenchmarkScene>("DrawList", "DrawList", &engine.GetRenderer(), 5000);
+    const auto results = RunSceneBenchmarks(frameCount, 30, engine.GetFrameFunctions());
+    SceneManager::ClearScenes();
+    return results.size() == 1 && results[0].frameTime.sampleCount == frameCount;
+}
+
+/// @brief 実行できるベンチマーク
+struct BenchmarkSuite {
+    const char *name;
+    std::function<bool()> run;
+};
+
+const std::vector<BenchmarkSuite> &GetBenchmarkSuites() {
+    static const std::vector<BenchmarkSuite> suites = {
+        { "micro", []() { return RunMicroBenchmarks(); } },
+        { "physics", []() { return RunPhysicsBenchmarks(); } },
+        { "containers", []() { return RunContainerBenchmarks(); } },
+        { "hashmap", []() { return RunHashMapBenchmarks(); } },
+        { "json", []() { return RunJsonBenchmarks(); } },
+        { "profiler", []() { return RunProfilerBenchmarks(); } },
+        { "glyphatlas", []() { return RunGlyphAtlasBenchmarks(); } },
+        { "scenes", []() { return RunNullSceneBenchmarks(); } },
+    };
+    return suites;
+}
+
+} // namespace
+
+/// @brief 引数で指定したベンチマーク(指定が無ければ全て)を実行する。
+/// 基準より遅くなったものや結果の違いがあれば 1 を返す
+int main(int argc, char **argv) {
+    Test::SetLogEcho(true);
+    std::vector<std::string> names(argv + 1, argv + argc);
+    bool isPassed = true;
+    size_t runCount = 0;
+    for (const auto &suite : GetBenchmarkSuites()) {
+        if (!names.empty() && std::find(names.begin(), names.end(), suite.name) == names.end()) {
+            continue;
+        }
+        isPassed = suite.run() && isPassed;
+        ++runCount;
+    }
+    if (runCount == 0) {
+        std::printf("Unknown benchmark. Available:");
+        for (const auto &suite : GetBenchmarkSuites()) {
+            std::printf(" %s", suite.name);
+        }
+        std::printf("\n");
+        return 1;
+    }
+    return isPassed ? 0 : 1;
+}
\ No newline at end of file
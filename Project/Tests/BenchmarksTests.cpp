@@ -0,0 +1,62 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "TestFramework.h"
+#include "TestLogs.h"
+#include "Common/Benchmarks.h"
+#include "Common/Logs.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テスト用の一時ディレクトリ(テストの終わりに消す)
+class TempDirectory {
+public:
+    TempDirectory() {
+        path_ = std::filesystem::temp_directory_path() / "KashipanEngineBenchmarksTests";
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string operator/(const std::string &name) const {
+        return (path_ / name).string();
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+std::vector<MyStd::Benchmark::Result> MakeResults(double nanoseconds) {
+    MyStd::Benchmark::Result result;
+    result.name = "Benchmarks.Test";
+    result.nanosecondsPerIteration = nanoseconds;
+    result.minNanosecondsPerIteration = nanoseconds;
+    result.maxNanosecondsPerIteration = nanoseconds;
+    result.iterationCount = 1;
+    result.sampleCount = 1;
+    return { result };
+}
+
+} // namespace
+
+TEST(Benchmarks, MissingBaselineFails) {
+    TempDirectory directory;
+    const std::string baselinePath = directory / "missing_baseline.json";
+    Test::ClearLogs();
+    EXPECT_FALSE(CheckBenchmarkRegressions(MakeResults(10.0), baselinePath, 0.1));
+    EXPECT_EQ(size_t(1), Test::GetLogCount(kLogLevelFlagError));
+    // 基準を勝手に作らない
+    EXPECT_FALSE(std::filesystem::exists(baselinePath));
+}
+
+TEST(Benchmarks, ComparesAgainstSavedBaseline) {
+    TempDirectory directory;
+    const std::string baselinePath = directory / "baseline.json";
+    ASSERT_TRUE(SaveBenchmarkResults(MakeResults(10.0), baselinePath));
+    EXPECT_TRUE(CheckBenchmarkRegressions(MakeResults(10.5), baselinePath, 0.1));
+    EXPECT_FALSE(CheckBenchmarkRegressions(MakeResults(12.0), baselinePath, 0.1));
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "TestFramework.h"
+#include "Common/CookedJson.h"
+#include "Common/JsoncLoader.h"
+#include "Common/StringId.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テスト用の一時フォルダ。終了時に消す
+class TempDirectory {
+public:
+    TempDirectory() {
+        path_ = std::filesystem::temp_directory_path() / "KashipanEngineCookedJsonTests";
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string operator/(const std::string &name) const {
+        return (path_ / name).string();
+    }
+    /// @brief 保存の一時ファイルが残っているかどうか
+    bool HasTemporaryFile() const {
+        for (const auto &entry : std::filesystem::directory_iterator(path_)) {
+            if (entry.path().extension() == ".tmp") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+void WriteText(const std::string &filepath, const std::string &text) {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+Json MakeSample() {
+    return Json::parse(R"({
+        "null": null, "true": true, "false": false,
+        "integer": -123456789012, "unsigned": 18446744073709551615, "float": 0.1,
+        "string": "テキスト", "empty": "", "array": [ 1, [ 2, [ 3 ] ], { "a": [] } ],
+        "object": { "b": 1, "a": 2, "nested": { "deep": {} } }
+    })");
+}
+
+} // namespace
+
+TEST(CookedJson, CookAndUncookRoundTrip) {
+    const Json json = MakeSample();
+    const uint64_t hash = 0x1234;
+    const auto restored = UncookJson(CookJson(json, hash), &hash);
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_TRUE(*restored == json);
+    // 型も保たれる
+    EXPECT_TRUE(restored->at("integer").is_number_integer());
+    EXPECT_TRUE(restored->at("unsigned").is_number_unsigned());
+    EXPECT_TRUE(restored->at("float").get<double>() == 0.1);
+}
+
+TEST(CookedJson, RejectsStaleOrBrokenData) {
+    const uint64_t hash = 1;
+    const uint64_t otherHash = 2;
+    const std::string bytes = CookJson(MakeSample(), hash);
+    EXPECT_FALSE(UncookJson(bytes, &otherHash).has_value());
+    EXPECT_TRUE(UncookJson(bytes, nullptr).has_value());
+    // 途中で切れたデータ・余分なデータ
+    for (size_t size = 0; size < bytes.size(); size += 7) {
+        EXPECT_FALSE(UncookJson(std::string_view(bytes).substr(0, size), nullptr).has_value());
+    }
+    EXPECT_FALSE(UncookJson(bytes + "x", nullptr).has_value());
+    // 型タグが壊れたデータ(ヘッダーの直後が最初の値の型タグ)
+    std::string broken = bytes;
+    broken[24] = static_cast<char>(0xFF);
+    EXPECT_FALSE(UncookJson(broken, nullptr).has_value());
+}
+
+TEST(CookedJson, SaveReplacesFileWithoutLeavingTemporary) {
+    TempDirectory directory;
+    const std::string path = directory / "config.json.cooked";
+    WriteText(path, "old");
+    ASSERT_TRUE(SaveCookedJson(path, 5, MakeSample()));
+    EXPECT_FALSE(directory.HasTemporaryFile());
+    const uint64_t hash = 5;
+    const auto loaded = LoadCookedJson(path, &hash);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_TRUE(*loaded == MakeSample());
+}
+
+TEST(CookedJson, LoadJsoncIgnoresStaleCookedFile) {
+    TempDirectory directory;
+    const std::string path = directory / "config.json";
+    const std::string cookedPath = path + kCookedJsonExtension;
+    WriteText(path, "{ \"value\": 1 } // コメント");
+    EXPECT_EQ(1, LoadJsonc(path)["value"].get<int>());
+    ASSERT_TRUE(std::filesystem::exists(cookedPath));
+    EXPECT_EQ(1, LoadJsonc(path)["value"].get<int>());
+
+    // 元のファイルを書き換えたら、変換済みファイルではなく新しい内容を読む
+    WriteText(path, "{ \"value\": 2 }");
+    EXPECT_EQ(2, LoadJsonc(path)["value"].get<int>());
+    const uint64_t hash = StringId::Hash(std::string("{ \"value\": 2 }"));
+    EXPECT_TRUE(LoadCookedJson(cookedPath, &hash).has_value());
+
+    // 元のファイルが無ければ変換済みファイルを使う
+    std::filesystem::remove(path);
+    EXPECT_EQ(2, LoadJsonc(path)["value"].get<int>());
+}
+
+TEST(CookedJson, SaveJsoncRewritesExistingCookedFile) {
+    TempDirectory directory;
+    const std::string path = directory / "save.json";
+    const std::string cookedPath = path + kCookedJsonExtension;
+    // 変換済みファイルが無ければ作らない
+    ASSERT_TRUE(SaveJsonc(Json{ { "value", 1 } }, path));
+    EXPECT_FALSE(std::filesystem::exists(cookedPath));
+    EXPECT_EQ(1, LoadJsonc(path)["value"].get<int>());
+    ASSERT_TRUE(std::filesystem::exists(cookedPath));
+
+    // 保存したら変換済みファイルも新しい内容とハッシュ値になる
+    ASSERT_TRUE(SaveJsonc(MakeSample(), path));
+    std::ifstream file(path, std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const uint64_t hash = StringId::Hash(text);
+    const auto cooked = LoadCookedJson(cookedPath, &hash);
+    ASSERT_TRUE(cooked.has_value());
+    EXPECT_TRUE(*cooked == MakeSample());
+    EXPECT_TRUE(LoadJsonc(path) == MakeSample());
+    EXPECT_FALSE(directory.HasTemporaryFile());
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <any>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <Document.h>
+#include <DocumentCompat.h>
+#include "TestFramework.h"
+#include "2d/UI/UIElements.h"
+
+using namespace MyStd;
+
+TEST(Document, BuildsAndReadsTypedValues) {
+    Document document;
+    document["name"] = "player";
+    document["hp"] = 100;
+    document["speed"] = 2.5f;
+    document["isAlive"] = true;
+    document["items"].push_back(std::string("sword"));
+    document["items"].push_back(std::string("a string longer than sixteen bytes"));
+    const DocumentValue &root = document.GetRootValue();
+    EXPECT_EQ(std::string("player"), root.at("name").GetTo<std::string>());
+    EXPECT_EQ(100, root.at("hp").GetTo<int>());
+    EXPECT_NEAR(2.5, root.at("speed").GetTo<double>(), 1.0e-9);
+    EXPECT_TRUE(root.at("isAlive").GetTo<bool>());
+    EXPECT_EQ(size_t(2), root.at("items").size());
+    EXPECT_EQ(std::string("a string longer than sixteen bytes"), root.at("items").at(1).GetTo<std::string>());
+    bool isThrown = false;
+    try {
+        root.at("hp").GetTo<std::string>();
+    } catch (const std::invalid_argument &) {
+        isThrown = true;
+    }
+    EXPECT_TRUE(isThrown);
+}
+
+TEST(Document, ValuesSurviveMoveButNodesMustBeReacquired) {
+    Document document;
+    document["a"]["b"] = 1;
+    const DocumentValue *value = &document.GetRootValue().at("a").at("b");
+    Document moved(std::move(document));
+    // 値のアドレスは変わらない
+    EXPECT_TRUE(&moved.GetRootValue().at("a").at("b") == value);
+    // ハンドルは新しい Document から取り直す
+    moved.GetRoot()["a"]["b"] = 2;
+    EXPECT_EQ(2, value->GetTo<int>());
+}
+
+TEST(Document, ConvertsAnyUnorderedMapBothWays) {
+    AnyUnorderedMap source;
+    source["name"] = std::any(std::string("enemy"));
+    source["hp"] = std::any(30);
+    source["speed"] = std::any(1.5f);
+    source["isBoss"] = std::any(false);
+    source["stats"]["attack"] = std::any(12);
+    AnyVector drops;
+    drops.push_back(std::any(std::string("coin")));
+    drops.push_back(std::any(3));
+    source["drops"] = std::any(drops);
+
+    Document document;
+    DocumentCompat::ToDocument(source, document);
+    const DocumentValue &root = document.GetRootValue();
+    EXPECT_EQ(std::string("enemy"), root.at("name").GetTo<std::string>());
+    EXPECT_EQ(30, root.at("hp").GetTo<int>());
+    EXPECT_NEAR(1.5f, root.at("speed").GetTo<float>(), 1.0e-6f);
+    EXPECT_FALSE(root.at("isBoss").GetTo<bool>());
+    EXPECT_EQ(12, root.at("stats").at("attack").GetTo<int>());
+    EXPECT_TRUE(root.at("drops").IsArray());
+    EXPECT_EQ(3, root.at("drops").at(1).GetTo<int>());
+
+    // 元の型(int・float・std::string)で取り出せる
+    AnyUnorderedMap restored = DocumentCompat::ToAnyUnorderedMap(root);
+    EXPECT_EQ(std::string("enemy"), restored["name"].GetTo<std::string>());
+    EXPECT_EQ(30, restored["hp"].GetTo<int>());
+    EXPECT_NEAR(1.5f, restored["speed"].GetTo<float>(), 1.0e-6f);
+    EXPECT_FALSE(restored["isBoss"].GetTo<bool>());
+    EXPECT_EQ(12, restored["stats"]["attack"].GetTo<int>());
+    AnyVector restoredDrops = restored["drops"].GetTo<AnyVector>();
+    EXPECT_EQ(size_t(2), restoredDrops.size());
+    EXPECT_EQ(std::string("coin"), restoredDrops[0].GetTo<std::string>());
+}
+
+TEST(Document, ConvertsAnyVectorAndRejectsUnsupportedValues) {
+    AnyVector source;
+    source.push_back(std::any(1));
+    source[1][0] = std::any(2.0);
+    Document document;
+    DocumentCompat::ToDocument(source, document);
+    EXPECT_EQ(size_t(2), document.GetRootValue().size());
+    EXPECT_NEAR(2.0, document.GetRootValue().at(1).at(0).GetTo<double>(), 1.0e-9);
+    AnyVector restored = DocumentCompat::ToAnyVector(document.GetRootValue());
+    EXPECT_EQ(1, restored[0].GetTo<int>());
+    EXPECT_NEAR(2.0f, restored[1][0].GetTo<float>(), 1.0e-6f);
+
+    // Document で表せない型は例外にする
+    AnyVector unsupported;
+    unsupported.push_back(std::any(std::pair<int, int>(1, 2)));
+    bool isThrown = false;
+    try {
+        DocumentCompat::ToDocument(unsupported, document);
+    } catch (const std::invalid_argument &) {
+        isThrown = true;
+    }
+    EXPECT_TRUE(isThrown);
+}
+
+TEST(Document, UIElementsKeepsTypesAndDoesNotGrowOnOverwrite) {
+    using namespace KashipanEngine;
+    UIElements elements;
+    EXPECT_EQ(-1, elements.Get<int>("textureIndex"));
+    EXPECT_TRUE(elements.Get<bool>("isVisible"));
+    EXPECT_NEAR(1.0f, elements.Get<Vector2>("scale").x, 1.0e-6f);
+    // 無い要素は既定値で作る
+    EXPECT_NEAR(0.0f, elements.Get<float>("alpha"), 1.0e-6f);
+    for (int frame = 0; frame < 1000; ++frame) {
+        elements.Set("color", Vector4(static_cast<float>(frame), 0.0f, 0.0f, 255.0f));
+        elements.Set("pos", Vector2(1.0f, static_cast<float>(frame)));
+    }
+    EXPECT_NEAR(999.0f, elements.Get<Vector4>("color").x, 1.0e-6f);
+    EXPECT_NEAR(999.0f, elements.Get<Vector2>("pos").y, 1.0e-6f);
+}
\ No newline at end of file
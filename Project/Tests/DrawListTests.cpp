@@ -0,0 +1,112 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestFramework.h"
+#include "NullEngine.h"
+
+using namespace KashipanEngine;
+using Test::NullRenderer;
+
+namespace {
+
+/// @brief 1ページで "A" だけのフォント
+FontData CreateDrawListTestFont() {
+    FontData fontData{};
+    fontData.common.lineHeight = 32.0f;
+    fontData.common.scaleW = 256.0f;
+    fontData.common.scaleH = 256.0f;
+    fontData.common.pages = 1;
+    fontData.pages.emplace_back();
+    std::vector<CharInfo> chars;
+    CharInfo charInfo{};
+    charInfo.id = 'A';
+    charInfo.width = 20.0f;
+    charInfo.height = 32.0f;
+    charInfo.xAdvance = 20.0f;
+    chars.push_back(charInfo);
+    fontData.charsCount = static_cast<int>(chars.size());
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+TextBatcher::TextState MakeTextState(const TextLayout &layout, const FontData &fontData, bool isUseCamera) {
+    TextBatcher::TextState textState;
+    textState.layout = &layout;
+    textState.fontData = &fontData;
+    textState.maxGlyphCount = static_cast<uint32_t>(layout.GetGlyphs().size());
+    textState.isUseCamera = isUseCamera;
+    return textState;
+}
+
+NullRenderer::ObjectState MakeObject(const std::string &name, StringId pipeLineName, uint32_t vertexCount, uint32_t indexCount) {
+    NullRenderer::ObjectState objectState;
+    objectState.name = name;
+    objectState.pipeLineName = pipeLineName;
+    objectState.vertexCount = vertexCount;
+    objectState.indexCount = indexCount;
+    return objectState;
+}
+
+} // namespace
+
+TEST(DrawList, DrawsInRendererOrder) {
+    // 線、通常、半透明、カメラを使うテキストの順に描画し、2Dは追加した順番を保つ
+    const FontData fontData = CreateDrawListTestFont();
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetText(u8"AA");
+    NullRenderer renderer;
+    renderer.PreDraw();
+    auto &drawList = renderer.GetDrawList();
+    drawList.AddObject(MakeObject("2d-0", "Object3d.Solid.BlendNormal", 4, 6), false, false);
+    drawList.AddText(MakeTextState(layout, fontData, false));
+    drawList.AddObject(MakeObject("alpha", "Object3d.Solid.BlendNormal", 4, 6), true, true);
+    drawList.AddObject(MakeObject("2d-1", "Object3d.Solid.BlendNormal", 4, 6), false, false);
+    drawList.AddText(MakeTextState(layout, fontData, true));
+    drawList.AddObject(MakeObject("opaque", "Object3d.Solid.BlendNormal", 4, 6), true, false);
+    NullRenderer::LineState line;
+    line.name = "line";
+    line.vertexCount = 2;
+    drawList.AddLine(line);
+    renderer.PostDraw();
+
+    // まとめる単位は追加した順(0が2Dのテキスト、1がカメラを使うテキスト)
+    const std::vector<std::string> expected = { "line", "opaque", "alpha", "text:1", "2d-0", "text:0", "2d-1" };
+    EXPECT_TRUE(renderer.GetDrawOrder() == expected);
+    const auto &drawStats = renderer.GetDrawStats();
+    EXPECT_EQ(7u, drawStats.drawCallCount);
+    EXPECT_EQ(1u, drawStats.lineDrawCallCount);
+    EXPECT_EQ(2u, drawStats.textDrawCallCount);
+    EXPECT_EQ(2u, drawStats.textCount);
+    EXPECT_EQ(4u, drawStats.textGlyphCount);
+    // 線の2頂点 + オブジェクト4つの6インデックス + 文字4つの6インデックス
+    EXPECT_EQ(uint64_t(2 + 4 * 6 + 4 * 6), drawStats.primitiveVertexCount);
+}
+
+TEST(DrawList, CountsDrawsAndPipeLineChanges) {
+    NullRenderer renderer;
+    renderer.PreDraw();
+    auto &drawList = renderer.GetDrawList();
+    // パーティクルは描画リストを通さず、その場で描画される
+    drawList.SetPipeLine(renderer, "Particle.Solid.BlendNormal");
+    drawList.CountParticleDraw(10, 6);
+    drawList.AddObject(MakeObject("a", "Object3d.Solid.BlendNormal", 4, 6), true, false);
+    drawList.AddObject(MakeObject("b", "Object3d.Solid.BlendNormal", 3, 0), true, false);
+    drawList.AddObject(MakeObject("c", "Object3d.Solid.BlendAdd", 4, 6), true, false);
+    renderer.PostDraw();
+
+    const auto &drawStats = renderer.GetDrawStats();
+    EXPECT_EQ(4u, drawStats.drawCallCount);
+    EXPECT_EQ(1u, drawStats.particleDrawCallCount);
+    EXPECT_EQ(13u, drawStats.instanceCount);
+    // インデックスの無いものは頂点の数を数える
+    EXPECT_EQ(uint64_t(60 + 6 + 3 + 6), drawStats.primitiveVertexCount);
+    // パーティクル、オブジェクト用の既定のパイプライン、BlendAdd
+    EXPECT_EQ(3u, drawStats.pipeLineChangeCount);
+
+    // 次のフレームは数え直す
+    renderer.PreDraw();
+    renderer.PostDraw();
+    EXPECT_EQ(0u, renderer.GetDrawStats().drawCallCount);
+    EXPECT_EQ(1u, renderer.GetDrawStats().pipeLineChangeCount);
+}
\ No newline at end of file
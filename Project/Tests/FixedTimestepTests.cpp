@@ -0,0 +1,113 @@
+#include <cmath>
+#include <vector>
+#include <FixedTimestep.h>
+#include "TestFramework.h"
+#include "Math/Physics/PhysicsWorld.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+const double kTickRate = 60.0;
+const uint32_t kMaxSubsteps = 8;
+
+/// @brief 地面に向かって落ちる球を並べたワールドを作る
+void BuildFallingBalls(PhysicsWorld &world) {
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    RigidBodyDesc desc;
+    for (int i = 0; i < 8; ++i) {
+        desc.position = Vector3(static_cast<float>(i) * 1.1f, 1.0f + static_cast<float>(i) * 0.7f, 0.0f);
+        desc.velocity = Vector3(0.0f, 0.0f, static_cast<float>(i % 3) * 0.5f);
+        desc.restitution = 0.2f;
+        world.AddBody(desc);
+    }
+}
+
+/// @brief エンジンのゲームループと同じ形で、フレームの経過時間をティックに分けてワールドを進める。
+/// ティックごとの状態のハッシュを返す
+std::vector<uint64_t> RunFixedLoop(const std::vector<double> &frameTimes, size_t tickCount) {
+    MyStd::FixedTimestep timestep(kTickRate, kMaxSubsteps);
+    // ワールドの中のアキュムレータは使わず、1ティックに1ステップだけ進める
+    PhysicsWorld world(static_cast<float>(1.0 / kTickRate), 1);
+    BuildFallingBalls(world);
+    std::vector<uint64_t> hashes;
+    for (size_t frame = 0; hashes.size() < tickCount; ++frame) {
+        uint32_t pendingTickCount = timestep.Advance(frameTimes[frame % frameTimes.size()]);
+        while (pendingTickCount-- > 0) {
+            world.StepFixed();
+            hashes.push_back(world.ComputeStateHash());
+        }
+    }
+    hashes.resize(tickCount);
+    return hashes;
+}
+
+} // namespace
+
+TEST(FixedTimestep, SimulationDoesNotDependOnFrameRate) {
+    // 144fps・24fps・揺れのあるフレーム時間で回しても、同じティックでは同じ状態になる
+    const size_t kTickCount = 240;
+    const std::vector<uint64_t> reference = RunFixedLoop({ 1.0 / 144.0 }, kTickCount);
+    EXPECT_TRUE(reference == RunFixedLoop({ 1.0 / 24.0 }, kTickCount));
+    EXPECT_TRUE(reference == RunFixedLoop({ 0.004, 0.031, 0.017, 0.009, 0.052 }, kTickCount));
+    // 状態が実際に変化していること(何も動かないワールドでは比べる意味がない)
+    EXPECT_NE(reference.front(), reference.back());
+}
+
+TEST(FixedTimestep, TickCountDoesNotDependOnFrameSplit) {
+    // 2進数で割り切れる時間を使い、丸め誤差なしで同じ合計時間を別々に区切る
+    MyStd::FixedTimestep even(64.0, kMaxSubsteps);
+    MyStd::FixedTimestep uneven(64.0, kMaxSubsteps);
+    const double frameTimes[] = { 1.0 / 256.0, 3.0 / 128.0, 1.0 / 32.0, 1.0 / 256.0, 9.0 / 256.0 };
+    uint64_t evenTickCount = 0;
+    uint64_t unevenTickCount = 0;
+    for (int frame = 0; frame < 160; ++frame) {
+        evenTickCount += even.Advance(5.0 / 256.0);
+        unevenTickCount += uneven.Advance(frameTimes[frame % 5]);
+    }
+    // 合計は両方とも 160 * 5 / 256 秒 = 200 ティック
+    EXPECT_EQ(uint64_t(200), evenTickCount);
+    EXPECT_EQ(evenTickCount, unevenTickCount);
+    EXPECT_EQ(evenTickCount, even.GetTotalTickCount());
+    EXPECT_NEAR(0.0, uneven.GetAlpha(), 1e-12);
+}
+
+TEST(FixedTimestep, InterpolationFollowsElapsedTime) {
+    // 等速で動く点を前後のティックの間で補間すると、経過時間での位置と一致する
+    const double kSpeed = 3.0;
+    MyStd::FixedTimestep timestep(kTickRate, kMaxSubsteps);
+    double previousPosition = 0.0;
+    double currentPosition = 0.0;
+    double elapsed = 0.0;
+    const double frameTimes[] = { 0.007, 0.013, 0.021, 0.0166, 0.041 };
+    for (int frame = 0; frame < 200; ++frame) {
+        const double frameTime = frameTimes[frame % 5];
+        elapsed += frameTime;
+        uint32_t pendingTickCount = timestep.Advance(frameTime);
+        while (pendingTickCount-- > 0) {
+            previousPosition = currentPosition;
+            currentPosition += kSpeed * timestep.GetTickDelta();
+        }
+        const double alpha = timestep.GetAlpha();
+        EXPECT_TRUE(alpha >= 0.0 && alpha < 1.0);
+        if (timestep.GetTotalTickCount() == 0) {
+            continue;
+        }
+        // 描画は1ティック遅れの位置になる
+        const double drawnPosition = previousPosition + (currentPosition - previousPosition) * alpha;
+        EXPECT_NEAR(kSpeed * (elapsed - timestep.GetTickDelta()), drawnPosition, 1e-9);
+    }
+}
+
+TEST(FixedTimestep, DropsTimeBeyondMaxSubsteps) {
+    MyStd::FixedTimestep timestep(kTickRate, 4);
+    // 10.5 ティック分の処理落ちは 4 ティックだけ進め、残りの整数ティック分を捨てる
+    EXPECT_EQ(4u, timestep.Advance(10.5 / kTickRate));
+    EXPECT_NEAR(6.0 / kTickRate, timestep.GetDroppedSeconds(), 1e-12);
+    EXPECT_NEAR(0.5, timestep.GetAlpha(), 1e-9);
+    // 次のフレームに遅れを持ち越さない
+    EXPECT_EQ(1u, timestep.Advance(0.5 / kTickRate));
+    timestep.Reset();
+    EXPECT_EQ(uint64_t(0), timestep.GetTotalTickCount());
+    EXPECT_NEAR(0.0, timestep.GetDroppedSeconds(), 1e-12);
+}
\ No newline at end of file
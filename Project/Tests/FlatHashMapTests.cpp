@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <FlatHashMap.h>
+#include "TestFramework.h"
+
+using MyStd::FlatHashMap;
+using MyStd::FlatHashSet;
+
+namespace {
+
+/// @brief 指定回数目の構築で例外を出す値。生きている数も数える
+struct Fragile {
+    // 生きているインスタンスの数
+    static inline int sLiveCount = 0;
+    // 0 より大きければ、この回数目の構築で例外を出す
+    static inline int sThrowCountdown = 0;
+
+    explicit Fragile(int setValue) : value(setValue) {
+        Tick();
+        ++sLiveCount;
+    }
+    Fragile(const Fragile &other) : value(other.value) {
+        Tick();
+        ++sLiveCount;
+    }
+    // 例外を出し得るムーブ(再ハッシュではコピーされるはず)
+    Fragile(Fragile &&other) : value(other.value) {
+        Tick();
+        other.value = -1;
+        ++sLiveCount;
+    }
+    Fragile &operator=(const Fragile &) = default;
+    ~Fragile() {
+        --sLiveCount;
+    }
+
+    static void Tick() {
+        if (sThrowCountdown > 0 && --sThrowCountdown == 0) {
+            throw std::runtime_error("Fragile");
+        }
+    }
+
+    int value;
+};
+
+/// @brief 中身が std::unordered_map と一致しているか
+template<typename Map, typename Reference>
+bool IsSameContents(const Map &map, const Reference &reference) {
+    if (map.size() != reference.size()) {
+        return false;
+    }
+    size_t visited = 0;
+    for (const auto &[key, value] : map) {
+        auto it = reference.find(key);
+        if (it == reference.end() || it->second != value) {
+            return false;
+        }
+        ++visited;
+    }
+    return visited == reference.size();
+}
+
+} // namespace
+
+TEST(FlatHashMap, RandomOperationsMatchUnorderedMap) {
+    std::mt19937 engine(12345u);
+    FlatHashMap<int, int> map;
+    std::unordered_map<int, int> reference;
+    for (int operation = 0; operation < 200000; ++operation) {
+        // キーの範囲を狭くして、追加と削除が同じキーでぶつかるようにする
+        const int key = static_cast<int>(engine() % 2048) - 1024;
+        const int value = static_cast<int>(engine());
+        switch (engine() % 10) {
+        case 0:
+        case 1: {
+            const bool isInserted = map.try_emplace(key, value).second;
+            EXPECT_EQ(reference.try_emplace(key, value).second, isInserted);
+            break;
+        }
+        case 2:
+            map[key] = value;
+            reference[key] = value;
+            break;
+        case 3:
+            map.insert_or_assign(key, value);
+            reference.insert_or_assign(key, value);
+            break;
+        case 4:
+        case 5:
+            EXPECT_EQ(reference.erase(key), map.erase(key));
+            break;
+        case 6: {
+            auto it = map.find(key);
+            if (it != map.end()) {
+                map.erase(it);
+            }
+            reference.erase(key);
+            break;
+        }
+        case 7: {
+            auto it = map.find(key);
+            auto referenceIt = reference.find(key);
+            ASSERT_TRUE((it == map.end()) == (referenceIt == reference.end()));
+            if (it != map.end()) {
+                EXPECT_EQ(referenceIt->second, it->second);
+            }
+            break;
+        }
+        case 8:
+            EXPECT_EQ(reference.count(key) == 1, map.contains(key));
+            break;
+        default:
+            if (engine() % 5000 == 0) {
+                map.clear();
+                reference.clear();
+            }
+            break;
+        }
+        ASSERT_TRUE(map.size() == reference.size());
+        if (operation % 10000 == 0) {
+            ASSERT_TRUE(IsSameContents(map, reference));
+        }
+    }
+    ASSERT_TRUE(IsSameContents(map, reference));
+
+    // コピーとムーブ
+    FlatHashMap<int, int> copy(map);
+    EXPECT_TRUE(IsSameContents(copy, reference));
+    FlatHashMap<int, int> moved(std::move(copy));
+    EXPECT_TRUE(IsSameContents(moved, reference));
+    EXPECT_EQ(size_t(0), copy.size());
+    copy = moved;
+    EXPECT_TRUE(IsSameContents(copy, reference));
+}
+
+TEST(FlatHashMap, StringKeysSupportTransparentLookup) {
+    FlatHashMap<std::string, int> map;
+    std::unordered_map<std::string, int> reference;
+    for (int i = 0; i < 5000; ++i) {
+        const std::string key = "Resources/Textures/" + std::to_string(i * 7919 % 10007) + ".png";
+        map[key] = i;
+        reference[key] = i;
+    }
+    ASSERT_TRUE(IsSameContents(map, reference));
+    for (const auto &[key, value] : reference) {
+        const std::string_view view(key);
+        EXPECT_TRUE(map.find(view) != map.end());
+        EXPECT_EQ(value, map.at(view));
+        EXPECT_EQ(value, map.at(key.c_str()));
+    }
+    EXPECT_TRUE(map.find(std::string_view("missing")) == map.end());
+    EXPECT_FALSE(map.contains("missing"));
+    bool isThrown = false;
+    try {
+        map.at("missing");
+    } catch (const std::out_of_range &) {
+        isThrown = true;
+    }
+    EXPECT_TRUE(isThrown);
+}
+
+TEST(FlatHashMap, EraseWhileIteratingVisitsEveryElementOnce) {
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+    std::vector<int> visited;
+    for (auto it = map.begin(); it != map.end();) {
+        visited.push_back(it->first);
+        if (it->first % 3 == 0) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(size_t(1000), visited.size());
+    EXPECT_TRUE(std::adjacent_find(visited.begin(), visited.end()) == visited.end());
+    EXPECT_EQ(size_t(666), map.size());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i % 3 != 0, map.contains(i));
+    }
+}
+
+TEST(FlatHashMap, ChurnDoesNotGrowWithoutBound) {
+    // 追加と削除を繰り返しても、削除済みのスロットを詰め直すので容量は増え続けない
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::mt19937_64 engine(99u);
+    std::vector<uint64_t> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(engine());
+        map[keys.back()] = i;
+    }
+    const size_t capacity = map.capacity();
+    for (int round = 0; round < 100000; ++round) {
+        const size_t slot = engine() % keys.size();
+        EXPECT_EQ(size_t(1), map.erase(keys[slot]));
+        keys[slot] = engine();
+        map[keys[slot]] = static_cast<uint64_t>(round);
+    }
+    EXPECT_EQ(size_t(1000), map.size());
+    EXPECT_TRUE(map.capacity() <= capacity * 2);
+    for (const uint64_t key : keys) {
+        EXPECT_TRUE(map.contains(key));
+    }
+}
+
+TEST(FlatHashMap, SetMatchesUnorderedSet) {
+    std::mt19937 engine(4242u);
+    FlatHashSet<int> set;
+    std::unordered_set<int> reference;
+    for (int operation = 0; operation < 100000; ++operation) {
+        const int key = static_cast<int>(engine() % 4096);
+        if (engine() % 3 != 0) {
+            EXPECT_EQ(reference.insert(key).second, set.insert(key).second);
+        } else {
+            EXPECT_EQ(reference.erase(key), set.erase(key));
+        }
+        ASSERT_TRUE(set.size() == reference.size());
+    }
+    size_t visited = 0;
+    for (const int key : set) {
+        EXPECT_EQ(size_t(1), reference.count(key));
+        ++visited;
+    }
+    EXPECT_EQ(reference.size(), visited);
+}
+
+TEST(FlatHashMap, ThrowingConstructorLeavesMapUnchanged) {
+    Fragile::sLiveCount = 0;
+    {
+        FlatHashMap<int, Fragile> map;
+        for (int i = 0; i < 10; ++i) {
+            map.try_emplace(i, i * 10);
+        }
+        const size_t capacity = map.capacity();
+        Fragile::sThrowCountdown = 1;
+        bool isThrown = false;
+        try {
+            map.try_emplace(100, 1000);
+        } catch (const std::runtime_error &) {
+            isThrown = true;
+        }
+        EXPECT_TRUE(isThrown);
+        // 途中まで追加した状態が残らない
+        EXPECT_EQ(size_t(10), map.size());
+        EXPECT_EQ(capacity, map.capacity());
+        EXPECT_FALSE(map.contains(100));
+        EXPECT_EQ(10, Fragile::sLiveCount);
+        size_t visited = 0;
+        for (const auto &[key, value] : map) {
+            EXPECT_EQ(key * 10, value.value);
+            ++visited;
+        }
+        EXPECT_EQ(size_t(10), visited);
+        // その後も普通に使える
+        map.try_emplace(100, 1000);
+        EXPECT_EQ(1000, map.at(100).value);
+        EXPECT_EQ(size_t(11), map.size());
+    }
+    EXPECT_EQ(0, Fragile::sLiveCount);
+}
+
+TEST(FlatHashMap, ThrowDuringRehashKeepsOldContents) {
+    Fragile::sLiveCount = 0;
+    {
+        FlatHashMap<int, Fragile> map;
+        // 最初の容量は16で、負荷率 7/8 の14個までは再ハッシュしない
+        const int count = 14;
+        for (int i = 0; i < count; ++i) {
+            map.try_emplace(i, i);
+        }
+        const size_t capacity = map.capacity();
+        ASSERT_TRUE(capacity == 16);
+        const size_t size = map.size();
+        const int liveCount = Fragile::sLiveCount;
+        // 再ハッシュの途中(3つ目の要素を移すところ)で例外を出す
+        Fragile::sThrowCountdown = 3;
+        bool isThrown = false;
+        try {
+            map.try_emplace(count, count);
+        } catch (const std::runtime_error &) {
+            isThrown = true;
+        }
+        EXPECT_TRUE(isThrown);
+        EXPECT_EQ(size, map.size());
+        EXPECT_EQ(capacity, map.capacity());
+        EXPECT_EQ(liveCount, Fragile::sLiveCount);
+        for (int i = 0; i < count; ++i) {
+            ASSERT_TRUE(map.contains(i));
+            // ムーブせずにコピーしたので、元の値は壊れていない
+            EXPECT_EQ(i, map.at(i).value);
+        }
+        map.try_emplace(count, count);
+        EXPECT_EQ(count, map.at(count).value);
+        EXPECT_TRUE(map.capacity() > capacity);
+    }
+    EXPECT_EQ(0, Fragile::sLiveCount);
+}
+
+TEST(FlatHashMap, ThrowingCopyConstructorReleasesPartialCopy) {
+    Fragile::sLiveCount = 0;
+    {
+        FlatHashMap<int, Fragile> map;
+        for (int i = 0; i < 100; ++i) {
+            map.try_emplace(i, i);
+        }
+        Fragile::sThrowCountdown = 50;
+        bool isThrown = false;
+        try {
+            FlatHashMap<int, Fragile> copy(map);
+        } catch (const std::runtime_error &) {
+            isThrown = true;
+        }
+        EXPECT_TRUE(isThrown);
+        // 途中までコピーした要素は壊されている
+        EXPECT_EQ(100, Fragile::sLiveCount);
+    }
+    EXPECT_EQ(0, Fragile::sLiveCount);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "TestFramework.h"
+#include "Font/CookedFont.h"
+#include "Font/FontLoader.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テスト用の一時ディレクトリ(テストの終わりに消す)
+class TempDirectory {
+public:
+    TempDirectory() {
+        path_ = std::filesystem::temp_directory_path() / "KashipanEngineFontLoaderTests";
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string operator/(const std::string &name) const {
+        return (path_ / name).string();
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+std::string ReadFile(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::string &filePath, const std::string &bytes) {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/// @brief リトルエンディアンで値を追加する
+template<typename T>
+void Append(std::string &bytes, T value) {
+    char buffer[sizeof(T)];
+    std::memcpy(buffer, &value, sizeof(T));
+    bytes.append(buffer, sizeof(T));
+}
+
+/// @brief バイナリ形式のブロックを追加する
+void AppendBlock(std::string &bytes, uint8_t blockType, const std::string &block) {
+    Append<uint8_t>(bytes, blockType);
+    Append<uint32_t>(bytes, static_cast<uint32_t>(block.size()));
+    bytes += block;
+}
+
+void AppendChar(std::string &block, uint32_t id, uint16_t x, int16_t xAdvance) {
+    Append<uint32_t>(block, id);
+    Append<uint16_t>(block, x);
+    Append<uint16_t>(block, 0);
+    Append<uint16_t>(block, 10);
+    Append<uint16_t>(block, 12);
+    Append<int16_t>(block, -1);
+    Append<int16_t>(block, 2);
+    Append<int16_t>(block, xAdvance);
+    Append<uint8_t>(block, 0);
+    Append<uint8_t>(block, 15);
+}
+
+const char kSmallTextFont[] =
+    "info face=\"Small\" size=16 bold=1 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=1,2,3,4 spacing=1,1 outline=0\n"
+    "common lineHeight=18 base=14 scaleW=256 scaleH=128 pages=1 packed=0 alphaChnl=1 redChnl=0 greenChnl=0 blueChnl=0\n"
+    "page id=0 file=\"small_0.png\"\n"
+    "chars count=2\n"
+    "char id=65 x=0 y=0 width=10 height=12 xoffset=-1 yoffset=2 xadvance=9 page=0 chnl=15\n"
+    "char id=86 x=12 y=0 width=10 height=12 xoffset=-1 yoffset=2 xadvance=8 page=0 chnl=15\n"
+    "kernings count=2\n"
+    "kerning first=65 second=86 amount=-2\n"
+    "kerning first=86 second=65 amount=-1\n";
+
+/// @brief kSmallTextFont と同じ内容のバイナリ形式(バージョン3)
+std::string CreateSmallBinaryFont() {
+    std::string bytes = "BMF";
+    Append<uint8_t>(bytes, 3);
+
+    std::string info;
+    Append<int16_t>(info, 16);
+    Append<uint8_t>(info, 0x80 | 0x40 | 0x10);
+    Append<uint8_t>(info, 0);
+    Append<uint16_t>(info, 100);
+    Append<uint8_t>(info, 1);
+    for (uint8_t padding : { 1, 2, 3, 4 }) {
+        Append<uint8_t>(info, padding);
+    }
+    Append<uint8_t>(info, 1);
+    Append<uint8_t>(info, 1);
+    Append<uint8_t>(info, 0);
+    info += std::string("Small") + '\0';
+    AppendBlock(bytes, 1, info);
+
+    std::string common;
+    for (uint16_t value : { 18, 14, 256, 128, 1 }) {
+        Append<uint16_t>(common, value);
+    }
+    for (uint8_t value : { 0, 1, 0, 0, 0 }) {
+        Append<uint8_t>(common, value);
+    }
+    AppendBlock(bytes, 2, common);
+
+    AppendBlock(bytes, 3, std::string("small_0.png") + '\0');
+
+    std::string chars;
+    AppendChar(chars, 65, 0, 9);
+    AppendChar(chars, 86, 12, 8);
+    AppendBlock(bytes, 4, chars);
+
+    std::string kernings;
+    Append<uint32_t>(kernings, 65);
+    Append<uint32_t>(kernings, 86);
+    Append<int16_t>(kernings, -2);
+    Append<uint32_t>(kernings, 86);
+    Append<uint32_t>(kernings, 65);
+    Append<int16_t>(kernings, -1);
+    AppendBlock(bytes, 5, kernings);
+    return bytes;
+}
+
+} // namespace
+
+TEST(FontLoader, BinaryFixtureMatchesTextFont) {
+    // Tests/Data/test_binary.fnt は Resources/Font/test.fnt をバイナリ形式(バージョン3)で書き出したもの
+    const std::string text = ReadFile("Resources/Font/test.fnt");
+    const std::string binary = ReadFile("Tests/Data/test_binary.fnt");
+    ASSERT_TRUE(!text.empty() && !binary.empty());
+    const FontData textFont = ParseFNT(text);
+    const FontData binaryFont = ParseFNT(binary);
+    EXPECT_TRUE(textFont.chars.GetCount() > 0);
+    EXPECT_EQ(textFont.chars.GetCount(), binaryFont.chars.GetCount());
+    EXPECT_TRUE(textFont == binaryFont);
+}
+
+TEST(FontLoader, BinaryKerningsMatchTextFont) {
+    const FontData textFont = ParseFNT(kSmallTextFont);
+    const FontData binaryFont = ParseFNT(CreateSmallBinaryFont());
+    EXPECT_TRUE(textFont == binaryFont);
+    EXPECT_EQ(-2.0f, binaryFont.GetKerning(65, 86));
+    EXPECT_EQ(-1.0f, binaryFont.GetKerning(86, 65));
+    EXPECT_EQ(0.0f, binaryFont.GetKerning(65, 65));
+}
+
+TEST(FontLoader, TruncatedBinaryFontThrows) {
+    const std::string binary = CreateSmallBinaryFont();
+    bool isThrown = false;
+    try {
+        ParseFNT(std::string_view(binary).substr(0, binary.size() - 3));
+    } catch (const std::runtime_error &) {
+        isThrown = true;
+    }
+    EXPECT_TRUE(isThrown);
+}
+
+TEST(FontLoader, StaleCookedFontIsNotUsed) {
+    TempDirectory directory;
+    const std::string fntPath = directory / "small.fnt";
+    WriteFile(fntPath, kSmallTextFont);
+    const FontData first = LoadFNT(fntPath.c_str());
+    EXPECT_TRUE(std::filesystem::exists(fntPath + kCookedFontExtension));
+    EXPECT_EQ(9.0f, first.FindChar(65)->xAdvance);
+
+    // 元のファイルが変わったら変換済みファイルではなく元のファイルを読み直す
+    std::string changed = kSmallTextFont;
+    changed.replace(changed.find("xadvance=9"), 10, "xadvance=7");
+    WriteFile(fntPath, changed);
+    const FontData second = LoadFNT(fntPath.c_str());
+    EXPECT_EQ(7.0f, second.FindChar(65)->xAdvance);
+
+    // 元のファイルが無ければ変換済みファイルだけで読める
+    std::filesystem::remove(fntPath);
+    const FontData cookedOnly = LoadFNT(fntPath.c_str());
+    EXPECT_TRUE(cookedOnly == second);
+}
\ No newline at end of file
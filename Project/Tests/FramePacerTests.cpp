@@ -0,0 +1,134 @@
+#include <chrono>
+#include <FramePacer.h>
+#include "TestFramework.h"
+
+using MyStd::FramePacer;
+using Clock = FramePacer::Clock;
+
+namespace {
+
+/// @brief 実際の時間を使わずに FramePacer を動かす時計。
+/// 現在時刻を読むたびに kTick だけ進み(空回りの待ちが終わるように)、眠ると眠った時間と寝過ごした時間だけ進む
+class FakeClock {
+public:
+    static constexpr Clock::duration kTick = std::chrono::microseconds(1);
+
+    /// @brief pacer の時刻と眠る関数をこの時計に差し替える
+    /// @param oversleep 眠るたびに余分に進める時間
+    void Attach(FramePacer &pacer, Clock::duration oversleep = Clock::duration::zero()) {
+        pacer.SetNowFunction([this]() {
+            now_ += kTick;
+            return now_;
+        });
+        pacer.SetSleepFunction([this, oversleep](Clock::duration duration) {
+            now_ += duration + oversleep;
+            sleptTime_ += duration + oversleep;
+            ++sleepCount_;
+        });
+    }
+
+    /// @brief 眠らずに時刻を進める(フレームの処理に掛かった時間や、他のプロセスに止められた時間)
+    void Advance(Clock::duration duration) { now_ += duration; }
+
+    Clock::time_point Now() const { return now_; }
+    Clock::duration GetSleptTime() const { return sleptTime_; }
+    int GetSleepCount() const { return sleepCount_; }
+
+private:
+    Clock::time_point now_;
+    Clock::duration sleptTime_ = Clock::duration::zero();
+    int sleepCount_ = 0;
+};
+
+double ToSeconds(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+TEST(FramePacer, KeepsIntervalWithLowJitter) {
+    FramePacer pacer;
+    FakeClock clock;
+    clock.Attach(pacer);
+    pacer.SetFrameRate(240.0);
+    const int frameCount = 120;
+    pacer.WaitForNextFrame();
+    const auto start = clock.Now();
+    for (int i = 0; i < frameCount; ++i) {
+        // フレームの処理に 1ms 掛かる
+        clock.Advance(std::chrono::milliseconds(1));
+        pacer.WaitForNextFrame();
+    }
+    const double elapsed = ToSeconds(clock.Now() - start);
+    // 予定より早く進むことは無く、予定時刻を基準に進むので誤差も積み重ならない
+    EXPECT_TRUE(elapsed >= frameCount / 240.0);
+    EXPECT_TRUE(elapsed < frameCount / 240.0 + 0.0001);
+    const auto stats = pacer.GetStats();
+    EXPECT_EQ(size_t(frameCount), stats.sampleCount);
+    // 空回りで予定時刻ちょうどまで待つので、ずれは時刻を読む間隔程度
+    EXPECT_TRUE(stats.max < 0.01);
+    EXPECT_TRUE(stats.average >= 0.0);
+}
+
+TEST(FramePacer, SleepsInsteadOfSpinning) {
+    // 寝過ごさない環境では、空回りで待つ時間は下限まで縮み、待ち時間の大半を眠る
+    FramePacer pacer;
+    FakeClock clock;
+    clock.Attach(pacer);
+    pacer.SetFrameRate(120.0);
+    pacer.WaitForNextFrame();
+    const auto start = clock.Now();
+    for (int i = 0; i < 60; ++i) {
+        pacer.WaitForNextFrame();
+    }
+    const double wall = ToSeconds(clock.Now() - start);
+    EXPECT_EQ(60, clock.GetSleepCount());
+    EXPECT_TRUE(ToSeconds(clock.GetSleptTime()) > wall * 0.9);
+    EXPECT_NEAR(0.2, pacer.GetStats().spinMargin, 1e-9);
+}
+
+TEST(FramePacer, SpinMarginFollowsOversleep) {
+    // 毎回 2ms 寝過ごす環境では、空回りで待つ時間が寝過ごしの分まで伸び、ずれは無くなる
+    FramePacer pacer;
+    FakeClock clock;
+    clock.Attach(pacer, std::chrono::milliseconds(2));
+    pacer.SetFrameRate(100.0);
+    pacer.WaitForNextFrame();
+    for (int i = 0; i < 60; ++i) {
+        pacer.WaitForNextFrame();
+    }
+    const auto stats = pacer.GetStats();
+    EXPECT_TRUE(stats.spinMargin >= 2.0);
+    EXPECT_TRUE(stats.spinMargin <= 4.0);
+    EXPECT_TRUE(stats.p50 < 0.01);
+}
+
+TEST(FramePacer, ResyncsAfterHitchWithoutBurst) {
+    FramePacer pacer;
+    FakeClock clock;
+    clock.Attach(pacer);
+    pacer.SetFrameRate(100.0);
+    pacer.WaitForNextFrame();
+    pacer.WaitForNextFrame();
+    // 3フレーム分止まった後は、遅れを取り戻すために待たずに続けて進むことはしない
+    clock.Advance(std::chrono::milliseconds(30));
+    pacer.WaitForNextFrame();
+    const auto start = clock.Now();
+    pacer.WaitForNextFrame();
+    const double interval = ToSeconds(clock.Now() - start);
+    EXPECT_NEAR(0.01, interval, 0.0001);
+}
+
+TEST(FramePacer, ZeroFrameRateDoesNotWait) {
+    FramePacer pacer;
+    FakeClock clock;
+    clock.Attach(pacer);
+    pacer.SetFrameRate(0.0);
+    const auto start = clock.Now();
+    for (int i = 0; i < 1000; ++i) {
+        pacer.WaitForNextFrame();
+    }
+    EXPECT_EQ(0, clock.GetSleepCount());
+    // 時刻を読む分しか進まない
+    EXPECT_TRUE(clock.Now() - start <= FakeClock::kTick * 2000);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <filesystem>
+#include <string>
+#include "TestFramework.h"
+#include "Common/FrameStatistics.h"
+#include "Common/JsoncLoader.h"
+#include "Common/Profiler.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テスト用の一時フォルダ。終了時に消す
+class TempDirectory {
+public:
+    TempDirectory() {
+        path_ = std::filesystem::temp_directory_path() / "KashipanEngineFrameStatisticsTests";
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string GetPath() const {
+        return path_.string();
+    }
+    std::string operator/(const std::string &name) const {
+        return (path_ / name).string();
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+} // namespace
+
+TEST(FrameStatistics, HitchReportIsWrittenBySaveQueue) {
+    TempDirectory directory;
+    InitializeFrameStatistics(directory.GetPath());
+    Profiler::RegisterThread("Main");
+    GetFrameTimeStats().Reset();
+    const FrameAllocationSample allocation;
+    for (int i = 0; i < 80; ++i) {
+        {
+            PROFILE_SCOPE("FrameStatisticsTests.Frame");
+        }
+        Profiler::EndFrame();
+        EXPECT_FALSE(UpdateFrameStatistics(0.016, allocation));
+    }
+    ASSERT_TRUE(UpdateFrameStatistics(0.2, allocation));
+
+    // 報告もトレースも保存用のスレッドで書き出すので、呼び出した時点ではまだ書き込まれていない
+    const std::string reportPath = directory / "hitch_81.json";
+    const std::string tracePath = directory / "hitch_81_trace.json";
+    EXPECT_FALSE(std::filesystem::exists(tracePath));
+    EXPECT_FALSE(std::filesystem::exists(reportPath));
+
+    FlushJsoncSaves();
+    const Json report = LoadJsoncText(reportPath);
+    ASSERT_TRUE(report.is_object());
+    EXPECT_EQ(uint64_t(81), report.value("frame", uint64_t(0)));
+    EXPECT_EQ(std::string("hitch_81_trace.json"), report.value("trace", std::string()));
+    EXPECT_EQ(size_t(60), report["recentFrames"].size());
+    const Json trace = LoadJsoncText(tracePath);
+    ASSERT_TRUE(trace.is_object());
+    EXPECT_TRUE(trace["traceEvents"].is_array() && !trace["traceEvents"].empty());
+}
\ No newline at end of file
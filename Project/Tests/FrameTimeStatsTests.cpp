@@ -0,0 +1,90 @@
+#include <FrameTimeStats.h>
+#include "TestFramework.h"
+
+using MyStd::FrameTimeStats;
+
+namespace {
+
+/// @brief 同じ時間のフレームを続けて追加する。ヒッチと判定された数を返す
+int AddFrames(FrameTimeStats &stats, double milliseconds, int count) {
+    int hitchCount = 0;
+    for (int i = 0; i < count; ++i) {
+        hitchCount += stats.AddFrame(milliseconds) ? 1 : 0;
+    }
+    return hitchCount;
+}
+
+} // namespace
+
+TEST(FrameTimeStats, FirstHitchIsNotBlockedByCooldown) {
+    // まだヒッチが無ければ、待つフレーム数に関係なく最初のヒッチを検出する
+    FrameTimeStats stats(240);
+    stats.SetWarmupFrames(5);
+    stats.SetCooldownFrames(60);
+    EXPECT_EQ(0, AddFrames(stats, 16.0, 10));
+    EXPECT_TRUE(stats.AddFrame(100.0));
+    EXPECT_EQ(uint64_t(1), stats.GetSummary().hitchCount);
+}
+
+TEST(FrameTimeStats, NoHitchDuringWarmup) {
+    FrameTimeStats stats(240);
+    stats.SetWarmupFrames(60);
+    EXPECT_EQ(0, AddFrames(stats, 16.0, 30));
+    EXPECT_FALSE(stats.AddFrame(100.0));
+    EXPECT_EQ(0, AddFrames(stats, 16.0, 29));
+    // 60 フレーム目からは検出する
+    EXPECT_TRUE(stats.AddFrame(100.0));
+}
+
+TEST(FrameTimeStats, CooldownSuppressesConsecutiveHitches) {
+    FrameTimeStats stats(240);
+    stats.SetWarmupFrames(10);
+    stats.SetCooldownFrames(20);
+    AddFrames(stats, 16.0, 10);
+    EXPECT_TRUE(stats.AddFrame(100.0));
+    // 待つフレーム数の間は検出しない
+    EXPECT_EQ(0, AddFrames(stats, 16.0, 19));
+    EXPECT_FALSE(stats.AddFrame(100.0));
+    EXPECT_TRUE(stats.AddFrame(100.0));
+    EXPECT_EQ(uint64_t(2), stats.GetSummary().hitchCount);
+}
+
+TEST(FrameTimeStats, ResetForgetsPreviousHitches) {
+    FrameTimeStats stats(240);
+    stats.SetWarmupFrames(5);
+    stats.SetCooldownFrames(1000);
+    AddFrames(stats, 16.0, 5);
+    EXPECT_TRUE(stats.AddFrame(100.0));
+    stats.Reset();
+    EXPECT_EQ(uint64_t(0), stats.GetFrameCount());
+    EXPECT_EQ(uint64_t(0), stats.GetSummary().hitchCount);
+    // 待つフレーム数が残っていても、リセット後の最初のヒッチは検出する
+    AddFrames(stats, 16.0, 5);
+    EXPECT_TRUE(stats.AddFrame(100.0));
+}
+
+TEST(FrameTimeStats, ShortFramesAreNotHitches) {
+    // 中央値の何倍でも、最小の時間より短ければヒッチにしない
+    FrameTimeStats stats(240);
+    stats.SetWarmupFrames(5);
+    stats.SetHitchThreshold(3.0, 8.0);
+    AddFrames(stats, 1.0, 10);
+    EXPECT_FALSE(stats.AddFrame(7.0));
+    EXPECT_TRUE(stats.AddFrame(9.0));
+}
+
+TEST(FrameTimeStats, SummaryUsesRecentFrames) {
+    FrameTimeStats stats(100);
+    // 古いフレームは統計から外れる
+    AddFrames(stats, 50.0, 100);
+    for (int i = 1; i <= 100; ++i) {
+        stats.AddFrame(static_cast<double>(i));
+    }
+    const auto summary = stats.GetSummary();
+    EXPECT_EQ(size_t(100), summary.sampleCount);
+    EXPECT_NEAR(50.5, summary.average, 1e-9);
+    EXPECT_NEAR(51.0, summary.p50, 1e-9);
+    EXPECT_NEAR(95.0, summary.p95, 1e-9);
+    EXPECT_NEAR(99.0, summary.p99, 1e-9);
+    EXPECT_NEAR(100.0, summary.max, 1e-9);
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "TestFramework.h"
+#include "Font/GlyphAtlas.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+const char *const kFontFilePath = "Resources/Font/SourceCodePro-Regular.ttf";
+
+/// @brief 区画の追い出しが起きる小さいアトラス
+GlyphAtlasDesc CreateSmallAtlasDesc() {
+    GlyphAtlasDesc desc;
+    desc.atlasSize = 256;
+    desc.regionSize = 128;
+    desc.sdfPixelHeight = 32.0f;
+    desc.sdfPadding = 4;
+    desc.workerCount = 2;
+    return desc;
+}
+
+/// @brief ASCII・ラテン文字・ギリシャ文字・キリル文字の順に、フォントにある文字を count 文字作る
+std::vector<int> CreateCodePoints(const GlyphAtlas &atlas, int fontId, size_t count) {
+    std::vector<int> codePoints;
+    for (int codePoint = 0x21; codePoint <= 0x4FF && codePoints.size() < count; ++codePoint) {
+        if (atlas.HasGlyph(fontId, codePoint)) {
+            codePoints.push_back(codePoint);
+        }
+    }
+    return codePoints;
+}
+
+/// @brief 文字をすべて要求して、入り終わるまで待つ
+void RequestGlyphs(GlyphAtlas &atlas, int fontId, const std::vector<int> &codePoints) {
+    for (const int codePoint : codePoints) {
+        atlas.FindGlyph(fontId, codePoint);
+    }
+    atlas.WaitIdle();
+}
+
+/// @brief アトラスに入っている文字の画素がラスタライズした結果と同じで、文字の四角形が重なっていないかどうか
+/// @param checkedCount 確かめた文字数の格納先
+bool IsAtlasConsistent(GlyphAtlas &atlas, int fontId, const std::vector<int> &codePoints, size_t &checkedCount) {
+    const auto &pixels = atlas.GetPixels();
+    const uint32_t atlasSize = atlas.GetDesc().atlasSize;
+    std::vector<GlyphAtlas::Glyph> glyphs;
+    bool isConsistent = true;
+    for (const int codePoint : codePoints) {
+        const GlyphAtlas::Glyph *glyph = atlas.FindGlyph(fontId, codePoint);
+        if (glyph == nullptr || glyph->width == 0) {
+            continue;
+        }
+        glyphs.push_back(*glyph);
+        int width = 0;
+        int height = 0;
+        const std::vector<uint8_t> bitmap = atlas.RasterizeGlyph(fontId, codePoint, width, height);
+        bool isMatched = width == glyph->width && height == glyph->height &&
+            static_cast<uint32_t>(glyph->x + glyph->width) <= atlasSize &&
+            static_cast<uint32_t>(glyph->y + glyph->height) <= atlasSize;
+        for (int row = 0; isMatched && row < height; ++row) {
+            isMatched = std::memcmp(&pixels[(static_cast<size_t>(glyph->y) + row) * atlasSize + glyph->x],
+                &bitmap[static_cast<size_t>(row) * width], static_cast<size_t>(width)) == 0;
+        }
+        isConsistent = isConsistent && isMatched;
+    }
+    checkedCount = glyphs.size();
+
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const auto &a = glyphs[i];
+        for (size_t j = i + 1; j < glyphs.size(); ++j) {
+            const auto &b = glyphs[j];
+            if (a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height) {
+                isConsistent = false;
+            }
+        }
+    }
+    return isConsistent;
+}
+
+} // namespace
+
+TEST(GlyphAtlas, PixelsMatchRasterizedGlyphs) {
+    GlyphAtlas atlas(CreateSmallAtlasDesc());
+    const int fontId = atlas.LoadFont(kFontFilePath);
+    ASSERT_TRUE(fontId >= 0);
+    EXPECT_TRUE(atlas.HasGlyph(fontId, 'A'));
+    EXPECT_FALSE(atlas.HasGlyph(fontId, 0x3042));
+
+    const std::vector<int> codePoints = CreateCodePoints(atlas, fontId, 16);
+    ASSERT_TRUE(codePoints.size() == 16);
+    atlas.BeginFrame();
+    RequestGlyphs(atlas, fontId, codePoints);
+    size_t checkedCount = 0;
+    EXPECT_TRUE(IsAtlasConsistent(atlas, fontId, codePoints, checkedCount));
+    EXPECT_EQ(size_t(16), checkedCount);
+    EXPECT_EQ(uint64_t(0), atlas.GetStats().evictedRegionCount);
+}
+
+TEST(GlyphAtlas, EvictionKeepsGlyphsInUse) {
+    GlyphAtlas atlas(CreateSmallAtlasDesc());
+    const int fontId = atlas.LoadFont(kFontFilePath);
+    ASSERT_TRUE(fontId >= 0);
+
+    // 毎フレーム使い続ける文字と、フレームごとに入れ替わる文字
+    const size_t kKeepGlyphCount = 8;
+    const size_t kStreamGlyphsPerFrame = 6;
+    const size_t kFrameCount = 40;
+    const std::vector<int> codePoints = CreateCodePoints(atlas, fontId, kKeepGlyphCount + kStreamGlyphsPerFrame * kFrameCount);
+    ASSERT_TRUE(codePoints.size() == kKeepGlyphCount + kStreamGlyphsPerFrame * kFrameCount);
+    const std::vector<int> keepCodePoints(codePoints.begin(), codePoints.begin() + kKeepGlyphCount);
+    atlas.BeginFrame();
+    RequestGlyphs(atlas, fontId, keepCodePoints);
+
+    size_t keepMissCount = 0;
+    size_t streamMissCount = 0;
+    for (size_t frame = 0; frame < kFrameCount; ++frame) {
+        atlas.BeginFrame();
+        for (const int codePoint : keepCodePoints) {
+            keepMissCount += atlas.FindGlyph(fontId, codePoint) ? 0 : 1;
+        }
+        const auto begin = codePoints.begin() + kKeepGlyphCount + frame * kStreamGlyphsPerFrame;
+        const std::vector<int> frameCodePoints(begin, begin + kStreamGlyphsPerFrame);
+        RequestGlyphs(atlas, fontId, frameCodePoints);
+        for (const int codePoint : frameCodePoints) {
+            streamMissCount += atlas.FindGlyph(fontId, codePoint) ? 0 : 1;
+        }
+    }
+    const GlyphAtlas::Stats stats = atlas.GetStats();
+    EXPECT_EQ(size_t(0), keepMissCount);
+    EXPECT_EQ(size_t(0), streamMissCount);
+    EXPECT_TRUE(stats.evictedRegionCount > 0);
+    EXPECT_EQ(uint64_t(0), stats.failedCount);
+
+    // 区画を使い回した後も画素が正しい(FindGlyph は無い文字を要求するので、追い出しの確認の後で見る)
+    size_t checkedCount = 0;
+    EXPECT_TRUE(IsAtlasConsistent(atlas, fontId, codePoints, checkedCount));
+    EXPECT_TRUE(checkedCount >= kKeepGlyphCount);
+
+    // 追い出された文字は要求すれば入れ直される
+    atlas.BeginFrame();
+    const int evictedCodePoint = codePoints[kKeepGlyphCount];
+    RequestGlyphs(atlas, fontId, { evictedCodePoint });
+    EXPECT_TRUE(atlas.FindGlyph(fontId, evictedCodePoint) != nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <vector>
+#include <InputRecording.h>
+#include "TestFramework.h"
+#include "Common/Random.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief キーやマウス、コントローラーが少しずつ変わる記録を作る
+MyStd::InputRecording CreateRecording(uint32_t frameCount) {
+    MyStd::InputRecording recording;
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        MyStd::InputSnapshot snapshot;
+        snapshot.deltaTime = 1.0f / 60.0f + static_cast<float>(i % 3) * 0.001f;
+        snapshot.keys[(i / 10) % 256] = 0x80;
+        snapshot.mouseX = static_cast<int32_t>(i * 3);
+        snapshot.mouseY = -static_cast<int32_t>(i);
+        snapshot.mouseWheel = (i % 20 == 0) ? 120 : 0;
+        snapshot.pads[0].isConnected = true;
+        snapshot.pads[0].thumbLX = static_cast<int16_t>(i * 100);
+        recording.AddFrame(snapshot);
+    }
+    return recording;
+}
+
+/// @brief 乱数を続けて取り出す
+std::vector<int> DrawRandomValues(size_t count) {
+    std::vector<int> values;
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(GetRandomInt(0, 1000000));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(InputRecording, FramesAndSeedRoundTrip) {
+    MyStd::InputRecording recording = CreateRecording(300);
+    recording.SetSeed(0xDEADBEEFu);
+    MyStd::InputRecording restored;
+    ASSERT_TRUE(restored.Deserialize(recording.Serialize()));
+    EXPECT_TRUE(restored.HasSeed());
+    EXPECT_EQ(0xDEADBEEFu, restored.GetSeed());
+    ASSERT_TRUE(restored.GetFrameCount() == recording.GetFrameCount());
+    for (size_t i = 0; i < recording.GetFrameCount(); ++i) {
+        EXPECT_TRUE(restored.GetFrame(i) == recording.GetFrame(i));
+    }
+}
+
+TEST(InputRecording, ReplayRestoresRandomSequence) {
+    // 記録の開始: 新しいシード値で初期化し直して記録する(Input::StartRecording と同じ手順)
+    InitializeRandom();
+    MyStd::InputRecording recording = CreateRecording(10);
+    recording.SetSeed(GetRandomSeed());
+    const std::vector<int> recorded = DrawRandomValues(64);
+    const std::vector<uint8_t> bytes = recording.Serialize();
+
+    // 記録の後に乱数が進んでいても、再生の開始で記録時の乱数列に戻る
+    InitializeRandom();
+    DrawRandomValues(17);
+    MyStd::InputRecording replay;
+    ASSERT_TRUE(replay.Deserialize(bytes));
+    ASSERT_TRUE(replay.HasSeed());
+    SetRandomSeed(replay.GetSeed());
+    EXPECT_TRUE(DrawRandomValues(64) == recorded);
+}
+
+TEST(InputRecording, VersionOneHasNoSeed) {
+    // シード値を保存する前の形式(ヘッダにシード値が無い)も読み込める
+    const std::vector<uint8_t> bytes = {
+        'K', 'I', 'R', 'C',
+        1, 0,
+        static_cast<uint8_t>(MyStd::InputRecording::kSnapshotSize & 0xFF),
+        static_cast<uint8_t>(MyStd::InputRecording::kSnapshotSize >> 8),
+        0, 0, 0, 0,
+    };
+    MyStd::InputRecording recording;
+    ASSERT_TRUE(recording.Deserialize(bytes));
+    EXPECT_FALSE(recording.HasSeed());
+    EXPECT_EQ(size_t(0), recording.GetFrameCount());
+}
+
+TEST(InputRecording, CorruptDataIsRejected) {
+    MyStd::InputRecording recording = CreateRecording(50);
+    recording.SetSeed(42);
+    std::vector<uint8_t> bytes = recording.Serialize();
+    MyStd::InputRecording restored;
+    // 途中で切れている
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + bytes.size() / 2);
+    EXPECT_FALSE(restored.Deserialize(truncated));
+    EXPECT_EQ(size_t(0), restored.GetFrameCount());
+    EXPECT_FALSE(restored.HasSeed());
+    // 未対応のバージョン
+    bytes[4] = 99;
+    EXPECT_FALSE(restored.Deserialize(bytes));
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "TestFramework.h"
+#include "Common/JsoncLoader.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 以前の GetNestedValue。途中の値をコピーし、インデックスを std::stoi で読む
+std::optional<Json> GetNestedValueReference(const Json &json, const std::string &path) {
+    try {
+        Json current = json;
+        std::stringstream ss(path);
+        std::string segment;
+        while (std::getline(ss, segment, '.')) {
+            size_t bracketStart = segment.find('[');
+            if (bracketStart != std::string::npos) {
+                std::string arrayName = segment.substr(0, bracketStart);
+                size_t bracketEnd = segment.find(']', bracketStart);
+                if (bracketEnd == std::string::npos) {
+                    return std::nullopt;
+                }
+                std::string indexStr = segment.substr(bracketStart + 1, bracketEnd - bracketStart - 1);
+                int index = std::stoi(indexStr);
+                if (!current.contains(arrayName) || !current[arrayName].is_array() ||
+                    index < 0 || index >= static_cast<int>(current[arrayName].size())) {
+                    return std::nullopt;
+                }
+                current = current[arrayName][index];
+            } else {
+                if (!current.contains(segment)) {
+                    return std::nullopt;
+                }
+                current = current[segment];
+            }
+        }
+        return current;
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+Json MakeDocument() {
+    return Json::parse(R"({
+        "name": "root",
+        "": { "empty": 1 },
+        "object": {
+            "array": [ { "value": 10 }, { "value": 20 }, [ 5, 6 ] ],
+            "nested": { "deep": { "leaf": true } }
+        },
+        "list": [ 1, 2, 3 ],
+        "number": 42
+    })");
+}
+
+/// @brief 文字列のパス・FindNestedValue・JsonPath の結果が以前の実装と一致するか
+void ExpectParity(const Json &json, const std::string &path) {
+    const std::optional<Json> expected = GetNestedValueReference(json, path);
+    const std::optional<Json> actual = GetNestedValue(json, path);
+    const Json *found = FindNestedValue(json, path);
+    const JsonPath compiled(path);
+    const Json *compiledFound = compiled.Find(json);
+    if (expected.has_value() != actual.has_value() ||
+        (expected && *expected != *actual) ||
+        expected.has_value() != (found != nullptr) ||
+        (found && *found != *expected) ||
+        expected.has_value() != (compiledFound != nullptr) ||
+        (compiledFound && *compiledFound != *expected)) {
+        Test::ReportFailure(__FILE__, __LINE__, "path \"" + path + "\" differs from the std::stoi implementation");
+    }
+}
+
+} // namespace
+
+TEST(JsonPath, MissingAndMalformedPathsMatchPreviousImplementation) {
+    const Json json = MakeDocument();
+    const std::vector<std::string> paths = {
+        "", "name", "number", "missing", "object", "object.nested.deep.leaf", "object.nested.missing",
+        "object.array[0].value", "object.array[1]", "object.array[3]", "object.array[-1]",
+        "object.array[abc]", "object.array[]", "object.array[0", "object.array0]", "list[2]",
+        ".name", "name.", "object..nested", "..", ".", "[0]", "name[0]", "number.value",
+        // std::stoi と同じく、空白・符号・数字の後ろの文字を許す
+        "list[ 1]", "list[\t2]", "list[+1]", "list[-0]", "list[1x]", "list[0x1]", "list[1 ]",
+        "list[+-1]", "list[- 1]", "list[ ]", "list[+]",
+        // int に収まらない値は失敗
+        "list[2147483647]", "list[2147483648]", "list[99999999999999999999]",
+        // "]" の後ろの文字は無視する
+        "object.array[0]x", "object.array[0]x.value", "list[1]]",
+        ".empty", "[1]",
+    };
+    for (const auto &path : paths) {
+        ExpectParity(json, path);
+    }
+}
+
+TEST(JsonPath, ChainedIndicesResolve) {
+    // 以前は最初のインデックスより後ろを無視していたが、続けて書いたインデックスも辿る
+    const Json json = MakeDocument();
+    const Json *value = FindNestedValue(json, "object.array[2][1]");
+    ASSERT_TRUE(value != nullptr);
+    EXPECT_EQ(6, value->get<int>());
+    EXPECT_TRUE(FindNestedValue(json, "object.array[2][2]") == nullptr);
+    EXPECT_TRUE(FindNestedValue(json, "object.array[2][ 0]")->get<int>() == 5);
+    EXPECT_TRUE(JsonPath("object.array[2][1]").Find(json) == value);
+}
+
+TEST(JsonPath, CompiledPathCanBeCopiedAndWritesThrough) {
+    Json json = MakeDocument();
+    JsonPath path("object.array[1].value");
+    ASSERT_TRUE(path.IsValid());
+    const JsonPath copy = path;
+    path = JsonPath("number");
+    Json *value = copy.Find(json);
+    ASSERT_TRUE(value != nullptr);
+    *value = 99;
+    EXPECT_EQ(99, json["object"]["array"][1]["value"].get<int>());
+    EXPECT_EQ(42, path.Find(json)->get<int>());
+    EXPECT_FALSE(JsonPath("list[abc]").IsValid());
+    EXPECT_TRUE(JsonPath("list[abc]").Find(json) == nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestFramework.h"
+#include "Common/JsoncLoader.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief テスト用の一時フォルダ。終了時に消す
+class TempDirectory {
+public:
+    TempDirectory() {
+        path_ = std::filesystem::temp_directory_path() / "KashipanEngineJsoncSaveQueueTests";
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string operator/(const std::string &name) const {
+        return (path_ / name).string();
+    }
+    /// @brief 保存の一時ファイルが残っているかどうか
+    bool HasTemporaryFile() const {
+        for (const auto &entry : std::filesystem::directory_iterator(path_)) {
+            if (entry.path().extension() == ".tmp") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+int ReadValue(const std::string &filepath) {
+    const Json json = LoadJsoncText(filepath);
+    return json.is_object() ? json.value("value", -1) : -1;
+}
+
+} // namespace
+
+TEST(JsoncSaveQueue, SavesToSamePathAreCoalesced) {
+    TempDirectory directory;
+    const std::string path = directory / "coalesce.json";
+    std::vector<std::shared_future<bool>> futures;
+    for (int i = 0; i < 50; ++i) {
+        futures.push_back(SaveJsoncAsync(Json{ { "value", i } }, path));
+    }
+    // 最初の保存の完了を待った時点で、もう最後の内容が書かれている(まとめて1回で書いている)
+    ASSERT_TRUE(futures.front().get());
+    EXPECT_EQ(49, ReadValue(path));
+    for (const auto &future : futures) {
+        EXPECT_TRUE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        EXPECT_TRUE(future.get());
+    }
+}
+
+TEST(JsoncSaveQueue, CallerCanModifySourceAfterSave) {
+    TempDirectory directory;
+    const std::string path = directory / "copy.json";
+    Json json{ { "value", 1 } };
+    auto future = SaveJsoncAsync(json, path);
+    json["value"] = 2;
+    FlushJsoncSaves();
+    EXPECT_TRUE(future.get());
+    EXPECT_EQ(1, ReadValue(path));
+}
+
+TEST(JsoncSaveQueue, FlushWritesBeforeCoalesceWindow) {
+    TempDirectory directory;
+    const std::string pathA = directory / "a.json";
+    const std::string pathB = directory / "b.json";
+    const auto start = std::chrono::steady_clock::now();
+    auto futureA = SaveJsoncAsync(Json{ { "value", 1 } }, pathA);
+    auto futureB = SaveJsoncAsync(Json{ { "value", 2 } }, pathB);
+    FlushJsoncSaves();
+    // Flush は待ち時間(100ms)を待たずに書く
+    EXPECT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100));
+    EXPECT_TRUE(futureA.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    EXPECT_TRUE(futureB.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    EXPECT_EQ(1, ReadValue(pathA));
+    EXPECT_EQ(2, ReadValue(pathB));
+}
+
+TEST(JsoncSaveQueue, FailedSaveReportsFalseAndDoesNotBlockOthers) {
+    TempDirectory directory;
+    const std::string badPath = directory / "missing/dir/file.json";
+    const std::string goodPath = directory / "good.json";
+    auto bad = SaveJsoncAsync(Json{ { "value", 1 } }, badPath);
+    auto good = SaveJsoncAsync(Json{ { "value", 2 } }, goodPath);
+    FlushJsoncSaves();
+    EXPECT_FALSE(bad.get());
+    EXPECT_TRUE(good.get());
+    EXPECT_EQ(2, ReadValue(goodPath));
+    EXPECT_FALSE(std::filesystem::exists(badPath));
+    EXPECT_FALSE(directory.HasTemporaryFile());
+}
+
+TEST(JsoncSaveQueue, SyncAndAsyncSavesToSamePathDoNotCollide) {
+    // 同じパスへの同期保存と非同期保存が重なっても、一時ファイルを取り合って失敗しない
+    TempDirectory directory;
+    const std::string path = directory / "shared.json";
+    std::vector<std::shared_future<bool>> futures;
+    std::vector<std::thread> threads;
+    std::atomic<int> failedCount = 0;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&path, &failedCount, t]() {
+            for (int i = 0; i < 20; ++i) {
+                failedCount += SaveJsonc(Json{ { "value", t * 100 + i } }, path) ? 0 : 1;
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(SaveJsoncAsync(Json{ { "value", i } }, path));
+        FlushJsoncSaves();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, failedCount.load());
+    for (const auto &future : futures) {
+        EXPECT_TRUE(future.get());
+    }
+    EXPECT_TRUE(ReadValue(path) >= 0);
+    EXPECT_FALSE(directory.HasTemporaryFile());
+}
+
+// 終了処理の後は待ち行列を使えないので、このテストは最後に置く
+TEST(JsoncSaveQueue, FinalizeWritesPendingSavesAndLaterSavesAreSynchronous) {
+    TempDirectory directory;
+    const std::string pendingPath = directory / "pending.json";
+    const std::string laterPath = directory / "later.json";
+    auto pending = SaveJsoncAsync(Json{ { "value", 3 } }, pendingPath);
+    FinalizeJsoncSaveQueue();
+    EXPECT_TRUE(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    EXPECT_TRUE(pending.get());
+    EXPECT_EQ(3, ReadValue(pendingPath));
+
+    auto later = SaveJsoncAsync(Json{ { "value", 4 } }, laterPath);
+    EXPECT_TRUE(later.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    EXPECT_TRUE(later.get());
+    EXPECT_EQ(4, ReadValue(laterPath));
+    // 2回目の終了処理・Flush は何もしない
+    FinalizeJsoncSaveQueue();
+    FlushJsoncSaves();
+}
\ No newline at end of file
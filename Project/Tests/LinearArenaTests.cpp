@@ -0,0 +1,113 @@
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+#include <LinearArena.h>
+#include "TestFramework.h"
+
+using MyStd::FrameArena;
+using MyStd::LinearArena;
+using MyStd::ScratchArena;
+using MyStd::ScratchScope;
+
+TEST(LinearArena, RewindReleasesOnlyLaterOverflow) {
+    LinearArena arena(64);
+    arena.Allocate(32);
+    // 容量を超えた分はヒープから確保する
+    arena.Allocate(128);
+    const size_t marker = arena.GetMarker();
+    const size_t overflowMarker = arena.GetOverflowMarker();
+    arena.Allocate(16);
+    arena.Allocate(256);
+    arena.Allocate(512);
+    EXPECT_EQ(size_t(3), arena.GetOverflowMarker());
+    arena.Rewind(marker, overflowMarker);
+    EXPECT_EQ(marker, arena.GetMarker());
+    EXPECT_EQ(size_t(1), arena.GetOverflowMarker());
+    arena.Reset();
+    EXPECT_EQ(size_t(0), arena.GetMarker());
+    EXPECT_EQ(size_t(0), arena.GetOverflowMarker());
+}
+
+TEST(LinearArena, NestedScratchScopesKeepOuterOverflowAlive) {
+    // 外側のスコープが何も切り出していない(位置 0 の)ときに、内側のスコープを抜けても外側の確保は残る
+    LinearArena &arena = ScratchArena::Get();
+    ASSERT_TRUE(arena.GetMarker() == 0 && arena.GetOverflowMarker() == 0);
+    {
+        ScratchScope outer;
+        auto *outerBlock = static_cast<unsigned char *>(outer.Allocate(ScratchArena::kDefaultCapacity * 2));
+        std::memset(outerBlock, 0x5A, ScratchArena::kDefaultCapacity * 2);
+        EXPECT_EQ(size_t(0), arena.GetMarker());
+        EXPECT_EQ(size_t(1), arena.GetOverflowMarker());
+        {
+            ScratchScope inner;
+            inner.Allocate(64);
+            inner.Allocate(ScratchArena::kDefaultCapacity * 2);
+            {
+                ScratchScope innermost;
+                innermost.Allocate(ScratchArena::kDefaultCapacity);
+                EXPECT_EQ(size_t(3), arena.GetOverflowMarker());
+            }
+            EXPECT_EQ(size_t(2), arena.GetOverflowMarker());
+            EXPECT_EQ(size_t(64), arena.GetMarker());
+        }
+        EXPECT_EQ(size_t(0), arena.GetMarker());
+        EXPECT_EQ(size_t(1), arena.GetOverflowMarker());
+        // 外側の領域は解放されていない
+        EXPECT_EQ(0x5A, outerBlock[0]);
+        EXPECT_EQ(0x5A, outerBlock[ScratchArena::kDefaultCapacity * 2 - 1]);
+    }
+    EXPECT_EQ(size_t(0), arena.GetMarker());
+    EXPECT_EQ(size_t(0), arena.GetOverflowMarker());
+}
+
+TEST(LinearArena, ScratchScopeWorksWithPmrContainers) {
+    ScratchScope scope;
+    std::pmr::vector<int> values(scope.GetResource());
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(999, values.back());
+    EXPECT_TRUE(ScratchArena::Get().GetMarker() > 0);
+}
+
+TEST(FrameArena, PreviousFrameStaysValidUntilNextSwap) {
+    FrameArena frameArena(1024);
+    int *first = frameArena.Allocate<int>(4);
+    first[0] = 42;
+    frameArena.EndFrame();
+    int *second = frameArena.Allocate<int>(4);
+    second[0] = 7;
+    // 前のフレームの領域はまだ使える
+    EXPECT_EQ(42, first[0]);
+    EXPECT_TRUE(static_cast<void *>(first) != static_cast<void *>(second));
+    frameArena.EndFrame();
+    // 2フレーム前の領域は空になって、最初から使い直す
+    EXPECT_EQ(size_t(0), frameArena.GetArena().GetUsed());
+    EXPECT_TRUE(static_cast<void *>(frameArena.Allocate<int>(4)) == static_cast<void *>(first));
+}
+
+TEST(FrameArena, ResetPmrVectorSwitchesResourceAndKeepsCapacity) {
+    FrameArena frameArena(64 * 1024);
+    std::pmr::vector<int> values;
+    for (int frame = 0; frame < 4; ++frame) {
+        MyStd::ResetPmrVector(values, frameArena.GetResource());
+        EXPECT_TRUE(values.empty());
+        EXPECT_TRUE(values.get_allocator().resource() == frameArena.GetResource());
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        // 同じフレームの中では領域を使い回す
+        const size_t used = frameArena.GetArena().GetUsed();
+        MyStd::ResetPmrVector(values, frameArena.GetResource());
+        EXPECT_EQ(used, frameArena.GetArena().GetUsed());
+        values.assign(100, frame);
+        frameArena.EndFrame();
+    }
+    // 前のフレームの容量を確保し直しているので、足りていれば伸ばさない
+    MyStd::ResetPmrVector(values, frameArena.GetResource());
+    EXPECT_TRUE(values.capacity() >= 100);
+    const size_t used = frameArena.GetArena().GetUsed();
+    values.assign(100, 0);
+    EXPECT_EQ(used, frameArena.GetArena().GetUsed());
+    EXPECT_EQ(size_t(0), frameArena.GetArena().GetOverflowCount());
+}
\ No newline at end of file
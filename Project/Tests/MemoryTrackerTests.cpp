@@ -0,0 +1,98 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestFramework.h"
+#include "TestLogs.h"
+#include "Common/MemoryTracker.h"
+#include "Common/Profiler.h"
+#include "Common/StringId.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief タグの統計の取得
+MemoryTracker::TagStats GetTagStats(MemoryTag tag) {
+    return MemoryTracker::GetStats()[static_cast<size_t>(tag)];
+}
+
+} // namespace
+
+TEST(MemoryTracker, TaggedAllocationsAreCounted) {
+    const auto before = GetTagStats(MemoryTag::kModel);
+    std::unique_ptr<char[]> block;
+    {
+        MEMORY_TAG_SCOPE(kModel);
+        block = std::make_unique<char[]>(4096);
+    }
+    const auto during = GetTagStats(MemoryTag::kModel);
+    EXPECT_EQ(before.liveBytes + 4096, during.liveBytes);
+    EXPECT_EQ(before.liveCount + 1, during.liveCount);
+    // 解放はタグのスコープの外でも、確保した時のタグから引かれる
+    block.reset();
+    EXPECT_EQ(before.liveBytes, GetTagStats(MemoryTag::kModel).liveBytes);
+}
+
+TEST(MemoryTracker, BudgetWarnsOnceUntilBackUnder) {
+    Test::ClearLogs();
+    MemoryTracker::SetBudget(MemoryTag::kFont, GetTagStats(MemoryTag::kFont).liveBytes + 1024);
+    std::unique_ptr<char[]> block;
+    {
+        MEMORY_TAG_SCOPE(kFont);
+        block = std::make_unique<char[]>(2048);
+    }
+    MemoryTracker::EndFrame();
+    MemoryTracker::EndFrame();
+    EXPECT_EQ(size_t(1), Test::GetLogCount(kLogLevelFlagWarning));
+    EXPECT_TRUE(GetTagStats(MemoryTag::kFont).liveBytes > GetTagStats(MemoryTag::kFont).budgetBytes);
+    // 予算を下回ってから再び超えると、また警告する
+    block.reset();
+    MemoryTracker::EndFrame();
+    {
+        MEMORY_TAG_SCOPE(kFont);
+        block = std::make_unique<char[]>(2048);
+    }
+    MemoryTracker::EndFrame();
+    EXPECT_EQ(size_t(2), Test::GetLogCount(kLogLevelFlagWarning));
+    block.reset();
+    MemoryTracker::SetBudget(MemoryTag::kFont, 0);
+}
+
+TEST(MemoryTracker, ReportLeaksFindsBlocksAllocatedAfterCheckStart) {
+    // エンジンと同じく、保持するログは対象外にする
+    MemoryTracker::SetLeakCheckIgnored(MemoryTag::kLog, true);
+    MemoryTracker::BeginLeakCheck();
+    std::unique_ptr<char[]> block;
+    {
+        MEMORY_TAG_SCOPE(kScene);
+        block = std::make_unique<char[]>(256);
+    }
+    Test::ClearLogs();
+    EXPECT_FALSE(MemoryTracker::ReportLeaks());
+    EXPECT_EQ(size_t(1), Test::GetLogCount(kLogLevelFlagWarning));
+    // 対象外にしたタグは数えない
+    MemoryTracker::SetLeakCheckIgnored(MemoryTag::kScene, true);
+    EXPECT_TRUE(MemoryTracker::ReportLeaks());
+    MemoryTracker::SetLeakCheckIgnored(MemoryTag::kScene, false);
+    block.reset();
+    EXPECT_TRUE(MemoryTracker::ReportLeaks());
+}
+
+TEST(MemoryTracker, ProcessLifetimeTablesAreNotLeaks) {
+    // 基準の後にプロファイラのスレッドのバッファや集計用の表、StringId の逆引き表が増えてもリークにしない
+    MemoryTracker::SetLeakCheckIgnored(MemoryTag::kLog, true);
+    MemoryTracker::BeginLeakCheck();
+    const size_t persistentBefore = GetTagStats(MemoryTag::kPersistent).liveCount;
+    std::thread thread([]() {
+        Profiler::RegisterThread("MemoryTrackerTests.Worker");
+        PROFILE_SCOPE("MemoryTrackerTests.Zone");
+    });
+    thread.join();
+    Profiler::EndFrame();
+    for (int i = 0; i < 100; ++i) {
+        StringId::Intern("MemoryTrackerTests.Interned." + std::to_string(i));
+    }
+    EXPECT_TRUE(GetTagStats(MemoryTag::kPersistent).liveCount > persistentBefore);
+    EXPECT_TRUE(MemoryTracker::ReportLeaks());
+}
\ No newline at end of file
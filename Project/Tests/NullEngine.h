@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "Common/DrawList.h"
+#include "Common/MemoryTracker.h"
+#include "Common/SceneBenchmark.h"
+
+namespace KashipanEngine::Test {
+
+/// @brief GPUを使わない描画先。DrawList が描画させた順番を記録するだけで、コマンドは何も積まない
+class NullRenderer {
+public:
+    /// @brief オブジェクトの描画情報(DrawList が使う項目と、順番の確認用の名前だけ)
+    struct ObjectState {
+        std::string name;
+        StringId pipeLineName = "Object3d.Solid.BlendNormal";
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+    };
+    /// @brief 線の描画情報
+    struct LineState {
+        std::string name;
+        StringId pipeLineName = "Line.Normal";
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+    };
+
+    /// @brief 描画前処理。描画リストと記録した順番を空にする
+    void PreDraw() {
+        drawList_.Reset(std::pmr::get_default_resource());
+        drawOrder_.clear();
+    }
+
+    /// @brief 描画後処理。描画リストの順番で描画して、描画コマンドの数を確定させる
+    void PostDraw() {
+        drawList_.Submit(*this, "Object3d.Solid.BlendNormal");
+        drawList_.Clear(std::pmr::get_default_resource());
+    }
+
+    DrawList<ObjectState, LineState> &GetDrawList() { return drawList_; }
+    const DrawStats &GetDrawStats() const { return drawList_.GetDrawStats(); }
+    /// @brief 直近の PostDraw で描画した順番("名前" か、テキストなら "text:まとめる単位のインデックス")
+    const std::vector<std::string> &GetDrawOrder() const { return drawOrder_; }
+
+    // 以下は DrawList::Submit から呼ばれる
+
+    void SetPipeLine(StringId) {}
+    void BeginObjects() {}
+    void DrawLine(LineState &lineState) { drawOrder_.push_back(lineState.name); }
+    void DrawObject(ObjectState &objectState) { drawOrder_.push_back(objectState.name); }
+    void PrepareTexts(const TextBatcher &) {}
+    void DrawTextBatch(const TextBatcher &, size_t batchIndex) { drawOrder_.push_back("text:" + std::to_string(batchIndex)); }
+
+private:
+    DrawList<ObjectState, LineState> drawList_;
+    std::vector<std::string> drawOrder_;
+};
+
+/// @brief ウィンドウもGPUも使わずにシーンを回すエンジンの代わり。
+/// 1フレームに固定ステップ更新を1ティックだけ進め、描画は NullRenderer に積む
+class NullEngine {
+public:
+    NullRenderer &GetRenderer() { return renderer_; }
+
+    /// @brief シーンのベンチマークでフレームを進める処理
+    /// @param maxFrameCount 進めるフレーム数の上限(ウィンドウが閉じられた場合の代わり)。0なら上限なし
+    SceneBenchmarkFrameFunctions GetFrameFunctions(uint32_t maxFrameCount = 0) {
+        SceneBenchmarkFrameFunctions frameFunctions;
+        frameFunctions.processMessage = [this, maxFrameCount]() {
+            return maxFrameCount == 0 || frameCount_ < maxFrameCount;
+        };
+        frameFunctions.beginFrame = [this]() {
+            ++frameCount_;
+            hasPendingTick_ = true;
+            renderer_.PreDraw();
+            return true;
+        };
+        frameFunctions.beginFixedUpdate = [this]() {
+            const bool hasPendingTick = hasPendingTick_;
+            hasPendingTick_ = false;
+            return hasPendingTick;
+        };
+        frameFunctions.endFrame = [this]() {
+            renderer_.PostDraw();
+            MemoryTracker::EndFrame();
+        };
+        frameFunctions.getDrawStats = [this]() { return renderer_.GetDrawStats(); };
+        return frameFunctions;
+    }
+
+    /// @brief 始めたフレームの数
+    uint32_t GetFrameCount() const { return frameCount_; }
+
+private:
+    NullRenderer renderer_;
+    uint32_t frameCount_ = 0;
+    bool hasPendingTick_ = false;
+};
+
+} // namespace KashipanEngine::Test
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <vector>
+#include "TestFramework.h"
+#include "Math/Physics/PhysicsWorld.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+// 2進数で割り切れるステップ時間(時間の足し算で丸め誤差が出ないようにする)
+const float kStep = 1.0f / 64.0f;
+
+/// @brief 地面の上に箱と球とカプセルを積み上げたワールドを作る
+void BuildMixedStack(PhysicsWorld &world) {
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    RigidBodyDesc desc;
+    for (int i = 0; i < 12; ++i) {
+        desc.shape = static_cast<RigidBodyShape>(i % 3);
+        desc.position = Vector3(static_cast<float>(i % 2) * 0.3f, 0.5f + static_cast<float>(i) * 1.2f, 0.0f);
+        desc.restitution = 0.1f * static_cast<float>(i % 4);
+        world.AddBody(desc);
+    }
+}
+
+} // namespace
+
+TEST(PhysicsWorld, SameInputsGiveSameStateEveryStep) {
+    PhysicsWorld a;
+    PhysicsWorld b;
+    BuildMixedStack(a);
+    BuildMixedStack(b);
+    for (int step = 0; step < 300; ++step) {
+        a.StepFixed();
+        b.StepFixed();
+        ASSERT_TRUE(a.ComputeStateHash() == b.ComputeStateHash());
+    }
+}
+
+TEST(PhysicsWorld, UpdateSplitsFrameTimeIntoSameSteps) {
+    // 同じ合計時間なら、フレームの区切り方が違っても同じステップ数・同じ状態になる
+    PhysicsWorld fixedWorld(kStep, 8);
+    PhysicsWorld variableWorld(kStep, 8);
+    BuildMixedStack(fixedWorld);
+    BuildMixedStack(variableWorld);
+    const float frameTimes[] = { kStep * 0.5f, kStep * 1.5f, kStep * 2.0f, kStep * 0.25f, kStep * 2.0f };
+    uint32_t fixedStepCount = 0;
+    uint32_t variableStepCount = 0;
+    for (int frame = 0; frame < 100; ++frame) {
+        fixedStepCount += fixedWorld.Update(kStep * 1.25f);
+        variableStepCount += variableWorld.Update(frameTimes[frame % 5]);
+    }
+    // 合計時間は両方とも 125 ステップ分
+    EXPECT_EQ(fixedStepCount, variableStepCount);
+    EXPECT_EQ(fixedWorld.ComputeStateHash(), variableWorld.ComputeStateHash());
+    EXPECT_TRUE(fixedWorld.GetInterpolationAlpha() >= 0.0f && fixedWorld.GetInterpolationAlpha() < 1.0f);
+}
+
+TEST(PhysicsWorld, UpdateDropsTimeBeyondMaxSubSteps) {
+    PhysicsWorld world(kStep, 4);
+    BuildMixedStack(world);
+    EXPECT_EQ(4u, world.Update(kStep * 10.5f));
+    // 追いつけない時間は持ち越さない
+    EXPECT_EQ(0u, world.Update(kStep * 0.25f));
+}
+
+TEST(PhysicsWorld, StackComesToRestAndSleeps) {
+    PhysicsWorld world;
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    RigidBodyDesc desc;
+    desc.shape = RigidBodyShape::kAABB;
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 5; ++i) {
+        desc.position = Vector3(0.0f, 0.5f + static_cast<float>(i), 0.0f);
+        ids.push_back(world.AddBody(desc));
+    }
+    for (int step = 0; step < 600; ++step) {
+        world.StepFixed();
+    }
+    EXPECT_EQ(0u, world.GetAwakeBodyCount());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        // 崩れずに積み上がったまま
+        EXPECT_NEAR(0.5f + static_cast<float>(i), world.GetPosition(ids[i]).y, 0.05f);
+        EXPECT_NEAR(0.0f, world.GetPosition(ids[i]).x, 0.01f);
+    }
+}
+
+TEST(PhysicsWorld, BodyWokenByIslandDoesNotFallAsleepImmediately) {
+    PhysicsWorld world(kStep);
+    world.AddPlane(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    RigidBodyDesc desc;
+    desc.position = Vector3(0.0f, 0.5f, 0.0f);
+    const uint32_t resting = world.AddBody(desc);
+    for (int step = 0; step < 120 && !world.IsSleeping(resting); ++step) {
+        world.StepFixed();
+    }
+    ASSERT_TRUE(world.IsSleeping(resting));
+
+    // 接触したまま離れていく球が、眠っている球をアイランドとして起こす
+    desc.position = Vector3(0.99f, 0.5f, 0.0f);
+    desc.velocity = Vector3(2.0f, 0.0f, 0.0f);
+    world.AddBody(desc);
+    world.StepFixed();
+    ASSERT_TRUE(!world.IsSleeping(resting));
+
+    // 離れた後も、起きてから timeToSleep(0.5秒)経つまでは眠らない
+    for (int step = 0; step < 20; ++step) {
+        world.StepFixed();
+        EXPECT_FALSE(world.IsSleeping(resting));
+    }
+    for (int step = 0; step < 60; ++step) {
+        world.StepFixed();
+    }
+    EXPECT_TRUE(world.IsSleeping(resting));
+}
+
+TEST(PhysicsWorld, BroadPhaseFindsContactsOnEveryAxis) {
+    // 横・縦・奥に並べた球のどの並びでも、隣同士の接触が見つかる
+    for (int axis = 0; axis < 3; ++axis) {
+        PhysicsWorld world;
+        world.SetGravity(Vector3(0.0f, 0.0f, 0.0f));
+        RigidBodyDesc desc;
+        for (int i = 0; i < 16; ++i) {
+            const float offset = static_cast<float>(i) * 0.95f;
+            desc.position = Vector3(axis == 0 ? offset : 0.0f, axis == 1 ? offset : 0.0f, axis == 2 ? offset : 0.0f);
+            world.AddBody(desc);
+        }
+        world.StepFixed();
+        EXPECT_EQ(15u, static_cast<uint32_t>(world.GetContacts().size()));
+    }
+}
+
+TEST(PhysicsWorld, RemoveBodyKeepsOtherBodiesAndContacts) {
+    PhysicsWorld world;
+    BuildMixedStack(world);
+    for (int step = 0; step < 30; ++step) {
+        world.StepFixed();
+    }
+    world.RemoveBody(3);
+    world.RemoveBody(0);
+    EXPECT_FALSE(world.IsValid(3));
+    EXPECT_TRUE(world.IsValid(11));
+    for (const auto &contact : world.GetContacts()) {
+        EXPECT_TRUE(contact.bodyA != 3 && contact.bodyB != 3);
+    }
+    for (int step = 0; step < 30; ++step) {
+        world.StepFixed();
+    }
+    EXPECT_EQ(10u, world.GetBodyCount());
+}
\ No newline at end of file
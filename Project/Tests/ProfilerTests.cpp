@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+#include "TestFramework.h"
+#include "Common/Profiler.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 統計から名前の一致するゾーンを探す
+const Profiler::ZoneStats *FindZone(const std::vector<Profiler::ZoneStats> &stats, const std::string &name) {
+    auto it = std::find_if(stats.begin(), stats.end(), [&name](const Profiler::ZoneStats &zone) {
+        return zone.name == name;
+    });
+    return it != stats.end() ? &*it : nullptr;
+}
+
+} // namespace
+
+TEST(Profiler, UnregisteredThreadZonesAreDropped) {
+    const uint64_t droppedBefore = Profiler::GetDroppedZoneCount();
+    std::thread thread([]() {
+        PROFILE_SCOPE("ProfilerTests.Unregistered");
+    });
+    thread.join();
+    Profiler::EndFrame();
+    EXPECT_EQ(droppedBefore + 1, Profiler::GetDroppedZoneCount());
+    EXPECT_TRUE(FindZone(Profiler::GetZoneStats(), "ProfilerTests.Unregistered") == nullptr);
+}
+
+TEST(Profiler, RegisteredThreadZonesAreCollected) {
+    const uint64_t droppedBefore = Profiler::GetDroppedZoneCount();
+    std::thread thread([]() {
+        Profiler::RegisterThread("ProfilerTests.Worker");
+        for (int i = 0; i < 3; ++i) {
+            PROFILE_SCOPE("ProfilerTests.Registered");
+        }
+    });
+    thread.join();
+    Profiler::EndFrame();
+    EXPECT_EQ(droppedBefore, Profiler::GetDroppedZoneCount());
+    const Profiler::ZoneStats *zone = FindZone(Profiler::GetZoneStats(), "ProfilerTests.Registered");
+    ASSERT_TRUE(zone != nullptr);
+    EXPECT_EQ(3u, zone->lastCallCount);
+}
+
+TEST(Profiler, DisabledZonesAreNotRecorded) {
+    Profiler::RegisterThread("Main");
+    Profiler::SetEnabled(false);
+    {
+        PROFILE_SCOPE("ProfilerTests.Disabled");
+    }
+    Profiler::SetEnabled(true);
+    Profiler::EndFrame();
+    EXPECT_TRUE(FindZone(Profiler::GetZoneStats(), "ProfilerTests.Disabled") == nullptr);
+}
\ No newline at end of file
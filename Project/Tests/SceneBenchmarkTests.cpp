@@ -0,0 +1,91 @@
+#include <memory>
+#include <string>
+#include "TestFramework.h"
+#include "TestLogs.h"
+#include "NullEngine.h"
+#include "Base/SceneManager.h"
+
+using namespace KashipanEngine;
+using Test::NullEngine;
+using Test::NullRenderer;
+
+namespace {
+
+/// @brief 毎フレーム決まった数のオブジェクトを描画するシーン
+class DrawObjectsScene : public SceneBase {
+public:
+    DrawObjectsScene(const std::string &name, NullRenderer *renderer, int objectCount)
+        : SceneBase(name), renderer_(renderer), objectCount_(objectCount) {}
+
+    void Initialize() override { isInitialized_ = true; }
+    void Finalize() override { isInitialized_ = false; }
+    void Update() override { ++updateCount_; }
+    void FixedUpdate() override { ++fixedUpdateCount_; }
+    void Draw() override {
+        ++drawCount_;
+        for (int i = 0; i < objectCount_; ++i) {
+            NullRenderer::ObjectState objectState;
+            objectState.indexCount = 6;
+            renderer_->GetDrawList().AddObject(objectState, true, false);
+        }
+    }
+
+    int GetUpdateCount() const { return updateCount_; }
+    int GetFixedUpdateCount() const { return fixedUpdateCount_; }
+    int GetDrawCount() const { return drawCount_; }
+
+private:
+    NullRenderer *renderer_ = nullptr;
+    int objectCount_ = 0;
+    int updateCount_ = 0;
+    int fixedUpdateCount_ = 0;
+    int drawCount_ = 0;
+};
+
+} // namespace
+
+TEST(SceneBenchmark, RunsRegisteredScenesWithoutGpu) {
+    NullEngine engine;
+    auto few = std::make_unique<DrawObjectsScene>("Few", &engine.GetRenderer(), 3);
+    auto many = std::make_unique<DrawObjectsScene>("Many", &engine.GetRenderer(), 40);
+    const DrawObjectsScene *fewScene = few.get();
+    const DrawObjectsScene *manyScene = many.get();
+    SceneManager::AddScene("Few", std::move(few));
+    SceneManager::AddScene("Many", std::move(many));
+
+    const auto results = RunSceneBenchmarks(20, 5, engine.GetFrameFunctions());
+    ASSERT_TRUE(results.size() == 2);
+    EXPECT_TRUE(results[0].sceneName == "Few");
+    EXPECT_EQ(size_t(20), results[0].frameTime.sampleCount);
+    EXPECT_NEAR(3.0, results[0].drawCallsPerFrame, 1e-9);
+    EXPECT_NEAR(3.0, results[0].instancesPerFrame, 1e-9);
+    EXPECT_TRUE(results[1].sceneName == "Many");
+    EXPECT_NEAR(40.0, results[1].drawCallsPerFrame, 1e-9);
+    // 計測前のフレームも更新・描画する
+    EXPECT_EQ(25, fewScene->GetUpdateCount());
+    EXPECT_EQ(25, fewScene->GetFixedUpdateCount());
+    EXPECT_EQ(25, manyScene->GetDrawCount());
+    EXPECT_EQ(uint32_t(50), engine.GetFrameCount());
+    // 終わったら元のシーンに戻す
+    EXPECT_TRUE(SceneManager::GetActiveSceneName() == "Few");
+    SceneManager::ClearScenes();
+}
+
+TEST(SceneBenchmark, StopsWhenFramesCannotContinue) {
+    NullEngine engine;
+    SceneManager::AddScene<DrawObjectsScene>("Scene", "Scene", &engine.GetRenderer(), 1);
+    // ウィンドウが閉じられたのと同じく、12フレームで打ち切る
+    const auto result = RunSceneBenchmark("Scene", 20, 5, engine.GetFrameFunctions(12));
+    EXPECT_EQ(size_t(7), result.frameTime.sampleCount);
+    EXPECT_NEAR(1.0, result.drawCallsPerFrame, 1e-9);
+    SceneManager::ClearScenes();
+}
+
+TEST(SceneBenchmark, MissingSceneIsWarned) {
+    NullEngine engine;
+    Test::ClearLogs();
+    const auto result = RunSceneBenchmark("Missing", 10, 0, engine.GetFrameFunctions());
+    EXPECT_EQ(size_t(0), result.frameTime.sampleCount);
+    EXPECT_EQ(size_t(1), Test::GetLogCount(kLogLevelFlagWarning));
+    EXPECT_EQ(uint32_t(0), engine.GetFrameCount());
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <SlotMap.h>
+#include "TestFramework.h"
+
+using MyStd::NamedSlotMap;
+using MyStd::SlotHandle;
+using MyStd::SlotMap;
+
+namespace {
+
+/// @brief ハンドルを並べ替えのキーにする
+uint64_t ToKey(const SlotHandle &handle) {
+    return (static_cast<uint64_t>(handle.index) << 32) | handle.generation;
+}
+
+} // namespace
+
+TEST(SlotMap, ErasedHandleBecomesStaleWhenSlotIsReused) {
+    SlotMap<int> slotMap;
+    const SlotHandle first = slotMap.insert(1);
+    EXPECT_TRUE(slotMap.erase(first));
+    const SlotHandle second = slotMap.insert(2);
+    // 同じスロットが再利用されても、古いハンドルは新しい値を指さない
+    EXPECT_EQ(first.index, second.index);
+    EXPECT_FALSE(slotMap.contains(first));
+    EXPECT_TRUE(slotMap.get(first) == nullptr);
+    EXPECT_EQ(2, *slotMap.get(second));
+    EXPECT_FALSE(slotMap.erase(first));
+    EXPECT_EQ(size_t(1), slotMap.size());
+}
+
+TEST(SlotMap, ClearInvalidatesEveryHandle) {
+    SlotMap<int> slotMap;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 8; ++i) {
+        handles.push_back(slotMap.insert(i));
+    }
+    slotMap.clear();
+    for (const auto &handle : handles) {
+        EXPECT_FALSE(slotMap.contains(handle));
+    }
+    // 番号の小さいスロットから再利用する
+    const SlotHandle handle = slotMap.insert(100);
+    EXPECT_EQ(0u, handle.index);
+    EXPECT_NE(handles[0].generation, handle.generation);
+}
+
+TEST(SlotMap, RandomOperationsMatchReferenceModel) {
+    // 追加・削除・取得・全削除をランダムに繰り返して、std::map で作った正解と比べる
+    std::mt19937 engine(20240528u);
+    for (int round = 0; round < 20; ++round) {
+        SlotMap<int> slotMap;
+        std::map<uint64_t, std::pair<SlotHandle, int>> alive;
+        std::vector<SlotHandle> dead;
+        int nextValue = 0;
+        for (int operation = 0; operation < 5000; ++operation) {
+            const uint32_t kind = engine() % 100;
+            if (kind < 50 || alive.empty()) {
+                const SlotHandle handle = slotMap.insert(nextValue);
+                ASSERT_TRUE(handle.IsValid());
+                ASSERT_TRUE(alive.find(ToKey(handle)) == alive.end());
+                alive[ToKey(handle)] = { handle, nextValue };
+                ++nextValue;
+            } else if (kind < 90) {
+                auto it = alive.begin();
+                std::advance(it, engine() % alive.size());
+                ASSERT_TRUE(slotMap.erase(it->second.first));
+                dead.push_back(it->second.first);
+                alive.erase(it);
+            } else if (kind < 99) {
+                // 削除済みのハンドルをもう一度消しても何も起きない
+                if (!dead.empty()) {
+                    EXPECT_FALSE(slotMap.erase(dead[engine() % dead.size()]));
+                }
+            } else {
+                slotMap.clear();
+                for (const auto &entry : alive) {
+                    dead.push_back(entry.second.first);
+                }
+                alive.clear();
+            }
+
+            ASSERT_TRUE(slotMap.size() == alive.size());
+        }
+        for (const auto &entry : alive) {
+            const int *value = slotMap.get(entry.second.first);
+            ASSERT_TRUE(value != nullptr);
+            EXPECT_EQ(entry.second.second, *value);
+        }
+        for (const auto &handle : dead) {
+            ASSERT_TRUE(!slotMap.contains(handle));
+        }
+        // 詰めて保持している値とハンドルの対応も正しい
+        std::vector<int> values(slotMap.begin(), slotMap.end());
+        std::vector<int> expected;
+        for (size_t i = 0; i < slotMap.size(); ++i) {
+            const SlotHandle handle = slotMap.handle_at(i);
+            EXPECT_EQ(values[i], slotMap[handle]);
+            expected.push_back(alive.at(ToKey(handle)).second);
+        }
+        EXPECT_TRUE(values == expected);
+    }
+}
+
+TEST(SlotMap, NamedSlotMapKeepsKeysAndHandlesInSync) {
+    std::mt19937 engine(7u);
+    NamedSlotMap<std::string, int> namedMap;
+    std::map<std::string, int> reference;
+    for (int operation = 0; operation < 3000; ++operation) {
+        const std::string key = "key" + std::to_string(engine() % 64);
+        if (engine() % 3 != 0) {
+            const int value = static_cast<int>(engine() % 1000);
+            const SlotHandle handle = namedMap.insert(key, value);
+            reference[key] = value;
+            EXPECT_TRUE(namedMap.find(key) == handle);
+            EXPECT_EQ(key, namedMap.key_of(handle));
+        } else {
+            const SlotHandle handle = namedMap.find(key);
+            EXPECT_EQ(reference.erase(key) == 1, namedMap.erase(key));
+            EXPECT_FALSE(namedMap.contains(handle));
+        }
+        ASSERT_TRUE(namedMap.size() == reference.size());
+    }
+    for (const auto &[key, value] : reference) {
+        EXPECT_EQ(value, namedMap.at(key));
+    }
+}
+
+TEST(SlotMap, NamedSlotMapStoresMoveOnlyValues) {
+    NamedSlotMap<std::string, std::unique_ptr<int>> namedMap;
+    const SlotHandle handle = namedMap.insert("a", std::make_unique<int>(1));
+    const int *first = namedMap.get(handle)->get();
+    // 別のキーを追加しても、先に追加した値の指す先は変わらない
+    namedMap.insert("b", std::make_unique<int>(2));
+    EXPECT_TRUE(namedMap.get(handle)->get() == first);
+    EXPECT_EQ(1, *namedMap.at("a"));
+    EXPECT_EQ(2, *namedMap.at("b"));
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "TestFramework.h"
+#include "Math/Physics/SpringSystem.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+const float kFrameTime = 1.0f / 60.0f;
+
+/// @brief 位置が有限の値かどうか
+bool IsFinite(const Vector3 &position) {
+    return std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(position.z);
+}
+
+/// @brief 上の2つの角を固定した布を作る
+ClothGrid BuildHangingCloth(SpringSystem &system, uint32_t size, float stiffness) {
+    const float spacing = 2.0f / static_cast<float>(size - 1);
+    const ClothGrid grid = system.CreateCloth(Vector3(-1.0f, 3.0f, 0.0f), Vector3(spacing, 0.0f, 0.0f),
+        Vector3(0.0f, 0.0f, spacing), size, size, 1.0f, stiffness);
+    system.Pin(grid.firstParticle);
+    system.Pin(grid.firstParticle + size - 1);
+    return grid;
+}
+
+/// @brief 自由落下させた質点の終端速度を測る
+float MeasureTerminalSpeed(uint32_t subSteps, float frameTime) {
+    SpringSystem system;
+    system.SetSubSteps(subSteps);
+    system.SetDamping(5.0f);
+    const uint32_t particle = system.AddParticle(Vector3(0.0f, 0.0f, 0.0f));
+    // 終端速度に達するまで落とす
+    float time = 0.0f;
+    while (time < 4.0f) {
+        system.Update(frameTime);
+        time += frameTime;
+    }
+    const float startY = system.GetPosition(particle).y;
+    const int frameCount = static_cast<int>(1.0f / frameTime);
+    for (int frame = 0; frame < frameCount; ++frame) {
+        system.Update(frameTime);
+    }
+    return (startY - system.GetPosition(particle).y) / (static_cast<float>(frameCount) * frameTime);
+}
+
+} // namespace
+
+TEST(SpringSystem, DampingDoesNotDependOnSubStepCount) {
+    // 線形の減衰なので、終端速度は 重力 / 減衰率 になる
+    const float expected = 9.8f / 5.0f;
+    EXPECT_NEAR(expected, MeasureTerminalSpeed(1, kFrameTime), expected * 0.1f);
+    EXPECT_NEAR(expected, MeasureTerminalSpeed(8, kFrameTime), expected * 0.05f);
+    EXPECT_NEAR(expected, MeasureTerminalSpeed(32, kFrameTime), expected * 0.05f);
+    EXPECT_NEAR(expected, MeasureTerminalSpeed(8, 1.0f / 240.0f), expected * 0.05f);
+}
+
+TEST(SpringSystem, RopeSettlesWithoutStretching) {
+    SpringSystem system;
+    const uint32_t first = system.CreateRope(Vector3(0.0f, 5.0f, 0.0f), Vector3(4.0f, 5.0f, 0.0f), 16);
+    system.Pin(first);
+    for (int frame = 0; frame < 600; ++frame) {
+        system.Update(kFrameTime);
+    }
+    // 垂れ下がって止まる
+    const Vector3 tail = system.GetPosition(first + 16);
+    ASSERT_TRUE(IsFinite(tail));
+    EXPECT_NEAR(0.0f, tail.x, 0.05f);
+    EXPECT_NEAR(1.0f, tail.y, 0.05f);
+    system.Update(kFrameTime);
+    EXPECT_NEAR(0.0f, (system.GetPosition(first + 16) - tail).Length(), 1.0e-3f);
+    // 伸び縮みしないバネなので長さは保たれる
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_NEAR(0.25f, (system.GetPosition(first + i + 1) - system.GetPosition(first + i)).Length(), 0.01f);
+    }
+}
+
+TEST(SpringSystem, StiffClothStaysStableAndComesToRest) {
+    SpringSystem system;
+    const ClothGrid grid = BuildHangingCloth(system, 32, 0.0f);
+    system.AddCollider(Math::Sphere(Vector3(0.0f, 1.5f, 0.5f), 0.6f));
+    system.AddCollider(Math::Plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f));
+    for (int frame = 0; frame < 600; ++frame) {
+        system.Update(kFrameTime);
+    }
+    float maxMotion = 0.0f;
+    std::vector<Vector3> before(system.GetParticleCount());
+    for (uint32_t i = 0; i < system.GetParticleCount(); ++i) {
+        before[i] = system.GetPosition(i);
+        ASSERT_TRUE(IsFinite(before[i]));
+        EXPECT_TRUE(before[i].y >= -1.0e-4f);
+    }
+    system.Update(kFrameTime);
+    for (uint32_t i = 0; i < system.GetParticleCount(); ++i) {
+        maxMotion = (std::max)(maxMotion, (system.GetPosition(i) - before[i]).Length());
+    }
+    // 落ち着いて、ほとんど動かない
+    EXPECT_TRUE(maxMotion < 0.01f);
+    // 隣の質点との距離が大きく伸びていない
+    const float spacing = 2.0f / 31.0f;
+    for (uint32_t x = 0; x + 1 < grid.width; ++x) {
+        const uint32_t bottom = grid.firstParticle + (grid.height - 1) * grid.width + x;
+        EXPECT_NEAR(spacing, (system.GetPosition(bottom + 1) - system.GetPosition(bottom)).Length(), spacing * 0.1f);
+    }
+}
+
+TEST(SpringSystem, SoftClothWithLargeTimeStepStaysFinite) {
+    // 柔らかいバネと長いフレーム時間でも発散しない
+    for (const uint32_t subSteps : { 1u, 2u, 8u }) {
+        SpringSystem system;
+        system.SetSubSteps(subSteps);
+        BuildHangingCloth(system, 16, 50.0f);
+        for (int frame = 0; frame < 300; ++frame) {
+            system.Update(1.0f / 20.0f);
+        }
+        for (uint32_t i = 0; i < system.GetParticleCount(); ++i) {
+            ASSERT_TRUE(IsFinite(system.GetPosition(i)));
+            EXPECT_TRUE(system.GetPosition(i).Length() < 20.0f);
+        }
+    }
+}
+
+TEST(SpringSystem, ParallelAndSerialGiveSameResult) {
+    SpringSystem parallel;
+    SpringSystem serial;
+    parallel.SetParallel(true);
+    serial.SetParallel(false);
+    BuildHangingCloth(parallel, 48, 0.0f);
+    BuildHangingCloth(serial, 48, 0.0f);
+    for (int frame = 0; frame < 60; ++frame) {
+        parallel.Update(kFrameTime);
+        serial.Update(kFrameTime);
+    }
+    for (uint32_t i = 0; i < parallel.GetParticleCount(); ++i) {
+        const Vector3 a = parallel.GetPosition(i);
+        const Vector3 b = serial.GetPosition(i);
+        ASSERT_TRUE(a.x == b.x && a.y == b.y && a.z == b.z);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestFramework.h"
+#include "Common/StringId.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+STRING_ID_CONSTANT(kTestConstantName, "StringIdTests.Constant");
+
+} // namespace
+
+TEST(StringId, HashIsComputedAtCompileTime) {
+    constexpr StringId id = "StringIdTests.CompileTime";
+    static_assert(id.GetHash() == StringId::Hash("StringIdTests.CompileTime"));
+    static_assert(StringId("a") != StringId("b"));
+    static_assert(!StringId().IsValid());
+    EXPECT_TRUE(id == StringId(std::string("StringIdTests.CompileTime")));
+}
+
+TEST(StringId, RuntimeConversionDoesNotRegister) {
+    // 変換するだけでは逆引き用の表に登録されず、16進表記になる
+    const std::string name = "StringIdTests.RuntimeOnly";
+    const StringId id(name);
+    EXPECT_EQ('#', id.GetString().front());
+    EXPECT_EQ(size_t(17), id.GetString().size());
+}
+
+TEST(StringId, InternRegistersTheString) {
+    const std::string name = "StringIdTests.Interned";
+    const StringId interned = StringId::Intern(name);
+    EXPECT_TRUE(interned == StringId(name));
+    EXPECT_EQ(name, interned.GetString());
+    // 後から変換した識別子からも引ける
+    EXPECT_EQ(name, StringId(name).GetString());
+    // 同じ文字列を何度登録してもよい
+    EXPECT_TRUE(StringId::Intern(name) == interned);
+}
+
+TEST(StringId, NamespaceScopeConstantIsRegistered) {
+    static_assert(kTestConstantName == StringId("StringIdTests.Constant"));
+    EXPECT_EQ(std::string("StringIdTests.Constant"), kTestConstantName.GetString());
+}
+
+TEST(StringId, ConcurrentInternIsConsistent) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 500; ++i) {
+                // スレッド間で半分の名前が重なる
+                StringId::Intern("StringIdTests.Thread." + std::to_string((t % 2) * 1000 + i));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < 500; ++i) {
+        const std::string name = "StringIdTests.Thread." + std::to_string(1000 + i);
+        EXPECT_EQ(name, StringId(name).GetString());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <TaskGraph.h>
+#include "TestFramework.h"
+
+using MyStd::TaskGraph;
+using TaskThread = MyStd::TaskGraph::TaskThread;
+using TaskState = MyStd::TaskGraph::TaskState;
+
+namespace {
+
+/// @brief 処理の開始・終了の順番を記録する
+class OrderRecorder {
+public:
+    void Begin(const std::string &name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        begins_[name] = counter_++;
+    }
+    void End(const std::string &name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ends_[name] = counter_++;
+    }
+    /// @brief before が終わってから after が始まったかどうか
+    bool IsOrdered(const std::string &before, const std::string &after) const {
+        return ends_.at(before) < begins_.at(after);
+    }
+    /// @brief a と b の実行中の期間が重なっていたかどうか
+    bool IsOverlapped(const std::string &a, const std::string &b) const {
+        return begins_.at(a) < ends_.at(b) && begins_.at(b) < ends_.at(a);
+    }
+    bool IsRun(const std::string &name) const { return begins_.contains(name); }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, int> begins_;
+    std::map<std::string, int> ends_;
+    int counter_ = 0;
+};
+
+TaskState FindState(const TaskGraph &graph, const std::string &name) {
+    for (const auto &result : graph.GetResults()) {
+        if (result.name == name) {
+            return result.state;
+        }
+    }
+    return TaskState::kPending;
+}
+
+// 偽のサブシステム。エンジンの初期化グラフと同じ依存関係で、スレッドの制約を検査する
+thread_local bool tIsApartmentInitialized = false;
+
+/// @brief COM オブジェクトの代わり。作ったスレッドの初期化が終了後も続いている必要がある
+struct FakeComObject {
+    std::thread::id creatorThread;
+};
+
+/// @brief エンジンの各サブシステムの代わり
+struct FakeEngine {
+    std::thread::id mainThread = std::this_thread::get_id();
+    std::mutex mutex;
+    std::vector<std::string> errors;
+    std::atomic<bool> isDeviceCreated = false;
+    std::atomic<bool> isPrefetched = false;
+    std::atomic<bool> isTextureReady = false;
+    std::atomic<bool> isPipeLineReady = false;
+    std::atomic<bool> isRendererReady = false;
+    FakeComObject sound;
+    FakeComObject inputDevices;
+
+    void Fail(const std::string &message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(message);
+    }
+    bool IsMainThread() const { return std::this_thread::get_id() == mainThread; }
+    /// @brief COM オブジェクトを作る。プロセスの終了まで使うので、メインスレッド以外で作るのは誤り
+    FakeComObject CreateComObject(const char *name) {
+        if (!tIsApartmentInitialized && !IsMainThread()) {
+            Fail(std::string(name) + ": COM is not initialized on this thread");
+        }
+        if (!IsMainThread()) {
+            Fail(std::string(name) + ": COM object outlives the worker apartment");
+        }
+        return FakeComObject{ std::this_thread::get_id() };
+    }
+    /// @brief コマンドリストの取得。メインスレッド以外からは使えない
+    void UseCommandList(const char *name) {
+        if (!IsMainThread()) {
+            Fail(std::string(name) + ": command list used from a worker thread");
+        }
+    }
+};
+
+/// @brief エンジンの初期化と同じ形のグラフを作る
+void BuildFakeEngineGraph(TaskGraph &graph, FakeEngine &engine, std::mt19937 &random) {
+    // 処理ごとに少し待って実行順をばらつかせる
+    auto jitter = [&random]() {
+        return std::chrono::microseconds(random() % 500);
+    };
+    auto add = [&](const char *name, TaskThread thread, std::function<void()> function,
+        std::vector<std::string> dependencies) {
+        const auto delay = jitter();
+        graph.AddTask(name, thread, [function, delay]() {
+            std::this_thread::sleep_for(delay);
+            function();
+        }, std::move(dependencies));
+    };
+    add("WinApp", TaskThread::kMain, [&]() {}, {});
+    add("DirectXCommon", TaskThread::kMain, [&]() { engine.isDeviceCreated = true; }, { "WinApp" });
+    add("InputDevices", TaskThread::kMain, [&]() { engine.inputDevices = engine.CreateComObject("InputDevices"); }, { "WinApp" });
+    add("Input", TaskThread::kMain, [&]() {}, { "InputDevices" });
+    add("UAV", TaskThread::kMain, [&]() { engine.UseCommandList("UAV"); }, { "DirectXCommon" });
+    add("PrimitiveDrawer", TaskThread::kMain, [&]() {}, { "UAV" });
+    add("Sound", TaskThread::kMain, [&]() { engine.sound = engine.CreateComObject("Sound"); }, {});
+    add("AssetPrefetch", TaskThread::kAny, [&]() {
+        // デコードは COM を使うが、オブジェクトを処理の外に持ち出さない
+        if (!tIsApartmentInitialized && !engine.IsMainThread()) {
+            engine.Fail("AssetPrefetch: COM is not initialized on this thread");
+        }
+        engine.isPrefetched = true;
+    }, {});
+    add("SRV", TaskThread::kMain, [&]() {}, { "PrimitiveDrawer" });
+    add("ImGui", TaskThread::kMain, [&]() {}, { "SRV" });
+    add("Texture", TaskThread::kMain, [&]() {
+        if (!engine.isPrefetched) {
+            engine.Fail("Texture: default texture was not prefetched");
+        }
+        engine.UseCommandList("Texture");
+        engine.isTextureReady = true;
+    }, { "ImGui", "AssetPrefetch" });
+    add("PipeLineManager", TaskThread::kAny, [&]() {
+        // デバイスだけを使う
+        if (!engine.isDeviceCreated) {
+            engine.Fail("PipeLineManager: device is not created");
+        }
+        engine.isPipeLineReady = true;
+    }, { "DirectXCommon" });
+    add("Renderer", TaskThread::kMain, [&]() {
+        if (!engine.isTextureReady || !engine.isPipeLineReady) {
+            engine.Fail("Renderer: dependencies are not ready");
+        }
+        engine.UseCommandList("Renderer");
+        engine.isRendererReady = true;
+    }, { "Texture", "PipeLineManager" });
+    add("Object", TaskThread::kMain, [&]() {}, { "Renderer" });
+    add("Lines", TaskThread::kMain, [&]() {}, { "Object" });
+    add("ScreenBuffer", TaskThread::kMain, [&]() { engine.UseCommandList("ScreenBuffer"); }, { "Lines", "Input" });
+    add("Random", TaskThread::kAny, [&]() {}, {});
+    add("SceneBase", TaskThread::kMain, [&]() {
+        if (!engine.isRendererReady) {
+            engine.Fail("SceneBase: renderer is not ready");
+        }
+    }, { "ScreenBuffer", "Sound", "Random" });
+    graph.SetWorkerCallbacks(
+        []() { tIsApartmentInitialized = true; },
+        []() { tIsApartmentInitialized = false; });
+}
+
+} // namespace
+
+TEST(TaskGraph, DependenciesRunInOrderAndIndependentTasksOverlap) {
+    TaskGraph graph;
+    OrderRecorder recorder;
+    // A と B は開始したら互いの開始を待ち合わせる。順番に動かすと先の方は相手を待ちきれずに終わる
+    std::mutex mutex;
+    std::condition_variable condition;
+    int arrivedCount = 0;
+    auto task = [&](const std::string &name, bool isRendezvous) {
+        return [&, name, isRendezvous]() {
+            recorder.Begin(name);
+            if (isRendezvous) {
+                std::unique_lock<std::mutex> lock(mutex);
+                ++arrivedCount;
+                condition.notify_all();
+                condition.wait_for(lock, std::chrono::seconds(5), [&]() { return arrivedCount == 2; });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            recorder.End(name);
+        };
+    };
+    // 後から追加する処理への依存も書ける
+    graph.AddTask("C", TaskThread::kAny, task("C", false), { "A", "B" });
+    graph.AddTask("A", TaskThread::kAny, task("A", true));
+    graph.AddTask("B", TaskThread::kAny, task("B", true));
+    ASSERT_TRUE(graph.Run(2));
+    EXPECT_TRUE(recorder.IsOrdered("A", "C"));
+    EXPECT_TRUE(recorder.IsOrdered("B", "C"));
+    EXPECT_TRUE(recorder.IsOverlapped("A", "B"));
+    for (const auto &result : graph.GetResults()) {
+        EXPECT_TRUE(result.state == TaskState::kSucceeded);
+        // 眠った時間より短く計測されることはない
+        EXPECT_TRUE(result.durationMilliseconds >= 10.0);
+    }
+}
+
+TEST(TaskGraph, MainThreadTasksRunOnCaller) {
+    TaskGraph graph;
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<int> mainCount = 0;
+    std::atomic<int> wrongCount = 0;
+    for (int i = 0; i < 16; ++i) {
+        graph.AddTask("Main" + std::to_string(i), TaskThread::kMain, [&]() {
+            (std::this_thread::get_id() == mainThread ? mainCount : wrongCount) += 1;
+        });
+        graph.AddTask("Any" + std::to_string(i), TaskThread::kAny, []() {});
+    }
+    ASSERT_TRUE(graph.Run(4));
+    EXPECT_EQ(16, mainCount.load());
+    EXPECT_EQ(0, wrongCount.load());
+}
+
+TEST(TaskGraph, CyclesAndUnknownDependenciesRunNothing) {
+    bool isRun = false;
+    TaskGraph cycle;
+    cycle.AddTask("A", TaskThread::kAny, [&]() { isRun = true; }, { "B" });
+    cycle.AddTask("B", TaskThread::kAny, [&]() { isRun = true; }, { "A" });
+    cycle.AddTask("C", TaskThread::kAny, [&]() { isRun = true; });
+    EXPECT_FALSE(cycle.Run(2));
+    EXPECT_FALSE(isRun);
+    EXPECT_TRUE(cycle.GetErrorMessage().find("cycle") != std::string::npos);
+    EXPECT_TRUE(cycle.GetErrorMessage().find("A -> B -> A") != std::string::npos ||
+        cycle.GetErrorMessage().find("B -> A -> B") != std::string::npos);
+
+    TaskGraph unknown;
+    unknown.AddTask("A", TaskThread::kAny, [&]() { isRun = true; }, { "Missing" });
+    EXPECT_FALSE(unknown.Run(2));
+    EXPECT_FALSE(isRun);
+    EXPECT_TRUE(unknown.GetErrorMessage().find("Missing") != std::string::npos);
+
+    bool isThrown = false;
+    try {
+        unknown.AddTask("A", TaskThread::kAny, []() {});
+    } catch (const std::invalid_argument &) {
+        isThrown = true;
+    }
+    EXPECT_TRUE(isThrown);
+}
+
+TEST(TaskGraph, FailureSkipsDependentsButNotIndependentBranches) {
+    TaskGraph graph;
+    std::atomic<bool> isDependentRun = false;
+    std::atomic<bool> isIndependentRun = false;
+    graph.AddTask("Fail", TaskThread::kAny, []() { throw std::runtime_error("device lost"); });
+    graph.AddTask("Child", TaskThread::kMain, [&]() { isDependentRun = true; }, { "Fail" });
+    graph.AddTask("GrandChild", TaskThread::kAny, [&]() { isDependentRun = true; }, { "Child" });
+    graph.AddTask("Independent", TaskThread::kAny, [&]() { isIndependentRun = true; });
+    EXPECT_FALSE(graph.Run(2));
+    EXPECT_FALSE(isDependentRun.load());
+    EXPECT_TRUE(isIndependentRun.load());
+    EXPECT_TRUE(FindState(graph, "Fail") == TaskState::kFailed);
+    EXPECT_TRUE(FindState(graph, "Child") == TaskState::kSkipped);
+    EXPECT_TRUE(FindState(graph, "GrandChild") == TaskState::kSkipped);
+    EXPECT_TRUE(FindState(graph, "Independent") == TaskState::kSucceeded);
+    EXPECT_TRUE(graph.GetErrorMessage().find("device lost") != std::string::npos);
+}
+
+TEST(TaskGraph, WorkerCallbacksRunOncePerWorker) {
+    TaskGraph graph;
+    std::atomic<int> beginCount = 0;
+    std::atomic<int> endCount = 0;
+    graph.SetWorkerCallbacks([&]() { ++beginCount; }, [&]() { ++endCount; });
+    graph.AddTask("A", TaskThread::kAny, []() {});
+    ASSERT_TRUE(graph.Run(3));
+    EXPECT_EQ(3, beginCount.load());
+    EXPECT_EQ(3, endCount.load());
+    // ワーカーが無ければ呼ばない
+    ASSERT_TRUE(graph.Run(0));
+    EXPECT_EQ(3, beginCount.load());
+}
+
+TEST(TaskGraph, FakeEngineInitializationKeepsThreadConstraints) {
+    // エンジンと同じ依存関係で、COM オブジェクトとコマンドリストを使う処理がメインスレッドに残るか調べる
+    std::mt19937 random(20240611u);
+    for (size_t round = 0; round < 40; ++round) {
+        FakeEngine engine;
+        TaskGraph graph;
+        BuildFakeEngineGraph(graph, engine, random);
+        const size_t workerCount = round % 5;
+        ASSERT_TRUE(graph.Run(workerCount));
+        for (const auto &error : engine.errors) {
+            KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, error);
+        }
+        EXPECT_TRUE(engine.sound.creatorThread == engine.mainThread);
+        EXPECT_TRUE(engine.inputDevices.creatorThread == engine.mainThread);
+        for (const auto &result : graph.GetResults()) {
+            if (result.name == "Sound" || result.name == "InputDevices" || result.name == "Texture") {
+                EXPECT_TRUE(result.thread == TaskThread::kMain);
+            }
+        }
+    }
+}
\ No newline at end of file
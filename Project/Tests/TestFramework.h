@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "TestLogs.h"
+
+namespace KashipanEngine::Test {
+
+/// @brief 登録されたテスト
+struct TestCase {
+    const char *suiteName;
+    const char *testName;
+    void (*function)();
+};
+
+/// @brief 登録されたテストの一覧
+std::vector<TestCase> &GetTestCases();
+
+/// @brief 実行中のテストの失敗を記録する
+/// @param file 失敗した場所のファイル名
+/// @param line 失敗した場所の行番号
+/// @param message 失敗の内容
+void ReportFailure(const char *file, int line, const std::string &message);
+
+/// @brief テストを登録するための静的オブジェクト
+struct TestRegistrar {
+    TestRegistrar(const char *suiteName, const char *testName, void (*function)()) {
+        GetTestCases().push_back({ suiteName, testName, function });
+    }
+};
+
+/// @brief 失敗の表示用に値を文字列にする
+template<typename T>
+std::string ToTestString(const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return value ? "true" : "false";
+    } else if constexpr (std::is_enum_v<T>) {
+        return std::to_string(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return std::to_string(value);
+    } else if constexpr (std::is_convertible_v<const T &, std::string>) {
+        return "\"" + std::string(value) + "\"";
+    } else {
+        return "(value)";
+    }
+}
+
+} // namespace KashipanEngine::Test
+
+/// @brief テストの定義。suite と name は識別子
+#define TEST(suite, name) \
+    static void suite##_##name##_Test(); \
+    static ::KashipanEngine::Test::TestRegistrar suite##_##name##_Registrar(#suite, #name, &suite##_##name##_Test); \
+    static void suite##_##name##_Test()
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            ::KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, "EXPECT_TRUE(" #condition ")"); \
+        } \
+    } while (false)
+
+#define EXPECT_FALSE(condition) EXPECT_TRUE(!(condition))
+
+#define EXPECT_EQ(expected, actual) \
+    do { \
+        const auto &testExpected = (expected); \
+        const auto &testActual = (actual); \
+        if (!(testExpected == testActual)) { \
+            ::KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, "EXPECT_EQ(" #expected ", " #actual "): " + \
+                ::KashipanEngine::Test::ToTestString(testExpected) + " != " + \
+                ::KashipanEngine::Test::ToTestString(testActual)); \
+        } \
+    } while (false)
+
+#define EXPECT_NE(a, b) \
+    do { \
+        if ((a) == (b)) { \
+            ::KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, "EXPECT_NE(" #a ", " #b ")"); \
+        } \
+    } while (false)
+
+#define EXPECT_NEAR(expected, actual, tolerance) \
+    do { \
+        const double testExpected = static_cast<double>(expected); \
+        const double testActual = static_cast<double>(actual); \
+        if (!(testActual >= testExpected - (tolerance) && testActual <= testExpected + (tolerance))) { \
+            ::KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, "EXPECT_NEAR(" #expected ", " #actual "): " + \
+                std::to_string(testExpected) + " vs " + std::to_string(testActual)); \
+        } \
+    } while (false)
+
+/// @brief 失敗したらテストを中断する
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            ::KashipanEngine::Test::ReportFailure(__FILE__, __LINE__, "ASSERT_TRUE(" #condition ")"); \
+            return; \
+        } \
+    } while (false)
@@ -0,0 +1,108 @@
+#include <array>
+#include <cstdio>
+#include <mutex>
+#include "TestLogs.h"
+#include "Common/MemoryTracker.h"
+
+// テスト・ベンチマーク用の Log の実装。Logs.cpp は Windows に依存するので、代わりにこれをリンクする
+
+namespace KashipanEngine {
+
+namespace {
+
+std::mutex sLogMutex;
+// レベルごとのログの数(Info, Warning, Error)
+std::array<size_t, 3> sLogCounts{};
+// 直近のログ
+std::vector<std::string> sRecentLogs;
+bool sIsLogEcho = false;
+
+void Write(const std::string &message, LogLevelFlags logLevelFlags) {
+    // Logs.cpp と同じく、保持するログはログのタグで数える
+    MEMORY_TAG_SCOPE(kLog);
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    if (logLevelFlags & kLogLevelFlagInfo) ++sLogCounts[0];
+    if (logLevelFlags & kLogLevelFlagWarning) ++sLogCounts[1];
+    if (logLevelFlags & kLogLevelFlagError) ++sLogCounts[2];
+    sRecentLogs.push_back(message);
+    if (sRecentLogs.size() > kRecentLogCapacity) {
+        sRecentLogs.erase(sRecentLogs.begin());
+    }
+    if (sIsLogEcho) {
+        std::printf("%s\n", message.c_str());
+    }
+}
+
+std::string Narrow(const std::wstring &message) {
+    std::string result;
+    result.reserve(message.size());
+    for (const wchar_t c : message) {
+        result.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+    }
+    return result;
+}
+
+} // namespace
+
+void InitializeLog(const std::string &, const std::string &, const LogLevelFlags, const LogTypeFlags) {}
+
+void Log(const std::string &message, const LogLevelFlags logLevelFlags, const std::source_location &) {
+    Write(message, logLevelFlags);
+}
+
+void Log(const std::wstring &message, const LogLevelFlags logLevelFlags, const std::source_location &) {
+    Write(Narrow(message), logLevelFlags);
+}
+
+void Log(const std::source_location &message, const LogLevelFlags logLevelFlags, const std::source_location &) {
+    Write(message.function_name(), logLevelFlags);
+}
+
+void LogSimple(const std::string &message, const LogLevelFlags logLevelFlags) {
+    Write(message, logLevelFlags);
+}
+
+void LogSimple(const std::wstring &message, const LogLevelFlags logLevelFlags) {
+    Write(Narrow(message), logLevelFlags);
+}
+
+void LogSimple(const std::source_location &message, const LogLevelFlags logLevelFlags) {
+    Write(message.function_name(), logLevelFlags);
+}
+
+void LogNewLine() {}
+
+void LogInsertPartition(const std::string &partition) {
+    Write(partition, kLogLevelFlagNone);
+}
+
+std::vector<std::string> GetRecentLogs() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    return sRecentLogs;
+}
+
+namespace Test {
+
+size_t GetLogCount(LogLevelFlags logLevelFlags) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    size_t count = 0;
+    if (logLevelFlags & kLogLevelFlagInfo) count += sLogCounts[0];
+    if (logLevelFlags & kLogLevelFlagWarning) count += sLogCounts[1];
+    if (logLevelFlags & kLogLevelFlagError) count += sLogCounts[2];
+    return count;
+}
+
+void ClearLogs() {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    sLogCounts = {};
+    sRecentLogs.clear();
+}
+
+void SetLogEcho(bool isEcho) {
+    std::lock_guard<std::mutex> lock(sLogMutex);
+    sIsLogEcho = isEcho;
+}
+
+} // namespace Test
+
+} // namespace KashipanEngine
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include "Common/Logs.h"
+
+namespace KashipanEngine::Test {
+
+// テスト用の Log の実装(TestLogs.cpp)が出力したログを数える
+
+/// @brief 指定したレベルのログの数
+size_t GetLogCount(LogLevelFlags logLevelFlags);
+/// @brief 数えたログを捨てる
+void ClearLogs();
+/// @brief ログを標準出力にも出力するかどうか(ベンチマークの結果の表示用)
+void SetLogEcho(bool isEcho);
+
+} // namespace KashipanEngine::Test
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "TestFramework.h"
+
+namespace KashipanEngine::Test {
+
+namespace {
+
+// 実行中のテストの失敗数
+size_t sFailureCount = 0;
+
+} // namespace
+
+std::vector<TestCase> &GetTestCases() {
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
+
+void ReportFailure(const char *file, int line, const std::string &message) {
+    std::printf("  %s(%d): %s\n", file, line, message.c_str());
+    ++sFailureCount;
+}
+
+} // namespace KashipanEngine::Test
+
+/// @brief 登録されたテストを実行する。引数を渡した場合は「スイート名.テスト名」がそれで始まるテストだけ実行する
+int main(int argc, char **argv) {
+    using namespace KashipanEngine::Test;
+    const std::string filter = argc > 1 ? argv[1] : "";
+    size_t runCount = 0;
+    size_t failedCount = 0;
+    for (const auto &testCase : GetTestCases()) {
+        const std::string fullName = std::string(testCase.suiteName) + "." + testCase.testName;
+        if (fullName.compare(0, filter.size(), filter) != 0) {
+            continue;
+        }
+        std::printf("[ RUN    ] %s\n", fullName.c_str());
+        std::fflush(stdout);
+        const size_t failureCountBefore = sFailureCount;
+        ClearLogs();
+        testCase.function();
+        ++runCount;
+        if (sFailureCount != failureCountBefore) {
+            ++failedCount;
+            std::printf("[ FAILED ] %s\n", fullName.c_str());
+        } else {
+            std::printf("[     OK ] %s\n", fullName.c_str());
+        }
+    }
+    std::printf("%zu tests, %zu failed\n", runCount, failedCount);
+    return runCount == 0 || failedCount != 0 ? 1 : 0;
+}
\ No newline at end of file
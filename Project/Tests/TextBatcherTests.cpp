@@ -0,0 +1,75 @@
+#include <utility>
+#include <vector>
+#include "TestFramework.h"
+#include "Font/TextBatcher.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 1ページで "A" だけのフォント
+FontData CreateBatchTestFont() {
+    FontData fontData{};
+    fontData.common.lineHeight = 32.0f;
+    fontData.common.scaleW = 256.0f;
+    fontData.common.scaleH = 256.0f;
+    fontData.common.pages = 1;
+    fontData.pages.emplace_back();
+    std::vector<CharInfo> chars;
+    CharInfo charInfo{};
+    charInfo.id = 'A';
+    charInfo.width = 20.0f;
+    charInfo.height = 32.0f;
+    charInfo.xAdvance = 20.0f;
+    chars.push_back(charInfo);
+    fontData.charsCount = static_cast<int>(chars.size());
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+TextBatcher::TextState MakeTextState(const TextLayout &layout, const FontData &fontData, uint32_t layer) {
+    TextBatcher::TextState textState;
+    textState.layout = &layout;
+    textState.fontData = &fontData;
+    textState.maxGlyphCount = static_cast<uint32_t>(layout.GetGlyphs().size());
+    textState.layer = layer;
+    return textState;
+}
+
+} // namespace
+
+TEST(TextBatcher, SameLayerTextsShareBatch) {
+    const FontData fontData = CreateBatchTestFont();
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetText(u8"AAA");
+    TextBatcher batcher;
+    batcher.Clear();
+    batcher.Add(MakeTextState(layout, fontData, 0));
+    batcher.Add(MakeTextState(layout, fontData, 0));
+    batcher.Build();
+    ASSERT_TRUE(batcher.GetBatches().size() == 1);
+    EXPECT_EQ(6u, batcher.GetBatches()[0].glyphCount);
+    EXPECT_EQ(size_t(24), batcher.GetVertices().size());
+}
+
+TEST(TextBatcher, LayersKeepSubmissionOrder) {
+    // 間に2Dオブジェクトを挟んだテキストは、見た目が同じでも別の単位にして順番を保つ
+    const FontData fontData = CreateBatchTestFont();
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetText(u8"AA");
+    TextBatcher batcher;
+    batcher.Clear();
+    batcher.Add(MakeTextState(layout, fontData, 0));
+    batcher.Add(MakeTextState(layout, fontData, 1));
+    batcher.Add(MakeTextState(layout, fontData, 0));
+    batcher.Build();
+    const auto &batches = batcher.GetBatches();
+    ASSERT_TRUE(batches.size() == 2);
+    EXPECT_EQ(0u, batches[0].layer);
+    EXPECT_EQ(4u, batches[0].glyphCount);
+    EXPECT_EQ(1u, batches[1].layer);
+    EXPECT_EQ(2u, batches[1].glyphCount);
+    EXPECT_EQ(16u, batches[1].vertexOffset);
+}
\ No newline at end of file
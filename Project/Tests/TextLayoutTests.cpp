@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestFramework.h"
+#include "Font/TextLayout.h"
+
+using namespace KashipanEngine;
+
+namespace {
+
+/// @brief 幅の決まった数文字だけのフォント(A=30, 空白=10, H=50, i=5)
+FontData CreateWrapTestFont() {
+    FontData fontData{};
+    fontData.common.lineHeight = 32.0f;
+    fontData.common.scaleW = 256.0f;
+    fontData.common.scaleH = 256.0f;
+    fontData.common.pages = 1;
+    std::vector<CharInfo> chars;
+    const std::pair<int, float> advances[] = { { ' ', 10.0f }, { 'A', 30.0f }, { 'H', 50.0f }, { 'i', 5.0f } };
+    for (const auto &[codePoint, advance] : advances) {
+        CharInfo charInfo{};
+        charInfo.id = codePoint;
+        charInfo.width = advance;
+        charInfo.height = 32.0f;
+        charInfo.xAdvance = advance;
+        chars.push_back(charInfo);
+    }
+    fontData.charsCount = static_cast<int>(chars.size());
+    fontData.chars.Build(std::move(chars));
+    return fontData;
+}
+
+bool IsSameAsFullLayout(const TextLayout &layout, const FontData &fontData, float maxWidth, const std::u8string &text) {
+    TextLayout fullLayout;
+    fullLayout.SetFont(&fontData);
+    fullLayout.SetMaxWidth(maxWidth);
+    fullLayout.SetText(text);
+    return layout.IsSameLayout(fullLayout);
+}
+
+/// @brief 複数バイトの文字とカーニングを含むフォント。'z' は無いので '?' で表示される
+FontData CreateEditTestFont() {
+    FontData fontData{};
+    fontData.common.lineHeight = 32.0f;
+    fontData.common.scaleW = 256.0f;
+    fontData.common.scaleH = 256.0f;
+    fontData.common.pages = 1;
+    std::vector<CharInfo> chars;
+    const std::pair<int, float> advances[] = {
+        { ' ', 10.0f }, { '?', 14.0f }, { 'A', 30.0f }, { 'H', 50.0f }, { 'V', 28.0f }, { 'i', 5.0f },
+        { 0x00E8, 12.0f }, { 0x00E9, 12.0f }, // è é (2バイト、1バイト目が同じ)
+        { 0x3001, 32.0f }, { 0x3042, 32.0f }, { 0x3044, 32.0f }, // 、 あ い (3バイト、2バイト目まで同じ)
+        { 0x6F22, 32.0f }, // 漢
+        { 0x1F600, 32.0f }, // 4バイト
+    };
+    for (const auto &[codePoint, advance] : advances) {
+        CharInfo charInfo{};
+        charInfo.id = codePoint;
+        charInfo.width = advance;
+        charInfo.height = 32.0f;
+        charInfo.xAdvance = advance;
+        chars.push_back(charInfo);
+    }
+    fontData.charsCount = static_cast<int>(chars.size());
+    fontData.chars.Build(std::move(chars));
+    const std::pair<std::pair<int, int>, float> kernings[] = {
+        { { 'A', 'V' }, -4.0f }, { { 'V', 'A' }, -4.0f }, { { 0x00E9, 'V' }, -2.0f },
+        { { 0x3042, 0x3044 }, -3.0f }, { { 'A', 0x1F600 }, 2.0f },
+    };
+    for (const auto &[pair, amount] : kernings) {
+        fontData.kernings[FontData::MakeKerningKey(pair.first, pair.second)] = amount;
+    }
+    return fontData;
+}
+
+std::u8string EncodeUtf8(const std::vector<int> &codePoints) {
+    std::u8string text;
+    for (const int codePoint : codePoints) {
+        const uint32_t c = static_cast<uint32_t>(codePoint);
+        if (c < 0x80) {
+            text += static_cast<char8_t>(c);
+        } else if (c < 0x800) {
+            text += static_cast<char8_t>(0xC0 | (c >> 6));
+            text += static_cast<char8_t>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            text += static_cast<char8_t>(0xE0 | (c >> 12));
+            text += static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+            text += static_cast<char8_t>(0x80 | (c & 0x3F));
+        } else {
+            text += static_cast<char8_t>(0xF0 | (c >> 18));
+            text += static_cast<char8_t>(0x80 | ((c >> 12) & 0x3F));
+            text += static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+            text += static_cast<char8_t>(0x80 | (c & 0x3F));
+        }
+    }
+    return text;
+}
+
+/// @brief 同じ揃え方で、すべての行の表示位置が同じかどうか
+bool IsSameLineOrigins(const TextLayout &layout, const TextLayout &other) {
+    if (layout.GetLines().size() != other.GetLines().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < layout.GetLines().size(); ++i) {
+        float x = 0.0f, y = 0.0f, otherX = 0.0f, otherY = 0.0f;
+        layout.GetLineOrigin(i, x, y);
+        other.GetLineOrigin(i, otherX, otherY);
+        if (x != otherX || y != otherY) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(TextLayout, WrapsAtSpaceAndInsideLongWords) {
+    const FontData fontData = CreateWrapTestFont();
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetMaxWidth(105.0f);
+    layout.SetText(u8"A AAH");
+    // "A " / "AA" / "H"(空白で折り返し、折り返せる位置の無い単語は文字の途中で折り返す)
+    ASSERT_TRUE(layout.GetLines().size() == 3);
+    EXPECT_FALSE(layout.GetLines()[0].isWrapped);
+    EXPECT_TRUE(layout.GetLines()[1].isWrapped);
+    EXPECT_TRUE(layout.GetLines()[2].isWrapped);
+}
+
+TEST(TextLayout, RelayoutStartsAtParagraphBegin) {
+    // 最後の行を変えると段落全体が1行に詰まる。1行戻るだけでは "A " の行が残る
+    const FontData fontData = CreateWrapTestFont();
+    TextLayout layout;
+    layout.SetFont(&fontData);
+    layout.SetMaxWidth(105.0f);
+    layout.SetText(u8"A AAH");
+    layout.SetText(u8"A AAi");
+    EXPECT_EQ(size_t(1), layout.GetLines().size());
+    EXPECT_TRUE(IsSameAsFullLayout(layout, fontData, 105.0f, u8"A AAi"));
+
+    // 前の段落は使い回し、変えた段落だけ詰め直す
+    layout.SetText(u8"AAA\nA AAH");
+    layout.SetText(u8"AAA\nA AAi");
+    EXPECT_EQ(size_t(2), layout.GetLines().size());
+    EXPECT_TRUE(IsSameAsFullLayout(layout, fontData, 105.0f, u8"AAA\nA AAi"));
+}
+
+TEST(TextLayout, RandomEditsMatchFullLayout) {
+    // 挿入・削除・置換をランダムに繰り返し、毎回すべて計算し直した結果と比べる
+    const FontData fontData = CreateEditTestFont();
+    // A と V を多めにしてカーニングの組が編集の前後にまたがるようにし、
+    // 1バイト目や2バイト目まで同じ複数バイトの文字を隣り合わせて、変わった部分の境界を文字の途中に置く
+    const int alphabet[] = { 'A', 'A', 'V', 'V', 'H', 'i', ' ', ' ', '\n', 'z',
+        0x00E8, 0x00E9, 0x3001, 0x3042, 0x3044, 0x6F22, 0x1F600 };
+    const TextAlignX alignXs[] = { TextAlignX::Left, TextAlignX::Center, TextAlignX::Right };
+    const TextAlignY alignYs[] = { TextAlignY::Top, TextAlignY::Center, TextAlignY::Bottom };
+    const float maxWidths[] = { 0.0f, 40.0f, 100.0f, 250.0f };
+
+    std::mt19937 random(20261019u);
+    size_t kerningSplitCount = 0;
+    size_t multibyteBoundaryCount = 0;
+    for (const float maxWidth : maxWidths) {
+        TextLayout layout;
+        layout.SetFont(&fontData);
+        layout.SetMaxWidth(maxWidth);
+        std::vector<int> codePoints;
+        for (int edit = 0; edit < 400; ++edit) {
+            const size_t size = codePoints.size();
+            const size_t position = std::uniform_int_distribution<size_t>(0, size)(random);
+            // 長くなりすぎないよう、長い間は削除を増やす
+            const int operation = size > 48 ? std::uniform_int_distribution<int>(1, 2)(random)
+                : std::uniform_int_distribution<int>(0, 2)(random);
+
+            // 編集する位置の前後がカーニングの組か、複数バイトの文字か
+            if (position > 0 && position < size &&
+                fontData.GetKerning(codePoints[position - 1], codePoints[position]) != 0.0f) {
+                ++kerningSplitCount;
+            }
+            if ((position > 0 && codePoints[position - 1] >= 0x80) || (position < size && codePoints[position] >= 0x80)) {
+                ++multibyteBoundaryCount;
+            }
+
+            if (operation != 0) {
+                const size_t count = std::min(size - position, std::uniform_int_distribution<size_t>(1, 4)(random));
+                codePoints.erase(codePoints.begin() + position, codePoints.begin() + position + count);
+            }
+            if (operation != 1) {
+                const size_t count = std::uniform_int_distribution<size_t>(1, 4)(random);
+                for (size_t i = 0; i < count; ++i) {
+                    const int codePoint = alphabet[std::uniform_int_distribution<size_t>(0, std::size(alphabet) - 1)(random)];
+                    codePoints.insert(codePoints.begin() + position + i, codePoint);
+                }
+            }
+
+            const std::u8string text = EncodeUtf8(codePoints);
+            const TextAlignX alignX = alignXs[edit % 3];
+            const TextAlignY alignY = alignYs[(edit / 3) % 3];
+            layout.SetAlign(alignX, alignY);
+            layout.SetText(text);
+
+            TextLayout fullLayout;
+            fullLayout.SetFont(&fontData);
+            fullLayout.SetMaxWidth(maxWidth);
+            fullLayout.SetAlign(alignX, alignY);
+            fullLayout.SetText(text);
+            ASSERT_TRUE(layout.GetText() == text);
+            ASSERT_TRUE(layout.IsSameLayout(fullLayout));
+            ASSERT_TRUE(IsSameLineOrigins(layout, fullLayout));
+        }
+    }
+    // 境界をまたぐ編集が実際に起きていること
+    EXPECT_TRUE(kerningSplitCount > 20);
+    EXPECT_TRUE(multibyteBoundaryCount > 100);
+}
\ No newline at end of file
@@ -2,6 +2,11 @@
 #include <memory>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <string>
+#include <vector>
 #ifdef USE_IMGUI
 #include <imgui.h>
 #endif
@@ -13,6 +18,7 @@
 #include "Base/Input.h"
 #include "Base/Sound.h"
 #include "Base/ScreenBuffer.h"
+#include "Base/SceneManager.h"
 
 #include "2d/ImGuiManager.h"
 
@@ -20,7 +26,19 @@
 #include "Common/ConvertColor.h"
 #include "Common/KeyFrameAnimation.h"
 #include "Common/GridLine.h"
+#include "Common/Logs.h"
 #include "Common/KeyConfig.h"
+#include "Common/Profiler.h"
+#include "Common/MemoryTracker.h"
+#include "Common/Benchmarks.h"
+#include "Common/AssetBenchmarks.h"
+#include "Common/TextBenchmarks.h"
+#include "Common/GlyphAtlasBenchmarks.h"
+#include "Common/PhysicsBenchmarks.h"
+#include "Common/ContainerBenchmarks.h"
+#include "Common/JsonBenchmarks.h"
+#include "Common/ProfilerBenchmarks.h"
+#include "Common/SceneBase.h"
 
 #include "3d/DirectionalLight.h"
 #include "Objects.h"
@@ -31,24 +49,269 @@
 
 using namespace KashipanEngine;
 
+namespace {
+
+/// @brief コマンドラインで指定する起動オプション
+struct CommandLineOptions {
+    /// @brief ウィンドウを表示せず、GPUへの描画コマンドも積まずに動かすかどうか(--headless)
+    bool isHeadless = false;
+    /// @brief シーンのベンチマークで計測するフレーム数。0ならベンチマークをせず通常通り起動する(--benchmark-scenes[=フレーム数])
+    uint32_t sceneBenchmarkFrameCount = 0;
+    /// @brief 実行して終了するベンチマークの名前(--benchmark=名前。複数指定できる)
+    std::vector<std::string> benchmarkNames;
+    /// @brief 解析できなかった引数(ログの準備ができてから警告を出す)
+    std::vector<std::string> unknownArguments;
+};
+
+/// @brief シーンのベンチマークで計測するフレーム数の既定値
+const uint32_t kDefaultSceneBenchmarkFrameCount = 600;
+
+/// @brief コマンドライン引数の解析。知らない引数は unknownArguments に入れて無視する
+CommandLineOptions ParseCommandLine(int argc, char **argv) {
+    CommandLineOptions options;
+    const std::string benchmarkScenes = "--benchmark-scenes";
+    const std::string benchmark = "--benchmark=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--headless") {
+            options.isHeadless = true;
+        } else if (argument == benchmarkScenes) {
+            options.sceneBenchmarkFrameCount = kDefaultSceneBenchmarkFrameCount;
+        } else if (argument.starts_with(benchmarkScenes + "=")) {
+            const long frameCount = std::strtol(argument.c_str() + benchmarkScenes.size() + 1, nullptr, 10);
+            options.sceneBenchmarkFrameCount = frameCount > 0 ? static_cast<uint32_t>(frameCount) : kDefaultSceneBenchmarkFrameCount;
+        } else if (argument.starts_with(benchmark)) {
+            options.benchmarkNames.push_back(argument.substr(benchmark.size()));
+        } else {
+            options.unknownArguments.push_back(argument);
+        }
+    }
+    return options;
+}
+
+/// @brief 実行できるベンチマーク(名前は KashipanEngineBenchmarks と揃える)
+struct BenchmarkSuite {
+    const char *name;
+    bool (*run)();
+};
+
+const BenchmarkSuite kBenchmarkSuites[] = {
+    { "micro", []() { return RunMicroBenchmarks(); } },
+    { "assets", []() { return RunAssetBenchmarks(); } },
+    { "text", []() { return RunTextBenchmarks(); } },
+    { "glyphatlas", []() { return RunGlyphAtlasBenchmarks(); } },
+    { "physics", []() { return RunPhysicsBenchmarks(); } },
+    { "containers", []() { return RunContainerBenchmarks(); } },
+    { "hashmap", []() { return RunHashMapBenchmarks(); } },
+    { "json", []() { return RunJsonBenchmarks(); } },
+    { "profiler", []() { return RunProfilerBenchmarks(); } },
+};
+
+/// @brief 名前で指定したベンチマークの実行
+/// @return すべて見つかり、基準より遅くなったものが無かったかどうか
+bool RunBenchmarks(const std::vector<std::string> &names) {
+    bool isPassed = true;
+    for (const auto &name : names) {
+        const auto it = std::find_if(std::begin(kBenchmarkSuites), std::end(kBenchmarkSuites),
+            [&name](const BenchmarkSuite &suite) { return name == suite.name; });
+        if (it == std::end(kBenchmarkSuites)) {
+            Log("Unknown benchmark: " + name, kLogLevelFlagError);
+            isPassed = false;
+            continue;
+        }
+        isPassed = it->run() && isPassed;
+    }
+    return isPassed;
+}
+
+/// @brief モデル・パーティクル・スプライトを並べたデモシーン
+class DemoScene : public SceneBase {
+public:
+    DemoScene() : SceneBase("Demo") {}
+    ~DemoScene() override {
+        if (isInitialized_) {
+            Finalize();
+        }
+    }
+
+    void Initialize() override {
+        // テクスチャを読み込む
+        textures_[0] = Texture::Load("Resources/uvChecker.png");
+        textures_[1] = Texture::Load("Resources/testPlayer.png");
+
+        //==================================================
+        // 平行光源
+        //==================================================
+
+        directionalLight_.color = Vector4(255.0f, 255.0f, 255.0f, 255.0f);
+        directionalLight_.direction = Vector3(0.5f, -0.75f, -0.5f).Normalize();
+        directionalLight_.intensity = 16.0f;
+
+        //==================================================
+        // モデル
+        //==================================================
+
+        // モデルに使用するカメラ
+        camera_ = std::make_unique<Camera>();
+        camera_->SetTranslate({ 0.0f, 1.0f, -16.0f });
+        // カメラをレンダラーにセット
+        engine_->GetRenderer()->SetCamera(camera_.get());
+
+        // モデルの生成
+        models_.push_back(std::make_unique<Model>("Resources/nahida", "nahida.obj"));
+        models_.back()->GetStatePtr().transform->translate = { 0.0f, 0.0f, 0.0f };
+        models_.push_back(std::make_unique<Model>("Resources/Ground", "ground.obj"));
+        models_.back()->GetStatePtr().transform->translate = { 0.0f, 0.0f, 0.0f };
+
+        //==================================================
+        // パーティクル
+        //==================================================
+
+        particleGroup_ = ParticleManager::CreateParticleGroup(
+            "TestParticles",
+            engine_->GetDxCommon(),
+            kInstanceCount, // 最大インスタンス数
+            textures_[0]    // 使用テクスチャ
+        );
+        for (int i = 0; i < kInstanceCount; ++i) {
+            if (auto *p = particleGroup_->SpawnParticle()) {
+                // 円状に配置
+                float angle = (static_cast<float>(i) / static_cast<float>(kInstanceCount)) * 6.2831853f;
+                float radius = 4.0f + (i % 10) * 0.1f;
+                p->transform.translate += { std::cos(angle) * radius, 0.2f * (i % 10), std::sin(angle) * radius };
+                p->transform.scale = { 0.5f, 0.5f, 0.5f };
+                p->transform.rotate = { 0.0f, angle, 0.0f };
+            }
+        }
+        particleTime_ = 0.0f;
+
+        //==================================================
+        // スプライト
+        //==================================================
+
+        sprite_ = std::make_unique<Sprite>(textures_[0]);
+        sprite_->GetStatePtr().transform->translate = { 256.0f, 256.0f, 0.0f };
+
+        isInitialized_ = true;
+    }
+
+    void Finalize() override {
+        sprite_.reset();
+        models_.clear();
+        particleGroup_ = nullptr;
+        isInitialized_ = false;
+    }
+
+    void Update() override {
+        // 平行光源をレンダラーにセット
+        engine_->GetRenderer()->SetLight(&directionalLight_);
+#ifdef USE_IMGUI
+        // モデル
+        ImGui::Begin("モデル");
+        for (size_t i = 0; i < models_.size(); i++) {
+            auto modelState = models_[i]->GetStatePtr();
+            ImGui::Text("モデル %zu", i);
+            ImGui::InputFloat3(("位置##model" + std::to_string(i)).c_str(), &modelState.transform->translate.x);
+            ImGui::InputFloat3(("回転##model" + std::to_string(i)).c_str(), &modelState.transform->rotate.x);
+            ImGui::InputFloat3(("拡縮##model" + std::to_string(i)).c_str(), &modelState.transform->scale.x);
+        }
+        ImGui::End();
+
+        // パーティクル
+        ImGui::Begin("パーティクル");
+        ImGui::Text("アクティブパーティクル数: %d", particleGroup_->GetInstanceCount());
+        Vector3 spawnPos = particleGroup_->GetSpawnPosition();
+        ImGui::InputFloat3("発生位置", &spawnPos.x);
+        particleGroup_->SetSpawnPosition(spawnPos);
+        ImGui::End();
+
+        // スプライト
+        ImGui::Begin("スプライト");
+        auto spriteState = sprite_->GetStatePtr();
+        ImGui::DragFloat3("位置", &spriteState.transform->translate.x);
+        ImGui::DragFloat3("回転", &spriteState.transform->rotate.x);
+        ImGui::DragFloat3("拡縮", &spriteState.transform->scale.x);
+        ImGui::End();
+#endif
+    }
+
+    void FixedUpdate() override {
+        // パーティクルのアニメーション(フレームレートに依存しないよう固定ステップで更新する)
+        float dt = engine_->GetFixedDeltaTime();
+        particleTime_ += dt;
+        const auto &list = particleGroup_->GetParticles();
+        for (size_t i = 0; i < list.size(); ++i) {
+            auto &p = list[i];
+            if (!p->isAlive || !p->isActive) { continue; }
+            // 上昇させつつ回転
+            p->transform.translate.y += dt * 0.5f;
+            p->transform.rotate.y += dt * 0.8f;
+            // 一定高さで非アクティブ化して再スポーン
+            if (p->transform.translate.y > 4.0f) {
+                p->isActive = false;
+                p->isAlive = false;
+                if (auto *newP = particleGroup_->SpawnParticle()) {
+                    float angle = (static_cast<float>(i) / static_cast<float>(kInstanceCount)) * 6.2831853f;
+                    float radius = 4.0f + (static_cast<int>(i) % 10) * 0.1f;
+                    p->transform.translate += { std::cos(angle) * radius, 0.0f, std::sin(angle) * radius };
+                    p->transform.scale = { 0.5f, 0.5f, 0.5f };
+                    p->transform.rotate = { 0.0f, angle, 0.0f };
+                }
+            }
+        }
+    }
+
+    void Draw() override {
+        for (size_t i = 0; i < models_.size(); i++) {
+            models_[i]->Draw();
+        }
+        // パーティクルの描画
+        particleGroup_->Draw();
+        // スプライトの描画
+        sprite_->Draw();
+    }
+
+private:
+    static const int kInstanceCount = 1024;
+
+    TextureHandle textures_[2];
+    DirectionalLight directionalLight_{};
+    std::unique_ptr<Camera> camera_;
+    // モデルコンテナ
+    std::vector<std::unique_ptr<Model>> models_;
+    ParticleGroup *particleGroup_ = nullptr;
+    float particleTime_ = 0.0f;
+    std::unique_ptr<Sprite> sprite_;
+};
+
+} // namespace
+
 // Windowsアプリでのエントリーポイント(main関数)
+// --headless: ウィンドウを表示せず、GPUへの描画コマンドも積まずに動かす
+// --benchmark-scenes[=フレーム数]: 登録したすべてのシーンを計測してログに出力し、終了する
+// --benchmark=名前: 指定したベンチマーク(micro, assets, text など)を実行し、基準より遅くなれば 1 を返して終了する
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     //==================================================
     // 自作ゲームエンジン
     //==================================================
 
     // エンジンのインスタンスを作成
-    std::unique_ptr<Engine> myGameEngine = std::make_unique<Engine>("KashipanEngine", 1920, 1080, true);
+    const CommandLineOptions options = ParseCommandLine(__argc, __argv);
+    std::unique_ptr<Engine> myGameEngine = std::make_unique<Engine>("KashipanEngine", 1920, 1080, true,
+        std::filesystem::current_path(), options.isHeadless);
+    for (const auto &argument : options.unknownArguments) {
+        Log("Unknown command line argument: " + argument, kLogLevelFlagWarning);
+    }
+
+    // ベンチマークだけを行って終了する
+    if (!options.benchmarkNames.empty()) {
+        return RunBenchmarks(options.benchmarkNames) ? 0 : 1;
+    }
 
     // WinAppクラスへのポインタ
     WinApp *winApp = myGameEngine->GetWinApp();
     winApp->SetSizeChangeMode(SizeChangeMode::kNormal);
 
-    // テクスチャを読み込む
-    uint32_t textures[2];
-    textures[0] = Texture::Load("Resources/uvChecker.png");
-    textures[1] = Texture::Load("Resources/testPlayer.png");
-
     // フレームレート
     int frameRate = 60;
     myGameEngine->SetFrameRate(frameRate);
@@ -57,63 +320,18 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     bool isDebugCameraActive = false;
 
     //==================================================
-    // 平行光源
-    //==================================================
-
-    DirectionalLight directionalLight{};
-    directionalLight.color = Vector4(255.0f, 255.0f, 255.0f, 255.0f);
-    directionalLight.direction = Vector3(0.5f, -0.75f, -0.5f).Normalize();
-    directionalLight.intensity = 16.0f;
-
-    //==================================================
-    // モデル
+    // シーン
     //==================================================
 
-    // モデルに使用するカメラ
-    std::unique_ptr<Camera> camera = std::make_unique<Camera>();
-    camera->SetTranslate({ 0.0f, 1.0f, -16.0f });
-    // カメラをレンダラーにセット
-    myGameEngine->GetRenderer()->SetCamera(camera.get());
+    SceneManager::AddScene<DemoScene>("Demo");
 
-    // モデルコンテナ
-    std::vector<std::unique_ptr<Model>> models;
-    // モデルの生成
-    models.push_back(std::make_unique<Model>("Resources/nahida", "nahida.obj"));
-    models.back()->GetStatePtr().transform->translate = { 0.0f, 0.0f, 0.0f };
-    models.push_back(std::make_unique<Model>("Resources/Ground", "ground.obj"));
-    models.back()->GetStatePtr().transform->translate = { 0.0f, 0.0f, 0.0f };
-
-    //==================================================
-    // パーティクル
-    //==================================================
-
-    const int kInstanceCount = 1024;
-    ParticleGroup *particleGroup = ParticleManager::CreateParticleGroup(
-        "TestParticles",
-        myGameEngine->GetDxCommon(),
-        kInstanceCount, // 最大インスタンス数
-        textures[0]     // 使用テクスチャ
-    );
-    for (int i = 0; i < kInstanceCount; ++i) {
-        if (auto *p = particleGroup->SpawnParticle()) {
-            // 円状に配置
-            float angle = (static_cast<float>(i) / static_cast<float>(kInstanceCount)) * 6.2831853f;
-            float radius = 4.0f + (i % 10) * 0.1f;
-            p->transform.translate += { std::cos(angle) * radius, 0.2f * (i % 10), std::sin(angle) * radius };
-            p->transform.scale = { 0.5f, 0.5f, 0.5f };
-            p->transform.rotate = { 0.0f, angle, 0.0f };
-        }
+    // シーンのベンチマークだけを行って終了する
+    if (options.sceneBenchmarkFrameCount > 0) {
+        myGameEngine->RunSceneBenchmarks(options.sceneBenchmarkFrameCount);
+        SceneManager::ClearScenes();
+        return 0;
     }
 
-    float particleTime = 0.0f;
-
-    //==================================================
-    // スプライト
-    //==================================================
-
-    std::unique_ptr<Sprite> sprite = std::make_unique<Sprite>(textures[0]);
-    sprite->GetStatePtr().transform->translate = { 256.0f, 256.0f, 0.0f };
-
     // ウィンドウのxボタンが押されるまでループ
     while (myGameEngine->ProccessMessage() != -1) {
         myGameEngine->BeginFrame();
@@ -125,14 +343,101 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         // 更新処理
         //==================================================
 
-        // 平行光源をレンダラーにセット
-        myGameEngine->GetRenderer()->SetLight(&directionalLight);
 #ifdef USE_IMGUI
         ImGuiManager::Begin("KashipanEngine");
         // FPSの表示
         ImGui::Text("FPS: %d", myGameEngine->GetFPS());
         // デルタタイムの表示
         ImGui::Text("DeltaTime: %f", myGameEngine->GetDeltaTime());
+        // フレーム開始時刻のずれの表示
+        auto pacingStats = myGameEngine->GetFramePacingStats();
+        ImGui::Text("Jitter: p50 %.3fms, p99 %.3fms, max %.3fms (spin %.3fms)",
+            pacingStats.p50, pacingStats.p99, pacingStats.max, pacingStats.spinMargin);
+        auto frameTimeStats = myGameEngine->GetFrameTimeStats();
+        ImGui::Text("Frame: p50 %.2fms, p95 %.2fms, p99 %.2fms, max %.2fms (hitch %llu)",
+            frameTimeStats.p50, frameTimeStats.p95, frameTimeStats.p99, frameTimeStats.max,
+            static_cast<unsigned long long>(frameTimeStats.hitchCount));
+        // 直近のフレームの描画コマンドの数
+        const auto &drawStats = myGameEngine->GetRenderer()->GetDrawStats();
+        ImGui::Text("Draw: %u calls, %u instances, %u pipeline changes",
+            drawStats.drawCallCount, drawStats.instanceCount, drawStats.pipeLineChangeCount);
+        ImGui::Text("Text: %u texts, %u glyphs in %u calls",
+            drawStats.textCount, drawStats.textGlyphCount, drawStats.textDrawCallCount);
+        // プロファイラの結果の表示(1フレームあたりの時間)
+        if (ImGui::TreeNode("プロファイラ")) {
+            for (const auto &zone : Profiler::GetZoneStats()) {
+                ImGui::Text("%-40s avg %.3fms, min %.3fms, p99 %.3fms",
+                    zone.name.c_str(), zone.average, zone.min, zone.p99);
+            }
+            if (ImGui::Button("トレースを書き出す")) {
+                Profiler::ExportChromeTrace("Logs/trace.json");
+            }
+            ImGui::TreePop();
+        }
+        // タグごとのヒープの使用状況の表示
+        if (ImGui::TreeNode("メモリ")) {
+            for (const auto &tagStats : MemoryTracker::GetStats()) {
+                ImGui::Text("%-10s %8.2fMB (%zu blocks), %llu allocs/frame%s",
+                    tagStats.name, static_cast<double>(tagStats.liveBytes) / (1024.0 * 1024.0), tagStats.liveCount,
+                    static_cast<unsigned long long>(tagStats.frameAllocationCount),
+                    tagStats.budgetBytes != 0 && tagStats.liveBytes > tagStats.budgetBytes ? " [OVER BUDGET]" : "");
+            }
+            ImGui::TreePop();
+        }
+        // 入力の記録と再生(性能の比較用に同じ操作を繰り返す)
+        if (ImGui::TreeNode("入力の記録")) {
+            if (!Input::IsRecording() && !Input::IsReplaying()) {
+                if (ImGui::Button("記録開始")) {
+                    myGameEngine->StartInputRecording();
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("再生")) {
+                    myGameEngine->StartInputReplay("Logs/input.kirc");
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("最大速度で再生")) {
+                    myGameEngine->StartInputReplay("Logs/input.kirc", true);
+                }
+            } else if (Input::IsRecording()) {
+                if (ImGui::Button("記録終了")) {
+                    myGameEngine->StopInputRecording("Logs/input.kirc");
+                }
+            } else {
+                ImGui::Text("再生中: %zu / %zu", Input::GetReplayFrameIndex(), Input::GetReplayFrameCount());
+            }
+            ImGui::TreePop();
+        }
+        // ベンチマーク(結果は Logs/Benchmarks に保存し、Benchmarks の基準と比べる)
+        if (ImGui::TreeNode("ベンチマーク")) {
+            if (ImGui::Button("マイクロベンチマーク")) {
+                RunMicroBenchmarks();
+            }
+            if (ImGui::Button("アセット読み込みベンチマーク")) {
+                RunAssetBenchmarks();
+            }
+            if (ImGui::Button("テキストベンチマーク")) {
+                RunTextBenchmarks();
+            }
+            if (ImGui::Button("グリフアトラスベンチマーク")) {
+                RunGlyphAtlasBenchmarks();
+            }
+            if (ImGui::Button("物理ベンチマーク")) {
+                RunPhysicsBenchmarks();
+            }
+            if (ImGui::Button("コンテナベンチマーク")) {
+                RunContainerBenchmarks();
+            }
+            if (ImGui::Button("ハッシュマップベンチマーク")) {
+                RunHashMapBenchmarks();
+            }
+            if (ImGui::Button("JSON読み込みベンチマーク")) {
+                RunJsonBenchmarks();
+            }
+            if (ImGui::Button("プロファイラベンチマーク")) {
+                RunProfilerBenchmarks();
+            }
+            ImGui::TreePop();
+        }
         ImGui::InputInt("フレームレート", &frameRate);
         if (ImGui::Button("フレームレートを設定")) {
             myGameEngine->SetFrameRate(frameRate);
@@ -177,74 +482,21 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         ImGui::Text("マウス座標: x.%d y.%d", static_cast<int>(Input::GetMouseX()), static_cast<int>(Input::GetMouseY()));
 
         ImGui::End();
-
-        // モデル
-        ImGui::Begin("モデル");
-        for (size_t i = 0; i < models.size(); i++) {
-            auto modelState = models[i]->GetStatePtr();
-            ImGui::Text("モデル %zu", i);
-            ImGui::InputFloat3(("位置##model" + std::to_string(i)).c_str(), &modelState.transform->translate.x);
-            ImGui::InputFloat3(("回転##model" + std::to_string(i)).c_str(), &modelState.transform->rotate.x);
-            ImGui::InputFloat3(("拡縮##model" + std::to_string(i)).c_str(), &modelState.transform->scale.x);
-        }
-        ImGui::End();
-
-        // パーティクル
-        ImGui::Begin("パーティクル");
-        ImGui::Text("アクティブパーティクル数: %d", particleGroup->GetInstanceCount());
-        Vector3 spawnPos = particleGroup->GetSpawnPosition();
-        ImGui::InputFloat3("発生位置", &spawnPos.x);
-        particleGroup->SetSpawnPosition(spawnPos);
-        ImGui::End();
-
-        // スプライト
-        ImGui::Begin("スプライト");
-        auto spriteState = sprite->GetStatePtr();
-        ImGui::DragFloat3("位置", &spriteState.transform->translate.x);
-        ImGui::DragFloat3("回転", &spriteState.transform->rotate.x);
-        ImGui::DragFloat3("拡縮", &spriteState.transform->scale.x);
-        ImGui::End();
 #else
         static_cast<void>(isDebugCameraActive);
 #endif
 
-        // パーティクルのアニメーション
-        {
-            float dt = myGameEngine->GetDeltaTime();
-            particleTime += dt;
-            const auto &list = particleGroup->GetParticles();
-            for (size_t i = 0; i < list.size(); ++i) {
-                auto &p = list[i];
-                if (!p->isAlive || !p->isActive) { continue; }
-                // 上昇させつつ回転
-                p->transform.translate.y += dt * 0.5f;
-                p->transform.rotate.y += dt * 0.8f;
-                // 一定高さで非アクティブ化して再スポーン
-                if (p->transform.translate.y > 4.0f) {
-                    p->isActive = false;
-                    p->isAlive = false;
-                    if (auto *newP = particleGroup->SpawnParticle()) {
-                        float angle = (static_cast<float>(i) / static_cast<float>(kInstanceCount)) * 6.2831853f;
-                        float radius = 4.0f + (static_cast<int>(i) % 10) * 0.1f;
-                        p->transform.translate += { std::cos(angle) * radius, 0.0f, std::sin(angle) * radius };
-                        p->transform.scale = { 0.5f, 0.5f, 0.5f };
-                        p->transform.rotate = { 0.0f, angle, 0.0f };
-                    }
-                }
-            }
+        // シーンの更新(固定ステップの更新はティックの数だけ呼ぶ)
+        SceneManager::UpdateActiveScene();
+        while (myGameEngine->BeginFixedUpdate()) {
+            SceneManager::FixedUpdateActiveScene();
         }
 
         //==================================================
         // 描画処理
         //==================================================
 
-        for (size_t i = 0; i < models.size(); i++) {
-            models[i]->Draw();
-        }
-        // パーティクルの描画
-        particleGroup->Draw();
-        // スプライトの描画
-        sprite->Draw();
+        SceneManager::DrawActiveScene();
 
         myGameEngine->EndFrame();
         // ESCで終了
@@ -253,5 +505,6 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         }
     }
 
+    SceneManager::ClearScenes();
     return 0;
 }
\ No newline at end of file